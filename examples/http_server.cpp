@@ -0,0 +1,118 @@
+/*!
+    \file http_server.cpp
+    \brief HTTP server example
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "asio_service.h"
+
+#include "server/http/http_server.h"
+
+#include <iostream>
+
+class HelloSession : public CppServer::HTTP::HTTPSession
+{
+public:
+    using CppServer::HTTP::HTTPSession::HTTPSession;
+
+protected:
+    void onReceivedRequest(const CppServer::HTTP::HTTPRequest& request) override
+    {
+        std::cout << "Request: " << request.method() << " " << request.url() << std::endl;
+
+        // Send the response to the client
+        response().SetBegin(200);
+        response().SetHeader("Content-Type", "text/plain");
+        response().SetBody("Hello from HTTP server!");
+        SendResponseAsync();
+    }
+
+    void onReceivedRequestError(const CppServer::HTTP::HTTPRequest& request, const std::string& error) override
+    {
+        std::cout << "Request error: " << error << std::endl;
+    }
+
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        std::cout << "HTTP session caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
+    }
+};
+
+class HelloServer : public CppServer::HTTP::HTTPServer
+{
+public:
+    using CppServer::HTTP::HTTPServer::HTTPServer;
+
+protected:
+    std::shared_ptr<CppServer::Asio::TCPSession> CreateSession(std::shared_ptr<CppServer::Asio::TCPServer> server) override
+    {
+        return std::make_shared<HelloSession>(server);
+    }
+
+protected:
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        std::cout << "HTTP server caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    // HTTP server port
+    int port = 8080;
+    if (argc > 1)
+        port = std::atoi(argv[1]);
+
+    std::cout << "HTTP server port: " << port << std::endl;
+
+    std::cout << std::endl;
+
+    // Create a new Asio service
+    auto service = std::make_shared<AsioService>();
+
+    // Start the Asio service
+    std::cout << "Asio service starting...";
+    service->Start();
+    std::cout << "Done!" << std::endl;
+
+    // Create a new HTTP server
+    auto server = std::make_shared<HelloServer>(service, port);
+
+    // Start the server
+    std::cout << "Server starting...";
+    server->Start();
+    std::cout << "Done!" << std::endl;
+
+    std::cout << "Press Enter to stop the server or '!' to restart the server..." << std::endl;
+
+    // Perform text input
+    std::string line;
+    while (getline(std::cin, line))
+    {
+        if (line.empty())
+            break;
+
+        // Restart the server
+        if (line == "!")
+        {
+            std::cout << "Server restarting...";
+            server->Restart();
+            std::cout << "Done!" << std::endl;
+            continue;
+        }
+    }
+
+    // Stop the server
+    std::cout << "Server stopping...";
+    server->Stop();
+    std::cout << "Done!" << std::endl;
+
+    // Stop the Asio service
+    std::cout << "Asio service stopping...";
+    service->Stop();
+    std::cout << "Done!" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*!
+    \file framed.h
+    \brief Message framing adapter definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_FRAMED_H
+#define CPPSERVER_ASIO_FRAMED_H
+
+#include "message_compression.h"
+#include "message_framing.h"
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CppServer {
+namespace Asio {
+
+//! Message framing adapter
+/*!
+    Message framing adapter extends TCP/SSL session or client with the
+    message framing. Received data is split into whole messages which
+    are notified with onMessage() handler, sent messages are framed with
+    the same framing. Framing should be configured with framing() before
+    the connection is established, default framing is 4 bytes big-endian
+    length prefix.
+
+    Messages could be compressed with compression() configured the same
+    way on both sides of the connection, default is no compression. Sent
+    messages are compressed before framing, received messages are
+    decompressed after framing, the maximal message size of the framing
+    limits the decompressed size as well. Without context takeover the
+    message prepared with PrepareMessage() could be multicast to all
+    sessions of the server, so it is compressed only once.
+
+    Framing and compression state is reset in onConnected() handler, so
+    the derived class which overrides it should call the base handler.
+
+    Base class should be TCPSession, TCPClient, SSLSession, SSLClient or
+    one of their descendants, e.g.:
+    \code
+    class ChatSession : public Framed<TCPSession>
+    {
+    public:
+        using Framed<TCPSession>::Framed;
+
+    protected:
+        void onMessage(const void* buffer, size_t size) override { SendMessageAsync(buffer, size); }
+    };
+    \endcode
+
+    Thread-safe.
+*/
+template <class TBase>
+class Framed : public TBase
+{
+public:
+    using TBase::TBase;
+
+    //! Get the message framing
+    MessageFraming& framing() noexcept { return _framing; }
+    const MessageFraming& framing() const noexcept { return _framing; }
+    //! Get the message compression
+    MessageCompression& compression() noexcept { return _compression; }
+    const MessageCompression& compression() const noexcept { return _compression; }
+
+    //! Prepare the framed message to multicast
+    /*!
+        Message is compressed and framed the same way as the sent message
+        and appended to the output buffer, which could be multicast to all
+        sessions with the same framing and compression, e.g.:
+        \code
+        std::vector<uint8_t> message;
+        if (session->PrepareMessage(buffer, size, message))
+            server->Multicast(message.data(), message.size());
+        \endcode
+
+        \param buffer - Message buffer
+        \param size - Message size
+        \param output - Output buffer
+        \return 'true' if the message was successfully prepared, 'false' if the message could not be framed or compressed with context takeover
+    */
+    bool PrepareMessage(const void* buffer, size_t size, std::vector<uint8_t>& output);
+
+    //! Send the framed message (synchronous)
+    /*!
+        \param buffer - Message buffer to send
+        \param size - Message size
+        \return Size of sent data including the framing
+    */
+    size_t SendMessage(const void* buffer, size_t size);
+    //! Send the framed text message (synchronous)
+    /*!
+        \param text - Text message to send
+        \return Size of sent data including the framing
+    */
+    size_t SendMessage(std::string_view text) { return SendMessage(text.data(), text.size()); }
+
+    //! Send the framed message (asynchronous)
+    /*!
+        Framed message is sent with a single asynchronous send, so messages
+        sent from different threads are never interleaved.
+
+        \param buffer - Message buffer to send
+        \param size - Message size
+        \return 'true' if the message was successfully sent, 'false' if the connection is not established or the message does not fit into the length prefix
+    */
+    bool SendMessageAsync(const void* buffer, size_t size);
+    //! Send the framed text message (asynchronous)
+    /*!
+        \param text - Text message to send
+        \return 'true' if the text message was successfully sent, 'false' if the connection is not established or the message does not fit into the length prefix
+    */
+    bool SendMessageAsync(std::string_view text) { return SendMessageAsync(text.data(), text.size()); }
+
+protected:
+    //! Handle message received notification
+    /*!
+        Notification is called when another whole message was received.
+        Message buffer is valid only during the notification call.
+
+        \param buffer - Received message buffer
+        \param size - Received message size
+    */
+    virtual void onMessage(const void* buffer, size_t size) {}
+    //! Handle message framing error notification
+    /*!
+        Notification is called when the received message exceeds the maximal
+        message size or could not be decompressed. The connection is
+        disconnected after the notification.
+
+        \param error - Framing error message
+    */
+    virtual void onMessageError(const std::string& error) {}
+
+    void onConnected() override;
+    void onReceived(const void* buffer, size_t size) override;
+
+private:
+    MessageFraming _framing;
+    MessageCompression _compression;
+    // Compressed messages should be sent in the order of compression
+    std::mutex _compression_lock;
+    // Decompressed message buffer
+    std::string _decompressed;
+    bool _decompression_error{false};
+
+    // Frame the message into the thread local send buffer
+    const std::vector<uint8_t>* Frame(const void* buffer, size_t size);
+    // Compress and frame the message into the output buffer
+    bool FrameMessage(const void* buffer, size_t size, std::vector<uint8_t>& output);
+    // Decompress and notify the received message
+    void ReceiveMessage(const void* buffer, size_t size);
+    // Disconnect the client asynchronously or the session
+    template <class T>
+    static auto DisconnectOnError(T& instance, int) -> decltype(instance.DisconnectAsync(), void()) { instance.DisconnectAsync(); }
+    template <class T>
+    static void DisconnectOnError(T& instance, long) { instance.Disconnect(); }
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#include "framed.inl"
+
+#endif // CPPSERVER_ASIO_FRAMED_H
@@ -0,0 +1,138 @@
+/*!
+    \file framed.inl
+    \brief Message framing adapter inline implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppServer {
+namespace Asio {
+
+template <class TBase>
+inline bool Framed<TBase>::PrepareMessage(const void* buffer, size_t size, std::vector<uint8_t>& output)
+{
+    std::scoped_lock locker(_compression_lock);
+
+    // Message compressed with context takeover is valid only for this connection
+    if ((_compression.mode() != MessageCompression::Mode::None) && _compression.context_takeover())
+        return false;
+
+    return FrameMessage(buffer, size, output);
+}
+
+template <class TBase>
+inline const std::vector<uint8_t>* Framed<TBase>::Frame(const void* buffer, size_t size)
+{
+    // Reuse the send buffer of the calling thread
+    thread_local std::vector<uint8_t> output;
+    output.clear();
+
+    if (!FrameMessage(buffer, size, output))
+        return nullptr;
+
+    return &output;
+}
+
+template <class TBase>
+inline bool Framed<TBase>::FrameMessage(const void* buffer, size_t size, std::vector<uint8_t>& output)
+{
+    if (_compression.mode() == MessageCompression::Mode::None)
+        return _framing.Frame(buffer, size, output);
+
+    // Reuse the compression buffer of the calling thread
+    thread_local std::string compressed;
+    compressed.clear();
+
+    return _compression.Compress(buffer, size, compressed) && _framing.Frame(compressed.data(), compressed.size(), output);
+}
+
+template <class TBase>
+inline size_t Framed<TBase>::SendMessage(const void* buffer, size_t size)
+{
+    std::unique_lock<std::mutex> locker(_compression_lock, std::defer_lock);
+    if (_compression.mode() != MessageCompression::Mode::None)
+        locker.lock();
+
+    auto output = Frame(buffer, size);
+    if (output == nullptr)
+        return 0;
+
+    return TBase::Send(output->data(), output->size());
+}
+
+template <class TBase>
+inline bool Framed<TBase>::SendMessageAsync(const void* buffer, size_t size)
+{
+    std::unique_lock<std::mutex> locker(_compression_lock, std::defer_lock);
+    if (_compression.mode() != MessageCompression::Mode::None)
+        locker.lock();
+
+    auto output = Frame(buffer, size);
+    if (output == nullptr)
+        return false;
+
+    return TBase::SendAsync(output->data(), output->size());
+}
+
+template <class TBase>
+inline void Framed<TBase>::onConnected()
+{
+    // Drop the partial message and the compression window of the previous connection
+    _framing.Reset();
+    {
+        std::scoped_lock locker(_compression_lock);
+        _compression.Reset();
+    }
+    _decompression_error = false;
+
+    TBase::onConnected();
+}
+
+template <class TBase>
+inline void Framed<TBase>::onReceived(const void* buffer, size_t size)
+{
+    // Ignore the rest of the received data after the framing or decompression error
+    if (_framing.error() || _decompression_error)
+        return;
+
+    auto handler = [this](const void* message, size_t length) { ReceiveMessage(message, length); };
+    if (!_framing.Receive(buffer, size, handler))
+    {
+        onMessageError("Message size exceeds the limit!");
+        DisconnectOnError(*this, 0);
+    }
+    else if (_decompression_error)
+    {
+        onMessageError("Invalid compressed message!");
+        DisconnectOnError(*this, 0);
+    }
+}
+
+template <class TBase>
+inline void Framed<TBase>::ReceiveMessage(const void* buffer, size_t size)
+{
+    // Ignore the rest of the received messages after the decompression error
+    if (_decompression_error)
+        return;
+
+    if (_compression.mode() == MessageCompression::Mode::None)
+    {
+        onMessage(buffer, size);
+        return;
+    }
+
+    // Decompressed message is limited with the maximal message size of the framing
+    size_t limit = _framing.max_message_size();
+    _decompressed.clear();
+    if (!_compression.Decompress(buffer, size, _decompressed, limit) || ((limit > 0) && (_decompressed.size() > limit)))
+    {
+        _decompression_error = true;
+        return;
+    }
+
+    onMessage(_decompressed.data(), _decompressed.size());
+}
+
+} // namespace Asio
+} // namespace CppServer
@@ -0,0 +1,167 @@
+/*!
+    \file message_compression.h
+    \brief Message compression definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_MESSAGE_COMPRESSION_H
+#define CPPSERVER_ASIO_MESSAGE_COMPRESSION_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+struct z_stream_s;
+
+namespace CppServer {
+namespace Asio {
+
+//! Message compression
+/*!
+    Message compression compresses each sent message and decompresses each
+    received message with the streaming raw deflate (RFC 1951). Compressed
+    message is flushed to the byte boundary and its trailing empty block
+    (0x00 0x00 0xFF 0xFF) is removed, the same as permessage-deflate
+    WebSocket extension (RFC 7692) does.
+
+    With context takeover (default) the compression window is kept between
+    messages, so each message could reference the data of the previous
+    messages. Such messages are compressed better, but each compressed
+    message is valid only for the stream it was compressed for. Without
+    context takeover the compression state is reset after each message,
+    so the same compressed message could be sent to any count of peers,
+    e.g. compressed once and multicast to all sessions of the server.
+
+    Preset dictionary primes the compression window of each message with
+    the data which is common for the messages (e.g. field names of JSON
+    messages). It recovers the compression ratio of short messages lost
+    without context takeover. Both peers should use the same dictionary.
+
+    Compression streams are created on the first compressed or decompressed
+    message. Compressing and decompressing use separate streams, so one
+    thread could send messages while another one receives them.
+
+    Deflate compression is available only if the library is built with
+    zlib (CPPSERVER_ZLIB definition). Otherwise compressing and
+    decompressing in the deflate mode always fail.
+
+    Not thread-safe.
+*/
+class MessageCompression
+{
+public:
+    //! Compression mode
+    enum class Mode
+    {
+        None,           //!< Messages are not compressed
+        Deflate         //!< Messages are compressed with raw deflate
+    };
+
+    MessageCompression();
+    MessageCompression(const MessageCompression&) = delete;
+    MessageCompression(MessageCompression&&) = delete;
+    ~MessageCompression();
+
+    MessageCompression& operator=(const MessageCompression&) = delete;
+    MessageCompression& operator=(MessageCompression&&) = delete;
+
+    //! Is deflate compression supported?
+    static bool IsDeflateSupported() noexcept;
+
+    //! Get the compression mode
+    Mode mode() const noexcept { return _mode; }
+    //! Get the compression level
+    int level() const noexcept { return _level; }
+    //! Get the compression window bits
+    int window_bits() const noexcept { return _window_bits; }
+    //! Is the context takeover enabled?
+    bool context_takeover() const noexcept { return _context_takeover; }
+    //! Get the preset dictionary
+    const std::string& dictionary() const noexcept { return _dictionary; }
+
+    //! Setup no compression
+    void SetupNone();
+    //! Setup raw deflate compression
+    /*!
+        \param level - Compression level from 0 (no compression) to 9 (best compression) or -1 for the default level (default is -1)
+        \param window_bits - Compression window bits from 9 to 15 (default is 15)
+    */
+    void SetupDeflate(int level = -1, int window_bits = 15);
+    //! Setup context takeover
+    /*!
+        \param enable - Keep the compression window between messages (default is true)
+    */
+    void SetupContextTakeover(bool enable);
+    //! Setup preset dictionary
+    /*!
+        Only the last 32 KB of the dictionary are used.
+
+        \param dictionary - Preset dictionary (empty for no dictionary)
+    */
+    void SetupDictionary(std::string_view dictionary);
+
+    //! Reset the compression state
+    /*!
+        Drop the compression window of the previous messages.
+    */
+    void Reset();
+
+    //! Compress the message and append it to the output buffer
+    /*!
+        Message could be compressed by parts, only the last part completes
+        the message. Without compression the message is appended as is.
+
+        \param buffer - Message buffer
+        \param size - Message size
+        \param output - Output buffer
+        \param fin - Last part of the message flag (default is true)
+        \return 'true' if the message was successfully compressed, 'false' in case of the compression error
+    */
+    bool Compress(const void* buffer, size_t size, std::string& output, bool fin = true);
+    //! Decompress the message and append it to the output buffer
+    /*!
+        Decompressing stops as soon as the decompressed size exceeds the
+        limit, so the caller should check the output size to reject too
+        large messages without decompressing them completely. Without
+        compression the message is appended as is.
+
+        \param buffer - Compressed message buffer
+        \param size - Compressed message size
+        \param output - Output buffer
+        \param limit - Decompressed size limit or zero for no limit (default is 0)
+        \return 'true' if the message was successfully decompressed, 'false' in case of the invalid compressed message
+    */
+    bool Decompress(const void* buffer, size_t size, std::string& output, size_t limit = 0);
+
+private:
+    Mode _mode;
+    int _level;
+    int _window_bits;
+    bool _context_takeover;
+    std::string _dictionary;
+
+    // Compression streams
+    std::unique_ptr<z_stream_s> _deflate;
+    std::unique_ptr<z_stream_s> _inflate;
+
+    // Create compression streams
+    bool InitDeflate();
+    bool InitInflate();
+    // Reset compression streams for the next message
+    bool ResetDeflate();
+    bool ResetInflate();
+    // Process the input with compression streams
+    bool Deflate(const uint8_t* data, size_t size, std::string& output);
+    bool Inflate(const uint8_t* data, size_t size, std::string& output, size_t start, size_t limit);
+    // Destroy compression streams
+    void ReleaseDeflate();
+    void ReleaseInflate();
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_MESSAGE_COMPRESSION_H
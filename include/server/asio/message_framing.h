@@ -0,0 +1,163 @@
+/*!
+    \file message_framing.h
+    \brief Message framing definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_MESSAGE_FRAMING_H
+#define CPPSERVER_ASIO_MESSAGE_FRAMING_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CppServer {
+namespace Asio {
+
+//! Message framing
+/*!
+    Message framing splits the received byte stream into whole messages
+    and frames sent messages. Two framing modes are supported:
+    - length prefix - message is prefixed with its length in 1, 2, 4 or 8
+      bytes of the big-endian or little-endian byte order (default is 4
+      bytes big-endian)
+    - delimiter - message is terminated with the delimiter sequence
+
+    Whole messages are parsed in place of the received buffer. Only the
+    partial message at the end of the received buffer is copied into the
+    framing buffer and completed with the next received buffers.
+
+    Not thread-safe.
+*/
+class MessageFraming
+{
+public:
+    //! Framing mode
+    enum class Mode
+    {
+        LengthPrefix,   //!< Length-prefixed messages
+        Delimiter       //!< Delimiter-terminated messages
+    };
+
+    //! Length prefix byte order
+    enum class Endian
+    {
+        Big,            //!< Big-endian (network) byte order
+        Little          //!< Little-endian byte order
+    };
+
+    MessageFraming();
+    MessageFraming(const MessageFraming&) = default;
+    MessageFraming(MessageFraming&&) = default;
+    ~MessageFraming() = default;
+
+    MessageFraming& operator=(const MessageFraming&) = default;
+    MessageFraming& operator=(MessageFraming&&) = default;
+
+    //! Get the framing mode
+    Mode mode() const noexcept { return _mode; }
+    //! Get the length prefix width in bytes
+    size_t length_width() const noexcept { return _length_width; }
+    //! Get the length prefix byte order
+    Endian length_endian() const noexcept { return _length_endian; }
+    //! Get the delimiter sequence
+    const std::string& delimiter() const noexcept { return _delimiter; }
+    //! Get the maximal message size
+    size_t max_message_size() const noexcept { return _max_message_size; }
+
+    //! Get the count of pending bytes of the partial message
+    size_t pending() const noexcept { return _buffer.size(); }
+    //! Is the framing error occurred?
+    bool error() const noexcept { return _error; }
+
+    //! Setup length-prefixed framing
+    /*!
+        \param width - Length prefix width in bytes: 1, 2, 4 or 8 (default is 4)
+        \param endian - Length prefix byte order (default is Endian::Big)
+    */
+    void SetupLengthPrefix(size_t width = 4, Endian endian = Endian::Big);
+    //! Setup delimiter-terminated framing
+    /*!
+        \param delimiter - Non-empty delimiter sequence
+    */
+    void SetupDelimiter(std::string_view delimiter);
+    //! Setup the maximal message size
+    /*!
+        Receiving a larger message is the framing error. Zero value means
+        no limit (default).
+
+        \param size - Maximal message size in bytes
+    */
+    void SetupMaxMessageSize(size_t size) noexcept { _max_message_size = size; }
+
+    //! Reset the framing state
+    /*!
+        Drop the partial message and clear the framing error.
+    */
+    void Reset();
+
+    //! Receive the buffer and call the message handler for each whole message
+    /*!
+        Message handler is called with the message buffer and size without
+        the length prefix or the delimiter. Message buffer points into the
+        received buffer or into the framing buffer and is valid only during
+        the handler call.
+
+        \param buffer - Received buffer
+        \param size - Received buffer size
+        \param handler - Message handler with signature void(const void* buffer, size_t size)
+        \return 'true' if the buffer was successfully received, 'false' in case of the framing error
+    */
+    template <class THandler>
+    bool Receive(const void* buffer, size_t size, THandler&& handler);
+
+    //! Frame the message and append it to the output buffer
+    /*!
+        \param buffer - Message buffer
+        \param size - Message size
+        \param output - Output buffer
+        \return 'true' if the message was successfully framed, 'false' if the message size does not fit into the length prefix
+    */
+    bool Frame(const void* buffer, size_t size, std::vector<uint8_t>& output) const;
+
+private:
+    Mode _mode;
+    size_t _length_width;
+    Endian _length_endian;
+    std::string _delimiter;
+    size_t _max_message_size;
+
+    // Partial message buffer
+    std::vector<uint8_t> _buffer;
+    // Length of the partial length-prefixed message
+    size_t _length;
+    // Framing error flag
+    bool _error;
+
+    template <class THandler>
+    bool ReceiveLengthPrefix(const uint8_t* data, size_t size, THandler& handler);
+    template <class THandler>
+    bool ReceiveDelimiter(const uint8_t* data, size_t size, THandler& handler);
+
+    // Read and validate the length prefix
+    bool ReadLength(const uint8_t* data, size_t& length) const noexcept;
+    // Find the delimiter position or std::string::npos
+    size_t FindDelimiter(const uint8_t* data, size_t size) const noexcept;
+    // Check if the message size exceeds the limit
+    bool IsTooLarge(size_t size) const noexcept { return (_max_message_size > 0) && (size > _max_message_size); }
+    // Set the framing error
+    bool Fail();
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#include "message_framing.inl"
+
+#endif // CPPSERVER_ASIO_MESSAGE_FRAMING_H
@@ -0,0 +1,170 @@
+/*!
+    \file message_framing.inl
+    \brief Message framing inline implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppServer {
+namespace Asio {
+
+template <class THandler>
+inline bool MessageFraming::Receive(const void* buffer, size_t size, THandler&& handler)
+{
+    assert((buffer != nullptr) && "Pointer to the buffer should not be null!");
+    if (buffer == nullptr)
+        return false;
+
+    // Ignore the rest of the stream after the framing error
+    if (_error)
+        return false;
+
+    const uint8_t* data = (const uint8_t*)buffer;
+
+    if (_mode == Mode::LengthPrefix)
+        return ReceiveLengthPrefix(data, size, handler);
+    else
+        return ReceiveDelimiter(data, size, handler);
+}
+
+template <class THandler>
+inline bool MessageFraming::ReceiveLengthPrefix(const uint8_t* data, size_t size, THandler& handler)
+{
+    // Complete the partial message of the previous buffers
+    if (!_buffer.empty())
+    {
+        // Complete the length prefix
+        if (_buffer.size() < _length_width)
+        {
+            size_t chunk = std::min(_length_width - _buffer.size(), size);
+            _buffer.insert(_buffer.end(), data, data + chunk);
+            data += chunk;
+            size -= chunk;
+
+            // Wait for the rest of the length prefix
+            if (_buffer.size() < _length_width)
+                return true;
+
+            if (!ReadLength(_buffer.data(), _length))
+                return Fail();
+        }
+
+        // Complete the message body
+        size_t chunk = std::min(_length_width + _length - _buffer.size(), size);
+        _buffer.insert(_buffer.end(), data, data + chunk);
+        data += chunk;
+        size -= chunk;
+
+        // Wait for the rest of the message body
+        if (_buffer.size() < (_length_width + _length))
+            return true;
+
+        handler(_buffer.data() + _length_width, _length);
+        _buffer.clear();
+    }
+
+    // Parse whole messages in place of the received buffer
+    while (size >= _length_width)
+    {
+        size_t length;
+        if (!ReadLength(data, length))
+            return Fail();
+
+        // Keep the partial message
+        if ((size - _length_width) < length)
+        {
+            _length = length;
+            break;
+        }
+
+        handler(data + _length_width, length);
+        data += _length_width + length;
+        size -= _length_width + length;
+    }
+
+    // Copy the partial message into the framing buffer
+    if (size > 0)
+        _buffer.insert(_buffer.end(), data, data + size);
+
+    return true;
+}
+
+template <class THandler>
+inline bool MessageFraming::ReceiveDelimiter(const uint8_t* data, size_t size, THandler& handler)
+{
+    const size_t delimiter_size = _delimiter.size();
+
+    // Complete the partial message of the previous buffers
+    if (!_buffer.empty())
+    {
+        size_t offset = _buffer.size();
+
+        // Find the delimiter split between the framing buffer and the received buffer
+        size_t tail = std::min(delimiter_size - 1, size);
+        _buffer.insert(_buffer.end(), data, data + tail);
+        size_t start = (offset > (delimiter_size - 1)) ? (offset - (delimiter_size - 1)) : 0;
+        size_t found = FindDelimiter(_buffer.data() + start, _buffer.size() - start);
+        if (found != std::string::npos)
+        {
+            found += start;
+            size_t consumed = found + delimiter_size - offset;
+            data += consumed;
+            size -= consumed;
+        }
+        else
+        {
+            _buffer.resize(offset);
+
+            // Find the delimiter in the received buffer
+            found = FindDelimiter(data, size);
+            if (found == std::string::npos)
+            {
+                _buffer.insert(_buffer.end(), data, data + size);
+
+                // Wait for the rest of the message
+                return IsTooLarge(_buffer.size() - std::min(_buffer.size(), delimiter_size - 1)) ? Fail() : true;
+            }
+
+            _buffer.insert(_buffer.end(), data, data + found);
+            data += found + delimiter_size;
+            size -= found + delimiter_size;
+            found = _buffer.size();
+        }
+
+        if (IsTooLarge(found))
+            return Fail();
+
+        handler(_buffer.data(), found);
+        _buffer.clear();
+    }
+
+    // Parse whole messages in place of the received buffer
+    while (size > 0)
+    {
+        size_t found = FindDelimiter(data, size);
+        if (found == std::string::npos)
+            break;
+
+        if (IsTooLarge(found))
+            return Fail();
+
+        handler(data, found);
+        data += found + delimiter_size;
+        size -= found + delimiter_size;
+    }
+
+    // Copy the partial message into the framing buffer
+    if (size > 0)
+    {
+        if (IsTooLarge(size - std::min(size, delimiter_size - 1)))
+            return Fail();
+
+        _buffer.insert(_buffer.end(), data, data + size);
+    }
+
+    return true;
+}
+
+} // namespace Asio
+} // namespace CppServer
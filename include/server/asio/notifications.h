@@ -0,0 +1,70 @@
+/*!
+    \file notifications.h
+    \brief Pending notifications queue definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_NOTIFICATIONS_H
+#define CPPSERVER_ASIO_NOTIFICATIONS_H
+
+#include <mutex>
+#include <vector>
+
+namespace CppServer {
+namespace Asio {
+
+//! Pending notifications queue
+/*!
+    Pending notifications queue collects notifications produced under the
+    owner lock and dispatches them to handlers without holding the lock,
+    so handlers are allowed to call any owner method. Notifications are
+    dispatched in the queued order by one thread at a time, another thread
+    which tries to dispatch meanwhile leaves its notifications to the
+    dispatching thread.
+
+    Push() and Clear() should be called under the owner lock, Dispatch()
+    should be called without holding it.
+
+    Not thread-safe.
+*/
+template <class TNotification>
+class Notifications
+{
+public:
+    Notifications() = default;
+    Notifications(const Notifications&) = delete;
+    Notifications(Notifications&&) = delete;
+    ~Notifications() = default;
+
+    Notifications& operator=(const Notifications&) = delete;
+    Notifications& operator=(Notifications&&) = delete;
+
+    //! Queue the notification
+    /*!
+        \param notification - Notification to queue
+    */
+    void Push(TNotification notification) { _notifications.emplace_back(std::move(notification)); }
+    //! Clear pending notifications
+    void Clear() { _notifications.clear(); }
+
+    //! Dispatch pending notifications
+    /*!
+        \param lock - Owner lock which protects the queue
+        \param handler - Notification handler
+    */
+    template <class TLock, class THandler>
+    void Dispatch(TLock& lock, THandler&& handler);
+
+private:
+    std::vector<TNotification> _notifications;
+    bool _dispatching{false};
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#include "notifications.inl"
+
+#endif // CPPSERVER_ASIO_NOTIFICATIONS_H
@@ -0,0 +1,42 @@
+/*!
+    \file notifications.inl
+    \brief Pending notifications queue inline implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppServer {
+namespace Asio {
+
+template <class TNotification>
+template <class TLock, class THandler>
+inline void Notifications<TNotification>::Dispatch(TLock& lock, THandler&& handler)
+{
+    std::vector<TNotification> notifications;
+    for (;;)
+    {
+        {
+            std::scoped_lock locker(lock);
+
+            // Another thread is calling handlers and will take new notifications
+            if (_dispatching || _notifications.empty())
+                return;
+
+            _dispatching = true;
+            notifications.swap(_notifications);
+        }
+
+        for (auto& notification : notifications)
+            handler(notification);
+        notifications.clear();
+
+        {
+            std::scoped_lock locker(lock);
+            _dispatching = false;
+        }
+    }
+}
+
+} // namespace Asio
+} // namespace CppServer
@@ -0,0 +1,244 @@
+/*!
+    \file rudp_channel.h
+    \brief Reliable UDP channel definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_RUDP_CHANNEL_H
+#define CPPSERVER_ASIO_RUDP_CHANNEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace CppServer {
+namespace Asio {
+
+//! Reliable UDP channel
+/*!
+    Reliable UDP channel is a transport independent protocol state machine
+    which provides reliable ordered and unreliable unordered delivery of
+    messages between two peers over datagrams. Each message is carried by
+    a single datagram, so the message size is limited by MaxMessageSize.
+
+    Reliable messages are numbered with sequence numbers, acknowledged
+    with cumulative and selective acknowledgements (SACK), retransmitted
+    by the retransmission timeout (RTO) or the fast retransmit after three
+    later messages were acknowledged, and limited by the congestion window
+    with slow start, congestion avoidance and multiplicative decrease on
+    loss. Unreliable messages bypass the sequencing and the congestion
+    window.
+
+    Each channel reset starts a new random incarnation of the channel which
+    is stamped into every datagram. Datagram with another incarnation of
+    the peer means that the peer was restarted, so the channel drops the
+    state of the previous peer incarnation and starts sequences from zero.
+    Reliable messages which were not acknowledged by the previous peer
+    incarnation are dropped and passed to the onDropped() handler. Late
+    datagrams of the previous peer incarnation are ignored.
+
+    Datagram formats (all numbers are in network byte order):
+    - Reliable message: [type = 1 : 1][0 : 1][incarnation : 2][sequence : 4][payload]
+    - Unreliable message: [type = 2 : 1][0 : 1][incarnation : 2][payload]
+    - Acknowledgement: [type = 3 : 1][blocks : 1][incarnation : 2][cumulative : 4][[begin : 4][end : 4] * blocks]
+
+    Channel does not perform any IO. Prepared datagrams are passed to the
+    onSend() handler and delivered messages are passed to the onReceived()
+    handler. The owner should pass each received datagram to Receive() and
+    periodically call Flush() to send acknowledgements, retransmissions and
+    new messages allowed by the congestion window.
+
+    Not thread-safe.
+*/
+class RUDPChannel
+{
+public:
+    //! Maximal message size
+    static const size_t MaxMessageSize = 1200;
+    //! Maximal count of reordered messages buffered by the receiver
+    static const size_t MaxReorderSize = 4096;
+
+    RUDPChannel();
+    RUDPChannel(const RUDPChannel&) = delete;
+    RUDPChannel(RUDPChannel&&) = delete;
+    virtual ~RUDPChannel() = default;
+
+    RUDPChannel& operator=(const RUDPChannel&) = delete;
+    RUDPChannel& operator=(RUDPChannel&&) = delete;
+
+    //! Get the number of messages pending to be sent or acknowledged
+    size_t messages_pending() const noexcept { return _send_queue.size() + _send_window.size(); }
+    //! Get the number of messages sent by the channel
+    uint64_t messages_sent() const noexcept { return _messages_sent; }
+    //! Get the number of messages received by the channel
+    uint64_t messages_received() const noexcept { return _messages_received; }
+    //! Get the number of retransmitted messages
+    uint64_t messages_retransmitted() const noexcept { return _messages_retransmitted; }
+    //! Get the number of reliable messages dropped on peer restarts
+    uint64_t messages_dropped() const noexcept { return _messages_dropped; }
+    //! Get the number of detected peer restarts
+    uint64_t peer_resets() const noexcept { return _peer_resets; }
+
+    //! Get the congestion window in messages
+    double congestion_window() const noexcept { return _cwnd; }
+    //! Get the smoothed round-trip time in nanoseconds
+    uint64_t rtt() const noexcept { return _srtt; }
+    //! Get the retransmission timeout in nanoseconds
+    uint64_t rto() const noexcept { return _rto; }
+
+    //! Send reliable ordered message
+    /*!
+        \param buffer - Message buffer to send
+        \param size - Message buffer size
+        \return 'true' if the message was successfully queued, 'false' if the message is too large
+    */
+    bool SendReliable(const void* buffer, size_t size);
+    //! Send unreliable unordered message
+    /*!
+        Message is sent immediately with the onSend() handler.
+
+        \param buffer - Message buffer to send
+        \param size - Message buffer size
+        \return 'true' if the message was successfully sent, 'false' if the message is too large
+    */
+    bool SendUnreliable(const void* buffer, size_t size);
+
+    //! Receive datagram from the peer
+    /*!
+        \param buffer - Datagram buffer
+        \param size - Datagram buffer size
+        \param timestamp - Current timestamp in nanoseconds
+        \return 'true' if the datagram was successfully processed, 'false' if the datagram is malformed
+    */
+    bool Receive(const void* buffer, size_t size, uint64_t timestamp);
+
+    //! Flush acknowledgements, retransmissions and new messages
+    /*!
+        \param timestamp - Current timestamp in nanoseconds
+    */
+    void Flush(uint64_t timestamp);
+
+    //! Reset the channel state
+    /*!
+        Channel starts a new incarnation, so the peer will reset its state
+        on the next received datagram.
+    */
+    void Reset();
+
+protected:
+    //! Handle datagram send notification
+    /*!
+        Notification is called when the datagram should be sent to the peer.
+
+        \param buffer - Datagram buffer
+        \param size - Datagram buffer size
+    */
+    virtual void onSend(const void* buffer, size_t size) {}
+    //! Handle message received notification
+    /*!
+        Notification is called when another message was received from the
+        peer. Reliable messages are delivered in order.
+
+        \param buffer - Received message buffer
+        \param size - Received message buffer size
+    */
+    virtual void onReceived(const void* buffer, size_t size) {}
+    //! Handle message dropped notification
+    /*!
+        Notification is called for each reliable message which was not
+        acknowledged by the peer before its restart. Such message will
+        never be delivered. Messages are dropped in the send order.
+
+        \param buffer - Dropped message buffer
+        \param size - Dropped message buffer size
+    */
+    virtual void onDropped(const void* buffer, size_t size) {}
+
+private:
+    // Sequence numbers comparison with wrap around
+    struct SequenceLess
+    {
+        bool operator()(uint32_t a, uint32_t b) const noexcept { return (int32_t)(a - b) < 0; }
+    };
+    // Sent message waiting for acknowledgement
+    struct Packet
+    {
+        std::vector<uint8_t> datagram;
+        uint64_t timestamp;
+        size_t retransmits;
+        bool sacked;
+    };
+
+    // Channel incarnations
+    uint16_t _incarnation;
+    uint16_t _peer_incarnation;
+    uint16_t _previous_peer_incarnation;
+    // Sender state
+    uint32_t _send_sequence;
+    std::deque<std::vector<uint8_t>> _send_queue;
+    std::map<uint32_t, Packet, SequenceLess> _send_window;
+    // Congestion control
+    double _cwnd;
+    double _ssthresh;
+    bool _recovery;
+    uint32_t _recovery_sequence;
+    // Round-trip time estimation
+    uint64_t _srtt;
+    uint64_t _rttvar;
+    uint64_t _rto;
+    // Receiver state
+    uint32_t _receive_sequence;
+    std::map<uint32_t, std::vector<uint8_t>, SequenceLess> _receive_buffer;
+    bool _ack_required;
+    // Channel statistic
+    uint64_t _messages_sent;
+    uint64_t _messages_received;
+    uint64_t _messages_retransmitted;
+    uint64_t _messages_dropped;
+    uint64_t _peer_resets;
+
+    //! Reset sender and receiver state for a new peer incarnation
+    void ResetSequences();
+    //! Drop the given unacknowledged and queued reliable messages
+    void DropPending(const std::map<uint32_t, Packet, SequenceLess>& window, const std::deque<std::vector<uint8_t>>& queue);
+    //! Check the peer incarnation of the received datagram
+    /*!
+        \param incarnation - Peer incarnation of the received datagram
+        \return 'true' if the datagram should be processed, 'false' if the datagram belongs to the previous peer incarnation
+    */
+    bool CheckIncarnation(uint16_t incarnation);
+    //! Process acknowledgement datagram
+    bool ReceiveAck(const uint8_t* buffer, size_t size, uint64_t timestamp);
+    //! Update round-trip time estimation with a new sample
+    void UpdateRTT(uint64_t sample);
+    //! Retransmit the given packet
+    void Retransmit(Packet& packet, uint64_t timestamp);
+    //! Send acknowledgement datagram
+    void SendAck();
+};
+
+//! Reliable UDP channel notification
+/*!
+    Message received or dropped by the channel which is queued to be
+    notified without holding the channel lock.
+*/
+struct RUDPNotification
+{
+    enum class Type
+    {
+        Message,
+        Dropped
+    } type;
+    std::vector<uint8_t> message;
+
+    RUDPNotification(Type t, const void* buffer, size_t size) : type(t), message((const uint8_t*)buffer, (const uint8_t*)buffer + size) {}
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_RUDP_CHANNEL_H
@@ -0,0 +1,178 @@
+/*!
+    \file rudp_client.h
+    \brief Reliable UDP client definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_RUDP_CLIENT_H
+#define CPPSERVER_ASIO_RUDP_CLIENT_H
+
+#include "notifications.h"
+#include "rudp_channel.h"
+#include "timer.h"
+#include "udp_client.h"
+
+namespace CppServer {
+namespace Asio {
+
+//! Reliable UDP client
+/*!
+    Reliable UDP client is used to exchange reliable ordered and unreliable
+    unordered messages with the reliable UDP server. Datagrams received
+    from other endpoints than the connected server are ignored.
+
+    Client periodically flushes its channel to send acknowledgements,
+    retransmissions and new messages allowed by the congestion window.
+    Derived classes which override onConnected() or onDisconnected()
+    handlers must call the base implementation. Message handlers are
+    called one at a time without holding the channel lock, so they may
+    send new messages.
+
+    Thread-safe.
+*/
+class RUDPClient : public UDPClient
+{
+public:
+    using UDPClient::UDPClient;
+
+    RUDPClient(const RUDPClient&) = delete;
+    RUDPClient(RUDPClient&&) = delete;
+    virtual ~RUDPClient() = default;
+
+    RUDPClient& operator=(const RUDPClient&) = delete;
+    RUDPClient& operator=(RUDPClient&&) = delete;
+
+    //! Get the number of messages pending to be sent or acknowledged
+    size_t messages_pending() const { std::scoped_lock locker(_channel_lock); return _channel.messages_pending(); }
+    //! Get the number of messages sent by the client
+    uint64_t messages_sent() const { std::scoped_lock locker(_channel_lock); return _channel.messages_sent(); }
+    //! Get the number of messages received by the client
+    uint64_t messages_received() const { std::scoped_lock locker(_channel_lock); return _channel.messages_received(); }
+    //! Get the number of retransmitted messages
+    uint64_t messages_retransmitted() const { std::scoped_lock locker(_channel_lock); return _channel.messages_retransmitted(); }
+    //! Get the smoothed round-trip time in nanoseconds
+    uint64_t rtt() const { std::scoped_lock locker(_channel_lock); return _channel.rtt(); }
+    //! Get the number of reliable messages dropped on server restarts
+    uint64_t messages_dropped() const { std::scoped_lock locker(_channel_lock); return _channel.messages_dropped(); }
+    //! Get the number of detected peer restarts
+    uint64_t peer_resets() const { std::scoped_lock locker(_channel_lock); return _channel.peer_resets(); }
+
+    //! Get the option: flush interval
+    const CppCommon::Timespan& option_flush_interval() const noexcept { return _option_flush_interval; }
+    //! Get the option: maximal count of pending reliable messages
+    size_t option_max_pending() const noexcept { return _option_max_pending; }
+
+    //! Send reliable ordered message to the server
+    /*!
+        \param buffer - Message buffer to send
+        \param size - Message buffer size
+        \return 'true' if the message was successfully sent, 'false' if the client is not connected, the message is too large or too many messages are pending
+    */
+    virtual bool SendReliable(const void* buffer, size_t size);
+    //! Send reliable ordered text to the server
+    /*!
+        \param text - Text to send
+        \return 'true' if the text was successfully sent, 'false' if the client is not connected, the text is too large or too many messages are pending
+    */
+    virtual bool SendReliable(std::string_view text) { return SendReliable(text.data(), text.size()); }
+    //! Send unreliable unordered message to the server
+    /*!
+        \param buffer - Message buffer to send
+        \param size - Message buffer size
+        \return 'true' if the message was successfully sent, 'false' if the client is not connected or the message is too large
+    */
+    virtual bool SendUnreliable(const void* buffer, size_t size);
+    //! Send unreliable unordered text to the server
+    /*!
+        \param text - Text to send
+        \return 'true' if the text was successfully sent, 'false' if the client is not connected or the text is too large
+    */
+    virtual bool SendUnreliable(std::string_view text) { return SendUnreliable(text.data(), text.size()); }
+
+    //! Setup option: flush interval
+    /*!
+        Flush interval bounds the delay of acknowledgements and the
+        granularity of retransmission timeouts.
+
+        \param interval - Flush interval (default is 10 milliseconds)
+    */
+    void SetupFlushInterval(const CppCommon::Timespan& interval) noexcept { _option_flush_interval = interval; }
+    //! Setup option: maximal count of pending reliable messages
+    /*!
+        Reliable messages are pending until the server acknowledges them.
+        SendReliable() fails when the limit is reached.
+
+        \param messages - Maximal count of pending reliable messages (0 means no limit, default is 4096)
+    */
+    void SetupMaxPending(size_t messages) noexcept { _option_max_pending = messages; }
+
+protected:
+    //! Handle message received notification
+    /*!
+        Notification is called when another message was received from
+        the server. Reliable messages are delivered in order.
+
+        \param buffer - Received message buffer
+        \param size - Received message buffer size
+    */
+    virtual void onReceivedMessage(const void* buffer, size_t size) {}
+    //! Handle message dropped notification
+    /*!
+        Notification is called for each reliable message which was not
+        acknowledged by the server before its restart. Such message will
+        never be delivered.
+
+        \param buffer - Dropped message buffer
+        \param size - Dropped message buffer size
+    */
+    virtual void onDroppedMessage(const void* buffer, size_t size) {}
+
+    void onConnected() override;
+    void onDisconnected() override;
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) final;
+
+private:
+    // Pending notifications
+    Notifications<RUDPNotification> _notifications;
+    // Reliable UDP channel
+    class Channel : public RUDPChannel
+    {
+    public:
+        explicit Channel(RUDPClient& client) : _client(client) {}
+
+    protected:
+        void onSend(const void* buffer, size_t size) override { _client.SendAsync(buffer, size); }
+        void onReceived(const void* buffer, size_t size) override { _client._notifications.Push(RUDPNotification(RUDPNotification::Type::Message, buffer, size)); }
+        void onDropped(const void* buffer, size_t size) override { _client._notifications.Push(RUDPNotification(RUDPNotification::Type::Dropped, buffer, size)); }
+
+    private:
+        RUDPClient& _client;
+    };
+    mutable std::recursive_mutex _channel_lock;
+    Channel _channel{*this};
+    // Flush timer
+    std::mutex _timer_lock;
+    std::shared_ptr<Timer> _timer;
+    // Options
+    CppCommon::Timespan _option_flush_interval{CppCommon::Timespan::milliseconds(10)};
+    size_t _option_max_pending{4096};
+
+    //! Call handlers of pending notifications
+    /*!
+        Should be called without holding the channel lock.
+    */
+    void Notify();
+    //! Flush the client channel
+    /*!
+        \param timer - Flush timer which called the handler
+        \param canceled - Timer canceled flag
+    */
+    void Flush(const std::shared_ptr<Timer>& timer, bool canceled);
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_RUDP_CLIENT_H
@@ -0,0 +1,229 @@
+/*!
+    \file rudp_server.h
+    \brief Reliable UDP server definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_RUDP_SERVER_H
+#define CPPSERVER_ASIO_RUDP_SERVER_H
+
+#include "notifications.h"
+#include "rudp_channel.h"
+#include "udp_server.h"
+
+namespace CppServer {
+namespace Asio {
+
+//! Reliable UDP session
+/*!
+    Reliable UDP session is a virtual UDP session which owns a reliable
+    UDP channel providing reliable ordered and unreliable unordered
+    messages with the client. Message handlers are called one at a time
+    without holding the channel lock, so they may send new messages.
+
+    Thread-safe.
+*/
+class RUDPSession : public UDPSession
+{
+    friend class RUDPServer;
+
+public:
+    using UDPSession::UDPSession;
+
+    RUDPSession(const RUDPSession&) = delete;
+    RUDPSession(RUDPSession&&) = delete;
+    virtual ~RUDPSession() = default;
+
+    RUDPSession& operator=(const RUDPSession&) = delete;
+    RUDPSession& operator=(RUDPSession&&) = delete;
+
+    //! Get the number of messages pending to be sent or acknowledged
+    size_t messages_pending() const { std::scoped_lock locker(_channel_lock); return _channel.messages_pending(); }
+    //! Get the number of messages sent by the session
+    uint64_t messages_sent() const { std::scoped_lock locker(_channel_lock); return _channel.messages_sent(); }
+    //! Get the number of messages received by the session
+    uint64_t messages_received() const { std::scoped_lock locker(_channel_lock); return _channel.messages_received(); }
+    //! Get the number of retransmitted messages
+    uint64_t messages_retransmitted() const { std::scoped_lock locker(_channel_lock); return _channel.messages_retransmitted(); }
+    //! Get the smoothed round-trip time in nanoseconds
+    uint64_t rtt() const { std::scoped_lock locker(_channel_lock); return _channel.rtt(); }
+    //! Get the number of reliable messages dropped on client restarts
+    uint64_t messages_dropped() const { std::scoped_lock locker(_channel_lock); return _channel.messages_dropped(); }
+    //! Get the number of detected peer restarts
+    uint64_t peer_resets() const { std::scoped_lock locker(_channel_lock); return _channel.peer_resets(); }
+
+    //! Get the option: maximal count of pending reliable messages
+    size_t option_max_pending() const noexcept { return _option_max_pending; }
+
+    //! Send reliable ordered message to the client
+    /*!
+        \param buffer - Message buffer to send
+        \param size - Message buffer size
+        \return 'true' if the message was successfully sent, 'false' if the session is not connected, the message is too large or too many messages are pending
+    */
+    virtual bool SendReliable(const void* buffer, size_t size);
+    //! Send reliable ordered text to the client
+    /*!
+        \param text - Text to send
+        \return 'true' if the text was successfully sent, 'false' if the session is not connected, the text is too large or too many messages are pending
+    */
+    virtual bool SendReliable(std::string_view text) { return SendReliable(text.data(), text.size()); }
+    //! Send unreliable unordered message to the client
+    /*!
+        \param buffer - Message buffer to send
+        \param size - Message buffer size
+        \return 'true' if the message was successfully sent, 'false' if the session is not connected or the message is too large
+    */
+    virtual bool SendUnreliable(const void* buffer, size_t size);
+    //! Send unreliable unordered text to the client
+    /*!
+        \param text - Text to send
+        \return 'true' if the text was successfully sent, 'false' if the session is not connected or the text is too large
+    */
+    virtual bool SendUnreliable(std::string_view text) { return SendUnreliable(text.data(), text.size()); }
+
+    //! Setup option: maximal count of pending reliable messages
+    /*!
+        Reliable messages are pending until the client acknowledges them.
+        SendReliable() fails when the limit is reached.
+
+        \param messages - Maximal count of pending reliable messages (0 means no limit, default is 4096)
+    */
+    void SetupMaxPending(size_t messages) noexcept { _option_max_pending = messages; }
+
+protected:
+    //! Handle message received notification
+    /*!
+        Notification is called when another message was received from
+        the client. Reliable messages are delivered in order.
+
+        \param buffer - Received message buffer
+        \param size - Received message buffer size
+    */
+    virtual void onReceivedMessage(const void* buffer, size_t size) {}
+    //! Handle message dropped notification
+    /*!
+        Notification is called for each reliable message which was not
+        acknowledged by the client before its restart. Such message will
+        never be delivered.
+
+        \param buffer - Dropped message buffer
+        \param size - Dropped message buffer size
+    */
+    virtual void onDroppedMessage(const void* buffer, size_t size) {}
+
+    void onReceived(const void* buffer, size_t size) final;
+
+private:
+    // Pending notifications
+    Notifications<RUDPNotification> _notifications;
+    // Reliable UDP channel
+    class Channel : public RUDPChannel
+    {
+    public:
+        explicit Channel(RUDPSession& session) : _session(session) {}
+
+    protected:
+        void onSend(const void* buffer, size_t size) override { _session.SendAsync(buffer, size); }
+        void onReceived(const void* buffer, size_t size) override { _session._notifications.Push(RUDPNotification(RUDPNotification::Type::Message, buffer, size)); }
+        void onDropped(const void* buffer, size_t size) override { _session._notifications.Push(RUDPNotification(RUDPNotification::Type::Dropped, buffer, size)); }
+
+    private:
+        RUDPSession& _session;
+    };
+    mutable std::recursive_mutex _channel_lock;
+    Channel _channel{*this};
+    // Options
+    size_t _option_max_pending{4096};
+
+    //! Call handlers of pending notifications
+    /*!
+        Should be called without holding the channel lock.
+    */
+    void Notify();
+    //! Flush the session channel
+    void Flush();
+};
+
+//! Reliable UDP server
+/*!
+    Reliable UDP server is an UDP server in sessions mode which creates
+    reliable UDP sessions for client endpoints.
+
+    Server periodically flushes all sessions to send acknowledgements,
+    retransmissions and new messages allowed by congestion windows.
+    Derived classes which override onStarted() or onStopped() handlers
+    must call the base implementation.
+
+    Thread-safe.
+*/
+class RUDPServer : public UDPServer
+{
+public:
+    //! Initialize reliable UDP server with a given Asio service and port number
+    /*!
+        \param service - Asio service
+        \param port - Port number
+        \param protocol - Internet protocol type (default is IPv4)
+    */
+    RUDPServer(std::shared_ptr<Service> service, int port, InternetProtocol protocol = InternetProtocol::IPv4);
+    //! Initialize reliable UDP server with a given Asio service, server address and port number
+    /*!
+        \param service - Asio service
+        \param address - Server address
+        \param port - Port number
+    */
+    RUDPServer(std::shared_ptr<Service> service, const std::string& address, int port);
+    //! Initialize reliable UDP server with a given Asio service and endpoint
+    /*!
+        \param service - Asio service
+        \param endpoint - Server UDP endpoint
+    */
+    RUDPServer(std::shared_ptr<Service> service, const asio::ip::udp::endpoint& endpoint);
+    RUDPServer(const RUDPServer&) = delete;
+    RUDPServer(RUDPServer&&) = delete;
+    virtual ~RUDPServer() = default;
+
+    RUDPServer& operator=(const RUDPServer&) = delete;
+    RUDPServer& operator=(RUDPServer&&) = delete;
+
+    //! Get the option: flush interval
+    const CppCommon::Timespan& option_flush_interval() const noexcept { return _option_flush_interval; }
+
+    //! Setup option: flush interval
+    /*!
+        Flush interval bounds the delay of acknowledgements and the
+        granularity of retransmission timeouts.
+
+        \param interval - Flush interval (default is 10 milliseconds)
+    */
+    void SetupFlushInterval(const CppCommon::Timespan& interval) noexcept { _option_flush_interval = interval; }
+
+protected:
+    std::shared_ptr<UDPSession> CreateSession(std::shared_ptr<UDPServer> server, const asio::ip::udp::endpoint& endpoint) override { return std::make_shared<RUDPSession>(server, endpoint); }
+
+protected:
+    void onStarted() override;
+    void onStopped() override;
+
+private:
+    // Flush timer
+    std::mutex _timer_lock;
+    std::shared_ptr<Timer> _timer;
+    // Options
+    CppCommon::Timespan _option_flush_interval{CppCommon::Timespan::milliseconds(10)};
+
+    //! Flush all sessions
+    /*!
+        \param timer - Flush timer which called the handler
+        \param canceled - Timer canceled flag
+    */
+    void FlushAll(const std::shared_ptr<Timer>& timer, bool canceled);
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_RUDP_SERVER_H
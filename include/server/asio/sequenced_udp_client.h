@@ -0,0 +1,217 @@
+/*!
+    \file sequenced_udp_client.h
+    \brief Sequenced multicast UDP client definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_SEQUENCED_UDP_CLIENT_H
+#define CPPSERVER_ASIO_SEQUENCED_UDP_CLIENT_H
+
+#include "notifications.h"
+#include "timer.h"
+#include "udp_client.h"
+
+#include <map>
+
+namespace CppServer {
+namespace Asio {
+
+//! Sequenced multicast UDP client
+/*!
+    Sequenced multicast UDP client receives datagrams multicasted by the
+    sequenced multicast UDP server and delivers them in the sequence order.
+    Gaps in the sequence are detected by reordered datagrams and server
+    heartbeats, and recovered with unicast negative acknowledgements (NACK)
+    sent to the server. Gaps which cannot be recovered are reported with
+    the onGap() handler and skipped.
+
+    Client is synchronized with the first datagram or heartbeat received
+    after connect, so earlier datagrams are not requested.
+
+    Client accepts datagrams only from the configured server endpoint or,
+    if it is not configured, from the sender of the first datagram received
+    after connect. Datagrams from other endpoints are dropped.
+
+    Datagram with another server session means that the server was
+    restarted. Buffered messages of the previous session are delivered,
+    missed ones are reported with the onGap() handler, then onReset()
+    handler is called and the client is synchronized with the new session.
+    Late datagrams of the previous session are ignored.
+
+    onReceivedMessage(), onGap() and onReset() handlers are called without
+    holding the sequence state lock, so they are allowed to call any client
+    method. Handlers are called in the sequence order by one thread at
+    a time.
+
+    Derived classes which override onConnected(), onDisconnected() or
+    onReceived() handlers must call the base implementation.
+
+    Thread-safe.
+*/
+class SequencedUDPClient : public UDPClient
+{
+public:
+    using UDPClient::UDPClient;
+
+    SequencedUDPClient(const SequencedUDPClient&) = delete;
+    SequencedUDPClient(SequencedUDPClient&&) = delete;
+    virtual ~SequencedUDPClient() = default;
+
+    SequencedUDPClient& operator=(const SequencedUDPClient&) = delete;
+    SequencedUDPClient& operator=(SequencedUDPClient&&) = delete;
+
+    //! Get the next expected sequence number
+    uint64_t sequence() const noexcept { return _sequence; }
+    //! Get the number of NACK datagrams sent by the client
+    uint64_t nacks_sent() const noexcept { return _nacks_sent; }
+    //! Get the number of datagrams recovered by retransmission
+    uint64_t datagrams_recovered() const noexcept { return _datagrams_recovered; }
+    //! Get the number of lost datagrams
+    uint64_t datagrams_lost() const noexcept { return _datagrams_lost; }
+    //! Get the number of detected server restarts
+    uint64_t server_resets() const noexcept { return _server_resets; }
+
+    //! Get the option: NACK interval
+    const CppCommon::Timespan& option_nack_interval() const noexcept { return _option_nack_interval; }
+    //! Get the option: NACK retries
+    size_t option_nack_retries() const noexcept { return _option_nack_retries; }
+    //! Get the option: reorder buffer size
+    size_t option_reorder_buffer() const noexcept { return _option_reorder_buffer; }
+    //! Get the option: server endpoint
+    const asio::ip::udp::endpoint& option_server_endpoint() const noexcept { return _option_server_endpoint; }
+
+    //! Setup option: NACK interval
+    /*!
+        \param interval - Interval between NACK retries (default is 20 milliseconds)
+    */
+    void SetupNackInterval(const CppCommon::Timespan& interval) noexcept { _option_nack_interval = interval; }
+    //! Setup option: NACK retries
+    /*!
+        \param retries - Count of NACK retries before the gap is skipped (default is 5)
+    */
+    void SetupNackRetries(size_t retries) noexcept { _option_nack_retries = retries; }
+    //! Setup option: reorder buffer size
+    /*!
+        \param datagrams - Maximal count of datagrams buffered ahead of the gap (default is 4096)
+    */
+    void SetupReorderBuffer(size_t datagrams) noexcept { _option_reorder_buffer = (datagrams > 0) ? datagrams : 1; }
+    //! Setup option: server endpoint
+    /*!
+        Should be called before the client is connected.
+
+        \param endpoint - Endpoint of the sequenced server to accept datagrams from (default is the sender of the first datagram)
+    */
+    void SetupServerEndpoint(const asio::ip::udp::endpoint& endpoint) noexcept { _option_server_endpoint = endpoint; }
+
+protected:
+    //! Handle sequenced message received notification
+    /*!
+        Notification is called in the sequence order.
+
+        \param sequence - Message sequence number
+        \param buffer - Received message buffer
+        \param size - Received message buffer size
+    */
+    virtual void onReceivedMessage(uint64_t sequence, const void* buffer, size_t size) {}
+    //! Handle sequence gap notification
+    /*!
+        Notification is called when messages in the given sequence range
+        cannot be recovered and are skipped.
+
+        \param begin - First lost sequence number
+        \param end - Next sequence number after the last lost one
+    */
+    virtual void onGap(uint64_t begin, uint64_t end) {}
+    //! Handle server reset notification
+    /*!
+        Notification is called when the server restart was detected. The next
+        message will be delivered from the sequence of the new server session.
+    */
+    virtual void onReset() {}
+
+    void onConnected() override;
+    void onDisconnected() override;
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override;
+
+private:
+    // Sequence state
+    std::mutex _sequence_lock;
+    bool _synchronized{false};
+    uint16_t _session{0};
+    uint16_t _previous_session{0};
+    std::atomic<uint64_t> _sequence{0};
+    uint64_t _highest{0};
+    std::map<uint64_t, std::vector<uint8_t>> _reorder_buffer;
+    asio::ip::udp::endpoint _server_endpoint;
+    size_t _nack_retries{0};
+    // Pending notifications
+    struct Notification
+    {
+        enum class Type
+        {
+            Message,
+            Gap,
+            Reset
+        } type;
+        uint64_t begin;
+        uint64_t end;
+        std::vector<uint8_t> message;
+    };
+    Notifications<Notification> _notifications;
+    // NACK timer
+    std::mutex _timer_lock;
+    std::shared_ptr<Timer> _timer;
+    // Client statistic
+    std::atomic<uint64_t> _nacks_sent{0};
+    std::atomic<uint64_t> _datagrams_recovered{0};
+    std::atomic<uint64_t> _datagrams_lost{0};
+    std::atomic<uint64_t> _server_resets{0};
+    // Options
+    CppCommon::Timespan _option_nack_interval{CppCommon::Timespan::milliseconds(20)};
+    size_t _option_nack_retries{5};
+    size_t _option_reorder_buffer{4096};
+    asio::ip::udp::endpoint _option_server_endpoint;
+
+    //! Check the sender endpoint of the received datagram
+    /*!
+        \param endpoint - Sender endpoint
+        \return 'true' if the datagram was sent by the server, 'false' if the datagram should be dropped
+    */
+    bool CheckEndpoint(const asio::ip::udp::endpoint& endpoint);
+    //! Check the server session of the received datagram
+    /*!
+        \param session - Server session of the received datagram
+        \return 'true' if the datagram should be processed, 'false' if the datagram belongs to the previous server session
+    */
+    bool CheckSession(uint16_t session);
+    //! Synchronize the sequence with the server
+    void Synchronize(uint64_t sequence);
+    //! Deliver buffered messages in the sequence order
+    /*!
+        Should be called under the sequence state lock. Messages are queued
+        into pending notifications.
+    */
+    void Deliver();
+    //! Skip lost messages up to the given sequence number
+    void Skip(uint64_t end);
+    //! Send NACK for all gaps
+    void SendNack();
+    //! Retry NACK or skip the oldest gap
+    /*!
+        \param timer - NACK timer which called the handler
+        \param canceled - Timer canceled flag
+    */
+    void Recover(const std::shared_ptr<Timer>& timer, bool canceled);
+    //! Call handlers of pending notifications
+    /*!
+        Should be called without holding the sequence state lock.
+    */
+    void Notify();
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_SEQUENCED_UDP_CLIENT_H
@@ -0,0 +1,189 @@
+/*!
+    \file sequenced_udp_server.h
+    \brief Sequenced multicast UDP server definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_SEQUENCED_UDP_SERVER_H
+#define CPPSERVER_ASIO_SEQUENCED_UDP_SERVER_H
+
+#include "timer.h"
+#include "udp_server.h"
+
+#include <map>
+
+namespace CppServer {
+namespace Asio {
+
+//! Sequenced multicast UDP server
+/*!
+    Sequenced multicast UDP server stamps each multicast datagram with
+    a sequence number and keeps the last datagrams in a bounded retransmit
+    ring. Clients detect gaps in the sequence and request missed datagrams
+    with unicast negative acknowledgements (NACK). Requested datagrams are
+    retransmitted by unicast, datagrams which already left the ring are
+    reported as lost. Overlapping NACK ranges are merged, datagrams
+    retransmitted for one NACK are limited and each client endpoint has
+    its own retransmit rate budget, so clients are not able to flood the
+    server with retransmissions. Datagrams which were not retransmitted
+    because of these limits will be requested by the next client NACK.
+    Server multicasts heartbeats with the next sequence
+    number when idle, so clients are able to detect the loss of the last
+    datagram.
+
+    Each server start begins a new random session with sequences from zero.
+    The session is stamped into every datagram, so clients detect the server
+    restart and re-synchronize with the new sequence. NACK datagrams of
+    another session are ignored.
+
+    Datagram formats (all numbers are in network byte order):
+    - Data: [type = 1 : 1][0 : 1][session : 2][sequence : 8][payload]
+    - NACK: [type = 2 : 1][ranges : 1][session : 2][[begin : 8][end : 8] * ranges]
+    - Lost: [type = 3 : 1][0 : 1][session : 2][begin : 8][end : 8]
+    - Heartbeat: [type = 4 : 1][0 : 1][session : 2][next sequence : 8]
+
+    Derived classes which override onStarted(), onStopped() or onReceived()
+    handlers must call the base implementation.
+
+    Thread-safe.
+*/
+class SequencedUDPServer : public UDPServer
+{
+public:
+    using UDPServer::UDPServer;
+
+    SequencedUDPServer(const SequencedUDPServer&) = delete;
+    SequencedUDPServer(SequencedUDPServer&&) = delete;
+    virtual ~SequencedUDPServer() = default;
+
+    SequencedUDPServer& operator=(const SequencedUDPServer&) = delete;
+    SequencedUDPServer& operator=(SequencedUDPServer&&) = delete;
+
+    //! Get the current session
+    uint16_t session() const noexcept { return _session; }
+    //! Get the next sequence number
+    uint64_t sequence() const noexcept { return _sequence; }
+    //! Get the number of NACK datagrams received by the server
+    uint64_t nacks_received() const noexcept { return _nacks_received; }
+    //! Get the number of datagrams retransmitted by the server
+    uint64_t datagrams_retransmitted() const noexcept { return _datagrams_retransmitted; }
+
+    //! Get the option: retransmit ring size
+    size_t option_retransmit_ring() const noexcept { return _option_retransmit_ring; }
+    //! Get the option: retransmit limit
+    size_t option_retransmit_limit() const noexcept { return _option_retransmit_limit; }
+    //! Get the option: retransmit rate
+    size_t option_retransmit_rate() const noexcept { return _option_retransmit_rate; }
+    //! Get the option: heartbeat interval
+    const CppCommon::Timespan& option_heartbeat_interval() const noexcept { return _option_heartbeat_interval; }
+
+    using UDPServer::Multicast;
+    using UDPServer::MulticastAsync;
+
+    //! Multicast sequenced datagram to the prepared multicast endpoint (synchronous)
+    /*!
+        \param buffer - Datagram buffer to multicast
+        \param size - Datagram buffer size
+        \return Size of multicasted datagram payload
+    */
+    size_t Multicast(const void* buffer, size_t size) override;
+    //! Multicast sequenced datagram to the prepared multicast endpoint with timeout (synchronous)
+    /*!
+        \param buffer - Datagram buffer to multicast
+        \param size - Datagram buffer size
+        \param timeout - Timeout
+        \return Size of multicasted datagram payload
+    */
+    size_t Multicast(const void* buffer, size_t size, const CppCommon::Timespan& timeout) override;
+    //! Multicast sequenced datagram to the prepared multicast endpoint (asynchronous)
+    /*!
+        \param buffer - Datagram buffer to multicast
+        \param size - Datagram buffer size
+        \return 'true' if the datagram was successfully multicasted, 'false' if the datagram was not multicasted
+    */
+    bool MulticastAsync(const void* buffer, size_t size) override;
+
+    //! Setup option: retransmit ring size
+    /*!
+        Should be called before the server is started.
+
+        \param datagrams - Count of the last multicasted datagrams kept for retransmission (default is 4096)
+    */
+    void SetupRetransmitRing(size_t datagrams) noexcept { _option_retransmit_ring = (datagrams > 0) ? datagrams : 1; }
+    //! Setup option: retransmit limit
+    /*!
+        \param datagrams - Maximal count of datagrams retransmitted for one NACK (default is 1024)
+    */
+    void SetupRetransmitLimit(size_t datagrams) noexcept { _option_retransmit_limit = (datagrams > 0) ? datagrams : 1; }
+    //! Setup option: retransmit rate
+    /*!
+        \param datagrams - Maximal count of datagrams retransmitted to one client endpoint per second or zero for no limit (default is 16384)
+    */
+    void SetupRetransmitRate(size_t datagrams) noexcept { _option_retransmit_rate = datagrams; }
+    //! Setup option: heartbeat interval
+    /*!
+        \param interval - Idle heartbeat interval (default is 100 milliseconds)
+    */
+    void SetupHeartbeatInterval(const CppCommon::Timespan& interval) noexcept { _option_heartbeat_interval = interval; }
+
+protected:
+    void onStarted() override;
+    void onStopped() override;
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override;
+
+private:
+    // Retransmit ring
+    std::mutex _ring_lock;
+    std::atomic<uint16_t> _session{0};
+    std::atomic<uint64_t> _sequence{0};
+    std::vector<std::vector<uint8_t>> _ring;
+    std::atomic<bool> _multicasted{false};
+    // Retransmit rate budgets of client endpoints
+    struct Budget
+    {
+        double datagrams;
+        uint64_t timestamp;
+    };
+    std::map<asio::ip::udp::endpoint, Budget> _budgets;
+    // Heartbeat timer
+    std::mutex _timer_lock;
+    std::shared_ptr<Timer> _timer;
+    // Server statistic
+    std::atomic<uint64_t> _nacks_received{0};
+    std::atomic<uint64_t> _datagrams_retransmitted{0};
+    // Options
+    size_t _option_retransmit_ring{4096};
+    size_t _option_retransmit_limit{1024};
+    size_t _option_retransmit_rate{16384};
+    CppCommon::Timespan _option_heartbeat_interval{CppCommon::Timespan::milliseconds(100)};
+
+    //! Stamp the datagram with the next sequence number and keep it in the retransmit ring
+    /*!
+        Should be called under the retransmit ring lock, so datagrams are
+        multicasted in the sequence order.
+    */
+    const std::vector<uint8_t>& Prepare(const void* buffer, size_t size);
+    //! Take datagrams from the retransmit rate budget of the client endpoint
+    /*!
+        Should be called under the retransmit ring lock.
+
+        \param endpoint - Client endpoint
+        \param datagrams - Count of datagrams requested to retransmit
+        \param timestamp - Current timestamp in nanoseconds
+        \return Count of datagrams allowed to retransmit
+    */
+    size_t TakeBudget(const asio::ip::udp::endpoint& endpoint, size_t datagrams, uint64_t timestamp);
+    //! Multicast heartbeat if the server is idle
+    /*!
+        \param timer - Heartbeat timer which called the handler
+        \param canceled - Timer canceled flag
+    */
+    void Heartbeat(const std::shared_ptr<Timer>& timer, bool canceled);
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_SEQUENCED_UDP_SERVER_H
@@ -10,7 +10,9 @@
 #define CPPSERVER_ASIO_SSL_CLIENT_H
 
 #include "ssl_context.h"
+#include "tcp_connector.h"
 #include "tcp_resolver.h"
+#include "timer.h"
 
 #include "system/uuid.h"
 #include "time/timespan.h"
@@ -95,11 +97,37 @@ public:
     bool option_keep_alive() const noexcept;
     //! Get the option: no delay
     bool option_no_delay() const noexcept;
+    //! Get the option: happy eyeballs
+    bool option_happy_eyeballs() const noexcept;
+    //! Get the option: connection attempt delay
+    const CppCommon::Timespan& option_connection_attempt_delay() const noexcept;
+    //! Get the option: connect timeout
+    const CppCommon::Timespan& option_connect_timeout() const noexcept;
+    //! Get the option: handshake timeout
+    const CppCommon::Timespan& option_handshake_timeout() const noexcept;
+    //! Get the option: reconnect
+    bool option_reconnect() const noexcept;
+    //! Get the option: reconnect delay
+    const CppCommon::Timespan& option_reconnect_delay() const noexcept;
+    //! Get the option: reconnect maximal delay
+    const CppCommon::Timespan& option_reconnect_max_delay() const noexcept;
+    //! Get the option: reconnect attempts
+    size_t option_reconnect_attempts() const noexcept;
+    //! Get the option: reconnect timeout
+    const CppCommon::Timespan& option_reconnect_timeout() const noexcept;
+    //! Get the option: reconnect preserve
+    bool option_reconnect_preserve() const noexcept;
     //! Get the option: receive buffer size
     size_t option_receive_buffer_size() const;
     //! Get the option: send buffer size
     size_t option_send_buffer_size() const;
 
+    //! Get the application protocol negotiated with the server (ALPN)
+    /*!
+        \return Negotiated application protocol or empty string if the protocol was not negotiated
+    */
+    std::string alpn_protocol();
+
     //! Is the client connected?
     bool IsConnected() const noexcept;
     //! Is the session handshaked?
@@ -142,7 +170,7 @@ public:
     /*!
         \return 'true' if the client was successfully disconnected, 'false' if the client is already disconnected
     */
-    virtual bool DisconnectAsync() { return DisconnectAsync(false); }
+    virtual bool DisconnectAsync();
     //! Reconnect the client (asynchronous)
     /*!
         \return 'true' if the client was successfully reconnected, 'false' if the client is already reconnected
@@ -242,6 +270,105 @@ public:
         \param enable - Enable/disable option
     */
     void SetupNoDelay(bool enable) noexcept;
+    //! Setup option: happy eyeballs
+    /*!
+        This option will race asynchronous connection attempts to the
+        resolved endpoints interleaving IPv6 and IPv4 addresses instead
+        of trying them one by one. The first established connection is
+        used for SSL handshake, other attempts are canceled.
+
+        https://tools.ietf.org/html/rfc8305
+
+        \param enable - Enable/disable option
+    */
+    void SetupHappyEyeballs(bool enable) noexcept;
+    //! Setup option: connection attempt delay
+    /*!
+        This option will setup the delay before the next connection attempt
+        is started in the happy eyeballs mode. Default delay is 250 milliseconds.
+
+        \param delay - Connection attempt delay
+    */
+    void SetupConnectionAttemptDelay(const CppCommon::Timespan& delay) noexcept;
+    //! Setup option: connect timeout
+    /*!
+        This option will abort the asynchronous connect attempt (including
+        DNS resolve) which is not connected within the given timeout and
+        report the timed out error. Zero value means no timeout (default).
+
+        Timed out DNS resolve fails the connect attempt immediately. The
+        resolve itself cannot be canceled, so its late result is ignored.
+
+        \param timeout - Connect timeout
+    */
+    void SetupConnectTimeout(const CppCommon::Timespan& timeout) noexcept;
+    //! Setup option: handshake timeout
+    /*!
+        This option will disconnect the client which is not handshaked
+        within the given timeout after it is connected and report the timed
+        out error. Zero value means no timeout (default).
+
+        \param timeout - Handshake timeout
+    */
+    void SetupHandshakeTimeout(const CppCommon::Timespan& timeout) noexcept;
+    //! Setup option: reconnect
+    /*!
+        This option will reconnect the client automatically when the connection
+        is lost or the asynchronous connect or SSL handshake fails. Reconnect
+        attempts are delayed with exponential backoff and jitter, so many clients
+        disconnected at once are not reconnected to the server at once. Automatic
+        reconnect is stopped by Disconnect() or DisconnectAsync() methods and
+        resumed by the next connect.
+
+        \param enable - Enable/disable option
+    */
+    void SetupReconnect(bool enable) noexcept;
+    //! Setup option: reconnect delay
+    /*!
+        This option will setup the delay before the first reconnect attempt.
+        The delay is doubled for each next attempt up to the reconnect maximal
+        delay and randomized between its half and its full value. Default delay
+        is 1 second.
+
+        \param delay - Reconnect delay
+    */
+    void SetupReconnectDelay(const CppCommon::Timespan& delay) noexcept;
+    //! Setup option: reconnect maximal delay
+    /*!
+        This option will limit the exponential backoff of reconnect attempts.
+        Default maximal delay is 30 seconds.
+
+        \param delay - Reconnect maximal delay
+    */
+    void SetupReconnectMaxDelay(const CppCommon::Timespan& delay) noexcept;
+    //! Setup option: reconnect attempts
+    /*!
+        This option will limit the count of reconnect attempts in a row.
+        Zero value means unlimited reconnect attempts (default).
+
+        \param attempts - Reconnect attempts
+    */
+    void SetupReconnectAttempts(size_t attempts) noexcept;
+    //! Setup option: reconnect timeout
+    /*!
+        This option will abort the asynchronous connect attempt or SSL handshake
+        of the client with automatic reconnect which is not completed within the
+        given timeout and report the timed out error. The shortest of the connect
+        (handshake) timeout and the reconnect timeout is used. Zero value means
+        no timeout (default).
+
+        \param timeout - Reconnect timeout
+    */
+    void SetupReconnectTimeout(const CppCommon::Timespan& timeout) noexcept;
+    //! Setup option: reconnect preserve
+    /*!
+        This option will preserve the data pending to send when the connection
+        is lost and send it after reconnect and SSL handshake. Data could be
+        sent asynchronously while the client is reconnecting.
+
+        \param enable - Enable/disable option
+    */
+    void SetupReconnectPreserve(bool enable) noexcept;
     //! Setup option: receive buffer size
     /*!
         This option will setup SO_RCVBUF if the OS support this feature.
@@ -0,0 +1,255 @@
+/*!
+    \file ssl_client_pool.h
+    \brief SSL client connection pool definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_SSL_CLIENT_POOL_H
+#define CPPSERVER_ASIO_SSL_CLIENT_POOL_H
+
+#include "ssl_client.h"
+#include "tcp_resolver.h"
+#include "timer.h"
+
+#include "time/timestamp.h"
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace CppServer {
+namespace Asio {
+
+//! SSL client connection pool
+/*!
+    SSL client connection pool keeps handshaked SSL clients to the same
+    server ready to be leased. Minimal count of clients is connected when
+    the pool is started and kept connected by the periodic health check.
+    New clients are connected on demand up to the maximal count, leases
+    above it wait for the first returned client. Idle clients above the
+    minimal count are disconnected after the idle timeout, unhealthy idle
+    clients are disconnected and replaced.
+
+    Leased client is used as a regular SSL client and should be returned
+    back to the pool with Return() method. Disconnected client is never
+    leased and is dropped when it is returned.
+
+    SSL client type should be constructible from the Asio service, SSL
+    context, server address and port number.
+
+    SSL client connection pool should be created with std::make_shared().
+
+    Thread-safe.
+*/
+template <class TClient = SSLClient>
+class SSLClientPool : public std::enable_shared_from_this<SSLClientPool<TClient>>
+{
+public:
+    //! Lease handler
+    typedef std::function<void(std::shared_ptr<TClient>)> LeaseHandler;
+
+    //! Initialize SSL client connection pool with a given Asio service, SSL context, server address and port number
+    /*!
+        \param service - Asio service
+        \param context - SSL context
+        \param address - Server address
+        \param port - Server port number
+        \param min_size - Minimal count of connected clients (default is 0)
+        \param max_size - Maximal count of clients (default is 8)
+    */
+    SSLClientPool(std::shared_ptr<Service> service, std::shared_ptr<SSLContext> context, const std::string& address, int port, size_t min_size = 0, size_t max_size = 8);
+    SSLClientPool(const SSLClientPool&) = delete;
+    SSLClientPool(SSLClientPool&&) = delete;
+    virtual ~SSLClientPool() = default;
+
+    SSLClientPool& operator=(const SSLClientPool&) = delete;
+    SSLClientPool& operator=(SSLClientPool&&) = delete;
+
+    //! Get the Asio service
+    std::shared_ptr<Service>& service() noexcept { return _service; }
+    //! Get the SSL context
+    std::shared_ptr<SSLContext>& context() noexcept { return _context; }
+    //! Get the TCP resolver
+    std::shared_ptr<TCPResolver>& resolver() noexcept { return _resolver; }
+    //! Get the server address
+    const std::string& address() const noexcept { return _address; }
+    //! Get the server port number
+    int port() const noexcept { return _port; }
+
+    //! Get the minimal count of connected clients
+    size_t min_size() const noexcept { return _min_size; }
+    //! Get the maximal count of clients
+    size_t max_size() const noexcept { return _max_size; }
+
+    //! Get the count of clients (connecting, idle and leased)
+    size_t size();
+    //! Get the count of idle clients
+    size_t idle();
+    //! Get the count of leased clients
+    size_t leased();
+
+    //! Get the option: idle timeout
+    const CppCommon::Timespan& option_idle_timeout() const noexcept { return _option_idle_timeout; }
+    //! Get the option: health check interval
+    const CppCommon::Timespan& option_health_check_interval() const noexcept { return _option_health_check_interval; }
+    //! Get the option: connect timeout
+    const CppCommon::Timespan& option_connect_timeout() const noexcept { return _option_connect_timeout; }
+    //! Get the option: handshake timeout
+    const CppCommon::Timespan& option_handshake_timeout() const noexcept { return _option_handshake_timeout; }
+
+    //! Is the pool started?
+    bool IsStarted();
+
+    //! Start the pool
+    /*!
+        Connect the minimal count of clients and start the health check.
+
+        \return 'true' if the pool was successfully started, 'false' if the pool failed to start
+    */
+    virtual bool Start();
+    //! Stop the pool
+    /*!
+        Disconnect all idle and connecting clients and fail all pending leases.
+        Leased clients are disconnected when they are returned.
+
+        \return 'true' if the pool was successfully stopped, 'false' if the pool is already stopped
+    */
+    virtual bool Stop();
+
+    //! Try to lease the idle client
+    /*!
+        Connect a new client if there is no idle one and the maximal count
+        of clients is not reached.
+
+        \return Leased client or nullptr if there is no idle client
+    */
+    std::shared_ptr<TClient> TryLease();
+    //! Lease the client (asynchronous)
+    /*!
+        Lease handler is called once with the leased client or with nullptr
+        if the lease timeout expired or the pool was stopped. It is called
+        in the calling thread if the idle client is available, otherwise in
+        the Asio service thread.
+
+        \param handler - Lease handler
+        \param timeout - Lease timeout (default is 1 minute)
+    */
+    void LeaseAsync(const LeaseHandler& handler, const CppCommon::Timespan& timeout = CppCommon::Timespan::minutes(1));
+    //! Return the leased client back to the pool
+    /*!
+        \param client - Leased client
+    */
+    void Return(std::shared_ptr<TClient> client);
+
+    //! Setup option: idle timeout
+    /*!
+        \param timeout - Idle timeout (default is 1 minute)
+    */
+    void SetupIdleTimeout(const CppCommon::Timespan& timeout) noexcept { _option_idle_timeout = timeout; }
+    //! Setup option: health check interval
+    /*!
+        \param interval - Health check interval (default is 1 second)
+    */
+    void SetupHealthCheckInterval(const CppCommon::Timespan& interval) noexcept { _option_health_check_interval = interval; }
+    //! Setup option: connect timeout
+    /*!
+        This option will setup the connect timeout of new clients, so the
+        client stuck in connecting does not hold its place in the pool.
+        Zero value means no timeout (default).
+
+        \param timeout - Connect timeout
+    */
+    void SetupConnectTimeout(const CppCommon::Timespan& timeout) noexcept { _option_connect_timeout = timeout; }
+    //! Setup option: handshake timeout
+    /*!
+        This option will setup the SSL handshake timeout of new clients.
+        Zero value means no timeout (default).
+
+        \param timeout - Handshake timeout
+    */
+    void SetupHandshakeTimeout(const CppCommon::Timespan& timeout) noexcept { _option_handshake_timeout = timeout; }
+
+protected:
+    //! Handle the idle client health check
+    /*!
+        Notification is called by the periodic health check for each idle
+        client without holding the pool lock, so the client could be leased
+        while it is checked. Unhealthy client is disconnected only if it is
+        still idle after the check. Default implementation checks that the
+        client is still connected and handshaked.
+
+        \param client - Idle client
+        \return 'true' if the client is healthy, 'false' if the client should be disconnected
+    */
+    virtual bool onHealthCheck(TClient& client) { return client.IsHandshaked(); }
+
+private:
+    class Client;
+
+    // Pending lease
+    struct Waiter
+    {
+        LeaseHandler handler;
+        std::shared_ptr<Timer> timer;
+    };
+
+    // Asio service
+    std::shared_ptr<Service> _service;
+    // SSL context
+    std::shared_ptr<SSLContext> _context;
+    // TCP resolver shared by all clients
+    std::shared_ptr<TCPResolver> _resolver;
+    // Server address & port
+    std::string _address;
+    int _port;
+    // Pool size limits
+    size_t _min_size;
+    size_t _max_size;
+    // Pool state
+    std::mutex _lock;
+    bool _started;
+    std::vector<std::shared_ptr<Client>> _clients;
+    std::deque<std::shared_ptr<Client>> _idle;
+    std::deque<std::shared_ptr<Waiter>> _waiters;
+    std::shared_ptr<Timer> _health_timer;
+    // Options
+    CppCommon::Timespan _option_idle_timeout;
+    CppCommon::Timespan _option_health_check_interval;
+    CppCommon::Timespan _option_connect_timeout;
+    CppCommon::Timespan _option_handshake_timeout;
+
+    // Create new client (requires the lock)
+    void Create(std::vector<std::shared_ptr<Client>>& connecting);
+    // Create new clients up to the minimal count (requires the lock)
+    void Grow(std::vector<std::shared_ptr<Client>>& connecting);
+    // Create new clients for pending leases up to the maximal count (requires the lock)
+    void Demand(size_t leases, std::vector<std::shared_ptr<Client>>& connecting);
+    // Connect created clients
+    void Connect(const std::vector<std::shared_ptr<Client>>& connecting);
+    // Take the most recently used idle client (requires the lock)
+    std::shared_ptr<Client> Take();
+    // Lease the ready client to the first waiter or put it into the idle list (requires the lock)
+    std::shared_ptr<Waiter> Release(const std::shared_ptr<Client>& client);
+    // Remove the client from the pool (requires the lock)
+    bool Remove(const std::shared_ptr<Client>& client);
+    // Schedule the next health check (requires the lock)
+    void Schedule();
+
+    // Client notifications
+    void onClientReady(const std::shared_ptr<Client>& client);
+    void onClientDisconnected(const std::shared_ptr<Client>& client);
+    void onWaiterTimeout(const std::shared_ptr<Waiter>& waiter);
+    void onHealthTimer();
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#include "ssl_client_pool.inl"
+
+#endif // CPPSERVER_ASIO_SSL_CLIENT_POOL_H
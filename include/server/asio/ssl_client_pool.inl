@@ -0,0 +1,481 @@
+/*!
+    \file ssl_client_pool.inl
+    \brief SSL client connection pool inline implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppServer {
+namespace Asio {
+
+//! SSL client connection pool client
+template <class TClient>
+class SSLClientPool<TClient>::Client : public TClient
+{
+public:
+    using TClient::TClient;
+
+    // Pool of the client (set once before the client is connected)
+    std::weak_ptr<SSLClientPool<TClient>> pool;
+
+    // Client state (protected by the pool lock)
+    bool ready{false};
+    bool leased{false};
+    uint64_t timestamp{0};
+
+protected:
+    void onHandshaked() override
+    {
+        TClient::onHandshaked();
+
+        auto instance = pool.lock();
+        if (instance)
+            instance->onClientReady(std::static_pointer_cast<Client>(this->shared_from_this()));
+    }
+
+    void onDisconnected() override
+    {
+        TClient::onDisconnected();
+
+        auto instance = pool.lock();
+        if (instance)
+            instance->onClientDisconnected(std::static_pointer_cast<Client>(this->shared_from_this()));
+    }
+};
+
+template <class TClient>
+inline SSLClientPool<TClient>::SSLClientPool(std::shared_ptr<Service> service, std::shared_ptr<SSLContext> context, const std::string& address, int port, size_t min_size, size_t max_size)
+    : _service(service),
+      _context(context),
+      _resolver(std::make_shared<TCPResolver>(service)),
+      _address(address),
+      _port(port),
+      _min_size(min_size),
+      _max_size(std::max(min_size, max_size)),
+      _started(false),
+      _option_idle_timeout(CppCommon::Timespan::minutes(1)),
+      _option_health_check_interval(CppCommon::Timespan::seconds(1)),
+      _option_connect_timeout(CppCommon::Timespan::zero()),
+      _option_handshake_timeout(CppCommon::Timespan::zero())
+{
+    assert((max_size > 0) && "Maximal count of clients must be greater than zero!");
+}
+
+template <class TClient>
+inline size_t SSLClientPool<TClient>::size()
+{
+    std::scoped_lock locker(_lock);
+    return _clients.size();
+}
+
+template <class TClient>
+inline size_t SSLClientPool<TClient>::idle()
+{
+    std::scoped_lock locker(_lock);
+    return _idle.size();
+}
+
+template <class TClient>
+inline size_t SSLClientPool<TClient>::leased()
+{
+    std::scoped_lock locker(_lock);
+    return std::count_if(_clients.begin(), _clients.end(), [](const std::shared_ptr<Client>& client) { return client->leased; });
+}
+
+template <class TClient>
+inline bool SSLClientPool<TClient>::IsStarted()
+{
+    std::scoped_lock locker(_lock);
+    return _started;
+}
+
+template <class TClient>
+inline bool SSLClientPool<TClient>::Start()
+{
+    std::vector<std::shared_ptr<Client>> connecting;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        if (_started)
+            return false;
+
+        _started = true;
+
+        // Warm up the minimal count of clients
+        Grow(connecting);
+        Schedule();
+    }
+
+    Connect(connecting);
+
+    return true;
+}
+
+template <class TClient>
+inline bool SSLClientPool<TClient>::Stop()
+{
+    std::vector<std::shared_ptr<Client>> disconnecting;
+    std::deque<std::shared_ptr<Waiter>> waiters;
+    std::shared_ptr<Timer> timer;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        if (!_started)
+            return false;
+
+        _started = false;
+
+        // Leased clients are kept until they are returned
+        for (auto& client : _clients)
+            if (!client->leased)
+                disconnecting.push_back(client);
+        for (auto& client : disconnecting)
+            Remove(client);
+
+        waiters.swap(_waiters);
+        timer.swap(_health_timer);
+    }
+
+    if (timer)
+        timer->Cancel();
+
+    // Fail all pending leases
+    for (auto& waiter : waiters)
+    {
+        waiter->timer->Cancel();
+        waiter->handler(nullptr);
+    }
+
+    for (auto& client : disconnecting)
+        client->DisconnectAsync();
+
+    return true;
+}
+
+template <class TClient>
+inline std::shared_ptr<TClient> SSLClientPool<TClient>::TryLease()
+{
+    std::shared_ptr<Client> client;
+    std::vector<std::shared_ptr<Client>> connecting;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        if (!_started)
+            return nullptr;
+
+        // Connect a new client for the next lease if there is no idle one
+        client = Take();
+        if (!client)
+            Demand(_waiters.size() + 1, connecting);
+    }
+
+    Connect(connecting);
+
+    return client;
+}
+
+template <class TClient>
+inline void SSLClientPool<TClient>::LeaseAsync(const LeaseHandler& handler, const CppCommon::Timespan& timeout)
+{
+    std::shared_ptr<Client> client;
+    std::vector<std::shared_ptr<Client>> connecting;
+    bool started;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        started = _started;
+        if (started)
+        {
+            client = Take();
+            if (!client)
+            {
+                // Wait for the ready client until the lease timeout expires
+                auto waiter = std::make_shared<Waiter>();
+                waiter->handler = handler;
+                waiter->timer = std::make_shared<Timer>(_service);
+                std::weak_ptr<SSLClientPool<TClient>> weak_pool = this->shared_from_this();
+                std::weak_ptr<Waiter> weak_waiter = waiter;
+                auto timer_handler = [weak_pool, weak_waiter](bool canceled)
+                {
+                    if (canceled)
+                        return;
+
+                    auto pool = weak_pool.lock();
+                    auto waiter = weak_waiter.lock();
+                    if (pool && waiter)
+                        pool->onWaiterTimeout(waiter);
+                };
+                if (waiter->timer->Setup(timer_handler, timeout))
+                    waiter->timer->WaitAsync();
+
+                _waiters.push_back(waiter);
+                Demand(_waiters.size(), connecting);
+            }
+        }
+    }
+
+    Connect(connecting);
+
+    // Call the lease handler with the idle client or fail the lease of the stopped pool
+    if (client || !started)
+        handler(client);
+}
+
+template <class TClient>
+inline void SSLClientPool<TClient>::Return(std::shared_ptr<TClient> client)
+{
+    auto instance = std::dynamic_pointer_cast<Client>(client);
+    if (!instance)
+        return;
+
+    std::shared_ptr<Waiter> waiter;
+    bool drop = false;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        // Check if the client is leased from the pool
+        auto it = std::find(_clients.begin(), _clients.end(), instance);
+        if ((it == _clients.end()) || !instance->leased)
+            return;
+
+        instance->leased = false;
+
+        // Keep only handshaked clients of the started pool
+        if (_started && instance->IsHandshaked())
+            waiter = Release(instance);
+        else
+            drop = Remove(instance);
+    }
+
+    if (waiter)
+    {
+        waiter->timer->Cancel();
+        waiter->handler(instance);
+    }
+    else if (drop)
+        instance->DisconnectAsync();
+}
+
+template <class TClient>
+inline void SSLClientPool<TClient>::Create(std::vector<std::shared_ptr<Client>>& connecting)
+{
+    auto client = std::make_shared<Client>(_service, _context, _address, _port);
+    client->SetupConnectTimeout(_option_connect_timeout);
+    client->SetupHandshakeTimeout(_option_handshake_timeout);
+    client->pool = this->shared_from_this();
+    _clients.push_back(client);
+    connecting.push_back(client);
+}
+
+template <class TClient>
+inline void SSLClientPool<TClient>::Grow(std::vector<std::shared_ptr<Client>>& connecting)
+{
+    while (_clients.size() < _min_size)
+        Create(connecting);
+}
+
+template <class TClient>
+inline void SSLClientPool<TClient>::Demand(size_t leases, std::vector<std::shared_ptr<Client>>& connecting)
+{
+    // Count clients which are still connecting
+    size_t pending = std::count_if(_clients.begin(), _clients.end(), [](const std::shared_ptr<Client>& client) { return !client->ready; });
+
+    while ((pending < leases) && (_clients.size() < _max_size))
+    {
+        Create(connecting);
+        ++pending;
+    }
+}
+
+template <class TClient>
+inline void SSLClientPool<TClient>::Connect(const std::vector<std::shared_ptr<Client>>& connecting)
+{
+    for (auto& client : connecting)
+        client->ConnectAsync(_resolver);
+}
+
+template <class TClient>
+inline std::shared_ptr<typename SSLClientPool<TClient>::Client> SSLClientPool<TClient>::Take()
+{
+    while (!_idle.empty())
+    {
+        auto client = _idle.back();
+        _idle.pop_back();
+
+        // Skip the client disconnected while it was idle
+        if (client->IsHandshaked())
+        {
+            client->leased = true;
+            return client;
+        }
+    }
+
+    return nullptr;
+}
+
+template <class TClient>
+inline std::shared_ptr<typename SSLClientPool<TClient>::Waiter> SSLClientPool<TClient>::Release(const std::shared_ptr<Client>& client)
+{
+    if (!_waiters.empty())
+    {
+        auto waiter = _waiters.front();
+        _waiters.pop_front();
+        client->leased = true;
+        return waiter;
+    }
+
+    client->timestamp = CppCommon::Timestamp::nano();
+    _idle.push_back(client);
+    return nullptr;
+}
+
+template <class TClient>
+inline bool SSLClientPool<TClient>::Remove(const std::shared_ptr<Client>& client)
+{
+    auto it = std::find(_clients.begin(), _clients.end(), client);
+    if (it == _clients.end())
+        return false;
+
+    _clients.erase(it);
+    _idle.erase(std::remove(_idle.begin(), _idle.end(), client), _idle.end());
+    return true;
+}
+
+template <class TClient>
+inline void SSLClientPool<TClient>::Schedule()
+{
+    std::weak_ptr<SSLClientPool<TClient>> weak_pool = this->shared_from_this();
+    auto timer_handler = [weak_pool](bool canceled)
+    {
+        if (canceled)
+            return;
+
+        auto pool = weak_pool.lock();
+        if (pool)
+            pool->onHealthTimer();
+    };
+    _health_timer = std::make_shared<Timer>(_service, timer_handler, _option_health_check_interval);
+    _health_timer->WaitAsync();
+}
+
+template <class TClient>
+inline void SSLClientPool<TClient>::onClientReady(const std::shared_ptr<Client>& client)
+{
+    std::shared_ptr<Waiter> waiter;
+    bool removed = false;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        // Check if the client was not removed from the stopped pool
+        auto it = std::find(_clients.begin(), _clients.end(), client);
+        if (it != _clients.end())
+        {
+            client->ready = true;
+            waiter = Release(client);
+        }
+        else
+            removed = true;
+    }
+
+    if (removed)
+        client->DisconnectAsync();
+    else if (waiter)
+    {
+        waiter->timer->Cancel();
+        waiter->handler(client);
+    }
+}
+
+template <class TClient>
+inline void SSLClientPool<TClient>::onClientDisconnected(const std::shared_ptr<Client>& client)
+{
+    std::scoped_lock locker(_lock);
+
+    // Leased client is removed when it is returned
+    if (!client->leased)
+        Remove(client);
+}
+
+template <class TClient>
+inline void SSLClientPool<TClient>::onWaiterTimeout(const std::shared_ptr<Waiter>& waiter)
+{
+    {
+        std::scoped_lock locker(_lock);
+
+        auto it = std::find(_waiters.begin(), _waiters.end(), waiter);
+        if (it == _waiters.end())
+            return;
+
+        _waiters.erase(it);
+    }
+
+    waiter->handler(nullptr);
+}
+
+template <class TClient>
+inline void SSLClientPool<TClient>::onHealthTimer()
+{
+    std::vector<std::shared_ptr<Client>> disconnecting;
+    std::vector<std::shared_ptr<Client>> connecting;
+    std::vector<std::shared_ptr<Client>> unhealthy;
+
+    // Copy idle clients to check them without the pool lock
+    {
+        std::scoped_lock locker(_lock);
+
+        if (!_started)
+            return;
+
+        unhealthy.assign(_idle.begin(), _idle.end());
+    }
+
+    // Check idle clients
+    unhealthy.erase(std::remove_if(unhealthy.begin(), unhealthy.end(), [this](const std::shared_ptr<Client>& client) { return onHealthCheck(*client); }), unhealthy.end());
+
+    {
+        std::scoped_lock locker(_lock);
+
+        if (!_started)
+            return;
+
+        // Disconnect unhealthy clients which are still idle
+        for (auto& client : unhealthy)
+        {
+            if (std::find(_idle.begin(), _idle.end(), client) != _idle.end())
+            {
+                Remove(client);
+                disconnecting.push_back(client);
+            }
+        }
+
+        // Disconnect the least recently used idle clients above the minimal count
+        uint64_t timestamp = CppCommon::Timestamp::nano();
+        while (!_idle.empty() && (_clients.size() > _min_size) && ((timestamp - _idle.front()->timestamp) >= (uint64_t)_option_idle_timeout.total()))
+        {
+            auto client = _idle.front();
+            Remove(client);
+            disconnecting.push_back(client);
+        }
+
+        // Replace disconnected clients and connect clients for pending leases
+        Grow(connecting);
+        Demand(_waiters.size(), connecting);
+
+        Schedule();
+    }
+
+    for (auto& client : disconnecting)
+        client->DisconnectAsync();
+
+    Connect(connecting);
+}
+
+} // namespace Asio
+} // namespace CppServer
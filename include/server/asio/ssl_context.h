@@ -11,6 +11,9 @@
 
 #include "service.h"
 
+#include <string>
+#include <vector>
+
 namespace CppServer {
 namespace Asio {
 
@@ -34,6 +37,20 @@ public:
 
     //! Configures the context to use system root certificates
     void set_root_certs();
+
+    //! Configures the context to negotiate application protocols (ALPN)
+    /*!
+        Client offers the given protocols to the server. Server selects the
+        first of the given protocols offered by the client or continues the
+        handshake without the application protocol.
+
+        \param protocols - Application protocols in the preference order (e.g. {"h2", "http/1.1"})
+    */
+    void set_alpn_protocols(const std::vector<std::string>& protocols);
+
+private:
+    // Application protocols in the wire format
+    std::string _alpn_protocols;
 };
 
 } // namespace Asio
@@ -67,6 +67,12 @@ public:
     //! Get the option: send buffer size
     size_t option_send_buffer_size() const;
 
+    //! Get the application protocol negotiated with the client (ALPN)
+    /*!
+        \return Negotiated application protocol or empty string if the protocol was not negotiated
+    */
+    std::string alpn_protocol();
+
     //! Is the session connected?
     bool IsConnected() const noexcept { return _connected; }
     //! Is the session handshaked?
@@ -9,7 +9,9 @@
 #ifndef CPPSERVER_ASIO_TCP_CLIENT_H
 #define CPPSERVER_ASIO_TCP_CLIENT_H
 
+#include "tcp_connector.h"
 #include "tcp_resolver.h"
+#include "timer.h"
 
 #include "system/uuid.h"
 #include "time/timespan.h"
@@ -88,6 +90,24 @@ public:
     bool option_keep_alive() const noexcept { return _option_keep_alive; }
     //! Get the option: no delay
     bool option_no_delay() const noexcept { return _option_no_delay; }
+    //! Get the option: happy eyeballs
+    bool option_happy_eyeballs() const noexcept { return _option_happy_eyeballs; }
+    //! Get the option: connection attempt delay
+    const CppCommon::Timespan& option_connection_attempt_delay() const noexcept { return _option_connection_attempt_delay; }
+    //! Get the option: connect timeout
+    const CppCommon::Timespan& option_connect_timeout() const noexcept { return _option_connect_timeout; }
+    //! Get the option: reconnect
+    bool option_reconnect() const noexcept { return _option_reconnect; }
+    //! Get the option: reconnect delay
+    const CppCommon::Timespan& option_reconnect_delay() const noexcept { return _option_reconnect_delay; }
+    //! Get the option: reconnect maximal delay
+    const CppCommon::Timespan& option_reconnect_max_delay() const noexcept { return _option_reconnect_max_delay; }
+    //! Get the option: reconnect attempts
+    size_t option_reconnect_attempts() const noexcept { return _option_reconnect_attempts; }
+    //! Get the option: reconnect timeout
+    const CppCommon::Timespan& option_reconnect_timeout() const noexcept { return _option_reconnect_timeout; }
+    //! Get the option: reconnect preserve
+    bool option_reconnect_preserve() const noexcept { return _option_reconnect_preserve; }
     //! Get the option: receive buffer size
     size_t option_receive_buffer_size() const;
     //! Get the option: send buffer size
@@ -133,7 +153,7 @@ public:
     /*!
         \return 'true' if the client was successfully disconnected, 'false' if the client is already disconnected
     */
-    virtual bool DisconnectAsync() { return DisconnectAsync(false); }
+    virtual bool DisconnectAsync();
     //! Reconnect the client (asynchronous)
     /*!
         \return 'true' if the client was successfully reconnected, 'false' if the client is already reconnected
@@ -233,6 +253,95 @@ public:
         \param enable - Enable/disable option
     */
     void SetupNoDelay(bool enable) noexcept { _option_no_delay = enable; }
+    //! Setup option: happy eyeballs
+    /*!
+        This option will race asynchronous connection attempts to the
+        resolved endpoints interleaving IPv6 and IPv4 addresses instead
+        of trying them one by one. The first established connection is
+        used, other attempts are canceled.
+
+        https://tools.ietf.org/html/rfc8305
+
+        \param enable - Enable/disable option
+    */
+    void SetupHappyEyeballs(bool enable) noexcept { _option_happy_eyeballs = enable; }
+    //! Setup option: connection attempt delay
+    /*!
+        This option will setup the delay before the next connection attempt
+        is started in the happy eyeballs mode. Default delay is 250 milliseconds.
+
+        \param delay - Connection attempt delay
+    */
+    void SetupConnectionAttemptDelay(const CppCommon::Timespan& delay) noexcept { _option_connection_attempt_delay = delay; }
+    //! Setup option: connect timeout
+    /*!
+        This option will abort the asynchronous connect attempt (including
+        DNS resolve) which is not connected within the given timeout and
+        report the timed out error. Zero value means no timeout (default).
+
+        Timed out DNS resolve fails the connect attempt immediately. The
+        resolve itself cannot be canceled, so its late result is ignored.
+
+        \param timeout - Connect timeout
+    */
+    void SetupConnectTimeout(const CppCommon::Timespan& timeout) noexcept { _option_connect_timeout = timeout; }
+    //! Setup option: reconnect
+    /*!
+        This option will reconnect the client automatically when the connection
+        is lost or the asynchronous connect fails. Reconnect attempts are delayed
+        with exponential backoff and jitter, so many clients disconnected at once
+        are not reconnected to the server at once. Automatic reconnect is stopped
+        by Disconnect() or DisconnectAsync() methods and resumed by the next
+        connect.
+
+        \param enable - Enable/disable option
+    */
+    void SetupReconnect(bool enable) noexcept { _option_reconnect = enable; }
+    //! Setup option: reconnect delay
+    /*!
+        This option will setup the delay before the first reconnect attempt.
+        The delay is doubled for each next attempt up to the reconnect maximal
+        delay and randomized between its half and its full value. Default delay
+        is 1 second.
+
+        \param delay - Reconnect delay
+    */
+    void SetupReconnectDelay(const CppCommon::Timespan& delay) noexcept { _option_reconnect_delay = delay; }
+    //! Setup option: reconnect maximal delay
+    /*!
+        This option will limit the exponential backoff of reconnect attempts.
+        Default maximal delay is 30 seconds.
+
+        \param delay - Reconnect maximal delay
+    */
+    void SetupReconnectMaxDelay(const CppCommon::Timespan& delay) noexcept { _option_reconnect_max_delay = delay; }
+    //! Setup option: reconnect attempts
+    /*!
+        This option will limit the count of reconnect attempts in a row.
+        Zero value means unlimited reconnect attempts (default).
+
+        \param attempts - Reconnect attempts
+    */
+    void SetupReconnectAttempts(size_t attempts) noexcept { _option_reconnect_attempts = attempts; }
+    //! Setup option: reconnect timeout
+    /*!
+        This option will abort the asynchronous connect attempt of the client
+        with automatic reconnect which is not connected within the given timeout
+        and report the timed out error. The shortest of the connect timeout and
+        the reconnect timeout is used. Zero value means no timeout (default).
+
+        \param timeout - Reconnect timeout
+    */
+    void SetupReconnectTimeout(const CppCommon::Timespan& timeout) noexcept { _option_reconnect_timeout = timeout; }
+    //! Setup option: reconnect preserve
+    /*!
+        This option will preserve the data pending to send when the connection
+        is lost and send it after reconnect. Data could be sent asynchronously
+        while the client is reconnecting.
+
+        \param enable - Enable/disable option
+    */
+    void SetupReconnectPreserve(bool enable) noexcept { _option_reconnect_preserve = enable; }
     //! Setup option: receive buffer size
     /*!
         This option will setup SO_RCVBUF if the OS support this feature.
@@ -332,7 +441,35 @@ private:
     // Options
     bool _option_keep_alive;
     bool _option_no_delay;
+    bool _option_happy_eyeballs;
+    CppCommon::Timespan _option_connection_attempt_delay;
+    CppCommon::Timespan _option_connect_timeout;
+    bool _option_reconnect;
+    CppCommon::Timespan _option_reconnect_delay;
+    CppCommon::Timespan _option_reconnect_max_delay;
+    size_t _option_reconnect_attempts;
+    CppCommon::Timespan _option_reconnect_timeout;
+    bool _option_reconnect_preserve;
+    // Automatic reconnect
+    std::shared_ptr<TCPResolver> _reconnect_resolver;
+    std::shared_ptr<Timer> _reconnect_timer;
+    std::atomic<bool> _reconnect_stopped;
+    std::atomic<size_t> _reconnect_attempts;
+    // Connect attempt deadline
+    asio::system_timer _connect_timer;
+    std::shared_ptr<TCPConnector> _connector;
+    // Resolve attempt identifier, results of the timed out resolve attempts are ignored
+    size_t _resolve_attempt;
+    // Resolver and waiter Id of the pending resolve attempt
+    std::shared_ptr<TCPResolver> _resolve_resolver;
+    uint64_t _resolve_id;
 
+    //! Disconnect the client (synchronous)
+    /*!
+        \param reconnect - Reconnect flag
+        \return 'true' if the client was successfully disconnected, 'false' if the client is already disconnected
+    */
+    bool Disconnect(bool reconnect);
     //! Disconnect the client (asynchronous)
     /*!
         \param dispatch - Dispatch flag
@@ -340,6 +477,15 @@ private:
     */
     bool DisconnectAsync(bool dispatch);
 
+    //! Try to reconnect the client after the reconnect delay
+    void TryReconnect();
+    //! Stop the automatic reconnect
+    void StopReconnect();
+    //! Start the connect attempt deadline
+    void StartConnectTimer(const CppCommon::Timespan& timeout);
+    //! Abort the connect attempt by timeout
+    void AbortConnect();
+
     //! Try to receive new data
     void TryReceive();
     //! Try to send pending data
@@ -347,6 +493,8 @@ private:
 
     //! Clear send/receive buffers
     void ClearBuffers();
+    //! Preserve pending send buffers for reconnect
+    void PreserveBuffers();
 
     //! Send error notification
     void SendError(std::error_code ec);
@@ -0,0 +1,112 @@
+/*!
+    \file tcp_connector.h
+    \brief TCP connector definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_TCP_CONNECTOR_H
+#define CPPSERVER_ASIO_TCP_CONNECTOR_H
+
+#include "service.h"
+
+#include "time/timespan.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace CppServer {
+namespace Asio {
+
+//! TCP connector
+/*!
+    TCP connector races connection attempts to the resolved endpoints
+    using Happy Eyeballs algorithm (RFC 8305). Endpoints are interleaved
+    by the address family starting with the family of the first resolved
+    endpoint. The next attempt is started when the connection attempt
+    delay expires or the previous attempt fails. The first established
+    connection is moved into the target socket, other attempts are
+    canceled.
+
+    Not thread-safe, connection attempt handlers are serialized with
+    the strand if it is required by the Asio service.
+*/
+class TCPConnector : public std::enable_shared_from_this<TCPConnector>
+{
+public:
+    //! Connect handler
+    typedef std::function<void(std::error_code, const asio::ip::tcp::endpoint&)> ConnectHandler;
+
+    //! Initialize connector with a given Asio IO service and target socket
+    /*!
+        \param io_service - Asio IO service of the connecting client
+        \param strand - Asio service strand of the connecting client
+        \param strand_required - Strand required flag
+        \param socket - Target socket
+        \param delay - Connection attempt delay
+    */
+    TCPConnector(std::shared_ptr<asio::io_service> io_service, asio::io_service::strand& strand, bool strand_required, asio::ip::tcp::socket& socket, const CppCommon::Timespan& delay);
+    TCPConnector(const TCPConnector&) = delete;
+    TCPConnector(TCPConnector&&) = delete;
+    ~TCPConnector() = default;
+
+    TCPConnector& operator=(const TCPConnector&) = delete;
+    TCPConnector& operator=(TCPConnector&&) = delete;
+
+    //! Connect to the first available endpoint (asynchronous)
+    /*!
+        Connect handler is called once with the endpoint of the established
+        connection or with the error of the last failed attempt.
+
+        \param endpoints - Resolved endpoints
+        \param handler - Connect handler
+    */
+    void ConnectAsync(const asio::ip::tcp::resolver::results_type& endpoints, const ConnectHandler& handler);
+
+    //! Interleave endpoints by the address family
+    /*!
+        \param endpoints - Resolved endpoints
+        \return Endpoints in the connection attempts order
+    */
+    static std::vector<asio::ip::tcp::endpoint> Interleave(const asio::ip::tcp::resolver::results_type& endpoints);
+
+    //! Cancel all connection attempts
+    /*!
+        Connect handler is called with the operation aborted error when
+        all pending connection attempts are canceled. Should be called
+        from the strand of the connecting client.
+    */
+    void Cancel();
+
+private:
+    // Asio IO service
+    std::shared_ptr<asio::io_service> _io_service;
+    // Asio service strand for serialized handler execution
+    asio::io_service::strand _strand;
+    bool _strand_required;
+    // Target socket
+    asio::ip::tcp::socket& _socket;
+    // Connection attempt delay
+    CppCommon::Timespan _delay;
+    asio::system_timer _timer;
+    // Connection attempts
+    std::vector<asio::ip::tcp::endpoint> _endpoints;
+    std::vector<std::unique_ptr<asio::ip::tcp::socket>> _attempts;
+    size_t _pending;
+    bool _canceled;
+    bool _done;
+    std::error_code _error;
+    ConnectHandler _handler;
+
+    // Start the next connection attempt
+    void StartAttempt();
+    // Handle the connection attempt result
+    void onAttempt(size_t index, std::error_code ec);
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_TCP_CONNECTOR_H
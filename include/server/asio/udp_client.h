@@ -9,6 +9,7 @@
 #ifndef CPPSERVER_ASIO_UDP_CLIENT_H
 #define CPPSERVER_ASIO_UDP_CLIENT_H
 
+#include "timer.h"
 #include "udp_resolver.h"
 
 #include "system/uuid.h"
@@ -78,7 +79,7 @@ public:
     int port() const noexcept { return _port; }
 
     //! Get the number of bytes pending sent by the client
-    uint64_t bytes_pending() const noexcept { return _bytes_sending; }
+    uint64_t bytes_pending() const noexcept { return _bytes_pending + _bytes_sending; }
     //! Get the number of bytes sent by the client
     uint64_t bytes_sent() const noexcept { return _bytes_sent; }
     //! Get the number of bytes received by the client
@@ -94,6 +95,28 @@ public:
     bool option_reuse_port() const noexcept { return _option_reuse_port; }
     //! Get the option: bind the socket to the multicast UDP server
     bool option_multicast() const noexcept { return _option_multicast; }
+    //! Get the option: receive batch size
+    size_t option_receive_batch() const noexcept { return _option_receive_batch; }
+    //! Get the option: send batch size
+    size_t option_send_batch() const noexcept { return _option_send_batch; }
+    //! Get the option: GSO segment size
+    size_t option_gso_segment_size() const noexcept { return _option_gso_segment_size; }
+    //! Get the option: GRO
+    bool option_gro() const noexcept { return _option_gro; }
+    //! Get the option: connected socket
+    bool option_connected() const noexcept { return _option_connected; }
+    //! Get the option: reconnect
+    bool option_reconnect() const noexcept { return _option_reconnect; }
+    //! Get the option: reconnect delay
+    const CppCommon::Timespan& option_reconnect_delay() const noexcept { return _option_reconnect_delay; }
+    //! Get the option: reconnect maximal delay
+    const CppCommon::Timespan& option_reconnect_max_delay() const noexcept { return _option_reconnect_max_delay; }
+    //! Get the option: reconnect attempts
+    size_t option_reconnect_attempts() const noexcept { return _option_reconnect_attempts; }
+    //! Get the option: reconnect timeout
+    const CppCommon::Timespan& option_reconnect_timeout() const noexcept { return _option_reconnect_timeout; }
+    //! Get the option: send buffer limit
+    size_t option_send_buffer_limit() const noexcept { return _option_send_buffer_limit; }
     //! Get the option: receive buffer size
     size_t option_receive_buffer_size() const;
     //! Get the option: send buffer size
@@ -139,7 +162,7 @@ public:
     /*!
         \return 'true' if the client was successfully disconnected, 'false' if the client is already disconnected
     */
-    virtual bool DisconnectAsync() { return DisconnectAsync(false); }
+    virtual bool DisconnectAsync();
     //! Reconnect the client (asynchronous)
     /*!
         \return 'true' if the client was successfully reconnected, 'false' if the client is already reconnected
@@ -234,7 +257,7 @@ public:
     /*!
         \param buffer - Datagram buffer to send
         \param size - Datagram buffer size
-        \return 'true' if the datagram was successfully sent, 'false' if the datagram was not sent
+        \return 'true' if the datagram was successfully sent, 'false' if the datagram was not sent or the send buffer limit is exceeded
     */
     virtual bool SendAsync(const void* buffer, size_t size);
     //! Send text to the connected server (asynchronous)
@@ -248,7 +271,7 @@ public:
         \param endpoint - Endpoint to send
         \param buffer - Datagram buffer to send
         \param size - Datagram buffer size
-        \return 'true' if the datagram was successfully sent, 'false' if the datagram was not sent
+        \return 'true' if the datagram was successfully sent, 'false' if the datagram was not sent or the send buffer limit is exceeded
     */
     virtual bool SendAsync(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size);
     //! Send text to the given endpoint (asynchronous)
@@ -315,6 +338,130 @@ public:
         \param enable - Enable/disable option
     */
     void SetupMulticast(bool enable) noexcept { _option_reuse_address = enable; _option_multicast = enable; }
+    //! Setup option: receive batch size
+    /*!
+        This option will enable batched receive of up to the given count
+        of datagrams per socket wakeup using recvmmsg() if the OS support
+        this feature. Each received datagram is delivered with a separate
+        onReceived() notification. Value 1 disables batched receive.
+
+        \param datagrams - Maximal count of datagrams to receive per wakeup (default is 1)
+    */
+    void SetupReceiveBatch(size_t datagrams) noexcept { _option_receive_batch = (datagrams > 0) ? datagrams : 1; }
+    //! Setup option: send batch size
+    /*!
+        This option will enable batched send of up to the given count of
+        queued datagrams per socket wakeup using sendmmsg() if the OS support
+        this feature. Value 1 disables batched send.
+
+        \param datagrams - Maximal count of datagrams to send per wakeup (default is 1)
+    */
+    void SetupSendBatch(size_t datagrams) noexcept { _option_send_batch = (datagrams > 0) ? datagrams : 1; }
+    //! Setup option: GSO segment size
+    /*!
+        This option will setup UDP_SEGMENT (generic segmentation offload)
+        if the OS support this feature. Each sent buffer larger than the
+        segment size will be split by the kernel into datagrams of the
+        given size (the last one could be shorter). Buffer should not
+        exceed 64 segments and the maximal UDP datagram size. onSent()
+        is called once for the whole buffer. Value 0 disables GSO. If the
+        OS rejects the option, onError() is called and datagrams are sent
+        without segmentation.
+
+        \param segment_size - Datagram segment size (default is 0)
+    */
+    void SetupGSO(size_t segment_size) noexcept { _option_gso_segment_size = segment_size; }
+    //! Setup option: GRO
+    /*!
+        This option will setup UDP_GRO (generic receive offload) if the
+        OS support this feature. The kernel will coalesce datagrams of
+        the same flow into one buffer and onReceived() will be called
+        for each of original datagrams. If the OS rejects the option,
+        onError() is called and datagrams are received one by one.
+
+        \param enable - Enable/disable option
+    */
+    void SetupGRO(bool enable) noexcept { _option_gro = enable; }
+    //! Setup option: connected socket
+    /*!
+        This option will connect() the client socket to the server endpoint.
+        The kernel caches the route to the server, datagrams to the server
+        are sent with plain send() without the destination address and
+        datagrams from foreign endpoints are filtered by the kernel. Option
+        is ignored for the multicast client.
+
+        Connected socket reports ICMP port unreachable messages of the server
+        as 'connection refused' errors of the next send or receive operation.
+        Such errors are not fatal: the client stays connected, the refused
+        datagram is sent again once (and is reported as sent with zero size
+        if it is refused again) and the receive operation is restarted, so
+        the client keeps working when the server is restarted.
+
+        \param enable - Enable/disable option
+    */
+    void SetupConnected(bool enable) noexcept { _option_connected = enable; }
+    //! Setup option: reconnect
+    /*!
+        This option will reconnect the client automatically when the client
+        is disconnected by the socket error or the asynchronous DNS resolve
+        fails. Reconnect attempts are delayed with exponential backoff and
+        jitter. Pending datagrams are not preserved for reconnect. Automatic
+        reconnect is stopped by Disconnect() or DisconnectAsync() methods and
+        resumed by the next connect.
+
+        \param enable - Enable/disable option
+    */
+    void SetupReconnect(bool enable) noexcept { _option_reconnect = enable; }
+    //! Setup option: reconnect delay
+    /*!
+        This option will setup the delay before the first reconnect attempt.
+        The delay is doubled for each next attempt up to the reconnect maximal
+        delay and randomized between its half and its full value. Default delay
+        is 1 second.
+
+        \param delay - Reconnect delay
+    */
+    void SetupReconnectDelay(const CppCommon::Timespan& delay) noexcept { _option_reconnect_delay = delay; }
+    //! Setup option: reconnect maximal delay
+    /*!
+        This option will limit the exponential backoff of reconnect attempts.
+        Default maximal delay is 30 seconds.
+
+        \param delay - Reconnect maximal delay
+    */
+    void SetupReconnectMaxDelay(const CppCommon::Timespan& delay) noexcept { _option_reconnect_max_delay = delay; }
+    //! Setup option: reconnect attempts
+    /*!
+        This option will limit the count of reconnect attempts in a row.
+        Reconnect attempts are counted until the first datagram is received
+        from the server. Zero value means unlimited reconnect attempts (default).
+
+        \param attempts - Reconnect attempts
+    */
+    void SetupReconnectAttempts(size_t attempts) noexcept { _option_reconnect_attempts = attempts; }
+    //! Setup option: reconnect timeout
+    /*!
+        This option will abort the asynchronous DNS resolve of the client
+        with automatic reconnect which is not completed within the given
+        timeout and report the timed out error. Zero value means no timeout
+        (default).
+
+        Timed out DNS resolve fails the connect attempt immediately. The
+        resolve itself cannot be canceled, so its late result is ignored.
+
+        \param timeout - Reconnect timeout
+    */
+    void SetupReconnectTimeout(const CppCommon::Timespan& timeout) noexcept { _option_reconnect_timeout = timeout; }
+    //! Setup option: send buffer limit
+    /*!
+        This option will limit the size of datagrams queued by SendAsync()
+        and not yet passed to the socket. Datagram which exceeds the limit
+        is not queued and SendAsync() returns 'false'. Zero limit disables
+        the check.
+
+        \param limit - Send buffer limit in bytes (default is 0)
+    */
+    void SetupSendBufferLimit(size_t limit) noexcept { _option_send_buffer_limit = limit; }
     //! Setup option: receive buffer size
     /*!
         This option will setup SO_RCVBUF if the OS support this feature.
@@ -394,30 +541,91 @@ private:
     // Server endpoint & client socket
     asio::ip::udp::endpoint _endpoint;
     asio::ip::udp::socket _socket;
+    bool _socket_connected;
     std::atomic<bool> _resolving;
     std::atomic<bool> _connected;
     // Client statistic
+    uint64_t _bytes_pending;
     uint64_t _bytes_sending;
     uint64_t _bytes_sent;
     uint64_t _bytes_received;
     uint64_t _datagrams_sent;
     uint64_t _datagrams_received;
-    // Receive and send endpoints
+    // Receive endpoint
     asio::ip::udp::endpoint _receive_endpoint;
-    asio::ip::udp::endpoint _send_endpoint;
     // Receive buffer
     bool _receiving;
     std::vector<uint8_t> _receive_buffer;
     HandlerStorage _receive_storage;
+    // Receive batch buffers
+    std::vector<uint8_t> _receive_batch_buffer;
+    std::vector<asio::ip::udp::endpoint> _receive_batch_endpoints;
+#if defined(__linux__)
+    std::vector<uint8_t> _receive_batch_control;
+    std::vector<iovec> _receive_batch_vectors;
+    std::vector<mmsghdr> _receive_batch_headers;
+#endif
     // Send buffer
+    struct SendDatagram
+    {
+        asio::ip::udp::endpoint endpoint;
+        size_t offset;
+        size_t size;
+    };
+    struct SentDatagram
+    {
+        asio::ip::udp::endpoint endpoint;
+        size_t sent;
+    };
     bool _sending;
-    std::vector<uint8_t> _send_buffer;
+    std::mutex _send_lock;
+    std::vector<uint8_t> _send_buffer_main;
+    std::vector<uint8_t> _send_buffer_flush;
+    std::vector<SendDatagram> _send_datagrams_main;
+    std::vector<SendDatagram> _send_datagrams_flush;
+    size_t _send_datagrams_flush_offset;
+    bool _send_refused;
     HandlerStorage _send_storage;
+#if defined(__linux__)
+    // Send batch buffers
+    std::vector<iovec> _send_batch_vectors;
+    std::vector<mmsghdr> _send_batch_headers;
+    std::vector<SentDatagram> _send_batch_sent;
+#endif
     // Options
     bool _option_reuse_address;
     bool _option_reuse_port;
     bool _option_multicast;
+    size_t _option_receive_batch;
+    size_t _option_send_batch;
+    size_t _option_gso_segment_size;
+    bool _option_gro;
+    bool _option_connected;
+    bool _option_reconnect;
+    CppCommon::Timespan _option_reconnect_delay;
+    CppCommon::Timespan _option_reconnect_max_delay;
+    size_t _option_reconnect_attempts;
+    CppCommon::Timespan _option_reconnect_timeout;
+    size_t _option_send_buffer_limit;
+    // Automatic reconnect
+    std::shared_ptr<UDPResolver> _reconnect_resolver;
+    std::shared_ptr<Timer> _reconnect_timer;
+    std::atomic<bool> _reconnect_stopped;
+    std::atomic<size_t> _reconnect_attempts;
+    // Resolve attempt deadline
+    asio::system_timer _connect_timer;
+    // Resolve attempt identifier, results of the timed out resolve attempts are ignored
+    size_t _resolve_attempt;
+    // Resolver and waiter Id of the pending resolve attempt
+    std::shared_ptr<UDPResolver> _resolve_resolver;
+    uint64_t _resolve_id;
 
+    //! Disconnect the client (synchronous)
+    /*!
+        \param reconnect - Reconnect flag
+        \return 'true' if the client was successfully disconnected, 'false' if the client is already disconnected
+    */
+    bool Disconnect(bool reconnect);
     //! Disconnect the client (asynchronous)
     /*!
         \param dispatch - Dispatch flag
@@ -425,12 +633,52 @@ private:
     */
     bool DisconnectAsync(bool dispatch);
 
+    //! Try to reconnect the client after the reconnect delay
+    void TryReconnect();
+    //! Stop the automatic reconnect
+    void StopReconnect();
+    //! Start the resolve attempt deadline
+    void StartConnectTimer(const CppCommon::Timespan& timeout);
+    //! Abort the resolve attempt by timeout
+    void AbortConnect();
+
+    //! Open and prepare the client socket for the server endpoint
+    void OpenSocket();
+
     //! Try to receive new datagram
     void TryReceive();
+#if defined(__linux__)
+    //! Try to receive a batch of new datagrams
+    void TryReceiveBatch();
+#endif
+
+    //! Prepare receive batch buffers
+    void PrepareReceiveBatch();
+
+    //! Try to send pending datagrams
+    void TrySend();
+#if defined(__linux__)
+    //! Try to send a batch of pending datagrams
+    void TrySendBatch();
+#endif
+    //! Complete the current flushed datagram
+    /*!
+        \param sent - Size of sent datagram (zero if the datagram was dropped)
+    */
+    void CompleteSend(size_t sent);
+    //! Release the current flushed datagram without calling the datagram sent handler
+    /*!
+        \param sent - Size of sent datagram (zero if the datagram was dropped)
+        \return Released datagram to notify about
+    */
+    SentDatagram ReleaseSend(size_t sent);
 
     //! Clear send/receive buffers
     void ClearBuffers();
 
+    //! Is the given error a refused datagram of the connected socket?
+    bool IsRefused(const std::error_code& ec) const noexcept { return _socket_connected && (ec == asio::error::connection_refused); }
+
     //! Send error notification
     void SendError(std::error_code ec);
 };
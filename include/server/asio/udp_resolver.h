@@ -11,6 +11,14 @@
 
 #include "service.h"
 
+#include "time/timespan.h"
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 namespace CppServer {
 namespace Asio {
 
@@ -18,6 +26,14 @@ namespace Asio {
 /*!
     UDP resolver is used to resolve DNS while connecting UDP clients.
 
+    Resolved endpoints are kept in the DNS cache of the resolver for the
+    cache TTL, resolve errors are kept for the negative cache TTL. Cached
+    results are shared by all clients connecting with the same resolver.
+    Concurrent lookups of the same host and service are coalesced into
+    a single DNS request. Each asynchronous lookup is identified by its
+    waiter Id, so a client can cancel its own lookup without aborting
+    lookups of other clients coalesced with it.
+
     Thread-safe.
 */
 class UDPResolver
@@ -44,7 +60,76 @@ public:
     //! Get the UDP resolver
     asio::ip::udp::resolver& resolver() noexcept { return _resolver; }
 
-    //! Cancel any asynchronous operations that are waiting on the resolver
+    //! Get the option: DNS cache TTL
+    const CppCommon::Timespan& option_cache_ttl() const noexcept { return _option_cache_ttl; }
+    //! Get the option: DNS negative cache TTL
+    const CppCommon::Timespan& option_negative_cache_ttl() const noexcept { return _option_negative_cache_ttl; }
+
+    //! Setup option: DNS cache TTL
+    /*!
+        This option will setup the time resolved endpoints are kept in
+        the DNS cache. Default TTL is 60 seconds, zero TTL disables
+        caching of resolved endpoints.
+
+        \param ttl - DNS cache TTL
+    */
+    void SetupCacheTTL(const CppCommon::Timespan& ttl) noexcept { _option_cache_ttl = ttl; }
+    //! Setup option: DNS negative cache TTL
+    /*!
+        This option will setup the time resolve errors are kept in
+        the DNS cache. Default TTL is 5 seconds, zero TTL disables
+        caching of resolve errors.
+
+        \param ttl - DNS negative cache TTL
+    */
+    void SetupNegativeCacheTTL(const CppCommon::Timespan& ttl) noexcept { _option_negative_cache_ttl = ttl; }
+
+    //! Get the count of DNS cache entries
+    size_t cache_size();
+
+    //! Clear the DNS cache
+    void ClearCache();
+
+    //! Resolve the host name and service (synchronous)
+    /*!
+        \param host - Host name or address
+        \param service - Service name or port number
+        \param ec - Resolve error
+        \return Resolved endpoints
+    */
+    asio::ip::udp::resolver::results_type Resolve(const std::string& host, const std::string& service, asio::error_code& ec);
+
+    //! Resolve the host name and service (asynchronous)
+    /*!
+        Handler is always posted to its associated executor, so handlers
+        bound to the strand are called in the strand.
+
+        \param host - Host name or address
+        \param service - Service name or port number
+        \param handler - Resolve handler with void(std::error_code, asio::ip::udp::resolver::results_type) signature
+        \return Resolve waiter Id to cancel the lookup (zero if the cached results are notified)
+    */
+    template <class THandler>
+    uint64_t ResolveAsync(const std::string& host, const std::string& service, THandler handler)
+    {
+        auto executor = asio::get_associated_executor(handler, _io_service->get_executor());
+        return ResolveCached(host, service, [executor, handler](std::error_code ec, const asio::ip::udp::resolver::results_type& results) mutable
+        {
+            asio::post(executor, [handler, ec, results]() mutable { handler(ec, results); });
+        });
+    }
+
+    //! Cancel the asynchronous lookup of the given resolve waiter
+    /*!
+        Resolve handler of the waiter is called with the operation aborted
+        error. The DNS request itself is not canceled and its results are
+        still notified to other waiters of the same host and service.
+
+        \param id - Resolve waiter Id
+        \return 'true' if the waiter was canceled, 'false' if its lookup is already completed
+    */
+    virtual bool Cancel(uint64_t id);
+    //! Cancel all asynchronous lookups of all clients using the resolver
     virtual void Cancel() { _resolver.cancel(); }
 
 private:
@@ -57,6 +142,44 @@ private:
     bool _strand_required;
     // UDP resolver
     asio::ip::udp::resolver _resolver;
+
+    // Resolve handler
+    typedef std::function<void(std::error_code, const asio::ip::udp::resolver::results_type&)> ResolveHandler;
+
+    // Resolve waiter
+    struct Waiter
+    {
+        uint64_t id;
+        ResolveHandler handler;
+    };
+
+    // DNS cache entry
+    struct CacheEntry
+    {
+        asio::ip::udp::resolver::results_type results;
+        std::error_code error;
+        uint64_t expires{0};
+        bool resolving{false};
+        std::vector<Waiter> waiters;
+    };
+
+    // DNS cache shared with pending resolve handlers
+    struct Cache
+    {
+        std::mutex lock;
+        std::map<std::pair<std::string, std::string>, CacheEntry> entries;
+        uint64_t waiters{0};
+    };
+    std::shared_ptr<Cache> _cache;
+
+    // Options
+    CppCommon::Timespan _option_cache_ttl;
+    CppCommon::Timespan _option_negative_cache_ttl;
+
+    // Resolve using the DNS cache and coalesce concurrent lookups
+    uint64_t ResolveCached(const std::string& host, const std::string& service, const ResolveHandler& handler);
+    // Store resolve results in the DNS cache entry
+    static void Store(CacheEntry& entry, const asio::ip::udp::resolver::results_type& results, const std::error_code& ec, uint64_t timestamp, const CppCommon::Timespan& ttl, const CppCommon::Timespan& negative_ttl);
 };
 
 } // namespace Asio
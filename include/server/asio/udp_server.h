@@ -9,9 +9,13 @@
 #ifndef CPPSERVER_ASIO_UDP_SERVER_H
 #define CPPSERVER_ASIO_UDP_SERVER_H
 
-#include "service.h"
+#include "timer.h"
+#include "udp_session.h"
 
-#include "system/uuid.h"
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace CppServer {
 namespace Asio {
@@ -20,10 +24,19 @@ namespace Asio {
 /*!
     UDP server is used to send or multicast datagrams to UDP endpoints.
 
+    In sessions mode UDP server keeps a table of virtual UDP sessions keyed
+    by client endpoints and dispatches received datagrams to them. Each
+    receiving socket remembers the session of the last received datagram,
+    so a burst of datagrams from the same client is dispatched without
+    looking up the sessions table. Sessions do not have their own send
+    queues, datagrams of all sessions are sent from the server send buffer.
+
     Thread-safe.
 */
 class UDPServer : public std::enable_shared_from_this<UDPServer>
 {
+    friend class UDPSession;
+
 public:
     //! Initialize UDP server with a given Asio service and port number
     /*!
@@ -72,7 +85,7 @@ public:
     int port() const noexcept { return _port; }
 
     //! Get the number of bytes pending sent by the server
-    uint64_t bytes_pending() const noexcept { return _bytes_sending; }
+    uint64_t bytes_pending() const noexcept { return _bytes_pending + _bytes_sending; }
     //! Get the number of bytes sent by the server
     uint64_t bytes_sent() const noexcept { return _bytes_sent; }
     //! Get the number of bytes received by the server
@@ -81,11 +94,33 @@ public:
     uint64_t datagrams_sent() const noexcept { return _datagrams_sent; }
     //! Get the number datagrams received by the server
     uint64_t datagrams_received() const noexcept { return _datagrams_received; }
+    //! Get the number of sessions connected to the server
+    uint64_t connected_sessions() const { std::shared_lock<std::shared_mutex> locker(_sessions_lock); return _sessions.size(); }
 
     //! Get the option: reuse address
     bool option_reuse_address() const noexcept { return _option_reuse_address; }
     //! Get the option: reuse port
     bool option_reuse_port() const noexcept { return _option_reuse_port; }
+    //! Get the option: reuse port socket group
+    bool option_reuse_port_group() const noexcept { return _option_reuse_port_group; }
+    //! Get the option: reuse port socket group steering
+    bool option_reuse_port_steering() const noexcept { return _option_reuse_port_steering; }
+    //! Get the option: receive batch size
+    size_t option_receive_batch() const noexcept { return _option_receive_batch; }
+    //! Get the option: send batch size
+    size_t option_send_batch() const noexcept { return _option_send_batch; }
+    //! Get the option: GSO segment size
+    size_t option_gso_segment_size() const noexcept { return _option_gso_segment_size; }
+    //! Get the option: GRO
+    bool option_gro() const noexcept { return _option_gro; }
+    //! Get the option: sessions mode
+    bool option_sessions() const noexcept { return _option_sessions; }
+    //! Get the option: session timeout
+    const CppCommon::Timespan& option_session_timeout() const noexcept { return _option_session_timeout; }
+    //! Get the option: send buffer limit
+    size_t option_send_buffer_limit() const noexcept { return _option_send_buffer_limit; }
+    //! Get the option: session send limit
+    size_t option_session_send_limit() const noexcept { return _option_session_send_limit; }
     //! Get the option: receive buffer size
     size_t option_receive_buffer_size() const;
     //! Get the option: send buffer size
@@ -205,10 +240,13 @@ public:
 
     //! Send datagram into the given endpoint (asynchronous)
     /*!
+        Datagram will be queued and sent as soon as possible. onSent() will
+        be called for each datagram once it is sent.
+
         \param endpoint - Endpoint to send
         \param buffer - Datagram buffer to send
         \param size - Datagram buffer size
-        \return 'true' if the datagram was successfully sent, 'false' if the datagram was not sent
+        \return 'true' if the datagram was successfully sent, 'false' if the datagram was not sent or the send buffer limit is exceeded
     */
     virtual bool SendAsync(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size);
     //! Send text into the given endpoint (asynchronous)
@@ -256,6 +294,19 @@ public:
     //! Receive datagram from the client (asynchronous)
     virtual void ReceiveAsync();
 
+    //! Disconnect all connected sessions
+    /*!
+        \return 'true' if all sessions were successfully disconnected, 'false' if the server is not started
+    */
+    virtual bool DisconnectAll();
+
+    //! Find a session with a given client endpoint
+    /*!
+        \param endpoint - Client endpoint
+        \return Session with a given client endpoint or null if the session it not connected
+    */
+    std::shared_ptr<UDPSession> FindSession(const asio::ip::udp::endpoint& endpoint);
+
     //! Setup option: reuse address
     /*!
         This option will enable/disable SO_REUSEADDR if the OS support this feature.
@@ -270,6 +321,121 @@ public:
         \param enable - Enable/disable option
     */
     void SetupReusePort(bool enable) noexcept { _option_reuse_port = enable; }
+    //! Setup option: reuse port socket group
+    /*!
+        This option will open one additional SO_REUSEPORT socket bound to
+        the server endpoint for each working thread of the Asio service
+        if the OS support this feature, so the kernel will distribute
+        incoming datagrams across all sockets of the group. Each socket
+        of the group is served by its own strand. In the Asio service pool
+        mode sockets are spread over IO services of the pool, otherwise
+        all of them share the same IO service.
+
+        In this mode ReceiveAsync() starts continuous receive loops on all
+        sockets of the group, so onReceived() could be called from several
+        threads at the same time and should be thread-safe. Datagrams are
+        sent from the main server socket. Receive batch and GRO options
+        are applied to the main server socket only.
+
+        Optional steering attaches a classic BPF program to the group which
+        selects the socket by the flow hash of the received datagram
+        (Linux only).
+
+        \param enable - Enable/disable option
+        \param steering - Enable/disable flow hash steering (default is false)
+    */
+    void SetupReusePortGroup(bool enable, bool steering = false) noexcept { _option_reuse_port_group = enable; _option_reuse_port_steering = steering; }
+    //! Setup option: receive batch size
+    /*!
+        This option will enable batched receive of up to the given count
+        of datagrams per socket wakeup using recvmmsg() if the OS support
+        this feature. Each received datagram is delivered with a separate
+        onReceived() notification. Value 1 disables batched receive.
+
+        \param datagrams - Maximal count of datagrams to receive per wakeup (default is 1)
+    */
+    void SetupReceiveBatch(size_t datagrams) noexcept { _option_receive_batch = (datagrams > 0) ? datagrams : 1; }
+    //! Setup option: send batch size
+    /*!
+        This option will enable batched send of up to the given count of
+        queued datagrams per socket wakeup using sendmmsg() if the OS support
+        this feature. Value 1 disables batched send.
+
+        \param datagrams - Maximal count of datagrams to send per wakeup (default is 1)
+    */
+    void SetupSendBatch(size_t datagrams) noexcept { _option_send_batch = (datagrams > 0) ? datagrams : 1; }
+    //! Setup option: GSO segment size
+    /*!
+        This option will setup UDP_SEGMENT (generic segmentation offload)
+        if the OS support this feature. Each sent buffer larger than the
+        segment size will be split by the kernel into datagrams of the
+        given size (the last one could be shorter). Buffer should not
+        exceed 64 segments and the maximal UDP datagram size. onSent()
+        is called once for the whole buffer. Value 0 disables GSO. If the
+        OS rejects the option, onError() is called and datagrams are sent
+        without segmentation.
+
+        \param segment_size - Datagram segment size (default is 0)
+    */
+    void SetupGSO(size_t segment_size) noexcept { _option_gso_segment_size = segment_size; }
+    //! Setup option: GRO
+    /*!
+        This option will setup UDP_GRO (generic receive offload) if the
+        OS support this feature. The kernel will coalesce datagrams of
+        the same flow into one buffer and onReceived() will be called
+        for each of original datagrams. If the OS rejects the option,
+        onError() is called and datagrams are received one by one.
+
+        \param enable - Enable/disable option
+    */
+    void SetupGRO(bool enable) noexcept { _option_gro = enable; }
+    //! Setup option: sessions mode
+    /*!
+        This option will enable/disable virtual UDP sessions. In this mode
+        the server creates a session with CreateSession() on the first
+        datagram received from a new client endpoint, dispatches received
+        datagrams to UDPSession::onReceived() instead of onReceived() and
+        starts a continuous receive loop right after the server is started.
+
+        Should be called before the server is started.
+
+        \param enable - Enable/disable option
+    */
+    void SetupSessions(bool enable) noexcept { _option_sessions = enable; }
+    //! Setup option: session timeout
+    /*!
+        Sessions idle for the session timeout are disconnected. Idle sessions
+        are checked four times per the session timeout, so an idle session
+        is disconnected before 1.25 of the session timeout is passed. Zero
+        timeout disables idle sessions expiration.
+
+        Should be called before the server is started.
+
+        \param timeout - Idle session timeout (default is 30 seconds)
+    */
+    void SetupSessionTimeout(const CppCommon::Timespan& timeout) noexcept { _option_session_timeout = timeout; }
+    //! Setup option: send buffer limit
+    /*!
+        This option will limit the size of datagrams queued by SendAsync()
+        and not yet passed to the socket. Datagram which exceeds the limit
+        is not queued and SendAsync() returns 'false', so a slow socket
+        cannot grow the send buffer without bound. Zero limit disables
+        the check.
+
+        \param limit - Send buffer limit in bytes (default is 0)
+    */
+    void SetupSendBufferLimit(size_t limit) noexcept { _option_send_buffer_limit = limit; }
+    //! Setup option: session send limit
+    /*!
+        This option will limit the size of datagrams queued by each session
+        and not yet sent. Sessions share the server send buffer, so the limit
+        keeps one session from filling the whole send buffer limit. Datagram
+        which exceeds the limit is not queued and UDPSession::SendAsync()
+        returns 'false'. Zero limit disables the check.
+
+        \param limit - Session send limit in bytes (default is 0)
+    */
+    void SetupSessionSendLimit(size_t limit) noexcept { _option_session_send_limit = limit; }
     //! Setup option: receive buffer size
     /*!
         This option will setup SO_RCVBUF if the OS support this feature.
@@ -285,6 +451,18 @@ public:
     */
     void SetupSendBufferSize(size_t size);
 
+protected:
+    //! Create session factory method
+    /*!
+        \param server - Connected server
+        \param endpoint - Client endpoint
+        \return UDP session
+    */
+    virtual std::shared_ptr<UDPSession> CreateSession(std::shared_ptr<UDPServer> server, const asio::ip::udp::endpoint& endpoint) { return std::make_shared<UDPSession>(server, endpoint); }
+
+    //! Get all connected sessions
+    std::vector<std::shared_ptr<UDPSession>> GetSessions();
+
 protected:
     //! Handle server started notification
     virtual void onStarted() {}
@@ -313,6 +491,17 @@ protected:
     */
     virtual void onSent(const asio::ip::udp::endpoint& endpoint, size_t sent) {}
 
+    //! Handle session connected notification
+    /*!
+        \param session - Connected session
+    */
+    virtual void onConnected(std::shared_ptr<UDPSession>& session) {}
+    //! Handle session disconnected notification
+    /*!
+        \param session - Disconnected session
+    */
+    virtual void onDisconnected(std::shared_ptr<UDPSession>& session) {}
+
     //! Handle error notification
     /*!
         \param error - Error code
@@ -339,29 +528,169 @@ private:
     asio::ip::udp::socket _socket;
     std::atomic<bool> _started;
     // Server statistic
+    uint64_t _bytes_pending;
     uint64_t _bytes_sending;
     uint64_t _bytes_sent;
-    uint64_t _bytes_received;
+    std::atomic<uint64_t> _bytes_received;
     uint64_t _datagrams_sent;
-    uint64_t _datagrams_received;
-    // Multicast, receive and send endpoints
+    std::atomic<uint64_t> _datagrams_received;
+    // Multicast and receive endpoints
     asio::ip::udp::endpoint _multicast_endpoint;
     asio::ip::udp::endpoint _receive_endpoint;
-    asio::ip::udp::endpoint _send_endpoint;
     // Receive buffer
     bool _receiving;
     std::vector<uint8_t> _receive_buffer;
     HandlerStorage _receive_storage;
+    std::shared_ptr<UDPSession> _receive_session;
+    // Receive batch buffers
+    std::vector<uint8_t> _receive_batch_buffer;
+    std::vector<asio::ip::udp::endpoint> _receive_batch_endpoints;
+#if defined(__linux__)
+    std::vector<uint8_t> _receive_batch_control;
+    std::vector<iovec> _receive_batch_vectors;
+    std::vector<mmsghdr> _receive_batch_headers;
+#endif
+    // Reuse port socket group
+    struct GroupSocket
+    {
+        asio::io_service::strand strand;
+        asio::ip::udp::socket socket;
+        asio::ip::udp::endpoint receive_endpoint;
+        std::vector<uint8_t> receive_buffer;
+        HandlerStorage receive_storage;
+        std::shared_ptr<UDPSession> receive_session;
+
+        explicit GroupSocket(asio::io_service& io_service) : strand(io_service), socket(io_service) {}
+    };
+    std::mutex _group_lock;
+    std::vector<std::shared_ptr<GroupSocket>> _group_sockets;
+    std::atomic<bool> _continuous_receiving;
+    // Server sessions
+    struct EndpointHash
+    {
+        size_t operator()(const asio::ip::udp::endpoint& endpoint) const noexcept;
+    };
+    mutable std::shared_mutex _sessions_lock;
+    std::unordered_map<asio::ip::udp::endpoint, std::shared_ptr<UDPSession>, EndpointHash> _sessions;
+    std::shared_ptr<Timer> _sessions_timer;
     // Send buffer
+    struct SendDatagram
+    {
+        asio::ip::udp::endpoint endpoint;
+        size_t offset;
+        size_t size;
+        std::shared_ptr<UDPSession> session;
+    };
+    struct SentDatagram
+    {
+        asio::ip::udp::endpoint endpoint;
+        size_t size;
+        size_t sent;
+        std::shared_ptr<UDPSession> session;
+    };
     bool _sending;
-    std::vector<uint8_t> _send_buffer;
+    std::mutex _send_lock;
+    std::vector<uint8_t> _send_buffer_main;
+    std::vector<uint8_t> _send_buffer_flush;
+    std::vector<SendDatagram> _send_datagrams_main;
+    std::vector<SendDatagram> _send_datagrams_flush;
+    size_t _send_datagrams_flush_offset;
     HandlerStorage _send_storage;
+#if defined(__linux__)
+    // Send batch buffers
+    std::vector<iovec> _send_batch_vectors;
+    std::vector<mmsghdr> _send_batch_headers;
+    std::vector<SentDatagram> _send_batch_sent;
+#endif
     // Options
     bool _option_reuse_address;
     bool _option_reuse_port;
+    bool _option_reuse_port_group;
+    bool _option_reuse_port_steering;
+    size_t _option_receive_batch;
+    size_t _option_send_batch;
+    size_t _option_gso_segment_size;
+    bool _option_gro;
+    bool _option_sessions;
+    CppCommon::Timespan _option_session_timeout;
+    size_t _option_send_buffer_limit;
+    size_t _option_session_send_limit;
 
     //! Try to receive new datagram
     void TryReceive();
+#if defined(__linux__)
+    //! Try to receive a batch of new datagrams
+    void TryReceiveBatch();
+#endif
+
+    //! Prepare receive batch buffers
+    void PrepareReceiveBatch();
+
+    //! Open reuse port socket group
+    void OpenGroup();
+    //! Close reuse port socket group
+    void CloseGroup();
+    //! Try to receive new datagram using the reuse port group socket
+    /*!
+        \param group_socket - Reuse port group socket
+    */
+    void TryReceiveGroup(std::shared_ptr<GroupSocket> group_socket);
+
+    //! Process the received datagram
+    /*!
+        Update statistic and dispatch the datagram to the session of the
+        client endpoint in sessions mode or to onReceived() otherwise.
+
+        \param endpoint - Received endpoint
+        \param buffer - Received datagram buffer
+        \param size - Received datagram buffer size
+        \param session - Session of the last datagram received by the same socket
+    */
+    void ReceiveDatagram(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size, std::shared_ptr<UDPSession>& session);
+
+    //! Find the session of the client endpoint or create a new one
+    std::shared_ptr<UDPSession> RegisterSession(const asio::ip::udp::endpoint& endpoint);
+    //! Unregister the session by client endpoint and session Id
+    /*!
+        \param endpoint - Client endpoint
+        \param id - Session Id
+    */
+    void UnregisterSession(const asio::ip::udp::endpoint& endpoint, const CppCommon::UUID& id);
+    //! Disconnect idle sessions
+    /*!
+        \param timer - Idle sessions expiration timer which called the handler
+        \param canceled - Timer canceled flag
+    */
+    void ExpireSessions(const std::shared_ptr<Timer>& timer, bool canceled);
+
+    //! Enqueue datagram into the send buffer
+    /*!
+        \param session - Sending session (null if the datagram is sent by the server)
+        \param endpoint - Endpoint to send
+        \param buffer - Datagram buffer to send
+        \param size - Datagram buffer size
+        \return 'true' if the datagram was successfully enqueued, 'false' if the server is not started or the send limit is exceeded
+    */
+    bool EnqueueSend(std::shared_ptr<UDPSession> session, const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size);
+    //! Try to send pending datagrams
+    void TrySend();
+#if defined(__linux__)
+    //! Try to send a batch of pending datagrams
+    void TrySendBatch();
+#endif
+    //! Complete the current flushed datagram
+    /*!
+        \param sent - Size of sent datagram (zero if the datagram was dropped)
+    */
+    void CompleteSend(size_t sent);
+    //! Release the current flushed datagram without calling the datagram sent handlers
+    /*!
+        \param sent - Size of sent datagram (zero if the datagram was dropped)
+        \return Released datagram to notify about
+    */
+    SentDatagram ReleaseSend(size_t sent);
+    //! Call the datagram sent handlers of the server and the session
+    void NotifySent(const SentDatagram& datagram);
 
     //! Clear send/receive buffers
     void ClearBuffers();
@@ -0,0 +1,162 @@
+/*!
+    \file udp_session.h
+    \brief UDP session definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_ASIO_UDP_SESSION_H
+#define CPPSERVER_ASIO_UDP_SESSION_H
+
+#include "service.h"
+
+#include "system/uuid.h"
+
+namespace CppServer {
+namespace Asio {
+
+class UDPServer;
+
+//! UDP session
+/*!
+    UDP session is a virtual session of the UDP server bound to a single
+    client endpoint. Session is created by the UDP server in sessions mode
+    on the first datagram received from a new client endpoint and
+    disconnected when the client is idle for the session timeout.
+
+    Thread-safe.
+*/
+class UDPSession : public std::enable_shared_from_this<UDPSession>
+{
+    friend class UDPServer;
+
+public:
+    //! Initialize the session with a given server and client endpoint
+    /*!
+        \param server - Connected server
+        \param endpoint - Client endpoint
+    */
+    UDPSession(std::shared_ptr<UDPServer> server, const asio::ip::udp::endpoint& endpoint);
+    UDPSession(const UDPSession&) = delete;
+    UDPSession(UDPSession&&) = delete;
+    virtual ~UDPSession() = default;
+
+    UDPSession& operator=(const UDPSession&) = delete;
+    UDPSession& operator=(UDPSession&&) = delete;
+
+    //! Get the session Id
+    const CppCommon::UUID& id() const noexcept { return _id; }
+
+    //! Get the server
+    std::shared_ptr<UDPServer>& server() noexcept { return _server; }
+    //! Get the client endpoint
+    const asio::ip::udp::endpoint& endpoint() const noexcept { return _endpoint; }
+
+    //! Get the number of bytes pending sent by the session
+    uint64_t bytes_pending() const noexcept { return _bytes_pending; }
+    //! Get the number of bytes sent by the session
+    uint64_t bytes_sent() const noexcept { return _bytes_sent; }
+    //! Get the number of bytes received by the session
+    uint64_t bytes_received() const noexcept { return _bytes_received; }
+    //! Get the number datagrams sent by the session
+    uint64_t datagrams_sent() const noexcept { return _datagrams_sent; }
+    //! Get the number datagrams received by the session
+    uint64_t datagrams_received() const noexcept { return _datagrams_received; }
+
+    //! Is the session connected?
+    bool IsConnected() const noexcept { return _connected; }
+
+    //! Disconnect the session
+    /*!
+        \return 'true' if the section was successfully disconnected, 'false' if the section is already disconnected
+    */
+    virtual bool Disconnect();
+
+    //! Send datagram to the client (synchronous)
+    /*!
+        \param buffer - Datagram buffer to send
+        \param size - Datagram buffer size
+        \return Size of sent datagram
+    */
+    virtual size_t Send(const void* buffer, size_t size);
+    //! Send text to the client (synchronous)
+    /*!
+        \param text - Text to send
+        \return Size of sent text
+    */
+    virtual size_t Send(std::string_view text) { return Send(text.data(), text.size()); }
+
+    //! Send datagram to the client (asynchronous)
+    /*!
+        Datagram is queued into the server send buffer shared by all sessions.
+
+        \param buffer - Datagram buffer to send
+        \param size - Datagram buffer size
+        \return 'true' if the datagram was successfully sent, 'false' if the session is not connected or the send limit is exceeded
+    */
+    virtual bool SendAsync(const void* buffer, size_t size);
+    //! Send text to the client (asynchronous)
+    /*!
+        \param text - Text to send
+        \return 'true' if the text was successfully sent, 'false' if the session is not connected
+    */
+    virtual bool SendAsync(std::string_view text) { return SendAsync(text.data(), text.size()); }
+
+protected:
+    //! Handle session connected notification
+    virtual void onConnected() {}
+    //! Handle session disconnected notification
+    virtual void onDisconnected() {}
+
+    //! Handle datagram received notification
+    /*!
+        Notification is called when another datagram was received from
+        the client.
+
+        \param buffer - Received datagram buffer
+        \param size - Received datagram buffer size
+    */
+    virtual void onReceived(const void* buffer, size_t size) {}
+    //! Handle datagram sent notification
+    /*!
+        Notification is called when a datagram queued by SendAsync() was
+        sent to the client.
+
+        \param sent - Size of sent datagram (zero if the datagram was dropped)
+        \param pending - Size of pending datagrams of the session
+    */
+    virtual void onSent(size_t sent, size_t pending) {}
+
+private:
+    // Session Id
+    CppCommon::UUID _id;
+    // Server & client endpoint
+    std::shared_ptr<UDPServer> _server;
+    asio::ip::udp::endpoint _endpoint;
+    std::atomic<bool> _connected;
+    // Last activity timestamp
+    std::atomic<uint64_t> _activity;
+    // Session statistic
+    std::atomic<uint64_t> _bytes_pending;
+    std::atomic<uint64_t> _bytes_sent;
+    std::atomic<uint64_t> _bytes_received;
+    std::atomic<uint64_t> _datagrams_sent;
+    std::atomic<uint64_t> _datagrams_received;
+
+    //! Connect the session
+    void Connect();
+    //! Process the datagram received from the client
+    void ReceiveDatagram(const void* buffer, size_t size);
+    //! Complete the datagram sent to the client
+    /*!
+        \param size - Size of queued datagram
+        \param sent - Size of sent datagram (zero if the datagram was dropped)
+    */
+    void CompleteSend(size_t size, size_t sent);
+};
+
+} // namespace Asio
+} // namespace CppServer
+
+#endif // CPPSERVER_ASIO_UDP_SESSION_H
@@ -0,0 +1,239 @@
+/*!
+    \file hpack.h
+    \brief HTTP/2 HPACK header compression definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HPACK_H
+#define CPPSERVER_HTTP_HPACK_H
+
+#include "http.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace CppServer {
+namespace HTTP {
+
+//! HPACK header fields list
+typedef std::vector<std::pair<std::string, std::string>> HPACKHeaders;
+
+//! HPACK dynamic table
+/*!
+    HPACK dynamic table keeps recently used header fields in the FIFO
+    order. The newest entry has the lowest index. Entries are evicted
+    when the table size exceeds the maximal table size.
+
+    Not thread-safe.
+*/
+class HPACKTable
+{
+public:
+    //! Initialize HPACK dynamic table with a given maximal table size
+    /*!
+        \param max_size - Maximal table size (default is 4096)
+    */
+    explicit HPACKTable(size_t max_size = 4096) : _size(0), _max_size(max_size) {}
+    HPACKTable(const HPACKTable&) = default;
+    HPACKTable(HPACKTable&&) = default;
+    ~HPACKTable() = default;
+
+    HPACKTable& operator=(const HPACKTable&) = default;
+    HPACKTable& operator=(HPACKTable&&) = default;
+
+    //! Get the count of table entries
+    size_t count() const noexcept { return _entries.size(); }
+    //! Get the table size
+    size_t size() const noexcept { return _size; }
+    //! Get the maximal table size
+    size_t max_size() const noexcept { return _max_size; }
+
+    //! Get the header field by the HPACK index (static and dynamic)
+    /*!
+        \param index - HPACK index (1-based)
+        \param name - Header field name
+        \param value - Header field value
+        \return 'true' if the header field was found, 'false' if the index is invalid
+    */
+    bool Get(size_t index, std::string_view& name, std::string_view& value) const noexcept;
+
+    //! Find the header field in the static and dynamic tables
+    /*!
+        \param name - Header field name
+        \param value - Header field value
+        \param name_index - HPACK index of the found header field name (zero if not found)
+        \return HPACK index of the found header field with the same value (zero if not found)
+    */
+    size_t Find(std::string_view name, std::string_view value, size_t& name_index) const noexcept;
+
+    //! Add the header field to the dynamic table
+    /*!
+        \param name - Header field name
+        \param value - Header field value
+    */
+    void Add(std::string_view name, std::string_view value);
+
+    //! Resize the dynamic table
+    /*!
+        \param max_size - Maximal table size
+    */
+    void Resize(size_t max_size);
+
+    //! Count of entries in the HPACK static table
+    static const size_t STATIC_COUNT = 61;
+
+private:
+    std::deque<std::pair<std::string, std::string>> _entries;
+    size_t _size;
+    size_t _max_size;
+
+    // Evict the oldest entries to fit the given table size
+    void Evict(size_t max_size);
+};
+
+//! HPACK header decoder
+/*!
+    HPACK decoder is used to decode HTTP/2 header blocks (RFC 7541)
+    including Huffman encoded strings and dynamic table updates.
+
+    Decoded header list size is limited to protect from small header blocks
+    which reference large dynamic table entries many times. The size of the
+    header list is the sum of name and value sizes plus 32 bytes for each
+    header field (RFC 7540 section 6.5.2).
+
+    Not thread-safe.
+*/
+class HPACKDecoder
+{
+public:
+    //! Initialize HPACK decoder with a given maximal dynamic table size and header list size
+    /*!
+        \param max_table_size - Maximal dynamic table size (default is 4096)
+        \param max_header_list_size - Maximal decoded header list size or zero for no limit (default is 0)
+    */
+    explicit HPACKDecoder(size_t max_table_size = 4096, size_t max_header_list_size = 0) : _table(max_table_size), _max_table_size(max_table_size), _max_header_list_size(max_header_list_size), _overflow(false) {}
+    HPACKDecoder(const HPACKDecoder&) = default;
+    HPACKDecoder(HPACKDecoder&&) = default;
+    ~HPACKDecoder() = default;
+
+    HPACKDecoder& operator=(const HPACKDecoder&) = default;
+    HPACKDecoder& operator=(HPACKDecoder&&) = default;
+
+    //! Get the dynamic table
+    const HPACKTable& table() const noexcept { return _table; }
+    //! Get the maximal decoded header list size
+    size_t max_header_list_size() const noexcept { return _max_header_list_size; }
+    //! Is the last header block exceeded the maximal decoded header list size?
+    bool overflow() const noexcept { return _overflow; }
+
+    //! Decode the header block
+    /*!
+        Decoded header fields are appended to the given list. Decoding is
+        stopped as soon as the decoded header list size exceeds the limit,
+        so the decoder state is not consistent after the overflow.
+
+        \param buffer - Header block buffer
+        \param size - Header block size
+        \param headers - Decoded header fields
+        \return 'true' if the header block was successfully decoded, 'false' in case of compression error or overflow
+    */
+    bool Decode(const void* buffer, size_t size, HPACKHeaders& headers);
+
+private:
+    HPACKTable _table;
+    size_t _max_table_size;
+    size_t _max_header_list_size;
+    bool _overflow;
+
+    // Account the decoded header field in the header list size
+    bool Account(size_t& list_size, size_t name_size, size_t value_size) noexcept;
+};
+
+//! HPACK header encoder
+/*!
+    HPACK encoder is used to encode HTTP/2 header blocks (RFC 7541).
+    Header fields are indexed in the dynamic table, strings are Huffman
+    encoded when it makes them shorter. Authorization header fields are
+    never indexed.
+
+    Not thread-safe.
+*/
+class HPACKEncoder
+{
+public:
+    //! Initialize HPACK encoder with a given maximal dynamic table size
+    /*!
+        \param max_table_size - Maximal dynamic table size (default is 4096)
+    */
+    explicit HPACKEncoder(size_t max_table_size = 4096) : _table(max_table_size), _size_update(false) {}
+    HPACKEncoder(const HPACKEncoder&) = default;
+    HPACKEncoder(HPACKEncoder&&) = default;
+    ~HPACKEncoder() = default;
+
+    HPACKEncoder& operator=(const HPACKEncoder&) = default;
+    HPACKEncoder& operator=(HPACKEncoder&&) = default;
+
+    //! Get the dynamic table
+    const HPACKTable& table() const noexcept { return _table; }
+
+    //! Set the maximal dynamic table size allowed by the decoder
+    /*!
+        Dynamic table size update is encoded at the beginning of the next header block.
+
+        \param max_table_size - Maximal dynamic table size
+    */
+    void SetMaxTableSize(size_t max_table_size);
+
+    //! Encode the header field
+    /*!
+        \param output - Output header block
+        \param name - Header field name in lower case
+        \param value - Header field value
+    */
+    void Encode(std::string& output, std::string_view name, std::string_view value);
+
+private:
+    HPACKTable _table;
+    bool _size_update;
+};
+
+//! HPACK Huffman coding
+/*!
+    Thread-safe.
+*/
+class HPACKHuffman
+{
+public:
+    HPACKHuffman() = delete;
+    HPACKHuffman(const HPACKHuffman&) = delete;
+    HPACKHuffman(HPACKHuffman&&) = delete;
+    ~HPACKHuffman() = delete;
+
+    HPACKHuffman& operator=(const HPACKHuffman&) = delete;
+    HPACKHuffman& operator=(HPACKHuffman&&) = delete;
+
+    //! Get the Huffman encoded size of the given string
+    static size_t EncodedSize(std::string_view str) noexcept;
+    //! Encode the given string and append it to the output
+    static void Encode(std::string& output, std::string_view str);
+    //! Decode the given Huffman encoded string and append it to the output
+    /*!
+        \param output - Output string
+        \param buffer - Huffman encoded buffer
+        \param size - Huffman encoded size
+        \return 'true' if the string was successfully decoded, 'false' in case of invalid code or padding
+    */
+    static bool Decode(std::string& output, const void* buffer, size_t size);
+};
+
+} // namespace HTTP
+} // namespace CppServer
+
+#endif // CPPSERVER_HTTP_HPACK_H
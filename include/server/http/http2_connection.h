@@ -0,0 +1,310 @@
+/*!
+    \file http2_connection.h
+    \brief HTTP/2 connection definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HTTP2_CONNECTION_H
+#define CPPSERVER_HTTP_HTTP2_CONNECTION_H
+
+#include "hpack.h"
+#include "http_request.h"
+#include "http_response.h"
+
+#include <map>
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTP/2 connection
+/*!
+    HTTP/2 connection implements the HTTP/2 protocol (RFC 9113) over any
+    transport: framing, HPACK header compression, SETTINGS negotiation,
+    flow control and stream multiplexing. Received bytes are fed with
+    Receive(), the bytes to send are notified with onSend().
+
+    Requests and responses are exchanged as HTTPRequest and HTTPResponse
+    with the HTTP/2 stream identifier set, so HTTP/1.x processing code
+    could handle them as is. Messages are notified when they are
+    completely received (END_STREAM).
+
+    Body of the sent message could be provided with the message or sent
+    later with SendBody() if the message has the body length set or the
+    chunked transfer encoding enabled. Body data is queued per stream and
+    sent as soon as the flow control windows allow it.
+
+    Received messages are checked against the header size, header count
+    and body size limits. Server answers the request over the limit with
+    the error response and asks the client to stop sending the request
+    body with RST_STREAM(NO_ERROR), client resets the response stream.
+    The stream error is notified with onStreamError() in both cases.
+
+    Not thread-safe.
+*/
+class HTTP2Connection
+{
+public:
+    //! Initialize HTTP/2 connection
+    /*!
+        \param server - Server side of the connection flag
+    */
+    explicit HTTP2Connection(bool server);
+    HTTP2Connection(const HTTP2Connection&) = delete;
+    HTTP2Connection(HTTP2Connection&&) = delete;
+    virtual ~HTTP2Connection() = default;
+
+    HTTP2Connection& operator=(const HTTP2Connection&) = delete;
+    HTTP2Connection& operator=(HTTP2Connection&&) = delete;
+
+    //! Is the server side of the connection?
+    bool server() const noexcept { return _server; }
+    //! Get the connection error flag
+    bool error() const noexcept { return _error; }
+
+    //! Get the count of active streams
+    size_t streams() const noexcept { return _streams.size(); }
+    //! Get the maximal count of concurrent streams allowed by the peer
+    size_t max_streams() const noexcept { return _remote_max_streams; }
+
+    //! Get the option: maximal received message header size
+    size_t option_max_header_size() const noexcept { return _option_max_header_size; }
+    //! Get the option: maximal count of received message headers
+    size_t option_max_headers() const noexcept { return _option_max_headers; }
+    //! Get the option: maximal received message body size
+    size_t option_max_body_size() const noexcept { return _option_max_body_size; }
+
+    //! Setup option: maximal received message header size
+    /*!
+        Header size is the size of all header field names and values as
+        they would be sent in HTTP/1.x message. Server answers the request
+        with a larger header with "431 Request Header Fields Too Large".
+
+        \param size - Maximal header size in bytes or zero for no limit (default is 0)
+    */
+    void SetupMaxHeaderSize(size_t size) noexcept { _option_max_header_size = size; }
+    //! Setup option: maximal count of received message headers
+    /*!
+        Server answers the request with more header fields with "431 Request
+        Header Fields Too Large".
+
+        \param count - Maximal count of header fields or zero for no limit (default is 0)
+    */
+    void SetupMaxHeaders(size_t count) noexcept { _option_max_headers = count; }
+    //! Setup option: maximal received message body size
+    /*!
+        Server answers the request with a larger body with "413 Payload Too
+        Large". Content length of the message is checked as soon as its
+        header is received, body data is checked while it is received, so
+        the stream receive window is not replenished for the rejected body.
+
+        \param size - Maximal body size in bytes or zero for no limit (default is 0)
+    */
+    void SetupMaxBodySize(size_t size) noexcept { _option_max_body_size = size; }
+
+    //! Is the connection going away (GOAWAY was sent or received)?
+    bool IsGoingAway() const noexcept { return _goaway_sent || _goaway_received; }
+
+    //! Start the connection
+    /*!
+        Client sends the connection preface, both sides send the initial
+        SETTINGS frame and enlarge the connection receive window.
+    */
+    void Start();
+
+    //! Receive data from the transport
+    /*!
+        \param buffer - Buffer to receive
+        \param size - Buffer size
+        \return 'true' if the data was successfully processed, 'false' in case of connection error
+    */
+    bool Receive(const void* buffer, size_t size);
+
+    //! Send HTTP request over a new stream (client side)
+    /*!
+        \param request - HTTP request
+        \return Stream identifier or zero if the request could not be sent
+    */
+    uint32_t SendRequest(const HTTPRequest& request);
+
+    //! Send HTTP response to the request stream (server side)
+    /*!
+        \param stream - Request stream identifier
+        \param response - HTTP response
+        \return 'true' if the response was successfully sent, 'false' if the stream is closed
+    */
+    bool SendResponse(uint32_t stream, const HTTPResponse& response);
+
+    //! Send the rest of the message body to the stream
+    /*!
+        Message with the chunked transfer encoding is finished with an
+        empty body part, otherwise with the last byte of the body length.
+
+        \param stream - Stream identifier
+        \param buffer - Body buffer
+        \param size - Body size
+        \return 'true' if the body was successfully sent, 'false' if the stream is closed
+    */
+    bool SendBody(uint32_t stream, const void* buffer, size_t size);
+
+    //! Reset the stream
+    /*!
+        \param stream - Stream identifier
+    */
+    void ResetStream(uint32_t stream);
+
+    //! Shutdown the connection gracefully
+    /*!
+        GOAWAY frame is sent to the peer, active streams are completed.
+    */
+    void Shutdown();
+
+protected:
+    //! Handle send data notification
+    /*!
+        Notification is called when the connection has data to send
+        to the transport.
+
+        \param buffer - Buffer to send
+        \param size - Buffer size
+    */
+    virtual void onSend(const void* buffer, size_t size) = 0;
+
+    //! Handle HTTP request received notification (server side)
+    /*!
+        \param request - HTTP request
+    */
+    virtual void onReceivedRequest(const HTTPRequest& request) {}
+
+    //! Handle HTTP response received notification (client side)
+    /*!
+        \param response - HTTP response
+    */
+    virtual void onReceivedResponse(const HTTPResponse& response) {}
+
+    //! Handle stream error notification
+    /*!
+        Notification is called when the stream was reset or refused
+        by the peer or reset because of the malformed message.
+
+        \param stream - Stream identifier
+        \param error - Stream error
+    */
+    virtual void onStreamError(uint32_t stream, const std::string& error) {}
+
+private:
+    // HTTP/2 stream state
+    struct Stream
+    {
+        // Received message
+        HPACKHeaders headers;
+        std::string body;
+        bool headers_received{false};
+        bool end_received{false};
+        // Sent message
+        bool headers_sent{false};
+        bool end_sent{false};
+        bool head{false};
+        bool chunked{false};
+        size_t remaining{0};
+        // Body data waiting for the flow control window
+        std::string pending;
+        size_t pending_offset{0};
+        bool pending_end{false};
+        // Flow control windows
+        int64_t send_window{0};
+        int64_t recv_window{0};
+    };
+
+    bool _server;
+    bool _error;
+    bool _settings_received;
+    bool _goaway_sent;
+    bool _goaway_received;
+    size_t _preface;
+
+    // Streams
+    std::map<uint32_t, Stream> _streams;
+    uint32_t _next_stream;
+    uint32_t _last_peer_stream;
+
+    // Peer settings
+    size_t _remote_max_streams;
+    size_t _remote_max_frame_size;
+    int64_t _remote_initial_window;
+
+    // Connection flow control windows
+    int64_t _send_window;
+    int64_t _recv_window;
+
+    // Header compression
+    HPACKEncoder _encoder;
+    HPACKDecoder _decoder;
+
+    // Header block split into CONTINUATION frames
+    uint32_t _continuation_stream;
+    bool _continuation_end;
+    std::string _header_block;
+
+    // Received message limits
+    size_t _option_max_header_size;
+    size_t _option_max_headers;
+    size_t _option_max_body_size;
+
+    // Incomplete received frame
+    std::string _input;
+    // Data to send
+    std::string _output;
+    // Lower case header name buffer
+    std::string _name;
+
+    // Process the received frame
+    void ProcessFrame(uint8_t type, uint8_t flags, uint32_t stream, const uint8_t* payload, size_t size);
+    void ProcessData(uint8_t flags, uint32_t stream, const uint8_t* payload, size_t size);
+    void ProcessHeaders(uint8_t flags, uint32_t stream, const uint8_t* payload, size_t size);
+    void ProcessHeaderBlock(uint32_t stream, bool end);
+    void ProcessSettings(uint8_t flags, uint32_t stream, const uint8_t* payload, size_t size);
+    void ProcessWindowUpdate(uint32_t stream, const uint8_t* payload, size_t size);
+    void ProcessResetStream(uint32_t stream, const uint8_t* payload, size_t size);
+    void ProcessPing(uint8_t flags, uint32_t stream, const uint8_t* payload, size_t size);
+    void ProcessGoAway(uint32_t stream, const uint8_t* payload, size_t size);
+
+    // Is the stream identifier not used yet?
+    bool IsIdle(uint32_t stream) const noexcept;
+    // Validate received header fields and return the error if the message is malformed
+    std::string Validate(const Stream& stream, const HPACKHeaders& headers, bool trailers) const;
+    // Notify the completely received message
+    void Complete(uint32_t stream);
+    // Close the stream if both sides finished their messages
+    void Close(uint32_t stream);
+    // Reject the received message over the limits and notify the stream error
+    void Reject(uint32_t stream, int status, const std::string& error);
+    // Reset the stream with the given error code and notify the stream error
+    void Fail(uint32_t stream, uint32_t code, const std::string& error);
+    // Close the connection with the given error code
+    void Fail(uint32_t code);
+
+    // Encode the header field with the lower case name unless it is connection specific
+    void EncodeHeader(std::string& block, std::string_view name, std::string_view value);
+    // Send the message header and body of the stream
+    void SendMessage(uint32_t id, Stream& stream, const std::string& block, std::string_view body, size_t length, bool chunked);
+    // Queue body data of the stream and send it within flow control windows
+    void SendData(uint32_t id, Stream& stream, const void* buffer, size_t size, bool end);
+    // Send queued body data of all streams
+    void SendPending();
+
+    // Write frames to the output
+    void WriteFrame(uint8_t type, uint8_t flags, uint32_t stream, const void* payload, size_t size);
+    void WriteHeaders(uint32_t stream, const std::string& block, bool end);
+    void WriteResetStream(uint32_t stream, uint32_t code);
+    void WriteWindowUpdate(uint32_t stream, uint32_t increment);
+    void WriteGoAway(uint32_t code);
+    // Flush the output to the transport
+    void Flush();
+};
+
+} // namespace HTTP
+} // namespace CppServer
+
+#endif // CPPSERVER_HTTP_HTTP2_CONNECTION_H
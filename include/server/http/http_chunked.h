@@ -0,0 +1,110 @@
+/*!
+    \file http_chunked.h
+    \brief HTTP chunked transfer encoding definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HTTP_CHUNKED_H
+#define CPPSERVER_HTTP_HTTP_CHUNKED_H
+
+#include "http.h"
+
+#include <cstddef>
+#include <string>
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTP chunked transfer encoding decoder
+/*!
+    HTTP chunked decoder is used to decode the body of HTTP request or
+    response with "Transfer-Encoding: chunked" incrementally. Decoded
+    body parts are returned as slices of the given buffer without
+    copying. Chunk extensions and trailer fields are skipped.
+
+    Not thread-safe.
+*/
+class HTTPChunkedDecoder
+{
+public:
+    HTTPChunkedDecoder() { Clear(); }
+    HTTPChunkedDecoder(const HTTPChunkedDecoder&) = default;
+    HTTPChunkedDecoder(HTTPChunkedDecoder&&) = default;
+    ~HTTPChunkedDecoder() = default;
+
+    HTTPChunkedDecoder& operator=(const HTTPChunkedDecoder&) = default;
+    HTTPChunkedDecoder& operator=(HTTPChunkedDecoder&&) = default;
+
+    //! Get the decoder error flag
+    bool error() const noexcept { return _error; }
+    //! Is the chunked body completely decoded?
+    bool complete() const noexcept { return _state == State::COMPLETE; }
+
+    //! Clear the decoder state
+    void Clear();
+
+    //! Decode the next part of the chunked body
+    /*!
+        Decoding stops after the next decoded body part, at the end of the
+        chunked body or at the end of the given buffer.
+
+        \param buffer - Buffer to decode
+        \param size - Buffer size
+        \param part - Decoded body part in the given buffer
+        \param part_size - Decoded body part size (could be zero)
+        \return Count of consumed bytes of the given buffer
+    */
+    size_t Decode(const void* buffer, size_t size, const char*& part, size_t& part_size);
+
+private:
+    enum class State
+    {
+        SIZE,
+        EXTENSION,
+        SIZE_LF,
+        DATA,
+        DATA_CR,
+        DATA_LF,
+        TRAILER_START,
+        TRAILER,
+        TRAILER_LF,
+        END_LF,
+        COMPLETE
+    };
+
+    State _state;
+    bool _error;
+    size_t _chunk_size;
+    size_t _chunk_digits;
+};
+
+//! HTTP chunked transfer encoding encoder
+/*!
+    Each chunk is sent as the chunk header, the chunk data and the chunk
+    trailer. An empty chunk finishes the chunked body.
+
+    Thread-safe.
+*/
+class HTTPChunkedEncoder
+{
+public:
+    HTTPChunkedEncoder() = delete;
+    HTTPChunkedEncoder(const HTTPChunkedEncoder&) = delete;
+    HTTPChunkedEncoder(HTTPChunkedEncoder&&) = delete;
+    ~HTTPChunkedEncoder() = delete;
+
+    HTTPChunkedEncoder& operator=(const HTTPChunkedEncoder&) = delete;
+    HTTPChunkedEncoder& operator=(HTTPChunkedEncoder&&) = delete;
+
+    //! Get the chunk header for the given chunk size
+    static std::string ChunkHeader(size_t size);
+    //! Get the chunk trailer
+    static const char* ChunkTrailer() noexcept { return "\r\n"; }
+};
+
+} // namespace HTTP
+} // namespace CppServer
+
+#endif // CPPSERVER_HTTP_HTTP_CHUNKED_H
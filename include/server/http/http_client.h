@@ -15,7 +15,11 @@
 #include "server/asio/tcp_client.h"
 #include "server/asio/timer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
 #include <future>
+#include <mutex>
 
 namespace CppServer {
 namespace HTTP {
@@ -44,6 +48,22 @@ public:
     HTTPRequest& request() noexcept { return _request; }
     const HTTPRequest& request() const noexcept { return _request; }
 
+    //! Get the option: stream body
+    bool option_stream_body() const noexcept { return _option_stream_body; }
+
+    //! Setup option: stream body
+    /*!
+        This option will deliver HTTP response body parts with
+        onReceivedResponseBodyPart() notification instead of storing
+        the whole body in HTTP response cache. Memory usage is bounded
+        by the receive buffer size regardless of the body size. HTTP
+        response provided to onReceivedResponse() notification contains
+        the header and an empty body.
+
+        \param enable - Enable/disable option
+    */
+    void SetupStreamBody(bool enable) noexcept { _option_stream_body = enable; }
+
     //! Send the current HTTP request (synchronous)
     /*!
         \return Size of sent data
@@ -126,6 +146,40 @@ public:
     */
     bool SendRequestBodyAsync(const void* buffer, size_t size) { return SendAsync(buffer, size); }
 
+    //! Send the HTTP request body chunk (synchronous)
+    /*!
+        HTTP request should be started with HTTPRequest::SetBodyChunked().
+        An empty chunk finishes the HTTP request body.
+
+        \param chunk - HTTP request body chunk
+        \return Size of sent data
+    */
+    size_t SendRequestBodyChunk(std::string_view chunk) { return SendRequestBodyChunk(chunk.data(), chunk.size()); }
+    //! Send the HTTP request body chunk (synchronous)
+    /*!
+        \param buffer - HTTP request body chunk buffer
+        \param size - HTTP request body chunk size
+        \return Size of sent data
+    */
+    size_t SendRequestBodyChunk(const void* buffer, size_t size);
+
+    //! Send the HTTP request body chunk (asynchronous)
+    /*!
+        HTTP request should be started with HTTPRequest::SetBodyChunked().
+        An empty chunk finishes the HTTP request body.
+
+        \param chunk - HTTP request body chunk
+        \return 'true' if the HTTP request body chunk was successfully sent, 'false' if the client is not connected
+    */
+    bool SendRequestBodyChunkAsync(std::string_view chunk) { return SendRequestBodyChunkAsync(chunk.data(), chunk.size()); }
+    //! Send the HTTP request body chunk (asynchronous)
+    /*!
+        \param buffer - HTTP request body chunk buffer
+        \param size - HTTP request body chunk size
+        \return 'true' if the HTTP request body chunk was successfully sent, 'false' if the client is not connected
+    */
+    bool SendRequestBodyChunkAsync(const void* buffer, size_t size);
+
 protected:
     void onReceived(const void* buffer, size_t size) override;
     void onDisconnected() override;
@@ -139,6 +193,19 @@ protected:
     */
     virtual void onReceivedResponseHeader(const HTTPResponse& response) {}
 
+    //! Handle HTTP response body part received notification
+    /*!
+        Notification is called when the next part of HTTP response body
+        was received from the server in the stream body mode. Chunked
+        body is delivered decoded. The buffer is valid only during the
+        notification.
+
+        \param response - HTTP response
+        \param buffer - HTTP response body part buffer
+        \param size - HTTP response body part size
+    */
+    virtual void onReceivedResponseBodyPart(const HTTPResponse& response, const void* buffer, size_t size) {}
+
     //! Handle HTTP response received notification
     /*!
         Notification is called when HTTP response was received
@@ -151,18 +218,60 @@ protected:
     //! Handle HTTP response error notification
     /*!
         Notification is called when HTTP response error was received
-        from the server.
+        from the server or the connection was closed before the end
+        of HTTP response body.
 
         \param response - HTTP response
         \param error - HTTP response error
     */
     virtual void onReceivedResponseError(const HTTPResponse& response, const std::string& error) {}
 
+    //! Handle HTTP protocol upgrade response notification
+    /*!
+        Notification is called instead of onReceivedResponse() when HTTP
+        response switches the connection protocol (101 Switching Protocols)
+        in reply to the upgrade request. Accepted upgrade switches the
+        connection to the upgraded protocol, so the rest of received data
+        is notified with onReceivedUpgraded() until the client is
+        disconnected. Declined upgrade response is processed as the regular
+        one.
+
+        \param response - HTTP response
+        \return 'true' if the upgrade was accepted, 'false' if the upgrade was declined (default)
+    */
+    virtual bool onReceivedResponseUpgrade(const HTTPResponse& response) { return false; }
+
+    //! Handle upgraded protocol data received notification
+    /*!
+        Notification is called when data was received from the server
+        after the connection was switched to the upgraded protocol.
+
+        \param buffer - Received buffer
+        \param size - Received buffer size
+    */
+    virtual void onReceivedUpgraded(const void* buffer, size_t size) {}
+
+    //! Skip the body of the current HTTP response
+    /*!
+        Should be called from onReceivedResponseHeader() notification for
+        the response to HEAD request which has body headers without body.
+    */
+    void SkipResponseBody() { _response.SkipBody(); }
+
 protected:
     // HTTP request
     HTTPRequest _request;
     // HTTP response
     HTTPResponse _response;
+
+private:
+    // Connection is switched to the upgraded protocol
+    std::atomic<bool> _upgraded{false};
+    // Options
+    bool _option_stream_body{false};
+
+    // Stream parts of HTTP response body and return the count of consumed bytes
+    size_t ReceiveBodyParts(const void* buffer, size_t size);
 };
 
 
@@ -171,6 +280,14 @@ protected:
     HTTP extended client make requests to HTTP Web server with returning std::future
     as a synchronization primitive.
 
+    Requests could be made concurrently, each of them returns its own future.
+    Requests are sent over the same keep-alive connection and pipelined up to
+    the pipeline depth, the rest of requests wait in the queue. Responses are
+    matched to requests in order. If the connection is closed all sent requests
+    without responses fail and queued requests are sent over a new connection.
+    Timeout of the sent request closes the connection as the next responses
+    could not be matched any more.
+
     Thread-safe.
 */
 class HTTPClientEx : public HTTPClient
@@ -182,8 +299,26 @@ public:
     std::shared_ptr<Asio::TCPResolver>& resolver() noexcept { return _resolver; }
     const std::shared_ptr<Asio::TCPResolver>& resolver() const noexcept { return _resolver; }
 
+    //! Get the option: pipeline depth
+    size_t option_pipeline_depth() const noexcept { return _option_pipeline_depth; }
+
+    //! Setup option: pipeline depth
+    /*!
+        This option will setup the maximal count of requests sent to the
+        server before their responses are received. Default depth is 1,
+        so the next request is sent only after the previous response.
+        Pipelining should be used only with servers supporting keep-alive
+        connections.
+
+        \param depth - Pipeline depth
+    */
+    void SetupPipelineDepth(size_t depth) noexcept { _option_pipeline_depth = std::max(depth, (size_t)1); }
+
     //! Make HTTP request
     /*!
+        The connection is reused for the next request while it is kept
+        alive by the server.
+
         \param timeout - HTTP request timeout
         \return HTTP request future
     */
@@ -199,13 +334,35 @@ public:
 protected:
     void onConnected() override;
     void onDisconnected() override;
+    void onReceivedResponseHeader(const HTTPResponse& response) override;
     void onReceivedResponse(const HTTPResponse& response) override;
     void onReceivedResponseError(const HTTPResponse& response, const std::string& error) override;
 
 private:
+    // Pending HTTP request
+    struct Request
+    {
+        HTTPRequest request;
+        std::promise<HTTPResponse> promise;
+        std::shared_ptr<Asio::Timer> timer;
+    };
+
     std::shared_ptr<Asio::TCPResolver> _resolver;
-    std::shared_ptr<Asio::Timer> _timer;
-    std::promise<HTTPResponse> _promise;
+    std::mutex _lock;
+    bool _connecting{false};
+    // Requests waiting to be sent
+    std::deque<std::shared_ptr<Request>> _queue;
+    // Sent requests waiting for responses
+    std::deque<std::shared_ptr<Request>> _pipeline;
+    // Options
+    size_t _option_pipeline_depth{1};
+
+    // Send queued requests (requires the lock)
+    void SendRequests();
+    // Fail all sent and queued requests
+    void FailRequests(const std::string& error);
+    // Handle the request timeout
+    void onRequestTimeout(const std::shared_ptr<Request>& request);
 };
 
 /*! \example http_client.cpp HTTP client example */
@@ -9,7 +9,7 @@
 #ifndef CPPSERVER_HTTP_HTTP_REQUEST_H
 #define CPPSERVER_HTTP_HTTP_REQUEST_H
 
-#include "http.h"
+#include "http_chunked.h"
 
 #include <string>
 #include <string_view>
@@ -28,6 +28,9 @@ namespace HTTP {
 */
 class HTTPRequest
 {
+    friend class HTTPSession;
+    friend class HTTPSSession;
+
 public:
     //! Initialize an empty HTTP request
     HTTPRequest() { Clear(); }
@@ -45,6 +48,8 @@ public:
     HTTPRequest& operator=(const HTTPRequest&) = default;
     HTTPRequest& operator=(HTTPRequest&&) = default;
 
+    //! Get the HTTP request error flag
+    bool error() const noexcept { return _error; }
     //! Get the HTTP request method
     std::string_view method() const noexcept { return std::string_view(_cache.data() + _method_index, _method_size); }
     //! Get the HTTP request URL
@@ -59,6 +64,11 @@ public:
     std::string_view body() const noexcept { return std::string_view(_cache.data() + _body_index, _body_size); }
     //! Get the HTTP request body length
     size_t body_length() const noexcept { return _body_length; }
+    //! Is the HTTP request body sent with chunked transfer encoding?
+    bool chunked() const noexcept { return _chunked; }
+
+    //! Get the HTTP/2 stream identifier of the HTTP request (zero for HTTP/1.x)
+    uint32_t stream() const noexcept { return _stream; }
 
     //! Get the HTTP request cache content
     const std::string& cache() const noexcept { return _cache; }
@@ -89,8 +99,22 @@ public:
         \param length - Body length
     */
     void SetBodyLength(size_t length);
+    //! Set the HTTP request body with chunked transfer encoding
+    /*!
+        Body chunks should be sent after the HTTP request header.
+        An empty chunk finishes the HTTP request body.
+    */
+    void SetBodyChunked();
+
+    //! Set the HTTP/2 stream identifier of the HTTP request
+    /*!
+        \param stream - HTTP/2 stream identifier
+    */
+    void SetStream(uint32_t stream) noexcept { _stream = stream; }
 
 private:
+    // HTTP request error flag
+    bool _error;
     // HTTP request method
     size_t _method_index;
     size_t _method_size;
@@ -106,9 +130,59 @@ private:
     size_t _body_index;
     size_t _body_size;
     size_t _body_length;
+    // HTTP request chunked body
+    bool _chunked;
+    HTTPChunkedDecoder _chunked_decoder;
+    // HTTP/2 stream identifier
+    uint32_t _stream;
 
     // HTTP request cache
     std::string _cache;
+
+    // HTTP request parser state
+    enum class ParserState
+    {
+        METHOD,
+        URL,
+        PROTOCOL,
+        PROTOCOL_LF,
+        HEADER_START,
+        HEADER_NAME,
+        HEADER_VALUE_START,
+        HEADER_VALUE,
+        HEADER_VALUE_LF,
+        HEADER_END_LF,
+        BODY
+    };
+    ParserState _state;
+    // HTTP request parser positions of the current header
+    size_t _header_name_index;
+    size_t _header_name_size;
+    size_t _header_value_index;
+    size_t _header_value_end;
+    // HTTP request parser flags
+    bool _has_host;
+    bool _has_content_length;
+    bool _keep_alive;
+    bool _has_upgrade;
+    bool _connection_upgrade;
+
+    // Is pending parts of HTTP request
+    bool IsPendingHeader() const { return (!_error && (_state != ParserState::BODY)); }
+    bool IsPendingBody() const { return (!_error && (_state == ParserState::BODY) && (_chunked ? !_chunked_decoder.complete() : (_body_size < _body_length))); }
+    // Is HTTP request keep-alive
+    bool IsKeepAlive() const { return _keep_alive; }
+    // Is HTTP request asking to upgrade the connection protocol
+    bool IsUpgrade() const { return _has_upgrade && _connection_upgrade; }
+
+    // Receive parts of HTTP request and return the count of consumed bytes
+    // (only bytes of the current request are appended to the request cache,
+    // the rest of the buffer belongs to the next pipelined request)
+    size_t ReceiveHeader(const void* buffer, size_t size);
+    size_t ReceiveBody(const void* buffer, size_t size);
+
+    // Process the parsed HTTP request header
+    bool ProcessHeader();
 };
 
 } // namespace HTTP
@@ -9,7 +9,7 @@
 #ifndef CPPSERVER_HTTP_HTTP_RESPONSE_H
 #define CPPSERVER_HTTP_HTTP_RESPONSE_H
 
-#include "http.h"
+#include "http_chunked.h"
 
 #include <string>
 #include <string_view>
@@ -70,6 +70,11 @@ public:
     std::string_view body() const noexcept { return std::string_view(_cache.data() + _body_index, _body_size); }
     //! Get the HTTP response body length
     size_t body_length() const noexcept { return _body_length; }
+    //! Is the HTTP response body sent with chunked transfer encoding?
+    bool chunked() const noexcept { return _chunked; }
+
+    //! Get the HTTP/2 stream identifier of the HTTP response (zero for HTTP/1.x)
+    uint32_t stream() const noexcept { return _stream; }
 
     //! Get the HTTP response cache content
     const std::string& cache() const noexcept { return _cache; }
@@ -106,6 +111,18 @@ public:
         \param length - Body length
     */
     void SetBodyLength(size_t length);
+    //! Set the HTTP response body with chunked transfer encoding
+    /*!
+        Body chunks should be sent after the HTTP response header.
+        An empty chunk finishes the HTTP response body.
+    */
+    void SetBodyChunked();
+
+    //! Set the HTTP/2 stream identifier of the HTTP response
+    /*!
+        \param stream - HTTP/2 stream identifier
+    */
+    void SetStream(uint32_t stream) noexcept { _stream = stream; }
 
 private:
     // HTTP response error flag
@@ -124,6 +141,14 @@ private:
     size_t _body_index;
     size_t _body_size;
     size_t _body_length;
+    bool _body_length_provided;
+    // HTTP response streamed body size (not stored in the cache)
+    size_t _body_streamed;
+    // HTTP response chunked body
+    bool _chunked;
+    HTTPChunkedDecoder _chunked_decoder;
+    // HTTP/2 stream identifier
+    uint32_t _stream;
 
     // HTTP response cache
     std::string _cache;
@@ -132,10 +157,23 @@ private:
     // Is pending parts of HTTP response
     bool IsPendingHeader() const;
     bool IsPendingBody() const;
-
-    // Receive parts of HTTP response
-    bool ReceiveHeader(const void* buffer, size_t size);
-    bool ReceiveBody(const void* buffer, size_t size);
+    // Is HTTP response body complete?
+    bool IsBodyComplete() const;
+    // Is HTTP response body delimited by the connection close?
+    bool IsBodyUntilClose() const;
+
+    // Receive parts of HTTP response and return the count of consumed bytes
+    // (the rest of the buffer belongs to the next pipelined response)
+    size_t ReceiveHeader(const void* buffer, size_t size);
+    size_t ReceiveBody(const void* buffer, size_t size);
+    size_t ReceiveChunkedBody(const void* buffer, size_t size);
+
+    // Stream parts of HTTP response body without caching
+    // (the next body part is returned as a slice of the given buffer)
+    size_t ReceiveBodyPart(const void* buffer, size_t size, const char*& part, size_t& part_size);
+
+    // Skip the body of HTTP response (response to HEAD request)
+    void SkipBody();
 };
 
 } // namespace HTTP
@@ -0,0 +1,48 @@
+/*!
+    \file http_server.h
+    \brief HTTP server definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HTTP_SERVER_H
+#define CPPSERVER_HTTP_HTTP_SERVER_H
+
+#include "http_session.h"
+
+#include "server/asio/tcp_server.h"
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTP server
+/*!
+    HTTP server is used to accept HTTP clients and serve their requests
+    with HTTP sessions. Override CreateSession() to create custom HTTP
+    sessions with request handlers.
+
+    Thread-safe.
+*/
+class HTTPServer : public Asio::TCPServer
+{
+public:
+    using TCPServer::TCPServer;
+
+    HTTPServer(const HTTPServer&) = delete;
+    HTTPServer(HTTPServer&&) = delete;
+    virtual ~HTTPServer() = default;
+
+    HTTPServer& operator=(const HTTPServer&) = delete;
+    HTTPServer& operator=(HTTPServer&&) = delete;
+
+protected:
+    std::shared_ptr<Asio::TCPSession> CreateSession(std::shared_ptr<Asio::TCPServer> server) override { return std::make_shared<HTTPSession>(server); }
+};
+
+/*! \example http_server.cpp HTTP server example */
+
+} // namespace HTTP
+} // namespace CppServer
+
+#endif // CPPSERVER_HTTP_HTTP_SERVER_H
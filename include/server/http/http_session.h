@@ -0,0 +1,256 @@
+/*!
+    \file http_session.h
+    \brief HTTP session definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HTTP_SESSION_H
+#define CPPSERVER_HTTP_HTTP_SESSION_H
+
+#include "http_request.h"
+#include "http_response.h"
+
+#include "server/asio/tcp_session.h"
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTP session
+/*!
+    HTTP session is used to receive HTTP requests from the connected
+    HTTP client and send HTTP responses back.
+
+    Session supports persistent connections (HTTP/1.1 keep-alive and
+    HTTP/1.0 "Connection: keep-alive") and pipelined requests. Requests
+    are notified in the received order and responses should be sent in
+    the same order. If the request asks to close the connection the
+    session is disconnected after the response is sent.
+
+    Thread-safe.
+*/
+class HTTPSession : public Asio::TCPSession
+{
+public:
+    using TCPSession::TCPSession;
+
+    HTTPSession(const HTTPSession&) = delete;
+    HTTPSession(HTTPSession&&) = delete;
+    virtual ~HTTPSession() = default;
+
+    HTTPSession& operator=(const HTTPSession&) = delete;
+    HTTPSession& operator=(HTTPSession&&) = delete;
+
+    //! Get the HTTP response
+    HTTPResponse& response() noexcept { return _response; }
+    const HTTPResponse& response() const noexcept { return _response; }
+
+    //! Get the option: maximal HTTP request header size
+    size_t option_max_header_size() const noexcept { return _option_max_header_size; }
+    //! Get the option: maximal count of HTTP request headers
+    size_t option_max_headers() const noexcept { return _option_max_headers; }
+    //! Get the option: maximal HTTP request body size
+    size_t option_max_body_size() const noexcept { return _option_max_body_size; }
+
+    //! Setup option: maximal HTTP request header size
+    /*!
+        HTTP request with a larger header (request line and header fields)
+        is rejected with "431 Request Header Fields Too Large" response and
+        the session is disconnected.
+
+        \param size - Maximal header size in bytes or zero for no limit (default is 65536)
+    */
+    void SetupMaxHeaderSize(size_t size) noexcept { _option_max_header_size = size; }
+    //! Setup option: maximal count of HTTP request headers
+    /*!
+        HTTP request with more header fields is rejected with "431 Request
+        Header Fields Too Large" response and the session is disconnected.
+
+        \param count - Maximal count of header fields or zero for no limit (default is 128)
+    */
+    void SetupMaxHeaders(size_t count) noexcept { _option_max_headers = count; }
+    //! Setup option: maximal HTTP request body size
+    /*!
+        HTTP request with a larger body is rejected with "413 Payload Too
+        Large" response and the session is disconnected. Body length of the
+        request is checked as soon as its header is received, chunked body
+        is checked while it is decoded.
+
+        \param size - Maximal body size in bytes or zero for no limit (default is 0)
+    */
+    void SetupMaxBodySize(size_t size) noexcept { _option_max_body_size = size; }
+
+    //! Send the current HTTP response (synchronous)
+    /*!
+        \return Size of sent data
+    */
+    size_t SendResponse() { return SendResponse(_response); }
+    //! Send the HTTP response (synchronous)
+    /*!
+        HTTP response cache is written directly to the session socket.
+
+        \param response - HTTP response
+        \return Size of sent data
+    */
+    size_t SendResponse(const HTTPResponse& response);
+
+    //! Send the HTTP response body (synchronous)
+    /*!
+        \param body - HTTP response body
+        \return Size of sent data
+    */
+    size_t SendResponseBody(std::string_view body) { return Send(body); }
+    //! Send the HTTP response body (synchronous)
+    /*!
+        \param buffer - HTTP response body buffer
+        \param size - HTTP response body size
+        \return Size of sent data
+    */
+    size_t SendResponseBody(const void* buffer, size_t size) { return Send(buffer, size); }
+
+    //! Send the current HTTP response (asynchronous)
+    /*!
+        \return 'true' if the current HTTP response was successfully sent, 'false' if the session is not connected
+    */
+    bool SendResponseAsync() { return SendResponseAsync(_response); }
+    //! Send the HTTP response (asynchronous)
+    /*!
+        HTTP response cache is appended to the session send buffer as
+        is without intermediate serialization.
+
+        \param response - HTTP response
+        \return 'true' if the current HTTP response was successfully sent, 'false' if the session is not connected
+    */
+    bool SendResponseAsync(const HTTPResponse& response);
+
+    //! Send the HTTP response body (asynchronous)
+    /*!
+        \param body - HTTP response body
+        \return 'true' if the current HTTP response was successfully sent, 'false' if the session is not connected
+    */
+    bool SendResponseBodyAsync(std::string_view body) { return SendAsync(body); }
+    //! Send the HTTP response body (asynchronous)
+    /*!
+        \param buffer - HTTP response body buffer
+        \param size - HTTP response body size
+        \return 'true' if the current HTTP response was successfully sent, 'false' if the session is not connected
+    */
+    bool SendResponseBodyAsync(const void* buffer, size_t size) { return SendAsync(buffer, size); }
+
+    //! Send the HTTP response body chunk (synchronous)
+    /*!
+        HTTP response should be started with HTTPResponse::SetBodyChunked().
+        An empty chunk finishes the HTTP response body.
+
+        \param chunk - HTTP response body chunk
+        \return Size of sent data
+    */
+    size_t SendResponseBodyChunk(std::string_view chunk) { return SendResponseBodyChunk(chunk.data(), chunk.size()); }
+    //! Send the HTTP response body chunk (synchronous)
+    /*!
+        \param buffer - HTTP response body chunk buffer
+        \param size - HTTP response body chunk size
+        \return Size of sent data
+    */
+    size_t SendResponseBodyChunk(const void* buffer, size_t size);
+
+    //! Send the HTTP response body chunk (asynchronous)
+    /*!
+        HTTP response should be started with HTTPResponse::SetBodyChunked().
+        An empty chunk finishes the HTTP response body.
+
+        \param chunk - HTTP response body chunk
+        \return 'true' if the HTTP response body chunk was successfully sent, 'false' if the session is not connected
+    */
+    bool SendResponseBodyChunkAsync(std::string_view chunk) { return SendResponseBodyChunkAsync(chunk.data(), chunk.size()); }
+    //! Send the HTTP response body chunk (asynchronous)
+    /*!
+        \param buffer - HTTP response body chunk buffer
+        \param size - HTTP response body chunk size
+        \return 'true' if the HTTP response body chunk was successfully sent, 'false' if the session is not connected
+    */
+    bool SendResponseBodyChunkAsync(const void* buffer, size_t size);
+
+protected:
+    void onReceived(const void* buffer, size_t size) override;
+    void onSent(size_t sent, size_t pending) override;
+
+    //! Handle HTTP request header received notification
+    /*!
+        Notification is called when HTTP request header was received
+        from the client.
+
+        \param request - HTTP request
+    */
+    virtual void onReceivedRequestHeader(const HTTPRequest& request) {}
+
+    //! Handle HTTP request received notification
+    /*!
+        Notification is called when HTTP request was received
+        from the client.
+
+        \param request - HTTP request
+    */
+    virtual void onReceivedRequest(const HTTPRequest& request) {}
+
+    //! Handle HTTP request error notification
+    /*!
+        Notification is called when HTTP request error was received
+        from the client.
+
+        \param request - HTTP request
+        \param error - HTTP request error
+    */
+    virtual void onReceivedRequestError(const HTTPRequest& request, const std::string& error) {}
+
+    //! Handle HTTP protocol upgrade request notification
+    /*!
+        Notification is called instead of onReceivedRequest() when HTTP
+        request asks to upgrade the connection protocol ("Connection: Upgrade"
+        and "Upgrade" headers). Accepted upgrade switches the connection to
+        the upgraded protocol, so the rest of received data is notified with
+        onReceivedUpgraded(). Declined upgrade request is processed as the
+        regular one.
+
+        \param request - HTTP request
+        \return 'true' if the upgrade was accepted, 'false' if the upgrade was declined (default)
+    */
+    virtual bool onReceivedRequestUpgrade(const HTTPRequest& request) { return false; }
+
+    //! Handle upgraded protocol data received notification
+    /*!
+        Notification is called when data was received from the client
+        after the connection was switched to the upgraded protocol.
+
+        \param buffer - Received buffer
+        \param size - Received buffer size
+    */
+    virtual void onReceivedUpgraded(const void* buffer, size_t size) {}
+
+protected:
+    // HTTP request
+    HTTPRequest _request;
+    // HTTP response
+    HTTPResponse _response;
+
+private:
+    // Close the connection after the response to the current request
+    std::atomic<bool> _closing{false};
+    // Disconnect the session when all pending responses are sent
+    std::atomic<bool> _disconnect_pending{false};
+    // Connection is switched to the upgraded protocol
+    std::atomic<bool> _upgraded{false};
+    // HTTP request limits
+    size_t _option_max_header_size{65536};
+    size_t _option_max_headers{128};
+    size_t _option_max_body_size{0};
+
+    // Reject the invalid HTTP request with the error response and disconnect the session
+    void RejectRequest(int status, const std::string& error);
+};
+
+} // namespace HTTP
+} // namespace CppServer
+
+#endif // CPPSERVER_HTTP_HTTP_SESSION_H
@@ -0,0 +1,146 @@
+/*!
+    \file https_client_pool.h
+    \brief HTTPS client connection pool definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HTTPS_CLIENT_POOL_H
+#define CPPSERVER_HTTP_HTTPS_CLIENT_POOL_H
+
+#include "https_client.h"
+
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTPS client connection pool
+/*!
+    HTTPS client connection pool makes requests to HTTPS Web servers over
+    persistent keep-alive connections keyed by the server address and
+    port, so TLS handshake is paid only once per connection. Each request returns its own std::future, so requests could be
+    made concurrently from any thread.
+
+    Idle connections are reused for the next requests to the same server
+    (the most recently used one first) and closed after the idle timeout.
+    At most the given count of connections is opened to each server, the
+    rest of requests wait in the queue for the first free connection.
+    The request timeout covers the time spent in the queue as well.
+    Idempotent requests are retried once over a new connection if the
+    reused keep-alive connection was closed by the server before any
+    response was received.
+
+    HTTPS client connection pool should be created with std::make_shared().
+
+    Thread-safe.
+*/
+class HTTPSClientPool : public std::enable_shared_from_this<HTTPSClientPool>
+{
+public:
+    //! Initialize HTTPS client connection pool with a given Asio service and SSL context
+    /*!
+        \param service - Asio service
+        \param context - SSL context
+        \param max_connections_per_host - Maximal count of connections to the same host (default is 8)
+        \param idle_timeout - Idle connection timeout (default is 1 minute)
+    */
+    HTTPSClientPool(std::shared_ptr<Asio::Service> service, std::shared_ptr<Asio::SSLContext> context, size_t max_connections_per_host = 8, const CppCommon::Timespan& idle_timeout = CppCommon::Timespan::minutes(1));
+    HTTPSClientPool(const HTTPSClientPool&) = delete;
+    HTTPSClientPool(HTTPSClientPool&&) = delete;
+    virtual ~HTTPSClientPool();
+
+    HTTPSClientPool& operator=(const HTTPSClientPool&) = delete;
+    HTTPSClientPool& operator=(HTTPSClientPool&&) = delete;
+
+    //! Get the Asio service
+    std::shared_ptr<Asio::Service>& service() noexcept { return _service; }
+    //! Get the SSL context
+    std::shared_ptr<Asio::SSLContext>& context() noexcept { return _context; }
+    //! Get the TCP resolver
+    std::shared_ptr<Asio::TCPResolver>& resolver() noexcept { return _resolver; }
+
+    //! Get the maximal count of connections to the same host
+    size_t max_connections_per_host() const noexcept { return _max_connections_per_host; }
+    //! Get the idle connection timeout
+    const CppCommon::Timespan& idle_timeout() const noexcept { return _idle_timeout; }
+
+    //! Get the count of opened connections
+    size_t connections();
+    //! Get the count of idle connections
+    size_t idle_connections();
+
+    //! Make HTTP request
+    /*!
+        \param address - Server address
+        \param port - Server port number
+        \param request - HTTP request
+        \param timeout - HTTP request timeout (default is 1 minute)
+        \return HTTP request future
+    */
+    std::future<HTTPResponse> MakeRequest(const std::string& address, int port, const HTTPRequest& request, const CppCommon::Timespan& timeout = CppCommon::Timespan::minutes(1));
+
+    //! Disconnect all connections and fail all pending requests
+    void DisconnectAll();
+
+private:
+    class Connection;
+
+    // Pending HTTP request
+    struct Request
+    {
+        std::string address;
+        int port;
+        HTTPRequest request;
+        uint64_t deadline;
+        std::promise<HTTPResponse> promise;
+        bool retried{false};
+        // Timer of the request waiting in the queue
+        std::shared_ptr<Asio::Timer> timer;
+    };
+
+    // Connections and queued requests of the same host
+    struct Host
+    {
+        std::vector<std::shared_ptr<Connection>> connections;
+        std::vector<std::shared_ptr<Connection>> idle;
+        std::deque<std::shared_ptr<Request>> queue;
+    };
+
+    std::shared_ptr<Asio::Service> _service;
+    std::shared_ptr<Asio::SSLContext> _context;
+    std::shared_ptr<Asio::TCPResolver> _resolver;
+    size_t _max_connections_per_host;
+    CppCommon::Timespan _idle_timeout;
+    std::mutex _lock;
+    std::map<std::string, Host> _hosts;
+    uint64_t _timer_id;
+
+    // Dispatch the request to the idle or new connection or queue it
+    void Dispatch(std::shared_ptr<Request> request);
+    // Open new connections for queued requests of the host
+    void Pump(const std::string& key);
+    // Setup the connection request or idle timer (requires the lock)
+    void Arm(const std::shared_ptr<Connection>& connection, const CppCommon::Timespan& timeout);
+    // Queue the request and setup its timer (requires the lock)
+    void Enqueue(Host& host, const std::shared_ptr<Request>& request);
+    // Take the next queued request and cancel its timer (requires the lock)
+    std::shared_ptr<Request> Dequeue(Host& host);
+    // Remove the connection from the host (requires the lock)
+    void Remove(const std::shared_ptr<Connection>& connection);
+
+    // Connection notifications
+    void onConnectionResponse(const std::shared_ptr<Connection>& connection, const HTTPResponse& response);
+    void onConnectionError(const std::shared_ptr<Connection>& connection, const std::string& error);
+    void onConnectionDisconnected(const std::shared_ptr<Connection>& connection, bool received);
+    void onConnectionTimer(const std::shared_ptr<Connection>& connection, uint64_t timer_id);
+    void onRequestTimer(const std::shared_ptr<Request>& request);
+};
+
+} // namespace HTTP
+} // namespace CppServer
+
+#endif // CPPSERVER_HTTP_HTTPS_CLIENT_POOL_H
@@ -0,0 +1,46 @@
+/*!
+    \file https_server.h
+    \brief HTTPS server definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HTTPS_SERVER_H
+#define CPPSERVER_HTTP_HTTPS_SERVER_H
+
+#include "https_session.h"
+
+#include "server/asio/ssl_server.h"
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTPS server
+/*!
+    HTTPS server is used to accept HTTPS clients and serve their requests
+    with HTTPS sessions. Override CreateSession() to create custom HTTPS
+    sessions with request handlers.
+
+    Thread-safe.
+*/
+class HTTPSServer : public Asio::SSLServer
+{
+public:
+    using SSLServer::SSLServer;
+
+    HTTPSServer(const HTTPSServer&) = delete;
+    HTTPSServer(HTTPSServer&&) = delete;
+    virtual ~HTTPSServer() = default;
+
+    HTTPSServer& operator=(const HTTPSServer&) = delete;
+    HTTPSServer& operator=(HTTPSServer&&) = delete;
+
+protected:
+    std::shared_ptr<Asio::SSLSession> CreateSession(std::shared_ptr<Asio::SSLServer> server) override { return std::make_shared<HTTPSSession>(server); }
+};
+
+} // namespace HTTP
+} // namespace CppServer
+
+#endif // CPPSERVER_HTTP_HTTPS_SERVER_H
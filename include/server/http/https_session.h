@@ -0,0 +1,290 @@
+/*!
+    \file https_session.h
+    \brief HTTPS session definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_HTTP_HTTPS_SESSION_H
+#define CPPSERVER_HTTP_HTTPS_SESSION_H
+
+#include "http2_connection.h"
+#include "http_request.h"
+#include "http_response.h"
+
+#include "server/asio/ssl_session.h"
+
+#include <mutex>
+#include <thread>
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTPS session
+/*!
+    HTTPS session is used to receive HTTP requests from the connected
+    HTTPS client and send HTTP responses back using secure transport.
+
+    Session supports persistent connections (HTTP/1.1 keep-alive and
+    HTTP/1.0 "Connection: keep-alive") and pipelined requests. Requests
+    are notified in the received order and responses should be sent in
+    the same order. If the request asks to close the connection the
+    session is disconnected after the response is sent.
+
+    If HTTP/2 protocol is negotiated with the client using ALPN (see
+    Asio::SSLContext::set_alpn_protocols()) requests are received over
+    HTTP/2 streams and notified when they are completely received with
+    the stream identifier set. Response is sent to the stream of the
+    response. Response without the stream is sent to the stream of the
+    request only from its onReceivedRequest() notification, responses
+    sent outside of it should have the stream of their requests
+    (HTTPResponse::SetStream()) or they are not sent. Response body parts
+    are sent to the stream of the last response. HTTP request limits are
+    applied to HTTP/2 requests as well, the request over the limit is
+    answered with the error response and its stream is reset.
+
+    Thread-safe.
+*/
+class HTTPSSession : public Asio::SSLSession
+{
+public:
+    using SSLSession::SSLSession;
+
+    HTTPSSession(const HTTPSSession&) = delete;
+    HTTPSSession(HTTPSSession&&) = delete;
+    virtual ~HTTPSSession() = default;
+
+    HTTPSSession& operator=(const HTTPSSession&) = delete;
+    HTTPSSession& operator=(HTTPSSession&&) = delete;
+
+    //! Get the HTTP response
+    HTTPResponse& response() noexcept { return _response; }
+    const HTTPResponse& response() const noexcept { return _response; }
+
+    //! Get the option: maximal HTTP request header size
+    size_t option_max_header_size() const noexcept { return _option_max_header_size; }
+    //! Get the option: maximal count of HTTP request headers
+    size_t option_max_headers() const noexcept { return _option_max_headers; }
+    //! Get the option: maximal HTTP request body size
+    size_t option_max_body_size() const noexcept { return _option_max_body_size; }
+
+    //! Setup option: maximal HTTP request header size
+    /*!
+        HTTP request with a larger header (request line and header fields)
+        is rejected with "431 Request Header Fields Too Large" response and
+        the session is disconnected.
+
+        \param size - Maximal header size in bytes or zero for no limit (default is 65536)
+    */
+    void SetupMaxHeaderSize(size_t size) noexcept { _option_max_header_size = size; }
+    //! Setup option: maximal count of HTTP request headers
+    /*!
+        HTTP request with more header fields is rejected with "431 Request
+        Header Fields Too Large" response and the session is disconnected.
+
+        \param count - Maximal count of header fields or zero for no limit (default is 128)
+    */
+    void SetupMaxHeaders(size_t count) noexcept { _option_max_headers = count; }
+    //! Setup option: maximal HTTP request body size
+    /*!
+        HTTP request with a larger body is rejected with "413 Payload Too
+        Large" response and the session is disconnected. Body length of the
+        request is checked as soon as its header is received, chunked body
+        is checked while it is decoded.
+
+        \param size - Maximal body size in bytes or zero for no limit (default is 0)
+    */
+    void SetupMaxBodySize(size_t size) noexcept { _option_max_body_size = size; }
+
+    //! Is HTTP/2 protocol negotiated with the client?
+    bool IsHTTP2() const noexcept { return _http2_enabled; }
+
+    //! Send the current HTTP response (synchronous)
+    /*!
+        \return Size of sent data
+    */
+    size_t SendResponse() { return SendResponse(_response); }
+    //! Send the HTTP response (synchronous)
+    /*!
+        HTTP response cache is written directly to the session SSL stream.
+
+        \param response - HTTP response
+        \return Size of sent data
+    */
+    size_t SendResponse(const HTTPResponse& response);
+
+    //! Send the HTTP response body (synchronous)
+    /*!
+        \param body - HTTP response body
+        \return Size of sent data
+    */
+    size_t SendResponseBody(std::string_view body) { return SendResponseBody(body.data(), body.size()); }
+    //! Send the HTTP response body (synchronous)
+    /*!
+        \param buffer - HTTP response body buffer
+        \param size - HTTP response body size
+        \return Size of sent data
+    */
+    size_t SendResponseBody(const void* buffer, size_t size);
+
+    //! Send the current HTTP response (asynchronous)
+    /*!
+        \return 'true' if the current HTTP response was successfully sent, 'false' if the session is not connected
+    */
+    bool SendResponseAsync() { return SendResponseAsync(_response); }
+    //! Send the HTTP response (asynchronous)
+    /*!
+        HTTP response cache is appended to the session send buffer as
+        is without intermediate serialization.
+
+        \param response - HTTP response
+        \return 'true' if the current HTTP response was successfully sent, 'false' if the session is not connected
+    */
+    bool SendResponseAsync(const HTTPResponse& response);
+
+    //! Send the HTTP response body (asynchronous)
+    /*!
+        \param body - HTTP response body
+        \return 'true' if the current HTTP response was successfully sent, 'false' if the session is not connected
+    */
+    bool SendResponseBodyAsync(std::string_view body) { return SendResponseBodyAsync(body.data(), body.size()); }
+    //! Send the HTTP response body (asynchronous)
+    /*!
+        \param buffer - HTTP response body buffer
+        \param size - HTTP response body size
+        \return 'true' if the current HTTP response was successfully sent, 'false' if the session is not connected
+    */
+    bool SendResponseBodyAsync(const void* buffer, size_t size);
+
+    //! Send the HTTP response body chunk (synchronous)
+    /*!
+        HTTP response should be started with HTTPResponse::SetBodyChunked().
+        An empty chunk finishes the HTTP response body.
+
+        \param chunk - HTTP response body chunk
+        \return Size of sent data
+    */
+    size_t SendResponseBodyChunk(std::string_view chunk) { return SendResponseBodyChunk(chunk.data(), chunk.size()); }
+    //! Send the HTTP response body chunk (synchronous)
+    /*!
+        \param buffer - HTTP response body chunk buffer
+        \param size - HTTP response body chunk size
+        \return Size of sent data
+    */
+    size_t SendResponseBodyChunk(const void* buffer, size_t size);
+
+    //! Send the HTTP response body chunk (asynchronous)
+    /*!
+        HTTP response should be started with HTTPResponse::SetBodyChunked().
+        An empty chunk finishes the HTTP response body.
+
+        \param chunk - HTTP response body chunk
+        \return 'true' if the HTTP response body chunk was successfully sent, 'false' if the session is not connected
+    */
+    bool SendResponseBodyChunkAsync(std::string_view chunk) { return SendResponseBodyChunkAsync(chunk.data(), chunk.size()); }
+    //! Send the HTTP response body chunk (asynchronous)
+    /*!
+        \param buffer - HTTP response body chunk buffer
+        \param size - HTTP response body chunk size
+        \return 'true' if the HTTP response body chunk was successfully sent, 'false' if the session is not connected
+    */
+    bool SendResponseBodyChunkAsync(const void* buffer, size_t size);
+
+protected:
+    void onHandshaked() override;
+    void onReceived(const void* buffer, size_t size) override;
+    void onSent(size_t sent, size_t pending) override;
+
+    //! Handle HTTP request header received notification
+    /*!
+        Notification is called when HTTP request header was received
+        from the client.
+
+        \param request - HTTP request
+    */
+    virtual void onReceivedRequestHeader(const HTTPRequest& request) {}
+
+    //! Handle HTTP request received notification
+    /*!
+        Notification is called when HTTP request was received
+        from the client.
+
+        \param request - HTTP request
+    */
+    virtual void onReceivedRequest(const HTTPRequest& request) {}
+
+    //! Handle HTTP request error notification
+    /*!
+        Notification is called when HTTP request error was received
+        from the client.
+
+        \param request - HTTP request
+        \param error - HTTP request error
+    */
+    virtual void onReceivedRequestError(const HTTPRequest& request, const std::string& error) {}
+
+    //! Handle HTTP protocol upgrade request notification
+    /*!
+        Notification is called instead of onReceivedRequest() when HTTP
+        request asks to upgrade the connection protocol ("Connection: Upgrade"
+        and "Upgrade" headers). Accepted upgrade switches the connection to
+        the upgraded protocol, so the rest of received data is notified with
+        onReceivedUpgraded(). Declined upgrade request is processed as the
+        regular one.
+
+        \param request - HTTP request
+        \return 'true' if the upgrade was accepted, 'false' if the upgrade was declined (default)
+    */
+    virtual bool onReceivedRequestUpgrade(const HTTPRequest& request) { return false; }
+
+    //! Handle upgraded protocol data received notification
+    /*!
+        Notification is called when data was received from the client
+        after the connection was switched to the upgraded protocol.
+
+        \param buffer - Received buffer
+        \param size - Received buffer size
+    */
+    virtual void onReceivedUpgraded(const void* buffer, size_t size) {}
+
+protected:
+    // HTTP request
+    HTTPRequest _request;
+    // HTTP response
+    HTTPResponse _response;
+
+private:
+    // Close the connection after the response to the current request
+    std::atomic<bool> _closing{false};
+    // Disconnect the session when all pending responses are sent
+    std::atomic<bool> _disconnect_pending{false};
+    // Connection is switched to the upgraded protocol
+    std::atomic<bool> _upgraded{false};
+    // HTTP request limits
+    size_t _option_max_header_size{65536};
+    size_t _option_max_headers{128};
+    size_t _option_max_body_size{0};
+
+    // HTTP/2 connection negotiated with ALPN
+    class HTTP2;
+    std::mutex _http2_lock;
+    std::shared_ptr<HTTP2> _http2;
+    std::atomic<bool> _http2_enabled{false};
+    uint32_t _http2_stream{0};
+    std::thread::id _http2_thread;
+    uint32_t _http2_body_stream{0};
+
+    // Send the HTTP response over HTTP/2 stream
+    bool SendResponseStream(const HTTPResponse& response);
+    // Send the HTTP response body over the HTTP/2 stream of the last response
+    bool SendResponseStreamBody(const void* buffer, size_t size);
+
+    // Reject the invalid HTTP request with the error response and disconnect the session
+    void RejectRequest(int status, const std::string& error);
+};
+
+} // namespace HTTP
+} // namespace CppServer
+
+#endif // CPPSERVER_HTTP_HTTPS_SESSION_H
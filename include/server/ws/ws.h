@@ -0,0 +1,405 @@
+/*!
+    \file ws.h
+    \brief WebSocket C++ Library definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_WS_H
+#define CPPSERVER_WS_H
+
+#include "server/asio/message_compression.h"
+#include "server/http/http_request.h"
+#include "server/http/http_response.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace CppServer {
+
+/*!
+    \namespace CppServer::WS
+    \brief WebSocket definitions
+*/
+namespace WS {
+
+//! WebSocket protocol
+/*!
+    WebSocket protocol implements the WebSocket protocol (RFC 6455) over
+    any transport: opening handshake over HTTP upgrade, framing, masking,
+    fragmented messages, ping/pong and closing handshake. Received bytes
+    are fed with ReceiveFrames(), the bytes to send (pong and close
+    replies) are notified with onWSSend().
+
+    Frames are parsed in place of the received buffer. Only unmasked final
+    data frames (received by the client) are notified without copying,
+    masked frames (received by the server) are unmasked while they are
+    copied into the message buffer, fragmented messages are collected in
+    the message buffer.
+
+    Frames are prepared with PrepareFrame() into a single buffer, so each
+    frame is sent with a single send call and frames sent from different
+    threads are never interleaved. Server frames are not masked, so the
+    same prepared frame could be sent to any count of server sessions.
+
+    Messages could be compressed with permessage-deflate extension (RFC
+    7692) negotiated in the opening handshake. Context takeover of sent
+    messages is controlled with SetupWSDeflateContextTakeover(). Without
+    context takeover the server compresses each message independently,
+    so the same compressed frame prepared with PrepareDeflateFrame()
+    could be sent to all sessions which use the same compression.
+
+    Receiving is not thread-safe, sending is thread-safe.
+*/
+class WebSocket
+{
+public:
+    //! WebSocket frame opcode
+    enum class Opcode : uint8_t
+    {
+        Continuation = 0x0,     //!< Continuation frame of the fragmented message
+        Text = 0x1,             //!< Text message frame
+        Binary = 0x2,           //!< Binary message frame
+        Close = 0x8,            //!< Close control frame
+        Ping = 0x9,             //!< Ping control frame
+        Pong = 0xA              //!< Pong control frame
+    };
+
+    //! WebSocket close status codes (RFC 6455 section 7.4.1)
+    enum CloseStatus : int
+    {
+        CLOSE_NORMAL = 1000,            //!< Normal closure
+        CLOSE_GOING_AWAY = 1001,        //!< Endpoint is going away
+        CLOSE_PROTOCOL_ERROR = 1002,    //!< Protocol error
+        CLOSE_UNSUPPORTED_DATA = 1003,  //!< Unsupported data type
+        CLOSE_NO_STATUS = 1005,         //!< No status code was received (never sent)
+        CLOSE_INVALID_PAYLOAD = 1007,   //!< Invalid message payload (e.g. not UTF-8 text)
+        CLOSE_POLICY_VIOLATION = 1008,  //!< Policy violation
+        CLOSE_MESSAGE_TOO_BIG = 1009,   //!< Message is too big to process
+        CLOSE_INTERNAL_ERROR = 1011     //!< Unexpected internal error
+    };
+
+    //! Initialize WebSocket protocol
+    /*!
+        \param server - Server side of the connection flag
+    */
+    explicit WebSocket(bool server);
+    WebSocket(const WebSocket&) = delete;
+    WebSocket(WebSocket&&) = delete;
+    virtual ~WebSocket() = default;
+
+    WebSocket& operator=(const WebSocket&) = delete;
+    WebSocket& operator=(WebSocket&&) = delete;
+
+    //! Is the HTTP request asking to upgrade the connection to WebSocket protocol?
+    /*!
+        \param request - HTTP request
+        \return 'true' if the request asks for WebSocket protocol, 'false' if the request asks for another protocol
+    */
+    static bool IsUpgradeRequest(const HTTP::HTTPRequest& request);
+    //! Prepare WebSocket upgrade response to the upgrade request (server side)
+    /*!
+        Valid upgrade request is answered with "101 Switching Protocols"
+        response, invalid one with "400 Bad Request" or with "426 Upgrade
+        Required" for the unsupported WebSocket version. Accepted upgrade
+        response could be extended with additional headers and should be
+        finished with SetBody().
+
+        \param request - HTTP upgrade request
+        \param response - HTTP upgrade response
+        \return 'true' if the upgrade request is valid, 'false' if the upgrade request is invalid
+    */
+    static bool PrepareUpgradeResponse(const HTTP::HTTPRequest& request, HTTP::HTTPResponse& response);
+    //! Prepare WebSocket upgrade request (client side)
+    /*!
+        \param request - HTTP upgrade request
+        \param host - Server host
+        \param url - WebSocket URL
+        \return Generated WebSocket key to check the upgrade response
+    */
+    static std::string PrepareUpgradeRequest(HTTP::HTTPRequest& request, std::string_view host, std::string_view url);
+    //! Check WebSocket upgrade response (client side)
+    /*!
+        \param response - HTTP upgrade response
+        \param key - WebSocket key of the upgrade request
+        \return 'true' if the upgrade response accepts the WebSocket key, 'false' if the upgrade was rejected
+    */
+    static bool CheckUpgradeResponse(const HTTP::HTTPResponse& response, std::string_view key);
+
+    //! Prepare WebSocket frame and append it to the frame buffer
+    /*!
+        \param frame - Frame buffer
+        \param opcode - Frame opcode
+        \param fin - Final frame of the message flag
+        \param buffer - Payload buffer
+        \param size - Payload size
+        \param mask - Mask the payload with a random mask key (client frames)
+    */
+    static void PrepareFrame(std::string& frame, Opcode opcode, bool fin, const void* buffer, size_t size, bool mask);
+    //! Prepare WebSocket close frame and append it to the frame buffer
+    /*!
+        \param frame - Frame buffer
+        \param status - Close status
+        \param reason - Close reason (truncated to fit into the control frame)
+        \param mask - Mask the payload with a random mask key (client frames)
+    */
+    static void PrepareCloseFrame(std::string& frame, int status, std::string_view reason, bool mask);
+    //! Prepare compressed WebSocket message frame and append it to the frame buffer
+    /*!
+        Message is compressed with permessage-deflate without context
+        takeover and with the maximal window, so the frame is valid for
+        any connection where IsWSDeflateStateless() is true.
+
+        \param frame - Frame buffer
+        \param opcode - Message opcode (Text or Binary)
+        \param buffer - Message buffer
+        \param size - Message size
+        \param mask - Mask the payload with a random mask key (client frames)
+        \return 'true' if the message was successfully compressed, 'false' in case of the compression error
+    */
+    static bool PrepareDeflateFrame(std::string& frame, Opcode opcode, const void* buffer, size_t size, bool mask);
+
+    //! Mask or unmask the payload
+    /*!
+        Payload is processed with SIMD instructions where available.
+        Destination buffer could be the same as the source buffer.
+
+        \param destination - Destination buffer
+        \param source - Source buffer
+        \param size - Payload size
+        \param key - 4 bytes mask key
+        \param offset - Offset of the source buffer in the frame payload
+    */
+    static void Mask(void* destination, const void* source, size_t size, const uint8_t* key, size_t offset = 0) noexcept;
+
+    //! Is the server side of the connection?
+    bool IsWSServer() const noexcept { return _ws_server; }
+    //! Is the close frame sent?
+    bool IsWSCloseSent() const noexcept { return _ws_close_sent; }
+    //! Is the close frame received?
+    bool IsWSCloseReceived() const noexcept { return _ws_close_received; }
+    //! Is the WebSocket protocol error occurred?
+    bool IsWSError() const noexcept { return _ws_error; }
+    //! Is permessage-deflate extension negotiated?
+    bool IsWSDeflated() const noexcept { return _ws_deflated; }
+    //! Are sent messages compressed independently with the maximal window?
+    /*!
+        Frames prepared with PrepareDeflateFrame() could be sent to such
+        connection.
+    */
+    bool IsWSDeflateStateless() const noexcept { return _ws_deflated && !_ws_compressor.context_takeover() && (_ws_compressor.window_bits() == 15); }
+
+    //! Get the maximal message size
+    size_t ws_max_message_size() const noexcept { return _ws_max_message_size; }
+    //! Setup the maximal message size
+    /*!
+        Larger message closes the connection with CLOSE_MESSAGE_TOO_BIG
+        status. Zero value means no limit.
+
+        \param size - Maximal message size in bytes (default is 64 MiB)
+    */
+    void SetupWSMaxMessageSize(size_t size) noexcept { _ws_max_message_size = size; }
+
+    //! Is permessage-deflate extension enabled?
+    bool ws_deflate() const noexcept { return _ws_deflate; }
+    //! Is context takeover of sent messages enabled?
+    bool ws_deflate_context_takeover() const noexcept { return _ws_deflate_context_takeover; }
+    //! Get the minimal size of the compressed message
+    size_t ws_deflate_threshold() const noexcept { return _ws_deflate_threshold; }
+    //! Setup permessage-deflate extension
+    /*!
+        Enabled extension is offered by the client and accepted by the
+        server in the opening handshake (default is disabled). Extension
+        is never offered or accepted if the library is built without zlib.
+
+        \param enable - Enable permessage-deflate extension
+    */
+    void SetupWSDeflate(bool enable) noexcept { _ws_deflate = enable; }
+    //! Setup context takeover of sent messages
+    /*!
+        Without context takeover each sent message is compressed from the
+        empty window. Messages are compressed worse, but the server could
+        compress the multicast message once for all sessions (default is
+        enabled).
+
+        \param enable - Enable context takeover
+    */
+    void SetupWSDeflateContextTakeover(bool enable) noexcept { _ws_deflate_context_takeover = enable; }
+    //! Setup the minimal size of the compressed message
+    /*!
+        Smaller whole messages are sent without compression (default is 64).
+
+        \param size - Minimal message size in bytes
+    */
+    void SetupWSDeflateThreshold(size_t size) noexcept { _ws_deflate_threshold = size; }
+
+protected:
+    //! Receive data from the transport
+    /*!
+        \param buffer - Buffer to receive
+        \param size - Buffer size
+        \return 'true' if the data was successfully processed, 'false' in case of WebSocket protocol error
+    */
+    bool ReceiveFrames(const void* buffer, size_t size);
+
+    //! Negotiate permessage-deflate extension of the upgrade request (server side)
+    /*!
+        Acceptable extension offer of the upgrade request is accepted with
+        the extension header of the upgrade response.
+
+        \param request - HTTP upgrade request
+        \param response - HTTP upgrade response
+    */
+    void NegotiateDeflate(const HTTP::HTTPRequest& request, HTTP::HTTPResponse& response);
+    //! Offer permessage-deflate extension with the upgrade request (client side)
+    /*!
+        \param request - HTTP upgrade request
+    */
+    void OfferDeflate(HTTP::HTTPRequest& request);
+    //! Accept permessage-deflate extension of the upgrade response (client side)
+    /*!
+        \param response - HTTP upgrade response
+        \return 'true' if the extension was accepted or not negotiated, 'false' if the response has invalid extensions
+    */
+    bool AcceptDeflate(const HTTP::HTTPResponse& response);
+
+    //! Prepare WebSocket message frame and append it to the frame buffer
+    /*!
+        Message is compressed if permessage-deflate extension is negotiated.
+        Compressed messages should be sent in the order they are prepared,
+        so the caller should serialize preparing and sending of frames.
+
+        \param frame - Frame buffer
+        \param opcode - Frame opcode
+        \param fin - Final frame of the message flag
+        \param buffer - Payload buffer
+        \param size - Payload size
+        \return 'true' if the frame was successfully prepared, 'false' in case of the compression error
+    */
+    bool PrepareMessage(std::string& frame, Opcode opcode, bool fin, const void* buffer, size_t size);
+
+    //! Mark the close frame as sent
+    /*!
+        \return 'true' if the close frame should be sent, 'false' if the close frame was already sent
+    */
+    bool MarkWSCloseSent() noexcept { return !_ws_close_sent.exchange(true); }
+
+    //! Reset WebSocket protocol state for a new connection
+    void ResetWebSocket();
+
+protected:
+    //! Handle send data notification
+    /*!
+        Notification is called when the protocol has the frame to send
+        to the transport (pong and close replies).
+
+        \param buffer - Buffer to send
+        \param size - Buffer size
+    */
+    virtual void onWSSend(const void* buffer, size_t size) = 0;
+
+    //! Handle WebSocket message received notification
+    /*!
+        Notification is called when the whole message was received.
+        Message buffer is valid only during the notification call.
+
+        \param buffer - Received message buffer
+        \param size - Received message size
+        \param text - Text message (UTF-8) flag
+    */
+    virtual void onWSReceived(const void* buffer, size_t size, bool text) {}
+    //! Handle WebSocket ping received notification
+    /*!
+        Pong reply is sent before the notification.
+
+        \param buffer - Ping payload buffer
+        \param size - Ping payload size
+    */
+    virtual void onWSPing(const void* buffer, size_t size) {}
+    //! Handle WebSocket pong received notification
+    /*!
+        \param buffer - Pong payload buffer
+        \param size - Pong payload size
+    */
+    virtual void onWSPong(const void* buffer, size_t size) {}
+    //! Handle WebSocket close received notification
+    /*!
+        Close reply is sent before the notification if the close frame
+        was not sent yet.
+
+        \param status - Close status (CLOSE_NO_STATUS if the status was not received)
+        \param reason - Close reason
+    */
+    virtual void onWSClose(int status, std::string_view reason) {}
+    //! Handle WebSocket error notification
+    /*!
+        Notification is called when the peer violated the protocol. Close
+        frame with the error status is sent after the notification.
+
+        \param status - Close status
+        \param error - WebSocket error
+    */
+    virtual void onWSError(int status, const std::string& error) {}
+
+private:
+    bool _ws_server;
+    size_t _ws_max_message_size;
+    bool _ws_deflate;
+    bool _ws_deflate_context_takeover;
+    size_t _ws_deflate_threshold;
+
+    // Negotiated permessage-deflate extension
+    bool _ws_deflated;
+    Asio::MessageCompression _ws_compressor;
+    Asio::MessageCompression _ws_decompressor;
+    // Sent message is compressed
+    bool _ws_send_compressed;
+
+    // Closing handshake state
+    std::atomic<bool> _ws_close_sent;
+    bool _ws_close_received;
+    bool _ws_error;
+
+    // Incomplete frame header
+    uint8_t _ws_header[14];
+    size_t _ws_header_size;
+
+    // Current frame
+    bool _ws_payload;
+    Opcode _ws_opcode;
+    bool _ws_fin;
+    bool _ws_masked;
+    uint8_t _ws_mask[4];
+    uint64_t _ws_remaining;
+    size_t _ws_offset;
+
+    // Fragmented message
+    Opcode _ws_message_opcode;
+    bool _ws_message_compressed;
+    std::string _ws_message;
+    // Decompressed message
+    std::string _ws_inflated;
+    // Control frame payload
+    std::string _ws_control;
+
+    // Process the received frame header
+    bool ProcessHeader(const uint8_t* header);
+    // Process the received frame payload part
+    void ProcessPayload(const uint8_t* data, size_t size);
+    // Process the completely received frame
+    bool ProcessFrame();
+    // Process the received close frame
+    bool ProcessClose(const uint8_t* payload, size_t size);
+    // Notify the received message if it is valid
+    bool Complete(const void* buffer, size_t size, bool text);
+    // Fail the connection with the given close status
+    bool Fail(int status, const std::string& error);
+};
+
+} // namespace WS
+} // namespace CppServer
+
+#endif // CPPSERVER_WS_H
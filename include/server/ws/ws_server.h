@@ -0,0 +1,88 @@
+/*!
+    \file ws_server.h
+    \brief WebSocket server definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_WS_WS_SERVER_H
+#define CPPSERVER_WS_WS_SERVER_H
+
+#include "ws_session.h"
+
+#include "server/http/http_server.h"
+
+namespace CppServer {
+namespace WS {
+
+//! WebSocket server
+/*!
+    WebSocket server is used to accept WebSocket clients and serve them
+    with WebSocket sessions. Override CreateSession() to create custom
+    WebSocket sessions with message handlers.
+
+    Multicast messages are not interleaved with fragments of the message
+    which is being sent by the session, they are sent after its final
+    fragment.
+
+    Thread-safe.
+*/
+class WSServer : public HTTP::HTTPServer
+{
+public:
+    using HTTPServer::HTTPServer;
+
+    WSServer(const WSServer&) = delete;
+    WSServer(WSServer&&) = delete;
+    virtual ~WSServer() = default;
+
+    WSServer& operator=(const WSServer&) = delete;
+    WSServer& operator=(WSServer&&) = delete;
+
+    //! Multicast the text message to all WebSocket sessions
+    /*!
+        Message is framed once and the same frame is sent to all sessions
+        upgraded to WebSocket protocol. Message is compressed once for all
+        sessions which negotiated permessage-deflate extension without
+        context takeover, sessions with context takeover compress the
+        message with their own compression window.
+
+        \param text - Text message (UTF-8) to multicast
+        \return 'true' if the text message was successfully multicast, 'false' if the server is not started
+    */
+    bool MulticastText(std::string_view text) { return MulticastFrame(WebSocket::Opcode::Text, text.data(), text.size()); }
+    //! Multicast the binary message to all WebSocket sessions
+    /*!
+        Message is framed once and the same frame is sent to all sessions
+        upgraded to WebSocket protocol. Message is compressed once for all
+        sessions which negotiated permessage-deflate extension without
+        context takeover, sessions with context takeover compress the
+        message with their own compression window.
+
+        \param buffer - Message buffer to multicast
+        \param size - Message size
+        \return 'true' if the binary message was successfully multicast, 'false' if the server is not started
+    */
+    bool MulticastBinary(const void* buffer, size_t size) { return MulticastFrame(WebSocket::Opcode::Binary, buffer, size); }
+    //! Multicast the ping frame to all WebSocket sessions
+    /*!
+        \param payload - Ping payload (up to 125 bytes)
+        \return 'true' if the ping frame was successfully multicast, 'false' if the server is not started
+    */
+    bool MulticastPing(std::string_view payload = "") { return MulticastFrame(WebSocket::Opcode::Ping, payload.data(), std::min(payload.size(), (size_t)125)); }
+
+protected:
+    std::shared_ptr<Asio::TCPSession> CreateSession(std::shared_ptr<Asio::TCPServer> server) override { return std::make_shared<WSSession>(server); }
+
+private:
+    // Multicast WebSocket frame
+    bool MulticastFrame(WebSocket::Opcode opcode, const void* buffer, size_t size);
+};
+
+/*! \example ws_chat_server.cpp WebSocket chat server example */
+
+} // namespace WS
+} // namespace CppServer
+
+#endif // CPPSERVER_WS_WS_SERVER_H
@@ -0,0 +1,221 @@
+/*!
+    \file ws_session.h
+    \brief WebSocket session definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_WS_WS_SESSION_H
+#define CPPSERVER_WS_WS_SESSION_H
+
+#include "ws.h"
+
+#include "server/asio/timer.h"
+#include "server/http/http_session.h"
+
+#include "time/timespan.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace CppServer {
+namespace WS {
+
+//! WebSocket session
+/*!
+    WebSocket session is used to upgrade HTTP connection of the client
+    to WebSocket protocol, receive WebSocket messages and send WebSocket
+    messages back. HTTP requests without WebSocket upgrade are processed
+    as regular HTTP requests.
+
+    Received close frame is answered with the close frame and the session
+    is disconnected when the answer is sent. If the ping interval is set
+    the session pings the client periodically and disconnects the client
+    which was silent during the whole ping interval or did not answer the
+    close frame.
+
+    If permessage-deflate extension is enabled with SetupWSDeflate() the
+    session accepts the extension offered by the client and compresses
+    messages which are not smaller than the compression threshold.
+
+    Derived class which overrides onDisconnected() or onSent() handlers
+    should call the base handlers.
+
+    Thread-safe.
+*/
+class WSSession : public HTTP::HTTPSession, protected WebSocket
+{
+    friend class WSServer;
+
+public:
+    //! Initialize the session with a given server
+    /*!
+        \param server - Connected server
+    */
+    explicit WSSession(std::shared_ptr<Asio::TCPServer> server) : HTTP::HTTPSession(server), WebSocket(true) {}
+    WSSession(const WSSession&) = delete;
+    WSSession(WSSession&&) = delete;
+    virtual ~WSSession() = default;
+
+    WSSession& operator=(const WSSession&) = delete;
+    WSSession& operator=(WSSession&&) = delete;
+
+    using WebSocket::Opcode;
+    using WebSocket::IsWSCloseSent;
+    using WebSocket::IsWSCloseReceived;
+    using WebSocket::ws_max_message_size;
+    using WebSocket::SetupWSMaxMessageSize;
+    using WebSocket::IsWSDeflated;
+    using WebSocket::IsWSDeflateStateless;
+    using WebSocket::ws_deflate;
+    using WebSocket::ws_deflate_context_takeover;
+    using WebSocket::ws_deflate_threshold;
+    using WebSocket::SetupWSDeflate;
+    using WebSocket::SetupWSDeflateContextTakeover;
+    using WebSocket::SetupWSDeflateThreshold;
+
+    //! Is the session upgraded to WebSocket protocol?
+    bool IsWSConnected() const noexcept { return _ws_connected; }
+
+    //! Get the option: ping interval
+    const CppCommon::Timespan& option_ping_interval() const noexcept { return _option_ping_interval; }
+
+    //! Send the text message (synchronous)
+    /*!
+        \param text - Text message (UTF-8) to send
+        \return Size of sent data including the framing
+    */
+    size_t SendText(std::string_view text) { return SendFrame(Opcode::Text, true, text.data(), text.size()); }
+    //! Send the binary message (synchronous)
+    /*!
+        \param buffer - Message buffer to send
+        \param size - Message size
+        \return Size of sent data including the framing
+    */
+    size_t SendBinary(const void* buffer, size_t size) { return SendFrame(Opcode::Binary, true, buffer, size); }
+
+    //! Send the text message (asynchronous)
+    /*!
+        \param text - Text message (UTF-8) to send
+        \return 'true' if the text message was successfully sent, 'false' if the session is not upgraded or closed
+    */
+    bool SendTextAsync(std::string_view text) { return SendFrameAsync(Opcode::Text, true, text.data(), text.size()); }
+    //! Send the binary message (asynchronous)
+    /*!
+        \param buffer - Message buffer to send
+        \param size - Message size
+        \return 'true' if the binary message was successfully sent, 'false' if the session is not upgraded or closed
+    */
+    bool SendBinaryAsync(const void* buffer, size_t size) { return SendFrameAsync(Opcode::Binary, true, buffer, size); }
+    //! Send the message fragment (asynchronous)
+    /*!
+        The first fragment is sent with Text or Binary opcode, the next
+        fragments are sent with Continuation opcode. The last fragment
+        is sent with the final flag. Fragments of one message should not
+        be interleaved with other messages.
+
+        \param opcode - Fragment opcode
+        \param fin - Final fragment of the message flag
+        \param buffer - Fragment buffer to send
+        \param size - Fragment size
+        \return 'true' if the message fragment was successfully sent, 'false' if the session is not upgraded or closed
+    */
+    bool SendFragmentAsync(Opcode opcode, bool fin, const void* buffer, size_t size) { return SendFrameAsync(opcode, fin, buffer, size); }
+    //! Send the ping frame (asynchronous)
+    /*!
+        \param payload - Ping payload (up to 125 bytes)
+        \return 'true' if the ping frame was successfully sent, 'false' if the session is not upgraded or closed
+    */
+    bool SendPingAsync(std::string_view payload = "") { return SendFrameAsync(Opcode::Ping, true, payload.data(), std::min(payload.size(), (size_t)125)); }
+
+    //! Close WebSocket connection (asynchronous)
+    /*!
+        Close frame is sent to the client and the session is disconnected
+        when the close frame of the client is received.
+
+        \param status - Close status (default is CLOSE_NORMAL)
+        \param reason - Close reason (default is "")
+        \return 'true' if the close frame was successfully sent, 'false' if the session is not upgraded or already closed
+    */
+    bool CloseAsync(int status = CLOSE_NORMAL, std::string_view reason = "");
+
+    //! Setup option: ping interval
+    /*!
+        Zero interval disables pings (default).
+
+        \param interval - Ping interval
+    */
+    void SetupPingInterval(const CppCommon::Timespan& interval) noexcept { _option_ping_interval = interval; }
+
+protected:
+    void onDisconnected() override;
+    void onSent(size_t sent, size_t pending) override;
+    bool onReceivedRequestUpgrade(const HTTP::HTTPRequest& request) override;
+    void onReceivedUpgraded(const void* buffer, size_t size) override;
+    void onWSSend(const void* buffer, size_t size) override { SendAsync(buffer, size); }
+
+    //! Handle WebSocket upgrade request notification
+    /*!
+        Notification is called when the valid WebSocket upgrade request was
+        received from the client. Upgrade response could be extended with
+        additional headers (e.g. "Sec-WebSocket-Protocol"). Rejected upgrade
+        is answered with "403 Forbidden" response and the session is
+        disconnected.
+
+        \param request - HTTP upgrade request
+        \param response - HTTP upgrade response
+        \return 'true' if the upgrade is accepted (default), 'false' if the upgrade is rejected
+    */
+    virtual bool onWSConnecting(const HTTP::HTTPRequest& request, HTTP::HTTPResponse& response) { return true; }
+    //! Handle WebSocket connected notification
+    /*!
+        \param request - HTTP upgrade request
+    */
+    virtual void onWSConnected(const HTTP::HTTPRequest& request) {}
+    //! Handle WebSocket disconnected notification
+    virtual void onWSDisconnected() {}
+
+private:
+    // WebSocket connection state
+    std::atomic<bool> _ws_connected{false};
+    std::atomic<bool> _ws_received{false};
+    std::atomic<bool> _ws_closing{false};
+    std::atomic<bool> _ws_disconnect_pending{false};
+    // Compressed messages should be sent in the order of compression
+    std::mutex _ws_send_lock;
+    // Multicast messages are deferred until the end of the fragmented message
+    struct DeferredMessage
+    {
+        Opcode opcode;
+        bool prepared;
+        std::string data;
+    };
+    bool _ws_fragmenting{false};
+    std::vector<DeferredMessage> _ws_deferred;
+    // Heartbeat timer
+    std::shared_ptr<Asio::Timer> _ws_heartbeat;
+    // Options
+    CppCommon::Timespan _option_ping_interval;
+
+    // Send WebSocket frame
+    size_t SendFrame(Opcode opcode, bool fin, const void* buffer, size_t size);
+    bool SendFrameAsync(Opcode opcode, bool fin, const void* buffer, size_t size);
+    // Send the multicast message or the prepared multicast frame in the order of other sent frames
+    bool SendMulticastAsync(Opcode opcode, const void* buffer, size_t size);
+    bool SendPreparedFrameAsync(Opcode opcode, const void* buffer, size_t size);
+    // Track the fragmented message and send the deferred multicast messages after its final fragment
+    void TrackFragments(Opcode opcode, bool fin);
+    // Disconnect the session when all pending data is sent
+    void DisconnectWhenSent();
+    // Start heartbeat and ping the client on each heartbeat
+    void StartHeartbeat();
+    void Heartbeat();
+};
+
+} // namespace WS
+} // namespace CppServer
+
+#endif // CPPSERVER_WS_WS_SESSION_H
@@ -0,0 +1,232 @@
+/*!
+    \file wss_client.h
+    \brief WebSocket secure client definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_WS_WSS_CLIENT_H
+#define CPPSERVER_WS_WSS_CLIENT_H
+
+#include "ws.h"
+
+#include "server/asio/timer.h"
+#include "server/http/https_client.h"
+
+#include "time/timespan.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace CppServer {
+namespace WS {
+
+//! WebSocket secure client
+/*!
+    WebSocket secure client is used to communicate with WebSocket secure
+    server. The client sends WebSocket upgrade request when it is
+    handshaked and switches to WebSocket protocol when the server accepts
+    the upgrade. Sent frames are masked with a random mask key of each
+    frame. WebSocket over HTTP/2 is not supported, so SSL context of the
+    client should not negotiate "h2" protocol with ALPN.
+
+    Received close frame is answered with the close frame and the client
+    is disconnected when the answer is sent. If the ping interval is set
+    the client pings the server periodically and disconnects from the
+    server which was silent during the whole ping interval or did not
+    answer the close frame.
+
+    If permessage-deflate extension is enabled with SetupWSDeflate() the
+    client offers the extension to the server and compresses messages
+    which are not smaller than the compression threshold when the server
+    accepts it.
+
+    Derived class which overrides onHandshaked(), onDisconnected() or
+    onSent() handlers should call the base handlers.
+
+    Thread-safe.
+*/
+class WSSClient : public HTTP::HTTPSClient, protected WebSocket
+{
+public:
+    //! Initialize WebSocket secure client with a given Asio service, server address and port number
+    /*!
+        \param service - Asio service
+        \param context - SSL context
+        \param address - Server address
+        \param port - Server port number
+    */
+    WSSClient(std::shared_ptr<Asio::Service> service, std::shared_ptr<Asio::SSLContext> context, const std::string& address, int port) : HTTP::HTTPSClient(service, context, address, port), WebSocket(false) {}
+    //! Initialize WebSocket secure client with a given Asio service, server address and scheme name
+    /*!
+        \param service - Asio service
+        \param context - SSL context
+        \param address - Server address
+        \param scheme - Scheme name
+    */
+    WSSClient(std::shared_ptr<Asio::Service> service, std::shared_ptr<Asio::SSLContext> context, const std::string& address, const std::string& scheme) : HTTP::HTTPSClient(service, context, address, scheme), WebSocket(false) {}
+    //! Initialize WebSocket secure client with a given Asio service and endpoint
+    /*!
+        \param service - Asio service
+        \param context - SSL context
+        \param endpoint - Server SSL endpoint
+    */
+    WSSClient(std::shared_ptr<Asio::Service> service, std::shared_ptr<Asio::SSLContext> context, const asio::ip::tcp::endpoint& endpoint) : HTTP::HTTPSClient(service, context, endpoint), WebSocket(false) {}
+    WSSClient(const WSSClient&) = delete;
+    WSSClient(WSSClient&&) = delete;
+    virtual ~WSSClient() = default;
+
+    WSSClient& operator=(const WSSClient&) = delete;
+    WSSClient& operator=(WSSClient&&) = delete;
+
+    using WebSocket::Opcode;
+    using WebSocket::IsWSCloseSent;
+    using WebSocket::IsWSCloseReceived;
+    using WebSocket::ws_max_message_size;
+    using WebSocket::SetupWSMaxMessageSize;
+    using WebSocket::IsWSDeflated;
+    using WebSocket::IsWSDeflateStateless;
+    using WebSocket::ws_deflate;
+    using WebSocket::ws_deflate_context_takeover;
+    using WebSocket::ws_deflate_threshold;
+    using WebSocket::SetupWSDeflate;
+    using WebSocket::SetupWSDeflateContextTakeover;
+    using WebSocket::SetupWSDeflateThreshold;
+
+    //! Is the client upgraded to WebSocket protocol?
+    bool IsWSConnected() const noexcept { return _ws_connected; }
+
+    //! Get the option: WebSocket URL
+    const std::string& option_ws_url() const noexcept { return _option_ws_url; }
+    //! Get the option: ping interval
+    const CppCommon::Timespan& option_ping_interval() const noexcept { return _option_ping_interval; }
+
+    //! Send the text message (synchronous)
+    /*!
+        \param text - Text message (UTF-8) to send
+        \return Size of sent data including the framing
+    */
+    size_t SendText(std::string_view text) { return SendFrame(Opcode::Text, true, text.data(), text.size()); }
+    //! Send the binary message (synchronous)
+    /*!
+        \param buffer - Message buffer to send
+        \param size - Message size
+        \return Size of sent data including the framing
+    */
+    size_t SendBinary(const void* buffer, size_t size) { return SendFrame(Opcode::Binary, true, buffer, size); }
+
+    //! Send the text message (asynchronous)
+    /*!
+        \param text - Text message (UTF-8) to send
+        \return 'true' if the text message was successfully sent, 'false' if the client is not upgraded or closed
+    */
+    bool SendTextAsync(std::string_view text) { return SendFrameAsync(Opcode::Text, true, text.data(), text.size()); }
+    //! Send the binary message (asynchronous)
+    /*!
+        \param buffer - Message buffer to send
+        \param size - Message size
+        \return 'true' if the binary message was successfully sent, 'false' if the client is not upgraded or closed
+    */
+    bool SendBinaryAsync(const void* buffer, size_t size) { return SendFrameAsync(Opcode::Binary, true, buffer, size); }
+    //! Send the message fragment (asynchronous)
+    /*!
+        The first fragment is sent with Text or Binary opcode, the next
+        fragments are sent with Continuation opcode. The last fragment
+        is sent with the final flag. Fragments of one message should not
+        be interleaved with other messages.
+
+        \param opcode - Fragment opcode
+        \param fin - Final fragment of the message flag
+        \param buffer - Fragment buffer to send
+        \param size - Fragment size
+        \return 'true' if the message fragment was successfully sent, 'false' if the client is not upgraded or closed
+    */
+    bool SendFragmentAsync(Opcode opcode, bool fin, const void* buffer, size_t size) { return SendFrameAsync(opcode, fin, buffer, size); }
+    //! Send the ping frame (asynchronous)
+    /*!
+        \param payload - Ping payload (up to 125 bytes)
+        \return 'true' if the ping frame was successfully sent, 'false' if the client is not upgraded or closed
+    */
+    bool SendPingAsync(std::string_view payload = "") { return SendFrameAsync(Opcode::Ping, true, payload.data(), std::min(payload.size(), (size_t)125)); }
+
+    //! Close WebSocket connection (asynchronous)
+    /*!
+        Close frame is sent to the server and the client is disconnected
+        when the close frame of the server is received.
+
+        \param status - Close status (default is CLOSE_NORMAL)
+        \param reason - Close reason (default is "")
+        \return 'true' if the close frame was successfully sent, 'false' if the client is not upgraded or already closed
+    */
+    bool CloseAsync(int status = CLOSE_NORMAL, std::string_view reason = "");
+
+    //! Setup option: WebSocket URL
+    /*!
+        \param url - WebSocket URL of the upgrade request (default is "/")
+    */
+    void SetupWSUrl(std::string_view url) { _option_ws_url = url; }
+    //! Setup option: ping interval
+    /*!
+        Zero interval disables pings (default).
+
+        \param interval - Ping interval
+    */
+    void SetupPingInterval(const CppCommon::Timespan& interval) noexcept { _option_ping_interval = interval; }
+
+protected:
+    void onHandshaked() override;
+    void onDisconnected() override;
+    void onSent(size_t sent, size_t pending) override;
+    void onReceivedResponse(const HTTP::HTTPResponse& response) override;
+    bool onReceivedResponseUpgrade(const HTTP::HTTPResponse& response) override;
+    void onReceivedUpgraded(const void* buffer, size_t size) override;
+    void onWSSend(const void* buffer, size_t size) override { SendAsync(buffer, size); }
+
+    //! Handle WebSocket upgrade request notification
+    /*!
+        Notification is called before the upgrade request is sent to the
+        server. Upgrade request could be extended with additional headers
+        (e.g. "Origin" or "Sec-WebSocket-Protocol").
+
+        \param request - HTTP upgrade request
+    */
+    virtual void onWSConnecting(HTTP::HTTPRequest& request) {}
+    //! Handle WebSocket connected notification
+    /*!
+        \param response - HTTP upgrade response
+    */
+    virtual void onWSConnected(const HTTP::HTTPResponse& response) {}
+    //! Handle WebSocket disconnected notification
+    virtual void onWSDisconnected() {}
+
+private:
+    // WebSocket key of the upgrade request
+    std::string _ws_key;
+    // WebSocket connection state
+    std::atomic<bool> _ws_connected{false};
+    std::atomic<bool> _ws_received{false};
+    std::atomic<bool> _ws_closing{false};
+    std::atomic<bool> _ws_disconnect_pending{false};
+    // Compressed messages should be sent in the order of compression
+    std::mutex _ws_send_lock;
+    // Heartbeat timer
+    std::shared_ptr<Asio::Timer> _ws_heartbeat;
+    // Options
+    std::string _option_ws_url{"/"};
+    CppCommon::Timespan _option_ping_interval;
+
+    // Send WebSocket frame
+    size_t SendFrame(Opcode opcode, bool fin, const void* buffer, size_t size);
+    bool SendFrameAsync(Opcode opcode, bool fin, const void* buffer, size_t size);
+    // Disconnect the client when all pending data is sent
+    void DisconnectWhenSent();
+    // Start heartbeat and ping the server on each heartbeat
+    void StartHeartbeat();
+    void Heartbeat();
+};
+
+} // namespace WS
+} // namespace CppServer
+
+#endif // CPPSERVER_WS_WSS_CLIENT_H
@@ -0,0 +1,86 @@
+/*!
+    \file wss_server.h
+    \brief WebSocket secure server definition
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPSERVER_WS_WSS_SERVER_H
+#define CPPSERVER_WS_WSS_SERVER_H
+
+#include "wss_session.h"
+
+#include "server/http/https_server.h"
+
+namespace CppServer {
+namespace WS {
+
+//! WebSocket secure server
+/*!
+    WebSocket secure server is used to accept WebSocket secure clients
+    and serve them with WebSocket secure sessions. Override CreateSession()
+    to create custom WebSocket secure sessions with message handlers.
+
+    Multicast messages are not interleaved with fragments of the message
+    which is being sent by the session, they are sent after its final
+    fragment.
+
+    Thread-safe.
+*/
+class WSSServer : public HTTP::HTTPSServer
+{
+public:
+    using HTTPSServer::HTTPSServer;
+
+    WSSServer(const WSSServer&) = delete;
+    WSSServer(WSSServer&&) = delete;
+    virtual ~WSSServer() = default;
+
+    WSSServer& operator=(const WSSServer&) = delete;
+    WSSServer& operator=(WSSServer&&) = delete;
+
+    //! Multicast the text message to all WebSocket secure sessions
+    /*!
+        Message is framed once and the same frame is sent to all sessions
+        upgraded to WebSocket protocol. Message is compressed once for all
+        sessions which negotiated permessage-deflate extension without
+        context takeover, sessions with context takeover compress the
+        message with their own compression window.
+
+        \param text - Text message (UTF-8) to multicast
+        \return 'true' if the text message was successfully multicast, 'false' if the server is not started
+    */
+    bool MulticastText(std::string_view text) { return MulticastFrame(WebSocket::Opcode::Text, text.data(), text.size()); }
+    //! Multicast the binary message to all WebSocket secure sessions
+    /*!
+        Message is framed once and the same frame is sent to all sessions
+        upgraded to WebSocket protocol. Message is compressed once for all
+        sessions which negotiated permessage-deflate extension without
+        context takeover, sessions with context takeover compress the
+        message with their own compression window.
+
+        \param buffer - Message buffer to multicast
+        \param size - Message size
+        \return 'true' if the binary message was successfully multicast, 'false' if the server is not started
+    */
+    bool MulticastBinary(const void* buffer, size_t size) { return MulticastFrame(WebSocket::Opcode::Binary, buffer, size); }
+    //! Multicast the ping frame to all WebSocket secure sessions
+    /*!
+        \param payload - Ping payload (up to 125 bytes)
+        \return 'true' if the ping frame was successfully multicast, 'false' if the server is not started
+    */
+    bool MulticastPing(std::string_view payload = "") { return MulticastFrame(WebSocket::Opcode::Ping, payload.data(), std::min(payload.size(), (size_t)125)); }
+
+protected:
+    std::shared_ptr<Asio::SSLSession> CreateSession(std::shared_ptr<Asio::SSLServer> server) override { return std::make_shared<WSSSession>(server); }
+
+private:
+    // Multicast WebSocket frame
+    bool MulticastFrame(WebSocket::Opcode opcode, const void* buffer, size_t size);
+};
+
+} // namespace WS
+} // namespace CppServer
+
+#endif // CPPSERVER_WS_WSS_SERVER_H
@@ -0,0 +1,163 @@
+//
+// Created by agent on 18.10.2026
+//
+
+#include "benchmark/cppbenchmark.h"
+
+#include "server/http/http_client.h"
+#include "server/http/http_server.h"
+
+#include <string>
+
+using namespace CppServer::Asio;
+using namespace CppServer::HTTP;
+
+// Typical browser request and server response with the same header set size
+const std::string request_to_parse =
+    "GET /api/v1/items?page=2&limit=50 HTTP/1.1\r\n"
+    "Host: www.example.com\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0.0.0 Safari/537.36\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+    "Accept-Language: en-US,en;q=0.9\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Referer: https://www.example.com/catalog/index.html\r\n"
+    "Cookie: session=7f3c1e9a4b2d8c6f0e5a3b1d9c7e5f3a; theme=dark; lang=en\r\n"
+    "Connection: keep-alive\r\n"
+    "Cache-Control: max-age=0\r\n"
+    "Upgrade-Insecure-Requests: 1\r\n"
+    "\r\n";
+const std::string response_to_parse =
+    "HTTP/1.1 200 OK\r\n"
+    "Date: Sun, 18 Oct 2026 12:00:00 GMT\r\n"
+    "Server: Apache/2.4.58 (Unix) OpenSSL/3.0.13\r\n"
+    "Content-Type: application/json; charset=UTF-8\r\n"
+    "Cache-Control: private, max-age=0, no-cache, no-store, must-revalidate\r\n"
+    "Expires: Thu, 01 Jan 1970 00:00:00 GMT\r\n"
+    "Vary: Accept-Encoding, Origin\r\n"
+    "Set-Cookie: session=7f3c1e9a4b2d8c6f0e5a3b1d9c7e5f3a; Path=/; HttpOnly; Secure\r\n"
+    "Strict-Transport-Security: max-age=31536000; includeSubDomains\r\n"
+    "Connection: keep-alive\r\n"
+    "Content-Length: 2\r\n"
+    "\r\n"
+    "{}";
+// CDN response with a large header set
+const std::string large_response_to_parse =
+    "HTTP/1.1 200 OK\r\n"
+    "Date: Sun, 18 Oct 2026 12:00:00 GMT\r\n"
+    "Content-Type: text/html; charset=utf-8\r\n"
+    "Content-Length: 2\r\n"
+    "Connection: keep-alive\r\n"
+    "Server: cloudflare\r\n"
+    "CF-RAY: 8a1b2c3d4e5f6a7b-AMS\r\n"
+    "CF-Cache-Status: HIT\r\n"
+    "Age: 1234\r\n"
+    "Cache-Control: public, max-age=14400, s-maxage=86400, stale-while-revalidate=60\r\n"
+    "ETag: W/\"5e1d-18b2c3d4e5f\"\r\n"
+    "Last-Modified: Fri, 16 Oct 2026 08:30:00 GMT\r\n"
+    "Vary: Accept-Encoding, Accept-Language, Cookie\r\n"
+    "Content-Security-Policy: default-src 'self'; script-src 'self' 'unsafe-inline' https://cdn.example.com https://www.googletagmanager.com; style-src 'self' 'unsafe-inline' https://fonts.googleapis.com; img-src 'self' data: https:; font-src 'self' https://fonts.gstatic.com; connect-src 'self' https://api.example.com; frame-ancestors 'none'\r\n"
+    "Strict-Transport-Security: max-age=63072000; includeSubDomains; preload\r\n"
+    "X-Content-Type-Options: nosniff\r\n"
+    "X-Frame-Options: DENY\r\n"
+    "X-XSS-Protection: 1; mode=block\r\n"
+    "Referrer-Policy: strict-origin-when-cross-origin\r\n"
+    "Permissions-Policy: camera=(), microphone=(), geolocation=(), interest-cohort=()\r\n"
+    "Set-Cookie: __cf_bm=Zx9yW8vU7tS6rQ5pO4nM3lK2jI1hG0fE9dC8bA7zY6x-1760788800-1.0.1.1-AbCdEfGhIjKlMnOpQrStUvWxYz0123456789; path=/; expires=Sun, 18-Oct-26 12:30:00 GMT; domain=.example.com; HttpOnly; Secure; SameSite=None\r\n"
+    "Alt-Svc: h3=\":443\"; ma=86400\r\n"
+    "\r\n"
+    "{}";
+
+class RequestParser : public HTTPSession
+{
+public:
+    using HTTPSession::HTTPSession;
+
+    void Parse(const void* buffer, size_t size) { onReceived(buffer, size); }
+
+    size_t requests{0};
+
+protected:
+    void onReceivedRequest(const HTTPRequest& request) override { ++requests; }
+};
+
+class ResponseParser : public HTTPClient
+{
+public:
+    using HTTPClient::HTTPClient;
+
+    void Parse(const void* buffer, size_t size) { onReceived(buffer, size); }
+
+    size_t responses{0};
+
+protected:
+    void onReceivedResponse(const HTTPResponse& response) override { ++responses; }
+};
+
+class HTTPParseFixture
+{
+protected:
+    std::shared_ptr<Service> service;
+    std::shared_ptr<TCPServer> server;
+    std::shared_ptr<RequestParser> request_parser;
+    std::shared_ptr<ResponseParser> response_parser;
+    std::string pipelined_requests;
+
+    HTTPParseFixture()
+    {
+        // Parsers are fed directly without starting the service and connecting sockets
+        service = std::make_shared<Service>();
+        server = std::make_shared<TCPServer>(service, 8080);
+        request_parser = std::make_shared<RequestParser>(server);
+        response_parser = std::make_shared<ResponseParser>(service, "127.0.0.1", 8080);
+
+        // Prepare a batch of pipelined requests
+        for (int i = 0; i < 100; ++i)
+            pipelined_requests += request_to_parse;
+    }
+};
+
+BENCHMARK_FIXTURE(HTTPParseFixture, "HTTPRequest parse")
+{
+    request_parser->Parse(request_to_parse.data(), request_to_parse.size());
+    context.metrics().AddBytes(request_to_parse.size());
+    context.metrics().AddItems(1);
+}
+
+BENCHMARK_FIXTURE(HTTPParseFixture, "HTTPRequest parse pipelined")
+{
+    request_parser->Parse(pipelined_requests.data(), pipelined_requests.size());
+    context.metrics().AddBytes(pipelined_requests.size());
+    context.metrics().AddItems(100);
+}
+
+BENCHMARK_FIXTURE(HTTPParseFixture, "HTTPRequest parse by 16 bytes")
+{
+    for (size_t offset = 0; offset < request_to_parse.size(); offset += 16)
+        request_parser->Parse(request_to_parse.data() + offset, std::min((size_t)16, request_to_parse.size() - offset));
+    context.metrics().AddBytes(request_to_parse.size());
+    context.metrics().AddItems(1);
+}
+
+BENCHMARK_FIXTURE(HTTPParseFixture, "HTTPResponse parse")
+{
+    response_parser->Parse(response_to_parse.data(), response_to_parse.size());
+    context.metrics().AddBytes(response_to_parse.size());
+    context.metrics().AddItems(1);
+}
+
+BENCHMARK_FIXTURE(HTTPParseFixture, "HTTPResponse parse large header set")
+{
+    response_parser->Parse(large_response_to_parse.data(), large_response_to_parse.size());
+    context.metrics().AddBytes(large_response_to_parse.size());
+    context.metrics().AddItems(1);
+}
+
+BENCHMARK_FIXTURE(HTTPParseFixture, "HTTPResponse parse by 16 bytes")
+{
+    for (size_t offset = 0; offset < response_to_parse.size(); offset += 16)
+        response_parser->Parse(response_to_parse.data() + offset, std::min((size_t)16, response_to_parse.size() - offset));
+    context.metrics().AddBytes(response_to_parse.size());
+    context.metrics().AddItems(1);
+}
+
+BENCHMARK_MAIN()
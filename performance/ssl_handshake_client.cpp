@@ -0,0 +1,255 @@
+//
+// Created by agent on 18.10.2026
+//
+
+#include "server/asio/service.h"
+#include "server/asio/ssl_client.h"
+
+#include "benchmark/reporter_console.h"
+#include "system/cpu.h"
+#include "threads/thread.h"
+#include "time/timestamp.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <vector>
+
+#include <OptionParser.h>
+
+using namespace CppCommon;
+using namespace CppServer::Asio;
+
+std::atomic<bool> benchmarking(false);
+
+std::atomic<uint64_t> timestamp_start(Timestamp::nano());
+std::atomic<uint64_t> timestamp_stop(Timestamp::nano());
+
+std::atomic<uint64_t> total_errors(0);
+std::atomic<uint64_t> total_handshakes(0);
+std::atomic<uint64_t> total_resumed(0);
+
+class HandshakeClient : public SSLClient
+{
+public:
+    HandshakeClient(std::shared_ptr<Service> service, std::shared_ptr<SSLContext> context, const std::string& address, int port, bool resume)
+        : SSLClient(service, context, address, port),
+          _resume(resume)
+    {
+    }
+
+    ~HandshakeClient()
+    {
+        if (_session != nullptr)
+            SSL_SESSION_free(_session);
+    }
+
+    const std::vector<uint64_t>& handshake_latency() const noexcept { return _handshake_latency; }
+    const std::vector<uint64_t>& first_byte_latency() const noexcept { return _first_byte_latency; }
+
+    void Start()
+    {
+        _connect_timestamp = Timestamp::nano();
+        ConnectAsync();
+    }
+
+protected:
+    void onConnected() override
+    {
+        // Offer the previous session to the server for resumption
+        if (_resume && (_session != nullptr))
+            SSL_set_session(stream().native_handle(), _session);
+
+        _handshake_timestamp = Timestamp::nano();
+    }
+
+    void onHandshaked() override
+    {
+        _handshake_latency.push_back(Timestamp::nano() - _handshake_timestamp);
+
+        if (SSL_session_reused(stream().native_handle()))
+            ++total_resumed;
+
+        // Keep the negotiated session for the next handshake
+        if (_resume)
+        {
+            if (_session != nullptr)
+                SSL_SESSION_free(_session);
+            _session = SSL_get1_session(stream().native_handle());
+        }
+    }
+
+    void onDisconnected() override
+    {
+        // Start a new handshake while benchmarking
+        if (benchmarking)
+            Start();
+    }
+
+    void onReceived(const void* buffer, size_t size) override
+    {
+        uint64_t timestamp = Timestamp::nano();
+        _first_byte_latency.push_back(timestamp - _connect_timestamp);
+
+        timestamp_stop = timestamp;
+        ++total_handshakes;
+
+        DisconnectAsync();
+    }
+
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        std::cout << "Client caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
+        ++total_errors;
+    }
+
+private:
+    bool _resume;
+    SSL_SESSION* _session{nullptr};
+    uint64_t _connect_timestamp{0};
+    uint64_t _handshake_timestamp{0};
+    std::vector<uint64_t> _handshake_latency;
+    std::vector<uint64_t> _first_byte_latency;
+};
+
+void PrintLatency(const std::string& name, std::vector<uint64_t>& latency)
+{
+    if (latency.empty())
+        return;
+
+    std::sort(latency.begin(), latency.end());
+
+    auto percentile = [&latency](double p) { return latency[std::min(latency.size() - 1, (size_t)(p * latency.size()))]; };
+
+    std::cout << name << " (min): " << CppBenchmark::ReporterConsole::GenerateTimePeriod(latency.front()) << std::endl;
+    std::cout << name << " (50%): " << CppBenchmark::ReporterConsole::GenerateTimePeriod(percentile(0.5)) << std::endl;
+    std::cout << name << " (90%): " << CppBenchmark::ReporterConsole::GenerateTimePeriod(percentile(0.9)) << std::endl;
+    std::cout << name << " (99%): " << CppBenchmark::ReporterConsole::GenerateTimePeriod(percentile(0.99)) << std::endl;
+    std::cout << name << " (99.9%): " << CppBenchmark::ReporterConsole::GenerateTimePeriod(percentile(0.999)) << std::endl;
+    std::cout << name << " (max): " << CppBenchmark::ReporterConsole::GenerateTimePeriod(latency.back()) << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    auto parser = optparse::OptionParser().version("1.0.0.0");
+
+    parser.add_option("-a", "--address").dest("address").set_default("127.0.0.1").help("Server address. Default: %default");
+    parser.add_option("-p", "--port").dest("port").action("store").type("int").set_default(2222).help("Server port. Default: %default");
+    parser.add_option("-t", "--threads").dest("threads").action("store").type("int").set_default(CPU::PhysicalCores()).help("Count of working threads. Default: %default");
+    parser.add_option("-c", "--clients").dest("clients").action("store").type("int").set_default(100).help("Count of working clients. Default: %default");
+    parser.add_option("-x", "--ciphers").dest("ciphers").set_default("").help("OpenSSL cipher list. Default: OpenSSL defaults");
+    parser.add_option("-r", "--resume").dest("resume").action("store_true").help("Resume the previous session on each reconnect");
+    parser.add_option("-z", "--seconds").dest("seconds").action("store").type("int").set_default(10).help("Count of seconds to benchmarking. Default: %default");
+
+    optparse::Values options = parser.parse_args(argc, argv);
+
+    // Print help
+    if (options.get("help"))
+    {
+        parser.print_help();
+        return 0;
+    }
+
+    // Client parameters
+    std::string address(options.get("address"));
+    int port = options.get("port");
+    int threads_count = options.get("threads");
+    int clients_count = options.get("clients");
+    std::string ciphers(options.get("ciphers"));
+    bool resume = options.get("resume");
+    int seconds_count = options.get("seconds");
+
+    std::cout << "Server address: " << address << std::endl;
+    std::cout << "Server port: " << port << std::endl;
+    std::cout << "Working threads: " << threads_count << std::endl;
+    std::cout << "Working clients: " << clients_count << std::endl;
+    std::cout << "Ciphers: " << (ciphers.empty() ? "default" : ciphers) << std::endl;
+    std::cout << "Session resumption: " << (resume ? "enabled" : "disabled") << std::endl;
+    std::cout << "Seconds to benchmarking: " << seconds_count << std::endl;
+
+    std::cout << std::endl;
+
+    // Create a new Asio service
+    auto service = std::make_shared<Service>(threads_count);
+
+    // Start the Asio service
+    std::cout << "Asio service starting...";
+    service->Start();
+    std::cout << "Done!" << std::endl;
+
+    // Create and prepare a new SSL client context
+    auto context = std::make_shared<SSLContext>(asio::ssl::context::tlsv12);
+    context->set_default_verify_paths();
+    context->set_root_certs();
+    context->set_verify_mode(asio::ssl::verify_peer | asio::ssl::verify_fail_if_no_peer_cert);
+    context->load_verify_file("../tools/certificates/ca.pem");
+    if (!ciphers.empty() && (SSL_CTX_set_cipher_list(context->native_handle(), ciphers.c_str()) != 1))
+    {
+        std::cout << "Invalid cipher list: " << ciphers << std::endl;
+        return -1;
+    }
+    SSL_CTX_set_session_cache_mode(context->native_handle(), resume ? SSL_SESS_CACHE_CLIENT : SSL_SESS_CACHE_OFF);
+
+    // Create handshake clients
+    std::vector<std::shared_ptr<HandshakeClient>> clients;
+    for (int i = 0; i < clients_count; ++i)
+    {
+        // Create handshake client
+        auto client = std::make_shared<HandshakeClient>(service, context, address, port, resume);
+        client->SetupNoDelay(true);
+        clients.emplace_back(client);
+    }
+
+    benchmarking = true;
+    timestamp_start = Timestamp::nano();
+
+    // Start handshaking
+    std::cout << "Benchmarking...";
+    for (auto& client : clients)
+        client->Start();
+    Thread::Sleep(seconds_count * 1000);
+    benchmarking = false;
+    std::cout << "Done!" << std::endl;
+
+    // Wait for all clients to disconnect
+    std::cout << "Clients disconnecting...";
+    for (const auto& client : clients)
+        while (client->IsConnected())
+            Thread::Yield();
+    std::cout << "Done!" << std::endl;
+
+    // Stop the Asio service
+    std::cout << "Asio service stopping...";
+    service->Stop();
+    std::cout << "Done!" << std::endl;
+
+    std::cout << std::endl;
+
+    std::cout << "Errors: " << total_errors << std::endl;
+
+    std::cout << std::endl;
+
+    // Collect latency samples from all clients
+    std::vector<uint64_t> handshake_latency;
+    std::vector<uint64_t> first_byte_latency;
+    for (const auto& client : clients)
+    {
+        handshake_latency.insert(handshake_latency.end(), client->handshake_latency().begin(), client->handshake_latency().end());
+        first_byte_latency.insert(first_byte_latency.end(), client->first_byte_latency().begin(), client->first_byte_latency().end());
+    }
+
+    std::cout << "Handshake time: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(timestamp_stop - timestamp_start) << std::endl;
+    std::cout << "Total handshakes: " << total_handshakes << std::endl;
+    std::cout << "Resumed handshakes: " << total_resumed << std::endl;
+    std::cout << "Handshake throughput: " << total_handshakes * 1000000000 / (timestamp_stop - timestamp_start) << " handshakes/s" << std::endl;
+
+    std::cout << std::endl;
+
+    PrintLatency("Handshake latency", handshake_latency);
+
+    std::cout << std::endl;
+
+    PrintLatency("Time to first byte", first_byte_latency);
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+//
+// Created by agent on 18.10.2026
+//
+
+#include "server/asio/service.h"
+#include "server/asio/ssl_server.h"
+#include "system/cpu.h"
+
+#include <iostream>
+
+#include <OptionParser.h>
+
+using namespace CppCommon;
+using namespace CppServer::Asio;
+
+class HandshakeSession : public SSLSession
+{
+public:
+    using SSLSession::SSLSession;
+
+protected:
+    void onHandshaked() override
+    {
+        // Send the first byte to the client right after the handshake
+        SendAsync("!");
+    }
+
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        std::cout << "Session caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
+    }
+};
+
+class HandshakeServer : public SSLServer
+{
+public:
+    using SSLServer::SSLServer;
+
+protected:
+    std::shared_ptr<SSLSession> CreateSession(std::shared_ptr<SSLServer> server) override
+    {
+        return std::make_shared<HandshakeSession>(server);
+    }
+
+protected:
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        std::cout << "Server caught an error with code " << error << " and category '" << category << "': " << message << std::endl;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    auto parser = optparse::OptionParser().version("1.0.0.0");
+
+    parser.add_option("-p", "--port").dest("port").action("store").type("int").set_default(2222).help("Server port. Default: %default");
+    parser.add_option("-t", "--threads").dest("threads").action("store").type("int").set_default(CPU::PhysicalCores()).help("Count of working threads. Default: %default");
+    parser.add_option("-k", "--key").dest("key").set_default("rsa").help("Server key type (rsa, ecdsa). Default: %default");
+    parser.add_option("-x", "--ciphers").dest("ciphers").set_default("").help("OpenSSL cipher list. Default: OpenSSL defaults");
+    parser.add_option("-n", "--no-resume").dest("no-resume").action("store_true").help("Disable session cache and session tickets");
+
+    optparse::Values options = parser.parse_args(argc, argv);
+
+    // Print help
+    if (options.get("help"))
+    {
+        parser.print_help();
+        return 0;
+    }
+
+    // Server parameters
+    int port = options.get("port");
+    int threads = options.get("threads");
+    std::string key(options.get("key"));
+    std::string ciphers(options.get("ciphers"));
+    bool resume = !options.get("no-resume");
+
+    // Server certificate
+    std::string certificate;
+    if (key == "rsa")
+        certificate = "../tools/certificates/server.pem";
+    else if (key == "ecdsa")
+        certificate = "../tools/certificates/server-ecdsa.pem";
+    else
+    {
+        std::cout << "Unknown server key type: " << key << std::endl;
+        return -1;
+    }
+
+    std::cout << "Server port: " << port << std::endl;
+    std::cout << "Working threads: " << threads << std::endl;
+    std::cout << "Server key: " << key << std::endl;
+    std::cout << "Ciphers: " << (ciphers.empty() ? "default" : ciphers) << std::endl;
+    std::cout << "Session resumption: " << (resume ? "enabled" : "disabled") << std::endl;
+
+    std::cout << std::endl;
+
+    // Create a new Asio service
+    auto service = std::make_shared<Service>(threads);
+
+    // Start the Asio service
+    std::cout << "Asio service starting...";
+    service->Start();
+    std::cout << "Done!" << std::endl;
+
+    // Create and prepare a new SSL server context
+    auto context = std::make_shared<SSLContext>(asio::ssl::context::tlsv12);
+    context->set_password_callback([](size_t max_length, asio::ssl::context::password_purpose purpose) -> std::string { return "qwerty"; });
+    context->use_certificate_chain_file(certificate);
+    context->use_private_key_file(certificate, asio::ssl::context::pem);
+    context->use_tmp_dh_file("../tools/certificates/dh4096.pem");
+    if (!ciphers.empty() && (SSL_CTX_set_cipher_list(context->native_handle(), ciphers.c_str()) != 1))
+    {
+        std::cout << "Invalid cipher list: " << ciphers << std::endl;
+        return -1;
+    }
+    if (resume)
+    {
+        static const unsigned char session_id_context[] = "cppserver-performance-ssl_handshake_server";
+        SSL_CTX_set_session_cache_mode(context->native_handle(), SSL_SESS_CACHE_SERVER);
+        SSL_CTX_set_session_id_context(context->native_handle(), session_id_context, sizeof(session_id_context) - 1);
+    }
+    else
+    {
+        SSL_CTX_set_session_cache_mode(context->native_handle(), SSL_SESS_CACHE_OFF);
+        SSL_CTX_set_options(context->native_handle(), SSL_OP_NO_TICKET);
+    }
+
+    // Create a new handshake server
+    auto server = std::make_shared<HandshakeServer>(service, context, port);
+    server->SetupNoDelay(true);
+    server->SetupReuseAddress(true);
+    server->SetupReusePort(true);
+
+    // Start the server
+    std::cout << "Server starting...";
+    server->Start();
+    std::cout << "Done!" << std::endl;
+
+    std::cout << "Press Enter to stop the server or '!' to restart the server..." << std::endl;
+
+    // Perform text input
+    std::string line;
+    while (getline(std::cin, line))
+    {
+        if (line.empty())
+            break;
+
+        // Restart the server
+        if (line == "!")
+        {
+            std::cout << "Server restarting...";
+            server->Restart();
+            std::cout << "Done!" << std::endl;
+            continue;
+        }
+    }
+
+    // Stop the server
+    std::cout << "Server stopping...";
+    server->Stop();
+    std::cout << "Done!" << std::endl;
+
+    // Stop the Asio service
+    std::cout << "Asio service stopping...";
+    service->Stop();
+    std::cout << "Done!" << std::endl;
+
+    return 0;
+}
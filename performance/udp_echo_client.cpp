@@ -31,10 +31,11 @@ std::atomic<uint64_t> total_messages(0);
 class EchoClient : public UDPClient
 {
 public:
-    EchoClient(std::shared_ptr<Service> service, const std::string& address, int port, int messages)
+    EchoClient(std::shared_ptr<Service> service, const std::string& address, int port, int messages, bool connected)
         : UDPClient(service, address, port),
           _messages(messages)
     {
+        SetupConnected(connected);
     }
 
     void SendMessage() { Send(message_to_send.data(), message_to_send.size()); }
@@ -81,6 +82,7 @@ int main(int argc, char** argv)
     parser.add_option("-c", "--clients").dest("clients").action("store").type("int").set_default(100).help("Count of working clients. Default: %default");
     parser.add_option("-m", "--messages").dest("messages").action("store").type("int").set_default(1000).help("Count of messages to send at the same time. Default: %default");
     parser.add_option("-s", "--size").dest("size").action("store").type("int").set_default(32).help("Single message size. Default: %default");
+    parser.add_option("-n", "--connected").dest("connected").action("store_true").help("Connect client sockets to the server endpoint");
     parser.add_option("-z", "--seconds").dest("seconds").action("store").type("int").set_default(10).help("Count of seconds to benchmarking. Default: %default");
 
     optparse::Values options = parser.parse_args(argc, argv);
@@ -100,6 +102,7 @@ int main(int argc, char** argv)
     int messages_count = options.get("messages");
     int message_size = options.get("size");
     int seconds_count = options.get("seconds");
+    bool connected = options.get("connected");
 
     std::cout << "Server address: " << address << std::endl;
     std::cout << "Server port: " << port << std::endl;
@@ -107,6 +110,7 @@ int main(int argc, char** argv)
     std::cout << "Working clients: " << clients_count << std::endl;
     std::cout << "Working messages: " << messages_count << std::endl;
     std::cout << "Message size: " << message_size << std::endl;
+    std::cout << "Connected sockets: " << (connected ? "enabled" : "disabled") << std::endl;
     std::cout << "Seconds to benchmarking: " << seconds_count << std::endl;
 
     std::cout << std::endl;
@@ -127,7 +131,7 @@ int main(int argc, char** argv)
     for (int i = 0; i < clients_count; ++i)
     {
         // Create echo client
-        auto client = std::make_shared<EchoClient>(service, address, port, messages_count);
+        auto client = std::make_shared<EchoClient>(service, address, port, messages_count, connected);
         clients.emplace_back(client);
     }
 
@@ -56,6 +56,8 @@ int main(int argc, char** argv)
 
     parser.add_option("-p", "--port").dest("port").action("store").type("int").set_default(3333).help("Server port. Default: %default");
     parser.add_option("-t", "--threads").dest("threads").action("store").type("int").set_default(CPU::PhysicalCores()).help("Count of working threads. Default: %default");
+    parser.add_option("-g", "--group").dest("group").action("store_true").help("Receive with SO_REUSEPORT socket per working thread");
+    parser.add_option("-s", "--steering").dest("steering").action("store_true").help("Steer datagrams of the socket group by the flow hash");
 
     optparse::Values options = parser.parse_args(argc, argv);
 
@@ -69,9 +71,12 @@ int main(int argc, char** argv)
     // Server port
     int port = options.get("port");
     int threads = options.get("threads");
+    bool group = options.get("group");
+    bool steering = options.get("steering");
 
     std::cout << "Server port: " << port << std::endl;
     std::cout << "Working threads: " << threads << std::endl;
+    std::cout << "Socket group: " << (group ? (steering ? "enabled with steering" : "enabled") : "disabled") << std::endl;
 
     std::cout << std::endl;
 
@@ -87,6 +92,7 @@ int main(int argc, char** argv)
     auto server = std::make_shared<EchoServer>(service, port);
     server->SetupReuseAddress(true);
     server->SetupReusePort(true);
+    server->SetupReusePortGroup(group, steering);
 
     // Start the server
     std::cout << "Server starting...";
@@ -0,0 +1,336 @@
+/*!
+    \file message_compression.cpp
+    \brief Message compression implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/message_compression.h"
+
+#if defined(CPPSERVER_ZLIB)
+#include <zlib.h>
+#else
+struct z_stream_s {};
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+namespace CppServer {
+namespace Asio {
+
+namespace {
+
+// Trailing empty block of the flushed deflate stream
+const uint8_t TAIL[4] = { 0x00, 0x00, 0xFF, 0xFF };
+
+#if defined(CPPSERVER_ZLIB)
+// Maximal input size of one compression stream call
+const size_t MAX_CHUNK = std::numeric_limits<uInt>::max();
+#endif
+
+} // namespace
+
+MessageCompression::MessageCompression()
+    : _mode(Mode::None),
+      _level(-1),
+      _window_bits(15),
+      _context_takeover(true)
+{
+}
+
+MessageCompression::~MessageCompression()
+{
+    ReleaseDeflate();
+    ReleaseInflate();
+}
+
+bool MessageCompression::IsDeflateSupported() noexcept
+{
+#if defined(CPPSERVER_ZLIB)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void MessageCompression::SetupNone()
+{
+    _mode = Mode::None;
+    Reset();
+}
+
+void MessageCompression::SetupDeflate(int level, int window_bits)
+{
+    assert(((level >= -1) && (level <= 9)) && "Compression level must be from -1 to 9!");
+    assert(((window_bits >= 9) && (window_bits <= 15)) && "Compression window bits must be from 9 to 15!");
+    if ((level < -1) || (level > 9) || (window_bits < 9) || (window_bits > 15))
+        return;
+
+    _mode = Mode::Deflate;
+    _level = level;
+    _window_bits = window_bits;
+    Reset();
+}
+
+void MessageCompression::SetupContextTakeover(bool enable)
+{
+    _context_takeover = enable;
+    Reset();
+}
+
+void MessageCompression::SetupDictionary(std::string_view dictionary)
+{
+    _dictionary = dictionary;
+    Reset();
+}
+
+void MessageCompression::Reset()
+{
+    ReleaseDeflate();
+    ReleaseInflate();
+}
+
+bool MessageCompression::Compress(const void* buffer, size_t size, std::string& output, bool fin)
+{
+    assert(((buffer != nullptr) || (size == 0)) && "Pointer to the buffer should not be null!");
+    if ((buffer == nullptr) && (size > 0))
+        return false;
+
+    if (_mode == Mode::None)
+    {
+        output.append((const char*)buffer, size);
+        return true;
+    }
+
+    if (!_deflate && !InitDeflate())
+        return false;
+
+    size_t index = output.size();
+    if (!Deflate((const uint8_t*)buffer, size, output))
+    {
+        // Compression stream is broken, so it will be created for the next message
+        output.resize(index);
+        ReleaseDeflate();
+        return false;
+    }
+
+    if (fin)
+    {
+        // Remove the trailing empty block of the flushed message
+        if (((output.size() - index) >= sizeof(TAIL)) && (std::memcmp(&output[output.size() - sizeof(TAIL)], TAIL, sizeof(TAIL)) == 0))
+            output.resize(output.size() - sizeof(TAIL));
+
+        if (!_context_takeover && !ResetDeflate())
+            ReleaseDeflate();
+    }
+
+    return true;
+}
+
+bool MessageCompression::Decompress(const void* buffer, size_t size, std::string& output, size_t limit)
+{
+    assert(((buffer != nullptr) || (size == 0)) && "Pointer to the buffer should not be null!");
+    if ((buffer == nullptr) && (size > 0))
+        return false;
+
+    if (_mode == Mode::None)
+    {
+        output.append((const char*)buffer, size);
+        return true;
+    }
+
+    if (!_inflate && !InitInflate())
+        return false;
+
+    // Restore the trailing empty block removed from the compressed message
+    size_t index = output.size();
+    if (!Inflate((const uint8_t*)buffer, size, output, index, limit) || !Inflate(TAIL, sizeof(TAIL), output, index, limit))
+    {
+        output.resize(index);
+        ReleaseInflate();
+        return false;
+    }
+
+    // Decompressing of the too large message was interrupted, so the stream is inconsistent
+    if ((limit > 0) && ((output.size() - index) > limit))
+    {
+        ReleaseInflate();
+        return true;
+    }
+
+    if (!_context_takeover && !ResetInflate())
+        ReleaseInflate();
+
+    return true;
+}
+
+#if defined(CPPSERVER_ZLIB)
+
+bool MessageCompression::InitDeflate()
+{
+    _deflate = std::make_unique<z_stream>();
+    if (deflateInit2(_deflate.get(), _level, Z_DEFLATED, -_window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        _deflate.reset();
+        return false;
+    }
+
+    if (!_dictionary.empty() && (deflateSetDictionary(_deflate.get(), (const Bytef*)_dictionary.data(), (uInt)_dictionary.size()) != Z_OK))
+    {
+        ReleaseDeflate();
+        return false;
+    }
+
+    return true;
+}
+
+bool MessageCompression::InitInflate()
+{
+    // Maximal window accepts messages compressed with any window
+    _inflate = std::make_unique<z_stream>();
+    if (inflateInit2(_inflate.get(), -15) != Z_OK)
+    {
+        _inflate.reset();
+        return false;
+    }
+
+    if (!_dictionary.empty() && (inflateSetDictionary(_inflate.get(), (const Bytef*)_dictionary.data(), (uInt)_dictionary.size()) != Z_OK))
+    {
+        ReleaseInflate();
+        return false;
+    }
+
+    return true;
+}
+
+bool MessageCompression::ResetDeflate()
+{
+    if (deflateReset(_deflate.get()) != Z_OK)
+        return false;
+
+    return _dictionary.empty() || (deflateSetDictionary(_deflate.get(), (const Bytef*)_dictionary.data(), (uInt)_dictionary.size()) == Z_OK);
+}
+
+bool MessageCompression::ResetInflate()
+{
+    if (inflateReset(_inflate.get()) != Z_OK)
+        return false;
+
+    return _dictionary.empty() || (inflateSetDictionary(_inflate.get(), (const Bytef*)_dictionary.data(), (uInt)_dictionary.size()) == Z_OK);
+}
+
+bool MessageCompression::Deflate(const uint8_t* data, size_t size, std::string& output)
+{
+    do
+    {
+        size_t chunk = std::min(size, MAX_CHUNK);
+        _deflate->next_in = (Bytef*)data;
+        _deflate->avail_in = (uInt)chunk;
+        data += chunk;
+        size -= chunk;
+
+        // Flush the compressed data to the byte boundary
+        do
+        {
+            size_t offset = output.size();
+            size_t capacity = std::min((size_t)deflateBound(_deflate.get(), _deflate->avail_in) + 16, MAX_CHUNK);
+            output.resize(offset + capacity);
+            _deflate->next_out = (Bytef*)&output[offset];
+            _deflate->avail_out = (uInt)capacity;
+
+            int result = deflate(_deflate.get(), Z_SYNC_FLUSH);
+            output.resize(offset + capacity - _deflate->avail_out);
+
+            // No progress is not an error when there is nothing to flush
+            if ((result != Z_OK) && (result != Z_BUF_ERROR))
+                return false;
+        } while (_deflate->avail_out == 0);
+    } while (size > 0);
+
+    return true;
+}
+
+bool MessageCompression::Inflate(const uint8_t* data, size_t size, std::string& output, size_t start, size_t limit)
+{
+    do
+    {
+        size_t chunk = std::min(size, MAX_CHUNK);
+        _inflate->next_in = (Bytef*)data;
+        _inflate->avail_in = (uInt)chunk;
+        data += chunk;
+        size -= chunk;
+
+        do
+        {
+            // Do not decompress much more than the limit
+            size_t offset = output.size();
+            size_t capacity = std::min(std::max((size_t)_inflate->avail_in * 4, (size_t)4096), MAX_CHUNK);
+            if (limit > 0)
+                capacity = std::min(capacity, limit - std::min(limit, offset - start) + 1);
+            output.resize(offset + capacity);
+            _inflate->next_out = (Bytef*)&output[offset];
+            _inflate->avail_out = (uInt)capacity;
+
+            int result = inflate(_inflate.get(), Z_SYNC_FLUSH);
+            output.resize(offset + capacity - _inflate->avail_out);
+
+            if ((limit > 0) && ((output.size() - start) > limit))
+                return true;
+
+            if (result == Z_STREAM_END)
+            {
+                // Final block ends the stream, so the rest of the message starts a new one
+                if (!ResetInflate())
+                    return false;
+            }
+            else if (result == Z_BUF_ERROR)
+            {
+                // No progress is possible without more input
+                if (_inflate->avail_out > 0)
+                    break;
+            }
+            else if (result != Z_OK)
+                return false;
+        } while ((_inflate->avail_in > 0) || (_inflate->avail_out == 0));
+    } while (size > 0);
+
+    return true;
+}
+
+void MessageCompression::ReleaseDeflate()
+{
+    if (_deflate)
+    {
+        deflateEnd(_deflate.get());
+        _deflate.reset();
+    }
+}
+
+void MessageCompression::ReleaseInflate()
+{
+    if (_inflate)
+    {
+        inflateEnd(_inflate.get());
+        _inflate.reset();
+    }
+}
+
+#else
+
+bool MessageCompression::InitDeflate() { return false; }
+bool MessageCompression::InitInflate() { return false; }
+bool MessageCompression::ResetDeflate() { return false; }
+bool MessageCompression::ResetInflate() { return false; }
+bool MessageCompression::Deflate(const uint8_t* data, size_t size, std::string& output) { return false; }
+bool MessageCompression::Inflate(const uint8_t* data, size_t size, std::string& output, size_t start, size_t limit) { return false; }
+void MessageCompression::ReleaseDeflate() { _deflate.reset(); }
+void MessageCompression::ReleaseInflate() { _inflate.reset(); }
+
+#endif
+
+} // namespace Asio
+} // namespace CppServer
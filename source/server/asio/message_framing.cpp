@@ -0,0 +1,141 @@
+/*!
+    \file message_framing.cpp
+    \brief Message framing implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/message_framing.h"
+
+#include <limits>
+
+namespace CppServer {
+namespace Asio {
+
+MessageFraming::MessageFraming()
+    : _mode(Mode::LengthPrefix),
+      _length_width(4),
+      _length_endian(Endian::Big),
+      _max_message_size(0),
+      _length(0),
+      _error(false)
+{
+}
+
+void MessageFraming::SetupLengthPrefix(size_t width, Endian endian)
+{
+    assert(((width == 1) || (width == 2) || (width == 4) || (width == 8)) && "Length prefix width must be 1, 2, 4 or 8 bytes!");
+    if ((width != 1) && (width != 2) && (width != 4) && (width != 8))
+        return;
+
+    _mode = Mode::LengthPrefix;
+    _length_width = width;
+    _length_endian = endian;
+    Reset();
+}
+
+void MessageFraming::SetupDelimiter(std::string_view delimiter)
+{
+    assert(!delimiter.empty() && "Delimiter must not be empty!");
+    if (delimiter.empty())
+        return;
+
+    _mode = Mode::Delimiter;
+    _delimiter = delimiter;
+    Reset();
+}
+
+void MessageFraming::Reset()
+{
+    _buffer.clear();
+    _length = 0;
+    _error = false;
+}
+
+bool MessageFraming::Frame(const void* buffer, size_t size, std::vector<uint8_t>& output) const
+{
+    assert((buffer != nullptr) && "Pointer to the buffer should not be null!");
+    if (buffer == nullptr)
+        return false;
+
+    const uint8_t* data = (const uint8_t*)buffer;
+
+    if (_mode == Mode::LengthPrefix)
+    {
+        // Check if the message size fits into the length prefix
+        if ((_length_width < 8) && ((uint64_t)size >> (8 * _length_width)) != 0)
+            return false;
+
+        output.reserve(output.size() + _length_width + size);
+
+        // Write the length prefix
+        for (size_t i = 0; i < _length_width; ++i)
+        {
+            size_t shift = (_length_endian == Endian::Big) ? (_length_width - 1 - i) : i;
+            output.push_back((uint8_t)((uint64_t)size >> (8 * shift)));
+        }
+
+        output.insert(output.end(), data, data + size);
+    }
+    else
+    {
+        output.reserve(output.size() + size + _delimiter.size());
+        output.insert(output.end(), data, data + size);
+        output.insert(output.end(), _delimiter.begin(), _delimiter.end());
+    }
+
+    return true;
+}
+
+bool MessageFraming::ReadLength(const uint8_t* data, size_t& length) const noexcept
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < _length_width; ++i)
+    {
+        size_t shift = (_length_endian == Endian::Big) ? (_length_width - 1 - i) : i;
+        value |= (uint64_t)data[i] << (8 * shift);
+    }
+
+    // Check if the message size is not addressable
+    if (value > (uint64_t)(std::numeric_limits<size_t>::max() - _length_width))
+        return false;
+
+    length = (size_t)value;
+
+    return !IsTooLarge(length);
+}
+
+size_t MessageFraming::FindDelimiter(const uint8_t* data, size_t size) const noexcept
+{
+    const size_t delimiter_size = _delimiter.size();
+    if (size < delimiter_size)
+        return std::string::npos;
+
+    const uint8_t* delimiter = (const uint8_t*)_delimiter.data();
+    const uint8_t* current = data;
+    const uint8_t* last = data + size - delimiter_size + 1;
+
+    // Scan for the first delimiter byte and compare the rest of the delimiter
+    while (current < last)
+    {
+        current = (const uint8_t*)std::memchr(current, delimiter[0], last - current);
+        if (current == nullptr)
+            return std::string::npos;
+        if (std::memcmp(current, delimiter, delimiter_size) == 0)
+            return current - data;
+        ++current;
+    }
+
+    return std::string::npos;
+}
+
+bool MessageFraming::Fail()
+{
+    _buffer.clear();
+    _error = true;
+    return false;
+}
+
+} // namespace Asio
+} // namespace CppServer
@@ -0,0 +1,472 @@
+/*!
+    \file rudp_channel.cpp
+    \brief Reliable UDP channel implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/rudp_channel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+
+namespace CppServer {
+namespace Asio {
+
+namespace {
+
+// Datagram types
+const uint8_t TYPE_RELIABLE = 1;
+const uint8_t TYPE_UNRELIABLE = 2;
+const uint8_t TYPE_ACK = 3;
+
+// Datagram header sizes
+const size_t RELIABLE_HEADER_SIZE = 8;
+const size_t UNRELIABLE_HEADER_SIZE = 4;
+const size_t ACK_HEADER_SIZE = 8;
+const size_t ACK_BLOCK_SIZE = 8;
+const size_t ACK_MAX_BLOCKS = 32;
+
+// Fast retransmit threshold
+const uint32_t DUPLICATE_THRESHOLD = 3;
+
+// Retransmission timeout limits in nanoseconds
+const uint64_t RTO_INITIAL = 200000000;
+const uint64_t RTO_MIN = 10000000;
+const uint64_t RTO_MAX = 10000000000;
+
+// Initial congestion window and slow start threshold in messages
+const double CWND_INITIAL = 10.0;
+const double CWND_MIN = 1.0;
+const double SSTHRESH_INITIAL = 1024.0;
+
+void WriteUInt32(uint8_t* buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)(value >> 24);
+    buffer[1] = (uint8_t)(value >> 16);
+    buffer[2] = (uint8_t)(value >> 8);
+    buffer[3] = (uint8_t)value;
+}
+
+uint32_t ReadUInt32(const uint8_t* buffer)
+{
+    return ((uint32_t)buffer[0] << 24) | ((uint32_t)buffer[1] << 16) | ((uint32_t)buffer[2] << 8) | (uint32_t)buffer[3];
+}
+
+void WriteUInt16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0] = (uint8_t)(value >> 8);
+    buffer[1] = (uint8_t)value;
+}
+
+uint16_t ReadUInt16(const uint8_t* buffer)
+{
+    return (uint16_t)(((uint16_t)buffer[0] << 8) | (uint16_t)buffer[1]);
+}
+
+// Generate a new non zero channel incarnation
+uint16_t GenerateIncarnation()
+{
+    static thread_local std::mt19937 generator(std::random_device{}());
+    std::uniform_int_distribution<unsigned> distribution(1, 0xFFFF);
+    return (uint16_t)distribution(generator);
+}
+
+} // namespace
+
+RUDPChannel::RUDPChannel()
+{
+    Reset();
+}
+
+void RUDPChannel::Reset()
+{
+    _incarnation = GenerateIncarnation();
+    _peer_incarnation = 0;
+    _previous_peer_incarnation = 0;
+    ResetSequences();
+    _messages_sent = 0;
+    _messages_received = 0;
+    _messages_retransmitted = 0;
+    _messages_dropped = 0;
+    _peer_resets = 0;
+}
+
+void RUDPChannel::ResetSequences()
+{
+    _send_sequence = 0;
+    _send_queue.clear();
+    _send_window.clear();
+    _cwnd = CWND_INITIAL;
+    _ssthresh = SSTHRESH_INITIAL;
+    _recovery = false;
+    _recovery_sequence = 0;
+    _srtt = 0;
+    _rttvar = 0;
+    _rto = RTO_INITIAL;
+    _receive_sequence = 0;
+    _receive_buffer.clear();
+    _ack_required = false;
+}
+
+void RUDPChannel::DropPending(const std::map<uint32_t, Packet, SequenceLess>& window, const std::deque<std::vector<uint8_t>>& queue)
+{
+    // Unacknowledged messages were sent before the queued ones
+    for (const auto& packet : window)
+    {
+        ++_messages_dropped;
+        onDropped(packet.second.datagram.data() + RELIABLE_HEADER_SIZE, packet.second.datagram.size() - RELIABLE_HEADER_SIZE);
+    }
+    for (const auto& datagram : queue)
+    {
+        ++_messages_dropped;
+        onDropped(datagram.data() + RELIABLE_HEADER_SIZE, datagram.size() - RELIABLE_HEADER_SIZE);
+    }
+}
+
+bool RUDPChannel::CheckIncarnation(uint16_t incarnation)
+{
+    // Remember the first seen peer incarnation
+    if (_peer_incarnation == 0)
+    {
+        _peer_incarnation = incarnation;
+        return true;
+    }
+
+    if (incarnation == _peer_incarnation)
+        return true;
+
+    // Ignore late datagrams of the previous peer incarnation
+    if (incarnation == _previous_peer_incarnation)
+        return false;
+
+    // Peer was restarted, so its sequences start from zero
+    _previous_peer_incarnation = _peer_incarnation;
+    _peer_incarnation = incarnation;
+    ++_peer_resets;
+
+    // Messages pending for the previous peer incarnation will never be delivered
+    auto window = std::move(_send_window);
+    auto queue = std::move(_send_queue);
+    ResetSequences();
+    DropPending(window, queue);
+    return true;
+}
+
+bool RUDPChannel::SendReliable(const void* buffer, size_t size)
+{
+    assert((buffer != nullptr) && "Pointer to the buffer should not be null!");
+    if (buffer == nullptr)
+        return false;
+
+    if (size > MaxMessageSize)
+        return false;
+
+    // Prepare the reliable datagram
+    std::vector<uint8_t> datagram(RELIABLE_HEADER_SIZE + size, 0);
+    datagram[0] = TYPE_RELIABLE;
+    WriteUInt16(datagram.data() + 2, _incarnation);
+    WriteUInt32(datagram.data() + 4, _send_sequence++);
+    std::copy((const uint8_t*)buffer, (const uint8_t*)buffer + size, datagram.data() + RELIABLE_HEADER_SIZE);
+
+    // Queue the datagram until the congestion window allows to send it
+    _send_queue.emplace_back(std::move(datagram));
+
+    return true;
+}
+
+bool RUDPChannel::SendUnreliable(const void* buffer, size_t size)
+{
+    assert((buffer != nullptr) && "Pointer to the buffer should not be null!");
+    if (buffer == nullptr)
+        return false;
+
+    if (size > MaxMessageSize)
+        return false;
+
+    // Prepare the unreliable datagram
+    std::vector<uint8_t> datagram(UNRELIABLE_HEADER_SIZE + size, 0);
+    datagram[0] = TYPE_UNRELIABLE;
+    WriteUInt16(datagram.data() + 2, _incarnation);
+    std::copy((const uint8_t*)buffer, (const uint8_t*)buffer + size, datagram.data() + UNRELIABLE_HEADER_SIZE);
+
+    // Update statistic
+    ++_messages_sent;
+
+    // Send the datagram immediately
+    onSend(datagram.data(), datagram.size());
+
+    return true;
+}
+
+bool RUDPChannel::Receive(const void* buffer, size_t size, uint64_t timestamp)
+{
+    assert((buffer != nullptr) && "Pointer to the buffer should not be null!");
+    if (buffer == nullptr)
+        return false;
+
+    const uint8_t* bytes = (const uint8_t*)buffer;
+
+    if (size < UNRELIABLE_HEADER_SIZE)
+        return false;
+
+    if ((bytes[0] != TYPE_RELIABLE) && (bytes[0] != TYPE_UNRELIABLE) && (bytes[0] != TYPE_ACK))
+        return false;
+
+    // Skip datagrams of the previous peer incarnation
+    if (!CheckIncarnation(ReadUInt16(bytes + 2)))
+        return true;
+
+    switch (bytes[0])
+    {
+        case TYPE_RELIABLE:
+        {
+            if (size < RELIABLE_HEADER_SIZE)
+                return false;
+
+            uint32_t sequence = ReadUInt32(bytes + 4);
+
+            // Acknowledge every reliable datagram including duplicates
+            _ack_required = true;
+
+            // Skip already delivered datagram
+            if (SequenceLess()(sequence, _receive_sequence))
+                return true;
+
+            // Buffer the reordered datagram
+            if (sequence != _receive_sequence)
+            {
+                if ((uint32_t)(sequence - _receive_sequence) <= MaxReorderSize)
+                    _receive_buffer.emplace(sequence, std::vector<uint8_t>(bytes + RELIABLE_HEADER_SIZE, bytes + size));
+                return true;
+            }
+
+            // Deliver the expected message
+            ++_receive_sequence;
+            ++_messages_received;
+            onReceived(bytes + RELIABLE_HEADER_SIZE, size - RELIABLE_HEADER_SIZE);
+
+            // Deliver all buffered messages in order
+            auto it = _receive_buffer.begin();
+            while ((it != _receive_buffer.end()) && (it->first == _receive_sequence))
+            {
+                std::vector<uint8_t> message(std::move(it->second));
+                it = _receive_buffer.erase(it);
+                ++_receive_sequence;
+                ++_messages_received;
+                onReceived(message.data(), message.size());
+            }
+            return true;
+        }
+        case TYPE_UNRELIABLE:
+        {
+            ++_messages_received;
+            onReceived(bytes + UNRELIABLE_HEADER_SIZE, size - UNRELIABLE_HEADER_SIZE);
+            return true;
+        }
+        case TYPE_ACK:
+            return ReceiveAck(bytes, size, timestamp);
+        default:
+            return false;
+    }
+}
+
+bool RUDPChannel::ReceiveAck(const uint8_t* buffer, size_t size, uint64_t timestamp)
+{
+    if (size < ACK_HEADER_SIZE)
+        return false;
+
+    size_t blocks = buffer[1];
+    if (size < (ACK_HEADER_SIZE + blocks * ACK_BLOCK_SIZE))
+        return false;
+
+    uint32_t cumulative = ReadUInt32(buffer + 4);
+
+    // Remove all cumulatively acknowledged packets
+    size_t acked = 0;
+    auto it = _send_window.begin();
+    while ((it != _send_window.end()) && SequenceLess()(it->first, cumulative))
+    {
+        // Karn's algorithm: sample round-trip time only for not retransmitted packets
+        if ((it->second.retransmits == 0) && !it->second.sacked)
+            UpdateRTT(timestamp - it->second.timestamp);
+        if (!it->second.sacked)
+            ++acked;
+        it = _send_window.erase(it);
+    }
+
+    // Mark selectively acknowledged packets
+    uint32_t highest_sacked = cumulative;
+    bool any_sacked = false;
+    for (size_t i = 0; i < blocks; ++i)
+    {
+        uint32_t begin = ReadUInt32(buffer + ACK_HEADER_SIZE + i * ACK_BLOCK_SIZE);
+        uint32_t end = ReadUInt32(buffer + ACK_HEADER_SIZE + i * ACK_BLOCK_SIZE + 4);
+        for (auto sit = _send_window.lower_bound(begin); (sit != _send_window.end()) && SequenceLess()(sit->first, end); ++sit)
+        {
+            if (!sit->second.sacked)
+            {
+                if (sit->second.retransmits == 0)
+                    UpdateRTT(timestamp - sit->second.timestamp);
+                sit->second.sacked = true;
+                ++acked;
+            }
+        }
+        if (!any_sacked || SequenceLess()(highest_sacked, end))
+            highest_sacked = end;
+        any_sacked = true;
+    }
+
+    // Leave the fast recovery when all packets sent before the loss are acknowledged
+    if (_recovery && !SequenceLess()(cumulative, _recovery_sequence))
+        _recovery = false;
+
+    // Grow the congestion window
+    for (size_t i = 0; i < acked; ++i)
+    {
+        if (_cwnd < _ssthresh)
+            _cwnd += 1.0;
+        else
+            _cwnd += 1.0 / _cwnd;
+    }
+
+    // Fast retransmit of packets with enough later packets acknowledged
+    if (any_sacked)
+    {
+        for (auto& packet : _send_window)
+        {
+            if (!SequenceLess()(packet.first, highest_sacked))
+                break;
+            if (packet.second.sacked || ((uint32_t)(highest_sacked - packet.first) <= DUPLICATE_THRESHOLD))
+                continue;
+
+            // Multiplicative decrease once per window of data
+            if (!_recovery)
+            {
+                _recovery = true;
+                _recovery_sequence = _send_sequence;
+                _ssthresh = std::max(_cwnd / 2.0, 2.0);
+                _cwnd = _ssthresh;
+            }
+            else if (packet.second.retransmits > 0)
+                continue;
+
+            Retransmit(packet.second, timestamp);
+        }
+    }
+
+    return true;
+}
+
+void RUDPChannel::Flush(uint64_t timestamp)
+{
+    // Send the acknowledgement
+    if (_ack_required)
+        SendAck();
+
+    // Retransmit the oldest packet on the retransmission timeout
+    for (auto& packet : _send_window)
+    {
+        if (packet.second.sacked)
+            continue;
+
+        if ((timestamp - packet.second.timestamp) >= _rto)
+        {
+            // Collapse the congestion window and back off the timer
+            _ssthresh = std::max((double)_send_window.size() / 2.0, 2.0);
+            _cwnd = CWND_MIN;
+            _rto = std::min(_rto * 2, RTO_MAX);
+            _recovery = false;
+
+            Retransmit(packet.second, timestamp);
+        }
+        break;
+    }
+
+    // Send new packets allowed by the congestion window
+    size_t in_flight = 0;
+    for (auto& packet : _send_window)
+        if (!packet.second.sacked)
+            ++in_flight;
+
+    while (!_send_queue.empty() && (in_flight < (size_t)_cwnd))
+    {
+        std::vector<uint8_t> datagram(std::move(_send_queue.front()));
+        _send_queue.pop_front();
+
+        uint32_t sequence = ReadUInt32(datagram.data() + 4);
+        auto& packet = _send_window[sequence];
+        packet.datagram = std::move(datagram);
+        packet.timestamp = timestamp;
+        packet.retransmits = 0;
+        packet.sacked = false;
+        ++in_flight;
+
+        // Update statistic
+        ++_messages_sent;
+
+        onSend(packet.datagram.data(), packet.datagram.size());
+    }
+}
+
+void RUDPChannel::UpdateRTT(uint64_t sample)
+{
+    // RFC 6298 round-trip time estimation
+    if (_srtt == 0)
+    {
+        _srtt = sample;
+        _rttvar = sample / 2;
+    }
+    else
+    {
+        uint64_t delta = (_srtt > sample) ? (_srtt - sample) : (sample - _srtt);
+        _rttvar = (3 * _rttvar + delta) / 4;
+        _srtt = (7 * _srtt + sample) / 8;
+    }
+
+    _rto = std::min(std::max(_srtt + 4 * _rttvar, RTO_MIN), RTO_MAX);
+}
+
+void RUDPChannel::Retransmit(Packet& packet, uint64_t timestamp)
+{
+    packet.timestamp = timestamp;
+    ++packet.retransmits;
+
+    // Update statistic
+    ++_messages_retransmitted;
+
+    onSend(packet.datagram.data(), packet.datagram.size());
+}
+
+void RUDPChannel::SendAck()
+{
+    _ack_required = false;
+
+    // Prepare the acknowledgement datagram with selective acknowledgement blocks
+    uint8_t datagram[ACK_HEADER_SIZE + ACK_MAX_BLOCKS * ACK_BLOCK_SIZE] = {};
+    datagram[0] = TYPE_ACK;
+    WriteUInt16(datagram + 2, _incarnation);
+    WriteUInt32(datagram + 4, _receive_sequence);
+
+    size_t blocks = 0;
+    auto it = _receive_buffer.begin();
+    while ((it != _receive_buffer.end()) && (blocks < ACK_MAX_BLOCKS))
+    {
+        uint32_t begin = it->first;
+        uint32_t end = begin + 1;
+        while ((++it != _receive_buffer.end()) && (it->first == end))
+            ++end;
+
+        WriteUInt32(datagram + ACK_HEADER_SIZE + blocks * ACK_BLOCK_SIZE, begin);
+        WriteUInt32(datagram + ACK_HEADER_SIZE + blocks * ACK_BLOCK_SIZE + 4, end);
+        ++blocks;
+    }
+    datagram[1] = (uint8_t)blocks;
+
+    onSend(datagram, ACK_HEADER_SIZE + blocks * ACK_BLOCK_SIZE);
+}
+
+} // namespace Asio
+} // namespace CppServer
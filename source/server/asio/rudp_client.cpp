@@ -0,0 +1,145 @@
+/*!
+    \file rudp_client.cpp
+    \brief Reliable UDP client implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/rudp_client.h"
+
+#include "time/timestamp.h"
+
+namespace CppServer {
+namespace Asio {
+
+bool RUDPClient::SendReliable(const void* buffer, size_t size)
+{
+    if (!IsConnected())
+        return false;
+
+    std::scoped_lock locker(_channel_lock);
+
+    // Check the pending messages limit
+    if ((option_max_pending() > 0) && (_channel.messages_pending() >= option_max_pending()))
+        return false;
+
+    if (!_channel.SendReliable(buffer, size))
+        return false;
+
+    // Send the message if the congestion window allows
+    _channel.Flush(CppCommon::Timestamp::nano());
+
+    return true;
+}
+
+bool RUDPClient::SendUnreliable(const void* buffer, size_t size)
+{
+    if (!IsConnected())
+        return false;
+
+    std::scoped_lock locker(_channel_lock);
+
+    return _channel.SendUnreliable(buffer, size);
+}
+
+void RUDPClient::onConnected()
+{
+    // Reset the channel state
+    {
+        std::scoped_lock locker(_channel_lock);
+        _channel.Reset();
+    }
+
+    // Start the flush timer (handler uses its own timer, the client timer could be replaced by the reconnect concurrently)
+    std::weak_ptr<UDPClient> weak(this->shared_from_this());
+    auto timer = std::make_shared<Timer>(service());
+    std::weak_ptr<Timer> weak_timer(timer);
+    timer->Setup([weak, weak_timer](bool canceled)
+    {
+        auto self = std::static_pointer_cast<RUDPClient>(weak.lock());
+        auto timer = weak_timer.lock();
+        if (self && timer)
+            self->Flush(timer, canceled);
+    }, option_flush_interval());
+    {
+        std::scoped_lock locker(_timer_lock);
+        _timer = timer;
+    }
+    timer->WaitAsync();
+
+    // Start receiving datagrams from the server
+    ReceiveAsync();
+}
+
+void RUDPClient::onDisconnected()
+{
+    // Stop the flush timer
+    std::shared_ptr<Timer> timer;
+    {
+        std::scoped_lock locker(_timer_lock);
+        timer.swap(_timer);
+    }
+    if (timer)
+        timer->Cancel();
+}
+
+void RUDPClient::onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size)
+{
+    // Process datagrams received from the connected server only
+    if (endpoint == this->endpoint())
+    {
+        {
+            std::scoped_lock locker(_channel_lock);
+
+            // Process the received datagram and acknowledge it immediately
+            uint64_t timestamp = CppCommon::Timestamp::nano();
+            if (_channel.Receive(buffer, size, timestamp))
+                _channel.Flush(timestamp);
+        }
+
+        // Call handlers outside the channel lock
+        Notify();
+    }
+
+    // Continue receiving datagrams from the server
+    ReceiveAsync();
+}
+
+void RUDPClient::Notify()
+{
+    _notifications.Dispatch(_channel_lock, [this](RUDPNotification& notification)
+    {
+        switch (notification.type)
+        {
+            case RUDPNotification::Type::Message:
+                onReceivedMessage(notification.message.data(), notification.message.size());
+                break;
+            case RUDPNotification::Type::Dropped:
+                onDroppedMessage(notification.message.data(), notification.message.size());
+                break;
+        }
+    });
+}
+
+void RUDPClient::Flush(const std::shared_ptr<Timer>& timer, bool canceled)
+{
+    if (canceled || !IsConnected())
+        return;
+
+    {
+        std::scoped_lock locker(_channel_lock);
+        _channel.Flush(CppCommon::Timestamp::nano());
+    }
+
+    // Restart the flush timer unless it was stopped or replaced by the client reconnect
+    std::scoped_lock locker(_timer_lock);
+    if (timer == _timer)
+    {
+        timer->Setup(option_flush_interval());
+        timer->WaitAsync();
+    }
+}
+
+} // namespace Asio
+} // namespace CppServer
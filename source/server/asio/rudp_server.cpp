@@ -0,0 +1,157 @@
+/*!
+    \file rudp_server.cpp
+    \brief Reliable UDP server implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/rudp_server.h"
+
+#include "time/timestamp.h"
+
+namespace CppServer {
+namespace Asio {
+
+bool RUDPSession::SendReliable(const void* buffer, size_t size)
+{
+    if (!IsConnected())
+        return false;
+
+    std::scoped_lock locker(_channel_lock);
+
+    // Check the pending messages limit
+    if ((option_max_pending() > 0) && (_channel.messages_pending() >= option_max_pending()))
+        return false;
+
+    if (!_channel.SendReliable(buffer, size))
+        return false;
+
+    // Send the message if the congestion window allows
+    _channel.Flush(CppCommon::Timestamp::nano());
+
+    return true;
+}
+
+bool RUDPSession::SendUnreliable(const void* buffer, size_t size)
+{
+    if (!IsConnected())
+        return false;
+
+    std::scoped_lock locker(_channel_lock);
+
+    return _channel.SendUnreliable(buffer, size);
+}
+
+void RUDPSession::onReceived(const void* buffer, size_t size)
+{
+    {
+        std::scoped_lock locker(_channel_lock);
+
+        // Process the received datagram and acknowledge it immediately
+        uint64_t timestamp = CppCommon::Timestamp::nano();
+        if (_channel.Receive(buffer, size, timestamp))
+            _channel.Flush(timestamp);
+    }
+
+    // Call handlers outside the channel lock
+    Notify();
+}
+
+void RUDPSession::Notify()
+{
+    _notifications.Dispatch(_channel_lock, [this](RUDPNotification& notification)
+    {
+        switch (notification.type)
+        {
+            case RUDPNotification::Type::Message:
+                onReceivedMessage(notification.message.data(), notification.message.size());
+                break;
+            case RUDPNotification::Type::Dropped:
+                onDroppedMessage(notification.message.data(), notification.message.size());
+                break;
+        }
+    });
+}
+
+void RUDPSession::Flush()
+{
+    std::scoped_lock locker(_channel_lock);
+
+    _channel.Flush(CppCommon::Timestamp::nano());
+}
+
+RUDPServer::RUDPServer(std::shared_ptr<Service> service, int port, InternetProtocol protocol)
+    : UDPServer(service, port, protocol)
+{
+    SetupSessions(true);
+}
+
+RUDPServer::RUDPServer(std::shared_ptr<Service> service, const std::string& address, int port)
+    : UDPServer(service, address, port)
+{
+    SetupSessions(true);
+}
+
+RUDPServer::RUDPServer(std::shared_ptr<Service> service, const asio::ip::udp::endpoint& endpoint)
+    : UDPServer(service, endpoint)
+{
+    SetupSessions(true);
+}
+
+void RUDPServer::onStarted()
+{
+    // Start the flush timer (handler uses its own timer, the server timer could be replaced by the restart concurrently)
+    std::weak_ptr<UDPServer> weak(this->shared_from_this());
+    auto timer = std::make_shared<Timer>(service());
+    std::weak_ptr<Timer> weak_timer(timer);
+    timer->Setup([weak, weak_timer](bool canceled)
+    {
+        auto self = std::static_pointer_cast<RUDPServer>(weak.lock());
+        auto timer = weak_timer.lock();
+        if (self && timer)
+            self->FlushAll(timer, canceled);
+    }, option_flush_interval());
+    {
+        std::scoped_lock locker(_timer_lock);
+        _timer = timer;
+    }
+    timer->WaitAsync();
+}
+
+void RUDPServer::onStopped()
+{
+    // Stop the flush timer
+    std::shared_ptr<Timer> timer;
+    {
+        std::scoped_lock locker(_timer_lock);
+        timer.swap(_timer);
+    }
+    if (timer)
+        timer->Cancel();
+}
+
+void RUDPServer::FlushAll(const std::shared_ptr<Timer>& timer, bool canceled)
+{
+    if (canceled || !IsStarted())
+        return;
+
+    // Flush all reliable sessions
+    for (auto& session : GetSessions())
+    {
+        auto rudp_session = std::dynamic_pointer_cast<RUDPSession>(session);
+        if (rudp_session)
+            rudp_session->Flush();
+    }
+
+    // Restart the flush timer unless it was stopped or replaced by the server restart
+    std::scoped_lock locker(_timer_lock);
+    if (timer == _timer)
+    {
+        timer->Setup(option_flush_interval());
+        timer->WaitAsync();
+    }
+}
+
+} // namespace Asio
+} // namespace CppServer
@@ -0,0 +1,369 @@
+/*!
+    \file sequenced_udp_client.cpp
+    \brief Sequenced multicast UDP client implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/sequenced_udp_client.h"
+
+#include <algorithm>
+
+namespace CppServer {
+namespace Asio {
+
+namespace {
+
+// Datagram types
+const uint8_t TYPE_DATA = 1;
+const uint8_t TYPE_NACK = 2;
+const uint8_t TYPE_LOST = 3;
+const uint8_t TYPE_HEARTBEAT = 4;
+
+// Datagram header sizes
+const size_t HEADER_SIZE = 12;
+const size_t NACK_HEADER_SIZE = 4;
+const size_t NACK_RANGE_SIZE = 16;
+const size_t NACK_MAX_RANGES = 16;
+
+void WriteUInt64(uint8_t* buffer, uint64_t value)
+{
+    for (int i = 7; i >= 0; --i)
+    {
+        buffer[i] = (uint8_t)value;
+        value >>= 8;
+    }
+}
+
+void WriteUInt16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0] = (uint8_t)(value >> 8);
+    buffer[1] = (uint8_t)value;
+}
+
+uint16_t ReadUInt16(const uint8_t* buffer)
+{
+    return (uint16_t)((buffer[0] << 8) | buffer[1]);
+}
+
+uint64_t ReadUInt64(const uint8_t* buffer)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i)
+        value = (value << 8) | buffer[i];
+    return value;
+}
+
+} // namespace
+
+void SequencedUDPClient::onConnected()
+{
+    // Reset the sequence state
+    {
+        std::scoped_lock locker(_sequence_lock);
+        _synchronized = false;
+        _session = 0;
+        _previous_session = 0;
+        _sequence = 0;
+        _highest = 0;
+        _reorder_buffer.clear();
+        _server_endpoint = option_server_endpoint();
+        _nack_retries = 0;
+        _notifications.Clear();
+    }
+
+    // Start the NACK timer (handler uses its own timer, the client timer could be replaced by the reconnect concurrently)
+    std::weak_ptr<UDPClient> weak(this->shared_from_this());
+    auto timer = std::make_shared<Timer>(service());
+    std::weak_ptr<Timer> weak_timer(timer);
+    timer->Setup([weak, weak_timer](bool canceled)
+    {
+        auto self = std::static_pointer_cast<SequencedUDPClient>(weak.lock());
+        auto timer = weak_timer.lock();
+        if (self && timer)
+            self->Recover(timer, canceled);
+    }, option_nack_interval());
+    {
+        std::scoped_lock locker(_timer_lock);
+        _timer = timer;
+    }
+    timer->WaitAsync();
+
+    // Start receiving datagrams from the server
+    ReceiveAsync();
+}
+
+void SequencedUDPClient::onDisconnected()
+{
+    // Stop the NACK timer
+    std::shared_ptr<Timer> timer;
+    {
+        std::scoped_lock locker(_timer_lock);
+        timer.swap(_timer);
+    }
+    if (timer)
+        timer->Cancel();
+}
+
+void SequencedUDPClient::onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)buffer;
+
+    if (size >= HEADER_SIZE)
+    {
+        std::scoped_lock locker(_sequence_lock);
+
+        // Drop datagrams from foreign endpoints and of the previous server session
+        if (CheckEndpoint(endpoint) && CheckSession(ReadUInt16(bytes + 2)))
+        {
+            switch (bytes[0])
+            {
+                case TYPE_DATA:
+                {
+                    uint64_t sequence = ReadUInt64(bytes + 4);
+
+                    if (!_synchronized)
+                        Synchronize(sequence);
+
+                    // Skip duplicate datagrams
+                    if (sequence < _sequence)
+                        break;
+
+                    // Skip messages which do not fit into the reorder buffer
+                    if ((sequence - _sequence) >= option_reorder_buffer())
+                        Skip(sequence - option_reorder_buffer() + 1);
+
+                    // Buffer the received message
+                    bool inserted = _reorder_buffer.emplace(sequence, std::vector<uint8_t>(bytes + HEADER_SIZE, bytes + size)).second;
+                    if (inserted && (sequence < _highest))
+                        ++_datagrams_recovered;
+
+                    // Detect a new gap
+                    bool gap = (sequence > _highest);
+                    _highest = std::max(_highest, sequence + 1);
+
+                    Deliver();
+
+                    // Request missed datagrams immediately
+                    if (gap)
+                        SendNack();
+                    break;
+                }
+                case TYPE_HEARTBEAT:
+                {
+                    uint64_t sequence = ReadUInt64(bytes + 4);
+
+                    if (!_synchronized)
+                        Synchronize(sequence);
+
+                    // Detect the loss of the last datagrams
+                    if (sequence > _highest)
+                    {
+                        _highest = sequence;
+                        SendNack();
+                    }
+                    break;
+                }
+                case TYPE_LOST:
+                {
+                    if (!_synchronized || (size < (HEADER_SIZE + 8)))
+                        break;
+
+                    // All missed messages before the end of the lost range cannot be recovered
+                    uint64_t end = ReadUInt64(bytes + HEADER_SIZE);
+                    if (end > _sequence)
+                        Skip(std::min(end, _highest));
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+    // Notify about delivered messages, gaps and server resets
+    Notify();
+
+    // Continue receiving datagrams from the server
+    ReceiveAsync();
+}
+
+bool SequencedUDPClient::CheckEndpoint(const asio::ip::udp::endpoint& endpoint)
+{
+    // Pin the sender of the first datagram as the server endpoint
+    if (_server_endpoint == asio::ip::udp::endpoint())
+        _server_endpoint = endpoint;
+
+    return (endpoint == _server_endpoint);
+}
+
+bool SequencedUDPClient::CheckSession(uint16_t session)
+{
+    // Remember the first seen server session
+    if (_session == 0)
+    {
+        _session = session;
+        return true;
+    }
+
+    if (session == _session)
+        return true;
+
+    // Ignore late datagrams of the previous server session
+    if (session == _previous_session)
+        return false;
+
+    // Server was restarted, so finish the previous session
+    if (_synchronized)
+        Skip(_highest);
+    _notifications.Push({ Notification::Type::Reset, 0, 0, std::vector<uint8_t>() });
+
+    // Synchronize with the sequence of the new session
+    _previous_session = _session;
+    _session = session;
+    _synchronized = false;
+    _sequence = 0;
+    _highest = 0;
+    _reorder_buffer.clear();
+    _nack_retries = 0;
+    ++_server_resets;
+    return true;
+}
+
+void SequencedUDPClient::Synchronize(uint64_t sequence)
+{
+    _synchronized = true;
+    _sequence = sequence;
+    _highest = sequence;
+}
+
+void SequencedUDPClient::Deliver()
+{
+    auto it = _reorder_buffer.begin();
+    while ((it != _reorder_buffer.end()) && (it->first == _sequence))
+    {
+        uint64_t sequence = it->first;
+        std::vector<uint8_t> message(std::move(it->second));
+        _reorder_buffer.erase(it);
+        ++_sequence;
+        _nack_retries = 0;
+        _notifications.Push({ Notification::Type::Message, sequence, sequence + 1, std::move(message) });
+        it = _reorder_buffer.begin();
+    }
+}
+
+void SequencedUDPClient::Skip(uint64_t end)
+{
+    while (_sequence < end)
+    {
+        // Deliver the buffered message
+        auto it = _reorder_buffer.begin();
+        if ((it != _reorder_buffer.end()) && (it->first == _sequence))
+        {
+            Deliver();
+            continue;
+        }
+
+        // Skip the lost messages up to the next buffered one
+        uint64_t begin = _sequence;
+        uint64_t gap_end = (it != _reorder_buffer.end()) ? std::min(it->first, end) : end;
+        _sequence = gap_end;
+        _datagrams_lost += gap_end - begin;
+        _notifications.Push({ Notification::Type::Gap, begin, gap_end, std::vector<uint8_t>() });
+    }
+
+    _highest = std::max(_highest, (uint64_t)_sequence);
+    _nack_retries = 0;
+
+    Deliver();
+}
+
+void SequencedUDPClient::SendNack()
+{
+    if ((_server_endpoint == asio::ip::udp::endpoint()) || (_sequence >= _highest))
+        return;
+
+    uint8_t datagram[NACK_HEADER_SIZE + NACK_MAX_RANGES * NACK_RANGE_SIZE] = {};
+    datagram[0] = TYPE_NACK;
+    WriteUInt16(datagram + 2, _session);
+
+    // Collect missed ranges between buffered messages
+    size_t ranges = 0;
+    uint64_t begin = _sequence;
+    for (auto it = _reorder_buffer.begin(); (it != _reorder_buffer.end()) && (ranges < NACK_MAX_RANGES); ++it)
+    {
+        if (it->first > begin)
+        {
+            WriteUInt64(datagram + NACK_HEADER_SIZE + ranges * NACK_RANGE_SIZE, begin);
+            WriteUInt64(datagram + NACK_HEADER_SIZE + ranges * NACK_RANGE_SIZE + 8, it->first);
+            ++ranges;
+        }
+        begin = it->first + 1;
+    }
+    if ((begin < _highest) && (ranges < NACK_MAX_RANGES))
+    {
+        WriteUInt64(datagram + NACK_HEADER_SIZE + ranges * NACK_RANGE_SIZE, begin);
+        WriteUInt64(datagram + NACK_HEADER_SIZE + ranges * NACK_RANGE_SIZE + 8, _highest);
+        ++ranges;
+    }
+    datagram[1] = (uint8_t)ranges;
+
+    if (ranges == 0)
+        return;
+
+    if (SendAsync(_server_endpoint, datagram, NACK_HEADER_SIZE + ranges * NACK_RANGE_SIZE))
+        ++_nacks_sent;
+}
+
+void SequencedUDPClient::Recover(const std::shared_ptr<Timer>& timer, bool canceled)
+{
+    if (canceled || !IsConnected())
+        return;
+
+    {
+        std::scoped_lock locker(_sequence_lock);
+
+        if (_sequence < _highest)
+        {
+            // Skip the oldest gap when all NACK retries are exhausted
+            if (++_nack_retries > option_nack_retries())
+                Skip(_reorder_buffer.empty() ? _highest : _reorder_buffer.begin()->first);
+            else
+                SendNack();
+        }
+    }
+
+    // Notify about skipped gaps
+    Notify();
+
+    // Restart the NACK timer unless it was stopped or replaced by the client reconnect
+    std::scoped_lock locker(_timer_lock);
+    if (timer == _timer)
+    {
+        timer->Setup(option_nack_interval());
+        timer->WaitAsync();
+    }
+}
+
+void SequencedUDPClient::Notify()
+{
+    _notifications.Dispatch(_sequence_lock, [this](Notification& notification)
+    {
+        switch (notification.type)
+        {
+            case Notification::Type::Message:
+                onReceivedMessage(notification.begin, notification.message.data(), notification.message.size());
+                break;
+            case Notification::Type::Gap:
+                onGap(notification.begin, notification.end);
+                break;
+            case Notification::Type::Reset:
+                onReset();
+                break;
+        }
+    });
+}
+
+} // namespace Asio
+} // namespace CppServer
@@ -0,0 +1,320 @@
+/*!
+    \file sequenced_udp_server.cpp
+    \brief Sequenced multicast UDP server implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/sequenced_udp_server.h"
+
+#include "time/timestamp.h"
+
+#include <algorithm>
+#include <random>
+
+namespace CppServer {
+namespace Asio {
+
+namespace {
+
+// Datagram types
+const uint8_t TYPE_DATA = 1;
+const uint8_t TYPE_NACK = 2;
+const uint8_t TYPE_LOST = 3;
+const uint8_t TYPE_HEARTBEAT = 4;
+
+// Datagram header sizes
+const size_t HEADER_SIZE = 12;
+const size_t NACK_HEADER_SIZE = 4;
+const size_t NACK_RANGE_SIZE = 16;
+
+void WriteUInt64(uint8_t* buffer, uint64_t value)
+{
+    for (int i = 7; i >= 0; --i)
+    {
+        buffer[i] = (uint8_t)value;
+        value >>= 8;
+    }
+}
+
+void WriteUInt16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0] = (uint8_t)(value >> 8);
+    buffer[1] = (uint8_t)value;
+}
+
+uint16_t ReadUInt16(const uint8_t* buffer)
+{
+    return (uint16_t)((buffer[0] << 8) | buffer[1]);
+}
+
+uint64_t ReadUInt64(const uint8_t* buffer)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i)
+        value = (value << 8) | buffer[i];
+    return value;
+}
+
+uint16_t GenerateSession()
+{
+    static thread_local std::mt19937 generator(std::random_device{}());
+    std::uniform_int_distribution<unsigned> distribution(1, 0xFFFF);
+    return (uint16_t)distribution(generator);
+}
+
+} // namespace
+
+const std::vector<uint8_t>& SequencedUDPServer::Prepare(const void* buffer, size_t size)
+{
+    uint64_t sequence = _sequence++;
+
+    // Reuse the ring slot of the oldest datagram
+    auto& datagram = _ring[sequence % _ring.size()];
+    datagram.resize(HEADER_SIZE + size);
+    datagram[0] = TYPE_DATA;
+    datagram[1] = 0;
+    WriteUInt16(datagram.data() + 2, _session);
+    WriteUInt64(datagram.data() + 4, sequence);
+    std::copy((const uint8_t*)buffer, (const uint8_t*)buffer + size, datagram.data() + HEADER_SIZE);
+
+    // Postpone the next heartbeat
+    _multicasted = true;
+
+    return datagram;
+}
+
+size_t SequencedUDPServer::Multicast(const void* buffer, size_t size)
+{
+    if (!IsStarted())
+        return 0;
+
+    std::scoped_lock locker(_ring_lock);
+
+    const auto& datagram = Prepare(buffer, size);
+    size_t sent = UDPServer::Multicast(datagram.data(), datagram.size());
+    return (sent > HEADER_SIZE) ? (sent - HEADER_SIZE) : 0;
+}
+
+size_t SequencedUDPServer::Multicast(const void* buffer, size_t size, const CppCommon::Timespan& timeout)
+{
+    if (!IsStarted())
+        return 0;
+
+    std::scoped_lock locker(_ring_lock);
+
+    const auto& datagram = Prepare(buffer, size);
+    size_t sent = UDPServer::Multicast(datagram.data(), datagram.size(), timeout);
+    return (sent > HEADER_SIZE) ? (sent - HEADER_SIZE) : 0;
+}
+
+bool SequencedUDPServer::MulticastAsync(const void* buffer, size_t size)
+{
+    if (!IsStarted())
+        return false;
+
+    std::scoped_lock locker(_ring_lock);
+
+    const auto& datagram = Prepare(buffer, size);
+    return UDPServer::MulticastAsync(datagram.data(), datagram.size());
+}
+
+void SequencedUDPServer::onStarted()
+{
+    // Start a new session with an empty retransmit ring
+    {
+        std::scoped_lock locker(_ring_lock);
+        _session = GenerateSession();
+        _sequence = 0;
+        _ring.clear();
+        _ring.resize(option_retransmit_ring());
+        _budgets.clear();
+    }
+
+    // Start the heartbeat timer (handler uses its own timer, the server timer could be replaced by the restart concurrently)
+    std::weak_ptr<UDPServer> weak(this->shared_from_this());
+    auto timer = std::make_shared<Timer>(service());
+    std::weak_ptr<Timer> weak_timer(timer);
+    timer->Setup([weak, weak_timer](bool canceled)
+    {
+        auto self = std::static_pointer_cast<SequencedUDPServer>(weak.lock());
+        auto timer = weak_timer.lock();
+        if (self && timer)
+            self->Heartbeat(timer, canceled);
+    }, option_heartbeat_interval());
+    {
+        std::scoped_lock locker(_timer_lock);
+        _timer = timer;
+    }
+    timer->WaitAsync();
+
+    // Start receiving NACK datagrams from clients
+    ReceiveAsync();
+}
+
+void SequencedUDPServer::onStopped()
+{
+    // Stop the heartbeat timer
+    std::shared_ptr<Timer> timer;
+    {
+        std::scoped_lock locker(_timer_lock);
+        timer.swap(_timer);
+    }
+    if (timer)
+        timer->Cancel();
+}
+
+void SequencedUDPServer::onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)buffer;
+
+    if ((size >= NACK_HEADER_SIZE) && (bytes[0] == TYPE_NACK) && (size >= (NACK_HEADER_SIZE + bytes[1] * NACK_RANGE_SIZE)) && (ReadUInt16(bytes + 2) == _session))
+    {
+        ++_nacks_received;
+
+        std::vector<std::vector<uint8_t>> datagrams;
+        std::vector<std::pair<uint64_t, uint64_t>> lost;
+        {
+            std::scoped_lock locker(_ring_lock);
+
+            // Datagrams available in the retransmit ring
+            uint64_t last = _sequence;
+            uint64_t first = (last > _ring.size()) ? (last - _ring.size()) : 0;
+
+            // Read requested ranges
+            std::vector<std::pair<uint64_t, uint64_t>> ranges;
+            for (size_t i = 0; i < bytes[1]; ++i)
+            {
+                uint64_t begin = ReadUInt64(bytes + NACK_HEADER_SIZE + i * NACK_RANGE_SIZE);
+                uint64_t end = std::min(ReadUInt64(bytes + NACK_HEADER_SIZE + i * NACK_RANGE_SIZE + 8), last);
+                if (begin < end)
+                    ranges.emplace_back(begin, end);
+            }
+
+            // Merge overlapping ranges, so each datagram is retransmitted once
+            std::sort(ranges.begin(), ranges.end());
+            size_t merged = 0;
+            for (size_t i = 0; i < ranges.size(); ++i)
+            {
+                if ((merged > 0) && (ranges[i].first <= ranges[merged - 1].second))
+                    ranges[merged - 1].second = std::max(ranges[merged - 1].second, ranges[i].second);
+                else
+                    ranges[merged++] = ranges[i];
+            }
+            ranges.resize(merged);
+
+            // Count datagrams to retransmit
+            size_t requested = 0;
+            for (auto& range : ranges)
+                if (range.second > first)
+                    requested += (size_t)std::min(range.second - std::max(range.first, first), (uint64_t)option_retransmit_limit());
+
+            // Limit datagrams retransmitted for the NACK and by the rate budget of the client endpoint
+            size_t allowed = TakeBudget(endpoint, std::min(requested, option_retransmit_limit()), CppCommon::Timestamp::nano());
+
+            for (auto& range : ranges)
+            {
+                uint64_t begin = range.first;
+                uint64_t end = range.second;
+
+                // Report datagrams which already left the retransmit ring
+                if (begin < first)
+                {
+                    lost.emplace_back(begin, std::min(end, first));
+                    begin = first;
+                }
+
+                // Copy datagrams to retransmit
+                for (uint64_t sequence = begin; (sequence < end) && (datagrams.size() < allowed); ++sequence)
+                    datagrams.emplace_back(_ring[sequence % _ring.size()]);
+            }
+        }
+
+        // Retransmit requested datagrams by unicast
+        for (auto& datagram : datagrams)
+            if (SendAsync(endpoint, datagram.data(), datagram.size()))
+                ++_datagrams_retransmitted;
+
+        // Notify the client about lost datagrams
+        for (auto& range : lost)
+        {
+            uint8_t datagram[HEADER_SIZE + 8] = {};
+            datagram[0] = TYPE_LOST;
+            WriteUInt16(datagram + 2, _session);
+            WriteUInt64(datagram + 4, range.first);
+            WriteUInt64(datagram + 12, range.second);
+            SendAsync(endpoint, datagram, sizeof(datagram));
+        }
+    }
+
+    // Continue receiving NACK datagrams from clients
+    ReceiveAsync();
+}
+
+size_t SequencedUDPServer::TakeBudget(const asio::ip::udp::endpoint& endpoint, size_t datagrams, uint64_t timestamp)
+{
+    if (option_retransmit_rate() == 0)
+        return datagrams;
+
+    double rate = (double)option_retransmit_rate();
+
+    // New client endpoint starts with the full budget of one second
+    auto it = _budgets.find(endpoint);
+    if (it == _budgets.end())
+        it = _budgets.emplace(endpoint, Budget{ rate, timestamp }).first;
+
+    // Refill the budget for the passed time
+    auto& budget = it->second;
+    if (timestamp > budget.timestamp)
+    {
+        budget.datagrams = std::min(rate, budget.datagrams + rate * (timestamp - budget.timestamp) / 1000000000.0);
+        budget.timestamp = timestamp;
+    }
+
+    size_t allowed = std::min(datagrams, (size_t)budget.datagrams);
+    budget.datagrams -= allowed;
+    return allowed;
+}
+
+void SequencedUDPServer::Heartbeat(const std::shared_ptr<Timer>& timer, bool canceled)
+{
+    if (canceled || !IsStarted())
+        return;
+
+    {
+        std::scoped_lock locker(_ring_lock);
+
+        // Forget client endpoints with the full retransmit rate budget
+        uint64_t timestamp = CppCommon::Timestamp::nano();
+        for (auto it = _budgets.begin(); it != _budgets.end();)
+        {
+            if ((timestamp > it->second.timestamp) && ((timestamp - it->second.timestamp) >= 1000000000))
+                it = _budgets.erase(it);
+            else
+                ++it;
+        }
+
+        // Multicast the next sequence number if the server was idle
+        // (under the retransmit ring lock, so it never overtakes the datagram of the same sequence)
+        if (!_multicasted.exchange(false) && (multicast_endpoint() != asio::ip::udp::endpoint()))
+        {
+            uint8_t datagram[HEADER_SIZE] = {};
+            datagram[0] = TYPE_HEARTBEAT;
+            WriteUInt16(datagram + 2, _session);
+            WriteUInt64(datagram + 4, _sequence);
+            UDPServer::MulticastAsync(datagram, sizeof(datagram));
+        }
+    }
+
+    // Restart the heartbeat timer unless it was stopped or replaced by the server restart
+    std::scoped_lock locker(_timer_lock);
+    if (timer == _timer)
+    {
+        timer->Setup(option_heartbeat_interval());
+        timer->WaitAsync();
+    }
+}
+
+} // namespace Asio
+} // namespace CppServer
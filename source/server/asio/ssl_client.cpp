@@ -9,6 +9,7 @@
 #include "server/asio/ssl_client.h"
 
 #include <mutex>
+#include <random>
 #include <vector>
 
 namespace CppServer {
@@ -43,7 +44,21 @@ public:
           _sending(false),
           _send_buffer_flush_offset(0),
           _option_keep_alive(false),
-          _option_no_delay(false)
+          _option_no_delay(false),
+          _option_happy_eyeballs(false),
+          _option_connection_attempt_delay(CppCommon::Timespan::milliseconds(250)),
+          _option_connect_timeout(CppCommon::Timespan::zero()),
+          _option_handshake_timeout(CppCommon::Timespan::zero()),
+          _option_reconnect(false),
+          _option_reconnect_delay(CppCommon::Timespan::seconds(1)),
+          _option_reconnect_max_delay(CppCommon::Timespan::seconds(30)),
+          _option_reconnect_attempts(0),
+          _option_reconnect_timeout(CppCommon::Timespan::zero()),
+          _option_reconnect_preserve(false),
+          _reconnect(std::make_shared<ReconnectState>()),
+          _connect_timer(*_io_service),
+          _resolve_attempt(0),
+          _resolve_id(0)
     {
         assert((service != nullptr) && "Asio service is invalid!");
         if (service == nullptr)
@@ -78,7 +93,21 @@ public:
           _sending(false),
           _send_buffer_flush_offset(0),
           _option_keep_alive(false),
-          _option_no_delay(false)
+          _option_no_delay(false),
+          _option_happy_eyeballs(false),
+          _option_connection_attempt_delay(CppCommon::Timespan::milliseconds(250)),
+          _option_connect_timeout(CppCommon::Timespan::zero()),
+          _option_handshake_timeout(CppCommon::Timespan::zero()),
+          _option_reconnect(false),
+          _option_reconnect_delay(CppCommon::Timespan::seconds(1)),
+          _option_reconnect_max_delay(CppCommon::Timespan::seconds(30)),
+          _option_reconnect_attempts(0),
+          _option_reconnect_timeout(CppCommon::Timespan::zero()),
+          _option_reconnect_preserve(false),
+          _reconnect(std::make_shared<ReconnectState>()),
+          _connect_timer(*_io_service),
+          _resolve_attempt(0),
+          _resolve_id(0)
     {
         assert((service != nullptr) && "Asio service is invalid!");
         if (service == nullptr)
@@ -113,7 +142,21 @@ public:
           _sending(false),
           _send_buffer_flush_offset(0),
           _option_keep_alive(false),
-          _option_no_delay(false)
+          _option_no_delay(false),
+          _option_happy_eyeballs(false),
+          _option_connection_attempt_delay(CppCommon::Timespan::milliseconds(250)),
+          _option_connect_timeout(CppCommon::Timespan::zero()),
+          _option_handshake_timeout(CppCommon::Timespan::zero()),
+          _option_reconnect(false),
+          _option_reconnect_delay(CppCommon::Timespan::seconds(1)),
+          _option_reconnect_max_delay(CppCommon::Timespan::seconds(30)),
+          _option_reconnect_attempts(0),
+          _option_reconnect_timeout(CppCommon::Timespan::zero()),
+          _option_reconnect_preserve(false),
+          _reconnect(std::make_shared<ReconnectState>()),
+          _connect_timer(*_io_service),
+          _resolve_attempt(0),
+          _resolve_id(0)
     {
         assert((service != nullptr) && "Asio service is invalid!");
         if (service == nullptr)
@@ -144,8 +187,29 @@ public:
     uint64_t& bytes_sent() noexcept { return _bytes_sent; }
     uint64_t& bytes_received() noexcept { return _bytes_received; }
 
+    // Automatic reconnect state shared by all implementations of the client
+    struct ReconnectState
+    {
+        std::shared_ptr<TCPResolver> resolver;
+        std::shared_ptr<Timer> timer;
+        std::atomic<bool> stopped{true};
+        std::atomic<size_t> attempts{0};
+    };
+
+    std::shared_ptr<ReconnectState>& reconnect() noexcept { return _reconnect; }
+
     bool option_keep_alive() const noexcept { return _option_keep_alive; }
     bool option_no_delay() const noexcept { return _option_no_delay; }
+    bool option_happy_eyeballs() const noexcept { return _option_happy_eyeballs; }
+    const CppCommon::Timespan& option_connection_attempt_delay() const noexcept { return _option_connection_attempt_delay; }
+    const CppCommon::Timespan& option_connect_timeout() const noexcept { return _option_connect_timeout; }
+    const CppCommon::Timespan& option_handshake_timeout() const noexcept { return _option_handshake_timeout; }
+    bool option_reconnect() const noexcept { return _option_reconnect; }
+    const CppCommon::Timespan& option_reconnect_delay() const noexcept { return _option_reconnect_delay; }
+    const CppCommon::Timespan& option_reconnect_max_delay() const noexcept { return _option_reconnect_max_delay; }
+    size_t option_reconnect_attempts() const noexcept { return _option_reconnect_attempts; }
+    const CppCommon::Timespan& option_reconnect_timeout() const noexcept { return _option_reconnect_timeout; }
+    bool option_reconnect_preserve() const noexcept { return _option_reconnect_preserve; }
 
     size_t option_receive_buffer_size() const
     {
@@ -172,6 +236,10 @@ public:
         if (IsConnected() || IsHandshaked() || _resolving || _connecting || _handshaking)
             return false;
 
+        // Resume the automatic reconnect
+        _reconnect->stopped = false;
+        _reconnect->resolver.reset();
+
         asio::error_code ec;
 
         // Connect to the server
@@ -219,12 +287,13 @@ public:
         {
             // Disconnect in case of the bad handshake
             SendError(ec);
-            Disconnect();
+            Disconnect(false);
             return false;
         }
 
         // Update the handshaked flag
         _handshaked = true;
+        _reconnect->attempts = 0;
 
         // Call the client handshaked handler
         onHandshaked();
@@ -244,11 +313,14 @@ public:
         if (IsConnected() || IsHandshaked() || _resolving || _connecting || _handshaking)
             return false;
 
+        // Resume the automatic reconnect
+        _reconnect->stopped = false;
+        _reconnect->resolver = resolver;
+
         asio::error_code ec;
 
         // Resolve the server endpoint
-        asio::ip::tcp::resolver::query query(_address, (_scheme.empty() ? std::to_string(_port) : _scheme));
-        auto endpoints = resolver->resolver().resolve(query, ec);
+        auto endpoints = resolver->Resolve(_address, (_scheme.empty() ? std::to_string(_port) : _scheme), ec);
 
         // Disconnect on error
         if (ec)
@@ -305,12 +377,13 @@ public:
         {
             // Disconnect in case of the bad handshake
             SendError(ec);
-            Disconnect();
+            Disconnect(false);
             return false;
         }
 
         // Update the handshaked flag
         _handshaked = true;
+        _reconnect->attempts = 0;
 
         // Call the client handshaked handler
         onHandshaked();
@@ -322,8 +395,12 @@ public:
         return true;
     }
 
-    bool Disconnect()
+    bool Disconnect(bool reconnect)
     {
+        // Stop the automatic reconnect if the client is disconnected by the user
+        if (!reconnect)
+            StopReconnect();
+
         if (!IsConnected() || _resolving || _connecting || _handshaking)
         {
             // Unlink the client
@@ -332,6 +409,7 @@ public:
         }
 
         auto self(this->shared_from_this());
+        auto client(_client);
 
         // Close the client socket
         socket().close();
@@ -339,6 +417,10 @@ public:
         // Call the client reset handler
         onReset();
 
+        // Preserve pending data for reconnect in the new client implementation
+        if (reconnect && client && option_reconnect() && option_reconnect_preserve() && !_reconnect->stopped)
+            client->_pimpl->PreserveBuffers(*this);
+
         // Update the handshaked flag
         _handshaking = false;
         _handshaked = false;
@@ -358,12 +440,23 @@ public:
         // Call the client disconnected handler
         onDisconnected();
 
+        // Try to reconnect the lost connection
+        if (reconnect && client)
+            client->_pimpl->TryReconnect(client);
+
         // Unlink the client
         _client = nullptr;
 
         return true;
     }
 
+    void StopReconnect()
+    {
+        // Pending reconnect timer will find the reconnect stopped
+        _reconnect->stopped = true;
+        _reconnect->attempts = 0;
+    }
+
     bool ConnectAsync(std::shared_ptr<SSLClient> client)
     {
         // Link the client
@@ -372,6 +465,9 @@ public:
         if (IsConnected() || IsHandshaked() || _resolving || _connecting || _handshaking)
             return false;
 
+        // Resume the automatic reconnect
+        _reconnect->stopped = false;
+
         // Post the connect handler
         auto self(this->shared_from_this());
         auto connect_handler = make_alloc_handler(_connect_storage, [this, self]()
@@ -379,6 +475,11 @@ public:
             if (IsConnected() || IsHandshaked() || _resolving || _connecting || _handshaking)
                 return;
 
+            _reconnect->resolver.reset();
+
+            // Limit the connect attempt with the connect timeout
+            StartConnectTimer(option_connect_timeout());
+
             // Async connect with the connect handler
             _connecting = true;
             auto async_connect_handler = make_alloc_handler(_connect_storage, [this, self](std::error_code ec1)
@@ -414,12 +515,18 @@ public:
                     // Call the client connected handler
                     onConnected();
 
+                    // Limit the SSL handshake with the handshake timeout
+                    StartConnectTimer(option_handshake_timeout());
+
                     // Async SSL handshake with the handshake handler
                     _handshaking = true;
                     auto async_handshake_handler = make_alloc_handler(_connect_storage, [this, self](std::error_code ec2)
                     {
                         _handshaking = false;
 
+                        // Cancel the connect attempt deadline
+                        _connect_timer.cancel();
+
                         if (IsHandshaked())
                             return;
 
@@ -427,13 +534,16 @@ public:
                         {
                             // Update the handshaked flag
                             _handshaked = true;
+                            _reconnect->attempts = 0;
 
                             // Call the client handshaked handler
                             onHandshaked();
 
-                            // Call the empty send buffer handler
+                            // Call the empty send buffer handler or send data preserved for reconnect
                             if (_send_buffer_main.empty())
                                 onEmpty();
+                            else
+                                TrySend();
 
                             // Try to receive something from the server
                             TryReceive();
@@ -452,10 +562,16 @@ public:
                 }
                 else
                 {
+                    // Cancel the connect attempt deadline
+                    _connect_timer.cancel();
+
                     SendError(ec1);
 
                     // Call the client disconnected handler
                     onDisconnected();
+
+                    // Try to reconnect after the failed connect
+                    TryReconnect(_client);
                 }
             });
             if (_strand_required)
@@ -479,6 +595,9 @@ public:
         if (IsConnected() || IsHandshaked() || _resolving || _connecting || _handshaking)
             return false;
 
+        // Resume the automatic reconnect
+        _reconnect->stopped = false;
+
         // Post the connect handler
         auto self(this->shared_from_this());
         auto connect_handler = make_alloc_handler(_connect_storage, [this, self, resolver]()
@@ -486,10 +605,20 @@ public:
             if (IsConnected() || IsHandshaked() || _resolving || _connecting || _handshaking)
                 return;
 
+            _reconnect->resolver = resolver;
+
+            // Limit the connect attempt with the connect timeout
+            StartConnectTimer(option_connect_timeout());
+
             // Async resolve with the resolve handler
             _resolving = true;
-            auto async_resolve_handler = make_alloc_handler(_connect_storage, [this, self](std::error_code ec1, asio::ip::tcp::resolver::results_type endpoints)
+            size_t attempt = ++_resolve_attempt;
+            auto async_resolve_handler = make_alloc_handler(_connect_storage, [this, self, attempt](std::error_code ec1, asio::ip::tcp::resolver::results_type endpoints)
             {
+                // Resolve attempt was already failed by timeout
+                if (attempt != _resolve_attempt)
+                    return;
+
                 _resolving = false;
 
                 if (IsConnected() || IsHandshaked() || _resolving || _connecting || _handshaking)
@@ -502,6 +631,7 @@ public:
                     auto async_connect_handler = make_alloc_handler(_connect_storage, [this, self](std::error_code ec2, const asio::ip::tcp::endpoint& endpoint)
                     {
                         _connecting = false;
+                        _connector.reset();
 
                         if (IsConnected() || IsHandshaked() || _resolving || _connecting || _handshaking)
                             return;
@@ -535,12 +665,18 @@ public:
                             // Call the client connected handler
                             onConnected();
 
+                            // Limit the SSL handshake with the handshake timeout
+                            StartConnectTimer(option_handshake_timeout());
+
                             // Async SSL handshake with the handshake handler
                             _handshaking = true;
                             auto async_handshake_handler = make_alloc_handler(_connect_storage, [this, self](std::error_code ec3)
                             {
                                 _handshaking = false;
 
+                                // Cancel the connect attempt deadline
+                                _connect_timer.cancel();
+
                                 if (IsHandshaked())
                                     return;
 
@@ -548,13 +684,16 @@ public:
                                 {
                                     // Update the handshaked flag
                                     _handshaked = true;
+                                    _reconnect->attempts = 0;
 
                                     // Call the client handshaked handler
                                     onHandshaked();
 
-                                    // Call the empty send buffer handler
+                                    // Call the empty send buffer handler or send data preserved for reconnect
                                     if (_send_buffer_main.empty())
                                         onEmpty();
+                                    else
+                                        TrySend();
 
                                     // Try to receive something from the server
                                     TryReceive();
@@ -573,32 +712,51 @@ public:
                         }
                         else
                         {
+                            // Cancel the connect attempt deadline
+                            _connect_timer.cancel();
+
                             SendError(ec2);
 
                             // Call the client disconnected handler
                             onDisconnected();
+
+                            // Try to reconnect after the failed connect
+                            TryReconnect(_client);
                         }
                     });
-                    if (_strand_required)
+                    if (option_happy_eyeballs() && (endpoints.size() > 1))
+                    {
+                        // Race connection attempts to the resolved endpoints
+                        _connector = std::make_shared<TCPConnector>(_io_service, _strand, _strand_required, _stream.next_layer(), option_connection_attempt_delay());
+                        _connector->ConnectAsync(endpoints, async_connect_handler);
+                    }
+                    else if (_strand_required)
                         asio::async_connect(socket(), endpoints, bind_executor(_strand, async_connect_handler));
                     else
                         asio::async_connect(socket(), endpoints, async_connect_handler);
                 }
                 else
                 {
+                    // Cancel the connect attempt deadline
+                    _connect_timer.cancel();
+
                     SendError(ec1);
 
                     // Call the client disconnected handler
                     onDisconnected();
+
+                    // Try to reconnect after the failed resolve
+                    TryReconnect(_client);
                 }
             });
 
             // Resolve the server endpoint
-            asio::ip::tcp::resolver::query query(_address, (_scheme.empty() ? std::to_string(_port) : _scheme));
+            std::string service_name = (_scheme.empty() ? std::to_string(_port) : _scheme);
+            _resolve_resolver = resolver;
             if (_strand_required)
-                resolver->resolver().async_resolve(query, bind_executor(_strand, async_resolve_handler));
+                _resolve_id = resolver->ResolveAsync(_address, service_name, bind_executor(_strand, async_resolve_handler));
             else
-                resolver->resolver().async_resolve(query, async_resolve_handler);
+                _resolve_id = resolver->ResolveAsync(_address, service_name, async_resolve_handler);
         });
         if (_strand_required)
             _strand.post(connect_handler);
@@ -619,7 +777,7 @@ public:
 
         // Dispatch or post the disconnect handler
         auto self(this->shared_from_this());
-        auto disconnect_handler = make_alloc_handler(_connect_storage, [this, self]() { Disconnect(); });
+        auto disconnect_handler = make_alloc_handler(_connect_storage, [this, self]() { Disconnect(true); });
         if (_strand_required)
         {
             if (dispatch)
@@ -667,7 +825,7 @@ public:
         if (ec)
         {
             SendError(ec);
-            Disconnect();
+            Disconnect(true);
         }
 
         return sent;
@@ -730,7 +888,7 @@ public:
         if (error && (error != asio::error::timed_out))
         {
             SendError(error);
-            Disconnect();
+            Disconnect(true);
         }
 
         return sent;
@@ -742,7 +900,8 @@ public:
         if (buffer == nullptr)
             return false;
 
-        if (!IsHandshaked())
+        // Data could be queued while the client is reconnecting if the pending data is preserved
+        if (!IsHandshaked() && (!option_reconnect() || !option_reconnect_preserve() || _reconnect->stopped))
             return false;
 
         if (size == 0)
@@ -766,6 +925,10 @@ public:
                 return true;
         }
 
+        // Send queued data after reconnect
+        if (!IsHandshaked())
+            return true;
+
         // Dispatch the send handler
         auto self(this->shared_from_this());
         auto send_handler = [this, self]()
@@ -810,7 +973,7 @@ public:
         if (ec)
         {
             SendError(ec);
-            Disconnect();
+            Disconnect(true);
         }
 
         return received;
@@ -880,7 +1043,7 @@ public:
         if (error && (error != asio::error::timed_out))
         {
             SendError(error);
-            Disconnect();
+            Disconnect(true);
         }
 
         return received;
@@ -901,6 +1064,16 @@ public:
 
     void SetupKeepAlive(bool enable) noexcept { _option_keep_alive = enable; }
     void SetupNoDelay(bool enable) noexcept { _option_no_delay = enable; }
+    void SetupHappyEyeballs(bool enable) noexcept { _option_happy_eyeballs = enable; }
+    void SetupConnectionAttemptDelay(const CppCommon::Timespan& delay) noexcept { _option_connection_attempt_delay = delay; }
+    void SetupConnectTimeout(const CppCommon::Timespan& timeout) noexcept { _option_connect_timeout = timeout; }
+    void SetupHandshakeTimeout(const CppCommon::Timespan& timeout) noexcept { _option_handshake_timeout = timeout; }
+    void SetupReconnect(bool enable) noexcept { _option_reconnect = enable; }
+    void SetupReconnectDelay(const CppCommon::Timespan& delay) noexcept { _option_reconnect_delay = delay; }
+    void SetupReconnectMaxDelay(const CppCommon::Timespan& delay) noexcept { _option_reconnect_max_delay = delay; }
+    void SetupReconnectAttempts(size_t attempts) noexcept { _option_reconnect_attempts = attempts; }
+    void SetupReconnectTimeout(const CppCommon::Timespan& timeout) noexcept { _option_reconnect_timeout = timeout; }
+    void SetupReconnectPreserve(bool enable) noexcept { _option_reconnect_preserve = enable; }
 
     void SetupReceiveBufferSize(size_t size)
     {
@@ -969,6 +1142,26 @@ private:
     // Options
     bool _option_keep_alive;
     bool _option_no_delay;
+    bool _option_happy_eyeballs;
+    CppCommon::Timespan _option_connection_attempt_delay;
+    CppCommon::Timespan _option_connect_timeout;
+    CppCommon::Timespan _option_handshake_timeout;
+    bool _option_reconnect;
+    CppCommon::Timespan _option_reconnect_delay;
+    CppCommon::Timespan _option_reconnect_max_delay;
+    size_t _option_reconnect_attempts;
+    CppCommon::Timespan _option_reconnect_timeout;
+    bool _option_reconnect_preserve;
+    // Automatic reconnect
+    std::shared_ptr<ReconnectState> _reconnect;
+    // Connect attempt deadline
+    asio::system_timer _connect_timer;
+    std::shared_ptr<TCPConnector> _connector;
+    // Resolve attempt identifier, results of the timed out resolve attempts are ignored
+    size_t _resolve_attempt;
+    // Resolver and waiter Id of the pending resolve attempt
+    std::shared_ptr<TCPResolver> _resolve_resolver;
+    uint64_t _resolve_id;
 
     void TryReceive()
     {
@@ -1110,6 +1303,135 @@ private:
         }
     }
 
+    void PreserveBuffers(Impl& impl)
+    {
+        std::scoped_lock locker(_send_lock, impl._send_lock);
+
+        // Keep the unsent part of the flush buffer and the main buffer before data queued while reconnecting
+        _send_buffer_main.insert(_send_buffer_main.begin(), impl._send_buffer_main.begin(), impl._send_buffer_main.end());
+        _send_buffer_main.insert(_send_buffer_main.begin(), impl._send_buffer_flush.begin() + impl._send_buffer_flush_offset, impl._send_buffer_flush.end());
+
+        // Update statistic
+        _bytes_pending = _send_buffer_main.size();
+    }
+
+    void TryReconnect(std::shared_ptr<SSLClient> client)
+    {
+        if (!client || !option_reconnect() || _reconnect->stopped)
+            return;
+
+        // Stop reconnecting when all reconnect attempts failed
+        if ((option_reconnect_attempts() > 0) && (_reconnect->attempts >= option_reconnect_attempts()))
+        {
+            StopReconnect();
+            ClearBuffers();
+            return;
+        }
+
+        // Exponential backoff limited by the maximal delay
+        int64_t delay = std::max(option_reconnect_delay().total(), (int64_t)1);
+        int64_t max_delay = std::max(option_reconnect_max_delay().total(), delay);
+        for (size_t i = 0; (i < _reconnect->attempts) && (delay < max_delay); ++i)
+            delay *= 2;
+        delay = std::min(delay, max_delay);
+        ++_reconnect->attempts;
+
+        // Randomize the delay between its half and its full value
+        thread_local std::mt19937_64 generator(std::random_device{}());
+        std::uniform_int_distribution<int64_t> distribution(delay / 2, delay);
+        CppCommon::Timespan timespan = CppCommon::Timespan::nanoseconds(distribution(generator));
+
+        // Create the reconnect timer which does not prolong the client lifetime
+        if (!_reconnect->timer)
+        {
+            std::weak_ptr<SSLClient> weak_client = client;
+            auto timer_handler = [weak_client](bool canceled)
+            {
+                if (canceled)
+                    return;
+
+                auto client = weak_client.lock();
+                if (!client)
+                    return;
+
+                // Reconnect with the current client implementation
+                auto reconnect = client->_pimpl->reconnect();
+                if (reconnect->stopped)
+                    return;
+
+                if (reconnect->resolver)
+                    client->ConnectAsync(reconnect->resolver);
+                else
+                    client->ConnectAsync();
+            };
+            _reconnect->timer = std::make_shared<Timer>(_service, timer_handler);
+        }
+
+        // Wait for the reconnect delay
+        if (_reconnect->timer->Setup(timespan))
+            _reconnect->timer->WaitAsync();
+    }
+
+    void StartConnectTimer(const CppCommon::Timespan& timeout)
+    {
+        // Use the shortest of the given timeout and the reconnect timeout
+        int64_t deadline = timeout.total();
+        if (option_reconnect() && (option_reconnect_timeout().total() > 0) && ((deadline <= 0) || (option_reconnect_timeout().total() < deadline)))
+            deadline = option_reconnect_timeout().total();
+        if (deadline <= 0)
+        {
+            // Cancel the deadline of the previous connect stage
+            _connect_timer.cancel();
+            return;
+        }
+
+        // Async wait for the connect attempt deadline
+        auto self(this->shared_from_this());
+        auto async_wait_handler = [this, self](const asio::error_code& ec)
+        {
+            if (!ec)
+                AbortConnect();
+        };
+        _connect_timer.expires_from_now(CppCommon::Timespan::nanoseconds(deadline).chrono());
+        if (_strand_required)
+            _connect_timer.async_wait(bind_executor(_strand, async_wait_handler));
+        else
+            _connect_timer.async_wait(async_wait_handler);
+    }
+
+    void AbortConnect()
+    {
+        if (!_resolving && !_connecting && !_handshaking)
+            return;
+
+        SendError(asio::error::timed_out);
+
+        // Fail the connect attempt immediately, the pending resolve result will be ignored
+        if (_resolving)
+        {
+            ++_resolve_attempt;
+            _resolving = false;
+
+            // Release the resolve waiter of the resolver
+            if (_resolve_resolver)
+                _resolve_resolver->Cancel(_resolve_id);
+            _resolve_resolver.reset();
+
+            // Call the client disconnected handler
+            onDisconnected();
+
+            // Try to reconnect after the failed resolve
+            TryReconnect(_client);
+            return;
+        }
+
+        // Cancel the connect attempt or SSL handshake
+        if (_connector)
+            _connector->Cancel();
+        asio::error_code ignore;
+        socket().close(ignore);
+    }
+
     void SendError(std::error_code ec)
     {
         // Skip Asio disconnect errors
@@ -1236,6 +1558,56 @@ bool SSLClient::option_no_delay() const noexcept
     return _pimpl->option_no_delay();
 }
 
+bool SSLClient::option_happy_eyeballs() const noexcept
+{
+    return _pimpl->option_happy_eyeballs();
+}
+
+const CppCommon::Timespan& SSLClient::option_connection_attempt_delay() const noexcept
+{
+    return _pimpl->option_connection_attempt_delay();
+}
+
+const CppCommon::Timespan& SSLClient::option_connect_timeout() const noexcept
+{
+    return _pimpl->option_connect_timeout();
+}
+
+const CppCommon::Timespan& SSLClient::option_handshake_timeout() const noexcept
+{
+    return _pimpl->option_handshake_timeout();
+}
+
+bool SSLClient::option_reconnect() const noexcept
+{
+    return _pimpl->option_reconnect();
+}
+
+const CppCommon::Timespan& SSLClient::option_reconnect_delay() const noexcept
+{
+    return _pimpl->option_reconnect_delay();
+}
+
+const CppCommon::Timespan& SSLClient::option_reconnect_max_delay() const noexcept
+{
+    return _pimpl->option_reconnect_max_delay();
+}
+
+size_t SSLClient::option_reconnect_attempts() const noexcept
+{
+    return _pimpl->option_reconnect_attempts();
+}
+
+const CppCommon::Timespan& SSLClient::option_reconnect_timeout() const noexcept
+{
+    return _pimpl->option_reconnect_timeout();
+}
+
+bool SSLClient::option_reconnect_preserve() const noexcept
+{
+    return _pimpl->option_reconnect_preserve();
+}
+
 size_t SSLClient::option_receive_buffer_size() const
 {
     return _pimpl->option_receive_buffer_size();
@@ -1246,6 +1618,14 @@ size_t SSLClient::option_send_buffer_size() const
     return _pimpl->option_send_buffer_size();
 }
 
+std::string SSLClient::alpn_protocol()
+{
+    const unsigned char* protocol = nullptr;
+    unsigned int size = 0;
+    SSL_get0_alpn_selected(stream().native_handle(), &protocol, &size);
+    return (protocol != nullptr) ? std::string((const char*)protocol, size) : std::string();
+}
+
 bool SSLClient::IsConnected() const noexcept
 {
     return _pimpl->IsConnected();
@@ -1270,7 +1650,7 @@ bool SSLClient::Connect(std::shared_ptr<TCPResolver> resolver)
 
 bool SSLClient::Disconnect()
 {
-    return _pimpl->Disconnect();
+    return _pimpl->Disconnect(false);
 }
 
 bool SSLClient::Reconnect()
@@ -1293,6 +1673,14 @@ bool SSLClient::ConnectAsync(std::shared_ptr<TCPResolver> resolver)
     return _pimpl->ConnectAsync(self, resolver);
 }
 
+bool SSLClient::DisconnectAsync()
+{
+    // Stop the automatic reconnect
+    _pimpl->StopReconnect();
+
+    return DisconnectAsync(false);
+}
+
 bool SSLClient::DisconnectAsync(bool dispatch)
 {
     return _pimpl->DisconnectAsync(dispatch);
@@ -1359,6 +1747,56 @@ void SSLClient::SetupNoDelay(bool enable) noexcept
     return _pimpl->SetupNoDelay(enable);
 }
 
+void SSLClient::SetupHappyEyeballs(bool enable) noexcept
+{
+    return _pimpl->SetupHappyEyeballs(enable);
+}
+
+void SSLClient::SetupConnectionAttemptDelay(const CppCommon::Timespan& delay) noexcept
+{
+    return _pimpl->SetupConnectionAttemptDelay(delay);
+}
+
+void SSLClient::SetupConnectTimeout(const CppCommon::Timespan& timeout) noexcept
+{
+    return _pimpl->SetupConnectTimeout(timeout);
+}
+
+void SSLClient::SetupHandshakeTimeout(const CppCommon::Timespan& timeout) noexcept
+{
+    return _pimpl->SetupHandshakeTimeout(timeout);
+}
+
+void SSLClient::SetupReconnect(bool enable) noexcept
+{
+    return _pimpl->SetupReconnect(enable);
+}
+
+void SSLClient::SetupReconnectDelay(const CppCommon::Timespan& delay) noexcept
+{
+    return _pimpl->SetupReconnectDelay(delay);
+}
+
+void SSLClient::SetupReconnectMaxDelay(const CppCommon::Timespan& delay) noexcept
+{
+    return _pimpl->SetupReconnectMaxDelay(delay);
+}
+
+void SSLClient::SetupReconnectAttempts(size_t attempts) noexcept
+{
+    return _pimpl->SetupReconnectAttempts(attempts);
+}
+
+void SSLClient::SetupReconnectTimeout(const CppCommon::Timespan& timeout) noexcept
+{
+    return _pimpl->SetupReconnectTimeout(timeout);
+}
+
+void SSLClient::SetupReconnectPreserve(bool enable) noexcept
+{
+    return _pimpl->SetupReconnectPreserve(enable);
+}
+
 void SSLClient::SetupReceiveBufferSize(size_t size)
 {
     return _pimpl->SetupReceiveBufferSize(size);
@@ -1375,11 +1813,33 @@ void SSLClient::onReset()
     size_t bytes_received = _pimpl->bytes_received();
     bool option_keep_alive = _pimpl->option_keep_alive();
     bool option_no_delay = _pimpl->option_no_delay();
+    bool option_happy_eyeballs = _pimpl->option_happy_eyeballs();
+    CppCommon::Timespan option_connection_attempt_delay = _pimpl->option_connection_attempt_delay();
+    CppCommon::Timespan option_connect_timeout = _pimpl->option_connect_timeout();
+    CppCommon::Timespan option_handshake_timeout = _pimpl->option_handshake_timeout();
+    bool option_reconnect = _pimpl->option_reconnect();
+    CppCommon::Timespan option_reconnect_delay = _pimpl->option_reconnect_delay();
+    CppCommon::Timespan option_reconnect_max_delay = _pimpl->option_reconnect_max_delay();
+    size_t option_reconnect_attempts = _pimpl->option_reconnect_attempts();
+    CppCommon::Timespan option_reconnect_timeout = _pimpl->option_reconnect_timeout();
+    bool option_reconnect_preserve = _pimpl->option_reconnect_preserve();
+    auto reconnect = _pimpl->reconnect();
     _pimpl = std::make_shared<Impl>(_pimpl->id(), _pimpl->service(), _pimpl->context(), _pimpl->endpoint());
     _pimpl->bytes_sent() = bytes_sent;
     _pimpl->bytes_received() = bytes_received;
     _pimpl->SetupKeepAlive(option_keep_alive);
     _pimpl->SetupNoDelay(option_no_delay);
+    _pimpl->SetupHappyEyeballs(option_happy_eyeballs);
+    _pimpl->SetupConnectionAttemptDelay(option_connection_attempt_delay);
+    _pimpl->SetupConnectTimeout(option_connect_timeout);
+    _pimpl->SetupHandshakeTimeout(option_handshake_timeout);
+    _pimpl->SetupReconnect(option_reconnect);
+    _pimpl->SetupReconnectDelay(option_reconnect_delay);
+    _pimpl->SetupReconnectMaxDelay(option_reconnect_max_delay);
+    _pimpl->SetupReconnectAttempts(option_reconnect_attempts);
+    _pimpl->SetupReconnectTimeout(option_reconnect_timeout);
+    _pimpl->SetupReconnectPreserve(option_reconnect_preserve);
+    _pimpl->reconnect() = reconnect;
 }
 
 } // namespace Asio
@@ -43,5 +43,33 @@ void SSLContext::set_root_certs()
 #endif
 }
 
+void SSLContext::set_alpn_protocols(const std::vector<std::string>& protocols)
+{
+    // Encode protocols as length-prefixed strings
+    _alpn_protocols.clear();
+    for (const auto& protocol : protocols)
+    {
+        if (protocol.empty() || (protocol.size() > 255))
+            continue;
+        _alpn_protocols.push_back((char)protocol.size());
+        _alpn_protocols.append(protocol);
+    }
+
+    // Offer protocols to the server
+    SSL_CTX_set_alpn_protos(native_handle(), (const unsigned char*)_alpn_protocols.data(), (unsigned int)_alpn_protocols.size());
+
+    // Select the protocol offered by the client
+    auto select = [](SSL* ssl, const unsigned char** out, unsigned char* outlen, const unsigned char* in, unsigned int inlen, void* arg) -> int
+    {
+        const std::string& server = *(const std::string*)arg;
+        unsigned char* selected = nullptr;
+        if (SSL_select_next_proto(&selected, outlen, (const unsigned char*)server.data(), (unsigned int)server.size(), in, inlen) != OPENSSL_NPN_NEGOTIATED)
+            return SSL_TLSEXT_ERR_NOACK;
+        *out = selected;
+        return SSL_TLSEXT_ERR_OK;
+    };
+    SSL_CTX_set_alpn_select_cb(native_handle(), select, &_alpn_protocols);
+}
+
 } // namespace Asio
 } // namespace CppServer
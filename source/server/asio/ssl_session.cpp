@@ -45,6 +45,14 @@ size_t SSLSession::option_send_buffer_size() const
     return option.value();
 }
 
+std::string SSLSession::alpn_protocol()
+{
+    const unsigned char* protocol = nullptr;
+    unsigned int size = 0;
+    SSL_get0_alpn_selected(_stream.native_handle(), &protocol, &size);
+    return (protocol != nullptr) ? std::string((const char*)protocol, size) : std::string();
+}
+
 void SSLSession::SetupReceiveBufferSize(size_t size)
 {
     asio::socket_base::receive_buffer_size option((int)size);
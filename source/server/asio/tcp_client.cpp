@@ -8,6 +8,8 @@
 
 #include "server/asio/tcp_client.h"
 
+#include <random>
+
 namespace CppServer {
 namespace Asio {
 
@@ -32,7 +34,21 @@ TCPClient::TCPClient(std::shared_ptr<Service> service, const std::string& addres
       _sending(false),
       _send_buffer_flush_offset(0),
       _option_keep_alive(false),
-      _option_no_delay(false)
+      _option_no_delay(false),
+      _option_happy_eyeballs(false),
+      _option_connection_attempt_delay(CppCommon::Timespan::milliseconds(250)),
+      _option_connect_timeout(CppCommon::Timespan::zero()),
+      _option_reconnect(false),
+      _option_reconnect_delay(CppCommon::Timespan::seconds(1)),
+      _option_reconnect_max_delay(CppCommon::Timespan::seconds(30)),
+      _option_reconnect_attempts(0),
+      _option_reconnect_timeout(CppCommon::Timespan::zero()),
+      _option_reconnect_preserve(false),
+      _reconnect_stopped(true),
+      _reconnect_attempts(0),
+      _connect_timer(*_io_service),
+      _resolve_attempt(0),
+      _resolve_id(0)
 {
     assert((service != nullptr) && "Asio service is invalid!");
     if (service == nullptr)
@@ -60,7 +76,21 @@ TCPClient::TCPClient(std::shared_ptr<Service> service, const std::string& addres
       _sending(false),
       _send_buffer_flush_offset(0),
       _option_keep_alive(false),
-      _option_no_delay(false)
+      _option_no_delay(false),
+      _option_happy_eyeballs(false),
+      _option_connection_attempt_delay(CppCommon::Timespan::milliseconds(250)),
+      _option_connect_timeout(CppCommon::Timespan::zero()),
+      _option_reconnect(false),
+      _option_reconnect_delay(CppCommon::Timespan::seconds(1)),
+      _option_reconnect_max_delay(CppCommon::Timespan::seconds(30)),
+      _option_reconnect_attempts(0),
+      _option_reconnect_timeout(CppCommon::Timespan::zero()),
+      _option_reconnect_preserve(false),
+      _reconnect_stopped(true),
+      _reconnect_attempts(0),
+      _connect_timer(*_io_service),
+      _resolve_attempt(0),
+      _resolve_id(0)
 {
     assert((service != nullptr) && "Asio service is invalid!");
     if (service == nullptr)
@@ -88,7 +118,21 @@ TCPClient::TCPClient(std::shared_ptr<Service> service, const asio::ip::tcp::endp
       _sending(false),
       _send_buffer_flush_offset(0),
       _option_keep_alive(false),
-      _option_no_delay(false)
+      _option_no_delay(false),
+      _option_happy_eyeballs(false),
+      _option_connection_attempt_delay(CppCommon::Timespan::milliseconds(250)),
+      _option_connect_timeout(CppCommon::Timespan::zero()),
+      _option_reconnect(false),
+      _option_reconnect_delay(CppCommon::Timespan::seconds(1)),
+      _option_reconnect_max_delay(CppCommon::Timespan::seconds(30)),
+      _option_reconnect_attempts(0),
+      _option_reconnect_timeout(CppCommon::Timespan::zero()),
+      _option_reconnect_preserve(false),
+      _reconnect_stopped(true),
+      _reconnect_attempts(0),
+      _connect_timer(*_io_service),
+      _resolve_attempt(0),
+      _resolve_id(0)
 {
     assert((service != nullptr) && "Asio service is invalid!");
     if (service == nullptr)
@@ -126,6 +170,10 @@ bool TCPClient::Connect()
     if (IsConnected())
         return false;
 
+    // Resume the automatic reconnect
+    _reconnect_stopped = false;
+    _reconnect_resolver.reset();
+
     asio::error_code ec;
 
     // Connect to the server
@@ -161,6 +209,7 @@ bool TCPClient::Connect()
 
     // Update the connected flag
     _connected = true;
+    _reconnect_attempts = 0;
 
     // Call the client connected handler
     onConnected();
@@ -177,11 +226,14 @@ bool TCPClient::Connect(std::shared_ptr<TCPResolver> resolver)
     if (IsConnected())
         return false;
 
+    // Resume the automatic reconnect
+    _reconnect_stopped = false;
+    _reconnect_resolver = resolver;
+
     asio::error_code ec;
 
     // Resolve the server endpoint
-    asio::ip::tcp::resolver::query query(_address, (_scheme.empty() ? std::to_string(_port) : _scheme));
-    auto endpoints = resolver->resolver().resolve(query, ec);
+    auto endpoints = resolver->Resolve(_address, (_scheme.empty() ? std::to_string(_port) : _scheme), ec);
 
     // Disconnect on error
     if (ec)
@@ -226,6 +278,7 @@ bool TCPClient::Connect(std::shared_ptr<TCPResolver> resolver)
 
     // Update the connected flag
     _connected = true;
+    _reconnect_attempts = 0;
 
     // Call the client connected handler
     onConnected();
@@ -239,6 +292,15 @@ bool TCPClient::Connect(std::shared_ptr<TCPResolver> resolver)
 
 bool TCPClient::Disconnect()
 {
+    return Disconnect(false);
+}
+
+bool TCPClient::Disconnect(bool reconnect)
+{
+    // Stop the automatic reconnect if the client is disconnected by the user
+    if (!reconnect)
+        StopReconnect();
+
     if (!IsConnected())
         return false;
 
@@ -254,12 +316,19 @@ bool TCPClient::Disconnect()
     _receiving = false;
     _sending = false;
 
-    // Clear send/receive buffers
-    ClearBuffers();
+    // Clear send/receive buffers or preserve pending data for reconnect
+    if (reconnect && option_reconnect() && option_reconnect_preserve() && !_reconnect_stopped)
+        PreserveBuffers();
+    else
+        ClearBuffers();
 
     // Call the client disconnected handler
     onDisconnected();
 
+    // Try to reconnect the lost connection
+    if (reconnect)
+        TryReconnect();
+
     return true;
 }
 
@@ -276,6 +345,9 @@ bool TCPClient::ConnectAsync()
     if (IsConnected() || _resolving || _connecting)
         return false;
 
+    // Resume the automatic reconnect
+    _reconnect_stopped = false;
+
     // Post the connect handler
     auto self(this->shared_from_this());
     auto connect_handler = [this, self]()
@@ -283,12 +355,20 @@ bool TCPClient::ConnectAsync()
         if (IsConnected() || _resolving || _connecting)
             return;
 
+        _reconnect_resolver.reset();
+
+        // Limit the connect attempt with the connect timeout
+        StartConnectTimer(option_connect_timeout());
+
         // Async connect with the connect handler
         _connecting = true;
         auto async_connect_handler = [this, self](std::error_code ec)
         {
             _connecting = false;
 
+            // Cancel the connect attempt deadline
+            _connect_timer.cancel();
+
             if (IsConnected() || _resolving || _connecting)
                 return;
 
@@ -314,13 +394,16 @@ bool TCPClient::ConnectAsync()
 
                 // Update the connected flag
                 _connected = true;
+                _reconnect_attempts = 0;
 
                 // Call the client connected handler
                 onConnected();
 
-                // Call the empty send buffer handler
+                // Call the empty send buffer handler or send data preserved for reconnect
                 if (_send_buffer_main.empty())
                     onEmpty();
+                else
+                    TrySend();
 
                 // Try to receive something from the server
                 TryReceive();
@@ -331,6 +414,9 @@ bool TCPClient::ConnectAsync()
 
                 // Call the client disconnected handler
                 onDisconnected();
+
+                // Try to reconnect after the failed connect
+                TryReconnect();
             }
         };
         if (_strand_required)
@@ -351,6 +437,9 @@ bool TCPClient::ConnectAsync(std::shared_ptr<TCPResolver> resolver)
     if (IsConnected() || _resolving || _connecting)
         return false;
 
+    // Resume the automatic reconnect
+    _reconnect_stopped = false;
+
     // Post the connect handler
     auto self(this->shared_from_this());
     auto connect_handler = [this, self, resolver]()
@@ -358,10 +447,20 @@ bool TCPClient::ConnectAsync(std::shared_ptr<TCPResolver> resolver)
         if (IsConnected() || _resolving || _connecting)
             return;
 
+        _reconnect_resolver = resolver;
+
+        // Limit the connect attempt with the connect timeout
+        StartConnectTimer(option_connect_timeout());
+
         // Async resolve with the connect handler
         _resolving = true;
-        auto async_resolve_handler = [this, self](std::error_code ec1, asio::ip::tcp::resolver::results_type endpoints)
+        size_t attempt = ++_resolve_attempt;
+        auto async_resolve_handler = [this, self, attempt](std::error_code ec1, asio::ip::tcp::resolver::results_type endpoints)
         {
+            // Resolve attempt was already failed by timeout
+            if (attempt != _resolve_attempt)
+                return;
+
             _resolving = false;
 
             if (IsConnected() || _resolving || _connecting)
@@ -375,6 +474,10 @@ bool TCPClient::ConnectAsync(std::shared_ptr<TCPResolver> resolver)
                 {
                     _connecting = false;
 
+                    // Cancel the connect attempt deadline
+                    _connect_timer.cancel();
+                    _connector.reset();
+
                     if (IsConnected() || _resolving || _connecting)
                         return;
 
@@ -403,13 +506,16 @@ bool TCPClient::ConnectAsync(std::shared_ptr<TCPResolver> resolver)
 
                         // Update the connected flag
                         _connected = true;
+                        _reconnect_attempts = 0;
 
                         // Call the client connected handler
                         onConnected();
 
-                        // Call the empty send buffer handler
+                        // Call the empty send buffer handler or send data preserved for reconnect
                         if (_send_buffer_main.empty())
                             onEmpty();
+                        else
+                            TrySend();
 
                         // Try to receive something from the server
                         TryReceive();
@@ -420,9 +526,18 @@ bool TCPClient::ConnectAsync(std::shared_ptr<TCPResolver> resolver)
 
                         // Call the client disconnected handler
                         onDisconnected();
+
+                        // Try to reconnect after the failed connect
+                        TryReconnect();
                     }
                 };
-                if (_strand_required)
+                if (option_happy_eyeballs() && (endpoints.size() > 1))
+                {
+                    // Race connection attempts to the resolved endpoints
+                    _connector = std::make_shared<TCPConnector>(_io_service, _strand, _strand_required, _socket, option_connection_attempt_delay());
+                    _connector->ConnectAsync(endpoints, async_connect_handler);
+                }
+                else if (_strand_required)
                     asio::async_connect(_socket, endpoints, bind_executor(_strand, async_connect_handler));
                 else
                     asio::async_connect(_socket, endpoints, async_connect_handler);
@@ -433,15 +548,19 @@ bool TCPClient::ConnectAsync(std::shared_ptr<TCPResolver> resolver)
 
                 // Call the client disconnected handler
                 onDisconnected();
+
+                // Try to reconnect after the failed resolve
+                TryReconnect();
             }
         };
 
         // Resolve the server endpoint
-        asio::ip::tcp::resolver::query query(_address, (_scheme.empty() ? std::to_string(_port) : _scheme));
+        std::string service_name = (_scheme.empty() ? std::to_string(_port) : _scheme);
+        _resolve_resolver = resolver;
         if (_strand_required)
-            resolver->resolver().async_resolve(query, bind_executor(_strand, async_resolve_handler));
+            _resolve_id = resolver->ResolveAsync(_address, service_name, bind_executor(_strand, async_resolve_handler));
         else
-            resolver->resolver().async_resolve(query, async_resolve_handler);
+            _resolve_id = resolver->ResolveAsync(_address, service_name, async_resolve_handler);
     };
     if (_strand_required)
         _strand.post(connect_handler);
@@ -451,6 +570,14 @@ bool TCPClient::ConnectAsync(std::shared_ptr<TCPResolver> resolver)
     return true;
 }
 
+bool TCPClient::DisconnectAsync()
+{
+    // Stop the automatic reconnect
+    StopReconnect();
+
+    return DisconnectAsync(false);
+}
+
 bool TCPClient::DisconnectAsync(bool dispatch)
 {
     if (!IsConnected() || _resolving || _connecting)
@@ -458,7 +585,7 @@ bool TCPClient::DisconnectAsync(bool dispatch)
 
     // Dispatch or post the disconnect handler
     auto self(this->shared_from_this());
-    auto disconnect_handler = [this, self]() { Disconnect(); };
+    auto disconnect_handler = [this, self]() { Disconnect(true); };
     if (_strand_required)
     {
         if (dispatch)
@@ -517,7 +644,7 @@ size_t TCPClient::Send(const void* buffer, size_t size)
     if (ec)
     {
         SendError(ec);
-        Disconnect();
+        Disconnect(true);
     }
 
     return sent;
@@ -580,7 +707,7 @@ size_t TCPClient::Send(const void* buffer, size_t size, const CppCommon::Timespa
     if (error && (error != asio::error::timed_out))
     {
         SendError(error);
-        Disconnect();
+        Disconnect(true);
     }
 
     return sent;
@@ -592,7 +719,8 @@ bool TCPClient::SendAsync(const void* buffer, size_t size)
     if (buffer == nullptr)
         return false;
 
-    if (!IsConnected())
+    // Data could be queued while the client is reconnecting if the pending data is preserved
+    if (!IsConnected() && (!option_reconnect() || !option_reconnect_preserve() || _reconnect_stopped))
         return false;
 
     if (size == 0)
@@ -616,6 +744,10 @@ bool TCPClient::SendAsync(const void* buffer, size_t size)
             return true;
     }
 
+    // Send queued data after reconnect
+    if (!IsConnected())
+        return true;
+
     // Dispatch the send handler
     auto self(this->shared_from_this());
     auto send_handler = [this, self]()
@@ -660,7 +792,7 @@ size_t TCPClient::Receive(void* buffer, size_t size)
     if (ec)
     {
         SendError(ec);
-        Disconnect();
+        Disconnect(true);
     }
 
     return received;
@@ -730,7 +862,7 @@ size_t TCPClient::Receive(void* buffer, size_t size, const CppCommon::Timespan&
     if (error && (error != asio::error::timed_out))
     {
         SendError(error);
-        Disconnect();
+        Disconnect(true);
     }
 
     return received;
@@ -889,6 +1021,148 @@ void TCPClient::ClearBuffers()
     }
 }
 
+void TCPClient::PreserveBuffers()
+{
+    {
+        std::scoped_lock locker(_send_lock);
+
+        // Keep the unsent part of the flush buffer before the main buffer
+        _send_buffer_main.insert(_send_buffer_main.begin(), _send_buffer_flush.begin() + _send_buffer_flush_offset, _send_buffer_flush.end());
+        _send_buffer_flush.clear();
+        _send_buffer_flush_offset = 0;
+
+        // Update statistic
+        _bytes_pending = _send_buffer_main.size();
+        _bytes_sending = 0;
+    }
+}
+
+void TCPClient::TryReconnect()
+{
+    if (!option_reconnect() || _reconnect_stopped)
+        return;
+
+    // Stop reconnecting when all reconnect attempts failed
+    if ((option_reconnect_attempts() > 0) && (_reconnect_attempts >= option_reconnect_attempts()))
+    {
+        StopReconnect();
+        ClearBuffers();
+        return;
+    }
+
+    // Exponential backoff limited by the maximal delay
+    int64_t delay = std::max(option_reconnect_delay().total(), (int64_t)1);
+    int64_t max_delay = std::max(option_reconnect_max_delay().total(), delay);
+    for (size_t i = 0; (i < _reconnect_attempts) && (delay < max_delay); ++i)
+        delay *= 2;
+    delay = std::min(delay, max_delay);
+    ++_reconnect_attempts;
+
+    // Randomize the delay between its half and its full value
+    thread_local std::mt19937_64 generator(std::random_device{}());
+    std::uniform_int_distribution<int64_t> distribution(delay / 2, delay);
+    CppCommon::Timespan timespan = CppCommon::Timespan::nanoseconds(distribution(generator));
+
+    // Create the reconnect timer which does not prolong the client lifetime
+    if (!_reconnect_timer)
+    {
+        std::weak_ptr<TCPClient> weak_self = this->shared_from_this();
+        auto timer_handler = [weak_self](bool canceled)
+        {
+            if (canceled)
+                return;
+
+            auto self = weak_self.lock();
+            if (!self)
+                return;
+
+            // Post the reconnect handler
+            auto reconnect_handler = [self]()
+            {
+                if (self->_reconnect_stopped)
+                    return;
+
+                if (self->_reconnect_resolver)
+                    self->ConnectAsync(self->_reconnect_resolver);
+                else
+                    self->ConnectAsync();
+            };
+            if (self->_strand_required)
+                self->_strand.post(reconnect_handler);
+            else
+                self->_io_service->post(reconnect_handler);
+        };
+        _reconnect_timer = std::make_shared<Timer>(_service, timer_handler);
+    }
+
+    // Wait for the reconnect delay
+    if (_reconnect_timer->Setup(timespan))
+        _reconnect_timer->WaitAsync();
+}
+
+void TCPClient::StopReconnect()
+{
+    // Pending reconnect timer will find the reconnect stopped
+    _reconnect_stopped = true;
+    _reconnect_attempts = 0;
+}
+
+void TCPClient::StartConnectTimer(const CppCommon::Timespan& timeout)
+{
+    // Use the shortest of the given timeout and the reconnect timeout
+    int64_t deadline = timeout.total();
+    if (option_reconnect() && (option_reconnect_timeout().total() > 0) && ((deadline <= 0) || (option_reconnect_timeout().total() < deadline)))
+        deadline = option_reconnect_timeout().total();
+    if (deadline <= 0)
+        return;
+
+    // Async wait for the connect attempt deadline
+    auto self(this->shared_from_this());
+    auto async_wait_handler = [this, self](const asio::error_code& ec)
+    {
+        if (!ec)
+            AbortConnect();
+    };
+    _connect_timer.expires_from_now(CppCommon::Timespan::nanoseconds(deadline).chrono());
+    if (_strand_required)
+        _connect_timer.async_wait(bind_executor(_strand, async_wait_handler));
+    else
+        _connect_timer.async_wait(async_wait_handler);
+}
+
+void TCPClient::AbortConnect()
+{
+    if (!_resolving && !_connecting)
+        return;
+
+    SendError(asio::error::timed_out);
+
+    // Fail the connect attempt immediately, the pending resolve result will be ignored
+    if (_resolving)
+    {
+        ++_resolve_attempt;
+        _resolving = false;
+
+        // Release the resolve waiter of the resolver
+        if (_resolve_resolver)
+            _resolve_resolver->Cancel(_resolve_id);
+        _resolve_resolver.reset();
+
+        // Call the client disconnected handler
+        onDisconnected();
+
+        // Try to reconnect after the failed resolve
+        TryReconnect();
+        return;
+    }
+
+    // Cancel the connect attempt
+    if (_connector)
+        _connector->Cancel();
+    asio::error_code ignore;
+    _socket.close(ignore);
+}
+
 void TCPClient::SendError(std::error_code ec)
 {
     // Skip Asio disconnect errors
@@ -0,0 +1,165 @@
+/*!
+    \file tcp_connector.cpp
+    \brief TCP connector implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/tcp_connector.h"
+
+namespace CppServer {
+namespace Asio {
+
+TCPConnector::TCPConnector(std::shared_ptr<asio::io_service> io_service, asio::io_service::strand& strand, bool strand_required, asio::ip::tcp::socket& socket, const CppCommon::Timespan& delay)
+    : _io_service(io_service),
+      _strand(strand),
+      _strand_required(strand_required),
+      _socket(socket),
+      _delay(delay),
+      _timer(*_io_service),
+      _pending(0),
+      _canceled(false),
+      _done(false)
+{
+}
+
+std::vector<asio::ip::tcp::endpoint> TCPConnector::Interleave(const asio::ip::tcp::resolver::results_type& endpoints)
+{
+    std::vector<asio::ip::tcp::endpoint> preferred;
+    std::vector<asio::ip::tcp::endpoint> other;
+
+    // Split endpoints by the address family of the first endpoint
+    for (const auto& entry : endpoints)
+    {
+        if (preferred.empty() || (entry.endpoint().protocol() == preferred.front().protocol()))
+            preferred.emplace_back(entry.endpoint());
+        else
+            other.emplace_back(entry.endpoint());
+    }
+
+    // Alternate address families keeping the resolved order within each family
+    std::vector<asio::ip::tcp::endpoint> result;
+    result.reserve(preferred.size() + other.size());
+    for (size_t i = 0; (i < preferred.size()) || (i < other.size()); ++i)
+    {
+        if (i < preferred.size())
+            result.emplace_back(preferred[i]);
+        if (i < other.size())
+            result.emplace_back(other[i]);
+    }
+
+    return result;
+}
+
+void TCPConnector::ConnectAsync(const asio::ip::tcp::resolver::results_type& endpoints, const ConnectHandler& handler)
+{
+    _endpoints = Interleave(endpoints);
+    _attempts.reserve(_endpoints.size());
+    _handler = handler;
+
+    if (_endpoints.empty())
+    {
+        _done = true;
+        _handler(asio::error::host_not_found, asio::ip::tcp::endpoint());
+        return;
+    }
+
+    StartAttempt();
+}
+
+void TCPConnector::Cancel()
+{
+    if (_done || _canceled)
+        return;
+
+    _canceled = true;
+
+    // Close pending connection attempts
+    asio::error_code ignore;
+    _timer.cancel();
+    for (auto& attempt : _attempts)
+        if (attempt)
+            attempt->close(ignore);
+}
+
+void TCPConnector::StartAttempt()
+{
+    if (_done || _canceled || (_attempts.size() == _endpoints.size()))
+        return;
+
+    size_t index = _attempts.size();
+    _attempts.emplace_back(std::make_unique<asio::ip::tcp::socket>(*_io_service));
+    ++_pending;
+
+    // Async connect with the connection attempt handler
+    auto self(this->shared_from_this());
+    auto async_connect_handler = [this, self, index](std::error_code ec) { onAttempt(index, ec); };
+    if (_strand_required)
+        _attempts[index]->async_connect(_endpoints[index], bind_executor(_strand, async_connect_handler));
+    else
+        _attempts[index]->async_connect(_endpoints[index], async_connect_handler);
+
+    // Start the next attempt when the connection attempt delay expires
+    if (_attempts.size() < _endpoints.size())
+    {
+        // Stale expiration queued before the failed attempt started the next one is ignored
+        size_t next = _attempts.size();
+        auto async_wait_handler = [this, self, next](const asio::error_code& ec)
+        {
+            if (!ec && (_attempts.size() == next))
+                StartAttempt();
+        };
+        _timer.expires_from_now(_delay.chrono());
+        if (_strand_required)
+            _timer.async_wait(bind_executor(_strand, async_wait_handler));
+        else
+            _timer.async_wait(async_wait_handler);
+    }
+}
+
+void TCPConnector::onAttempt(size_t index, std::error_code ec)
+{
+    --_pending;
+
+    if (_done)
+        return;
+
+    if (!ec)
+    {
+        _done = true;
+
+        // Cancel other connection attempts
+        asio::error_code ignore;
+        _timer.cancel();
+        for (size_t i = 0; i < _attempts.size(); ++i)
+            if ((i != index) && _attempts[i])
+                _attempts[i]->close(ignore);
+
+        // Move the established connection into the target socket
+        _socket = std::move(*_attempts[index]);
+
+        _handler(ec, _endpoints[index]);
+        return;
+    }
+
+    // Failed attempt starts the next one without waiting for the delay
+    _error = ec;
+    _attempts[index].reset();
+    if (!_canceled && (_attempts.size() < _endpoints.size()))
+    {
+        _timer.cancel();
+        StartAttempt();
+        return;
+    }
+
+    // All attempts failed
+    if (_pending == 0)
+    {
+        _done = true;
+        _handler(_error, asio::ip::tcp::endpoint());
+    }
+}
+
+} // namespace Asio
+} // namespace CppServer
@@ -8,6 +8,10 @@
 
 #include "server/asio/tcp_resolver.h"
 
+#include "time/timestamp.h"
+
+#include <algorithm>
+
 namespace CppServer {
 namespace Asio {
 
@@ -16,12 +20,162 @@ TCPResolver::TCPResolver(std::shared_ptr<Service> service)
       _io_service(_service->GetAsioService()),
       _strand(*_io_service),
       _strand_required(_service->IsStrandRequired()),
-      _resolver(*_io_service)
+      _resolver(*_io_service),
+      _cache(std::make_shared<Cache>()),
+      _option_cache_ttl(CppCommon::Timespan::seconds(60)),
+      _option_negative_cache_ttl(CppCommon::Timespan::seconds(5))
 {
     assert((service != nullptr) && "Asio service is invalid!");
     if (service == nullptr)
         throw CppCommon::ArgumentException("Asio service is invalid!");
 }
 
+size_t TCPResolver::cache_size()
+{
+    std::scoped_lock locker(_cache->lock);
+    return _cache->entries.size();
+}
+
+void TCPResolver::ClearCache()
+{
+    std::scoped_lock locker(_cache->lock);
+
+    // Entries with pending lookups are kept to notify their handlers
+    for (auto it = _cache->entries.begin(); it != _cache->entries.end();)
+    {
+        if (it->second.resolving)
+        {
+            it->second.expires = 0;
+            ++it;
+        }
+        else
+            it = _cache->entries.erase(it);
+    }
+}
+
+asio::ip::tcp::resolver::results_type TCPResolver::Resolve(const std::string& host, const std::string& service, asio::error_code& ec)
+{
+    auto key = std::make_pair(host, service);
+
+    // Find the cached results
+    {
+        std::scoped_lock locker(_cache->lock);
+        auto it = _cache->entries.find(key);
+        if ((it != _cache->entries.end()) && (CppCommon::Timestamp::nano() < it->second.expires))
+        {
+            ec = it->second.error;
+            return it->second.results;
+        }
+    }
+
+    // Synchronous lookup uses its own resolver, the shared one is used by asynchronous lookups concurrently
+    asio::ip::tcp::resolver resolver(*_io_service);
+    auto results = resolver.resolve(host, service, ec);
+
+    // Update the DNS cache
+    {
+        std::scoped_lock locker(_cache->lock);
+        Store(_cache->entries[key], results, ec, CppCommon::Timestamp::nano(), _option_cache_ttl, _option_negative_cache_ttl);
+    }
+
+    return results;
+}
+
+uint64_t TCPResolver::ResolveCached(const std::string& host, const std::string& service, const ResolveHandler& handler)
+{
+    auto key = std::make_pair(host, service);
+
+    std::scoped_lock locker(_cache->lock);
+
+    // Notify the cached results
+    auto& entry = _cache->entries[key];
+    if (!entry.resolving && (CppCommon::Timestamp::nano() < entry.expires))
+    {
+        handler(entry.error, entry.results);
+        return 0;
+    }
+
+    // Wait for the pending lookup of the same host and service
+    uint64_t id = ++_cache->waiters;
+    entry.waiters.push_back({ id, handler });
+    if (entry.resolving)
+        return id;
+
+    entry.resolving = true;
+
+    auto cache = _cache;
+    auto ttl = _option_cache_ttl;
+    auto negative_ttl = _option_negative_cache_ttl;
+    auto async_resolve_handler = [cache, key, ttl, negative_ttl](std::error_code ec, asio::ip::tcp::resolver::results_type results)
+    {
+        std::vector<Waiter> waiters;
+
+        {
+            std::scoped_lock locker(cache->lock);
+
+            uint64_t timestamp = CppCommon::Timestamp::nano();
+
+            auto& entry = cache->entries[key];
+            entry.resolving = false;
+            Store(entry, results, ec, timestamp, ttl, negative_ttl);
+            waiters = std::move(entry.waiters);
+            entry.waiters.clear();
+
+            // Evict expired entries
+            for (auto it = cache->entries.begin(); it != cache->entries.end();)
+            {
+                if (!it->second.resolving && (it->second.expires <= timestamp))
+                    it = cache->entries.erase(it);
+                else
+                    ++it;
+            }
+        }
+
+        for (auto& waiter : waiters)
+            waiter.handler(ec, results);
+    };
+
+    _resolver.async_resolve(host, service, async_resolve_handler);
+
+    return id;
+}
+
+bool TCPResolver::Cancel(uint64_t id)
+{
+    ResolveHandler handler;
+
+    // Find and remove the waiter of the pending lookup
+    {
+        std::scoped_lock locker(_cache->lock);
+        for (auto& entry : _cache->entries)
+        {
+            auto& waiters = entry.second.waiters;
+            auto it = std::find_if(waiters.begin(), waiters.end(), [id](const Waiter& waiter) { return waiter.id == id; });
+            if (it != waiters.end())
+            {
+                handler = std::move(it->handler);
+                waiters.erase(it);
+                break;
+            }
+        }
+    }
+
+    if (!handler)
+        return false;
+
+    handler(asio::error::operation_aborted, asio::ip::tcp::resolver::results_type());
+    return true;
+}
+
+void TCPResolver::Store(CacheEntry& entry, const asio::ip::tcp::resolver::results_type& results, const std::error_code& ec, uint64_t timestamp, const CppCommon::Timespan& ttl, const CppCommon::Timespan& negative_ttl)
+{
+    // Canceled lookups are not cached
+    int64_t duration = ec ? ((ec == asio::error::operation_aborted) ? 0 : negative_ttl.total()) : ttl.total();
+
+    entry.results = results;
+    entry.error = ec;
+    entry.expires = (duration > 0) ? (timestamp + duration) : 0;
+}
+
 } // namespace Asio
 } // namespace CppServer
@@ -8,6 +8,20 @@
 
 #include "server/asio/udp_client.h"
 
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+#if defined(__linux__)
+#include <netinet/udp.h>
+#if !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif
+#if !defined(UDP_GRO)
+#define UDP_GRO 104
+#endif
+#endif
+
 namespace CppServer {
 namespace Asio {
 
@@ -20,8 +34,10 @@ UDPClient::UDPClient(std::shared_ptr<Service> service, const std::string& addres
       _address(address),
       _port(port),
       _socket(*_io_service),
+      _socket_connected(false),
       _resolving(false),
       _connected(false),
+      _bytes_pending(0),
       _bytes_sending(0),
       _bytes_sent(0),
       _bytes_received(0),
@@ -29,9 +45,27 @@ UDPClient::UDPClient(std::shared_ptr<Service> service, const std::string& addres
       _datagrams_received(0),
       _receiving(false),
       _sending(false),
+      _send_datagrams_flush_offset(0),
+      _send_refused(false),
       _option_reuse_address(false),
       _option_reuse_port(false),
-      _option_multicast(false)
+      _option_multicast(false),
+      _option_receive_batch(1),
+      _option_send_batch(1),
+      _option_gso_segment_size(0),
+      _option_gro(false),
+      _option_connected(false),
+      _option_reconnect(false),
+      _option_reconnect_delay(CppCommon::Timespan::seconds(1)),
+      _option_reconnect_max_delay(CppCommon::Timespan::seconds(30)),
+      _option_reconnect_attempts(0),
+      _option_reconnect_timeout(CppCommon::Timespan::zero()),
+      _option_send_buffer_limit(0),
+      _reconnect_stopped(true),
+      _reconnect_attempts(0),
+      _connect_timer(*_io_service),
+      _resolve_attempt(0),
+      _resolve_id(0)
 {
     assert((service != nullptr) && "Asio service is invalid!");
     if (service == nullptr)
@@ -48,8 +82,10 @@ UDPClient::UDPClient(std::shared_ptr<Service> service, const std::string& addres
       _scheme(scheme),
       _port(0),
       _socket(*_io_service),
+      _socket_connected(false),
       _resolving(false),
       _connected(false),
+      _bytes_pending(0),
       _bytes_sending(0),
       _bytes_sent(0),
       _bytes_received(0),
@@ -57,9 +93,27 @@ UDPClient::UDPClient(std::shared_ptr<Service> service, const std::string& addres
       _datagrams_received(0),
       _receiving(false),
       _sending(false),
+      _send_datagrams_flush_offset(0),
+      _send_refused(false),
       _option_reuse_address(false),
       _option_reuse_port(false),
-      _option_multicast(false)
+      _option_multicast(false),
+      _option_receive_batch(1),
+      _option_send_batch(1),
+      _option_gso_segment_size(0),
+      _option_gro(false),
+      _option_connected(false),
+      _option_reconnect(false),
+      _option_reconnect_delay(CppCommon::Timespan::seconds(1)),
+      _option_reconnect_max_delay(CppCommon::Timespan::seconds(30)),
+      _option_reconnect_attempts(0),
+      _option_reconnect_timeout(CppCommon::Timespan::zero()),
+      _option_send_buffer_limit(0),
+      _reconnect_stopped(true),
+      _reconnect_attempts(0),
+      _connect_timer(*_io_service),
+      _resolve_attempt(0),
+      _resolve_id(0)
 {
     assert((service != nullptr) && "Asio service is invalid!");
     if (service == nullptr)
@@ -76,8 +130,10 @@ UDPClient::UDPClient(std::shared_ptr<Service> service, const asio::ip::udp::endp
       _port(endpoint.port()),
       _endpoint(endpoint),
       _socket(*_io_service),
+      _socket_connected(false),
       _resolving(false),
       _connected(false),
+      _bytes_pending(0),
       _bytes_sending(0),
       _bytes_sent(0),
       _bytes_received(0),
@@ -85,9 +141,27 @@ UDPClient::UDPClient(std::shared_ptr<Service> service, const asio::ip::udp::endp
       _datagrams_received(0),
       _receiving(false),
       _sending(false),
+      _send_datagrams_flush_offset(0),
+      _send_refused(false),
       _option_reuse_address(false),
       _option_reuse_port(false),
-      _option_multicast(false)
+      _option_multicast(false),
+      _option_receive_batch(1),
+      _option_send_batch(1),
+      _option_gso_segment_size(0),
+      _option_gro(false),
+      _option_connected(false),
+      _option_reconnect(false),
+      _option_reconnect_delay(CppCommon::Timespan::seconds(1)),
+      _option_reconnect_max_delay(CppCommon::Timespan::seconds(30)),
+      _option_reconnect_attempts(0),
+      _option_reconnect_timeout(CppCommon::Timespan::zero()),
+      _option_send_buffer_limit(0),
+      _reconnect_stopped(true),
+      _reconnect_attempts(0),
+      _connect_timer(*_io_service),
+      _resolve_attempt(0),
+      _resolve_id(0)
 {
     assert((service != nullptr) && "Asio service is invalid!");
     if (service == nullptr)
@@ -132,34 +206,15 @@ bool UDPClient::Connect()
     if (IsConnected())
         return false;
 
+    // Resume the automatic reconnect
+    _reconnect_stopped = false;
+    _reconnect_resolver.reset();
+
     // Create a new server endpoint
     _endpoint = asio::ip::udp::endpoint(asio::ip::make_address(_address), (unsigned short)_port);
 
-    // Open a client socket
-    _socket.open(_endpoint.protocol());
-    if (option_reuse_address())
-        _socket.set_option(asio::ip::udp::socket::reuse_address(true));
-#if (defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__)) && !defined(__CYGWIN__)
-    if (option_reuse_port())
-    {
-        typedef asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> reuse_port;
-        _socket.set_option(reuse_port(true));
-    }
-#endif
-    if (option_multicast())
-        _socket.bind(_endpoint);
-    else
-        _socket.bind(asio::ip::udp::endpoint(_endpoint.protocol(), 0));
-
-    // Prepare receive buffer
-    _receive_buffer.resize(option_receive_buffer_size());
-
-    // Reset statistic
-    _bytes_sending = 0;
-    _bytes_sent = 0;
-    _bytes_received = 0;
-    _datagrams_sent = 0;
-    _datagrams_received = 0;
+    // Open and prepare a client socket
+    OpenSocket();
 
     // Update the connected flag
     _connected = true;
@@ -185,11 +240,14 @@ bool UDPClient::Connect(std::shared_ptr<UDPResolver> resolver)
     if (IsConnected())
         return false;
 
+    // Resume the automatic reconnect
+    _reconnect_stopped = false;
+    _reconnect_resolver = resolver;
+
     std::error_code ec;
 
     // Resolve the server endpoint
-    asio::ip::udp::resolver::query query(_address, (_scheme.empty() ? std::to_string(_port) : _scheme));
-    auto endpoints = resolver->resolver().resolve(query, ec);
+    auto endpoints = resolver->Resolve(_address, (_scheme.empty() ? std::to_string(_port) : _scheme), ec);
 
     // Check for resolve errors
     if (ec)
@@ -203,31 +261,8 @@ bool UDPClient::Connect(std::shared_ptr<UDPResolver> resolver)
 
     _endpoint = *endpoints;
 
-    // Open a client socket
-    _socket.open(_endpoint.protocol());
-    if (option_reuse_address())
-        _socket.set_option(asio::ip::udp::socket::reuse_address(true));
-#if (defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__)) && !defined(__CYGWIN__)
-    if (option_reuse_port())
-    {
-        typedef asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> reuse_port;
-        _socket.set_option(reuse_port(true));
-    }
-#endif
-    if (option_multicast())
-        _socket.bind(_endpoint);
-    else
-        _socket.bind(asio::ip::udp::endpoint(_endpoint.protocol(), 0));
-
-    // Prepare receive buffer
-    _receive_buffer.resize(option_receive_buffer_size());
-
-    // Reset statistic
-    _bytes_sending = 0;
-    _bytes_sent = 0;
-    _bytes_received = 0;
-    _datagrams_sent = 0;
-    _datagrams_received = 0;
+    // Open and prepare a client socket
+    OpenSocket();
 
     // Update the connected flag
     _connected = true;
@@ -240,6 +275,15 @@ bool UDPClient::Connect(std::shared_ptr<UDPResolver> resolver)
 
 bool UDPClient::Disconnect()
 {
+    return Disconnect(false);
+}
+
+bool UDPClient::Disconnect(bool reconnect)
+{
+    // Stop the automatic reconnect if the client is disconnected by the user
+    if (!reconnect)
+        StopReconnect();
+
     if (!IsConnected())
         return false;
 
@@ -260,6 +304,16 @@ bool UDPClient::Disconnect()
     // Call the client disconnected handler
     onDisconnected();
 
+    // Try to reconnect after the socket error
+    if (reconnect)
+    {
+        // Reset reconnect attempts if the server was reachable
+        if (_datagrams_received > 0)
+            _reconnect_attempts = 0;
+
+        TryReconnect();
+    }
+
     return true;
 }
 
@@ -276,6 +330,9 @@ bool UDPClient::ConnectAsync()
     if (IsConnected())
         return false;
 
+    // Resume the automatic reconnect
+    _reconnect_stopped = false;
+
     // Post the connect handler
     auto self(this->shared_from_this());
     auto connect_handler = [this, self]() { Connect(); };
@@ -296,6 +353,9 @@ bool UDPClient::ConnectAsync(std::shared_ptr<UDPResolver> resolver)
     if (IsConnected() || _resolving)
         return false;
 
+    // Resume the automatic reconnect
+    _reconnect_stopped = false;
+
     // Post the connect handler
     auto self(this->shared_from_this());
     auto connect_handler = [this, self, resolver]()
@@ -303,12 +363,26 @@ bool UDPClient::ConnectAsync(std::shared_ptr<UDPResolver> resolver)
         if (IsConnected() || _resolving)
             return;
 
+        _reconnect_resolver = resolver;
+
+        // Limit the resolve attempt with the reconnect timeout
+        if (option_reconnect() && (option_reconnect_timeout().total() > 0))
+            StartConnectTimer(option_reconnect_timeout());
+
         // Async DNS resolve with the resolve handler
         _resolving = true;
-        auto async_resolve_handler = [this, self](std::error_code ec, asio::ip::udp::resolver::results_type endpoints)
+        size_t attempt = ++_resolve_attempt;
+        auto async_resolve_handler = [this, self, attempt](std::error_code ec, asio::ip::udp::resolver::results_type endpoints)
         {
+            // Resolve attempt was already failed by timeout
+            if (attempt != _resolve_attempt)
+                return;
+
             _resolving = false;
 
+            // Cancel the resolve attempt deadline
+            _connect_timer.cancel();
+
             if (IsConnected() || _resolving)
                 return;
 
@@ -317,31 +391,8 @@ bool UDPClient::ConnectAsync(std::shared_ptr<UDPResolver> resolver)
                 // Resolve the server endpoint
                 _endpoint = *endpoints;
 
-                // Open a client socket
-                _socket.open(_endpoint.protocol());
-                if (option_reuse_address())
-                    _socket.set_option(asio::ip::udp::socket::reuse_address(true));
-#if (defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__)) && !defined(__CYGWIN__)
-                if (option_reuse_port())
-                {
-                    typedef asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> reuse_port;
-                    _socket.set_option(reuse_port(true));
-                }
-#endif
-                if (option_multicast())
-                    _socket.bind(_endpoint);
-                else
-                    _socket.bind(asio::ip::udp::endpoint(_endpoint.protocol(), 0));
-
-                // Prepare receive buffer
-                _receive_buffer.resize(option_receive_buffer_size());
-
-                // Reset statistic
-                _bytes_sending = 0;
-                _bytes_sent = 0;
-                _bytes_received = 0;
-                _datagrams_sent = 0;
-                _datagrams_received = 0;
+                // Open and prepare a client socket
+                OpenSocket();
 
                 // Update the connected flag
                 _connected = true;
@@ -355,15 +406,19 @@ bool UDPClient::ConnectAsync(std::shared_ptr<UDPResolver> resolver)
 
                 // Call the client disconnected handler
                 onDisconnected();
+
+                // Try to reconnect after the failed resolve
+                TryReconnect();
             }
         };
 
         // Resolve the server endpoint
-        asio::ip::udp::resolver::query query(_address, (_scheme.empty() ? std::to_string(_port) : _scheme));
+        std::string service_name = (_scheme.empty() ? std::to_string(_port) : _scheme);
+        _resolve_resolver = resolver;
         if (_strand_required)
-            resolver->resolver().async_resolve(query, bind_executor(_strand, async_resolve_handler));
+            _resolve_id = resolver->ResolveAsync(_address, service_name, bind_executor(_strand, async_resolve_handler));
         else
-            resolver->resolver().async_resolve(query, async_resolve_handler);
+            _resolve_id = resolver->ResolveAsync(_address, service_name, async_resolve_handler);
     };
     if (_strand_required)
         _strand.post(connect_handler);
@@ -373,6 +428,14 @@ bool UDPClient::ConnectAsync(std::shared_ptr<UDPResolver> resolver)
     return true;
 }
 
+bool UDPClient::DisconnectAsync()
+{
+    // Stop the automatic reconnect
+    StopReconnect();
+
+    return DisconnectAsync(false);
+}
+
 bool UDPClient::DisconnectAsync(bool dispatch)
 {
     if (!IsConnected())
@@ -380,7 +443,7 @@ bool UDPClient::DisconnectAsync(bool dispatch)
 
     // Dispatch or post the disconnect handler
     auto self(this->shared_from_this());
-    auto disconnect_handler = [this, self]() { Disconnect(); };
+    auto disconnect_handler = [this, self]() { Disconnect(true); };
     if (_strand_required)
     {
         if (dispatch)
@@ -487,7 +550,9 @@ size_t UDPClient::Send(const asio::ip::udp::endpoint& endpoint, const void* buff
     asio::error_code ec;
 
     // Sent datagram to the server
-    size_t sent = _socket.send_to(asio::const_buffer(buffer, size), endpoint, 0, ec);
+    size_t sent = (_socket_connected && (endpoint == _endpoint)) ?
+        _socket.send(asio::const_buffer(buffer, size), 0, ec) :
+        _socket.send_to(asio::const_buffer(buffer, size), endpoint, 0, ec);
     if (sent > 0)
     {
         // Update statistic
@@ -499,10 +564,10 @@ size_t UDPClient::Send(const asio::ip::udp::endpoint& endpoint, const void* buff
     }
 
     // Disconnect on error
-    if (ec)
+    if (ec && !IsRefused(ec))
     {
         SendError(ec);
-        Disconnect();
+        Disconnect(true);
     }
 
     return sent;
@@ -551,7 +616,10 @@ size_t UDPClient::Send(const asio::ip::udp::endpoint& endpoint, const void* buff
 
     // Async send datagram to the server
     size_t sent = 0;
-    _socket.async_send_to(asio::buffer(buffer, size), endpoint, [&](std::error_code ec, size_t write) { async_done_handler(ec); sent = write; });
+    if (_socket_connected && (endpoint == _endpoint))
+        _socket.async_send(asio::buffer(buffer, size), [&](std::error_code ec, size_t write) { async_done_handler(ec); sent = write; });
+    else
+        _socket.async_send_to(asio::buffer(buffer, size), endpoint, [&](std::error_code ec, size_t write) { async_done_handler(ec); sent = write; });
 
     // Wait for complete or timeout
     std::unique_lock<std::mutex> lck(mtx);
@@ -569,10 +637,10 @@ size_t UDPClient::Send(const asio::ip::udp::endpoint& endpoint, const void* buff
     }
 
     // Disconnect on error
-    if (error && (error != asio::error::timed_out))
+    if (error && (error != asio::error::timed_out) && !IsRefused(error))
     {
         SendError(error);
-        Disconnect();
+        Disconnect(true);
     }
 
     return sent;
@@ -590,61 +658,46 @@ bool UDPClient::SendAsync(const asio::ip::udp::endpoint& endpoint, const void* b
     if (buffer == nullptr)
         return false;
 
-    if (_sending)
-        return false;
-
     if (!IsConnected())
         return false;
 
     if (size == 0)
         return true;
 
-    // Fill the main send buffer
-    const uint8_t* bytes = (const uint8_t*)buffer;
-    _send_buffer.assign(bytes, bytes + size);
-
-    // Update statistic
-    _bytes_sending = _send_buffer.size();
-
-    // Update send endpoint
-    _send_endpoint = endpoint;
-
-    // Async send-to with the send-to handler
-    _sending = true;
-    auto self(this->shared_from_this());
-    auto async_send_to_handler = make_alloc_handler(_send_storage, [this, self](std::error_code ec, size_t sent)
     {
-        _sending = false;
+        std::scoped_lock locker(_send_lock);
 
-        if (!IsConnected())
-            return;
+        // Check the send buffer limit
+        if ((_option_send_buffer_limit > 0) && ((_send_buffer_main.size() + size) > _option_send_buffer_limit))
+            return false;
 
-        // Disconnect on error
-        if (ec)
-        {
-            SendError(ec);
-            DisconnectAsync(true);
-            return;
-        }
+        // Detect multiple send handlers
+        bool send_required = _send_datagrams_main.empty() || _send_datagrams_flush.empty();
 
-        // Send some data to the server
-        if (sent > 0)
-        {
-            // Update statistic
-            _bytes_sending = 0;
-            _bytes_sent += sent;
+        // Fill the main send buffer
+        const uint8_t* bytes = (const uint8_t*)buffer;
+        _send_datagrams_main.push_back({ endpoint, _send_buffer_main.size(), size });
+        _send_buffer_main.insert(_send_buffer_main.end(), bytes, bytes + size);
 
-            // Clear the send buffer
-            _send_buffer.clear();
+        // Update statistic
+        _bytes_pending = _send_buffer_main.size();
 
-            // Call the buffer sent handler
-            onSent(_send_endpoint, sent);
-        }
-    });
+        // Avoid multiple send handlers
+        if (!send_required)
+            return true;
+    }
+
+    // Dispatch the send handler
+    auto self(this->shared_from_this());
+    auto send_handler = [this, self]()
+    {
+        // Try to send the main buffer
+        TrySend();
+    };
     if (_strand_required)
-        _socket.async_send_to(asio::buffer(_send_buffer.data(), _send_buffer.size()), _send_endpoint, bind_executor(_strand, async_send_to_handler));
+        _strand.dispatch(send_handler);
     else
-        _socket.async_send_to(asio::buffer(_send_buffer.data(), _send_buffer.size()), _send_endpoint, async_send_to_handler);
+        _io_service->dispatch(send_handler);
 
     return true;
 }
@@ -676,10 +729,10 @@ size_t UDPClient::Receive(asio::ip::udp::endpoint& endpoint, void* buffer, size_
     }
 
     // Disconnect on error
-    if (ec)
+    if (ec && !IsRefused(ec))
     {
         SendError(ec);
-        Disconnect();
+        Disconnect(true);
     }
 
     return received;
@@ -747,10 +800,10 @@ size_t UDPClient::Receive(asio::ip::udp::endpoint& endpoint, void* buffer, size_
     }
 
     // Disconnect on error
-    if (error && (error != asio::error::timed_out))
+    if (error && (error != asio::error::timed_out) && !IsRefused(error))
     {
         SendError(error);
-        Disconnect();
+        Disconnect(true);
     }
 
     return received;
@@ -777,6 +830,15 @@ void UDPClient::TryReceive()
     if (!IsConnected())
         return;
 
+#if defined(__linux__)
+    // Batched receive mode
+    if (!_receive_batch_headers.empty())
+    {
+        TryReceiveBatch();
+        return;
+    }
+#endif
+
     // Async receive with the receive handler
     _receiving = true;
     auto self(this->shared_from_this());
@@ -787,6 +849,13 @@ void UDPClient::TryReceive()
         if (!IsConnected())
             return;
 
+        // Server is not available yet, so continue to receive
+        if (IsRefused(ec))
+        {
+            TryReceive();
+            return;
+        }
+
         // Disconnect on error
         if (ec)
         {
@@ -810,19 +879,572 @@ void UDPClient::TryReceive()
                 _receive_buffer.resize(2 * size);
         }
     });
+    if (_socket_connected)
+    {
+        // Connected socket receives datagrams only from the server endpoint
+        if (_strand_required)
+            _socket.async_receive(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), bind_executor(_strand, async_receive_handler));
+        else
+            _socket.async_receive(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), async_receive_handler);
+    }
+    else
+    {
+        if (_strand_required)
+            _socket.async_receive_from(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), _receive_endpoint, bind_executor(_strand, async_receive_handler));
+        else
+            _socket.async_receive_from(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), _receive_endpoint, async_receive_handler);
+    }
+}
+
+#if defined(__linux__)
+void UDPClient::TryReceiveBatch()
+{
+    // Async wait for incoming datagrams with the receive handler
+    _receiving = true;
+    auto self(this->shared_from_this());
+    auto async_wait_handler = make_alloc_handler(_receive_storage, [this, self](std::error_code ec)
+    {
+        _receiving = false;
+
+        if (!IsConnected())
+            return;
+
+        // Receive a batch of datagrams
+        if (!ec)
+        {
+            for (size_t i = 0; i < _receive_batch_headers.size(); ++i)
+            {
+                _receive_batch_headers[i].msg_hdr.msg_name = _receive_batch_endpoints[i].data();
+                _receive_batch_headers[i].msg_hdr.msg_namelen = (socklen_t)_receive_batch_endpoints[i].capacity();
+                _receive_batch_headers[i].msg_len = 0;
+                if (!_receive_batch_control.empty())
+                {
+                    size_t control_size = _receive_batch_control.size() / _receive_batch_headers.size();
+                    _receive_batch_headers[i].msg_hdr.msg_control = _receive_batch_control.data() + i * control_size;
+                    _receive_batch_headers[i].msg_hdr.msg_controllen = control_size;
+                }
+            }
+
+            int count = ::recvmmsg(_socket.native_handle(), _receive_batch_headers.data(), (unsigned)_receive_batch_headers.size(), MSG_DONTWAIT, nullptr);
+            if (count < 0)
+            {
+                // Spurious wakeup, wait for incoming datagrams again
+                if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))
+                {
+                    TryReceiveBatch();
+                    return;
+                }
+
+                // Server is not available yet, so continue to receive
+                ec = std::error_code(errno, std::system_category());
+                if (IsRefused(ec))
+                {
+                    TryReceiveBatch();
+                    return;
+                }
+            }
+            else
+            {
+                size_t datagram_size = _receive_batch_buffer.size() / _receive_batch_headers.size();
+                for (int i = 0; i < count; ++i)
+                {
+                    size_t size = _receive_batch_headers[i].msg_len;
+                    if (size == 0)
+                        continue;
+
+                    _receive_batch_endpoints[i].resize(_receive_batch_headers[i].msg_hdr.msg_namelen);
+
+                    // Find the GRO segment size of coalesced datagrams
+                    size_t segment_size = size;
+                    bool segmented = false;
+                    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&_receive_batch_headers[i].msg_hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&_receive_batch_headers[i].msg_hdr, cmsg))
+                    {
+                        if ((cmsg->cmsg_level == IPPROTO_UDP) && (cmsg->cmsg_type == UDP_GRO))
+                        {
+                            int gso_size = 0;
+                            std::memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+                            if (gso_size > 0)
+                                segment_size = (size_t)gso_size;
+                            segmented = true;
+                        }
+                    }
+
+                    // Coalesced datagrams cannot be split if the GRO control message was truncated
+                    if (!segmented && ((_receive_batch_headers[i].msg_hdr.msg_flags & MSG_CTRUNC) != 0))
+                    {
+                        SendError(asio::error::no_buffer_space);
+                        continue;
+                    }
+
+                    // Split coalesced datagrams into segments
+                    const uint8_t* buffer = _receive_batch_buffer.data() + i * datagram_size;
+                    for (size_t offset = 0; offset < size; offset += segment_size)
+                    {
+                        size_t segment = std::min(segment_size, size - offset);
+
+                        // Update statistic
+                        ++_datagrams_received;
+                        _bytes_received += segment;
+
+                        // Call the datagram received handler
+                        onReceived(_receive_batch_endpoints[i], buffer + offset, segment);
+                    }
+                }
+                return;
+            }
+        }
+
+        // Disconnect on error
+        SendError(ec);
+        DisconnectAsync(true);
+    });
     if (_strand_required)
-        _socket.async_receive_from(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), _receive_endpoint, bind_executor(_strand, async_receive_handler));
+        _socket.async_wait(asio::ip::udp::socket::wait_read, bind_executor(_strand, async_wait_handler));
     else
-        _socket.async_receive_from(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), _receive_endpoint, async_receive_handler);
+        _socket.async_wait(asio::ip::udp::socket::wait_read, async_wait_handler);
 }
+#endif
 
-void UDPClient::ClearBuffers()
+void UDPClient::PrepareReceiveBatch()
 {
-    // Clear send buffers
-    _send_buffer.clear();
+    _receive_batch_buffer.clear();
+    _receive_batch_endpoints.clear();
+#if defined(__linux__)
+    _receive_batch_control.clear();
+    _receive_batch_vectors.clear();
+    _receive_batch_headers.clear();
+
+    // GRO requires control messages, so it is received in the batch mode
+    if ((_option_receive_batch <= 1) && !_option_gro)
+        return;
+
+    // Each batch slot is able to hold the maximal UDP datagram
+    const size_t datagram_size = 65536;
+
+    _receive_batch_buffer.resize(_option_receive_batch * datagram_size);
+    _receive_batch_endpoints.resize(_option_receive_batch);
+    _receive_batch_vectors.resize(_option_receive_batch);
+    _receive_batch_headers.resize(_option_receive_batch);
+    // Reserve space for other control messages enabled on the socket to avoid their truncation
+    if (_option_gro)
+        _receive_batch_control.resize(_option_receive_batch * (CMSG_SPACE(sizeof(int)) + 64));
+    for (size_t i = 0; i < _option_receive_batch; ++i)
+    {
+        _receive_batch_vectors[i].iov_base = _receive_batch_buffer.data() + i * datagram_size;
+        _receive_batch_vectors[i].iov_len = datagram_size;
+        _receive_batch_headers[i] = mmsghdr();
+        _receive_batch_headers[i].msg_hdr.msg_iov = &_receive_batch_vectors[i];
+        _receive_batch_headers[i].msg_hdr.msg_iovlen = 1;
+    }
+#endif
+}
+
+void UDPClient::TrySend()
+{
+    if (_sending)
+        return;
+
+    if (!IsConnected())
+        return;
+
+    // Swap send buffers
+    if (_send_datagrams_flush.empty())
+    {
+        std::scoped_lock locker(_send_lock);
+
+        // Swap flush and main buffers
+        _send_buffer_flush.swap(_send_buffer_main);
+        _send_datagrams_flush.swap(_send_datagrams_main);
+        _send_datagrams_flush_offset = 0;
+
+        // Update statistic
+        _bytes_pending = 0;
+        _bytes_sending += _send_buffer_flush.size();
+    }
+
+    // Check if the flush buffer is empty
+    if (_send_datagrams_flush.empty())
+        return;
+
+#if defined(__linux__)
+    // Batched send mode
+    if (_option_send_batch > 1)
+    {
+        TrySendBatch();
+        return;
+    }
+#endif
+
+    // Async send-to with the send-to handler
+    _sending = true;
+    auto self(this->shared_from_this());
+    auto async_send_to_handler = make_alloc_handler(_send_storage, [this, self](std::error_code ec, size_t sent)
+    {
+        _sending = false;
+
+        if (!IsConnected())
+            return;
+
+        // Refused datagram is not sent because of the ICMP error of the previous one, so send it again once
+        if (IsRefused(ec) && !_send_refused)
+        {
+            _send_refused = true;
+            TrySend();
+            return;
+        }
+
+        // Check for error
+        if (ec && !IsRefused(ec))
+        {
+            SendError(ec);
+            DisconnectAsync(true);
+            return;
+        }
+        else
+        {
+            // Complete the sent datagram, the datagram refused twice is lost
+            _send_refused = false;
+            CompleteSend(ec ? 0 : sent);
+        }
+
+        // Try to send the next datagram
+        TrySend();
+    });
+    auto& datagram = _send_datagrams_flush[_send_datagrams_flush_offset];
+    if (_socket_connected && (datagram.endpoint == _endpoint))
+    {
+        // Connected socket sends datagrams to the server endpoint without the destination address
+        if (_strand_required)
+            _socket.async_send(asio::buffer(_send_buffer_flush.data() + datagram.offset, datagram.size), bind_executor(_strand, async_send_to_handler));
+        else
+            _socket.async_send(asio::buffer(_send_buffer_flush.data() + datagram.offset, datagram.size), async_send_to_handler);
+    }
+    else
+    {
+        if (_strand_required)
+            _socket.async_send_to(asio::buffer(_send_buffer_flush.data() + datagram.offset, datagram.size), datagram.endpoint, bind_executor(_strand, async_send_to_handler));
+        else
+            _socket.async_send_to(asio::buffer(_send_buffer_flush.data() + datagram.offset, datagram.size), datagram.endpoint, async_send_to_handler);
+    }
+}
+
+#if defined(__linux__)
+void UDPClient::TrySendBatch()
+{
+    // Async wait for the socket write readiness with the send handler
+    _sending = true;
+    auto self(this->shared_from_this());
+    auto async_wait_handler = make_alloc_handler(_send_storage, [this, self](std::error_code ec)
+    {
+        if (!IsConnected())
+        {
+            _sending = false;
+            return;
+        }
+
+        // Send a batch of datagrams
+        if (!ec)
+        {
+            size_t count = std::min(_send_datagrams_flush.size() - _send_datagrams_flush_offset, _option_send_batch);
+            _send_batch_vectors.resize(count);
+            _send_batch_headers.resize(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto& datagram = _send_datagrams_flush[_send_datagrams_flush_offset + i];
+                _send_batch_vectors[i].iov_base = _send_buffer_flush.data() + datagram.offset;
+                _send_batch_vectors[i].iov_len = datagram.size;
+                _send_batch_headers[i] = mmsghdr();
+                if (!_socket_connected || (datagram.endpoint != _endpoint))
+                {
+                    _send_batch_headers[i].msg_hdr.msg_name = datagram.endpoint.data();
+                    _send_batch_headers[i].msg_hdr.msg_namelen = (socklen_t)datagram.endpoint.size();
+                }
+                _send_batch_headers[i].msg_hdr.msg_iov = &_send_batch_vectors[i];
+                _send_batch_headers[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            int sent = ::sendmmsg(_socket.native_handle(), _send_batch_headers.data(), (unsigned)count, MSG_DONTWAIT);
+            if (sent < 0)
+            {
+                // Socket is not ready, wait for the write readiness again
+                ec = std::error_code(errno, std::system_category());
+                if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))
+                {
+                    _sending = false;
+                    TrySend();
+                    return;
+                }
+
+                // Refused datagrams are not sent because of the ICMP error of the previous ones, so send them again once
+                if (IsRefused(ec))
+                {
+                    // The first datagram refused twice is lost
+                    if (_send_refused)
+                    {
+                        _send_refused = false;
+                        CompleteSend(0);
+                    }
+                    else
+                        _send_refused = true;
+
+                    _sending = false;
+                    TrySend();
+                    return;
+                }
+            }
+            else
+            {
+                // Release all sent datagrams before calling any handler, so
+                // the handler disconnecting the client cannot clear the flush
+                // buffer which is still in use
+                _send_refused = false;
+                _send_batch_sent.clear();
+                for (int i = 0; i < sent; ++i)
+                    _send_batch_sent.push_back(ReleaseSend(_send_batch_headers[i].msg_len));
+
+                _sending = false;
+
+                // Call the datagram sent handler for all sent datagrams
+                for (const auto& datagram : _send_batch_sent)
+                {
+                    if (!IsConnected())
+                        break;
+
+                    onSent(datagram.endpoint, datagram.sent);
+                }
+
+                // Try to send the next batch of datagrams
+                TrySend();
+                return;
+            }
+        }
+
+        _sending = false;
+
+        // Disconnect on error
+        SendError(ec);
+        DisconnectAsync(true);
+    });
+    if (_strand_required)
+        _socket.async_wait(asio::ip::udp::socket::wait_write, bind_executor(_strand, async_wait_handler));
+    else
+        _socket.async_wait(asio::ip::udp::socket::wait_write, async_wait_handler);
+}
+#endif
+
+void UDPClient::CompleteSend(size_t sent)
+{
+    auto datagram = ReleaseSend(sent);
+
+    // Call the datagram sent handler
+    onSent(datagram.endpoint, datagram.sent);
+}
+
+UDPClient::SentDatagram UDPClient::ReleaseSend(size_t sent)
+{
+    auto endpoint = _send_datagrams_flush[_send_datagrams_flush_offset].endpoint;
+    size_t size = _send_datagrams_flush[_send_datagrams_flush_offset].size;
 
     // Update statistic
+    _bytes_sending -= size;
+    _bytes_sent += sent;
+    if (sent > 0)
+        ++_datagrams_sent;
+
+    // Successfully send the whole flush buffer
+    if (++_send_datagrams_flush_offset == _send_datagrams_flush.size())
+    {
+        // Clear the flush buffer
+        _send_buffer_flush.clear();
+        _send_datagrams_flush.clear();
+        _send_datagrams_flush_offset = 0;
+    }
+
+    return SentDatagram{ endpoint, sent };
+}
+
+void UDPClient::TryReconnect()
+{
+    if (!option_reconnect() || _reconnect_stopped)
+        return;
+
+    // Stop reconnecting when all reconnect attempts failed
+    if ((option_reconnect_attempts() > 0) && (_reconnect_attempts >= option_reconnect_attempts()))
+    {
+        StopReconnect();
+        return;
+    }
+
+    // Exponential backoff limited by the maximal delay
+    int64_t delay = std::max(option_reconnect_delay().total(), (int64_t)1);
+    int64_t max_delay = std::max(option_reconnect_max_delay().total(), delay);
+    for (size_t i = 0; (i < _reconnect_attempts) && (delay < max_delay); ++i)
+        delay *= 2;
+    delay = std::min(delay, max_delay);
+    ++_reconnect_attempts;
+
+    // Randomize the delay between its half and its full value
+    thread_local std::mt19937_64 generator(std::random_device{}());
+    std::uniform_int_distribution<int64_t> distribution(delay / 2, delay);
+    CppCommon::Timespan timespan = CppCommon::Timespan::nanoseconds(distribution(generator));
+
+    // Create the reconnect timer which does not prolong the client lifetime
+    if (!_reconnect_timer)
+    {
+        std::weak_ptr<UDPClient> weak_self = this->shared_from_this();
+        auto timer_handler = [weak_self](bool canceled)
+        {
+            if (canceled)
+                return;
+
+            auto self = weak_self.lock();
+            if (!self)
+                return;
+
+            // Post the reconnect handler
+            auto reconnect_handler = [self]()
+            {
+                if (self->_reconnect_stopped)
+                    return;
+
+                if (self->_reconnect_resolver)
+                    self->ConnectAsync(self->_reconnect_resolver);
+                else
+                    self->ConnectAsync();
+            };
+            if (self->_strand_required)
+                self->_strand.post(reconnect_handler);
+            else
+                self->_io_service->post(reconnect_handler);
+        };
+        _reconnect_timer = std::make_shared<Timer>(_service, timer_handler);
+    }
+
+    // Wait for the reconnect delay
+    if (_reconnect_timer->Setup(timespan))
+        _reconnect_timer->WaitAsync();
+}
+
+void UDPClient::StopReconnect()
+{
+    // Pending reconnect timer will find the reconnect stopped
+    _reconnect_stopped = true;
+    _reconnect_attempts = 0;
+}
+
+void UDPClient::StartConnectTimer(const CppCommon::Timespan& timeout)
+{
+    // Async wait for the resolve attempt deadline
+    auto self(this->shared_from_this());
+    auto async_wait_handler = [this, self](const asio::error_code& ec)
+    {
+        if (!ec)
+            AbortConnect();
+    };
+    _connect_timer.expires_from_now(timeout.chrono());
+    if (_strand_required)
+        _connect_timer.async_wait(bind_executor(_strand, async_wait_handler));
+    else
+        _connect_timer.async_wait(async_wait_handler);
+}
+
+void UDPClient::AbortConnect()
+{
+    if (!_resolving)
+        return;
+
+    SendError(asio::error::timed_out);
+
+    // Fail the resolve attempt immediately, the pending resolve result will be ignored
+    ++_resolve_attempt;
+    _resolving = false;
+
+    // Release the resolve waiter of the resolver
+    if (_resolve_resolver)
+        _resolve_resolver->Cancel(_resolve_id);
+    _resolve_resolver.reset();
+
+    // Call the client disconnected handler
+    onDisconnected();
+
+    // Try to reconnect after the failed resolve
+    TryReconnect();
+}
+
+void UDPClient::OpenSocket()
+{
+    // Open a client socket
+    _socket.open(_endpoint.protocol());
+    if (option_reuse_address())
+        _socket.set_option(asio::ip::udp::socket::reuse_address(true));
+#if (defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__)) && !defined(__CYGWIN__)
+    if (option_reuse_port())
+    {
+        typedef asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> reuse_port;
+        _socket.set_option(reuse_port(true));
+    }
+#endif
+    if (option_multicast())
+        _socket.bind(_endpoint);
+    else
+        _socket.bind(asio::ip::udp::endpoint(_endpoint.protocol(), 0));
+    _socket_connected = option_connected() && !option_multicast();
+    if (_socket_connected)
+    {
+        _socket.connect(_endpoint);
+        _receive_endpoint = _endpoint;
+    }
+#if defined(__linux__)
+    if (option_gso_segment_size() > 0)
+    {
+        typedef asio::detail::socket_option::integer<IPPROTO_UDP, UDP_SEGMENT> udp_segment;
+        // Continue without the offload if the OS does not support it
+        std::error_code ec;
+        _socket.set_option(udp_segment((int)option_gso_segment_size()), ec);
+        if (ec)
+            SendError(ec);
+    }
+    if (option_gro())
+    {
+        typedef asio::detail::socket_option::boolean<IPPROTO_UDP, UDP_GRO> udp_gro;
+        // Continue without the offload if the OS does not support it
+        std::error_code ec;
+        _socket.set_option(udp_gro(true), ec);
+        if (ec)
+            SendError(ec);
+    }
+#endif
+
+    // Prepare receive buffer
+    _receive_buffer.resize(option_receive_buffer_size());
+    PrepareReceiveBatch();
+
+    // Reset statistic
+    _bytes_pending = 0;
     _bytes_sending = 0;
+    _bytes_sent = 0;
+    _bytes_received = 0;
+    _datagrams_sent = 0;
+    _datagrams_received = 0;
+}
+
+void UDPClient::ClearBuffers()
+{
+    {
+        std::scoped_lock locker(_send_lock);
+
+        // Clear send buffers
+        _send_buffer_main.clear();
+        _send_buffer_flush.clear();
+        _send_datagrams_main.clear();
+        _send_datagrams_flush.clear();
+        _send_datagrams_flush_offset = 0;
+        _send_refused = false;
+
+        // Update statistic
+        _bytes_pending = 0;
+        _bytes_sending = 0;
+    }
 }
 
 void UDPClient::SendError(std::error_code ec)
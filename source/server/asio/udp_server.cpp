@@ -8,6 +8,25 @@
 
 #include "server/asio/udp_server.h"
 
+#include "time/timestamp.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/filter.h>
+#include <netinet/udp.h>
+#if !defined(SO_ATTACH_REUSEPORT_CBPF)
+#define SO_ATTACH_REUSEPORT_CBPF 51
+#endif
+#if !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif
+#if !defined(UDP_GRO)
+#define UDP_GRO 104
+#endif
+#endif
+
 namespace CppServer {
 namespace Asio {
 
@@ -20,15 +39,28 @@ UDPServer::UDPServer(std::shared_ptr<Service> service, int port, InternetProtoco
       _port(port),
       _socket(*_io_service),
       _started(false),
+      _bytes_pending(0),
       _bytes_sending(0),
       _bytes_sent(0),
       _bytes_received(0),
       _datagrams_sent(0),
       _datagrams_received(0),
       _receiving(false),
+      _continuous_receiving(false),
       _sending(false),
+      _send_datagrams_flush_offset(0),
       _option_reuse_address(false),
-      _option_reuse_port(false)
+      _option_reuse_port(false),
+      _option_reuse_port_group(false),
+      _option_reuse_port_steering(false),
+      _option_receive_batch(1),
+      _option_send_batch(1),
+      _option_gso_segment_size(0),
+      _option_gro(false),
+      _option_sessions(false),
+      _option_session_timeout(CppCommon::Timespan::seconds(30)),
+      _option_send_buffer_limit(0),
+      _option_session_send_limit(0)
 {
     assert((service != nullptr) && "Asio service is invalid!");
     if (service == nullptr)
@@ -56,15 +88,28 @@ UDPServer::UDPServer(std::shared_ptr<Service> service, const std::string& addres
       _port(port),
       _socket(*_io_service),
       _started(false),
+      _bytes_pending(0),
       _bytes_sending(0),
       _bytes_sent(0),
       _bytes_received(0),
       _datagrams_sent(0),
       _datagrams_received(0),
       _receiving(false),
+      _continuous_receiving(false),
       _sending(false),
+      _send_datagrams_flush_offset(0),
       _option_reuse_address(false),
-      _option_reuse_port(false)
+      _option_reuse_port(false),
+      _option_reuse_port_group(false),
+      _option_reuse_port_steering(false),
+      _option_receive_batch(1),
+      _option_send_batch(1),
+      _option_gso_segment_size(0),
+      _option_gro(false),
+      _option_sessions(false),
+      _option_session_timeout(CppCommon::Timespan::seconds(30)),
+      _option_send_buffer_limit(0),
+      _option_session_send_limit(0)
 {
     assert((service != nullptr) && "Asio service is invalid!");
     if (service == nullptr)
@@ -85,13 +130,28 @@ UDPServer::UDPServer(std::shared_ptr<Service> service, const asio::ip::udp::endp
       _endpoint(endpoint),
       _socket(*_io_service),
       _started(false),
+      _bytes_pending(0),
       _bytes_sending(0),
       _bytes_sent(0),
       _bytes_received(0),
       _datagrams_sent(0),
       _datagrams_received(0),
       _receiving(false),
-      _sending(false)
+      _continuous_receiving(false),
+      _sending(false),
+      _send_datagrams_flush_offset(0),
+      _option_reuse_address(false),
+      _option_reuse_port(false),
+      _option_reuse_port_group(false),
+      _option_reuse_port_steering(false),
+      _option_receive_batch(1),
+      _option_send_batch(1),
+      _option_gso_segment_size(0),
+      _option_gro(false),
+      _option_sessions(false),
+      _option_session_timeout(CppCommon::Timespan::seconds(30)),
+      _option_send_buffer_limit(0),
+      _option_session_send_limit(0)
 {
     assert((service != nullptr) && "Asio service is invalid!");
     if (service == nullptr)
@@ -142,18 +202,44 @@ bool UDPServer::Start()
         if (option_reuse_address())
             _socket.set_option(asio::ip::udp::socket::reuse_address(true));
 #if (defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__)) && !defined(__CYGWIN__)
-        if (option_reuse_port())
+        if (option_reuse_port() || option_reuse_port_group())
         {
             typedef asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> reuse_port;
             _socket.set_option(reuse_port(true));
         }
 #endif
         _socket.bind(_endpoint);
+#if defined(__linux__)
+        if (option_gso_segment_size() > 0)
+        {
+            typedef asio::detail::socket_option::integer<IPPROTO_UDP, UDP_SEGMENT> udp_segment;
+            // Continue without the offload if the OS does not support it
+            std::error_code ec;
+            _socket.set_option(udp_segment((int)option_gso_segment_size()), ec);
+            if (ec)
+                SendError(ec);
+        }
+        if (option_gro())
+        {
+            typedef asio::detail::socket_option::boolean<IPPROTO_UDP, UDP_GRO> udp_gro;
+            // Continue without the offload if the OS does not support it
+            std::error_code ec;
+            _socket.set_option(udp_gro(true), ec);
+            if (ec)
+                SendError(ec);
+        }
+#endif
 
         // Prepare receive buffer
         _receive_buffer.resize(option_receive_buffer_size());
+        PrepareReceiveBatch();
+
+        // Open reuse port socket group
+        if (option_reuse_port_group())
+            OpenGroup();
 
         // Reset statistic
+        _bytes_pending = 0;
         _bytes_sending = 0;
         _bytes_sent = 0;
         _bytes_received = 0;
@@ -165,6 +251,34 @@ bool UDPServer::Start()
 
         // Call the server started handler
         onStarted();
+
+        // Start the sessions mode
+        if (option_sessions())
+        {
+            // Start the idle sessions expiration timer (idle sessions are checked four times per the session timeout)
+            if (option_session_timeout().total() > 0)
+            {
+                // Handler uses its own timer, the server timer could be reset by Stop() concurrently
+                std::weak_ptr<UDPServer> weak(self);
+                auto sessions_timer = std::make_shared<Timer>(_service);
+                std::weak_ptr<Timer> weak_timer(sessions_timer);
+                sessions_timer->Setup([weak, weak_timer](bool canceled)
+                {
+                    auto server = weak.lock();
+                    auto timer = weak_timer.lock();
+                    if (server && timer)
+                        server->ExpireSessions(timer, canceled);
+                }, CppCommon::Timespan(option_session_timeout().total() / 4));
+                {
+                    std::unique_lock<std::shared_mutex> locker(_sessions_lock);
+                    _sessions_timer = sessions_timer;
+                }
+                sessions_timer->WaitAsync();
+            }
+
+            // Start the continuous receive loop
+            ReceiveAsync();
+        }
     };
     if (_strand_required)
         _strand.post(start_handler);
@@ -202,12 +316,34 @@ bool UDPServer::Stop()
         // Close the server socket
         _socket.close();
 
+        // Close reuse port socket group
+        CloseGroup();
+
+        // Stop the idle sessions expiration timer
+        std::shared_ptr<Timer> sessions_timer;
+        {
+            std::unique_lock<std::shared_mutex> locker(_sessions_lock);
+            sessions_timer.swap(_sessions_timer);
+        }
+        if (sessions_timer)
+            sessions_timer->Cancel();
+
+        // Disconnect all sessions
+        for (auto& session : GetSessions())
+            session->Disconnect();
+        _receive_session.reset();
+
         // Update the started flag
         _started = false;
 
+        // Disconnect sessions registered concurrently, the later ones are disconnected by the registering socket
+        for (auto& session : GetSessions())
+            session->Disconnect();
+
         // Update sending/receiving flags
         _receiving = false;
         _sending = false;
+        _continuous_receiving = false;
 
         // Clear send/receive buffers
         ClearBuffers();
@@ -351,69 +487,62 @@ size_t UDPServer::Send(const asio::ip::udp::endpoint& endpoint, const void* buff
 }
 
 bool UDPServer::SendAsync(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size)
+{
+    return EnqueueSend(nullptr, endpoint, buffer, size);
+}
+
+bool UDPServer::EnqueueSend(std::shared_ptr<UDPSession> session, const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size)
 {
     assert((buffer != nullptr) && "Pointer to the buffer should not be null!");
     if (buffer == nullptr)
         return false;
 
-    if (_sending)
-        return false;
-
     if (!IsStarted())
         return false;
 
     if (size == 0)
         return true;
 
-    // Fill the main send buffer
-    const uint8_t* bytes = (const uint8_t*)buffer;
-    _send_buffer.assign(bytes, bytes + size);
-
-    // Update statistic
-    _bytes_sending = _send_buffer.size();
-
-    // Update send endpoint
-    _send_endpoint = endpoint;
-
-    // Async send-to with the send-to handler
-    _sending = true;
-    auto self(this->shared_from_this());
-    auto async_send_to_handler = make_alloc_handler(_send_storage, [this, self](std::error_code ec, size_t sent)
     {
-        _sending = false;
+        std::scoped_lock locker(_send_lock);
 
-        if (!IsStarted())
-            return;
+        // Check the send buffer limit
+        if ((_option_send_buffer_limit > 0) && ((_send_buffer_main.size() + size) > _option_send_buffer_limit))
+            return false;
 
-        // Check for error
-        if (ec)
-        {
-            SendError(ec);
+        // Check the session send limit
+        if (session && (_option_session_send_limit > 0) && ((session->_bytes_pending + size) > _option_session_send_limit))
+            return false;
 
-            // Call the buffer sent zero handler
-            onSent(_send_endpoint, 0);
+        // Detect multiple send handlers
+        bool send_required = _send_datagrams_main.empty() || _send_datagrams_flush.empty();
 
-            return;
-        }
+        // Fill the main send buffer
+        const uint8_t* bytes = (const uint8_t*)buffer;
+        _send_datagrams_main.push_back({ endpoint, _send_buffer_main.size(), size, session });
+        _send_buffer_main.insert(_send_buffer_main.end(), bytes, bytes + size);
 
-        // Send some data to the client
-        if (sent > 0)
-        {
-            // Update statistic
-            _bytes_sending = 0;
-            _bytes_sent += sent;
+        // Update statistic
+        _bytes_pending = _send_buffer_main.size();
+        if (session)
+            session->_bytes_pending += size;
 
-            // Clear the send buffer
-            _send_buffer.clear();
+        // Avoid multiple send handlers
+        if (!send_required)
+            return true;
+    }
 
-            // Call the buffer sent handler
-            onSent(_send_endpoint, sent);
-        }
-    });
+    // Dispatch the send handler
+    auto self(this->shared_from_this());
+    auto send_handler = [this, self]()
+    {
+        // Try to send the main buffer
+        TrySend();
+    };
     if (_strand_required)
-        _socket.async_send_to(asio::buffer(_send_buffer.data(), _send_buffer.size()), _send_endpoint, bind_executor(_strand, async_send_to_handler));
+        _strand.dispatch(send_handler);
     else
-        _socket.async_send_to(asio::buffer(_send_buffer.data(), _send_buffer.size()), _send_endpoint, async_send_to_handler);
+        _io_service->dispatch(send_handler);
 
     return true;
 }
@@ -532,6 +661,26 @@ std::string UDPServer::Receive(asio::ip::udp::endpoint& endpoint, size_t size, c
 
 void UDPServer::ReceiveAsync()
 {
+    // Start continuous receive loops of the reuse port socket group or sessions mode
+    if (option_reuse_port_group() || option_sessions())
+    {
+        {
+            // Group sockets are closed by Stop() concurrently
+            std::scoped_lock locker(_group_lock);
+
+            if (!IsStarted() || _continuous_receiving.exchange(true))
+                return;
+
+            // Start receive loops of the group sockets within their strands
+            auto self(this->shared_from_this());
+            for (auto& group_socket : _group_sockets)
+                group_socket->strand.post([this, self, group_socket]() { TryReceiveGroup(group_socket); });
+        }
+
+        TryReceive();
+        return;
+    }
+
     // Try to receive datagrams from clients
     TryReceive();
 }
@@ -544,6 +693,15 @@ void UDPServer::TryReceive()
     if (!IsStarted())
         return;
 
+#if defined(__linux__)
+    // Batched receive mode
+    if (!_receive_batch_headers.empty())
+    {
+        TryReceiveBatch();
+        return;
+    }
+#endif
+
     // Async receive with the receive handler
     _receiving = true;
     auto self(this->shared_from_this());
@@ -561,24 +719,21 @@ void UDPServer::TryReceive()
 
             // Call the datagram received zero handler
             onReceived(_receive_endpoint, _receive_buffer.data(), 0);
-
-            return;
         }
-
         // Received some data from the client
-        if (size > 0)
+        else if (size > 0)
         {
-            // Update statistic
-            ++_datagrams_received;
-            _bytes_received += size;
-
-            // Call the datagram received handler
-            onReceived(_receive_endpoint, _receive_buffer.data(), size);
+            // Process the received datagram
+            ReceiveDatagram(_receive_endpoint, _receive_buffer.data(), size, _receive_session);
 
             // If the receive buffer is full increase its size
             if (_receive_buffer.size() == size)
                 _receive_buffer.resize(2 * size);
         }
+
+        // Continue the continuous receive loop
+        if (_continuous_receiving)
+            TryReceive();
     });
     if (_strand_required)
         _socket.async_receive_from(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), _receive_endpoint, bind_executor(_strand, async_receive_handler));
@@ -586,13 +741,608 @@ void UDPServer::TryReceive()
         _socket.async_receive_from(asio::buffer(_receive_buffer.data(), _receive_buffer.size()), _receive_endpoint, async_receive_handler);
 }
 
-void UDPServer::ClearBuffers()
+#if defined(__linux__)
+void UDPServer::TryReceiveBatch()
+{
+    // Async wait for incoming datagrams with the receive handler
+    _receiving = true;
+    auto self(this->shared_from_this());
+    auto async_wait_handler = make_alloc_handler(_receive_storage, [this, self](std::error_code ec)
+    {
+        _receiving = false;
+
+        if (!IsStarted())
+            return;
+
+        // Receive a batch of datagrams
+        if (!ec)
+        {
+            for (size_t i = 0; i < _receive_batch_headers.size(); ++i)
+            {
+                _receive_batch_headers[i].msg_hdr.msg_name = _receive_batch_endpoints[i].data();
+                _receive_batch_headers[i].msg_hdr.msg_namelen = (socklen_t)_receive_batch_endpoints[i].capacity();
+                _receive_batch_headers[i].msg_len = 0;
+                if (!_receive_batch_control.empty())
+                {
+                    size_t control_size = _receive_batch_control.size() / _receive_batch_headers.size();
+                    _receive_batch_headers[i].msg_hdr.msg_control = _receive_batch_control.data() + i * control_size;
+                    _receive_batch_headers[i].msg_hdr.msg_controllen = control_size;
+                }
+            }
+
+            int count = ::recvmmsg(_socket.native_handle(), _receive_batch_headers.data(), (unsigned)_receive_batch_headers.size(), MSG_DONTWAIT, nullptr);
+            if (count < 0)
+            {
+                // Spurious wakeup, wait for incoming datagrams again
+                if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))
+                {
+                    TryReceiveBatch();
+                    return;
+                }
+
+                ec = std::error_code(errno, std::system_category());
+            }
+            else
+            {
+                size_t datagram_size = _receive_batch_buffer.size() / _receive_batch_headers.size();
+                for (int i = 0; i < count; ++i)
+                {
+                    size_t size = _receive_batch_headers[i].msg_len;
+                    if (size == 0)
+                        continue;
+
+                    _receive_batch_endpoints[i].resize(_receive_batch_headers[i].msg_hdr.msg_namelen);
+
+                    // Find the GRO segment size of coalesced datagrams
+                    size_t segment_size = size;
+                    bool segmented = false;
+                    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&_receive_batch_headers[i].msg_hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&_receive_batch_headers[i].msg_hdr, cmsg))
+                    {
+                        if ((cmsg->cmsg_level == IPPROTO_UDP) && (cmsg->cmsg_type == UDP_GRO))
+                        {
+                            int gso_size = 0;
+                            std::memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+                            if (gso_size > 0)
+                                segment_size = (size_t)gso_size;
+                            segmented = true;
+                        }
+                    }
+
+                    // Coalesced datagrams cannot be split if the GRO control message was truncated
+                    if (!segmented && ((_receive_batch_headers[i].msg_hdr.msg_flags & MSG_CTRUNC) != 0))
+                    {
+                        SendError(asio::error::no_buffer_space);
+                        continue;
+                    }
+
+                    // Split coalesced datagrams into segments
+                    const uint8_t* buffer = _receive_batch_buffer.data() + i * datagram_size;
+                    for (size_t offset = 0; offset < size; offset += segment_size)
+                    {
+                        size_t segment = std::min(segment_size, size - offset);
+
+                        // Process the received datagram
+                        ReceiveDatagram(_receive_batch_endpoints[i], buffer + offset, segment, _receive_session);
+                    }
+                }
+            }
+        }
+
+        if (ec)
+        {
+            SendError(ec);
+
+            // Call the datagram received zero handler
+            onReceived(_receive_endpoint, _receive_buffer.data(), 0);
+        }
+
+        // Continue the continuous receive loop
+        if (_continuous_receiving)
+            TryReceive();
+    });
+    if (_strand_required)
+        _socket.async_wait(asio::ip::udp::socket::wait_read, bind_executor(_strand, async_wait_handler));
+    else
+        _socket.async_wait(asio::ip::udp::socket::wait_read, async_wait_handler);
+}
+#endif
+
+void UDPServer::PrepareReceiveBatch()
+{
+    _receive_batch_buffer.clear();
+    _receive_batch_endpoints.clear();
+#if defined(__linux__)
+    _receive_batch_control.clear();
+    _receive_batch_vectors.clear();
+    _receive_batch_headers.clear();
+
+    // GRO requires control messages, so it is received in the batch mode
+    if ((_option_receive_batch <= 1) && !_option_gro)
+        return;
+
+    // Each batch slot is able to hold the maximal UDP datagram
+    const size_t datagram_size = 65536;
+
+    _receive_batch_buffer.resize(_option_receive_batch * datagram_size);
+    _receive_batch_endpoints.resize(_option_receive_batch);
+    _receive_batch_vectors.resize(_option_receive_batch);
+    _receive_batch_headers.resize(_option_receive_batch);
+    // Reserve space for other control messages enabled on the socket to avoid their truncation
+    if (_option_gro)
+        _receive_batch_control.resize(_option_receive_batch * (CMSG_SPACE(sizeof(int)) + 64));
+    for (size_t i = 0; i < _option_receive_batch; ++i)
+    {
+        _receive_batch_vectors[i].iov_base = _receive_batch_buffer.data() + i * datagram_size;
+        _receive_batch_vectors[i].iov_len = datagram_size;
+        _receive_batch_headers[i] = mmsghdr();
+        _receive_batch_headers[i].msg_hdr.msg_iov = &_receive_batch_vectors[i];
+        _receive_batch_headers[i].msg_hdr.msg_iovlen = 1;
+    }
+#endif
+}
+
+void UDPServer::OpenGroup()
+{
+#if (defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__)) && !defined(__CYGWIN__)
+    typedef asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> reuse_port;
+
+    std::scoped_lock locker(_group_lock);
+
+    // Open one additional socket for each working thread except the first one
+    for (size_t i = 1; i < _service->threads(); ++i)
+    {
+        auto group_socket = std::make_shared<GroupSocket>(*_service->GetAsioService());
+        group_socket->socket.open(_endpoint.protocol());
+        if (option_reuse_address())
+            group_socket->socket.set_option(asio::ip::udp::socket::reuse_address(true));
+        group_socket->socket.set_option(reuse_port(true));
+        group_socket->socket.bind(_endpoint);
+        group_socket->receive_buffer.resize(option_receive_buffer_size());
+        _group_sockets.emplace_back(group_socket);
+    }
+
+#if defined(__linux__)
+    // Attach flow hash steering program to the socket group
+    if (option_reuse_port_steering())
+    {
+        sock_filter code[] =
+        {
+            { BPF_LD | BPF_W | BPF_ABS, 0, 0, (uint32_t)(SKF_AD_OFF + SKF_AD_RXHASH) },
+            { BPF_ALU | BPF_MOD | BPF_K, 0, 0, (uint32_t)(_group_sockets.size() + 1) },
+            { BPF_RET | BPF_A, 0, 0, 0 }
+        };
+        sock_fprog program = { (unsigned short)(sizeof(code) / sizeof(code[0])), code };
+        if (::setsockopt(_socket.native_handle(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) != 0)
+            SendError(std::error_code(errno, std::system_category()));
+    }
+#endif
+#endif
+}
+
+void UDPServer::CloseGroup()
+{
+    std::scoped_lock locker(_group_lock);
+
+    // Update the continuous receiving flag
+    _continuous_receiving = false;
+
+    // Close all sockets of the group within their strands
+    for (auto& group_socket : _group_sockets)
+        group_socket->strand.post([group_socket]() { group_socket->socket.close(); });
+    _group_sockets.clear();
+}
+
+void UDPServer::TryReceiveGroup(std::shared_ptr<GroupSocket> group_socket)
 {
-    // Clear send buffers
-    _send_buffer.clear();
+    if (!IsStarted() || !_continuous_receiving)
+        return;
+
+    // Async receive with the receive handler
+    auto self(this->shared_from_this());
+    auto async_receive_handler = make_alloc_handler(group_socket->receive_storage, [this, self, group_socket](std::error_code ec, size_t size)
+    {
+        if (!IsStarted() || !_continuous_receiving || !group_socket->socket.is_open())
+        {
+            // Release the last received session
+            group_socket->receive_session.reset();
+            return;
+        }
+
+        // Check for error
+        if (ec)
+        {
+            SendError(ec);
+
+            // Call the datagram received zero handler
+            onReceived(group_socket->receive_endpoint, group_socket->receive_buffer.data(), 0);
+        }
+        // Received some data from the client
+        else if (size > 0)
+        {
+            // Process the received datagram
+            ReceiveDatagram(group_socket->receive_endpoint, group_socket->receive_buffer.data(), size, group_socket->receive_session);
+
+            // If the receive buffer is full increase its size
+            if (group_socket->receive_buffer.size() == size)
+                group_socket->receive_buffer.resize(2 * size);
+        }
+
+        // Continue the receive loop
+        TryReceiveGroup(group_socket);
+    });
+    group_socket->socket.async_receive_from(asio::buffer(group_socket->receive_buffer.data(), group_socket->receive_buffer.size()), group_socket->receive_endpoint, bind_executor(group_socket->strand, async_receive_handler));
+}
+
+void UDPServer::TrySend()
+{
+    if (_sending)
+        return;
+
+    if (!IsStarted())
+        return;
+
+    // Swap send buffers
+    if (_send_datagrams_flush.empty())
+    {
+        std::scoped_lock locker(_send_lock);
+
+        // Swap flush and main buffers
+        _send_buffer_flush.swap(_send_buffer_main);
+        _send_datagrams_flush.swap(_send_datagrams_main);
+        _send_datagrams_flush_offset = 0;
+
+        // Update statistic
+        _bytes_pending = 0;
+        _bytes_sending += _send_buffer_flush.size();
+    }
+
+    // Check if the flush buffer is empty
+    if (_send_datagrams_flush.empty())
+        return;
+
+#if defined(__linux__)
+    // Batched send mode
+    if (_option_send_batch > 1)
+    {
+        TrySendBatch();
+        return;
+    }
+#endif
+
+    // Async send-to with the send-to handler
+    _sending = true;
+    auto self(this->shared_from_this());
+    auto async_send_to_handler = make_alloc_handler(_send_storage, [this, self](std::error_code ec, size_t sent)
+    {
+        _sending = false;
+
+        if (!IsStarted())
+            return;
+
+        // Check for error
+        if (ec)
+        {
+            SendError(ec);
+
+            // Drop the failed datagram
+            CompleteSend(0);
+        }
+        else
+        {
+            // Complete the sent datagram
+            CompleteSend(sent);
+        }
+
+        // Try to send the next datagram
+        TrySend();
+    });
+    auto& datagram = _send_datagrams_flush[_send_datagrams_flush_offset];
+    if (_strand_required)
+        _socket.async_send_to(asio::buffer(_send_buffer_flush.data() + datagram.offset, datagram.size), datagram.endpoint, bind_executor(_strand, async_send_to_handler));
+    else
+        _socket.async_send_to(asio::buffer(_send_buffer_flush.data() + datagram.offset, datagram.size), datagram.endpoint, async_send_to_handler);
+}
+
+#if defined(__linux__)
+void UDPServer::TrySendBatch()
+{
+    // Async wait for the socket write readiness with the send handler
+    _sending = true;
+    auto self(this->shared_from_this());
+    auto async_wait_handler = make_alloc_handler(_send_storage, [this, self](std::error_code ec)
+    {
+        if (!IsStarted())
+        {
+            _sending = false;
+            return;
+        }
+
+        // Send a batch of datagrams
+        if (!ec)
+        {
+            size_t count = std::min(_send_datagrams_flush.size() - _send_datagrams_flush_offset, _option_send_batch);
+            _send_batch_vectors.resize(count);
+            _send_batch_headers.resize(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto& datagram = _send_datagrams_flush[_send_datagrams_flush_offset + i];
+                _send_batch_vectors[i].iov_base = _send_buffer_flush.data() + datagram.offset;
+                _send_batch_vectors[i].iov_len = datagram.size;
+                _send_batch_headers[i] = mmsghdr();
+                _send_batch_headers[i].msg_hdr.msg_name = datagram.endpoint.data();
+                _send_batch_headers[i].msg_hdr.msg_namelen = (socklen_t)datagram.endpoint.size();
+                _send_batch_headers[i].msg_hdr.msg_iov = &_send_batch_vectors[i];
+                _send_batch_headers[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            int sent = ::sendmmsg(_socket.native_handle(), _send_batch_headers.data(), (unsigned)count, MSG_DONTWAIT);
+            if (sent < 0)
+            {
+                // Socket is not ready, wait for the write readiness again
+                if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))
+                {
+                    _sending = false;
+                    TrySend();
+                    return;
+                }
+
+                ec = std::error_code(errno, std::system_category());
+            }
+            else
+            {
+                // Release all sent datagrams before calling any handler, so
+                // the handler stopping the server cannot clear the flush
+                // buffer which is still in use
+                _send_batch_sent.clear();
+                for (int i = 0; i < sent; ++i)
+                    _send_batch_sent.push_back(ReleaseSend(_send_batch_headers[i].msg_len));
+
+                _sending = false;
+
+                // Call the datagram sent handlers for all sent datagrams
+                for (const auto& datagram : _send_batch_sent)
+                {
+                    if (!IsStarted())
+                        break;
+
+                    NotifySent(datagram);
+                }
+                _send_batch_sent.clear();
+
+                // Try to send the next batch of datagrams
+                TrySend();
+                return;
+            }
+        }
+
+        _sending = false;
+
+        SendError(ec);
+
+        // Drop the failed datagram
+        CompleteSend(0);
+
+        // Try to send the rest of pending datagrams
+        TrySend();
+    });
+    if (_strand_required)
+        _socket.async_wait(asio::ip::udp::socket::wait_write, bind_executor(_strand, async_wait_handler));
+    else
+        _socket.async_wait(asio::ip::udp::socket::wait_write, async_wait_handler);
+}
+#endif
+
+void UDPServer::CompleteSend(size_t sent)
+{
+    NotifySent(ReleaseSend(sent));
+}
+
+UDPServer::SentDatagram UDPServer::ReleaseSend(size_t sent)
+{
+    auto endpoint = _send_datagrams_flush[_send_datagrams_flush_offset].endpoint;
+    size_t size = _send_datagrams_flush[_send_datagrams_flush_offset].size;
+    auto session = std::move(_send_datagrams_flush[_send_datagrams_flush_offset].session);
 
     // Update statistic
-    _bytes_sending = 0;
+    _bytes_sending -= size;
+    _bytes_sent += sent;
+    if (sent > 0)
+        ++_datagrams_sent;
+
+    // Successfully send the whole flush buffer
+    if (++_send_datagrams_flush_offset == _send_datagrams_flush.size())
+    {
+        // Clear the flush buffer
+        _send_buffer_flush.clear();
+        _send_datagrams_flush.clear();
+        _send_datagrams_flush_offset = 0;
+    }
+
+    return SentDatagram{ endpoint, size, sent, std::move(session) };
+}
+
+void UDPServer::NotifySent(const SentDatagram& datagram)
+{
+    // Call the datagram sent handler
+    onSent(datagram.endpoint, datagram.sent);
+
+    // Call the datagram sent handler of the session
+    if (datagram.session)
+        datagram.session->CompleteSend(datagram.size, datagram.sent);
+}
+
+bool UDPServer::DisconnectAll()
+{
+    if (!IsStarted())
+        return false;
+
+    // Disconnect all sessions
+    for (auto& session : GetSessions())
+        session->Disconnect();
+
+    return true;
+}
+
+std::shared_ptr<UDPSession> UDPServer::FindSession(const asio::ip::udp::endpoint& endpoint)
+{
+    std::shared_lock<std::shared_mutex> locker(_sessions_lock);
+
+    // Try to find the required session
+    auto it = _sessions.find(endpoint);
+    return (it != _sessions.end()) ? it->second : nullptr;
+}
+
+std::vector<std::shared_ptr<UDPSession>> UDPServer::GetSessions()
+{
+    std::shared_lock<std::shared_mutex> locker(_sessions_lock);
+
+    std::vector<std::shared_ptr<UDPSession>> sessions;
+    sessions.reserve(_sessions.size());
+    for (auto& session : _sessions)
+        sessions.emplace_back(session.second);
+    return sessions;
+}
+
+void UDPServer::ReceiveDatagram(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size, std::shared_ptr<UDPSession>& session)
+{
+    // Update statistic
+    ++_datagrams_received;
+    _bytes_received += size;
+
+    // Dispatch the datagram to the session of the client endpoint
+    if (option_sessions())
+    {
+        // Lookup the sessions table only if the datagram is received from another client
+        if (!session || !session->IsConnected() || (session->_endpoint != endpoint))
+            session = RegisterSession(endpoint);
+        session->ReceiveDatagram(buffer, size);
+        return;
+    }
+
+    // Call the datagram received handler
+    onReceived(endpoint, buffer, size);
+}
+
+std::shared_ptr<UDPSession> UDPServer::RegisterSession(const asio::ip::udp::endpoint& endpoint)
+{
+    // Fast path for the existing session
+    auto session = FindSession(endpoint);
+    if (session)
+        return session;
+
+    // Connect a new session before registering it, so the session found
+    // by other sockets or disconnected by other threads is always connected
+    auto created = CreateSession(this->shared_from_this(), endpoint);
+    created->Connect();
+
+    {
+        std::unique_lock<std::shared_mutex> locker(_sessions_lock);
+
+        // Register the new session unless it was registered concurrently
+        session = _sessions.try_emplace(endpoint, created).first->second;
+    }
+
+    // Drop the new session which lost the concurrent registration, was
+    // disconnected by its connected handler or was registered after the
+    // server stopped disconnecting sessions
+    if ((session != created) || !created->IsConnected() || !IsStarted())
+    {
+        UnregisterSession(endpoint, created->id());
+        created->Disconnect();
+    }
+
+    return session;
+}
+
+void UDPServer::UnregisterSession(const asio::ip::udp::endpoint& endpoint, const CppCommon::UUID& id)
+{
+    std::unique_lock<std::shared_mutex> locker(_sessions_lock);
+
+    // Try to find the unregistered session, another session of the same endpoint should be kept
+    auto it = _sessions.find(endpoint);
+    if ((it != _sessions.end()) && (it->second->id() == id))
+    {
+        // Erase the session
+        _sessions.erase(it);
+    }
+}
+
+void UDPServer::ExpireSessions(const std::shared_ptr<Timer>& timer, bool canceled)
+{
+    if (canceled || !IsStarted())
+        return;
+
+    uint64_t timestamp = CppCommon::Timestamp::nano();
+    uint64_t timeout = option_session_timeout().total();
+
+    // Disconnect idle sessions
+    for (auto& session : GetSessions())
+    {
+        uint64_t activity = session->_activity;
+        if ((timestamp > activity) && ((timestamp - activity) >= timeout))
+            session->Disconnect();
+    }
+
+    // Restart the idle sessions expiration timer unless it was stopped or replaced by the server restart
+    std::shared_lock<std::shared_mutex> locker(_sessions_lock);
+    if (timer == _sessions_timer)
+    {
+        timer->Setup(CppCommon::Timespan(option_session_timeout().total() / 4));
+        timer->WaitAsync();
+    }
+}
+
+size_t UDPServer::EndpointHash::operator()(const asio::ip::udp::endpoint& endpoint) const noexcept
+{
+    // FNV-1a hash of the endpoint address and port
+    uint64_t hash = 14695981039346656037ull;
+    auto combine = [&hash](const uint8_t* data, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+            hash = (hash ^ data[i]) * 1099511628211ull;
+    };
+
+    if (endpoint.address().is_v4())
+    {
+        auto bytes = endpoint.address().to_v4().to_bytes();
+        combine(bytes.data(), bytes.size());
+    }
+    else
+    {
+        auto bytes = endpoint.address().to_v6().to_bytes();
+        combine(bytes.data(), bytes.size());
+    }
+
+    uint16_t port = endpoint.port();
+    combine((const uint8_t*)&port, sizeof(port));
+
+    return (size_t)hash;
+}
+
+void UDPServer::ClearBuffers()
+{
+    {
+        std::scoped_lock locker(_send_lock);
+
+        // Release pending bytes of sessions for all dropped datagrams
+        for (const auto& datagram : _send_datagrams_main)
+            if (datagram.session)
+                datagram.session->_bytes_pending -= datagram.size;
+        for (size_t i = _send_datagrams_flush_offset; i < _send_datagrams_flush.size(); ++i)
+            if (_send_datagrams_flush[i].session)
+                _send_datagrams_flush[i].session->_bytes_pending -= _send_datagrams_flush[i].size;
+
+        // Clear send buffers
+        _send_buffer_main.clear();
+        _send_buffer_flush.clear();
+        _send_datagrams_main.clear();
+        _send_datagrams_flush.clear();
+        _send_datagrams_flush_offset = 0;
+
+        // Update statistic
+        _bytes_pending = 0;
+        _bytes_sending = 0;
+    }
 }
 
 void UDPServer::SendError(std::error_code ec)
@@ -0,0 +1,116 @@
+/*!
+    \file udp_session.cpp
+    \brief UDP session implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/asio/udp_session.h"
+#include "server/asio/udp_server.h"
+
+#include "time/timestamp.h"
+
+namespace CppServer {
+namespace Asio {
+
+UDPSession::UDPSession(std::shared_ptr<UDPServer> server, const asio::ip::udp::endpoint& endpoint)
+    : _id(CppCommon::UUID::Random()),
+      _server(server),
+      _endpoint(endpoint),
+      _connected(false),
+      _activity(0),
+      _bytes_pending(0),
+      _bytes_sent(0),
+      _bytes_received(0),
+      _datagrams_sent(0),
+      _datagrams_received(0)
+{
+}
+
+void UDPSession::Connect()
+{
+    // Update the last activity timestamp
+    _activity = CppCommon::Timestamp::nano();
+
+    // Update the connected flag
+    _connected = true;
+
+    // Call the session connected handler
+    onConnected();
+
+    // Call the session connected handler in the server
+    auto connected_session(this->shared_from_this());
+    _server->onConnected(connected_session);
+}
+
+bool UDPSession::Disconnect()
+{
+    if (!_connected.exchange(false))
+        return false;
+
+    // Unregister the session
+    _server->UnregisterSession(_endpoint, _id);
+
+    // Call the session disconnected handler
+    onDisconnected();
+
+    // Call the session disconnected handler in the server
+    auto disconnected_session(this->shared_from_this());
+    _server->onDisconnected(disconnected_session);
+
+    return true;
+}
+
+size_t UDPSession::Send(const void* buffer, size_t size)
+{
+    if (!IsConnected())
+        return 0;
+
+    size_t sent = _server->Send(_endpoint, buffer, size);
+
+    // Update statistic
+    if (sent > 0)
+    {
+        ++_datagrams_sent;
+        _bytes_sent += sent;
+    }
+
+    return sent;
+}
+
+bool UDPSession::SendAsync(const void* buffer, size_t size)
+{
+    if (!IsConnected())
+        return false;
+
+    return _server->EnqueueSend(this->shared_from_this(), _endpoint, buffer, size);
+}
+
+void UDPSession::ReceiveDatagram(const void* buffer, size_t size)
+{
+    // Update the last activity timestamp
+    _activity = CppCommon::Timestamp::nano();
+
+    // Update statistic
+    ++_datagrams_received;
+    _bytes_received += size;
+
+    // Call the datagram received handler
+    onReceived(buffer, size);
+}
+
+void UDPSession::CompleteSend(size_t size, size_t sent)
+{
+    // Update statistic
+    _bytes_pending -= size;
+    _bytes_sent += sent;
+    if (sent > 0)
+        ++_datagrams_sent;
+
+    // Call the datagram sent handler
+    onSent(sent, _bytes_pending);
+}
+
+} // namespace Asio
+} // namespace CppServer
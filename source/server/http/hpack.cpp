@@ -0,0 +1,568 @@
+/*!
+    \file hpack.cpp
+    \brief HTTP/2 HPACK header compression implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/http/hpack.h"
+
+namespace CppServer {
+namespace HTTP {
+
+namespace {
+
+// HPACK static table (RFC 7541, Appendix A)
+const std::string_view static_table[HPACKTable::STATIC_COUNT][2] =
+{
+    { ":authority", "" },
+    { ":method", "GET" },
+    { ":method", "POST" },
+    { ":path", "/" },
+    { ":path", "/index.html" },
+    { ":scheme", "http" },
+    { ":scheme", "https" },
+    { ":status", "200" },
+    { ":status", "204" },
+    { ":status", "206" },
+    { ":status", "304" },
+    { ":status", "400" },
+    { ":status", "404" },
+    { ":status", "500" },
+    { "accept-charset", "" },
+    { "accept-encoding", "gzip, deflate" },
+    { "accept-language", "" },
+    { "accept-ranges", "" },
+    { "accept", "" },
+    { "access-control-allow-origin", "" },
+    { "age", "" },
+    { "allow", "" },
+    { "authorization", "" },
+    { "cache-control", "" },
+    { "content-disposition", "" },
+    { "content-encoding", "" },
+    { "content-language", "" },
+    { "content-length", "" },
+    { "content-location", "" },
+    { "content-range", "" },
+    { "content-type", "" },
+    { "cookie", "" },
+    { "date", "" },
+    { "etag", "" },
+    { "expect", "" },
+    { "expires", "" },
+    { "from", "" },
+    { "host", "" },
+    { "if-match", "" },
+    { "if-modified-since", "" },
+    { "if-none-match", "" },
+    { "if-range", "" },
+    { "if-unmodified-since", "" },
+    { "last-modified", "" },
+    { "link", "" },
+    { "location", "" },
+    { "max-forwards", "" },
+    { "proxy-authenticate", "" },
+    { "proxy-authorization", "" },
+    { "range", "" },
+    { "referer", "" },
+    { "refresh", "" },
+    { "retry-after", "" },
+    { "server", "" },
+    { "set-cookie", "" },
+    { "strict-transport-security", "" },
+    { "transfer-encoding", "" },
+    { "user-agent", "" },
+    { "vary", "" },
+    { "via", "" },
+    { "www-authenticate", "" },
+};
+
+// HPACK Huffman code (RFC 7541, Appendix B), the last symbol is EOS
+struct HuffmanCode
+{
+    uint32_t code;
+    uint8_t bits;
+};
+
+const HuffmanCode huffman_codes[257] =
+{
+    { 0x00001ff8, 13 }, { 0x007fffd8, 23 }, { 0x0fffffe2, 28 }, { 0x0fffffe3, 28 },
+    { 0x0fffffe4, 28 }, { 0x0fffffe5, 28 }, { 0x0fffffe6, 28 }, { 0x0fffffe7, 28 },
+    { 0x0fffffe8, 28 }, { 0x00ffffea, 24 }, { 0x3ffffffc, 30 }, { 0x0fffffe9, 28 },
+    { 0x0fffffea, 28 }, { 0x3ffffffd, 30 }, { 0x0fffffeb, 28 }, { 0x0fffffec, 28 },
+    { 0x0fffffed, 28 }, { 0x0fffffee, 28 }, { 0x0fffffef, 28 }, { 0x0ffffff0, 28 },
+    { 0x0ffffff1, 28 }, { 0x0ffffff2, 28 }, { 0x3ffffffe, 30 }, { 0x0ffffff3, 28 },
+    { 0x0ffffff4, 28 }, { 0x0ffffff5, 28 }, { 0x0ffffff6, 28 }, { 0x0ffffff7, 28 },
+    { 0x0ffffff8, 28 }, { 0x0ffffff9, 28 }, { 0x0ffffffa, 28 }, { 0x0ffffffb, 28 },
+    { 0x00000014,  6 }, { 0x000003f8, 10 }, { 0x000003f9, 10 }, { 0x00000ffa, 12 },
+    { 0x00001ff9, 13 }, { 0x00000015,  6 }, { 0x000000f8,  8 }, { 0x000007fa, 11 },
+    { 0x000003fa, 10 }, { 0x000003fb, 10 }, { 0x000000f9,  8 }, { 0x000007fb, 11 },
+    { 0x000000fa,  8 }, { 0x00000016,  6 }, { 0x00000017,  6 }, { 0x00000018,  6 },
+    { 0x00000000,  5 }, { 0x00000001,  5 }, { 0x00000002,  5 }, { 0x00000019,  6 },
+    { 0x0000001a,  6 }, { 0x0000001b,  6 }, { 0x0000001c,  6 }, { 0x0000001d,  6 },
+    { 0x0000001e,  6 }, { 0x0000001f,  6 }, { 0x0000005c,  7 }, { 0x000000fb,  8 },
+    { 0x00007ffc, 15 }, { 0x00000020,  6 }, { 0x00000ffb, 12 }, { 0x000003fc, 10 },
+    { 0x00001ffa, 13 }, { 0x00000021,  6 }, { 0x0000005d,  7 }, { 0x0000005e,  7 },
+    { 0x0000005f,  7 }, { 0x00000060,  7 }, { 0x00000061,  7 }, { 0x00000062,  7 },
+    { 0x00000063,  7 }, { 0x00000064,  7 }, { 0x00000065,  7 }, { 0x00000066,  7 },
+    { 0x00000067,  7 }, { 0x00000068,  7 }, { 0x00000069,  7 }, { 0x0000006a,  7 },
+    { 0x0000006b,  7 }, { 0x0000006c,  7 }, { 0x0000006d,  7 }, { 0x0000006e,  7 },
+    { 0x0000006f,  7 }, { 0x00000070,  7 }, { 0x00000071,  7 }, { 0x00000072,  7 },
+    { 0x000000fc,  8 }, { 0x00000073,  7 }, { 0x000000fd,  8 }, { 0x00001ffb, 13 },
+    { 0x0007fff0, 19 }, { 0x00001ffc, 13 }, { 0x00003ffc, 14 }, { 0x00000022,  6 },
+    { 0x00007ffd, 15 }, { 0x00000003,  5 }, { 0x00000023,  6 }, { 0x00000004,  5 },
+    { 0x00000024,  6 }, { 0x00000005,  5 }, { 0x00000025,  6 }, { 0x00000026,  6 },
+    { 0x00000027,  6 }, { 0x00000006,  5 }, { 0x00000074,  7 }, { 0x00000075,  7 },
+    { 0x00000028,  6 }, { 0x00000029,  6 }, { 0x0000002a,  6 }, { 0x00000007,  5 },
+    { 0x0000002b,  6 }, { 0x00000076,  7 }, { 0x0000002c,  6 }, { 0x00000008,  5 },
+    { 0x00000009,  5 }, { 0x0000002d,  6 }, { 0x00000077,  7 }, { 0x00000078,  7 },
+    { 0x00000079,  7 }, { 0x0000007a,  7 }, { 0x0000007b,  7 }, { 0x00007ffe, 15 },
+    { 0x000007fc, 11 }, { 0x00003ffd, 14 }, { 0x00001ffd, 13 }, { 0x0ffffffc, 28 },
+    { 0x000fffe6, 20 }, { 0x003fffd2, 22 }, { 0x000fffe7, 20 }, { 0x000fffe8, 20 },
+    { 0x003fffd3, 22 }, { 0x003fffd4, 22 }, { 0x003fffd5, 22 }, { 0x007fffd9, 23 },
+    { 0x003fffd6, 22 }, { 0x007fffda, 23 }, { 0x007fffdb, 23 }, { 0x007fffdc, 23 },
+    { 0x007fffdd, 23 }, { 0x007fffde, 23 }, { 0x00ffffeb, 24 }, { 0x007fffdf, 23 },
+    { 0x00ffffec, 24 }, { 0x00ffffed, 24 }, { 0x003fffd7, 22 }, { 0x007fffe0, 23 },
+    { 0x00ffffee, 24 }, { 0x007fffe1, 23 }, { 0x007fffe2, 23 }, { 0x007fffe3, 23 },
+    { 0x007fffe4, 23 }, { 0x001fffdc, 21 }, { 0x003fffd8, 22 }, { 0x007fffe5, 23 },
+    { 0x003fffd9, 22 }, { 0x007fffe6, 23 }, { 0x007fffe7, 23 }, { 0x00ffffef, 24 },
+    { 0x003fffda, 22 }, { 0x001fffdd, 21 }, { 0x000fffe9, 20 }, { 0x003fffdb, 22 },
+    { 0x003fffdc, 22 }, { 0x007fffe8, 23 }, { 0x007fffe9, 23 }, { 0x001fffde, 21 },
+    { 0x007fffea, 23 }, { 0x003fffdd, 22 }, { 0x003fffde, 22 }, { 0x00fffff0, 24 },
+    { 0x001fffdf, 21 }, { 0x003fffdf, 22 }, { 0x007fffeb, 23 }, { 0x007fffec, 23 },
+    { 0x001fffe0, 21 }, { 0x001fffe1, 21 }, { 0x003fffe0, 22 }, { 0x001fffe2, 21 },
+    { 0x007fffed, 23 }, { 0x003fffe1, 22 }, { 0x007fffee, 23 }, { 0x007fffef, 23 },
+    { 0x000fffea, 20 }, { 0x003fffe2, 22 }, { 0x003fffe3, 22 }, { 0x003fffe4, 22 },
+    { 0x007ffff0, 23 }, { 0x003fffe5, 22 }, { 0x003fffe6, 22 }, { 0x007ffff1, 23 },
+    { 0x03ffffe0, 26 }, { 0x03ffffe1, 26 }, { 0x000fffeb, 20 }, { 0x0007fff1, 19 },
+    { 0x003fffe7, 22 }, { 0x007ffff2, 23 }, { 0x003fffe8, 22 }, { 0x01ffffec, 25 },
+    { 0x03ffffe2, 26 }, { 0x03ffffe3, 26 }, { 0x03ffffe4, 26 }, { 0x07ffffde, 27 },
+    { 0x07ffffdf, 27 }, { 0x03ffffe5, 26 }, { 0x00fffff1, 24 }, { 0x01ffffed, 25 },
+    { 0x0007fff2, 19 }, { 0x001fffe3, 21 }, { 0x03ffffe6, 26 }, { 0x07ffffe0, 27 },
+    { 0x07ffffe1, 27 }, { 0x03ffffe7, 26 }, { 0x07ffffe2, 27 }, { 0x00fffff2, 24 },
+    { 0x001fffe4, 21 }, { 0x001fffe5, 21 }, { 0x03ffffe8, 26 }, { 0x03ffffe9, 26 },
+    { 0x0ffffffd, 28 }, { 0x07ffffe3, 27 }, { 0x07ffffe4, 27 }, { 0x07ffffe5, 27 },
+    { 0x000fffec, 20 }, { 0x00fffff3, 24 }, { 0x000fffed, 20 }, { 0x001fffe6, 21 },
+    { 0x003fffe9, 22 }, { 0x001fffe7, 21 }, { 0x001fffe8, 21 }, { 0x007ffff3, 23 },
+    { 0x003fffea, 22 }, { 0x003fffeb, 22 }, { 0x01ffffee, 25 }, { 0x01ffffef, 25 },
+    { 0x00fffff4, 24 }, { 0x00fffff5, 24 }, { 0x03ffffea, 26 }, { 0x007ffff4, 23 },
+    { 0x03ffffeb, 26 }, { 0x07ffffe6, 27 }, { 0x03ffffec, 26 }, { 0x03ffffed, 26 },
+    { 0x07ffffe7, 27 }, { 0x07ffffe8, 27 }, { 0x07ffffe9, 27 }, { 0x07ffffea, 27 },
+    { 0x07ffffeb, 27 }, { 0x0ffffffe, 28 }, { 0x07ffffec, 27 }, { 0x07ffffed, 27 },
+    { 0x07ffffee, 27 }, { 0x07ffffef, 27 }, { 0x07fffff0, 27 }, { 0x03ffffee, 26 },
+    { 0x3fffffff, 30 },
+};
+
+// Huffman decoding tree built from the Huffman code
+class HuffmanTree
+{
+public:
+    struct Node
+    {
+        int16_t children[2];
+        int16_t symbol;
+    };
+
+    HuffmanTree()
+    {
+        _nodes.push_back({ { -1, -1 }, -1 });
+        for (int16_t symbol = 0; symbol < 257; ++symbol)
+        {
+            size_t node = 0;
+            const HuffmanCode& code = huffman_codes[symbol];
+            for (int bit = code.bits - 1; bit >= 0; --bit)
+            {
+                int index = (code.code >> bit) & 1;
+                if (_nodes[node].children[index] < 0)
+                {
+                    _nodes[node].children[index] = (int16_t)_nodes.size();
+                    _nodes.push_back({ { -1, -1 }, -1 });
+                }
+                node = _nodes[node].children[index];
+            }
+            _nodes[node].symbol = symbol;
+        }
+    }
+
+    const Node& operator[](size_t index) const noexcept { return _nodes[index]; }
+
+    static const HuffmanTree& instance()
+    {
+        static HuffmanTree tree;
+        return tree;
+    }
+
+private:
+    std::vector<Node> _nodes;
+};
+
+// Encode HPACK integer with the given prefix size
+void EncodeInteger(std::string& output, uint8_t flags, int prefix, size_t value)
+{
+    size_t max = ((size_t)1 << prefix) - 1;
+    if (value < max)
+    {
+        output.push_back((char)(flags | value));
+        return;
+    }
+
+    output.push_back((char)(flags | max));
+    value -= max;
+    while (value >= 0x80)
+    {
+        output.push_back((char)((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    output.push_back((char)value);
+}
+
+// Decode HPACK integer with the given prefix size
+bool DecodeInteger(const uint8_t*& data, const uint8_t* end, int prefix, size_t& value)
+{
+    if (data >= end)
+        return false;
+
+    size_t max = ((size_t)1 << prefix) - 1;
+    value = *data++ & max;
+    if (value < max)
+        return true;
+
+    // Protect the integer from overflow
+    for (int shift = 0; (data < end) && (shift < 28); shift += 7)
+    {
+        uint8_t byte = *data++;
+        value += (size_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+// Encode HPACK string literal (Huffman encoded if it is shorter)
+void EncodeString(std::string& output, std::string_view str)
+{
+    size_t huffman_size = HPACKHuffman::EncodedSize(str);
+    if (huffman_size < str.size())
+    {
+        EncodeInteger(output, 0x80, 7, huffman_size);
+        HPACKHuffman::Encode(output, str);
+    }
+    else
+    {
+        EncodeInteger(output, 0x00, 7, str.size());
+        output.append(str);
+    }
+}
+
+// Decode HPACK string literal
+bool DecodeString(const uint8_t*& data, const uint8_t* end, std::string& str)
+{
+    if (data >= end)
+        return false;
+
+    bool huffman = (*data & 0x80) != 0;
+    size_t size;
+    if (!DecodeInteger(data, end, 7, size) || (size > (size_t)(end - data)))
+        return false;
+
+    str.clear();
+    if (huffman)
+    {
+        if (!HPACKHuffman::Decode(str, data, size))
+            return false;
+    }
+    else
+        str.assign((const char*)data, size);
+
+    data += size;
+    return true;
+}
+
+} // namespace
+
+bool HPACKTable::Get(size_t index, std::string_view& name, std::string_view& value) const noexcept
+{
+    if (index == 0)
+        return false;
+
+    if (index <= STATIC_COUNT)
+    {
+        name = static_table[index - 1][0];
+        value = static_table[index - 1][1];
+        return true;
+    }
+
+    index -= STATIC_COUNT + 1;
+    if (index >= _entries.size())
+        return false;
+
+    name = _entries[index].first;
+    value = _entries[index].second;
+    return true;
+}
+
+size_t HPACKTable::Find(std::string_view name, std::string_view value, size_t& name_index) const noexcept
+{
+    name_index = 0;
+
+    for (size_t i = 0; i < STATIC_COUNT; ++i)
+    {
+        if (static_table[i][0] != name)
+            continue;
+        if (static_table[i][1] == value)
+            return i + 1;
+        if (name_index == 0)
+            name_index = i + 1;
+    }
+
+    for (size_t i = 0; i < _entries.size(); ++i)
+    {
+        if (_entries[i].first != name)
+            continue;
+        if (_entries[i].second == value)
+            return STATIC_COUNT + i + 1;
+        if (name_index == 0)
+            name_index = STATIC_COUNT + i + 1;
+    }
+
+    return 0;
+}
+
+void HPACKTable::Add(std::string_view name, std::string_view value)
+{
+    size_t size = name.size() + value.size() + 32;
+
+    // Entry larger than the table empties the table
+    if (size > _max_size)
+    {
+        Evict(0);
+        return;
+    }
+
+    Evict(_max_size - size);
+    _entries.emplace_front(std::string(name), std::string(value));
+    _size += size;
+}
+
+void HPACKTable::Resize(size_t max_size)
+{
+    _max_size = max_size;
+    Evict(max_size);
+}
+
+void HPACKTable::Evict(size_t max_size)
+{
+    while ((_size > max_size) && !_entries.empty())
+    {
+        _size -= _entries.back().first.size() + _entries.back().second.size() + 32;
+        _entries.pop_back();
+    }
+}
+
+bool HPACKDecoder::Decode(const void* buffer, size_t size, HPACKHeaders& headers)
+{
+    const uint8_t* data = (const uint8_t*)buffer;
+    const uint8_t* end = data + size;
+
+    std::string name;
+    std::string value;
+    size_t list_size = 0;
+    bool fields = false;
+
+    _overflow = false;
+
+    while (data < end)
+    {
+        uint8_t byte = *data;
+
+        // Indexed header field
+        if (byte & 0x80)
+        {
+            size_t index;
+            std::string_view indexed_name;
+            std::string_view indexed_value;
+            if (!DecodeInteger(data, end, 7, index) || !_table.Get(index, indexed_name, indexed_value))
+                return false;
+            if (!Account(list_size, indexed_name.size(), indexed_value.size()))
+                return false;
+            headers.emplace_back(std::string(indexed_name), std::string(indexed_value));
+            fields = true;
+            continue;
+        }
+
+        // Dynamic table size update is allowed only at the beginning of the header block
+        if ((byte & 0xE0) == 0x20)
+        {
+            size_t max_size;
+            if (fields || !DecodeInteger(data, end, 5, max_size) || (max_size > _max_table_size))
+                return false;
+            _table.Resize(max_size);
+            continue;
+        }
+
+        // Literal header field with incremental indexing, without indexing or never indexed
+        bool indexing = (byte & 0xC0) == 0x40;
+        size_t index;
+        if (!DecodeInteger(data, end, indexing ? 6 : 4, index))
+            return false;
+
+        if (index > 0)
+        {
+            std::string_view indexed_name;
+            std::string_view indexed_value;
+            if (!_table.Get(index, indexed_name, indexed_value))
+                return false;
+            name.assign(indexed_name);
+        }
+        else if (!DecodeString(data, end, name))
+            return false;
+
+        if (!DecodeString(data, end, value))
+            return false;
+
+        if (!Account(list_size, name.size(), value.size()))
+            return false;
+
+        if (indexing)
+            _table.Add(name, value);
+
+        headers.emplace_back(name, value);
+        fields = true;
+    }
+
+    return true;
+}
+
+bool HPACKDecoder::Account(size_t& list_size, size_t name_size, size_t value_size) noexcept
+{
+    list_size += name_size + value_size + 32;
+    if ((_max_header_list_size > 0) && (list_size > _max_header_list_size))
+    {
+        _overflow = true;
+        return false;
+    }
+    return true;
+}
+
+void HPACKEncoder::SetMaxTableSize(size_t max_table_size)
+{
+    if (max_table_size == _table.max_size())
+        return;
+
+    _table.Resize(max_table_size);
+    _size_update = true;
+}
+
+void HPACKEncoder::Encode(std::string& output, std::string_view name, std::string_view value)
+{
+    // Dynamic table size update at the beginning of the header block
+    if (_size_update)
+    {
+        EncodeInteger(output, 0x20, 5, _table.max_size());
+        _size_update = false;
+    }
+
+    size_t name_index;
+    size_t index = _table.Find(name, value, name_index);
+
+    // Indexed header field
+    if (index > 0)
+    {
+        EncodeInteger(output, 0x80, 7, index);
+        return;
+    }
+
+    // Authorization credentials are never indexed, large values would flush the dynamic table
+    bool sensitive = (name == "authorization") || (name == "proxy-authorization");
+    bool indexing = !sensitive && ((name.size() + value.size() + 32) <= (_table.max_size() / 2));
+
+    if (indexing)
+        EncodeInteger(output, 0x40, 6, name_index);
+    else
+        EncodeInteger(output, sensitive ? 0x10 : 0x00, 4, name_index);
+
+    if (name_index == 0)
+        EncodeString(output, name);
+    EncodeString(output, value);
+
+    if (indexing)
+        _table.Add(name, value);
+}
+
+size_t HPACKHuffman::EncodedSize(std::string_view str) noexcept
+{
+    size_t bits = 0;
+    for (unsigned char ch : str)
+        bits += huffman_codes[ch].bits;
+    return (bits + 7) / 8;
+}
+
+void HPACKHuffman::Encode(std::string& output, std::string_view str)
+{
+    uint64_t buffer = 0;
+    int bits = 0;
+
+    for (unsigned char ch : str)
+    {
+        const HuffmanCode& code = huffman_codes[ch];
+        buffer = (buffer << code.bits) | code.code;
+        bits += code.bits;
+        while (bits >= 8)
+        {
+            bits -= 8;
+            output.push_back((char)(buffer >> bits));
+        }
+    }
+
+    // Pad the last byte with the most significant bits of EOS
+    if (bits > 0)
+        output.push_back((char)((buffer << (8 - bits)) | (0xFF >> bits)));
+}
+
+bool HPACKHuffman::Decode(std::string& output, const void* buffer, size_t size)
+{
+    const HuffmanTree& tree = HuffmanTree::instance();
+    const uint8_t* data = (const uint8_t*)buffer;
+
+    size_t node = 0;
+    int padding = 0;
+    bool ones = true;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        uint8_t byte = data[i];
+        for (int bit = 7; bit >= 0; --bit)
+        {
+            int index = (byte >> bit) & 1;
+            int16_t child = tree[node].children[index];
+            if (child < 0)
+                return false;
+
+            ++padding;
+            ones = ones && (index == 1);
+
+            const HuffmanTree::Node& next = tree[child];
+            if (next.symbol >= 0)
+            {
+                // EOS symbol should not be decoded
+                if (next.symbol == 256)
+                    return false;
+                output.push_back((char)next.symbol);
+                node = 0;
+                padding = 0;
+                ones = true;
+            }
+            else
+                node = child;
+        }
+    }
+
+    // Padding should be the most significant bits of EOS and shorter than 8 bits
+    return (padding < 8) && ones;
+}
+
+} // namespace HTTP
+} // namespace CppServer
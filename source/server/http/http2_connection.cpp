@@ -0,0 +1,1265 @@
+/*!
+    \file http2_connection.cpp
+    \brief HTTP/2 connection implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/http/http2_connection.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace CppServer {
+namespace HTTP {
+
+namespace {
+
+// Client connection preface
+const char PREFACE[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+const size_t PREFACE_SIZE = sizeof(PREFACE) - 1;
+
+// Frame types
+const uint8_t FRAME_DATA = 0x0;
+const uint8_t FRAME_HEADERS = 0x1;
+const uint8_t FRAME_PRIORITY = 0x2;
+const uint8_t FRAME_RST_STREAM = 0x3;
+const uint8_t FRAME_SETTINGS = 0x4;
+const uint8_t FRAME_PUSH_PROMISE = 0x5;
+const uint8_t FRAME_PING = 0x6;
+const uint8_t FRAME_GOAWAY = 0x7;
+const uint8_t FRAME_WINDOW_UPDATE = 0x8;
+const uint8_t FRAME_CONTINUATION = 0x9;
+
+// Frame flags
+const uint8_t FLAG_END_STREAM = 0x1;
+const uint8_t FLAG_ACK = 0x1;
+const uint8_t FLAG_END_HEADERS = 0x4;
+const uint8_t FLAG_PADDED = 0x8;
+const uint8_t FLAG_PRIORITY = 0x20;
+
+// Settings
+const uint16_t SETTINGS_HEADER_TABLE_SIZE = 0x1;
+const uint16_t SETTINGS_ENABLE_PUSH = 0x2;
+const uint16_t SETTINGS_MAX_CONCURRENT_STREAMS = 0x3;
+const uint16_t SETTINGS_INITIAL_WINDOW_SIZE = 0x4;
+const uint16_t SETTINGS_MAX_FRAME_SIZE = 0x5;
+const uint16_t SETTINGS_MAX_HEADER_LIST_SIZE = 0x6;
+
+// Error codes
+const uint32_t NO_ERROR = 0x0;
+const uint32_t PROTOCOL_ERROR = 0x1;
+const uint32_t FLOW_CONTROL_ERROR = 0x3;
+const uint32_t STREAM_CLOSED = 0x5;
+const uint32_t FRAME_SIZE_ERROR = 0x6;
+const uint32_t REFUSED_STREAM = 0x7;
+const uint32_t CANCEL = 0x8;
+const uint32_t COMPRESSION_ERROR = 0x9;
+const uint32_t ENHANCE_YOUR_CALM = 0xB;
+
+// Protocol limits
+const size_t DEFAULT_MAX_FRAME_SIZE = 16384;
+const int64_t DEFAULT_WINDOW_SIZE = 65535;
+const int64_t MAX_WINDOW_SIZE = 0x7FFFFFFF;
+const size_t MAX_TABLE_SIZE = 4096;
+
+// Local settings
+const size_t LOCAL_MAX_STREAMS = 128;
+const int64_t LOCAL_STREAM_WINDOW = 1 << 20;
+const int64_t LOCAL_CONNECTION_WINDOW = 1 << 24;
+const size_t LOCAL_MAX_HEADER_BLOCK = 256 * 1024;
+const size_t LOCAL_MAX_HEADER_LIST = 256 * 1024;
+
+uint32_t ReadUInt32(const uint8_t* data)
+{
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+}
+
+void WriteUInt32(std::string& output, uint32_t value)
+{
+    output.push_back((char)(value >> 24));
+    output.push_back((char)(value >> 16));
+    output.push_back((char)(value >> 8));
+    output.push_back((char)value);
+}
+
+void WriteSetting(std::string& output, uint16_t id, uint32_t value)
+{
+    output.push_back((char)(id >> 8));
+    output.push_back((char)id);
+    WriteUInt32(output, value);
+}
+
+// Find the header field value by name
+std::string_view FindHeader(const HPACKHeaders& headers, std::string_view name)
+{
+    for (const auto& header : headers)
+        if (header.first == name)
+            return header.second;
+    return std::string_view();
+}
+
+// Compare header names case insensitive
+bool EqualName(std::string_view name1, std::string_view name2)
+{
+    if (name1.size() != name2.size())
+        return false;
+    for (size_t i = 0; i < name1.size(); ++i)
+        if (std::tolower((unsigned char)name1[i]) != name2[i])
+            return false;
+    return true;
+}
+
+// Connection specific header fields are not allowed in HTTP/2
+bool IsConnectionHeader(std::string_view name)
+{
+    return (name == "connection") || (name == "keep-alive") || (name == "proxy-connection") || (name == "transfer-encoding") || (name == "upgrade");
+}
+
+} // namespace
+
+HTTP2Connection::HTTP2Connection(bool server)
+    : _server(server),
+      _error(false),
+      _settings_received(false),
+      _goaway_sent(false),
+      _goaway_received(false),
+      _preface(server ? 0 : PREFACE_SIZE),
+      _next_stream(server ? 2 : 1),
+      _last_peer_stream(0),
+      _remote_max_streams(LOCAL_MAX_STREAMS),
+      _remote_max_frame_size(DEFAULT_MAX_FRAME_SIZE),
+      _remote_initial_window(DEFAULT_WINDOW_SIZE),
+      _send_window(DEFAULT_WINDOW_SIZE),
+      _recv_window(DEFAULT_WINDOW_SIZE),
+      _encoder(MAX_TABLE_SIZE),
+      _decoder(MAX_TABLE_SIZE, LOCAL_MAX_HEADER_LIST),
+      _continuation_stream(0),
+      _continuation_end(false),
+      _option_max_header_size(0),
+      _option_max_headers(0),
+      _option_max_body_size(0)
+{
+}
+
+void HTTP2Connection::Start()
+{
+    if (!_server)
+        _output.append(PREFACE, PREFACE_SIZE);
+
+    // Initial settings
+    std::string settings;
+    if (_server)
+        WriteSetting(settings, SETTINGS_MAX_CONCURRENT_STREAMS, (uint32_t)LOCAL_MAX_STREAMS);
+    else
+        WriteSetting(settings, SETTINGS_ENABLE_PUSH, 0);
+    WriteSetting(settings, SETTINGS_INITIAL_WINDOW_SIZE, (uint32_t)LOCAL_STREAM_WINDOW);
+    WriteSetting(settings, SETTINGS_MAX_HEADER_LIST_SIZE, (uint32_t)LOCAL_MAX_HEADER_LIST);
+    WriteFrame(FRAME_SETTINGS, 0, 0, settings.data(), settings.size());
+
+    // Enlarge the connection receive window
+    WriteWindowUpdate(0, (uint32_t)(LOCAL_CONNECTION_WINDOW - _recv_window));
+    _recv_window = LOCAL_CONNECTION_WINDOW;
+
+    Flush();
+}
+
+bool HTTP2Connection::Receive(const void* buffer, size_t size)
+{
+    if (_error)
+        return false;
+
+    // Append the data to the incomplete frame or parse it in place
+    const uint8_t* data = (const uint8_t*)buffer;
+    if (!_input.empty())
+    {
+        _input.append((const char*)buffer, size);
+        data = (const uint8_t*)_input.data();
+        size = _input.size();
+    }
+
+    size_t offset = 0;
+
+    // Check the client connection preface
+    while ((_preface < PREFACE_SIZE) && (offset < size))
+    {
+        if (data[offset++] != (uint8_t)PREFACE[_preface++])
+        {
+            Fail(PROTOCOL_ERROR);
+            break;
+        }
+    }
+
+    // Process complete frames
+    while (!_error && (_preface == PREFACE_SIZE) && ((size - offset) >= 9))
+    {
+        const uint8_t* header = data + offset;
+        size_t length = ((size_t)header[0] << 16) | ((size_t)header[1] << 8) | (size_t)header[2];
+        uint8_t type = header[3];
+        uint8_t flags = header[4];
+        uint32_t stream = ReadUInt32(header + 5) & 0x7FFFFFFF;
+
+        if (length > DEFAULT_MAX_FRAME_SIZE)
+        {
+            Fail(FRAME_SIZE_ERROR);
+            break;
+        }
+
+        // Wait for the rest of the frame
+        if ((size - offset) < (9 + length))
+            break;
+
+        offset += 9 + length;
+        ProcessFrame(type, flags, stream, header + 9, length);
+    }
+
+    // Keep the incomplete frame
+    if (_error)
+        _input.clear();
+    else if (_input.empty())
+    {
+        if (offset < size)
+            _input.assign((const char*)data + offset, size - offset);
+    }
+    else
+        _input.erase(0, offset);
+
+    Flush();
+
+    return !_error;
+}
+
+uint32_t HTTP2Connection::SendRequest(const HTTPRequest& request)
+{
+    if (_server || _error || IsGoingAway() || (_next_stream > MAX_WINDOW_SIZE))
+        return 0;
+
+    uint32_t id = _next_stream;
+    _next_stream += 2;
+
+    Stream& stream = _streams[id];
+    stream.head = (request.method() == "HEAD");
+    stream.send_window = _remote_initial_window;
+    stream.recv_window = LOCAL_STREAM_WINDOW;
+
+    // Find the request authority
+    std::string_view authority;
+    for (size_t i = 0; i < request.headers(); ++i)
+    {
+        auto [name, value] = request.header(i);
+        if (EqualName(name, "host"))
+            authority = value;
+    }
+
+    std::string block;
+    _encoder.Encode(block, ":method", request.method());
+    _encoder.Encode(block, ":scheme", "https");
+    if (!authority.empty())
+        _encoder.Encode(block, ":authority", authority);
+    _encoder.Encode(block, ":path", request.url());
+    for (size_t i = 0; i < request.headers(); ++i)
+    {
+        auto [name, value] = request.header(i);
+        if (!EqualName(name, "host"))
+            EncodeHeader(block, name, value);
+    }
+
+    SendMessage(id, stream, block, request.body(), request.body_length(), request.chunked());
+    Flush();
+
+    return id;
+}
+
+bool HTTP2Connection::SendResponse(uint32_t id, const HTTPResponse& response)
+{
+    if (!_server || _error)
+        return false;
+
+    auto it = _streams.find(id);
+    if ((it == _streams.end()) || it->second.headers_sent)
+        return false;
+
+    Stream& stream = it->second;
+
+    std::string block;
+    _encoder.Encode(block, ":status", std::to_string(response.status()));
+    for (size_t i = 0; i < response.headers(); ++i)
+    {
+        auto [name, value] = response.header(i);
+        EncodeHeader(block, name, value);
+    }
+
+    // Interim response is followed by the final one
+    if ((response.status() >= 100) && (response.status() < 200))
+    {
+        WriteHeaders(id, block, false);
+        Flush();
+        return true;
+    }
+
+    // Response to HEAD request has no body
+    if (stream.head)
+    {
+        stream.headers_sent = true;
+        stream.end_sent = true;
+        WriteHeaders(id, block, true);
+    }
+    else
+        SendMessage(id, stream, block, response.body(), response.body_length(), response.chunked());
+
+    Close(id);
+    Flush();
+
+    return true;
+}
+
+bool HTTP2Connection::SendBody(uint32_t id, const void* buffer, size_t size)
+{
+    if (_error)
+        return false;
+
+    auto it = _streams.find(id);
+    if ((it == _streams.end()) || !it->second.headers_sent || it->second.end_sent || it->second.pending_end)
+        return false;
+
+    Stream& stream = it->second;
+
+    if (stream.chunked)
+        SendData(id, stream, buffer, size, (size == 0));
+    else
+    {
+        if (size > stream.remaining)
+            return false;
+        stream.remaining -= size;
+        SendData(id, stream, buffer, size, (stream.remaining == 0));
+    }
+
+    Close(id);
+    Flush();
+
+    return true;
+}
+
+void HTTP2Connection::ResetStream(uint32_t id)
+{
+    auto it = _streams.find(id);
+    if (it == _streams.end())
+        return;
+
+    _streams.erase(it);
+
+    if (!_error)
+    {
+        WriteResetStream(id, CANCEL);
+        Flush();
+    }
+}
+
+void HTTP2Connection::Shutdown()
+{
+    if (_error || _goaway_sent)
+        return;
+
+    WriteGoAway(NO_ERROR);
+    Flush();
+}
+
+void HTTP2Connection::ProcessFrame(uint8_t type, uint8_t flags, uint32_t stream, const uint8_t* payload, size_t size)
+{
+    // Header block should not be interleaved with other frames
+    if ((_continuation_stream != 0) && (type != FRAME_CONTINUATION))
+    {
+        Fail(PROTOCOL_ERROR);
+        return;
+    }
+
+    // The first frame of the peer should be SETTINGS
+    if (!_settings_received && (type != FRAME_SETTINGS))
+    {
+        Fail(PROTOCOL_ERROR);
+        return;
+    }
+
+    switch (type)
+    {
+        case FRAME_DATA:
+            ProcessData(flags, stream, payload, size);
+            break;
+        case FRAME_HEADERS:
+            ProcessHeaders(flags, stream, payload, size);
+            break;
+        case FRAME_PRIORITY:
+            // Stream priorities are not used
+            if (stream == 0)
+                Fail(PROTOCOL_ERROR);
+            else if (size != 5)
+                Fail(stream, FRAME_SIZE_ERROR, "Invalid HTTP/2 PRIORITY frame!");
+            break;
+        case FRAME_RST_STREAM:
+            ProcessResetStream(stream, payload, size);
+            break;
+        case FRAME_SETTINGS:
+            ProcessSettings(flags, stream, payload, size);
+            break;
+        case FRAME_PUSH_PROMISE:
+            // Server push is disabled
+            Fail(PROTOCOL_ERROR);
+            break;
+        case FRAME_PING:
+            ProcessPing(flags, stream, payload, size);
+            break;
+        case FRAME_GOAWAY:
+            ProcessGoAway(stream, payload, size);
+            break;
+        case FRAME_WINDOW_UPDATE:
+            ProcessWindowUpdate(stream, payload, size);
+            break;
+        case FRAME_CONTINUATION:
+        {
+            if ((_continuation_stream == 0) || (stream != _continuation_stream))
+            {
+                Fail(PROTOCOL_ERROR);
+                return;
+            }
+            if ((_header_block.size() + size) > LOCAL_MAX_HEADER_BLOCK)
+            {
+                Fail(ENHANCE_YOUR_CALM);
+                return;
+            }
+            _header_block.append((const char*)payload, size);
+            if (flags & FLAG_END_HEADERS)
+            {
+                _continuation_stream = 0;
+                ProcessHeaderBlock(stream, _continuation_end);
+            }
+            break;
+        }
+        default:
+            // Unknown frames are ignored
+            break;
+    }
+}
+
+void HTTP2Connection::ProcessData(uint8_t flags, uint32_t id, const uint8_t* payload, size_t size)
+{
+    if (id == 0)
+    {
+        Fail(PROTOCOL_ERROR);
+        return;
+    }
+
+    // Padded data
+    const uint8_t* data = payload;
+    size_t length = size;
+    if (flags & FLAG_PADDED)
+    {
+        if ((size == 0) || (payload[0] >= size))
+        {
+            Fail(PROTOCOL_ERROR);
+            return;
+        }
+        data = payload + 1;
+        length = size - 1 - payload[0];
+    }
+
+    // The whole frame is counted by the connection flow control
+    if ((int64_t)size > _recv_window)
+    {
+        Fail(FLOW_CONTROL_ERROR);
+        return;
+    }
+    _recv_window -= size;
+    if (_recv_window < (LOCAL_CONNECTION_WINDOW / 2))
+    {
+        WriteWindowUpdate(0, (uint32_t)(LOCAL_CONNECTION_WINDOW - _recv_window));
+        _recv_window = LOCAL_CONNECTION_WINDOW;
+    }
+
+    auto it = _streams.find(id);
+    if ((it == _streams.end()) || it->second.end_received)
+    {
+        if (IsIdle(id))
+            Fail(PROTOCOL_ERROR);
+        else
+            WriteResetStream(id, STREAM_CLOSED);
+        return;
+    }
+
+    Stream& stream = it->second;
+
+    if (!stream.headers_received)
+    {
+        Fail(id, PROTOCOL_ERROR, "Invalid HTTP/2 DATA frame!");
+        return;
+    }
+
+    if ((int64_t)size > stream.recv_window)
+    {
+        Fail(id, FLOW_CONTROL_ERROR, "HTTP/2 stream flow control error!");
+        return;
+    }
+    stream.recv_window -= size;
+
+    // Check the received body against the body size limit
+    if ((_option_max_body_size > 0) && ((stream.body.size() + length) > _option_max_body_size))
+    {
+        Reject(id, 413, "HTTP/2 message body is too large!");
+        return;
+    }
+
+    stream.body.append((const char*)data, length);
+
+    if (flags & FLAG_END_STREAM)
+    {
+        Complete(id);
+        return;
+    }
+
+    // Replenish the stream receive window
+    if (stream.recv_window < (LOCAL_STREAM_WINDOW / 2))
+    {
+        WriteWindowUpdate(id, (uint32_t)(LOCAL_STREAM_WINDOW - stream.recv_window));
+        stream.recv_window = LOCAL_STREAM_WINDOW;
+    }
+}
+
+void HTTP2Connection::ProcessHeaders(uint8_t flags, uint32_t id, const uint8_t* payload, size_t size)
+{
+    if (id == 0)
+    {
+        Fail(PROTOCOL_ERROR);
+        return;
+    }
+
+    const uint8_t* data = payload;
+    size_t length = size;
+
+    // Padded header block
+    size_t padding = 0;
+    if (flags & FLAG_PADDED)
+    {
+        if (length == 0)
+        {
+            Fail(PROTOCOL_ERROR);
+            return;
+        }
+        padding = data[0];
+        ++data;
+        --length;
+    }
+
+    // Stream priority is skipped
+    if (flags & FLAG_PRIORITY)
+    {
+        if (length < 5)
+        {
+            Fail(PROTOCOL_ERROR);
+            return;
+        }
+        data += 5;
+        length -= 5;
+    }
+
+    if (padding > length)
+    {
+        Fail(PROTOCOL_ERROR);
+        return;
+    }
+    length -= padding;
+
+    _header_block.assign((const char*)data, length);
+
+    // Wait for CONTINUATION frames
+    if ((flags & FLAG_END_HEADERS) == 0)
+    {
+        _continuation_stream = id;
+        _continuation_end = (flags & FLAG_END_STREAM) != 0;
+        return;
+    }
+
+    ProcessHeaderBlock(id, (flags & FLAG_END_STREAM) != 0);
+}
+
+void HTTP2Connection::ProcessHeaderBlock(uint32_t id, bool end)
+{
+    // Header block is always decoded to keep the decoder state
+    HPACKHeaders headers;
+    bool decoded = _decoder.Decode(_header_block.data(), _header_block.size(), headers);
+    _header_block.clear();
+    if (!decoded)
+    {
+        // Decoding of too large header list is interrupted, so the decoder state is lost
+        Fail(_decoder.overflow() ? ENHANCE_YOUR_CALM : COMPRESSION_ERROR);
+        return;
+    }
+
+    auto it = _streams.find(id);
+
+    // New stream opened by the client
+    if (_server && (it == _streams.end()))
+    {
+        if (((id & 1) == 0) || (id <= _last_peer_stream))
+        {
+            Fail(PROTOCOL_ERROR);
+            return;
+        }
+        _last_peer_stream = id;
+
+        // New streams are ignored after GOAWAY
+        if (_goaway_sent)
+            return;
+
+        if (_streams.size() >= LOCAL_MAX_STREAMS)
+        {
+            WriteResetStream(id, REFUSED_STREAM);
+            return;
+        }
+
+        Stream& stream = _streams[id];
+        stream.send_window = _remote_initial_window;
+        stream.recv_window = LOCAL_STREAM_WINDOW;
+        stream.head = (FindHeader(headers, ":method") == "HEAD");
+        it = _streams.find(id);
+    }
+    else if ((it == _streams.end()) || it->second.end_received)
+    {
+        if (IsIdle(id))
+            Fail(PROTOCOL_ERROR);
+        else
+            WriteResetStream(id, STREAM_CLOSED);
+        return;
+    }
+
+    Stream& stream = it->second;
+
+    // Trailer fields should finish the stream
+    bool trailers = stream.headers_received;
+    if (trailers && !end)
+    {
+        Fail(id, PROTOCOL_ERROR, "Invalid HTTP/2 trailer fields!");
+        return;
+    }
+
+    std::string error = Validate(stream, headers, trailers);
+    if (!error.empty())
+    {
+        Fail(id, PROTOCOL_ERROR, error);
+        return;
+    }
+
+    // Interim response is skipped
+    if (!_server && !trailers)
+    {
+        std::string_view status = FindHeader(headers, ":status");
+        if (status[0] == '1')
+        {
+            if (end)
+                Fail(id, PROTOCOL_ERROR, "Invalid HTTP/2 interim response!");
+            return;
+        }
+    }
+
+    if (!trailers)
+    {
+        // Check the received header against the header limits
+        size_t header_size = 0;
+        size_t header_count = 0;
+        for (const auto& header : headers)
+        {
+            header_size += header.first.size() + header.second.size() + 4;
+            if (header.first[0] != ':')
+                ++header_count;
+        }
+        if (((_option_max_header_size > 0) && (header_size > _option_max_header_size)) ||
+            ((_option_max_headers > 0) && (header_count > _option_max_headers)))
+        {
+            Reject(id, 431, "HTTP/2 message header is too large!");
+            return;
+        }
+
+        // Check the content length against the body size limit
+        std::string_view content_length = FindHeader(headers, "content-length");
+        if ((_option_max_body_size > 0) && !content_length.empty())
+        {
+            // Parse the content length until it exceeds the limit
+            size_t length = 0;
+            for (size_t i = 0; (i < content_length.size()) && (length <= _option_max_body_size) && std::isdigit((unsigned char)content_length[i]); ++i)
+                length = length * 10 + (content_length[i] - '0');
+            if (length > _option_max_body_size)
+            {
+                Reject(id, 413, "HTTP/2 message body is too large!");
+                return;
+            }
+        }
+    }
+
+    for (auto& header : headers)
+        stream.headers.emplace_back(std::move(header));
+    stream.headers_received = true;
+
+    if (end)
+        Complete(id);
+}
+
+void HTTP2Connection::ProcessSettings(uint8_t flags, uint32_t id, const uint8_t* payload, size_t size)
+{
+    if (id != 0)
+    {
+        Fail(PROTOCOL_ERROR);
+        return;
+    }
+
+    if (flags & FLAG_ACK)
+    {
+        if (size != 0)
+            Fail(FRAME_SIZE_ERROR);
+        return;
+    }
+
+    if ((size % 6) != 0)
+    {
+        Fail(FRAME_SIZE_ERROR);
+        return;
+    }
+
+    for (size_t i = 0; i < size; i += 6)
+    {
+        uint16_t setting = (uint16_t)((payload[i] << 8) | payload[i + 1]);
+        uint32_t value = ReadUInt32(payload + i + 2);
+
+        switch (setting)
+        {
+            case SETTINGS_HEADER_TABLE_SIZE:
+                _encoder.SetMaxTableSize(std::min((size_t)value, MAX_TABLE_SIZE));
+                break;
+            case SETTINGS_ENABLE_PUSH:
+                if (value > 1)
+                {
+                    Fail(PROTOCOL_ERROR);
+                    return;
+                }
+                break;
+            case SETTINGS_MAX_CONCURRENT_STREAMS:
+                _remote_max_streams = value;
+                break;
+            case SETTINGS_INITIAL_WINDOW_SIZE:
+            {
+                if (value > MAX_WINDOW_SIZE)
+                {
+                    Fail(FLOW_CONTROL_ERROR);
+                    return;
+                }
+
+                // Adjust send windows of all streams
+                int64_t delta = (int64_t)value - _remote_initial_window;
+                for (auto& stream : _streams)
+                {
+                    stream.second.send_window += delta;
+                    if (stream.second.send_window > MAX_WINDOW_SIZE)
+                    {
+                        Fail(FLOW_CONTROL_ERROR);
+                        return;
+                    }
+                }
+                _remote_initial_window = value;
+                break;
+            }
+            case SETTINGS_MAX_FRAME_SIZE:
+                if ((value < DEFAULT_MAX_FRAME_SIZE) || (value > 0xFFFFFF))
+                {
+                    Fail(PROTOCOL_ERROR);
+                    return;
+                }
+                _remote_max_frame_size = value;
+                break;
+            default:
+                // Unknown settings are ignored
+                break;
+        }
+    }
+
+    _settings_received = true;
+
+    // Acknowledge settings
+    WriteFrame(FRAME_SETTINGS, FLAG_ACK, 0, nullptr, 0);
+
+    SendPending();
+}
+
+void HTTP2Connection::ProcessWindowUpdate(uint32_t id, const uint8_t* payload, size_t size)
+{
+    if (size != 4)
+    {
+        Fail(FRAME_SIZE_ERROR);
+        return;
+    }
+
+    uint32_t increment = ReadUInt32(payload) & 0x7FFFFFFF;
+
+    if (id == 0)
+    {
+        if (increment == 0)
+        {
+            Fail(PROTOCOL_ERROR);
+            return;
+        }
+        _send_window += increment;
+        if (_send_window > MAX_WINDOW_SIZE)
+        {
+            Fail(FLOW_CONTROL_ERROR);
+            return;
+        }
+        SendPending();
+        return;
+    }
+
+    auto it = _streams.find(id);
+    if (it == _streams.end())
+    {
+        if (IsIdle(id))
+            Fail(PROTOCOL_ERROR);
+        return;
+    }
+
+    Stream& stream = it->second;
+
+    if (increment == 0)
+    {
+        Fail(id, PROTOCOL_ERROR, "Invalid HTTP/2 WINDOW_UPDATE frame!");
+        return;
+    }
+    stream.send_window += increment;
+    if (stream.send_window > MAX_WINDOW_SIZE)
+    {
+        Fail(id, FLOW_CONTROL_ERROR, "HTTP/2 stream flow control error!");
+        return;
+    }
+
+    SendData(id, stream, nullptr, 0, stream.pending_end);
+    Close(id);
+}
+
+void HTTP2Connection::ProcessResetStream(uint32_t id, const uint8_t* payload, size_t size)
+{
+    if (id == 0)
+    {
+        Fail(PROTOCOL_ERROR);
+        return;
+    }
+    if (size != 4)
+    {
+        Fail(FRAME_SIZE_ERROR);
+        return;
+    }
+    if (IsIdle(id))
+    {
+        Fail(PROTOCOL_ERROR);
+        return;
+    }
+
+    auto it = _streams.find(id);
+    if (it == _streams.end())
+        return;
+
+    _streams.erase(it);
+
+    uint32_t code = ReadUInt32(payload);
+    onStreamError(id, (code == REFUSED_STREAM) ? "HTTP/2 stream refused!" : "HTTP/2 stream reset!");
+}
+
+void HTTP2Connection::ProcessPing(uint8_t flags, uint32_t id, const uint8_t* payload, size_t size)
+{
+    if (id != 0)
+    {
+        Fail(PROTOCOL_ERROR);
+        return;
+    }
+    if (size != 8)
+    {
+        Fail(FRAME_SIZE_ERROR);
+        return;
+    }
+
+    if ((flags & FLAG_ACK) == 0)
+        WriteFrame(FRAME_PING, FLAG_ACK, 0, payload, size);
+}
+
+void HTTP2Connection::ProcessGoAway(uint32_t id, const uint8_t* payload, size_t size)
+{
+    if (id != 0)
+    {
+        Fail(PROTOCOL_ERROR);
+        return;
+    }
+    if (size < 8)
+    {
+        Fail(FRAME_SIZE_ERROR);
+        return;
+    }
+
+    _goaway_received = true;
+
+    // Streams above the last processed one were not processed by the peer
+    uint32_t last = ReadUInt32(payload) & 0x7FFFFFFF;
+    std::vector<uint32_t> refused;
+    for (auto it = _streams.upper_bound(last); it != _streams.end();)
+    {
+        if ((it->first & 1) == (_server ? 0u : 1u))
+        {
+            refused.push_back(it->first);
+            it = _streams.erase(it);
+        }
+        else
+            ++it;
+    }
+
+    for (auto stream : refused)
+        onStreamError(stream, "HTTP/2 connection is going away!");
+}
+
+bool HTTP2Connection::IsIdle(uint32_t id) const noexcept
+{
+    bool local = (id & 1) == (_server ? 0u : 1u);
+    return local ? (id >= _next_stream) : (id > _last_peer_stream);
+}
+
+std::string HTTP2Connection::Validate(const Stream& stream, const HPACKHeaders& headers, bool trailers) const
+{
+    bool regular = false;
+    size_t method = 0;
+    size_t scheme = 0;
+    size_t path = 0;
+    size_t status = 0;
+
+    for (const auto& header : headers)
+    {
+        const std::string& name = header.first;
+
+        if (name.empty())
+            return "Invalid HTTP/2 header field!";
+
+        // Pseudo header fields should precede regular ones
+        if (name[0] == ':')
+        {
+            if (regular || trailers)
+                return "Invalid HTTP/2 pseudo header field!";
+
+            if (_server && (name == ":method"))
+                ++method;
+            else if (_server && (name == ":scheme"))
+                ++scheme;
+            else if (_server && (name == ":path"))
+            {
+                if (header.second.empty())
+                    return "Invalid HTTP/2 request path!";
+                ++path;
+            }
+            else if (_server && (name == ":authority"))
+                continue;
+            else if (!_server && (name == ":status"))
+            {
+                if ((header.second.size() != 3) || !std::all_of(header.second.begin(), header.second.end(), ::isdigit))
+                    return "Invalid HTTP/2 response status!";
+                ++status;
+            }
+            else
+                return "Invalid HTTP/2 pseudo header field!";
+            continue;
+        }
+
+        regular = true;
+
+        // Header field names should be in lower case
+        if (std::any_of(name.begin(), name.end(), [](char ch) { return (ch >= 'A') && (ch <= 'Z'); }))
+            return "Invalid HTTP/2 header field name!";
+
+        if (IsConnectionHeader(name) || ((name == "te") && (header.second != "trailers")))
+            return "Invalid HTTP/2 connection specific header field!";
+    }
+
+    if (trailers)
+        return std::string();
+
+    if (_server)
+    {
+        bool connect = (FindHeader(headers, ":method") == "CONNECT");
+        if ((method != 1) || (!connect && ((scheme != 1) || (path != 1))))
+            return "Invalid HTTP/2 request pseudo header fields!";
+    }
+    else if (status != 1)
+        return "Invalid HTTP/2 response status!";
+
+    return std::string();
+}
+
+void HTTP2Connection::Complete(uint32_t id)
+{
+    auto it = _streams.find(id);
+    if (it == _streams.end())
+        return;
+
+    Stream& stream = it->second;
+    stream.end_received = true;
+
+    // Check the received body against the content length
+    std::string_view content_length = FindHeader(stream.headers, "content-length");
+    if (!content_length.empty())
+    {
+        std::string_view status = FindHeader(stream.headers, ":status");
+        bool bodyless = !_server && (stream.head || (status == "204") || (status == "304"));
+        if (!bodyless && (content_length != std::to_string(stream.body.size())))
+        {
+            Fail(id, PROTOCOL_ERROR, "Invalid HTTP/2 message content length!");
+            return;
+        }
+    }
+
+    // Take the received message from the stream
+    HPACKHeaders headers = std::move(stream.headers);
+    std::string body = std::move(stream.body);
+    stream.headers.clear();
+    stream.body.clear();
+
+    if (_server)
+    {
+        HTTPRequest request;
+        request.SetBegin(FindHeader(headers, ":method"), FindHeader(headers, ":path"), "HTTP/2.0");
+        std::string_view authority = FindHeader(headers, ":authority");
+        if (!authority.empty() && FindHeader(headers, "host").empty())
+            request.SetHeader("Host", authority);
+        for (const auto& header : headers)
+            if ((header.first[0] != ':') && (body.empty() || (header.first != "content-length")))
+                request.SetHeader(header.first, header.second);
+        request.SetBody(body);
+        request.SetStream(id);
+
+        // Stream stays open for the response unless it was already sent
+        onReceivedRequest(request);
+        Close(id);
+    }
+    else
+    {
+        // Stop sending the request body if the response is already completed
+        if (!stream.end_sent)
+            WriteResetStream(id, CANCEL);
+        _streams.erase(it);
+
+        HTTPResponse response;
+        response.SetBegin(std::stoi(std::string(FindHeader(headers, ":status"))), "HTTP/2.0");
+        for (const auto& header : headers)
+            if ((header.first[0] != ':') && (body.empty() || (header.first != "content-length")))
+                response.SetHeader(header.first, header.second);
+        response.SetBody(body);
+        response.SetStream(id);
+
+        onReceivedResponse(response);
+    }
+}
+
+void HTTP2Connection::Close(uint32_t id)
+{
+    auto it = _streams.find(id);
+    if ((it != _streams.end()) && it->second.end_sent && it->second.end_received)
+        _streams.erase(it);
+}
+
+void HTTP2Connection::Reject(uint32_t id, int status, const std::string& error)
+{
+    if (!_server)
+    {
+        Fail(id, CANCEL, error);
+        return;
+    }
+
+    // Answer with the error response
+    HTTPResponse response(status);
+    response.SetBody();
+    SendResponse(id, response);
+
+    auto it = _streams.find(id);
+    if (it == _streams.end())
+        return;
+
+    // Ask the client to stop sending the request body
+    if (!it->second.end_received)
+        WriteResetStream(id, NO_ERROR);
+
+    _streams.erase(it);
+    onStreamError(id, error);
+}
+
+void HTTP2Connection::Fail(uint32_t id, uint32_t code, const std::string& error)
+{
+    WriteResetStream(id, code);
+
+    auto it = _streams.find(id);
+    if (it == _streams.end())
+        return;
+
+    _streams.erase(it);
+    onStreamError(id, error);
+}
+
+void HTTP2Connection::Fail(uint32_t code)
+{
+    if (_error)
+        return;
+
+    if (!_goaway_sent)
+        WriteGoAway(code);
+    _error = true;
+}
+
+void HTTP2Connection::EncodeHeader(std::string& block, std::string_view name, std::string_view value)
+{
+    _name.assign(name);
+    std::transform(_name.begin(), _name.end(), _name.begin(), [](char ch) { return (char)std::tolower((unsigned char)ch); });
+
+    if (IsConnectionHeader(_name) || ((_name == "te") && (value != "trailers")))
+        return;
+
+    _encoder.Encode(block, _name, value);
+}
+
+void HTTP2Connection::SendMessage(uint32_t id, Stream& stream, const std::string& block, std::string_view body, size_t length, bool chunked)
+{
+    bool complete = !chunked && (body.size() >= length);
+
+    stream.headers_sent = true;
+    stream.chunked = chunked;
+    stream.remaining = complete ? 0 : (length - body.size());
+
+    // Message without body is finished with the header block
+    if (complete && body.empty())
+    {
+        stream.end_sent = true;
+        WriteHeaders(id, block, true);
+        return;
+    }
+
+    WriteHeaders(id, block, false);
+
+    if (!body.empty())
+        SendData(id, stream, body.data(), body.size(), complete);
+}
+
+void HTTP2Connection::SendData(uint32_t id, Stream& stream, const void* buffer, size_t size, bool end)
+{
+    if (size > 0)
+        stream.pending.append((const char*)buffer, size);
+    stream.pending_end = end;
+
+    while (!stream.end_sent)
+    {
+        size_t available = stream.pending.size() - stream.pending_offset;
+        if ((available == 0) && !stream.pending_end)
+            break;
+
+        // Send data within flow control windows
+        int64_t window = std::min(_send_window, stream.send_window);
+        size_t chunk = std::min(available, _remote_max_frame_size);
+        if (window < (int64_t)chunk)
+            chunk = (window > 0) ? (size_t)window : 0;
+        if ((chunk == 0) && (available > 0))
+            break;
+
+        bool last = stream.pending_end && (chunk == available);
+        WriteFrame(FRAME_DATA, last ? FLAG_END_STREAM : 0, id, stream.pending.data() + stream.pending_offset, chunk);
+        stream.pending_offset += chunk;
+        stream.send_window -= chunk;
+        _send_window -= chunk;
+
+        if (last)
+            stream.end_sent = true;
+    }
+
+    // Release sent data
+    if (stream.pending_offset == stream.pending.size())
+    {
+        stream.pending.clear();
+        stream.pending_offset = 0;
+    }
+}
+
+void HTTP2Connection::SendPending()
+{
+    std::vector<uint32_t> completed;
+
+    for (auto& [id, stream] : _streams)
+    {
+        if (_send_window <= 0)
+            break;
+        if (stream.headers_sent && !stream.end_sent && (stream.pending_offset < stream.pending.size()))
+        {
+            SendData(id, stream, nullptr, 0, stream.pending_end);
+            if (stream.end_sent && stream.end_received)
+                completed.push_back(id);
+        }
+    }
+
+    for (auto id : completed)
+        Close(id);
+}
+
+void HTTP2Connection::WriteFrame(uint8_t type, uint8_t flags, uint32_t stream, const void* payload, size_t size)
+{
+    _output.push_back((char)(size >> 16));
+    _output.push_back((char)(size >> 8));
+    _output.push_back((char)size);
+    _output.push_back((char)type);
+    _output.push_back((char)flags);
+    WriteUInt32(_output, stream);
+    if (size > 0)
+        _output.append((const char*)payload, size);
+}
+
+void HTTP2Connection::WriteHeaders(uint32_t stream, const std::string& block, bool end)
+{
+    // Split the header block into HEADERS and CONTINUATION frames
+    size_t offset = 0;
+    do
+    {
+        size_t size = std::min(block.size() - offset, _remote_max_frame_size);
+        bool last = (offset + size) == block.size();
+        uint8_t type = (offset == 0) ? FRAME_HEADERS : FRAME_CONTINUATION;
+        uint8_t flags = (last ? FLAG_END_HEADERS : 0) | (((offset == 0) && end) ? FLAG_END_STREAM : 0);
+        WriteFrame(type, flags, stream, block.data() + offset, size);
+        offset += size;
+    } while (offset < block.size());
+}
+
+void HTTP2Connection::WriteResetStream(uint32_t stream, uint32_t code)
+{
+    std::string payload;
+    WriteUInt32(payload, code);
+    WriteFrame(FRAME_RST_STREAM, 0, stream, payload.data(), payload.size());
+}
+
+void HTTP2Connection::WriteWindowUpdate(uint32_t stream, uint32_t increment)
+{
+    std::string payload;
+    WriteUInt32(payload, increment);
+    WriteFrame(FRAME_WINDOW_UPDATE, 0, stream, payload.data(), payload.size());
+}
+
+void HTTP2Connection::WriteGoAway(uint32_t code)
+{
+    std::string payload;
+    WriteUInt32(payload, _last_peer_stream);
+    WriteUInt32(payload, code);
+    WriteFrame(FRAME_GOAWAY, 0, 0, payload.data(), payload.size());
+    _goaway_sent = true;
+}
+
+void HTTP2Connection::Flush()
+{
+    if (_output.empty())
+        return;
+
+    onSend(_output.data(), _output.size());
+    _output.clear();
+}
+
+} // namespace HTTP
+} // namespace CppServer
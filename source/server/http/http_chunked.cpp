@@ -0,0 +1,200 @@
+/*!
+    \file http_chunked.cpp
+    \brief HTTP chunked transfer encoding implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/http/http_chunked.h"
+
+#include <algorithm>
+
+namespace CppServer {
+namespace HTTP {
+
+void HTTPChunkedDecoder::Clear()
+{
+    _state = State::SIZE;
+    _error = false;
+    _chunk_size = 0;
+    _chunk_digits = 0;
+}
+
+size_t HTTPChunkedDecoder::Decode(const void* buffer, size_t size, const char*& part, size_t& part_size)
+{
+    const char* data = (const char*)buffer;
+
+    part = data;
+    part_size = 0;
+
+    size_t i = 0;
+    while ((i < size) && !_error)
+    {
+        char ch = data[i];
+
+        switch (_state)
+        {
+            case State::SIZE:
+            {
+                int digit = -1;
+                if ((ch >= '0') && (ch <= '9'))
+                    digit = ch - '0';
+                else if ((ch >= 'a') && (ch <= 'f'))
+                    digit = ch - 'a' + 10;
+                else if ((ch >= 'A') && (ch <= 'F'))
+                    digit = ch - 'A' + 10;
+
+                if (digit >= 0)
+                {
+                    // Protect the chunk size from overflow
+                    if (++_chunk_digits > 15)
+                    {
+                        _error = true;
+                        break;
+                    }
+                    _chunk_size = (_chunk_size << 4) | (size_t)digit;
+                    ++i;
+                    break;
+                }
+
+                // Chunk size should contain at least one hex digit
+                if (_chunk_digits == 0)
+                {
+                    _error = true;
+                    break;
+                }
+
+                if ((ch == ';') || (ch == ' ') || (ch == '\t'))
+                    _state = State::EXTENSION;
+                else if (ch == '\r')
+                    _state = State::SIZE_LF;
+                else
+                    _error = true;
+                ++i;
+                break;
+            }
+            case State::EXTENSION:
+            {
+                // Skip chunk extensions
+                if (ch == '\r')
+                    _state = State::SIZE_LF;
+                else if (ch == '\n')
+                    _error = true;
+                ++i;
+                break;
+            }
+            case State::SIZE_LF:
+            {
+                if (ch != '\n')
+                {
+                    _error = true;
+                    break;
+                }
+                _state = (_chunk_size > 0) ? State::DATA : State::TRAILER_START;
+                ++i;
+                break;
+            }
+            case State::DATA:
+            {
+                // Return the decoded part of the chunk data
+                size_t available = std::min(size - i, _chunk_size);
+                part = data + i;
+                part_size = available;
+                _chunk_size -= available;
+                if (_chunk_size == 0)
+                    _state = State::DATA_CR;
+                return i + available;
+            }
+            case State::DATA_CR:
+            {
+                if (ch != '\r')
+                {
+                    _error = true;
+                    break;
+                }
+                _state = State::DATA_LF;
+                ++i;
+                break;
+            }
+            case State::DATA_LF:
+            {
+                if (ch != '\n')
+                {
+                    _error = true;
+                    break;
+                }
+                _state = State::SIZE;
+                _chunk_digits = 0;
+                ++i;
+                break;
+            }
+            case State::TRAILER_START:
+            {
+                // Empty line finishes the chunked body
+                if (ch == '\r')
+                    _state = State::END_LF;
+                else
+                    _state = State::TRAILER;
+                ++i;
+                break;
+            }
+            case State::TRAILER:
+            {
+                // Skip trailer fields
+                if (ch == '\r')
+                    _state = State::TRAILER_LF;
+                else if (ch == '\n')
+                    _error = true;
+                ++i;
+                break;
+            }
+            case State::TRAILER_LF:
+            {
+                if (ch != '\n')
+                {
+                    _error = true;
+                    break;
+                }
+                _state = State::TRAILER_START;
+                ++i;
+                break;
+            }
+            case State::END_LF:
+            {
+                if (ch != '\n')
+                {
+                    _error = true;
+                    break;
+                }
+                _state = State::COMPLETE;
+                return i + 1;
+            }
+            case State::COMPLETE:
+                return i;
+        }
+    }
+
+    return i;
+}
+
+std::string HTTPChunkedEncoder::ChunkHeader(size_t size)
+{
+    const char digits[] = "0123456789abcdef";
+
+    // Format the chunk size in hex
+    char buffer[24];
+    size_t index = sizeof(buffer);
+    buffer[--index] = '\n';
+    buffer[--index] = '\r';
+    do
+    {
+        buffer[--index] = digits[size & 0x0F];
+        size >>= 4;
+    } while (size > 0);
+
+    return std::string(buffer + index, sizeof(buffer) - index);
+}
+
+} // namespace HTTP
+} // namespace CppServer
@@ -8,53 +8,141 @@
 
 #include "server/http/http_client.h"
 
+#include <algorithm>
+
 namespace CppServer {
 namespace HTTP {
 
-void HTTPClient::onReceived(const void* buffer, size_t size)
+size_t HTTPClient::SendRequestBodyChunk(const void* buffer, size_t size)
 {
-    // Receive HTTP response header
-    if (_response.IsPendingHeader())
-    {
-        if (_response.ReceiveHeader(buffer, size))
-            onReceivedResponseHeader(_response);
+    std::string header = HTTPChunkedEncoder::ChunkHeader(size);
 
-        size = 0;
-    }
+    size_t sent = Send(header);
+    if (size > 0)
+        sent += Send(buffer, size);
+    sent += Send(HTTPChunkedEncoder::ChunkTrailer());
+
+    return sent;
+}
 
-    // Check for HTTP response error
-    if (_response.error())
+bool HTTPClient::SendRequestBodyChunkAsync(const void* buffer, size_t size)
+{
+    std::string header = HTTPChunkedEncoder::ChunkHeader(size);
+
+    if (!SendAsync(header))
+        return false;
+    if ((size > 0) && !SendAsync(buffer, size))
+        return false;
+    return SendAsync(HTTPChunkedEncoder::ChunkTrailer());
+}
+
+void HTTPClient::onReceived(const void* buffer, size_t size)
+{
+    // Receive data of the upgraded protocol
+    if (_upgraded)
     {
-        onReceivedResponseError(_response, "Invalid HTTP response!");
-        _response.Clear();
-        DisconnectAsync();
+        onReceivedUpgraded(buffer, size);
         return;
     }
 
-    // Receive HTTP response body
-    if (_response.ReceiveBody(buffer, size))
+    const char* data = (const char*)buffer;
+
+    // Parse pipelined responses in place of the receive buffer
+    while (true)
     {
+        // Receive HTTP response header
+        if (_response.IsPendingHeader())
+        {
+            size_t consumed = _response.ReceiveHeader(data, size);
+            data += consumed;
+            size -= consumed;
+
+            // Check for HTTP response error
+            if (_response.error())
+            {
+                onReceivedResponseError(_response, "Invalid HTTP response!");
+                _response.Clear();
+                DisconnectAsync();
+                return;
+            }
+
+            // Wait for the rest of HTTP response header
+            if (_response.IsPendingHeader())
+                return;
+
+            onReceivedResponseHeader(_response);
+        }
+
+        // Receive HTTP response body
+        size_t consumed = _option_stream_body ? ReceiveBodyParts(data, size) : _response.ReceiveBody(data, size);
+        data += consumed;
+        size -= consumed;
+
+        // Check for HTTP response error
+        if (_response.error())
+        {
+            onReceivedResponseError(_response, "Invalid HTTP response!");
+            _response.Clear();
+            DisconnectAsync();
+            return;
+        }
+
+        // Wait for the rest of HTTP response body
+        if (!_response.IsBodyComplete())
+            return;
+
+        // Switch the connection to the upgraded protocol if the upgrade is accepted
+        if ((_response.status() == 101) && onReceivedResponseUpgrade(_response))
+        {
+            _upgraded = true;
+            _response.Clear();
+
+            // The rest of received data belongs to the upgraded protocol
+            if (size > 0)
+                onReceivedUpgraded(data, size);
+            return;
+        }
+
         onReceivedResponse(_response);
         _response.Clear();
-        return;
+
+        // Process the next pipelined response
+        if (size == 0)
+            return;
     }
+}
+
+size_t HTTPClient::ReceiveBodyParts(const void* buffer, size_t size)
+{
+    const char* data = (const char*)buffer;
 
-    // Check for HTTP response error
-    if (_response.error())
+    size_t consumed = 0;
+    while ((consumed < size) && !_response.error() && !_response.IsBodyComplete())
     {
-        onReceivedResponseError(_response, "Invalid HTTP response!");
-        _response.Clear();
-        DisconnectAsync();
-        return;
+        const char* part;
+        size_t part_size;
+        consumed += _response.ReceiveBodyPart(data + consumed, size - consumed, part, part_size);
+
+        if (part_size > 0)
+            onReceivedResponseBodyPart(_response, part, part_size);
     }
+
+    return consumed;
 }
 
 void HTTPClient::onDisconnected()
 {
+    // The next connection starts with HTTP protocol
+    _upgraded = false;
+
     // Receive HTTP response body
     if (_response.IsPendingBody())
     {
-        onReceivedResponse(_response);
+        // Only the body without the content length and the chunked transfer encoding is finished by the connection close
+        if (_response.IsBodyUntilClose())
+            onReceivedResponse(_response);
+        else
+            onReceivedResponseError(_response, "Connection closed before the end of HTTP response body!");
         _response.Clear();
         return;
     }
@@ -62,66 +150,213 @@ void HTTPClient::onDisconnected()
 
 std::future<HTTPResponse> HTTPClientEx::MakeRequest(const HTTPRequest& request, const CppCommon::Timespan& timeout)
 {
-    // Create TCP resolver if the current one is empty
-    if (!_resolver)
-        _resolver = std::make_shared<Asio::TCPResolver>(service());
-    // Create timer if the current one is empty
-    if (!_timer)
-        _timer = std::make_shared<Asio::Timer>(service());
-
-    _promise = std::promise<HTTPResponse>();
-    _request = request;
+    auto pending = std::make_shared<Request>();
+    pending->request = request;
 
-    // Connect to Web server
-    if (!ConnectAsync(_resolver))
-        _promise.set_exception(std::make_exception_ptr(std::runtime_error("Connection failed!")));
+    auto future = pending->promise.get_future();
 
-    // Setup timeout check timer
-    auto self(this->shared_from_this());
-    auto timeout_handler = [this, self](bool canceled)
+    // Setup timeout check timer of the request
+    std::weak_ptr<Asio::TCPClient> weak_client = shared_from_this();
+    std::weak_ptr<Request> weak_request = pending;
+    auto timeout_handler = [weak_client, weak_request](bool canceled)
     {
         if (canceled)
             return;
 
-        // Disconnect on timeout
-        onReceivedResponseError(_response, "Timeout!");
-        _response.Clear();
-        DisconnectAsync();
+        auto client = weak_client.lock();
+        auto request = weak_request.lock();
+        if (client && request)
+            std::static_pointer_cast<HTTPClientEx>(client)->onRequestTimeout(request);
     };
-    if (!_timer->Setup(timeout_handler, timeout) || !_timer->WaitAsync())
-        _promise.set_exception(std::make_exception_ptr(std::runtime_error("Timeout setup failed!")));
+    pending->timer = std::make_shared<Asio::Timer>(service());
+    if (!pending->timer->Setup(timeout_handler, timeout) || !pending->timer->WaitAsync())
+    {
+        pending->promise.set_exception(std::make_exception_ptr(std::runtime_error("Timeout setup failed!")));
+        return future;
+    }
+
+    bool connect = false;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        // Create TCP resolver if the current one is empty
+        if (!_resolver)
+            _resolver = std::make_shared<Asio::TCPResolver>(service());
+
+        _queue.emplace_back(pending);
+
+        // Send the request over the keep-alive connection or connect to Web server
+        if (IsConnected() && !_connecting)
+            SendRequests();
+        else if (!_connecting)
+            _connecting = connect = true;
+    }
+
+    if (connect && !ConnectAsync(_resolver))
+        FailRequests("Connection failed!");
 
-    return _promise.get_future();
+    return future;
+}
+
+void HTTPClientEx::SendRequests()
+{
+    // Send queued requests up to the pipeline depth
+    while (!_queue.empty() && (_pipeline.size() < _option_pipeline_depth))
+    {
+        auto request = _queue.front();
+        _queue.pop_front();
+        _pipeline.emplace_back(request);
+        SendRequestAsync(request->request);
+    }
+}
+
+void HTTPClientEx::FailRequests(const std::string& error)
+{
+    std::deque<std::shared_ptr<Request>> requests;
+
+    {
+        std::scoped_lock locker(_lock);
+        _connecting = false;
+        requests = std::move(_pipeline);
+        _pipeline.clear();
+        for (auto& request : _queue)
+            requests.emplace_back(request);
+        _queue.clear();
+    }
+
+    for (auto& request : requests)
+    {
+        request->timer->Cancel();
+        request->promise.set_exception(std::make_exception_ptr(std::runtime_error(error)));
+    }
 }
 
 void HTTPClientEx::onConnected()
 {
-    if (!SendRequestAsync())
-        _promise.set_exception(std::make_exception_ptr(std::runtime_error("Send HTTP request failed!")));
+    std::scoped_lock locker(_lock);
+    _connecting = false;
+    SendRequests();
 }
 
 void HTTPClientEx::onDisconnected()
 {
-    // Cancel timeout check timer
-    _timer->Cancel();
-
     HTTPClient::onDisconnected();
+
+    std::deque<std::shared_ptr<Request>> closed;
+    bool failed = false;
+    bool reconnect = false;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        // Sent requests without responses fail with the connection
+        closed = std::move(_pipeline);
+        _pipeline.clear();
+
+        // Queued requests fail if the connection was not established,
+        // otherwise they are sent over a new connection
+        failed = _connecting;
+        reconnect = !failed && !_queue.empty();
+        _connecting = reconnect;
+    }
+
+    for (auto& request : closed)
+    {
+        request->timer->Cancel();
+        request->promise.set_exception(std::make_exception_ptr(std::runtime_error("Connection closed!")));
+    }
+
+    if (failed || (reconnect && !ConnectAsync(_resolver)))
+        FailRequests("Connection failed!");
+}
+
+void HTTPClientEx::onReceivedResponseHeader(const HTTPResponse& response)
+{
+    std::scoped_lock locker(_lock);
+
+    // Response to HEAD request has no body
+    if (!_pipeline.empty() && (_pipeline.front()->request.method() == "HEAD"))
+        SkipResponseBody();
 }
 
 void HTTPClientEx::onReceivedResponse(const HTTPResponse& response)
 {
-    // Cancel timeout check timer
-    _timer->Cancel();
+    // Skip interim informational responses
+    if ((response.status() >= 100) && (response.status() < 200) && (response.status() != 101))
+        return;
+
+    std::shared_ptr<Request> request;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        if (_pipeline.empty())
+            return;
 
-    _promise.set_value(response);
+        // Responses are matched to requests in order
+        request = _pipeline.front();
+        _pipeline.pop_front();
+
+        SendRequests();
+    }
+
+    request->timer->Cancel();
+    request->promise.set_value(response);
 }
 
 void HTTPClientEx::onReceivedResponseError(const HTTPResponse& response, const std::string& error)
 {
-    // Cancel timeout check timer
-    _timer->Cancel();
+    std::shared_ptr<Request> request;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        if (_pipeline.empty())
+            return;
+
+        request = _pipeline.front();
+        _pipeline.pop_front();
+    }
+
+    request->timer->Cancel();
+    request->promise.set_exception(std::make_exception_ptr(std::runtime_error(error)));
+}
+
+void HTTPClientEx::onRequestTimeout(const std::shared_ptr<Request>& request)
+{
+    std::deque<std::shared_ptr<Request>> requests;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        // Queued request is just removed
+        auto it = std::find(_queue.begin(), _queue.end(), request);
+        if (it != _queue.end())
+            _queue.erase(it);
+        else
+        {
+            // Sent request could not be skipped in the pipeline, so the connection is closed
+            if (std::find(_pipeline.begin(), _pipeline.end(), request) == _pipeline.end())
+                return;
+            requests = std::move(_pipeline);
+            _pipeline.clear();
+        }
+    }
+
+    request->promise.set_exception(std::make_exception_ptr(std::runtime_error("Timeout!")));
 
-    _promise.set_exception(std::make_exception_ptr(std::runtime_error(error)));
+    if (!requests.empty())
+    {
+        for (auto& other : requests)
+        {
+            if (other == request)
+                continue;
+            other->timer->Cancel();
+            other->promise.set_exception(std::make_exception_ptr(std::runtime_error("Connection closed!")));
+        }
+        DisconnectAsync();
+    }
 }
 
 } // namespace HTTP
@@ -8,11 +8,67 @@
 
 #include "server/http/http_request.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 
 namespace CppServer {
 namespace HTTP {
 
+namespace {
+
+// Character classes of HTTP request grammar (RFC 7230)
+const uint8_t CHAR_TOKEN = 0x01;
+const uint8_t CHAR_URL = 0x02;
+const uint8_t CHAR_VALUE = 0x04;
+
+constexpr std::array<uint8_t, 256> CreateCharTable()
+{
+    std::array<uint8_t, 256> table{};
+    for (int ch = 0x21; ch < 0x7F; ++ch)
+        table[ch] = CHAR_URL | CHAR_VALUE;
+    for (int ch = 0x80; ch < 0x100; ++ch)
+        table[ch] = CHAR_VALUE;
+    for (int ch = '0'; ch <= '9'; ++ch)
+        table[ch] |= CHAR_TOKEN;
+    for (int ch = 'A'; ch <= 'Z'; ++ch)
+        table[ch] |= CHAR_TOKEN;
+    for (int ch = 'a'; ch <= 'z'; ++ch)
+        table[ch] |= CHAR_TOKEN;
+    for (char ch : "!#$%&'*+-.^_`|~")
+        if (ch != 0)
+            table[(uint8_t)ch] |= CHAR_TOKEN;
+    return table;
+}
+
+constexpr std::array<uint8_t, 256> CHAR_TABLE = CreateCharTable();
+
+inline bool IsTokenChar(char ch) { return (CHAR_TABLE[(uint8_t)ch] & CHAR_TOKEN) != 0; }
+inline bool IsURLChar(char ch) { return (CHAR_TABLE[(uint8_t)ch] & CHAR_URL) != 0; }
+inline bool IsValueChar(char ch) { return (CHAR_TABLE[(uint8_t)ch] & CHAR_VALUE) != 0; }
+
+bool CompareNoCase(std::string_view str1, std::string_view str2)
+{
+    if (str1.size() != str2.size())
+        return false;
+
+    for (size_t i = 0; i < str1.size(); ++i)
+    {
+        char ch1 = str1[i];
+        char ch2 = str2[i];
+        if ((ch1 >= 'A') && (ch1 <= 'Z'))
+            ch1 += 'a' - 'A';
+        if ((ch2 >= 'A') && (ch2 <= 'Z'))
+            ch2 += 'a' - 'A';
+        if (ch1 != ch2)
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
 std::tuple<std::string_view, std::string_view> HTTPRequest::header(size_t i) const noexcept
 {
     assert((i < _headers.size()) && "Index out of bounds!");
@@ -26,6 +82,7 @@ std::tuple<std::string_view, std::string_view> HTTPRequest::header(size_t i) con
 
 void HTTPRequest::Clear()
 {
+    _error = false;
     _method_index = 0;
     _method_size = 0;
     _url_index = 0;
@@ -36,8 +93,22 @@ void HTTPRequest::Clear()
     _body_index = 0;
     _body_size = 0;
     _body_length = 0;
+    _chunked = false;
+    _chunked_decoder.Clear();
+    _stream = 0;
 
     _cache.clear();
+
+    _state = ParserState::METHOD;
+    _header_name_index = 0;
+    _header_name_size = 0;
+    _header_value_index = 0;
+    _header_value_end = 0;
+    _has_host = false;
+    _has_content_length = false;
+    _keep_alive = false;
+    _has_upgrade = false;
+    _connection_upgrade = false;
 }
 
 void HTTPRequest::SetBegin(std::string_view method, std::string_view url, std::string_view protocol)
@@ -126,5 +197,344 @@ void HTTPRequest::SetBodyLength(size_t length)
     _body_length = length;
 }
 
+void HTTPRequest::SetBodyChunked()
+{
+    // Append chunked transfer encoding header
+    SetHeader("Transfer-Encoding", "chunked");
+
+    _cache.append("\r\n");
+
+    size_t index = _cache.size();
+
+    // Clear the HTTP request body
+    _body_index = index;
+    _body_size = 0;
+    _body_length = 0;
+    _chunked = true;
+}
+
+size_t HTTPRequest::ReceiveHeader(const void* buffer, size_t size)
+{
+    const char* data = (const char*)buffer;
+
+    // Count of bytes of the given buffer appended to the request cache
+    size_t flushed = 0;
+    auto flush = [&](size_t end)
+    {
+        _cache.append(data + flushed, end - flushed);
+        flushed = end;
+    };
+
+    // Request cache offset of the given buffer byte
+    auto offset = [&](size_t index) { return _cache.size() + (index - flushed); };
+
+    // Set the error flag and stop parsing
+    auto fail = [this](size_t consumed)
+    {
+        _error = true;
+        return consumed;
+    };
+
+    size_t i = 0;
+    while (i < size)
+    {
+        switch (_state)
+        {
+            case ParserState::METHOD:
+            {
+                // Skip empty lines before the request line
+                if (_cache.empty() && (flushed == i) && ((data[i] == '\r') || (data[i] == '\n')))
+                {
+                    flushed = ++i;
+                    break;
+                }
+
+                while ((i < size) && IsTokenChar(data[i]))
+                    ++i;
+                if (i == size)
+                    break;
+
+                // Method should be a non empty token followed by the space
+                _method_size = offset(i) - _method_index;
+                if ((data[i] != ' ') || (_method_size == 0))
+                    return fail(i);
+
+                _url_index = offset(++i);
+                _state = ParserState::URL;
+                break;
+            }
+            case ParserState::URL:
+            {
+                while ((i < size) && IsURLChar(data[i]))
+                    ++i;
+                if (i == size)
+                    break;
+
+                // URL should be a non empty string of visible characters followed by the space
+                _url_size = offset(i) - _url_index;
+                if ((data[i] != ' ') || (_url_size == 0))
+                    return fail(i);
+
+                _protocol_index = offset(++i);
+                _state = ParserState::PROTOCOL;
+                break;
+            }
+            case ParserState::PROTOCOL:
+            {
+                while ((i < size) && IsURLChar(data[i]))
+                    ++i;
+                if (i == size)
+                    break;
+                if (data[i] != '\r')
+                    return fail(i);
+
+                // Only HTTP/1.0 and HTTP/1.1 protocol versions are supported
+                flush(i);
+                _protocol_size = offset(i) - _protocol_index;
+                std::string_view version = protocol();
+                if ((version != "HTTP/1.1") && (version != "HTTP/1.0"))
+                    return fail(i);
+                _keep_alive = (version == "HTTP/1.1");
+
+                ++i;
+                _state = ParserState::PROTOCOL_LF;
+                break;
+            }
+            case ParserState::PROTOCOL_LF:
+            {
+                if (data[i] != '\n')
+                    return fail(i);
+
+                ++i;
+                _state = ParserState::HEADER_START;
+                break;
+            }
+            case ParserState::HEADER_START:
+            {
+                // Empty line finishes the header
+                if (data[i] == '\r')
+                {
+                    ++i;
+                    _state = ParserState::HEADER_END_LF;
+                    break;
+                }
+
+                _header_name_index = offset(i);
+                _state = ParserState::HEADER_NAME;
+                break;
+            }
+            case ParserState::HEADER_NAME:
+            {
+                while ((i < size) && IsTokenChar(data[i]))
+                    ++i;
+                if (i == size)
+                    break;
+
+                // Header name should be a non empty token followed by the colon
+                _header_name_size = offset(i) - _header_name_index;
+                if ((data[i] != ':') || (_header_name_size == 0))
+                    return fail(i);
+
+                ++i;
+                _state = ParserState::HEADER_VALUE_START;
+                break;
+            }
+            case ParserState::HEADER_VALUE_START:
+            {
+                // Skip all prefix whitespace characters
+                while ((i < size) && ((data[i] == ' ') || (data[i] == '\t')))
+                    ++i;
+                if (i == size)
+                    break;
+
+                _header_value_index = offset(i);
+                _header_value_end = _header_value_index;
+                _state = ParserState::HEADER_VALUE;
+                break;
+            }
+            case ParserState::HEADER_VALUE:
+            {
+                while (i < size)
+                {
+                    if (IsValueChar(data[i]))
+                    {
+                        while ((++i < size) && IsValueChar(data[i]));
+                        _header_value_end = offset(i);
+                    }
+                    else if ((data[i] == ' ') || (data[i] == '\t'))
+                        ++i;
+                    else
+                        break;
+                }
+                if (i == size)
+                    break;
+                if (data[i] != '\r')
+                    return fail(i);
+
+                ++i;
+                _state = ParserState::HEADER_VALUE_LF;
+                break;
+            }
+            case ParserState::HEADER_VALUE_LF:
+            {
+                if (data[i] != '\n')
+                    return fail(i);
+
+                ++i;
+                flush(i);
+
+                // Add a new header without suffix whitespace characters
+                _headers.emplace_back(_header_name_index, _header_name_size, _header_value_index, _header_value_end - _header_value_index);
+                if (!ProcessHeader())
+                    return fail(i);
+
+                _state = ParserState::HEADER_START;
+                break;
+            }
+            case ParserState::HEADER_END_LF:
+            {
+                if (data[i] != '\n')
+                    return fail(i);
+
+                ++i;
+                flush(i);
+
+                // HTTP/1.1 request should contain the host header
+                if ((protocol() == "HTTP/1.1") && !_has_host)
+                    return fail(i);
+
+                // Chunked HTTP request should be HTTP/1.1 without the content length
+                if (_chunked && ((protocol() != "HTTP/1.1") || _has_content_length))
+                    return fail(i);
+
+                // Update the body index and size
+                _body_index = _cache.size();
+                _body_size = 0;
+
+                _state = ParserState::BODY;
+                return i;
+            }
+            case ParserState::BODY:
+                return i;
+        }
+    }
+
+    // Append the rest of the given buffer to the request cache
+    flush(size);
+
+    return size;
+}
+
+size_t HTTPRequest::ReceiveBody(const void* buffer, size_t size)
+{
+    // Decode the chunked body
+    if (_chunked)
+    {
+        const char* data = (const char*)buffer;
+
+        // Decode only the rest of the chunked body, the next bytes belong to the next request
+        size_t consumed = 0;
+        while ((consumed < size) && !_chunked_decoder.complete() && !_chunked_decoder.error())
+        {
+            const char* part;
+            size_t part_size;
+            consumed += _chunked_decoder.Decode(data + consumed, size - consumed, part, part_size);
+
+            // Append the decoded body part
+            _cache.append(part, part_size);
+            _body_size += part_size;
+        }
+
+        // Check for chunked body error
+        if (_chunked_decoder.error())
+            _error = true;
+        else if (_chunked_decoder.complete())
+            _body_length = _body_size;
+
+        return consumed;
+    }
+
+    // Receive only the rest of the body, the next bytes belong to the next request
+    size_t consumed = std::min(size, _body_length - _body_size);
+
+    // Update HTTP request cache
+    _cache.append((const char*)buffer, consumed);
+
+    // Update body size
+    _body_size += consumed;
+
+    return consumed;
+}
+
+bool HTTPRequest::ProcessHeader()
+{
+    std::string_view key(_cache.data() + _header_name_index, _header_name_size);
+    std::string_view value(_cache.data() + _header_value_index, _header_value_end - _header_value_index);
+
+    if (CompareNoCase(key, "Host"))
+    {
+        // Multiple host headers are not allowed
+        if (_has_host)
+            return false;
+        _has_host = true;
+    }
+    else if (CompareNoCase(key, "Content-Length"))
+    {
+        // Content length should be a non empty decimal number
+        if (value.empty() || (value.size() > 18))
+            return false;
+        size_t length = 0;
+        for (char ch : value)
+        {
+            if ((ch < '0') || (ch > '9'))
+                return false;
+            length = length * 10 + (ch - '0');
+        }
+
+        // Multiple content length headers should have the same value
+        if (_has_content_length && (length != _body_length))
+            return false;
+        _has_content_length = true;
+        _body_length = length;
+    }
+    else if (CompareNoCase(key, "Transfer-Encoding"))
+    {
+        // Only a single chunked transfer encoding is supported
+        if (_chunked || !CompareNoCase(value, "chunked"))
+            return false;
+        _chunked = true;
+    }
+    else if (CompareNoCase(key, "Upgrade"))
+        _has_upgrade = !value.empty();
+    else if (CompareNoCase(key, "Connection"))
+    {
+        // Parse connection options
+        size_t index = 0;
+        while (index < value.size())
+        {
+            size_t next = value.find(',', index);
+            if (next == std::string_view::npos)
+                next = value.size();
+
+            std::string_view option = value.substr(index, next - index);
+            while (!option.empty() && ((option.front() == ' ') || (option.front() == '\t')))
+                option.remove_prefix(1);
+            while (!option.empty() && ((option.back() == ' ') || (option.back() == '\t')))
+                option.remove_suffix(1);
+
+            if (CompareNoCase(option, "close"))
+                _keep_alive = false;
+            else if (CompareNoCase(option, "keep-alive"))
+                _keep_alive = true;
+            else if (CompareNoCase(option, "upgrade"))
+                _connection_upgrade = true;
+
+            index = next + 1;
+        }
+    }
+
+    return true;
+}
+
 } // namespace HTTP
 } // namespace CppServer
@@ -8,11 +8,142 @@
 
 #include "server/http/http_response.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+
+// Vectorized scanning is used on x86 (SSE2 is a part of x86-64 baseline, AVX2 if enabled by the compiler)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define CPPSERVER_HTTP_SSE2
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace CppServer {
 namespace HTTP {
 
+namespace {
+
+#if defined(__AVX2__) || defined(CPPSERVER_HTTP_SSE2)
+// Count trailing zero bits of the non zero mask
+inline size_t CountTrailingZeros(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return (size_t)__builtin_ctz(mask);
+#endif
+}
+#endif
+
+// Find the first given character in the buffer (returns the buffer size if not found)
+inline size_t FindChar(const char* data, size_t size, char ch)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i pattern = _mm256_set1_epi8(ch);
+    for (; (i + 32) <= size; i += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(data + i));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, pattern));
+        if (mask != 0)
+            return i + CountTrailingZeros(mask);
+    }
+#endif
+#if defined(CPPSERVER_HTTP_SSE2)
+    const __m128i pattern16 = _mm_set1_epi8(ch);
+    for (; (i + 16) <= size; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(data + i));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern16));
+        if (mask != 0)
+            return i + CountTrailingZeros(mask);
+    }
+#endif
+    for (; i < size; ++i)
+        if (data[i] == ch)
+            return i;
+    return size;
+}
+
+// Find the first of two given characters in the buffer (returns the buffer size if not found)
+inline size_t FindChar2(const char* data, size_t size, char ch1, char ch2)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i pattern1 = _mm256_set1_epi8(ch1);
+    const __m256i pattern2 = _mm256_set1_epi8(ch2);
+    for (; (i + 32) <= size; i += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i matches = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, pattern1), _mm256_cmpeq_epi8(chunk, pattern2));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(matches);
+        if (mask != 0)
+            return i + CountTrailingZeros(mask);
+    }
+#endif
+#if defined(CPPSERVER_HTTP_SSE2)
+    const __m128i pattern16_1 = _mm_set1_epi8(ch1);
+    const __m128i pattern16_2 = _mm_set1_epi8(ch2);
+    for (; (i + 16) <= size; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i matches = _mm_or_si128(_mm_cmpeq_epi8(chunk, pattern16_1), _mm_cmpeq_epi8(chunk, pattern16_2));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(matches);
+        if (mask != 0)
+            return i + CountTrailingZeros(mask);
+    }
+#endif
+    for (; i < size; ++i)
+        if ((data[i] == ch1) || (data[i] == ch2))
+            return i;
+    return size;
+}
+
+// Find the "\r\n\r\n" header separator starting from the given index (returns the buffer size if not found)
+inline size_t FindHeaderEnd(const char* data, size_t size, size_t index)
+{
+    while ((index + 3) < size)
+    {
+        index += FindChar(data + index, size - 3 - index, '\r');
+        if ((index + 3) >= size)
+            break;
+        if ((data[index + 1] == '\n') && (data[index + 2] == '\r') && (data[index + 3] == '\n'))
+            return index;
+        ++index;
+    }
+    return size;
+}
+
+bool CompareNoCase(std::string_view str1, std::string_view str2)
+{
+    if (str1.size() != str2.size())
+        return false;
+
+    for (size_t i = 0; i < str1.size(); ++i)
+    {
+        char ch1 = str1[i];
+        char ch2 = str2[i];
+        if ((ch1 >= 'A') && (ch1 <= 'Z'))
+            ch1 += 'a' - 'A';
+        if ((ch2 >= 'A') && (ch2 <= 'Z'))
+            ch2 += 'a' - 'A';
+        if (ch1 != ch2)
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
 std::tuple<std::string_view, std::string_view> HTTPResponse::header(size_t i) const noexcept
 {
     assert((i < _headers.size()) && "Index out of bounds!");
@@ -36,6 +167,11 @@ void HTTPResponse::Clear()
     _body_index = 0;
     _body_size = 0;
     _body_length = 0;
+    _body_length_provided = false;
+    _body_streamed = 0;
+    _chunked = false;
+    _chunked_decoder.Clear();
+    _stream = 0;
 
     _cache.clear();
     _cache_size = 0;
@@ -210,6 +346,22 @@ void HTTPResponse::SetBodyLength(size_t length)
     _body_length = length;
 }
 
+void HTTPResponse::SetBodyChunked()
+{
+    // Append chunked transfer encoding header
+    SetHeader("Transfer-Encoding", "chunked");
+
+    _cache.append("\r\n");
+
+    size_t index = _cache.size();
+
+    // Clear the HTTP response body
+    _body_index = index;
+    _body_size = 0;
+    _body_length = 0;
+    _chunked = true;
+}
+
 bool HTTPResponse::IsPendingHeader() const
 {
     return (!_error && (_body_index == 0));
@@ -217,192 +369,273 @@ bool HTTPResponse::IsPendingHeader() const
 
 bool HTTPResponse::IsPendingBody() const
 {
-    return (!_error && (_body_index > 0) && (_body_size > 0));
+    return (!_error && (_body_index > 0) && !IsBodyComplete());
 }
 
-bool HTTPResponse::ReceiveHeader(const void* buffer, size_t size)
+size_t HTTPResponse::ReceiveHeader(const void* buffer, size_t size)
 {
-    // Update the response cache
-    _cache.insert(_cache.end(), (const char*)buffer, (const char*)buffer + size);
+    const char* input = (const char*)buffer;
+
+    // The cache contains only the scanned header bytes, so the given buffer is scanned in place
+    size_t consumed = 0;
 
-    // Try to seek for HTTP header separator
-    for (size_t i = _cache_size; i < _cache.size(); ++i)
+    // Try to seek for HTTP header separator split between the cache and the given buffer
+    size_t tail = std::min(_cache.size(), (size_t)3);
+    if (tail > 0)
     {
-        // Check for the response cache out of bounds
-        if ((i + 3) >= _cache.size())
-            break;
+        char joint[6];
+        size_t head = std::min(size, (size_t)3);
+        std::copy(_cache.end() - tail, _cache.end(), joint);
+        std::copy(input, input + head, joint + tail);
+        size_t j = FindHeaderEnd(joint, tail + head, 0);
+        if (j < tail)
+            consumed = j + 4 - tail;
+    }
 
-        // Check for the header separator
-        if ((_cache[i + 0] == '\r') && (_cache[i + 1] == '\n') && (_cache[i + 2] == '\r') && (_cache[i + 3] == '\n'))
+    // Try to seek for HTTP header separator in the given buffer
+    if (consumed == 0)
+    {
+        size_t j = FindHeaderEnd(input, size, 0);
+        if (j == size)
         {
-            size_t index = 0;
+            // Update the response cache with the whole buffer
+            _cache.insert(_cache.end(), input, input + size);
 
-            // Set the error flag for a while...
-            _error = true;
+            // Update the parsed cache size
+            _cache_size = _cache.size();
+            return size;
+        }
+        consumed = j + 4;
+    }
 
-            // Parse protocol version
-            _protocol_index = index;
-            _protocol_size = 0;
-            while (_cache[index] != ' ')
-            {
-                ++_protocol_size;
-                ++index;
-                if (index >= _cache.size())
-                    return false;
-            }
-            ++index;
-            if (index >= _cache.size())
-                return false;
+    // Update the response cache only with the header bytes, the rest belongs to the body or to the next pipelined response
+    _cache.insert(_cache.end(), input, input + consumed);
 
-            // Parse status code
-            size_t status_index = index;
-            size_t status_size = 0;
-            while (_cache[index] != ' ')
-            {
-                if ((_cache[index] < '0') || (_cache[index] > '9'))
-                    return false;
-                ++status_size;
-                ++index;
-                if (index >= _cache.size())
-                    return false;
-            }
-            _status = 0;
-            for (size_t j = status_index; j < (status_index + status_size); ++j)
-            {
-                _status *= 10;
-                _status += _cache[j] - '0';
-            }
-            ++index;
-            if (index >= _cache.size())
-                return false;
+    const char* data = _cache.data();
 
-            // Parse status phrase
-            _status_phrase_index = index;
-            _status_phrase_size = 0;
-            while (_cache[index] != '\r')
-            {
-                ++_status_phrase_size;
-                ++index;
-                if (index >= _cache.size())
-                    return false;
-            }
-            ++index;
-            if ((index >= _cache.size()) || (_cache[index] != '\n'))
-                return false;
+    // HTTP header separator index
+    size_t i = _cache.size() - 4;
+
+    // Set the error flag for a while...
+    _error = true;
+
+    // Header lines are parsed up to the last line separator at the index 'i'
+    size_t end = i + 1;
+
+    // Parse protocol version
+    size_t index = 0;
+    _protocol_index = index;
+    _protocol_size = FindChar(data + index, end - index, ' ');
+    index += _protocol_size;
+    if ((index >= end) || (_protocol_size == 0))
+        return size;
+    ++index;
+
+    // Parse status code
+    size_t status_size = 0;
+    _status = 0;
+    while ((index < end) && (data[index] >= '0') && (data[index] <= '9'))
+    {
+        _status = _status * 10 + (data[index] - '0');
+        ++status_size;
+        ++index;
+    }
+    if ((index >= end) || (data[index] != ' ') || (status_size == 0) || (status_size > 3))
+        return size;
+    ++index;
+
+    // Parse status phrase
+    _status_phrase_index = index;
+    _status_phrase_size = FindChar2(data + index, end - index, '\r', '\n');
+    index += _status_phrase_size;
+    if ((index >= end) || (data[index] != '\r') || (data[index + 1] != '\n'))
+        return size;
+    index += 2;
+
+    // Parse headers
+    while (index < end)
+    {
+        // Parse header name
+        size_t header_name_index = index;
+        size_t header_name_size = FindChar2(data + index, end - index, ':', '\r');
+        index += header_name_size;
+        if ((index >= end) || (data[index] != ':'))
+            return size;
+        ++index;
+
+        // Skip all prefix space characters
+        while ((index < end) && ((data[index] == ' ') || (data[index] == '\t')))
             ++index;
-            if (index >= _cache.size())
-                return false;
 
-            // Parse headers
-            while ((index < _cache.size()) && (index < i))
-            {
-                // Parse header name
-                size_t header_name_index = index;
-                size_t header_name_size = 0;
-                while (_cache[index] != ':')
-                {
-                    ++header_name_size;
-                    ++index;
-                    if (index >= i)
-                        break;
-                    if (index >= _cache.size())
-                        return false;
-                }
-                ++index;
-                if (index >= i)
-                    break;
-                if (index >= _cache.size())
-                    return false;
-
-                // Skip all prefix space characters
-                while (std::isspace(_cache[index]))
-                {
-                    ++index;
-                    if (index >= i)
-                        break;
-                    if (index >= _cache.size())
-                        return false;
-                }
-
-                // Parse header value
-                size_t header_value_index = index;
-                size_t header_value_size = 0;
-                while (_cache[index] != '\r')
-                {
-                    ++header_value_size;
-                    ++index;
-                    if (index >= i)
-                        break;
-                    if (index >= _cache.size())
-                        return false;
-                }
-                ++index;
-                if ((index >= _cache.size()) || (_cache[index] != '\n'))
-                    return false;
-                ++index;
-                if (index >= _cache.size())
-                    return false;
-
-                // Validate header name and value
-                if ((header_name_size == 0) || (header_value_size == 0))
-                    return false;
-
-                // Add a new header
-                _headers.emplace_back(header_name_index, header_name_size, header_value_index, header_value_size);
-
-                // Try to find the body content length
-                if (std::string_view(_cache.data() + header_name_index, header_name_size) == "Content-Length")
-                {
-                    _body_length = 0;
-                    for (size_t j = header_value_index; j < (header_value_index + header_value_size); ++j)
-                    {
-                        if ((_cache[j] < '0') || (_cache[j] > '9'))
-                            return false;
-                        _body_length *= 10;
-                        _body_length += _cache[j] - '0';
-                    }
-                }
-            }
+        // Parse header value
+        size_t header_value_index = index;
+        size_t header_value_size = FindChar2(data + index, end - index, '\r', '\n');
+        index += header_value_size;
+        if ((index >= end) || (data[index] != '\r') || (data[index + 1] != '\n'))
+            return size;
+        index += 2;
 
-            // Reset the error flag
-            _error = false;
+        // Skip all suffix space characters
+        while ((header_value_size > 0) && ((data[header_value_index + header_value_size - 1] == ' ') || (data[header_value_index + header_value_size - 1] == '\t')))
+            --header_value_size;
 
-            // Update the body index and size
-            _body_index = i + 4;
-            _body_size = _cache.size() - i;
+        // Validate header name and value
+        if ((header_name_size == 0) || (header_value_size == 0))
+            return size;
 
-            // Update the parsed cache size
-            _cache_size = _cache.size();
+        // Add a new header
+        _headers.emplace_back(header_name_index, header_name_size, header_value_index, header_value_size);
 
-            return true;
+        // Try to find the body content length
+        if (CompareNoCase(std::string_view(data + header_name_index, header_name_size), "Content-Length"))
+        {
+            _body_length = 0;
+            for (size_t j = header_value_index; j < (header_value_index + header_value_size); ++j)
+            {
+                if ((data[j] < '0') || (data[j] > '9'))
+                    return size;
+                _body_length *= 10;
+                _body_length += data[j] - '0';
+            }
+            _body_length_provided = true;
         }
+        // Try to find the chunked transfer encoding (should be the final transfer coding)
+        else if (CompareNoCase(std::string_view(data + header_name_index, header_name_size), "Transfer-Encoding"))
+        {
+            std::string_view coding(data + header_value_index, header_value_size);
+            size_t separator = coding.rfind(',');
+            if (separator != std::string_view::npos)
+                coding.remove_prefix(separator + 1);
+            while (!coding.empty() && ((coding.front() == ' ') || (coding.front() == '\t')))
+                coding.remove_prefix(1);
+            _chunked = CompareNoCase(coding, "chunked");
+        }
+    }
+
+    // Chunked transfer encoding overrides the content length
+    if (_chunked)
+    {
+        _body_length = 0;
+        _body_length_provided = false;
+    }
+
+    // Informational, "No Content" and "Not Modified" responses have no body
+    if (((_status >= 100) && (_status < 200)) || (_status == 204) || (_status == 304))
+    {
+        _body_length = 0;
+        _body_length_provided = true;
+        _chunked = false;
     }
 
+    // Reset the error flag
+    _error = false;
+
+    // Update the body index and size
+    _body_index = i + 4;
+    _body_size = 0;
+
     // Update the parsed cache size
-    _cache_size = (_cache.size() >= 3) ? (_cache.size() - 3) : 0;
+    _cache_size = _cache.size();
 
-    return false;
+    return consumed;
 }
 
-bool HTTPResponse::ReceiveBody(const void* buffer, size_t size)
+size_t HTTPResponse::ReceiveBody(const void* buffer, size_t size)
 {
-    // Update HTTP response cache
-    _cache.insert(_cache.end(), (const char*)buffer, (const char*)buffer + size);
+    // Decode the chunked body
+    if (_chunked)
+        return ReceiveChunkedBody(buffer, size);
 
-    // Update the parsed cache size
-    _cache_size = _cache.size();
+    // Receive only the rest of the body with the provided content length
+    size_t consumed = size;
+    if (_body_length_provided)
+        consumed = std::min(size, _body_length - _body_size);
+
+    // Update HTTP response cache
+    _cache.append((const char*)buffer, consumed);
 
     // Update body size
-    _body_size += size;
+    _body_size += consumed;
+
+    return consumed;
+}
+
+size_t HTTPResponse::ReceiveChunkedBody(const void* buffer, size_t size)
+{
+    const char* data = (const char*)buffer;
+
+    // Decode only the rest of the chunked body
+    size_t consumed = 0;
+    while ((consumed < size) && !_chunked_decoder.complete() && !_chunked_decoder.error())
+    {
+        const char* part;
+        size_t part_size;
+        consumed += _chunked_decoder.Decode(data + consumed, size - consumed, part, part_size);
 
-    // Check if the body was fully parsed
-    if ((_body_length > 0) && (_body_size >= _body_length))
+        // Append the decoded body part
+        _cache.append(part, part_size);
+        _body_size += part_size;
+    }
+
+    // Check for chunked body error
+    if (_chunked_decoder.error())
+        _error = true;
+    else if (_chunked_decoder.complete())
+        _body_length = _body_size;
+
+    return consumed;
+}
+
+size_t HTTPResponse::ReceiveBodyPart(const void* buffer, size_t size, const char*& part, size_t& part_size)
+{
+    // Decode the next part of the chunked body
+    if (_chunked)
     {
-        _body_size = _body_length;
-        return true;
+        size_t consumed = _chunked_decoder.Decode(buffer, size, part, part_size);
+        _body_streamed += part_size;
+
+        // Check for chunked body error
+        if (_chunked_decoder.error())
+            _error = true;
+        else if (_chunked_decoder.complete())
+            _body_length = _body_streamed;
+
+        return consumed;
     }
 
-    return false;
+    part = (const char*)buffer;
+    part_size = size;
+
+    // Receive only the rest of the body with the provided content length
+    if (_body_length_provided)
+        part_size = std::min(size, _body_length - _body_streamed);
+
+    _body_streamed += part_size;
+
+    return part_size;
+}
+
+void HTTPResponse::SkipBody()
+{
+    _body_length = 0;
+    _body_length_provided = true;
+    _chunked = false;
+}
+
+bool HTTPResponse::IsBodyComplete() const
+{
+    if (_error || (_body_index == 0))
+        return false;
+
+    if (_chunked)
+        return _chunked_decoder.complete();
+
+    return (_body_length_provided && ((_body_streamed + _body_size) >= _body_length));
+}
+
+bool HTTPResponse::IsBodyUntilClose() const
+{
+    return (!_body_length_provided && !_chunked);
 }
 
 } // namespace HTTP
@@ -0,0 +1,194 @@
+/*!
+    \file http_session.cpp
+    \brief HTTP session implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/http/http_session.h"
+
+namespace CppServer {
+namespace HTTP {
+
+size_t HTTPSession::SendResponse(const HTTPResponse& response)
+{
+    size_t sent = Send(response.cache());
+
+    // Close the connection if requested by the client (chunked response is closed by the last chunk)
+    if (_closing && !response.chunked())
+        Disconnect();
+
+    return sent;
+}
+
+bool HTTPSession::SendResponseAsync(const HTTPResponse& response)
+{
+    // Close the connection when the response is sent (chunked response is closed by the last chunk).
+    // The flag is set before sending, so the send completion handler could not miss it.
+    if (_closing && !response.chunked())
+        _disconnect_pending = true;
+
+    return SendAsync(response.cache());
+}
+
+size_t HTTPSession::SendResponseBodyChunk(const void* buffer, size_t size)
+{
+    std::string header = HTTPChunkedEncoder::ChunkHeader(size);
+
+    size_t sent = Send(header);
+    if (size > 0)
+        sent += Send(buffer, size);
+    sent += Send(HTTPChunkedEncoder::ChunkTrailer());
+
+    // Close the connection after the last chunk if requested by the client
+    if (_closing && (size == 0))
+        Disconnect();
+
+    return sent;
+}
+
+bool HTTPSession::SendResponseBodyChunkAsync(const void* buffer, size_t size)
+{
+    std::string header = HTTPChunkedEncoder::ChunkHeader(size);
+
+    // The last chunk is sent with one buffer, so the connection is never closed in the middle of it
+    if (size == 0)
+    {
+        // Close the connection when the last chunk is sent.
+        // The flag is set before sending, so the send completion handler could not miss it.
+        if (_closing)
+            _disconnect_pending = true;
+
+        return SendAsync(header.append(HTTPChunkedEncoder::ChunkTrailer()));
+    }
+
+    if (!SendAsync(header))
+        return false;
+    if (!SendAsync(buffer, size))
+        return false;
+    return SendAsync(HTTPChunkedEncoder::ChunkTrailer());
+}
+
+void HTTPSession::onReceived(const void* buffer, size_t size)
+{
+    // Receive data of the upgraded protocol
+    if (_upgraded)
+    {
+        onReceivedUpgraded(buffer, size);
+        return;
+    }
+
+    const uint8_t* data = (const uint8_t*)buffer;
+
+    // Parse requests in place of the receive buffer
+    while (!_closing)
+    {
+        // Receive HTTP request header
+        if (_request.IsPendingHeader())
+        {
+            size_t consumed = _request.ReceiveHeader(data, size);
+            data += consumed;
+            size -= consumed;
+
+            // Check for HTTP request error
+            if (_request.error())
+            {
+                RejectRequest(400, "Invalid HTTP request!");
+                return;
+            }
+
+            // Check HTTP request header limits
+            if (((_option_max_header_size > 0) && (_request.cache().size() > _option_max_header_size)) ||
+                ((_option_max_headers > 0) && (_request.headers() > _option_max_headers)))
+            {
+                RejectRequest(431, "HTTP request header is too large!");
+                return;
+            }
+
+            // Wait for the rest of HTTP request header
+            if (_request.IsPendingHeader())
+                return;
+
+            // Check HTTP request body length
+            if ((_option_max_body_size > 0) && !_request.chunked() && (_request.body_length() > _option_max_body_size))
+            {
+                RejectRequest(413, "HTTP request body is too large!");
+                return;
+            }
+
+            onReceivedRequestHeader(_request);
+        }
+
+        // Receive HTTP request body
+        if (_request.IsPendingBody())
+        {
+            size_t consumed = _request.ReceiveBody(data, size);
+            data += consumed;
+            size -= consumed;
+
+            // Check for HTTP request error
+            if (_request.error())
+            {
+                RejectRequest(400, "Invalid HTTP request body!");
+                return;
+            }
+
+            // Check decoded HTTP request chunked body size
+            if ((_option_max_body_size > 0) && (_request.body().size() > _option_max_body_size))
+            {
+                RejectRequest(413, "HTTP request body is too large!");
+                return;
+            }
+
+            // Wait for the rest of HTTP request body
+            if (_request.IsPendingBody())
+                return;
+        }
+
+        // Switch the connection to the upgraded protocol if the upgrade is accepted
+        if (_request.IsUpgrade() && onReceivedRequestUpgrade(_request))
+        {
+            _upgraded = true;
+            _request.Clear();
+
+            // The rest of received data belongs to the upgraded protocol
+            if (size > 0)
+                onReceivedUpgraded(data, size);
+            return;
+        }
+
+        // Close the connection after the response if requested by the client
+        _closing = !_request.IsKeepAlive();
+
+        onReceivedRequest(_request);
+        _request.Clear();
+
+        // Process the next pipelined request
+        if (size == 0)
+            return;
+    }
+}
+
+void HTTPSession::RejectRequest(int status, const std::string& error)
+{
+    onReceivedRequestError(_request, error);
+    _request.Clear();
+
+    // Answer with the error response and disconnect the session when it is sent
+    _closing = true;
+    HTTPResponse response(status);
+    response.SetHeader("Connection", "close");
+    response.SetBody();
+    SendResponseAsync(response);
+}
+
+void HTTPSession::onSent(size_t sent, size_t pending)
+{
+    // Disconnect when the last response is sent
+    if (_disconnect_pending && (pending == 0))
+        Disconnect();
+}
+
+} // namespace HTTP
+} // namespace CppServer
@@ -8,53 +8,324 @@
 
 #include "server/http/https_client.h"
 
+#include <algorithm>
+
 namespace CppServer {
 namespace HTTP {
 
+//! HTTPS client HTTP/2 connection
+class HTTPSClient::HTTP2 : public HTTP2Connection
+{
+public:
+    explicit HTTP2(HTTPSClient& client) : HTTP2Connection(false), _client(client) {}
+
+    // Received HTTP response or stream error
+    struct Received
+    {
+        HTTPResponse response;
+        std::string error;
+    };
+
+    // Received responses are notified outside of the connection lock
+    std::vector<Received> received;
+
+protected:
+    void onSend(const void* buffer, size_t size) override { _client.SendAsync(buffer, size); }
+
+    void onReceivedResponse(const HTTPResponse& response) override
+    {
+        received.push_back({ response, std::string() });
+    }
+
+    void onStreamError(uint32_t stream, const std::string& error) override
+    {
+        Received item;
+        item.response.SetStream(stream);
+        item.error = error;
+        received.emplace_back(std::move(item));
+    }
+
+private:
+    HTTPSClient& _client;
+};
+
+size_t HTTPSClient::SendRequest(const HTTPRequest& request)
+{
+    if (_http2_enabled)
+        return (SendRequestStream(request) != 0) ? request.cache().size() : 0;
+
+    return Send(request.cache());
+}
+
+size_t HTTPSClient::SendRequest(const HTTPRequest& request, const CppCommon::Timespan& timeout)
+{
+    if (_http2_enabled)
+        return (SendRequestStream(request) != 0) ? request.cache().size() : 0;
+
+    return Send(request.cache(), timeout);
+}
+
+size_t HTTPSClient::SendRequestBody(const void* buffer, size_t size)
+{
+    if (_http2_enabled)
+        return SendRequestStreamBody(buffer, size) ? size : 0;
+
+    return Send(buffer, size);
+}
+
+size_t HTTPSClient::SendRequestBody(const void* buffer, size_t size, const CppCommon::Timespan& timeout)
+{
+    if (_http2_enabled)
+        return SendRequestStreamBody(buffer, size) ? size : 0;
+
+    return Send(buffer, size, timeout);
+}
+
+bool HTTPSClient::SendRequestAsync(const HTTPRequest& request)
+{
+    if (_http2_enabled)
+        return (SendRequestStream(request) != 0);
+
+    return SendAsync(request.cache());
+}
+
+bool HTTPSClient::SendRequestBodyAsync(const void* buffer, size_t size)
+{
+    if (_http2_enabled)
+        return SendRequestStreamBody(buffer, size);
+
+    return SendAsync(buffer, size);
+}
+
+size_t HTTPSClient::SendRequestBodyChunk(const void* buffer, size_t size)
+{
+    // HTTP/2 stream data is not chunk encoded
+    if (_http2_enabled)
+        return SendRequestStreamBody(buffer, size) ? size : 0;
+
+    std::string header = HTTPChunkedEncoder::ChunkHeader(size);
+
+    size_t sent = Send(header);
+    if (size > 0)
+        sent += Send(buffer, size);
+    sent += Send(HTTPChunkedEncoder::ChunkTrailer());
+
+    return sent;
+}
+
+bool HTTPSClient::SendRequestBodyChunkAsync(const void* buffer, size_t size)
+{
+    // HTTP/2 stream data is not chunk encoded
+    if (_http2_enabled)
+        return SendRequestStreamBody(buffer, size);
+
+    std::string header = HTTPChunkedEncoder::ChunkHeader(size);
+
+    if (!SendAsync(header))
+        return false;
+    if ((size > 0) && !SendAsync(buffer, size))
+        return false;
+    return SendAsync(HTTPChunkedEncoder::ChunkTrailer());
+}
+
+uint32_t HTTPSClient::SendRequestStream(const HTTPRequest& request)
+{
+    std::scoped_lock locker(_http2_lock);
+
+    if (!_http2)
+        return 0;
+
+    _http2_stream = _http2->SendRequest(request);
+    return _http2_stream;
+}
+
+bool HTTPSClient::SendRequestStreamBody(const void* buffer, size_t size)
+{
+    std::scoped_lock locker(_http2_lock);
+
+    if (!_http2 || (_http2_stream == 0))
+        return false;
+
+    return _http2->SendBody(_http2_stream, buffer, size);
+}
+
+void HTTPSClient::ResetRequestStream(uint32_t stream)
+{
+    std::scoped_lock locker(_http2_lock);
+
+    if (_http2)
+        _http2->ResetStream(stream);
+}
+
+size_t HTTPSClient::max_request_streams()
+{
+    std::scoped_lock locker(_http2_lock);
+
+    return _http2 ? std::max(_http2->max_streams(), (size_t)1) : 1;
+}
+
+void HTTPSClient::onHandshaked()
+{
+    // Switch to HTTP/2 protocol if it was negotiated with the server
+    if (alpn_protocol() == "h2")
+    {
+        std::scoped_lock locker(_http2_lock);
+        _http2 = std::make_shared<HTTP2>(*this);
+        _http2_stream = 0;
+        _http2_enabled = true;
+        _http2->Start();
+    }
+}
+
 void HTTPSClient::onReceived(const void* buffer, size_t size)
 {
-    // Receive HTTP response header
-    if (_response.IsPendingHeader())
+    // Receive HTTP/2 frames
+    if (_http2_enabled)
     {
-        if (_response.ReceiveHeader(buffer, size))
-            onReceivedResponseHeader(_response);
+        bool result = false;
+        std::vector<HTTP2::Received> received;
+
+        {
+            std::scoped_lock locker(_http2_lock);
+            if (_http2)
+            {
+                result = _http2->Receive(buffer, size);
+                received = std::move(_http2->received);
+                _http2->received.clear();
+            }
+        }
 
-        size = 0;
+        // Notify received responses without the connection lock
+        for (auto& item : received)
+        {
+            if (item.error.empty())
+            {
+                onReceivedResponseHeader(item.response);
+                onReceivedResponse(item.response);
+            }
+            else
+                onReceivedResponseError(item.response, item.error);
+        }
+
+        if (!result)
+            DisconnectAsync();
+        return;
     }
 
-    // Check for HTTP response error
-    if (_response.error())
+    // Receive data of the upgraded protocol
+    if (_upgraded)
     {
-        onReceivedResponseError(_response, "Invalid HTTP response!");
-        _response.Clear();
-        DisconnectAsync();
+        onReceivedUpgraded(buffer, size);
         return;
     }
 
-    // Receive HTTP response body
-    if (_response.ReceiveBody(buffer, size))
+    const char* data = (const char*)buffer;
+
+    // Parse pipelined responses in place of the receive buffer
+    while (true)
     {
+        // Receive HTTP response header
+        if (_response.IsPendingHeader())
+        {
+            size_t consumed = _response.ReceiveHeader(data, size);
+            data += consumed;
+            size -= consumed;
+
+            // Check for HTTP response error
+            if (_response.error())
+            {
+                onReceivedResponseError(_response, "Invalid HTTP response!");
+                _response.Clear();
+                DisconnectAsync();
+                return;
+            }
+
+            // Wait for the rest of HTTP response header
+            if (_response.IsPendingHeader())
+                return;
+
+            onReceivedResponseHeader(_response);
+        }
+
+        // Receive HTTP response body
+        size_t consumed = _option_stream_body ? ReceiveBodyParts(data, size) : _response.ReceiveBody(data, size);
+        data += consumed;
+        size -= consumed;
+
+        // Check for HTTP response error
+        if (_response.error())
+        {
+            onReceivedResponseError(_response, "Invalid HTTP response!");
+            _response.Clear();
+            DisconnectAsync();
+            return;
+        }
+
+        // Wait for the rest of HTTP response body
+        if (!_response.IsBodyComplete())
+            return;
+
+        // Switch the connection to the upgraded protocol if the upgrade is accepted
+        if ((_response.status() == 101) && onReceivedResponseUpgrade(_response))
+        {
+            _upgraded = true;
+            _response.Clear();
+
+            // The rest of received data belongs to the upgraded protocol
+            if (size > 0)
+                onReceivedUpgraded(data, size);
+            return;
+        }
+
         onReceivedResponse(_response);
         _response.Clear();
-        return;
+
+        // Process the next pipelined response
+        if (size == 0)
+            return;
     }
+}
+
+size_t HTTPSClient::ReceiveBodyParts(const void* buffer, size_t size)
+{
+    const char* data = (const char*)buffer;
 
-    // Check for HTTP response error
-    if (_response.error())
+    size_t consumed = 0;
+    while ((consumed < size) && !_response.error() && !_response.IsBodyComplete())
     {
-        onReceivedResponseError(_response, "Invalid HTTP response!");
-        _response.Clear();
-        DisconnectAsync();
-        return;
+        const char* part;
+        size_t part_size;
+        consumed += _response.ReceiveBodyPart(data + consumed, size - consumed, part, part_size);
+
+        if (part_size > 0)
+            onReceivedResponseBodyPart(_response, part, part_size);
     }
+
+    return consumed;
 }
 
 void HTTPSClient::onDisconnected()
 {
+    // The next connection starts with HTTP protocol
+    _upgraded = false;
+
+    // Reset HTTP/2 connection
+    if (_http2_enabled)
+    {
+        std::scoped_lock locker(_http2_lock);
+        _http2.reset();
+        _http2_enabled = false;
+        return;
+    }
+
     // Receive HTTP response body
     if (_response.IsPendingBody())
     {
-        onReceivedResponse(_response);
+        // Only the body without the content length and the chunked transfer encoding is finished by the connection close
+        if (_response.IsBodyUntilClose())
+            onReceivedResponse(_response);
+        else
+            onReceivedResponseError(_response, "Connection closed before the end of HTTP response body!");
         _response.Clear();
         return;
     }
@@ -62,66 +333,260 @@ void HTTPSClient::onDisconnected()
 
 std::future<HTTPResponse> HTTPSClientEx::MakeRequest(const HTTPRequest& request, const CppCommon::Timespan& timeout)
 {
-    // Create TCP resolver if the current one is empty
-    if (!_resolver)
-        _resolver = std::make_shared<Asio::TCPResolver>(service());
-    // Create timer if the current one is empty
-    if (!_timer)
-        _timer = std::make_shared<Asio::Timer>(service());
+    auto pending = std::make_shared<Request>();
+    pending->request = request;
 
-    _promise = std::promise<HTTPResponse>();
-    _request = request;
+    auto future = pending->promise.get_future();
 
-    // Connect to Web server
-    if (!ConnectAsync(_resolver))
-        _promise.set_exception(std::make_exception_ptr(std::runtime_error("Connection failed!")));
-
-    // Setup timeout check timer
-    auto self(this->shared_from_this());
-    auto timeout_handler = [this, self](bool canceled)
+    // Setup timeout check timer of the request
+    std::weak_ptr<Asio::SSLClient> weak_client = shared_from_this();
+    std::weak_ptr<Request> weak_request = pending;
+    auto timeout_handler = [weak_client, weak_request](bool canceled)
     {
         if (canceled)
             return;
 
-        // Disconnect on timeout
-        onReceivedResponseError(_response, "Timeout!");
-        _response.Clear();
-        DisconnectAsync();
+        auto client = weak_client.lock();
+        auto request = weak_request.lock();
+        if (client && request)
+            std::static_pointer_cast<HTTPSClientEx>(client)->onRequestTimeout(request);
     };
-    if (!_timer->Setup(timeout_handler, timeout) || !_timer->WaitAsync())
-        _promise.set_exception(std::make_exception_ptr(std::runtime_error("Timeout setup failed!")));
+    pending->timer = std::make_shared<Asio::Timer>(service());
+    if (!pending->timer->Setup(timeout_handler, timeout) || !pending->timer->WaitAsync())
+    {
+        pending->promise.set_exception(std::make_exception_ptr(std::runtime_error("Timeout setup failed!")));
+        return future;
+    }
+
+    bool connect = false;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        // Create TCP resolver if the current one is empty
+        if (!_resolver)
+            _resolver = std::make_shared<Asio::TCPResolver>(service());
+
+        _queue.emplace_back(pending);
+
+        // Send the request over the keep-alive connection or connect to Web server
+        if (IsHandshaked() && !_connecting)
+            SendRequests();
+        else if (!_connecting)
+            _connecting = connect = true;
+    }
+
+    if (connect && !ConnectAsync(_resolver))
+        FailRequests("Connection failed!");
+
+    return future;
+}
+
+void HTTPSClientEx::SendRequests()
+{
+    // Multiplex queued requests over HTTP/2 streams up to the concurrent streams limit
+    if (IsHTTP2())
+    {
+        size_t depth = max_request_streams();
+        while (!_queue.empty() && (_pipeline.size() < depth))
+        {
+            auto request = _queue.front();
+            request->stream = SendRequestStream(request->request);
+
+            // Connection is going away, so the rest of requests wait for a new connection
+            if (request->stream == 0)
+                return;
+
+            _queue.pop_front();
+            _pipeline.emplace_back(request);
+        }
+        return;
+    }
+
+    // Send queued requests up to the pipeline depth
+    while (!_queue.empty() && (_pipeline.size() < _option_pipeline_depth))
+    {
+        auto request = _queue.front();
+        _queue.pop_front();
+        _pipeline.emplace_back(request);
+        SendRequestAsync(request->request);
+    }
+}
+
+std::shared_ptr<HTTPSClientEx::Request> HTTPSClientEx::TakeRequest(const HTTPResponse& response)
+{
+    // HTTP/1.1 responses are matched to requests in order, HTTP/2 responses by the stream identifier
+    auto it = _pipeline.begin();
+    if (response.stream() != 0)
+        it = std::find_if(_pipeline.begin(), _pipeline.end(), [&response](const std::shared_ptr<Request>& request) { return request->stream == response.stream(); });
+
+    if (it == _pipeline.end())
+        return nullptr;
+
+    auto request = *it;
+    _pipeline.erase(it);
+    return request;
+}
+
+void HTTPSClientEx::FailRequests(const std::string& error)
+{
+    std::deque<std::shared_ptr<Request>> requests;
 
-    return _promise.get_future();
+    {
+        std::scoped_lock locker(_lock);
+        _connecting = false;
+        requests = std::move(_pipeline);
+        _pipeline.clear();
+        for (auto& request : _queue)
+            requests.emplace_back(request);
+        _queue.clear();
+    }
+
+    for (auto& request : requests)
+    {
+        request->timer->Cancel();
+        request->promise.set_exception(std::make_exception_ptr(std::runtime_error(error)));
+    }
 }
 
 void HTTPSClientEx::onHandshaked()
 {
-    if (!SendRequestAsync())
-        _promise.set_exception(std::make_exception_ptr(std::runtime_error("Send HTTP request failed!")));
+    HTTPSClient::onHandshaked();
+
+    std::scoped_lock locker(_lock);
+    _connecting = false;
+    SendRequests();
 }
 
 void HTTPSClientEx::onDisconnected()
 {
-    // Cancel timeout check timer
-    _timer->Cancel();
-
     HTTPSClient::onDisconnected();
+
+    std::deque<std::shared_ptr<Request>> closed;
+    bool failed = false;
+    bool reconnect = false;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        // Sent requests without responses fail with the connection
+        closed = std::move(_pipeline);
+        _pipeline.clear();
+
+        // Queued requests fail if the connection was not established,
+        // otherwise they are sent over a new connection
+        failed = _connecting;
+        reconnect = !failed && !_queue.empty();
+        _connecting = reconnect;
+    }
+
+    for (auto& request : closed)
+    {
+        request->timer->Cancel();
+        request->promise.set_exception(std::make_exception_ptr(std::runtime_error("Connection closed!")));
+    }
+
+    if (failed || (reconnect && !ConnectAsync(_resolver)))
+        FailRequests("Connection failed!");
+}
+
+void HTTPSClientEx::onReceivedResponseHeader(const HTTPResponse& response)
+{
+    std::scoped_lock locker(_lock);
+
+    // Response to HEAD request has no body
+    if ((response.stream() == 0) && !_pipeline.empty() && (_pipeline.front()->request.method() == "HEAD"))
+        SkipResponseBody();
 }
 
 void HTTPSClientEx::onReceivedResponse(const HTTPResponse& response)
 {
-    // Cancel timeout check timer
-    _timer->Cancel();
+    // Skip interim informational responses
+    if ((response.status() >= 100) && (response.status() < 200) && (response.status() != 101))
+        return;
+
+    std::shared_ptr<Request> request;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        request = TakeRequest(response);
+        if (!request)
+            return;
 
-    _promise.set_value(response);
+        SendRequests();
+    }
+
+    request->timer->Cancel();
+    request->promise.set_value(response);
 }
 
 void HTTPSClientEx::onReceivedResponseError(const HTTPResponse& response, const std::string& error)
 {
-    // Cancel timeout check timer
-    _timer->Cancel();
+    std::shared_ptr<Request> request;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        request = TakeRequest(response);
+        if (!request)
+            return;
+
+        // Failed HTTP/2 stream frees the slot for the next request
+        if (request->stream != 0)
+            SendRequests();
+    }
+
+    request->timer->Cancel();
+    request->promise.set_exception(std::make_exception_ptr(std::runtime_error(error)));
+}
+
+void HTTPSClientEx::onRequestTimeout(const std::shared_ptr<Request>& request)
+{
+    std::deque<std::shared_ptr<Request>> requests;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        // Queued request is just removed
+        auto it = std::find(_queue.begin(), _queue.end(), request);
+        if (it != _queue.end())
+            _queue.erase(it);
+        else
+        {
+            it = std::find(_pipeline.begin(), _pipeline.end(), request);
+            if (it == _pipeline.end())
+                return;
 
-    _promise.set_exception(std::make_exception_ptr(std::runtime_error(error)));
+            if (request->stream != 0)
+            {
+                // Sent HTTP/2 request is canceled by resetting its stream
+                _pipeline.erase(it);
+                ResetRequestStream(request->stream);
+                SendRequests();
+            }
+            else
+            {
+                // Sent request could not be skipped in the pipeline, so the connection is closed
+                requests = std::move(_pipeline);
+                _pipeline.clear();
+            }
+        }
+    }
+
+    request->promise.set_exception(std::make_exception_ptr(std::runtime_error("Timeout!")));
+
+    if (!requests.empty())
+    {
+        for (auto& other : requests)
+        {
+            if (other == request)
+                continue;
+            other->timer->Cancel();
+            other->promise.set_exception(std::make_exception_ptr(std::runtime_error("Connection closed!")));
+        }
+        DisconnectAsync();
+    }
 }
 
 } // namespace HTTP
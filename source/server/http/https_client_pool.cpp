@@ -0,0 +1,573 @@
+/*!
+    \file https_client_pool.cpp
+    \brief HTTPS client connection pool implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/http/https_client_pool.h"
+
+#include "time/timestamp.h"
+
+#include <algorithm>
+
+namespace CppServer {
+namespace HTTP {
+
+namespace {
+
+bool CompareNoCase(std::string_view str1, std::string_view str2)
+{
+    if (str1.size() != str2.size())
+        return false;
+
+    for (size_t i = 0; i < str1.size(); ++i)
+    {
+        char ch1 = str1[i];
+        char ch2 = str2[i];
+        if ((ch1 >= 'A') && (ch1 <= 'Z'))
+            ch1 += 'a' - 'A';
+        if ((ch2 >= 'A') && (ch2 <= 'Z'))
+            ch2 += 'a' - 'A';
+        if (ch1 != ch2)
+            return false;
+    }
+
+    return true;
+}
+
+// Update the keep-alive flag with options of the connection header
+void ParseConnection(std::string_view value, bool& keep_alive)
+{
+    size_t index = 0;
+    while (index < value.size())
+    {
+        size_t next = value.find(',', index);
+        if (next == std::string_view::npos)
+            next = value.size();
+
+        std::string_view option = value.substr(index, next - index);
+        while (!option.empty() && ((option.front() == ' ') || (option.front() == '\t')))
+            option.remove_prefix(1);
+        while (!option.empty() && ((option.back() == ' ') || (option.back() == '\t')))
+            option.remove_suffix(1);
+
+        if (CompareNoCase(option, "close"))
+            keep_alive = false;
+        else if (CompareNoCase(option, "keep-alive"))
+            keep_alive = true;
+
+        index = next + 1;
+    }
+}
+
+// Could the connection be reused after the given request and response?
+bool IsKeepAlive(const HTTPRequest& request, const HTTPResponse& response)
+{
+    bool keep_alive = (response.protocol() == "HTTP/1.1");
+    for (size_t i = 0; i < response.headers(); ++i)
+    {
+        auto [key, value] = response.header(i);
+        if (CompareNoCase(key, "Connection"))
+            ParseConnection(value, keep_alive);
+    }
+
+    for (size_t i = 0; i < request.headers(); ++i)
+    {
+        auto [key, value] = request.header(i);
+        if (CompareNoCase(key, "Connection"))
+        {
+            bool request_keep_alive = true;
+            ParseConnection(value, request_keep_alive);
+            keep_alive = keep_alive && request_keep_alive;
+        }
+    }
+
+    return keep_alive;
+}
+
+// Get the time left to the request deadline
+CppCommon::Timespan Remaining(uint64_t deadline)
+{
+    uint64_t timestamp = CppCommon::Timestamp::nano();
+    return CppCommon::Timespan::nanoseconds((deadline > timestamp) ? (int64_t)(deadline - timestamp) : 0);
+}
+
+// Could the request be safely retried?
+bool IsIdempotent(std::string_view method)
+{
+    return ((method == "GET") || (method == "HEAD") || (method == "PUT") || (method == "DELETE") || (method == "OPTIONS") || (method == "TRACE"));
+}
+
+} // namespace
+
+//! Pooled HTTPS client connection
+class HTTPSClientPool::Connection : public HTTPSClient
+{
+public:
+    Connection(std::shared_ptr<HTTPSClientPool> pool, const std::string& key, std::shared_ptr<Asio::Service> service, std::shared_ptr<Asio::SSLContext> context, const std::string& address, int port)
+        : HTTPSClient(service, context, address, port),
+          key(key),
+          _pool(pool)
+    {
+    }
+
+    // Connection state (protected by the pool lock)
+    const std::string key;
+    std::shared_ptr<Request> request;
+    std::shared_ptr<Asio::Timer> timer;
+    uint64_t timer_id{0};
+    bool idle{false};
+    size_t served{0};
+
+protected:
+    void onHandshaked() override
+    {
+        HTTPSClient::onHandshaked();
+
+        auto pool = _pool.lock();
+        if (!pool)
+            return;
+
+        std::shared_ptr<Request> current;
+        {
+            std::scoped_lock locker(pool->_lock);
+            current = request;
+        }
+
+        // Send the request assigned to the new connection
+        if (current)
+            SendRequestAsync(current->request);
+    }
+
+    void onDisconnected() override
+    {
+        // Check if any part of the current response was received
+        bool received = !_response.cache().empty();
+
+        HTTPSClient::onDisconnected();
+
+        auto pool = _pool.lock();
+        if (pool)
+            pool->onConnectionDisconnected(std::static_pointer_cast<Connection>(shared_from_this()), received);
+    }
+
+    void onReceivedResponseHeader(const HTTPResponse& response) override
+    {
+        auto pool = _pool.lock();
+        if (!pool)
+            return;
+
+        // Response to HEAD request has no body
+        std::scoped_lock locker(pool->_lock);
+        if (request && (request->request.method() == "HEAD"))
+            SkipResponseBody();
+    }
+
+    void onReceivedResponse(const HTTPResponse& response) override
+    {
+        auto pool = _pool.lock();
+        if (pool)
+            pool->onConnectionResponse(std::static_pointer_cast<Connection>(shared_from_this()), response);
+    }
+
+    void onReceivedResponseError(const HTTPResponse& response, const std::string& error) override
+    {
+        auto pool = _pool.lock();
+        if (pool)
+            pool->onConnectionError(std::static_pointer_cast<Connection>(shared_from_this()), error);
+    }
+
+private:
+    std::weak_ptr<HTTPSClientPool> _pool;
+};
+
+HTTPSClientPool::HTTPSClientPool(std::shared_ptr<Asio::Service> service, std::shared_ptr<Asio::SSLContext> context, size_t max_connections_per_host, const CppCommon::Timespan& idle_timeout)
+    : _service(service),
+      _context(context),
+      _resolver(std::make_shared<Asio::TCPResolver>(service)),
+      _max_connections_per_host(std::max(max_connections_per_host, (size_t)1)),
+      _idle_timeout(idle_timeout),
+      _timer_id(0)
+{
+}
+
+HTTPSClientPool::~HTTPSClientPool()
+{
+    DisconnectAll();
+}
+
+size_t HTTPSClientPool::connections()
+{
+    std::scoped_lock locker(_lock);
+
+    size_t result = 0;
+    for (const auto& host : _hosts)
+        result += host.second.connections.size();
+    return result;
+}
+
+size_t HTTPSClientPool::idle_connections()
+{
+    std::scoped_lock locker(_lock);
+
+    size_t result = 0;
+    for (const auto& host : _hosts)
+        result += host.second.idle.size();
+    return result;
+}
+
+std::future<HTTPResponse> HTTPSClientPool::MakeRequest(const std::string& address, int port, const HTTPRequest& request, const CppCommon::Timespan& timeout)
+{
+    auto pending = std::make_shared<Request>();
+    pending->address = address;
+    pending->port = port;
+    pending->request = request;
+    pending->deadline = CppCommon::Timestamp::nano() + timeout.total();
+
+    auto future = pending->promise.get_future();
+
+    Dispatch(pending);
+
+    return future;
+}
+
+void HTTPSClientPool::DisconnectAll()
+{
+    std::vector<std::shared_ptr<Connection>> connections;
+    std::vector<std::shared_ptr<Request>> requests;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        for (auto& host : _hosts)
+        {
+            for (auto& connection : host.second.connections)
+            {
+                if (connection->request)
+                    requests.emplace_back(std::move(connection->request));
+                if (connection->timer)
+                    connection->timer->Cancel();
+                connection->timer.reset();
+                connection->timer_id = 0;
+                connections.emplace_back(connection);
+            }
+            while (!host.second.queue.empty())
+                requests.emplace_back(Dequeue(host.second));
+        }
+        _hosts.clear();
+    }
+
+    for (auto& request : requests)
+        request->promise.set_exception(std::make_exception_ptr(std::runtime_error("Connection pool disconnected!")));
+    for (auto& connection : connections)
+        connection->DisconnectAsync();
+}
+
+void HTTPSClientPool::Dispatch(std::shared_ptr<Request> request)
+{
+    const std::string key = request->address + ":" + std::to_string(request->port);
+
+    std::shared_ptr<Connection> connection;
+    bool created = false;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        auto& host = _hosts[key];
+
+        if (!host.idle.empty())
+        {
+            // Reuse the most recently used idle connection
+            connection = host.idle.back();
+            host.idle.pop_back();
+            connection->idle = false;
+        }
+        else if (host.connections.size() < _max_connections_per_host)
+        {
+            // Open a new connection
+            connection = std::make_shared<Connection>(shared_from_this(), key, _service, _context, request->address, request->port);
+            host.connections.emplace_back(connection);
+            created = true;
+        }
+        else
+        {
+            // Wait for the first free connection
+            Enqueue(host, request);
+            return;
+        }
+
+        connection->request = request;
+        Arm(connection, Remaining(request->deadline));
+    }
+
+    if (!created)
+    {
+        connection->SendRequestAsync(request->request);
+        return;
+    }
+
+    if (!connection->ConnectAsync(_resolver))
+    {
+        {
+            std::scoped_lock locker(_lock);
+            connection->request.reset();
+            Remove(connection);
+        }
+        request->promise.set_exception(std::make_exception_ptr(std::runtime_error("Connection failed!")));
+        Pump(key);
+    }
+}
+
+void HTTPSClientPool::Pump(const std::string& key)
+{
+    std::vector<std::shared_ptr<Request>> requests;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        auto it = _hosts.find(key);
+        if (it == _hosts.end())
+            return;
+
+        auto& host = it->second;
+
+        // Take queued requests which could be served by new connections
+        while (!host.queue.empty() && ((host.connections.size() + requests.size()) < _max_connections_per_host))
+            requests.emplace_back(Dequeue(host));
+
+        // Forget the host without connections and queued requests
+        if (requests.empty() && host.connections.empty() && host.queue.empty())
+            _hosts.erase(it);
+    }
+
+    for (auto& request : requests)
+        Dispatch(request);
+}
+
+void HTTPSClientPool::Arm(const std::shared_ptr<Connection>& connection, const CppCommon::Timespan& timeout)
+{
+    // Cancel the previous connection timer
+    if (connection->timer)
+        connection->timer->Cancel();
+
+    // Each timer wait uses its own timer with the unique Id, so stale notifications could be detected
+    auto timer = std::make_shared<Asio::Timer>(_service);
+    std::weak_ptr<HTTPSClientPool> weak_pool = shared_from_this();
+    std::weak_ptr<Connection> weak_connection = connection;
+    uint64_t id = ++_timer_id;
+    auto timer_handler = [weak_pool, weak_connection, id](bool canceled)
+    {
+        if (canceled)
+            return;
+
+        auto pool = weak_pool.lock();
+        auto connection = weak_connection.lock();
+        if (pool && connection)
+            pool->onConnectionTimer(connection, id);
+    };
+    if (timer->Setup(timer_handler, timeout))
+        timer->WaitAsync();
+
+    connection->timer = timer;
+    connection->timer_id = id;
+}
+
+void HTTPSClientPool::Enqueue(Host& host, const std::shared_ptr<Request>& request)
+{
+    host.queue.emplace_back(request);
+
+    // Queued request is failed by its timeout as well, even if no connection becomes free
+    auto timer = std::make_shared<Asio::Timer>(_service);
+    std::weak_ptr<HTTPSClientPool> weak_pool = shared_from_this();
+    std::weak_ptr<Request> weak_request = request;
+    auto timer_handler = [weak_pool, weak_request](bool canceled)
+    {
+        if (canceled)
+            return;
+
+        auto pool = weak_pool.lock();
+        auto request = weak_request.lock();
+        if (pool && request)
+            pool->onRequestTimer(request);
+    };
+    if (timer->Setup(timer_handler, Remaining(request->deadline)))
+        timer->WaitAsync();
+
+    request->timer = timer;
+}
+
+std::shared_ptr<HTTPSClientPool::Request> HTTPSClientPool::Dequeue(Host& host)
+{
+    auto request = host.queue.front();
+    host.queue.pop_front();
+
+    // Cancel the queued request timer
+    if (request->timer)
+        request->timer->Cancel();
+    request->timer.reset();
+
+    return request;
+}
+
+void HTTPSClientPool::Remove(const std::shared_ptr<Connection>& connection)
+{
+    auto it = _hosts.find(connection->key);
+    if (it == _hosts.end())
+        return;
+
+    auto& host = it->second;
+    host.connections.erase(std::remove(host.connections.begin(), host.connections.end(), connection), host.connections.end());
+    host.idle.erase(std::remove(host.idle.begin(), host.idle.end(), connection), host.idle.end());
+    connection->idle = false;
+
+    // Cancel the connection timer
+    if (connection->timer)
+        connection->timer->Cancel();
+    connection->timer.reset();
+    connection->timer_id = 0;
+}
+
+void HTTPSClientPool::onConnectionResponse(const std::shared_ptr<Connection>& connection, const HTTPResponse& response)
+{
+    std::shared_ptr<Request> request;
+    std::shared_ptr<Request> next;
+    bool keep_alive = false;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        request = std::move(connection->request);
+        ++connection->served;
+
+        keep_alive = (request && connection->IsHandshaked() && IsKeepAlive(request->request, response));
+
+        auto it = _hosts.find(connection->key);
+        if (!keep_alive || (it == _hosts.end()))
+        {
+            keep_alive = false;
+            Remove(connection);
+        }
+        else if (!it->second.queue.empty())
+        {
+            // Serve the next queued request with the same connection
+            next = Dequeue(it->second);
+            connection->request = next;
+            Arm(connection, Remaining(next->deadline));
+        }
+        else
+        {
+            // Keep the connection idle until the idle timeout
+            connection->idle = true;
+            it->second.idle.emplace_back(connection);
+            Arm(connection, _idle_timeout);
+        }
+    }
+
+    if (request)
+        request->promise.set_value(response);
+
+    if (next)
+        connection->SendRequestAsync(next->request);
+    else if (!keep_alive)
+    {
+        connection->DisconnectAsync();
+        Pump(connection->key);
+    }
+}
+
+void HTTPSClientPool::onConnectionError(const std::shared_ptr<Connection>& connection, const std::string& error)
+{
+    std::shared_ptr<Request> request;
+
+    {
+        std::scoped_lock locker(_lock);
+        request = std::move(connection->request);
+        Remove(connection);
+    }
+
+    if (request)
+        request->promise.set_exception(std::make_exception_ptr(std::runtime_error(error)));
+
+    Pump(connection->key);
+}
+
+void HTTPSClientPool::onConnectionDisconnected(const std::shared_ptr<Connection>& connection, bool received)
+{
+    std::shared_ptr<Request> request;
+    bool retry = false;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        request = std::move(connection->request);
+        Remove(connection);
+
+        // Retry the idempotent request if the reused connection was closed by the server
+        if (request && !received && (connection->served > 0) && !request->retried && IsIdempotent(request->request.method()))
+        {
+            request->retried = true;
+            retry = true;
+        }
+    }
+
+    if (retry)
+        Dispatch(request);
+    else if (request)
+        request->promise.set_exception(std::make_exception_ptr(std::runtime_error("Connection closed!")));
+
+    Pump(connection->key);
+}
+
+void HTTPSClientPool::onConnectionTimer(const std::shared_ptr<Connection>& connection, uint64_t timer_id)
+{
+    std::shared_ptr<Request> request;
+
+    {
+        std::scoped_lock locker(_lock);
+
+        // Skip notifications of the previous timer
+        if (connection->timer_id != timer_id)
+            return;
+
+        // Request timeout or idle timeout
+        request = std::move(connection->request);
+        Remove(connection);
+    }
+
+    if (request)
+        request->promise.set_exception(std::make_exception_ptr(std::runtime_error("Timeout!")));
+
+    connection->DisconnectAsync();
+
+    Pump(connection->key);
+}
+
+void HTTPSClientPool::onRequestTimer(const std::shared_ptr<Request>& request)
+{
+    const std::string key = request->address + ":" + std::to_string(request->port);
+
+    {
+        std::scoped_lock locker(_lock);
+
+        // Skip the request which already left the queue
+        auto it = _hosts.find(key);
+        if (it == _hosts.end())
+            return;
+        auto& queue = it->second.queue;
+        auto position = std::find(queue.begin(), queue.end(), request);
+        if (position == queue.end())
+            return;
+
+        queue.erase(position);
+        request->timer.reset();
+    }
+
+    request->promise.set_exception(std::make_exception_ptr(std::runtime_error("Timeout!")));
+
+    Pump(key);
+}
+
+} // namespace HTTP
+} // namespace CppServer
@@ -0,0 +1,353 @@
+/*!
+    \file https_session.cpp
+    \brief HTTPS session implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/http/https_session.h"
+
+namespace CppServer {
+namespace HTTP {
+
+//! HTTPS session HTTP/2 connection
+class HTTPSSession::HTTP2 : public HTTP2Connection
+{
+public:
+    explicit HTTP2(HTTPSSession& session) : HTTP2Connection(true), _session(session) {}
+
+    // Received HTTP request or stream error
+    struct Received
+    {
+        HTTPRequest request;
+        std::string error;
+    };
+
+    // Received requests are notified outside of the connection lock
+    std::vector<Received> received;
+
+protected:
+    void onSend(const void* buffer, size_t size) override { _session.SendAsync(buffer, size); }
+
+    void onReceivedRequest(const HTTPRequest& request) override
+    {
+        received.push_back({ request, std::string() });
+    }
+
+    void onStreamError(uint32_t stream, const std::string& error) override
+    {
+        Received item;
+        item.request.SetStream(stream);
+        item.error = error;
+        received.emplace_back(std::move(item));
+    }
+
+private:
+    HTTPSSession& _session;
+};
+
+size_t HTTPSSession::SendResponse(const HTTPResponse& response)
+{
+    if (_http2_enabled)
+        return SendResponseStream(response) ? response.cache().size() : 0;
+
+    size_t sent = Send(response.cache());
+
+    // Close the connection if requested by the client (chunked response is closed by the last chunk)
+    if (_closing && !response.chunked())
+        Disconnect();
+
+    return sent;
+}
+
+bool HTTPSSession::SendResponseAsync(const HTTPResponse& response)
+{
+    if (_http2_enabled)
+        return SendResponseStream(response);
+
+    // Close the connection when the response is sent (chunked response is closed by the last chunk).
+    // The flag is set before sending, so the send completion handler could not miss it.
+    if (_closing && !response.chunked())
+        _disconnect_pending = true;
+
+    return SendAsync(response.cache());
+}
+
+size_t HTTPSSession::SendResponseBody(const void* buffer, size_t size)
+{
+    if (_http2_enabled)
+        return SendResponseStreamBody(buffer, size) ? size : 0;
+
+    return Send(buffer, size);
+}
+
+bool HTTPSSession::SendResponseBodyAsync(const void* buffer, size_t size)
+{
+    if (_http2_enabled)
+        return SendResponseStreamBody(buffer, size);
+
+    return SendAsync(buffer, size);
+}
+
+size_t HTTPSSession::SendResponseBodyChunk(const void* buffer, size_t size)
+{
+    // HTTP/2 stream data is not chunk encoded
+    if (_http2_enabled)
+        return SendResponseStreamBody(buffer, size) ? size : 0;
+
+    std::string header = HTTPChunkedEncoder::ChunkHeader(size);
+
+    size_t sent = Send(header);
+    if (size > 0)
+        sent += Send(buffer, size);
+    sent += Send(HTTPChunkedEncoder::ChunkTrailer());
+
+    // Close the connection after the last chunk if requested by the client
+    if (_closing && (size == 0))
+        Disconnect();
+
+    return sent;
+}
+
+bool HTTPSSession::SendResponseBodyChunkAsync(const void* buffer, size_t size)
+{
+    // HTTP/2 stream data is not chunk encoded
+    if (_http2_enabled)
+        return SendResponseStreamBody(buffer, size);
+
+    std::string header = HTTPChunkedEncoder::ChunkHeader(size);
+
+    // The last chunk is sent with one buffer, so the connection is never closed in the middle of it
+    if (size == 0)
+    {
+        // Close the connection when the last chunk is sent.
+        // The flag is set before sending, so the send completion handler could not miss it.
+        if (_closing)
+            _disconnect_pending = true;
+
+        return SendAsync(header.append(HTTPChunkedEncoder::ChunkTrailer()));
+    }
+
+    if (!SendAsync(header))
+        return false;
+    if (!SendAsync(buffer, size))
+        return false;
+    return SendAsync(HTTPChunkedEncoder::ChunkTrailer());
+}
+
+bool HTTPSSession::SendResponseStream(const HTTPResponse& response)
+{
+    std::scoped_lock locker(_http2_lock);
+
+    if (!_http2)
+        return false;
+
+    // Response without the stream is sent to the request notified by the current thread
+    uint32_t stream = response.stream();
+    if ((stream == 0) && (_http2_thread == std::this_thread::get_id()))
+        stream = _http2_stream;
+    if (stream == 0)
+        return false;
+
+    _http2_body_stream = stream;
+
+    return _http2->SendResponse(stream, response);
+}
+
+bool HTTPSSession::SendResponseStreamBody(const void* buffer, size_t size)
+{
+    std::scoped_lock locker(_http2_lock);
+
+    if (!_http2)
+        return false;
+
+    return _http2->SendBody(_http2_body_stream, buffer, size);
+}
+
+void HTTPSSession::onHandshaked()
+{
+    // Switch to HTTP/2 protocol if it was negotiated with the client
+    if (alpn_protocol() == "h2")
+    {
+        std::scoped_lock locker(_http2_lock);
+        _http2 = std::make_shared<HTTP2>(*this);
+        _http2->SetupMaxHeaderSize(_option_max_header_size);
+        _http2->SetupMaxHeaders(_option_max_headers);
+        _http2->SetupMaxBodySize(_option_max_body_size);
+        _http2_stream = 0;
+        _http2_thread = std::thread::id();
+        _http2_body_stream = 0;
+        _http2_enabled = true;
+        _http2->Start();
+    }
+}
+
+void HTTPSSession::onReceived(const void* buffer, size_t size)
+{
+    // Receive HTTP/2 frames
+    if (_http2_enabled)
+    {
+        bool result = false;
+        std::vector<HTTP2::Received> received;
+
+        {
+            std::scoped_lock locker(_http2_lock);
+            if (_http2)
+            {
+                result = _http2->Receive(buffer, size);
+                received = std::move(_http2->received);
+                _http2->received.clear();
+            }
+        }
+
+        // Notify received requests without the connection lock
+        for (auto& item : received)
+        {
+            if (item.error.empty())
+            {
+                {
+                    std::scoped_lock locker(_http2_lock);
+                    _http2_stream = item.request.stream();
+                    _http2_thread = std::this_thread::get_id();
+                }
+
+                onReceivedRequestHeader(item.request);
+                onReceivedRequest(item.request);
+
+                {
+                    std::scoped_lock locker(_http2_lock);
+                    _http2_stream = 0;
+                    _http2_thread = std::thread::id();
+                }
+            }
+            else
+                onReceivedRequestError(item.request, item.error);
+        }
+
+        // Disconnect when GOAWAY frame of the connection error is sent
+        if (!result)
+            _disconnect_pending = true;
+        return;
+    }
+
+    // Receive data of the upgraded protocol
+    if (_upgraded)
+    {
+        onReceivedUpgraded(buffer, size);
+        return;
+    }
+
+    const uint8_t* data = (const uint8_t*)buffer;
+
+    // Parse requests in place of the receive buffer
+    while (!_closing)
+    {
+        // Receive HTTP request header
+        if (_request.IsPendingHeader())
+        {
+            size_t consumed = _request.ReceiveHeader(data, size);
+            data += consumed;
+            size -= consumed;
+
+            // Check for HTTP request error
+            if (_request.error())
+            {
+                RejectRequest(400, "Invalid HTTP request!");
+                return;
+            }
+
+            // Check HTTP request header limits
+            if (((_option_max_header_size > 0) && (_request.cache().size() > _option_max_header_size)) ||
+                ((_option_max_headers > 0) && (_request.headers() > _option_max_headers)))
+            {
+                RejectRequest(431, "HTTP request header is too large!");
+                return;
+            }
+
+            // Wait for the rest of HTTP request header
+            if (_request.IsPendingHeader())
+                return;
+
+            // Check HTTP request body length
+            if ((_option_max_body_size > 0) && !_request.chunked() && (_request.body_length() > _option_max_body_size))
+            {
+                RejectRequest(413, "HTTP request body is too large!");
+                return;
+            }
+
+            onReceivedRequestHeader(_request);
+        }
+
+        // Receive HTTP request body
+        if (_request.IsPendingBody())
+        {
+            size_t consumed = _request.ReceiveBody(data, size);
+            data += consumed;
+            size -= consumed;
+
+            // Check for HTTP request error
+            if (_request.error())
+            {
+                RejectRequest(400, "Invalid HTTP request body!");
+                return;
+            }
+
+            // Check decoded HTTP request chunked body size
+            if ((_option_max_body_size > 0) && (_request.body().size() > _option_max_body_size))
+            {
+                RejectRequest(413, "HTTP request body is too large!");
+                return;
+            }
+
+            // Wait for the rest of HTTP request body
+            if (_request.IsPendingBody())
+                return;
+        }
+
+        // Switch the connection to the upgraded protocol if the upgrade is accepted
+        if (_request.IsUpgrade() && onReceivedRequestUpgrade(_request))
+        {
+            _upgraded = true;
+            _request.Clear();
+
+            // The rest of received data belongs to the upgraded protocol
+            if (size > 0)
+                onReceivedUpgraded(data, size);
+            return;
+        }
+
+        // Close the connection after the response if requested by the client
+        _closing = !_request.IsKeepAlive();
+
+        onReceivedRequest(_request);
+        _request.Clear();
+
+        // Process the next pipelined request
+        if (size == 0)
+            return;
+    }
+}
+
+void HTTPSSession::RejectRequest(int status, const std::string& error)
+{
+    onReceivedRequestError(_request, error);
+    _request.Clear();
+
+    // Answer with the error response and disconnect the session when it is sent
+    _closing = true;
+    HTTPResponse response(status);
+    response.SetHeader("Connection", "close");
+    response.SetBody();
+    SendResponseAsync(response);
+}
+
+void HTTPSSession::onSent(size_t sent, size_t pending)
+{
+    // Disconnect when the last response is sent
+    if (_disconnect_pending && (pending == 0))
+        Disconnect();
+}
+
+} // namespace HTTP
+} // namespace CppServer
@@ -0,0 +1,965 @@
+/*!
+    \file ws.cpp
+    \brief WebSocket C++ Library implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/ws/ws.h"
+
+#include <openssl/evp.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <random>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define CPPSERVER_WS_SSE2
+#endif
+
+namespace CppServer {
+namespace WS {
+
+namespace {
+
+// WebSocket accept key GUID (RFC 6455 section 1.3)
+const std::string_view GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+bool CompareNoCase(std::string_view str1, std::string_view str2)
+{
+    if (str1.size() != str2.size())
+        return false;
+
+    for (size_t i = 0; i < str1.size(); ++i)
+    {
+        char ch1 = str1[i];
+        char ch2 = str2[i];
+        if ((ch1 >= 'A') && (ch1 <= 'Z'))
+            ch1 += 'a' - 'A';
+        if ((ch2 >= 'A') && (ch2 <= 'Z'))
+            ch2 += 'a' - 'A';
+        if (ch1 != ch2)
+            return false;
+    }
+
+    return true;
+}
+
+// Find the header value of HTTP message by the case-insensitive header name
+template <class TMessage>
+std::string_view FindHeader(const TMessage& message, std::string_view name)
+{
+    for (size_t i = 0; i < message.headers(); ++i)
+    {
+        auto [key, value] = message.header(i);
+        if (CompareNoCase(key, name))
+            return value;
+    }
+
+    return std::string_view();
+}
+
+std::string_view Trim(std::string_view value)
+{
+    while (!value.empty() && ((value.front() == ' ') || (value.front() == '\t')))
+        value.remove_prefix(1);
+    while (!value.empty() && ((value.back() == ' ') || (value.back() == '\t')))
+        value.remove_suffix(1);
+    return value;
+}
+
+// Check if the comma-separated header value contains the token
+bool HasToken(std::string_view value, std::string_view token)
+{
+    size_t index = 0;
+    while (index < value.size())
+    {
+        size_t next = value.find(',', index);
+        if (next == std::string_view::npos)
+            next = value.size();
+
+        if (CompareNoCase(Trim(value.substr(index, next - index)), token))
+            return true;
+
+        index = next + 1;
+    }
+
+    return false;
+}
+
+// permessage-deflate extension parameters (RFC 7692 section 7.1)
+struct DeflateParams
+{
+    bool server_no_context_takeover{false};
+    bool client_no_context_takeover{false};
+    // Zero if the parameter is absent, -1 if the parameter has no value
+    int server_max_window_bits{0};
+    int client_max_window_bits{0};
+};
+
+bool ParseWindowBits(std::string_view value, int& bits)
+{
+    if (value.empty() || (value.size() > 2))
+        return false;
+
+    bits = 0;
+    for (char ch : value)
+    {
+        if ((ch < '0') || (ch > '9'))
+            return false;
+        bits = bits * 10 + (ch - '0');
+    }
+
+    return (bits >= 8) && (bits <= 15);
+}
+
+// Parse permessage-deflate extension offer or response, unknown or duplicate parameters are invalid
+bool ParseDeflate(std::string_view extension, DeflateParams& params)
+{
+    params = DeflateParams();
+
+    size_t next = extension.find(';');
+    if (!CompareNoCase(Trim(extension.substr(0, next)), "permessage-deflate"))
+        return false;
+
+    while (next != std::string_view::npos)
+    {
+        size_t index = next + 1;
+        next = extension.find(';', index);
+        std::string_view param = Trim(extension.substr(index, (next == std::string_view::npos) ? std::string_view::npos : (next - index)));
+
+        // Split the parameter into the name and the optional value
+        std::string_view name = param;
+        std::string_view value;
+        bool has_value = false;
+        size_t equal = param.find('=');
+        if (equal != std::string_view::npos)
+        {
+            name = Trim(param.substr(0, equal));
+            value = Trim(param.substr(equal + 1));
+            if ((value.size() >= 2) && (value.front() == '"') && (value.back() == '"'))
+                value = value.substr(1, value.size() - 2);
+            has_value = true;
+        }
+
+        if (CompareNoCase(name, "server_no_context_takeover") && !has_value && !params.server_no_context_takeover)
+            params.server_no_context_takeover = true;
+        else if (CompareNoCase(name, "client_no_context_takeover") && !has_value && !params.client_no_context_takeover)
+            params.client_no_context_takeover = true;
+        else if (CompareNoCase(name, "server_max_window_bits") && has_value && (params.server_max_window_bits == 0))
+        {
+            if (!ParseWindowBits(value, params.server_max_window_bits))
+                return false;
+        }
+        else if (CompareNoCase(name, "client_max_window_bits") && (params.client_max_window_bits == 0))
+        {
+            if (!has_value)
+                params.client_max_window_bits = -1;
+            else if (!ParseWindowBits(value, params.client_max_window_bits))
+                return false;
+        }
+        else
+            return false;
+    }
+
+    return true;
+}
+
+std::string Base64Encode(const uint8_t* data, size_t size)
+{
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string result;
+    result.reserve(((size + 2) / 3) * 4);
+
+    size_t i = 0;
+    for (; (i + 3) <= size; i += 3)
+    {
+        uint32_t value = ((uint32_t)data[i] << 16) | ((uint32_t)data[i + 1] << 8) | data[i + 2];
+        result.push_back(table[(value >> 18) & 0x3F]);
+        result.push_back(table[(value >> 12) & 0x3F]);
+        result.push_back(table[(value >> 6) & 0x3F]);
+        result.push_back(table[value & 0x3F]);
+    }
+
+    if (i < size)
+    {
+        uint32_t value = (uint32_t)data[i] << 16;
+        if ((i + 1) < size)
+            value |= (uint32_t)data[i + 1] << 8;
+        result.push_back(table[(value >> 18) & 0x3F]);
+        result.push_back(table[(value >> 12) & 0x3F]);
+        result.push_back(((i + 1) < size) ? table[(value >> 6) & 0x3F] : '=');
+        result.push_back('=');
+    }
+
+    return result;
+}
+
+// Calculate the accept key of the WebSocket key (RFC 6455 section 4.2.2)
+std::string AcceptKey(std::string_view key)
+{
+    std::string source;
+    source.reserve(key.size() + GUID.size());
+    source.append(key);
+    source.append(GUID);
+
+    uint8_t digest[EVP_MAX_MD_SIZE];
+    unsigned int digest_size = 0;
+    if (EVP_Digest(source.data(), source.size(), digest, &digest_size, EVP_sha1(), nullptr) != 1)
+        return std::string();
+
+    return Base64Encode(digest, digest_size);
+}
+
+std::mt19937_64& RandomGenerator()
+{
+    thread_local std::mt19937_64 generator(((uint64_t)std::random_device()() << 32) | std::random_device()());
+    return generator;
+}
+
+// Validate UTF-8 text (RFC 3629), overlong sequences and surrogates are invalid
+bool ValidateUTF8(const uint8_t* data, size_t size)
+{
+    size_t i = 0;
+    while (i < size)
+    {
+        // Skip ASCII characters by 8 bytes
+        if ((i + 8) <= size)
+        {
+            uint64_t chunk;
+            std::memcpy(&chunk, data + i, sizeof(chunk));
+            if ((chunk & 0x8080808080808080ull) == 0)
+            {
+                i += 8;
+                continue;
+            }
+        }
+
+        uint8_t ch = data[i];
+        if (ch < 0x80)
+        {
+            ++i;
+            continue;
+        }
+
+        // Get the count and the range of the first continuation byte
+        size_t count;
+        uint8_t lower = 0x80;
+        uint8_t upper = 0xBF;
+        if ((ch >= 0xC2) && (ch <= 0xDF))
+            count = 1;
+        else if (ch == 0xE0)
+        {
+            count = 2;
+            lower = 0xA0;
+        }
+        else if (ch == 0xED)
+        {
+            count = 2;
+            upper = 0x9F;
+        }
+        else if ((ch >= 0xE1) && (ch <= 0xEF))
+            count = 2;
+        else if (ch == 0xF0)
+        {
+            count = 3;
+            lower = 0x90;
+        }
+        else if (ch == 0xF4)
+        {
+            count = 3;
+            upper = 0x8F;
+        }
+        else if ((ch >= 0xF1) && (ch <= 0xF3))
+            count = 3;
+        else
+            return false;
+
+        if ((size - i - 1) < count)
+            return false;
+        if ((data[i + 1] < lower) || (data[i + 1] > upper))
+            return false;
+        for (size_t j = 2; j <= count; ++j)
+            if ((data[i + j] & 0xC0) != 0x80)
+                return false;
+
+        i += count + 1;
+    }
+
+    return true;
+}
+
+// Get the size of the frame header by its first two bytes
+size_t HeaderSize(const uint8_t* header)
+{
+    size_t size = 2;
+    uint8_t length = header[1] & 0x7F;
+    if (length == 126)
+        size += 2;
+    else if (length == 127)
+        size += 8;
+    if ((header[1] & 0x80) != 0)
+        size += 4;
+    return size;
+}
+
+bool IsControl(WebSocket::Opcode opcode)
+{
+    return ((uint8_t)opcode & 0x08) != 0;
+}
+
+// Check the received close status (RFC 6455 section 7.4)
+bool IsValidStatus(int status)
+{
+    return ((status >= 1000) && (status <= 1003)) || ((status >= 1007) && (status <= 1014)) || ((status >= 3000) && (status <= 4999));
+}
+
+// Reuse the compression buffer of the calling thread
+std::string& CompressionBuffer()
+{
+    thread_local std::string buffer;
+    buffer.clear();
+    return buffer;
+}
+
+} // namespace
+
+WebSocket::WebSocket(bool server)
+    : _ws_server(server),
+      _ws_max_message_size(64 * 1024 * 1024),
+      _ws_deflate(false),
+      _ws_deflate_context_takeover(true),
+      _ws_deflate_threshold(64),
+      _ws_close_sent(false)
+{
+    ResetWebSocket();
+}
+
+bool WebSocket::IsUpgradeRequest(const HTTP::HTTPRequest& request)
+{
+    return HasToken(FindHeader(request, "Upgrade"), "websocket");
+}
+
+bool WebSocket::PrepareUpgradeResponse(const HTTP::HTTPRequest& request, HTTP::HTTPResponse& response)
+{
+    response.Clear();
+
+    // Check the WebSocket upgrade request (RFC 6455 section 4.2.1)
+    std::string_view key = FindHeader(request, "Sec-WebSocket-Key");
+    if ((request.method() != "GET") || !HasToken(FindHeader(request, "Upgrade"), "websocket") || !HasToken(FindHeader(request, "Connection"), "upgrade") || (key.size() != 24))
+    {
+        response.SetBegin(400);
+        response.SetBody("Invalid WebSocket upgrade request!");
+        return false;
+    }
+
+    // Check the supported WebSocket version
+    if (FindHeader(request, "Sec-WebSocket-Version") != "13")
+    {
+        response.SetBegin(426);
+        response.SetHeader("Sec-WebSocket-Version", "13");
+        response.SetBody("Unsupported WebSocket version!");
+        return false;
+    }
+
+    response.SetBegin(101);
+    response.SetHeader("Upgrade", "websocket");
+    response.SetHeader("Connection", "Upgrade");
+    response.SetHeader("Sec-WebSocket-Accept", AcceptKey(key));
+    return true;
+}
+
+std::string WebSocket::PrepareUpgradeRequest(HTTP::HTTPRequest& request, std::string_view host, std::string_view url)
+{
+    // Generate the random WebSocket key
+    uint8_t nonce[16];
+    for (size_t i = 0; i < sizeof(nonce); i += 8)
+    {
+        uint64_t random = RandomGenerator()();
+        std::memcpy(nonce + i, &random, sizeof(random));
+    }
+    std::string key = Base64Encode(nonce, sizeof(nonce));
+
+    request.Clear();
+    request.SetBegin("GET", url);
+    request.SetHeader("Host", host);
+    request.SetHeader("Upgrade", "websocket");
+    request.SetHeader("Connection", "Upgrade");
+    request.SetHeader("Sec-WebSocket-Key", key);
+    request.SetHeader("Sec-WebSocket-Version", "13");
+    return key;
+}
+
+bool WebSocket::CheckUpgradeResponse(const HTTP::HTTPResponse& response, std::string_view key)
+{
+    if (response.status() != 101)
+        return false;
+    if (!HasToken(FindHeader(response, "Upgrade"), "websocket") || !HasToken(FindHeader(response, "Connection"), "upgrade"))
+        return false;
+
+    std::string accept = AcceptKey(key);
+    return !accept.empty() && (FindHeader(response, "Sec-WebSocket-Accept") == accept);
+}
+
+void WebSocket::PrepareFrame(std::string& frame, Opcode opcode, bool fin, const void* buffer, size_t size, bool mask)
+{
+    assert(((buffer != nullptr) || (size == 0)) && "Pointer to the buffer should not be null!");
+
+    uint8_t header[14];
+    size_t header_size = 2;
+
+    header[0] = (fin ? 0x80 : 0x00) | (uint8_t)opcode;
+    if (size <= 125)
+        header[1] = (uint8_t)size;
+    else if (size <= 0xFFFF)
+    {
+        header[1] = 126;
+        header[2] = (uint8_t)(size >> 8);
+        header[3] = (uint8_t)size;
+        header_size = 4;
+    }
+    else
+    {
+        header[1] = 127;
+        for (size_t i = 0; i < 8; ++i)
+            header[2 + i] = (uint8_t)((uint64_t)size >> (56 - 8 * i));
+        header_size = 10;
+    }
+
+    // Client frames are masked with the random mask key
+    uint8_t key[4];
+    if (mask)
+    {
+        uint32_t random = (uint32_t)RandomGenerator()();
+        std::memcpy(key, &random, sizeof(key));
+        std::memcpy(header + header_size, key, sizeof(key));
+        header[1] |= 0x80;
+        header_size += sizeof(key);
+    }
+
+    size_t index = frame.size();
+    frame.append((const char*)header, header_size);
+    if (size > 0)
+    {
+        frame.append((const char*)buffer, size);
+        if (mask)
+            Mask(&frame[index + header_size], &frame[index + header_size], size, key);
+    }
+}
+
+void WebSocket::PrepareCloseFrame(std::string& frame, int status, std::string_view reason, bool mask)
+{
+    uint8_t payload[125];
+    payload[0] = (uint8_t)(status >> 8);
+    payload[1] = (uint8_t)status;
+
+    // Truncate the close reason on the UTF-8 character boundary
+    size_t size = std::min(reason.size(), sizeof(payload) - 2);
+    while ((size > 0) && (size < reason.size()) && (((uint8_t)reason[size] & 0xC0) == 0x80))
+        --size;
+    std::memcpy(payload + 2, reason.data(), size);
+
+    PrepareFrame(frame, Opcode::Close, true, payload, 2 + size, mask);
+}
+
+bool WebSocket::PrepareDeflateFrame(std::string& frame, Opcode opcode, const void* buffer, size_t size, bool mask)
+{
+    assert(((opcode == Opcode::Text) || (opcode == Opcode::Binary)) && "Only Text or Binary messages could be compressed!");
+    if ((opcode != Opcode::Text) && (opcode != Opcode::Binary))
+        return false;
+
+    // Stateless compressor of the calling thread
+    thread_local struct Compressor
+    {
+        Compressor() { compression.SetupDeflate(); compression.SetupContextTakeover(false); }
+        Asio::MessageCompression compression;
+    } compressor;
+
+    std::string& compressed = CompressionBuffer();
+    if (!compressor.compression.Compress(buffer, size, compressed))
+        return false;
+
+    // Mark the compressed message with RSV1 bit
+    size_t index = frame.size();
+    PrepareFrame(frame, opcode, true, compressed.data(), compressed.size(), mask);
+    frame[index] |= 0x40;
+    return true;
+}
+
+void WebSocket::Mask(void* destination, const void* source, size_t size, const uint8_t* key, size_t offset) noexcept
+{
+    uint8_t* dst = (uint8_t*)destination;
+    const uint8_t* src = (const uint8_t*)source;
+
+    // Rotate the mask key to the payload offset
+    uint8_t rotated[8];
+    for (size_t i = 0; i < sizeof(rotated); ++i)
+        rotated[i] = key[(offset + i) & 3];
+
+    size_t i = 0;
+
+#if defined(CPPSERVER_WS_SSE2)
+    uint32_t key32;
+    std::memcpy(&key32, rotated, sizeof(key32));
+    const __m128i key128 = _mm_set1_epi32((int)key32);
+    for (; (i + 16) <= size; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(chunk, key128));
+    }
+#endif
+
+    uint64_t key64;
+    std::memcpy(&key64, rotated, sizeof(key64));
+    for (; (i + 8) <= size; i += 8)
+    {
+        uint64_t chunk;
+        std::memcpy(&chunk, src + i, sizeof(chunk));
+        chunk ^= key64;
+        std::memcpy(dst + i, &chunk, sizeof(chunk));
+    }
+
+    for (; i < size; ++i)
+        dst[i] = src[i] ^ rotated[i & 3];
+}
+
+void WebSocket::NegotiateDeflate(const HTTP::HTTPRequest& request, HTTP::HTTPResponse& response)
+{
+    _ws_deflated = false;
+    if (!_ws_deflate || !Asio::MessageCompression::IsDeflateSupported())
+        return;
+
+    for (size_t i = 0; i < request.headers(); ++i)
+    {
+        auto [key, value] = request.header(i);
+        if (!CompareNoCase(key, "Sec-WebSocket-Extensions"))
+            continue;
+
+        // Accept the first acceptable offer
+        size_t index = 0;
+        while (index < value.size())
+        {
+            size_t next = value.find(',', index);
+            if (next == std::string_view::npos)
+                next = value.size();
+            std::string_view offer = value.substr(index, next - index);
+            index = next + 1;
+
+            // Raw deflate stream does not support 256 bytes window
+            DeflateParams params;
+            if (!ParseDeflate(offer, params) || (params.server_max_window_bits == 8))
+                continue;
+
+            bool context_takeover = _ws_deflate_context_takeover && !params.server_no_context_takeover;
+            int window_bits = (params.server_max_window_bits > 0) ? params.server_max_window_bits : 15;
+
+            std::string extension = "permessage-deflate";
+            if (!context_takeover)
+                extension += "; server_no_context_takeover";
+            if (params.client_no_context_takeover)
+                extension += "; client_no_context_takeover";
+            if (params.server_max_window_bits > 0)
+                extension += "; server_max_window_bits=" + std::to_string(window_bits);
+            response.SetHeader("Sec-WebSocket-Extensions", extension);
+
+            _ws_compressor.SetupDeflate(-1, window_bits);
+            _ws_compressor.SetupContextTakeover(context_takeover);
+            _ws_decompressor.SetupDeflate();
+            _ws_decompressor.SetupContextTakeover(!params.client_no_context_takeover);
+            _ws_deflated = true;
+            return;
+        }
+    }
+}
+
+void WebSocket::OfferDeflate(HTTP::HTTPRequest& request)
+{
+    _ws_deflated = false;
+    if (!_ws_deflate || !Asio::MessageCompression::IsDeflateSupported())
+        return;
+
+    if (_ws_deflate_context_takeover)
+        request.SetHeader("Sec-WebSocket-Extensions", "permessage-deflate; client_max_window_bits");
+    else
+        request.SetHeader("Sec-WebSocket-Extensions", "permessage-deflate; client_max_window_bits; client_no_context_takeover");
+}
+
+bool WebSocket::AcceptDeflate(const HTTP::HTTPResponse& response)
+{
+    _ws_deflated = false;
+
+    std::string_view extension = FindHeader(response, "Sec-WebSocket-Extensions");
+    if (extension.empty())
+        return true;
+
+    // Server should accept only the offered extension with valid parameters
+    DeflateParams params;
+    if (!_ws_deflate || !Asio::MessageCompression::IsDeflateSupported() || (extension.find(',') != std::string_view::npos) || !ParseDeflate(extension, params))
+        return false;
+
+    // Raw deflate stream does not support 256 bytes window
+    if ((params.client_max_window_bits < 0) || (params.client_max_window_bits == 8))
+        return false;
+
+    bool context_takeover = _ws_deflate_context_takeover && !params.client_no_context_takeover;
+    int window_bits = (params.client_max_window_bits > 0) ? params.client_max_window_bits : 15;
+
+    _ws_compressor.SetupDeflate(-1, window_bits);
+    _ws_compressor.SetupContextTakeover(context_takeover);
+    _ws_decompressor.SetupDeflate();
+    _ws_decompressor.SetupContextTakeover(!params.server_no_context_takeover);
+    _ws_deflated = true;
+    return true;
+}
+
+bool WebSocket::PrepareMessage(std::string& frame, Opcode opcode, bool fin, const void* buffer, size_t size)
+{
+    bool mask = !_ws_server;
+
+    // The first frame decides if the whole message is compressed, small messages are sent as is
+    if (!IsControl(opcode) && (opcode != Opcode::Continuation))
+        _ws_send_compressed = _ws_deflated && (!fin || (size >= _ws_deflate_threshold));
+
+    if (IsControl(opcode) || !_ws_send_compressed)
+    {
+        PrepareFrame(frame, opcode, fin, buffer, size, mask);
+        return true;
+    }
+
+    std::string& compressed = CompressionBuffer();
+    if (!_ws_compressor.Compress(buffer, size, compressed, fin))
+        return false;
+
+    // Mark the first frame of the compressed message with RSV1 bit
+    size_t index = frame.size();
+    PrepareFrame(frame, opcode, fin, compressed.data(), compressed.size(), mask);
+    if (opcode != Opcode::Continuation)
+        frame[index] |= 0x40;
+    return true;
+}
+
+void WebSocket::ResetWebSocket()
+{
+    _ws_close_sent = false;
+    _ws_close_received = false;
+    _ws_error = false;
+    _ws_header_size = 0;
+    _ws_payload = false;
+    _ws_opcode = Opcode::Continuation;
+    _ws_fin = false;
+    _ws_masked = false;
+    std::memset(_ws_mask, 0, sizeof(_ws_mask));
+    _ws_remaining = 0;
+    _ws_offset = 0;
+    _ws_message_opcode = Opcode::Continuation;
+    _ws_message_compressed = false;
+    _ws_message.clear();
+    _ws_control.clear();
+    _ws_deflated = false;
+    _ws_send_compressed = false;
+    _ws_compressor.SetupNone();
+    _ws_decompressor.SetupNone();
+}
+
+bool WebSocket::ReceiveFrames(const void* buffer, size_t size)
+{
+    assert((buffer != nullptr) && "Pointer to the buffer should not be null!");
+    if (buffer == nullptr)
+        return false;
+
+    // Ignore the rest of data after the protocol error or the close frame
+    if (_ws_error)
+        return false;
+    if (_ws_close_received)
+        return true;
+
+    const uint8_t* data = (const uint8_t*)buffer;
+
+    while (size > 0)
+    {
+        if (!_ws_payload)
+        {
+            const uint8_t* header;
+
+            if ((_ws_header_size == 0) && (size >= 2) && (size >= HeaderSize(data)))
+            {
+                // Parse the frame header in place of the received buffer
+                header = data;
+                size_t header_size = HeaderSize(data);
+                data += header_size;
+                size -= header_size;
+            }
+            else
+            {
+                // Collect the frame header split between the received buffers
+                size_t required = (_ws_header_size < 2) ? 2 : HeaderSize(_ws_header);
+                size_t chunk = std::min(required - _ws_header_size, size);
+                std::memcpy(_ws_header + _ws_header_size, data, chunk);
+                _ws_header_size += chunk;
+                data += chunk;
+                size -= chunk;
+
+                // Wait for the rest of the frame header
+                if ((_ws_header_size < 2) || (_ws_header_size < HeaderSize(_ws_header)))
+                    continue;
+
+                header = _ws_header;
+                _ws_header_size = 0;
+            }
+
+            if (!ProcessHeader(header))
+                return false;
+
+            // Notify the whole unmasked final frame in place of the received buffer
+            if (!_ws_masked && _ws_fin && !IsControl(_ws_opcode) && (_ws_opcode != Opcode::Continuation) && !_ws_message_compressed && (size >= _ws_remaining))
+            {
+                const uint8_t* payload = data;
+                size_t length = (size_t)_ws_remaining;
+                data += length;
+                size -= length;
+                _ws_remaining = 0;
+
+                if (!Complete(payload, length, (_ws_opcode == Opcode::Text)))
+                    return false;
+                continue;
+            }
+
+            _ws_payload = true;
+        }
+
+        // Receive the frame payload
+        size_t chunk = (size_t)std::min(_ws_remaining, (uint64_t)size);
+        ProcessPayload(data, chunk);
+        data += chunk;
+        size -= chunk;
+
+        // Wait for the rest of the frame payload
+        if (_ws_remaining > 0)
+            continue;
+
+        _ws_payload = false;
+        if (!ProcessFrame())
+            return false;
+
+        // Ignore the rest of data after the close frame
+        if (_ws_close_received)
+            return true;
+    }
+
+    return true;
+}
+
+bool WebSocket::ProcessHeader(const uint8_t* header)
+{
+    bool fin = (header[0] & 0x80) != 0;
+    Opcode opcode = (Opcode)(header[0] & 0x0F);
+    bool masked = (header[1] & 0x80) != 0;
+    uint64_t length = header[1] & 0x7F;
+    size_t index = 2;
+
+    // Reserved bits are used only by negotiated extensions, RSV1 marks the first frame of the compressed message
+    bool compressed = (header[0] & 0x40) != 0;
+    if (((header[0] & 0x30) != 0) || (compressed && (!_ws_deflated || ((opcode != Opcode::Text) && (opcode != Opcode::Binary)))))
+        return Fail(CLOSE_PROTOCOL_ERROR, "Invalid WebSocket frame reserved bits!");
+
+    // Client frames should be masked, server frames should not be masked
+    if (masked != _ws_server)
+        return Fail(CLOSE_PROTOCOL_ERROR, _ws_server ? "Unmasked WebSocket client frame!" : "Masked WebSocket server frame!");
+
+    // Read the extended payload length
+    if (length == 126)
+    {
+        length = ((uint64_t)header[2] << 8) | header[3];
+        index = 4;
+    }
+    else if (length == 127)
+    {
+        length = 0;
+        for (size_t i = 0; i < 8; ++i)
+            length = (length << 8) | header[2 + i];
+        index = 10;
+
+        if ((length >> 63) != 0)
+            return Fail(CLOSE_PROTOCOL_ERROR, "Invalid WebSocket frame payload length!");
+    }
+
+    if (masked)
+        std::memcpy(_ws_mask, header + index, sizeof(_ws_mask));
+
+    switch (opcode)
+    {
+        case Opcode::Close:
+        case Opcode::Ping:
+        case Opcode::Pong:
+            // Control frames should not be fragmented
+            if (!fin || (length > 125))
+                return Fail(CLOSE_PROTOCOL_ERROR, "Invalid WebSocket control frame!");
+            _ws_control.clear();
+            break;
+        case Opcode::Continuation:
+            if (_ws_message_opcode == Opcode::Continuation)
+                return Fail(CLOSE_PROTOCOL_ERROR, "Unexpected WebSocket continuation frame!");
+            break;
+        case Opcode::Text:
+        case Opcode::Binary:
+            if (_ws_message_opcode != Opcode::Continuation)
+                return Fail(CLOSE_PROTOCOL_ERROR, "Unexpected WebSocket data frame in the fragmented message!");
+            _ws_message_opcode = opcode;
+            _ws_message_compressed = compressed;
+            break;
+        default:
+            return Fail(CLOSE_PROTOCOL_ERROR, "Unknown WebSocket frame opcode!");
+    }
+
+    // Check the message size limit
+    if (!IsControl(opcode))
+    {
+        bool too_big = (length > (uint64_t)(std::numeric_limits<size_t>::max() - _ws_message.size()));
+        if (!too_big && (_ws_max_message_size > 0))
+            too_big = ((_ws_message.size() + length) > _ws_max_message_size);
+        if (too_big)
+            return Fail(CLOSE_MESSAGE_TOO_BIG, "WebSocket message is too big!");
+    }
+
+    _ws_opcode = opcode;
+    _ws_fin = fin;
+    _ws_masked = masked;
+    _ws_remaining = length;
+    _ws_offset = 0;
+    return true;
+}
+
+void WebSocket::ProcessPayload(const uint8_t* data, size_t size)
+{
+    std::string& payload = IsControl(_ws_opcode) ? _ws_control : _ws_message;
+
+    // Unmask the payload part in place of the payload buffer
+    size_t index = payload.size();
+    payload.append((const char*)data, size);
+    if (_ws_masked)
+        Mask(&payload[index], &payload[index], size, _ws_mask, _ws_offset);
+
+    _ws_offset += size;
+    _ws_remaining -= size;
+}
+
+bool WebSocket::ProcessFrame()
+{
+    switch (_ws_opcode)
+    {
+        case Opcode::Ping:
+        {
+            // Reply with the pong frame of the same payload
+            if (!_ws_close_sent)
+            {
+                std::string frame;
+                PrepareFrame(frame, Opcode::Pong, true, _ws_control.data(), _ws_control.size(), !_ws_server);
+                onWSSend(frame.data(), frame.size());
+            }
+
+            onWSPing(_ws_control.data(), _ws_control.size());
+            return true;
+        }
+        case Opcode::Pong:
+            onWSPong(_ws_control.data(), _ws_control.size());
+            return true;
+        case Opcode::Close:
+            return ProcessClose((const uint8_t*)_ws_control.data(), _ws_control.size());
+        default:
+        {
+            // Wait for the rest of the fragmented message
+            if (!_ws_fin)
+                return true;
+
+            bool result = Complete(_ws_message.data(), _ws_message.size(), (_ws_message_opcode == Opcode::Text));
+            _ws_message.clear();
+            return result;
+        }
+    }
+}
+
+bool WebSocket::ProcessClose(const uint8_t* payload, size_t size)
+{
+    int status = CLOSE_NO_STATUS;
+    std::string_view reason;
+
+    if (size == 1)
+        return Fail(CLOSE_PROTOCOL_ERROR, "Invalid WebSocket close frame!");
+    if (size >= 2)
+    {
+        status = ((int)payload[0] << 8) | payload[1];
+        reason = std::string_view((const char*)payload + 2, size - 2);
+
+        if (!IsValidStatus(status))
+            return Fail(CLOSE_PROTOCOL_ERROR, "Invalid WebSocket close status!");
+        if (!ValidateUTF8(payload + 2, size - 2))
+            return Fail(CLOSE_INVALID_PAYLOAD, "Invalid WebSocket close reason!");
+    }
+
+    _ws_close_received = true;
+
+    // Reply with the close frame of the same status
+    if (MarkWSCloseSent())
+    {
+        std::string frame;
+        if (status == CLOSE_NO_STATUS)
+            PrepareFrame(frame, Opcode::Close, true, "", 0, !_ws_server);
+        else
+            PrepareCloseFrame(frame, status, "", !_ws_server);
+        onWSSend(frame.data(), frame.size());
+    }
+
+    onWSClose(status, reason);
+    return true;
+}
+
+bool WebSocket::Complete(const void* buffer, size_t size, bool text)
+{
+    _ws_message_opcode = Opcode::Continuation;
+
+    if (_ws_message_compressed)
+    {
+        _ws_message_compressed = false;
+
+        // Decompressed message is limited with the maximal message size
+        _ws_inflated.clear();
+        if (!_ws_decompressor.Decompress(buffer, size, _ws_inflated, _ws_max_message_size))
+            return Fail(CLOSE_INVALID_PAYLOAD, "Invalid compressed WebSocket message!");
+        if ((_ws_max_message_size > 0) && (_ws_inflated.size() > _ws_max_message_size))
+            return Fail(CLOSE_MESSAGE_TOO_BIG, "WebSocket message is too big!");
+
+        buffer = _ws_inflated.data();
+        size = _ws_inflated.size();
+    }
+
+    if (text && !ValidateUTF8((const uint8_t*)buffer, size))
+        return Fail(CLOSE_INVALID_PAYLOAD, "Invalid UTF-8 WebSocket text message!");
+
+    onWSReceived(buffer, size, text);
+    return true;
+}
+
+bool WebSocket::Fail(int status, const std::string& error)
+{
+    _ws_error = true;
+
+    onWSError(status, error);
+
+    // Close the connection with the error status
+    if (MarkWSCloseSent())
+    {
+        std::string frame;
+        PrepareCloseFrame(frame, status, "", !_ws_server);
+        onWSSend(frame.data(), frame.size());
+    }
+
+    return false;
+}
+
+} // namespace WS
+} // namespace CppServer
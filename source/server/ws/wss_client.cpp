@@ -0,0 +1,217 @@
+/*!
+    \file wss_client.cpp
+    \brief WebSocket secure client implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/ws/wss_client.h"
+
+namespace CppServer {
+namespace WS {
+
+namespace {
+
+// Reuse the frame buffer of the calling thread
+std::string& FrameBuffer()
+{
+    thread_local std::string frame;
+    frame.clear();
+    return frame;
+}
+
+} // namespace
+
+bool WSSClient::CloseAsync(int status, std::string_view reason)
+{
+    if (!_ws_connected || !MarkWSCloseSent())
+        return false;
+
+    std::string& frame = FrameBuffer();
+    PrepareCloseFrame(frame, status, reason, true);
+    if (!SendAsync(frame.data(), frame.size()))
+        return false;
+
+    // Disconnect if the close frame of the server was already received
+    if (IsWSCloseReceived())
+        DisconnectWhenSent();
+
+    return true;
+}
+
+size_t WSSClient::SendFrame(Opcode opcode, bool fin, const void* buffer, size_t size)
+{
+    if (!_ws_connected || IsWSCloseSent())
+        return 0;
+
+    std::scoped_lock locker(_ws_send_lock);
+
+    std::string& frame = FrameBuffer();
+    if (!PrepareMessage(frame, opcode, fin, buffer, size))
+        return 0;
+
+    return Send(frame.data(), frame.size());
+}
+
+bool WSSClient::SendFrameAsync(Opcode opcode, bool fin, const void* buffer, size_t size)
+{
+    if (!_ws_connected || IsWSCloseSent())
+        return false;
+
+    std::scoped_lock locker(_ws_send_lock);
+
+    std::string& frame = FrameBuffer();
+    if (!PrepareMessage(frame, opcode, fin, buffer, size))
+        return false;
+
+    return SendAsync(frame.data(), frame.size());
+}
+
+void WSSClient::onHandshaked()
+{
+    HTTPSClient::onHandshaked();
+
+    // WebSocket protocol is upgraded only from HTTP/1.1 connection
+    if (IsHTTP2())
+    {
+        onWSError(CLOSE_PROTOCOL_ERROR, "WebSocket over HTTP/2 is not supported!");
+        DisconnectAsync();
+        return;
+    }
+
+    // Reset WebSocket state of the previous connection
+    ResetWebSocket();
+    _ws_closing = false;
+    _ws_disconnect_pending = false;
+
+    // Send WebSocket upgrade request
+    std::string host = address();
+    if ((port() > 0) && (port() != 443))
+        host += ":" + std::to_string(port());
+    _ws_key = PrepareUpgradeRequest(_request, host, _option_ws_url);
+    OfferDeflate(_request);
+    onWSConnecting(_request);
+    _request.SetBody();
+    SendRequestAsync(_request);
+}
+
+void WSSClient::onDisconnected()
+{
+    if (_ws_heartbeat)
+        _ws_heartbeat->Cancel();
+
+    HTTPSClient::onDisconnected();
+
+    if (_ws_connected.exchange(false))
+        onWSDisconnected();
+}
+
+void WSSClient::onSent(size_t sent, size_t pending)
+{
+    // Disconnect when the close frame is sent
+    if (_ws_disconnect_pending && (pending == 0))
+        DisconnectAsync();
+
+    HTTPSClient::onSent(sent, pending);
+}
+
+void WSSClient::onReceivedResponse(const HTTP::HTTPResponse& response)
+{
+    // Disconnect from the server which rejected the upgrade
+    onWSError(CLOSE_PROTOCOL_ERROR, "WebSocket upgrade was rejected by the server!");
+    DisconnectAsync();
+}
+
+bool WSSClient::onReceivedResponseUpgrade(const HTTP::HTTPResponse& response)
+{
+    if (!CheckUpgradeResponse(response, _ws_key) || !AcceptDeflate(response))
+    {
+        onWSError(CLOSE_PROTOCOL_ERROR, "Invalid WebSocket upgrade response!");
+        DisconnectAsync();
+        return true;
+    }
+
+    _ws_connected = true;
+    _ws_received = true;
+    StartHeartbeat();
+
+    onWSConnected(response);
+    return true;
+}
+
+void WSSClient::onReceivedUpgraded(const void* buffer, size_t size)
+{
+    // Ignore the data after the invalid upgrade response
+    if (!_ws_connected)
+        return;
+
+    _ws_received = true;
+
+    // Disconnect after the protocol error or the closing handshake
+    if (!ReceiveFrames(buffer, size) || IsWSCloseReceived())
+        DisconnectWhenSent();
+}
+
+void WSSClient::DisconnectWhenSent()
+{
+    _ws_disconnect_pending = true;
+    if (bytes_pending() == 0)
+        DisconnectAsync();
+}
+
+void WSSClient::StartHeartbeat()
+{
+    if (_option_ping_interval.total() <= 0)
+        return;
+
+    // Create the heartbeat timer which does not prolong the client lifetime
+    if (!_ws_heartbeat)
+    {
+        std::weak_ptr<Asio::SSLClient> weak_self = this->shared_from_this();
+        auto timer_handler = [weak_self](bool canceled)
+        {
+            if (canceled)
+                return;
+
+            auto self = std::static_pointer_cast<WSSClient>(weak_self.lock());
+            if (self)
+                self->Heartbeat();
+        };
+        _ws_heartbeat = std::make_shared<Asio::Timer>(service(), timer_handler);
+    }
+
+    if (_ws_heartbeat->Setup(_option_ping_interval))
+        _ws_heartbeat->WaitAsync();
+}
+
+void WSSClient::Heartbeat()
+{
+    if (!IsConnected() || !_ws_connected)
+        return;
+
+    // Disconnect from the server which was silent during the whole ping interval
+    if (!_ws_received.exchange(false))
+    {
+        DisconnectAsync();
+        return;
+    }
+
+    // Disconnect from the server which did not answer the close frame during the ping interval
+    if (IsWSCloseSent())
+    {
+        if (_ws_closing.exchange(true))
+        {
+            DisconnectAsync();
+            return;
+        }
+    }
+    else
+        SendPingAsync();
+
+    if (_ws_heartbeat->Setup(_option_ping_interval))
+        _ws_heartbeat->WaitAsync();
+}
+
+} // namespace WS
+} // namespace CppServer
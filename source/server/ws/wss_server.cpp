@@ -0,0 +1,67 @@
+/*!
+    \file wss_server.cpp
+    \brief WebSocket secure server implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/ws/wss_server.h"
+
+namespace CppServer {
+namespace WS {
+
+bool WSSServer::MulticastFrame(WebSocket::Opcode opcode, const void* buffer, size_t size)
+{
+    assert(((buffer != nullptr) || (size == 0)) && "Pointer to the buffer should not be null!");
+    if ((buffer == nullptr) && (size > 0))
+        return false;
+
+    if (!IsStarted())
+        return false;
+
+    // Server frames are not masked, so the frame is prepared once for all sessions
+    thread_local std::string frame;
+    frame.clear();
+    WebSocket::PrepareFrame(frame, opcode, true, buffer, size, false);
+
+    // Compressed frame is prepared once on demand for all sessions which compress messages independently
+    thread_local std::string compressed;
+    compressed.clear();
+    bool deflate = (opcode == WebSocket::Opcode::Text) || (opcode == WebSocket::Opcode::Binary);
+
+    std::shared_lock<std::shared_mutex> locker(_sessions_lock);
+
+    // Multicast all WebSocket secure sessions
+    for (auto& session : _sessions)
+    {
+        auto ws_session = std::dynamic_pointer_cast<WSSSession>(session.second);
+        if (!ws_session || !ws_session->IsWSConnected() || ws_session->IsWSCloseSent())
+            continue;
+
+        if (deflate && ws_session->IsWSDeflated())
+        {
+            // Session with context takeover compresses the message with its own compression window
+            if (!ws_session->IsWSDeflateStateless())
+            {
+                ws_session->SendMulticastAsync(opcode, buffer, size);
+                continue;
+            }
+
+            if (compressed.empty() && !WebSocket::PrepareDeflateFrame(compressed, opcode, buffer, size, false))
+                deflate = false;
+            else if (compressed.size() < frame.size())
+            {
+                ws_session->SendPreparedFrameAsync(opcode, compressed.data(), compressed.size());
+                continue;
+            }
+        }
+
+        ws_session->SendPreparedFrameAsync(opcode, frame.data(), frame.size());
+    }
+
+    return true;
+}
+
+} // namespace WS
+} // namespace CppServer
@@ -0,0 +1,283 @@
+/*!
+    \file wss_session.cpp
+    \brief WebSocket secure session implementation
+    \author agent
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "server/ws/wss_session.h"
+
+#include "server/asio/ssl_server.h"
+
+namespace CppServer {
+namespace WS {
+
+namespace {
+
+// Reuse the frame buffer of the calling thread
+std::string& FrameBuffer()
+{
+    thread_local std::string frame;
+    frame.clear();
+    return frame;
+}
+
+bool IsData(WebSocket::Opcode opcode)
+{
+    return ((uint8_t)opcode & 0x08) == 0;
+}
+
+} // namespace
+
+bool WSSSession::CloseAsync(int status, std::string_view reason)
+{
+    if (!_ws_connected || !MarkWSCloseSent())
+        return false;
+
+    std::string& frame = FrameBuffer();
+    PrepareCloseFrame(frame, status, reason, false);
+    if (!SendAsync(frame.data(), frame.size()))
+        return false;
+
+    // Disconnect if the close frame of the client was already received
+    if (IsWSCloseReceived())
+        DisconnectWhenSent();
+
+    return true;
+}
+
+size_t WSSSession::SendFrame(Opcode opcode, bool fin, const void* buffer, size_t size)
+{
+    if (!_ws_connected || IsWSCloseSent())
+        return 0;
+
+    std::scoped_lock locker(_ws_send_lock);
+
+    std::string& frame = FrameBuffer();
+    if (!PrepareMessage(frame, opcode, fin, buffer, size))
+        return 0;
+
+    size_t sent = Send(frame.data(), frame.size());
+    if (sent > 0)
+        TrackFragments(opcode, fin);
+
+    return sent;
+}
+
+bool WSSSession::SendFrameAsync(Opcode opcode, bool fin, const void* buffer, size_t size)
+{
+    if (!_ws_connected || IsWSCloseSent())
+        return false;
+
+    std::scoped_lock locker(_ws_send_lock);
+
+    std::string& frame = FrameBuffer();
+    if (!PrepareMessage(frame, opcode, fin, buffer, size))
+        return false;
+
+    if (!SendAsync(frame.data(), frame.size()))
+        return false;
+
+    TrackFragments(opcode, fin);
+    return true;
+}
+
+bool WSSSession::SendMulticastAsync(Opcode opcode, const void* buffer, size_t size)
+{
+    if (!_ws_connected || IsWSCloseSent())
+        return false;
+
+    std::scoped_lock locker(_ws_send_lock);
+
+    // Multicast message should not be interleaved with fragments of the sent message (RFC 6455 section 5.4)
+    if (_ws_fragmenting && IsData(opcode))
+    {
+        _ws_deferred.push_back({ opcode, false, std::string((const char*)buffer, size) });
+        return true;
+    }
+
+    std::string& frame = FrameBuffer();
+    if (!PrepareMessage(frame, opcode, true, buffer, size))
+        return false;
+
+    return SendAsync(frame.data(), frame.size());
+}
+
+bool WSSSession::SendPreparedFrameAsync(Opcode opcode, const void* buffer, size_t size)
+{
+    if (!_ws_connected || IsWSCloseSent())
+        return false;
+
+    std::scoped_lock locker(_ws_send_lock);
+
+    // Multicast frame should not be interleaved with fragments of the sent message (RFC 6455 section 5.4)
+    if (_ws_fragmenting && IsData(opcode))
+    {
+        _ws_deferred.push_back({ opcode, true, std::string((const char*)buffer, size) });
+        return true;
+    }
+
+    return SendAsync(buffer, size);
+}
+
+void WSSSession::TrackFragments(Opcode opcode, bool fin)
+{
+    // Control frames could be sent between fragments
+    if (!IsData(opcode))
+        return;
+
+    _ws_fragmenting = !fin;
+    if (_ws_fragmenting || _ws_deferred.empty())
+        return;
+
+    // Send multicast messages deferred until the final fragment
+    for (auto& deferred : _ws_deferred)
+    {
+        if (deferred.prepared)
+        {
+            SendAsync(deferred.data.data(), deferred.data.size());
+            continue;
+        }
+
+        std::string& frame = FrameBuffer();
+        if (PrepareMessage(frame, deferred.opcode, true, deferred.data.data(), deferred.data.size()))
+            SendAsync(frame.data(), frame.size());
+    }
+    _ws_deferred.clear();
+}
+
+void WSSSession::onDisconnected()
+{
+    if (_ws_heartbeat)
+        _ws_heartbeat->Cancel();
+
+    if (_ws_connected.exchange(false))
+        onWSDisconnected();
+}
+
+void WSSSession::onSent(size_t sent, size_t pending)
+{
+    // Disconnect when the close frame is sent
+    if (_ws_disconnect_pending && (pending == 0))
+        Disconnect();
+
+    HTTPSSession::onSent(sent, pending);
+}
+
+bool WSSSession::onReceivedRequestUpgrade(const HTTP::HTTPRequest& request)
+{
+    // Process other protocol upgrades as regular requests
+    if (!IsUpgradeRequest(request))
+        return false;
+
+    if (PrepareUpgradeResponse(request, _response))
+    {
+        NegotiateDeflate(request, _response);
+        if (onWSConnecting(request, _response))
+            _response.SetBody();
+        else
+        {
+            _response.Clear();
+            _response.SetBegin(403);
+            _response.SetBody("WebSocket connection is rejected!");
+        }
+    }
+
+    // Disconnect after the error response to the invalid or rejected upgrade request
+    if (_response.status() != 101)
+    {
+        SendResponseAsync(_response);
+        DisconnectWhenSent();
+        return true;
+    }
+
+    if (!SendResponseAsync(_response))
+        return true;
+
+    // Reset the fragmented message state of the previous connection
+    {
+        std::scoped_lock locker(_ws_send_lock);
+        _ws_fragmenting = false;
+        _ws_deferred.clear();
+    }
+
+    _ws_connected = true;
+    _ws_received = true;
+    StartHeartbeat();
+
+    onWSConnected(request);
+    return true;
+}
+
+void WSSSession::onReceivedUpgraded(const void* buffer, size_t size)
+{
+    // Ignore the data after the rejected upgrade
+    if (!_ws_connected)
+        return;
+
+    _ws_received = true;
+
+    // Disconnect after the protocol error or the closing handshake
+    if (!ReceiveFrames(buffer, size) || IsWSCloseReceived())
+        DisconnectWhenSent();
+}
+
+void WSSSession::DisconnectWhenSent()
+{
+    _ws_disconnect_pending = true;
+    if (bytes_pending() == 0)
+        Disconnect();
+}
+
+void WSSSession::StartHeartbeat()
+{
+    if (_option_ping_interval.total() <= 0)
+        return;
+
+    // Create the heartbeat timer which does not prolong the session lifetime
+    std::weak_ptr<Asio::SSLSession> weak_self = this->shared_from_this();
+    auto timer_handler = [weak_self](bool canceled)
+    {
+        if (canceled)
+            return;
+
+        auto self = std::static_pointer_cast<WSSSession>(weak_self.lock());
+        if (self)
+            self->Heartbeat();
+    };
+
+    _ws_heartbeat = std::make_shared<Asio::Timer>(server()->service(), timer_handler, _option_ping_interval);
+    _ws_heartbeat->WaitAsync();
+}
+
+void WSSSession::Heartbeat()
+{
+    if (!IsConnected() || !_ws_connected)
+        return;
+
+    // Disconnect the client which was silent during the whole ping interval
+    if (!_ws_received.exchange(false))
+    {
+        Disconnect();
+        return;
+    }
+
+    // Disconnect the client which did not answer the close frame during the ping interval
+    if (IsWSCloseSent())
+    {
+        if (_ws_closing.exchange(true))
+        {
+            Disconnect();
+            return;
+        }
+    }
+    else
+        SendPingAsync();
+
+    if (_ws_heartbeat->Setup(_option_ping_interval))
+        _ws_heartbeat->WaitAsync();
+}
+
+} // namespace WS
+} // namespace CppServer
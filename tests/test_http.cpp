@@ -4,14 +4,348 @@
 
 #include "test.h"
 
+#include "server/http/hpack.h"
+#include "server/http/http2_connection.h"
 #include "server/http/http_client.h"
+#include "server/http/http_client_pool.h"
+#include "server/http/http_server.h"
 #include "server/http/https_client.h"
+#include "server/http/https_server.h"
 #include "threads/thread.h"
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 using namespace CppCommon;
 using namespace CppServer::Asio;
 using namespace CppServer::HTTP;
 
+namespace {
+
+class EchoHTTPSession : public HTTPSession
+{
+public:
+    using HTTPSession::HTTPSession;
+
+protected:
+    void onReceivedRequest(const HTTPRequest& request) override
+    {
+        // Echo the request URL and body with chunked transfer encoding
+        if (request.url() == "/chunked")
+        {
+            response().SetBegin(200);
+            response().SetHeader("Content-Type", "text/plain");
+            response().SetBodyChunked();
+            SendResponseAsync();
+            SendResponseBodyChunkAsync(request.url());
+            if (!request.body().empty())
+                SendResponseBodyChunkAsync(request.body());
+            SendResponseBodyChunkAsync("");
+            return;
+        }
+
+        // Cut off the response in the middle of the body
+        if (request.url() == "/truncated/length")
+        {
+            Send("HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\nhello");
+            Disconnect();
+            return;
+        }
+        if (request.url() == "/truncated/chunked")
+        {
+            Send("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n");
+            Disconnect();
+            return;
+        }
+
+        // Echo the request URL and body
+        response().SetBegin(200);
+        response().SetHeader("Content-Type", "text/plain");
+        response().SetBody(std::string(request.url()) + std::string(request.body()));
+        SendResponseAsync();
+    }
+    void onReceivedRequestError(const HTTPRequest& request, const std::string& error) override { ++errors; }
+
+public:
+    static std::atomic<size_t> errors;
+};
+
+std::atomic<size_t> EchoHTTPSession::errors{0};
+
+class EchoHTTPServer : public HTTPServer
+{
+public:
+    using HTTPServer::HTTPServer;
+
+protected:
+    std::shared_ptr<TCPSession> CreateSession(std::shared_ptr<TCPServer> server) override { return std::make_shared<EchoHTTPSession>(server); }
+
+protected:
+    void onConnected(std::shared_ptr<TCPSession>& session) override { ++connected; }
+    void onDisconnected(std::shared_ptr<TCPSession>& session) override { ++disconnected; }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<size_t> connected{0};
+    std::atomic<size_t> disconnected{0};
+    std::atomic<bool> errors{false};
+};
+
+class LimitedHTTPServer : public EchoHTTPServer
+{
+public:
+    using EchoHTTPServer::EchoHTTPServer;
+
+protected:
+    std::shared_ptr<TCPSession> CreateSession(std::shared_ptr<TCPServer> server) override
+    {
+        auto session = std::make_shared<EchoHTTPSession>(server);
+        session->SetupMaxHeaderSize(1024);
+        session->SetupMaxHeaders(8);
+        session->SetupMaxBodySize(16);
+        return session;
+    }
+};
+
+class EchoHTTPSSession : public HTTPSSession
+{
+public:
+    using HTTPSSession::HTTPSSession;
+
+protected:
+    void onReceivedRequest(const HTTPRequest& request) override
+    {
+        // Echo the request URL and body with chunked transfer encoding
+        if (request.url() == "/chunked")
+        {
+            response().SetBegin(200);
+            response().SetHeader("Content-Type", "text/plain");
+            response().SetBodyChunked();
+            SendResponseAsync();
+            SendResponseBodyChunkAsync(request.url());
+            if (!request.body().empty())
+                SendResponseBodyChunkAsync(request.body());
+            SendResponseBodyChunkAsync("");
+            return;
+        }
+
+        // Echo the request URL and body
+        response().SetBegin(200);
+        response().SetHeader("Content-Type", "text/plain");
+        response().SetBody(std::string(request.url()) + std::string(request.body()));
+        SendResponseAsync();
+    }
+    void onReceivedRequestError(const HTTPRequest& request, const std::string& error) override { ++errors; }
+
+public:
+    static std::atomic<size_t> errors;
+};
+
+std::atomic<size_t> EchoHTTPSSession::errors{0};
+
+class EchoHTTPSServer : public HTTPSServer
+{
+public:
+    using HTTPSServer::HTTPSServer;
+
+    static std::shared_ptr<SSLContext> CreateContext()
+    {
+        auto context = std::make_shared<SSLContext>(asio::ssl::context::tlsv12);
+        context->set_password_callback([](size_t max_length, asio::ssl::context::password_purpose purpose) -> std::string { return "qwerty"; });
+        context->use_certificate_chain_file("../tools/certificates/server.pem");
+        context->use_private_key_file("../tools/certificates/server.pem", asio::ssl::context::pem);
+        context->use_tmp_dh_file("../tools/certificates/dh4096.pem");
+        return context;
+    }
+
+protected:
+    std::shared_ptr<SSLSession> CreateSession(std::shared_ptr<SSLServer> server) override { return std::make_shared<EchoHTTPSSession>(server); }
+
+protected:
+    void onHandshaked(std::shared_ptr<SSLSession>& session) override { ++handshaked; }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<size_t> handshaked{0};
+    std::atomic<bool> errors{false};
+};
+
+class LimitedHTTPSServer : public EchoHTTPSServer
+{
+public:
+    using EchoHTTPSServer::EchoHTTPSServer;
+
+protected:
+    std::shared_ptr<SSLSession> CreateSession(std::shared_ptr<SSLServer> server) override
+    {
+        auto session = std::make_shared<EchoHTTPSSession>(server);
+        session->SetupMaxHeaderSize(1024);
+        session->SetupMaxHeaders(8);
+        session->SetupMaxBodySize(16);
+        return session;
+    }
+};
+
+class LoopbackHTTP2Connection : public HTTP2Connection
+{
+public:
+    using HTTP2Connection::HTTP2Connection;
+
+    // Deliver sent data between connections until both of them are idle
+    static void Exchange(LoopbackHTTP2Connection& connection1, LoopbackHTTP2Connection& connection2)
+    {
+        while (!connection1.output.empty() || !connection2.output.empty())
+        {
+            std::string data;
+            data.swap(connection1.output);
+            REQUIRE(connection2.Receive(data.data(), data.size()));
+            data.clear();
+            data.swap(connection2.output);
+            REQUIRE(connection1.Receive(data.data(), data.size()));
+        }
+    }
+
+protected:
+    void onSend(const void* buffer, size_t size) override { output.append((const char*)buffer, size); }
+    void onReceivedRequest(const HTTPRequest& request) override { ++requests; }
+    void onReceivedResponse(const HTTPResponse& response) override { statuses.push_back(response.status()); }
+    void onStreamError(uint32_t stream, const std::string& error) override { ++errors; }
+
+public:
+    std::string output;
+    size_t requests{0};
+    std::vector<int> statuses;
+    size_t errors{0};
+};
+
+class RawHTTPClient : public TCPClient
+{
+public:
+    using TCPClient::TCPClient;
+
+    std::string received()
+    {
+        std::scoped_lock locker(_lock);
+        return _received;
+    }
+
+protected:
+    void onConnected() override { connected = true; }
+    void onDisconnected() override { disconnected = true; }
+    void onReceived(const void* buffer, size_t size) override
+    {
+        std::scoped_lock locker(_lock);
+        _received.append((const char*)buffer, size);
+    }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> connected{false};
+    std::atomic<bool> disconnected{false};
+    std::atomic<bool> errors{false};
+
+private:
+    std::mutex _lock;
+    std::string _received;
+};
+
+class ChunkedHTTPClient : public HTTPClient
+{
+public:
+    using HTTPClient::HTTPClient;
+
+    std::vector<std::string> bodies()
+    {
+        std::scoped_lock locker(_lock);
+        return _bodies;
+    }
+
+protected:
+    void onReceivedResponse(const HTTPResponse& response) override
+    {
+        std::scoped_lock locker(_lock);
+        _bodies.emplace_back(response.body());
+        ++responses;
+    }
+    void onReceivedResponseError(const HTTPResponse& response, const std::string& error) override { errors = true; }
+
+public:
+    std::atomic<size_t> responses{0};
+    std::atomic<bool> errors{false};
+
+private:
+    std::mutex _lock;
+    std::vector<std::string> _bodies;
+};
+
+class StreamHTTPClient : public HTTPClient
+{
+public:
+    using HTTPClient::HTTPClient;
+
+protected:
+    void onReceivedResponseBodyPart(const HTTPResponse& response, const void* buffer, size_t size) override { streamed += size; }
+    void onReceivedResponse(const HTTPResponse& response) override
+    {
+        body_length = response.body_length();
+        if (!response.body().empty())
+            cached = true;
+        ++responses;
+    }
+    void onReceivedResponseError(const HTTPResponse& response, const std::string& error) override { errors = true; }
+
+public:
+    std::atomic<size_t> streamed{0};
+    std::atomic<size_t> body_length{0};
+    std::atomic<size_t> responses{0};
+    std::atomic<bool> cached{false};
+    std::atomic<bool> errors{false};
+};
+
+class ParserHTTPClient : public HTTPClient
+{
+public:
+    using HTTPClient::HTTPClient;
+
+    // Feed raw bytes to the HTTP response parser
+    void Receive(std::string_view data) { onReceived(data.data(), data.size()); }
+
+protected:
+    void onReceivedResponse(const HTTPResponse& response) override { responses.push_back(response); }
+    void onReceivedResponseError(const HTTPResponse& response, const std::string& error) override { ++errors; }
+
+public:
+    std::vector<HTTPResponse> responses;
+    size_t errors{0};
+};
+
+size_t CountResponses(const std::string& received)
+{
+    size_t count = 0;
+    for (size_t i = received.find("HTTP/1.1 200 OK"); i != std::string::npos; i = received.find("HTTP/1.1 200 OK", i + 1))
+        ++count;
+    return count;
+}
+
+std::string FromHex(const std::string& hex)
+{
+    std::string result;
+    for (size_t i = 0; (i + 1) < hex.size(); i += 2)
+        result.push_back((char)std::stoi(hex.substr(i, 2), nullptr, 16));
+    return result;
+}
+
+HPACKHeaders DecodeHPACK(HPACKDecoder& decoder, const std::string& hex)
+{
+    HPACKHeaders headers;
+    std::string block = FromHex(hex);
+    REQUIRE(decoder.Decode(block.data(), block.size(), headers));
+    return headers;
+}
+
+} // namespace
+
 TEST_CASE("HTTP request test", "[CppServer][HTTP]")
 {
     // Create a new HTTP request
@@ -62,6 +396,130 @@ TEST_CASE("HTTP response test", "[CppServer][HTTP]")
     REQUIRE(response.body() == "test");
 }
 
+TEST_CASE("HTTP response parser test", "[CppServer][HTTP]")
+{
+    auto service = std::make_shared<Service>();
+
+    // HTTP response with headers longer than the scanned block
+    const std::string raw = "HTTP/1.1 200 OK\r\nContent-Type: text/plain; charset=UTF-8\r\nCache-Control: no-cache, no-store\r\nContent-Length: 4\r\n\r\ntest";
+
+    // Split HTTP response at every byte offset
+    for (size_t i = 1; i < raw.size(); ++i)
+    {
+        auto client = std::make_shared<ParserHTTPClient>(service, "127.0.0.1", 80);
+        client->Receive(std::string_view(raw).substr(0, i));
+        REQUIRE(client->responses.empty());
+        client->Receive(std::string_view(raw).substr(i));
+        REQUIRE(client->errors == 0);
+        REQUIRE(client->responses.size() == 1);
+
+        auto& response = client->responses[0];
+        REQUIRE(response.status() == 200);
+        REQUIRE(response.status_phrase() == "OK");
+        REQUIRE(response.protocol() == "HTTP/1.1");
+        REQUIRE(response.headers() == 3);
+        REQUIRE(std::get<0>(response.header(0)) == "Content-Type");
+        REQUIRE(std::get<1>(response.header(0)) == "text/plain; charset=UTF-8");
+        REQUIRE(std::get<0>(response.header(1)) == "Cache-Control");
+        REQUIRE(std::get<1>(response.header(1)) == "no-cache, no-store");
+        REQUIRE(std::get<0>(response.header(2)) == "Content-Length");
+        REQUIRE(std::get<1>(response.header(2)) == "4");
+        REQUIRE(response.body() == "test");
+        REQUIRE(response.body_length() == 4);
+    }
+
+    // Receive HTTP response byte by byte
+    auto client = std::make_shared<ParserHTTPClient>(service, "127.0.0.1", 80);
+    for (char ch : raw)
+        client->Receive(std::string_view(&ch, 1));
+    REQUIRE(client->errors == 0);
+    REQUIRE(client->responses.size() == 1);
+    REQUIRE(client->responses[0].headers() == 3);
+    REQUIRE(client->responses[0].body() == "test");
+}
+
+TEST_CASE("HTTP response parser pipelining test", "[CppServer][HTTP]")
+{
+    auto service = std::make_shared<Service>();
+    auto client = std::make_shared<ParserHTTPClient>(service, "127.0.0.1", 80);
+
+    // Two pipelined HTTP responses in one buffer
+    const std::string first = "HTTP/1.1 200 OK\r\ncontent-length: 5\r\n\r\nfirst";
+    const std::string second = "HTTP/1.1 404 Not Found\r\nContent-Length: 6\r\n\r\nsecond";
+    client->Receive(first + second);
+    REQUIRE(client->errors == 0);
+    REQUIRE(client->responses.size() == 2);
+
+    // Check each response consumed only its own bytes
+    REQUIRE(client->responses[0].status() == 200);
+    REQUIRE(client->responses[0].body() == "first");
+    REQUIRE(client->responses[0].cache().size() == first.size());
+    REQUIRE(client->responses[1].status() == 404);
+    REQUIRE(client->responses[1].status_phrase() == "Not Found");
+    REQUIRE(client->responses[1].body() == "second");
+    REQUIRE(client->responses[1].cache().size() == second.size());
+}
+
+TEST_CASE("HTTP response parser content length test", "[CppServer][HTTP]")
+{
+    auto service = std::make_shared<Service>();
+    auto client = std::make_shared<ParserHTTPClient>(service, "127.0.0.1", 80);
+
+    // Content length header is matched case-insensitively
+    client->Receive("HTTP/1.1 200 OK\r\ncontent-length: 4\r\n\r\ntest");
+    REQUIRE(client->errors == 0);
+    REQUIRE(client->responses.size() == 1);
+    REQUIRE(client->responses[0].body() == "test");
+    REQUIRE(client->responses[0].body_length() == 4);
+
+    // Body size does not include the header separator
+    client->Receive("HTTP/1.1 200 OK\r\nCONTENT-LENGTH: 0\r\n\r\n");
+    REQUIRE(client->errors == 0);
+    REQUIRE(client->responses.size() == 2);
+    REQUIRE(client->responses[1].body().empty());
+    REQUIRE(client->responses[1].body_length() == 0);
+}
+
+TEST_CASE("HTTP response parser bare LF test", "[CppServer][HTTP]")
+{
+    auto service = std::make_shared<Service>();
+
+    // Bare LF in the status line
+    auto client1 = std::make_shared<ParserHTTPClient>(service, "127.0.0.1", 80);
+    client1->Receive("HTTP/1.1 200 OK\nContent-Length: 0\r\n\r\n");
+    REQUIRE(client1->errors == 1);
+    REQUIRE(client1->responses.empty());
+
+    // Bare LF in the header value
+    auto client2 = std::make_shared<ParserHTTPClient>(service, "127.0.0.1", 80);
+    client2->Receive("HTTP/1.1 200 OK\r\nX-Test: first\nsecond\r\nContent-Length: 0\r\n\r\n");
+    REQUIRE(client2->errors == 1);
+    REQUIRE(client2->responses.empty());
+}
+
+TEST_CASE("HTTP response parser no body test", "[CppServer][HTTP]")
+{
+    auto service = std::make_shared<Service>();
+    auto client = std::make_shared<ParserHTTPClient>(service, "127.0.0.1", 80);
+
+    // Informational, "No Content" and "Not Modified" responses have no body even with the content length
+    client->Receive("HTTP/1.1 100 Continue\r\n\r\n"
+                    "HTTP/1.1 204 No Content\r\n\r\n"
+                    "HTTP/1.1 304 Not Modified\r\nContent-Length: 10\r\n\r\n"
+                    "HTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\ntest");
+    REQUIRE(client->errors == 0);
+    REQUIRE(client->responses.size() == 4);
+    REQUIRE(client->responses[0].status() == 100);
+    REQUIRE(client->responses[0].body().empty());
+    REQUIRE(client->responses[1].status() == 204);
+    REQUIRE(client->responses[1].body().empty());
+    REQUIRE(client->responses[2].status() == 304);
+    REQUIRE(client->responses[2].body().empty());
+    REQUIRE(client->responses[2].body_length() == 0);
+    REQUIRE(client->responses[3].status() == 200);
+    REQUIRE(client->responses[3].body() == "test");
+}
+
 TEST_CASE("HTTP client test", "[CppServer][HTTP]")
 {
     const std::string address = "example.com";
@@ -140,3 +598,858 @@ TEST_CASE("HTTPS client test", "[CppServer][HTTP]")
     while (service->IsStarted())
         Thread::Yield();
 }
+
+TEST_CASE("HTTP server test", "[CppServer][HTTP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8080;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo HTTP server
+    auto server = std::make_shared<EchoHTTPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create a new HTTP client
+    auto client = std::make_shared<HTTPClientEx>(service, address, port);
+
+    // Prepare HTTP request
+    client->request().SetBegin("POST", "/echo");
+    client->request().SetHeader("Host", "localhost");
+    client->request().SetBody("test");
+
+    // Send HTTP request
+    auto response = client->MakeRequest().get();
+
+    // Check HTTP response
+    REQUIRE(response.status() == 200);
+    REQUIRE(response.status_phrase() == "OK");
+    REQUIRE(response.protocol() == "HTTP/1.1");
+    REQUIRE(response.body_length() == 9);
+    REQUIRE(response.body() == "/echotest");
+
+    // Disconnect the HTTP client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Create and connect raw HTTP client
+    auto raw = std::make_shared<RawHTTPClient>(service, address, port);
+    REQUIRE(raw->ConnectAsync());
+    while (!raw->IsConnected())
+        Thread::Yield();
+
+    // Send pipelined requests split into several chunks
+    REQUIRE(raw->SendAsync("GET /1 HTTP/1.1\r\nHost: localhost\r\n\r\nPOST /2 HTTP/1.1\r\nHost: localhost\r\nContent-Length: 4\r\n\r\ntestGET /3 HTTP/1.1\r\nHo"));
+    REQUIRE(raw->SendAsync("st: localhost\r\n\r\n"));
+
+    // Wait for all responses...
+    while (CountResponses(raw->received()) != 3)
+        Thread::Yield();
+
+    // Request the server to close the connection
+    REQUIRE(raw->SendAsync("GET /4 HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n"));
+
+    // Wait for the connection is closed by the server...
+    while (raw->IsConnected())
+        Thread::Yield();
+
+    // Check responses are received in order
+    std::string received = raw->received();
+    REQUIRE(CountResponses(received) == 4);
+    REQUIRE(received.find("\r\n\r\n/1") < received.find("\r\n\r\n/2test"));
+    REQUIRE(received.find("\r\n\r\n/2test") < received.find("\r\n\r\n/3"));
+    REQUIRE(received.find("\r\n\r\n/3") < received.find("\r\n\r\n/4"));
+
+    // Create and connect invalid HTTP client
+    auto invalid = std::make_shared<RawHTTPClient>(service, address, port);
+    REQUIRE(invalid->ConnectAsync());
+    while (!invalid->IsConnected())
+        Thread::Yield();
+
+    // HTTP/1.1 request without the host header should be rejected
+    REQUIRE(invalid->SendAsync("GET / HTTP/1.1\r\n\r\n"));
+
+    // Wait for the connection is closed by the server...
+    while (invalid->IsConnected())
+        Thread::Yield();
+
+    // Stop the Echo HTTP server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo HTTP server state
+    REQUIRE(server->connected == 3);
+    REQUIRE(server->disconnected == 3);
+    REQUIRE(!server->errors);
+    REQUIRE(EchoHTTPSession::errors == 1);
+
+    // Check the invalid HTTP client state
+    REQUIRE(invalid->received().find("HTTP/1.1 400 Bad Request\r\n") == 0);
+
+    // Check the raw HTTP client state
+    REQUIRE(raw->connected);
+    REQUIRE(raw->disconnected);
+    REQUIRE(!raw->errors);
+}
+
+TEST_CASE("HTTP server request limits test", "[CppServer][HTTP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8081;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo HTTP server with limited requests
+    auto server = std::make_shared<LimitedHTTPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Send the raw HTTP request and wait for the connection is closed by the server
+    auto request = [&](const std::string& data)
+    {
+        auto raw = std::make_shared<RawHTTPClient>(service, address, port);
+        REQUIRE(raw->ConnectAsync());
+        while (!raw->IsConnected())
+            Thread::Yield();
+        REQUIRE(raw->SendAsync(data));
+        while (raw->IsConnected())
+            Thread::Yield();
+        return raw->received();
+    };
+
+    EchoHTTPSession::errors = 0;
+
+    // Request within limits should be processed
+    REQUIRE(request("POST / HTTP/1.1\r\nHost: localhost\r\nContent-Length: 4\r\nConnection: close\r\n\r\ntest").find("HTTP/1.1 200 OK\r\n") == 0);
+
+    // Too large header should be rejected
+    REQUIRE(request("GET / HTTP/1.1\r\nHost: localhost\r\nCookie: " + std::string(2000, 'x') + "\r\n\r\n").find("HTTP/1.1 431 Request Header Fields Too Large\r\n") == 0);
+
+    // Too many header fields should be rejected
+    std::string headers;
+    for (int i = 0; i < 10; ++i)
+        headers += "X-Header-" + std::to_string(i) + ": test\r\n";
+    REQUIRE(request("GET / HTTP/1.1\r\nHost: localhost\r\n" + headers + "\r\n").find("HTTP/1.1 431 Request Header Fields Too Large\r\n") == 0);
+
+    // Too large body should be rejected before it is received
+    REQUIRE(request("POST / HTTP/1.1\r\nHost: localhost\r\nContent-Length: 1000000\r\n\r\n").find("HTTP/1.1 413 Payload Too Large\r\n") == 0);
+
+    // Too large chunked body should be rejected
+    REQUIRE(request("POST / HTTP/1.1\r\nHost: localhost\r\nTransfer-Encoding: chunked\r\n\r\n10\r\n" + std::string(16, 'x') + "\r\n10\r\n" + std::string(16, 'x') + "\r\n0\r\n\r\n").find("HTTP/1.1 413 Payload Too Large\r\n") == 0);
+
+    // Invalid request should be answered with bad request response
+    REQUIRE(request("GET / HTTP/1.1\r\nHost localhost\r\n\r\n").find("HTTP/1.1 400 Bad Request\r\n") == 0);
+
+    // Stop the Echo HTTP server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo HTTP server state
+    REQUIRE(server->connected == 6);
+    REQUIRE(server->disconnected == 6);
+    REQUIRE(!server->errors);
+    REQUIRE(EchoHTTPSession::errors == 5);
+}
+
+TEST_CASE("HTTP chunked transfer encoding test", "[CppServer][HTTP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8080;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo HTTP server
+    auto server = std::make_shared<EchoHTTPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect chunked HTTP client
+    auto client = std::make_shared<ChunkedHTTPClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Send chunked HTTP request
+    client->request().SetBegin("POST", "/chunked");
+    client->request().SetHeader("Host", "localhost");
+    client->request().SetBodyChunked();
+    REQUIRE(client->SendRequestAsync());
+    REQUIRE(client->SendRequestBodyChunkAsync("hello "));
+    REQUIRE(client->SendRequestBodyChunkAsync("world"));
+    REQUIRE(client->SendRequestBodyChunkAsync(""));
+
+    // Wait for the chunked response...
+    while (client->responses != 1)
+        Thread::Yield();
+
+    // Send the next HTTP request over the same keep-alive connection
+    client->request().SetBegin("GET", "/chunked");
+    client->request().SetHeader("Host", "localhost");
+    client->request().SetBody();
+    REQUIRE(client->SendRequestAsync());
+
+    // Wait for the chunked response...
+    while (client->responses != 2)
+        Thread::Yield();
+
+    // Check chunked responses
+    auto bodies = client->bodies();
+    REQUIRE(bodies.size() == 2);
+    REQUIRE(bodies[0] == "/chunkedhello world");
+    REQUIRE(bodies[1] == "/chunked");
+    REQUIRE(client->IsConnected());
+    REQUIRE(!client->errors);
+
+    // Disconnect the chunked HTTP client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the Echo HTTP server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo HTTP server state
+    REQUIRE(server->connected == 1);
+    REQUIRE(server->disconnected == 1);
+    REQUIRE(!server->errors);
+}
+
+TEST_CASE("HTTP truncated response test", "[CppServer][HTTP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8080;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo HTTP server
+    auto server = std::make_shared<EchoHTTPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create chunked HTTP client
+    auto client = std::make_shared<ChunkedHTTPClient>(service, address, port);
+
+    for (const std::string url : { "/truncated/length", "/truncated/chunked" })
+    {
+        // Connect the chunked HTTP client
+        REQUIRE(client->ConnectAsync());
+        while (!client->IsConnected())
+            Thread::Yield();
+
+        // Send HTTP request which response is cut off in the middle of the body
+        client->errors = false;
+        client->request().SetBegin("GET", url);
+        client->request().SetHeader("Host", "localhost");
+        client->request().SetBody();
+        REQUIRE(client->SendRequestAsync());
+
+        // Wait for the response error...
+        while (!client->errors)
+            Thread::Yield();
+        while (client->IsConnected())
+            Thread::Yield();
+
+        // Check the truncated response was not received
+        REQUIRE(client->responses == 0);
+    }
+
+    // Stop the Echo HTTP server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+}
+
+TEST_CASE("HTTP stream body test", "[CppServer][HTTP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8080;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo HTTP server
+    auto server = std::make_shared<EchoHTTPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect stream HTTP client
+    auto client = std::make_shared<StreamHTTPClient>(service, address, port);
+    client->SetupStreamBody(true);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    const std::string body(1024 * 1024, 'x');
+
+    // Stream the response body with the content length
+    client->request().SetBegin("POST", "/echo");
+    client->request().SetHeader("Host", "localhost");
+    client->request().SetBody(body);
+    REQUIRE(client->SendRequestAsync());
+    while (client->responses != 1)
+        Thread::Yield();
+
+    REQUIRE(client->streamed == (5 + body.size()));
+    REQUIRE(client->body_length == (5 + body.size()));
+
+    // Stream the chunked response body
+    client->streamed = 0;
+    client->request().SetBegin("POST", "/chunked");
+    client->request().SetHeader("Host", "localhost");
+    client->request().SetBody(body);
+    REQUIRE(client->SendRequestAsync());
+    while (client->responses != 2)
+        Thread::Yield();
+
+    REQUIRE(client->streamed == (8 + body.size()));
+    REQUIRE(client->body_length == (8 + body.size()));
+
+    // Check the response body was not cached
+    REQUIRE(!client->cached);
+    REQUIRE(!client->errors);
+
+    // Disconnect the stream HTTP client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the Echo HTTP server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+}
+
+TEST_CASE("HTTP client pool test", "[CppServer][HTTP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8080;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo HTTP server
+    auto server = std::make_shared<EchoHTTPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create HTTP client pool with two connections per host
+    auto pool = std::make_shared<HTTPClientPool>(service, 2, Timespan::milliseconds(500));
+
+    // Make concurrent HTTP requests
+    std::vector<std::future<HTTPResponse>> futures;
+    for (int i = 0; i < 10; ++i)
+    {
+        HTTPRequest request("GET", "/" + std::to_string(i));
+        request.SetHeader("Host", "localhost");
+        request.SetBody();
+        futures.emplace_back(pool->MakeRequest(address, port, request));
+    }
+
+    // Check HTTP responses
+    for (int i = 0; i < 10; ++i)
+    {
+        auto response = futures[i].get();
+        REQUIRE(response.status() == 200);
+        REQUIRE(response.body() == ("/" + std::to_string(i)));
+    }
+
+    // Check keep-alive connections were reused
+    REQUIRE(server->connected <= 2);
+    REQUIRE(pool->connections() <= 2);
+
+    // Wait for idle connections are closed...
+    while (pool->connections() > 0)
+        Thread::Yield();
+    while (server->disconnected != server->connected)
+        Thread::Yield();
+
+    // Stop the Echo HTTP server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo HTTP server state
+    REQUIRE(!server->errors);
+}
+
+TEST_CASE("HTTP client pool queue timeout test", "[CppServer][HTTP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8093;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start plain TCP server which accepts connections and never replies
+    auto server = std::make_shared<TCPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create HTTP client pool with one connection per host
+    auto pool = std::make_shared<HTTPClientPool>(service, 1);
+
+    // Make HTTP request which occupies the only connection
+    HTTPRequest request("GET", "/");
+    request.SetHeader("Host", "localhost");
+    request.SetBody();
+    auto busy = pool->MakeRequest(address, port, request, Timespan::seconds(10));
+
+    // Make HTTP request which waits in the queue longer than its timeout
+    auto queued = pool->MakeRequest(address, port, request, Timespan::milliseconds(100));
+    REQUIRE(queued.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    REQUIRE_THROWS(queued.get());
+
+    // Check the busy request is still pending
+    REQUIRE(busy.wait_for(std::chrono::milliseconds(0)) == std::future_status::timeout);
+
+    // Disconnect the pool and fail the busy request
+    pool->DisconnectAll();
+    REQUIRE_THROWS(busy.get());
+
+    // Stop the plain TCP server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+}
+
+TEST_CASE("HTTP client pipelining test", "[CppServer][HTTP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8080;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo HTTP server
+    auto server = std::make_shared<EchoHTTPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create a new HTTP client with the pipeline depth of four requests
+    auto client = std::make_shared<HTTPClientEx>(service, address, port);
+    client->SetupPipelineDepth(4);
+
+    // Make concurrent HTTP requests with plain and chunked responses
+    std::vector<std::future<HTTPResponse>> futures;
+    for (int i = 0; i < 10; ++i)
+    {
+        HTTPRequest request("GET", ((i % 3) == 0) ? "/chunked" : ("/" + std::to_string(i)));
+        request.SetHeader("Host", "localhost");
+        request.SetBody();
+        futures.emplace_back(client->MakeRequest(request));
+    }
+
+    // Check HTTP responses are matched to requests in order
+    for (int i = 0; i < 10; ++i)
+    {
+        auto response = futures[i].get();
+        REQUIRE(response.status() == 200);
+        REQUIRE(response.body() == (((i % 3) == 0) ? "/chunked" : ("/" + std::to_string(i))));
+    }
+
+    // Check all requests were sent over the single connection
+    REQUIRE(server->connected == 1);
+
+    // Disconnect the HTTP client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the Echo HTTP server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo HTTP server state
+    REQUIRE(!server->errors);
+}
+
+TEST_CASE("HTTPS HTTP/2 test", "[CppServer][HTTP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8443;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo HTTPS server which prefers HTTP/2 protocol
+    auto server_context = EchoHTTPSServer::CreateContext();
+    server_context->set_alpn_protocols({ "h2", "http/1.1" });
+    auto server = std::make_shared<EchoHTTPSServer>(service, server_context, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create a new HTTPS client which supports HTTP/2 protocol
+    auto client_context = std::make_shared<SSLContext>(asio::ssl::context::tlsv12);
+    client_context->set_default_verify_paths();
+    client_context->set_root_certs();
+    client_context->set_verify_mode(asio::ssl::verify_peer | asio::ssl::verify_fail_if_no_peer_cert);
+    client_context->load_verify_file("../tools/certificates/ca.pem");
+    client_context->set_alpn_protocols({ "h2", "http/1.1" });
+    auto client = std::make_shared<HTTPSClientEx>(service, client_context, address, port);
+
+    // Make concurrent HTTP requests with plain and chunked responses
+    std::vector<std::future<HTTPResponse>> futures;
+    for (int i = 0; i < 10; ++i)
+    {
+        HTTPRequest request("POST", ((i % 3) == 0) ? "/chunked" : ("/" + std::to_string(i)));
+        request.SetHeader("Host", "localhost");
+        request.SetBody(std::string(i * 1000, 'x'));
+        futures.emplace_back(client->MakeRequest(request));
+    }
+
+    // Check HTTP responses are matched to requests by HTTP/2 streams
+    for (int i = 0; i < 10; ++i)
+    {
+        auto response = futures[i].get();
+        REQUIRE(response.status() == 200);
+        REQUIRE(response.protocol() == "HTTP/2.0");
+        REQUIRE(response.stream() != 0);
+        REQUIRE(response.body() == ((((i % 3) == 0) ? "/chunked" : ("/" + std::to_string(i))) + std::string(i * 1000, 'x')));
+    }
+
+    // Check all requests were multiplexed over the single connection
+    REQUIRE(client->IsHTTP2());
+    REQUIRE(server->handshaked == 1);
+
+    // Disconnect the HTTPS client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the Echo HTTPS server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo HTTPS server state
+    REQUIRE(!server->errors);
+    REQUIRE(EchoHTTPSSession::errors == 0);
+}
+
+TEST_CASE("HTTP/2 HPACK request test", "[CppServer][HTTP]")
+{
+    // RFC 7541 Appendix C.3: requests without Huffman coding
+    HPACKDecoder decoder1;
+    REQUIRE(DecodeHPACK(decoder1, "828684410f7777772e6578616d706c652e636f6d") == HPACKHeaders({ { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" } }));
+    REQUIRE(decoder1.table().size() == 57);
+    REQUIRE(DecodeHPACK(decoder1, "828684be58086e6f2d6361636865") == HPACKHeaders({ { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" }, { "cache-control", "no-cache" } }));
+    REQUIRE(decoder1.table().size() == 110);
+    REQUIRE(DecodeHPACK(decoder1, "828785bf400a637573746f6d2d6b65790c637573746f6d2d76616c7565") == HPACKHeaders({ { ":method", "GET" }, { ":scheme", "https" }, { ":path", "/index.html" }, { ":authority", "www.example.com" }, { "custom-key", "custom-value" } }));
+    REQUIRE(decoder1.table().size() == 164);
+
+    // RFC 7541 Appendix C.4: requests with Huffman coding
+    HPACKDecoder decoder2;
+    REQUIRE(DecodeHPACK(decoder2, "828684418cf1e3c2e5f23a6ba0ab90f4ff") == HPACKHeaders({ { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" } }));
+    REQUIRE(decoder2.table().size() == 57);
+    REQUIRE(DecodeHPACK(decoder2, "828684be5886a8eb10649cbf") == HPACKHeaders({ { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" }, { "cache-control", "no-cache" } }));
+    REQUIRE(decoder2.table().size() == 110);
+    REQUIRE(DecodeHPACK(decoder2, "828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf") == HPACKHeaders({ { ":method", "GET" }, { ":scheme", "https" }, { ":path", "/index.html" }, { ":authority", "www.example.com" }, { "custom-key", "custom-value" } }));
+    REQUIRE(decoder2.table().size() == 164);
+}
+
+TEST_CASE("HTTP/2 HPACK response test", "[CppServer][HTTP]")
+{
+    const HPACKHeaders response1 = { { ":status", "302" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:21 GMT" }, { "location", "https://www.example.com" } };
+    const HPACKHeaders response2 = { { ":status", "307" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:21 GMT" }, { "location", "https://www.example.com" } };
+    const HPACKHeaders response3 = { { ":status", "200" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:22 GMT" }, { "location", "https://www.example.com" }, { "content-encoding", "gzip" }, { "set-cookie", "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1" } };
+
+    // RFC 7541 Appendix C.5: responses without Huffman coding and evictions
+    HPACKDecoder decoder1(256);
+    REQUIRE(DecodeHPACK(decoder1, "4803333032580770726976617465611d4d6f6e2c203231204f637420323031332032303a31333a323120474d546e1768747470733a2f2f7777772e6578616d706c652e636f6d") == response1);
+    REQUIRE(decoder1.table().size() == 222);
+    REQUIRE(DecodeHPACK(decoder1, "4803333037c1c0bf") == response2);
+    REQUIRE(decoder1.table().size() == 222);
+    REQUIRE(DecodeHPACK(decoder1, "88c1611d4d6f6e2c203231204f637420323031332032303a31333a323220474d54c05a04677a69707738666f6f3d4153444a4b48514b425a584f5157454f50495541585157454f49553b206d61782d6167653d333630303b2076657273696f6e3d31") == response3);
+    REQUIRE(decoder1.table().size() == 215);
+
+    // RFC 7541 Appendix C.6: responses with Huffman coding and evictions
+    HPACKDecoder decoder2(256);
+    REQUIRE(DecodeHPACK(decoder2, "488264025885aec3771a4b6196d07abe941054d444a8200595040b8166e082a62d1bff6e919d29ad171863c78f0b97c8e9ae82ae43d3") == response1);
+    REQUIRE(decoder2.table().size() == 222);
+    REQUIRE(DecodeHPACK(decoder2, "4883640effc1c0bf") == response2);
+    REQUIRE(decoder2.table().size() == 222);
+    REQUIRE(DecodeHPACK(decoder2, "88c16196d07abe941054d444a8200595040b8166e084a62d1bffc05a839bd9ab77ad94e7821dd7f2e6c7b335dfdfcd5b3960d5af27087f3672c1ab270fb5291f9587316065c003ed4ee5b1063d5007") == response3);
+    REQUIRE(decoder2.table().size() == 215);
+
+    // Encoded responses should be decoded back
+    HPACKEncoder encoder(256);
+    HPACKDecoder decoder3(256);
+    for (const auto& response : { response1, response2, response3 })
+    {
+        std::string block;
+        for (const auto& header : response)
+            encoder.Encode(block, header.first, header.second);
+        HPACKHeaders headers;
+        REQUIRE(decoder3.Decode(block.data(), block.size(), headers));
+        REQUIRE(headers == response);
+    }
+}
+
+TEST_CASE("HTTP/2 HPACK header list size test", "[CppServer][HTTP]")
+{
+    // Index a large header field in the dynamic table
+    std::string block = FromHex("400a637573746f6d2d6b65797fe906") + std::string(1000, 'x');
+    HPACKDecoder decoder(4096, 16 * 1024);
+    HPACKHeaders headers;
+    REQUIRE(decoder.Decode(block.data(), block.size(), headers));
+    REQUIRE(headers.size() == 1);
+    REQUIRE(!decoder.overflow());
+
+    // Each one byte reference to the large header field adds 1042 bytes to the header list
+    std::string bomb(100, (char)0xBE);
+    headers.clear();
+    REQUIRE(!decoder.Decode(bomb.data(), bomb.size(), headers));
+    REQUIRE(decoder.overflow());
+    REQUIRE(headers.size() < 16);
+
+    // Small header block is still decoded
+    HPACKDecoder decoder2(4096, 16 * 1024);
+    REQUIRE(decoder2.Decode(block.data(), block.size(), headers));
+    REQUIRE(!decoder2.overflow());
+}
+
+TEST_CASE("HTTP/2 request limits test", "[CppServer][HTTP]")
+{
+    LoopbackHTTP2Connection server(true);
+    LoopbackHTTP2Connection client(false);
+    server.SetupMaxHeaderSize(1024);
+    server.SetupMaxHeaders(8);
+    server.SetupMaxBodySize(16);
+    server.Start();
+    client.Start();
+    LoopbackHTTP2Connection::Exchange(client, server);
+
+    // Request within limits should be received
+    HTTPRequest request("POST", "/");
+    request.SetHeader("Host", "localhost");
+    request.SetBody("test");
+    REQUIRE(client.SendRequest(request) != 0);
+    LoopbackHTTP2Connection::Exchange(client, server);
+    REQUIRE(server.requests == 1);
+    REQUIRE(server.streams() == 1);
+
+    // Too large header should be rejected
+    request.Clear();
+    request.SetBegin("GET", "/");
+    request.SetHeader("Host", "localhost");
+    request.SetHeader("Cookie", std::string(2000, 'x'));
+    request.SetBody();
+    REQUIRE(client.SendRequest(request) != 0);
+    LoopbackHTTP2Connection::Exchange(client, server);
+    REQUIRE(client.statuses == std::vector<int>({ 431 }));
+
+    // Too many header fields should be rejected
+    request.Clear();
+    request.SetBegin("GET", "/");
+    request.SetHeader("Host", "localhost");
+    for (int i = 0; i < 10; ++i)
+        request.SetHeader("X-Header-" + std::to_string(i), "test");
+    request.SetBody();
+    REQUIRE(client.SendRequest(request) != 0);
+    LoopbackHTTP2Connection::Exchange(client, server);
+    REQUIRE(client.statuses == std::vector<int>({ 431, 431 }));
+
+    // Too large body should be rejected before it is received
+    request.Clear();
+    request.SetBegin("POST", "/");
+    request.SetHeader("Host", "localhost");
+    request.SetBodyLength(1000000);
+    uint32_t stream = client.SendRequest(request);
+    REQUIRE(stream != 0);
+    LoopbackHTTP2Connection::Exchange(client, server);
+    REQUIRE(client.statuses == std::vector<int>({ 431, 431, 413 }));
+    REQUIRE(!client.SendBody(stream, std::string(1000, 'x').data(), 1000));
+
+    // Too large streamed body should be rejected while it is received
+    request.Clear();
+    request.SetBegin("POST", "/");
+    request.SetHeader("Host", "localhost");
+    request.SetBodyChunked();
+    stream = client.SendRequest(request);
+    REQUIRE(stream != 0);
+    REQUIRE(client.SendBody(stream, "0123456789", 10));
+    LoopbackHTTP2Connection::Exchange(client, server);
+    REQUIRE(client.statuses.size() == 3);
+    REQUIRE(client.SendBody(stream, "0123456789", 10));
+    LoopbackHTTP2Connection::Exchange(client, server);
+    REQUIRE(client.statuses == std::vector<int>({ 431, 431, 413, 413 }));
+    REQUIRE(!client.SendBody(stream, "0123456789", 10));
+
+    // Check rejected streams are closed without the connection error
+    REQUIRE(server.requests == 1);
+    REQUIRE(server.errors == 4);
+    REQUIRE(server.streams() == 1);
+    REQUIRE(!server.error());
+    REQUIRE(!client.error());
+}
+
+TEST_CASE("HTTPS HTTP/2 request limits test", "[CppServer][HTTP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8444;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo HTTPS server with limited requests which prefers HTTP/2 protocol
+    auto server_context = EchoHTTPSServer::CreateContext();
+    server_context->set_alpn_protocols({ "h2", "http/1.1" });
+    auto server = std::make_shared<LimitedHTTPSServer>(service, server_context, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create a new HTTPS client which supports HTTP/2 protocol
+    auto client_context = std::make_shared<SSLContext>(asio::ssl::context::tlsv12);
+    client_context->set_default_verify_paths();
+    client_context->set_root_certs();
+    client_context->set_verify_mode(asio::ssl::verify_peer | asio::ssl::verify_fail_if_no_peer_cert);
+    client_context->load_verify_file("../tools/certificates/ca.pem");
+    client_context->set_alpn_protocols({ "h2", "http/1.1" });
+    auto client = std::make_shared<HTTPSClientEx>(service, client_context, address, port);
+
+    EchoHTTPSSession::errors = 0;
+
+    // Request within limits should be processed
+    HTTPRequest request("POST", "/");
+    request.SetHeader("Host", "localhost");
+    request.SetBody("test");
+    auto response = client->MakeRequest(request).get();
+    REQUIRE(response.status() == 200);
+    REQUIRE(response.body() == "/test");
+
+    // Too large body should be rejected
+    request.Clear();
+    request.SetBegin("POST", "/");
+    request.SetHeader("Host", "localhost");
+    request.SetBody(std::string(1000, 'x'));
+    response = client->MakeRequest(request).get();
+    REQUIRE(response.status() == 413);
+
+    // Too large header should be rejected
+    request.Clear();
+    request.SetBegin("GET", "/");
+    request.SetHeader("Host", "localhost");
+    request.SetHeader("Cookie", std::string(2000, 'x'));
+    request.SetBody();
+    response = client->MakeRequest(request).get();
+    REQUIRE(response.status() == 431);
+
+    // Check all requests were multiplexed over the single connection
+    REQUIRE(client->IsHTTP2());
+    REQUIRE(server->handshaked == 1);
+
+    // Disconnect the HTTPS client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the Echo HTTPS server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo HTTPS server state
+    REQUIRE(!server->errors);
+    REQUIRE(EchoHTTPSSession::errors == 2);
+}
@@ -0,0 +1,316 @@
+//
+// Created by agent on 18.10.2026
+//
+
+#include "test.h"
+
+#include "server/asio/rudp_client.h"
+#include "server/asio/rudp_server.h"
+#include "threads/thread.h"
+
+#include <atomic>
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace CppCommon;
+using namespace CppServer::Asio;
+
+namespace {
+
+class LossyChannel : public RUDPChannel
+{
+public:
+    LossyChannel(std::deque<std::vector<uint8_t>>& link, size_t loss) : _link(link), _loss(loss) {}
+
+    std::vector<std::string> messages;
+    std::vector<std::string> dropped;
+
+protected:
+    void onSend(const void* buffer, size_t size) override
+    {
+        // Drop every n-th datagram
+        if ((_loss > 0) && ((++_counter % _loss) == 0))
+            return;
+        _link.emplace_back((const uint8_t*)buffer, (const uint8_t*)buffer + size);
+    }
+
+    void onReceived(const void* buffer, size_t size) override { messages.emplace_back((const char*)buffer, size); }
+    void onDropped(const void* buffer, size_t size) override { dropped.emplace_back((const char*)buffer, size); }
+
+private:
+    std::deque<std::vector<uint8_t>>& _link;
+    size_t _loss;
+    size_t _counter{0};
+};
+
+class EchoRUDPClient : public RUDPClient
+{
+public:
+    using RUDPClient::RUDPClient;
+
+protected:
+    void onConnected() override { RUDPClient::onConnected(); connected = true; }
+    void onDisconnected() override { RUDPClient::onDisconnected(); disconnected = true; }
+    void onReceivedMessage(const void* buffer, size_t size) override { received += size; }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> connected{false};
+    std::atomic<bool> disconnected{false};
+    std::atomic<size_t> received{0};
+    std::atomic<bool> errors{false};
+};
+
+class EchoRUDPSession : public RUDPSession
+{
+public:
+    using RUDPSession::RUDPSession;
+
+protected:
+    void onReceivedMessage(const void* buffer, size_t size) override { SendReliable(buffer, size); }
+};
+
+class EchoRUDPServer : public RUDPServer
+{
+public:
+    using RUDPServer::RUDPServer;
+
+protected:
+    std::shared_ptr<UDPSession> CreateSession(std::shared_ptr<UDPServer> server, const asio::ip::udp::endpoint& endpoint) override { return std::make_shared<EchoRUDPSession>(server, endpoint); }
+
+protected:
+    void onStarted() override { RUDPServer::onStarted(); started = true; }
+    void onStopped() override { RUDPServer::onStopped(); stopped = true; }
+    void onConnected(std::shared_ptr<UDPSession>& session) override { ++connected; }
+    void onDisconnected(std::shared_ptr<UDPSession>& session) override { ++disconnected; }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> started{false};
+    std::atomic<bool> stopped{false};
+    std::atomic<size_t> connected{0};
+    std::atomic<size_t> disconnected{0};
+    std::atomic<bool> errors{false};
+};
+
+} // namespace
+
+TEST_CASE("Reliable UDP channel test", "[CppServer][RUDP]")
+{
+    std::deque<std::vector<uint8_t>> link1;
+    std::deque<std::vector<uint8_t>> link2;
+
+    // Lose every 5th datagram in both directions
+    LossyChannel channel1(link1, 5);
+    LossyChannel channel2(link2, 5);
+
+    std::vector<std::string> expected;
+    for (int i = 0; i < 1000; ++i)
+    {
+        expected.emplace_back("message " + std::to_string(i));
+        REQUIRE(channel1.SendReliable(expected.back().data(), expected.back().size()));
+    }
+
+    // Too large messages should be rejected
+    std::vector<uint8_t> large(RUDPChannel::MaxMessageSize + 1);
+    REQUIRE(!channel1.SendReliable(large.data(), large.size()));
+
+    // Simulate the link with 1 millisecond one-way delay
+    uint64_t timestamp = 0;
+    for (int i = 0; (i < 100000) && (channel1.messages_pending() > 0); ++i)
+    {
+        timestamp += 1000000;
+
+        channel1.Flush(timestamp);
+        while (!link1.empty())
+        {
+            REQUIRE(channel2.Receive(link1.front().data(), link1.front().size(), timestamp));
+            link1.pop_front();
+        }
+
+        channel2.Flush(timestamp);
+        while (!link2.empty())
+        {
+            REQUIRE(channel1.Receive(link2.front().data(), link2.front().size(), timestamp));
+            link2.pop_front();
+        }
+    }
+
+    // Check all messages are delivered in order
+    REQUIRE(channel1.messages_pending() == 0);
+    REQUIRE(channel1.messages_retransmitted() > 0);
+    REQUIRE(channel2.messages == expected);
+}
+
+TEST_CASE("Reliable UDP channel peer restart test", "[CppServer][RUDP]")
+{
+    std::deque<std::vector<uint8_t>> link1;
+    std::deque<std::vector<uint8_t>> link2;
+
+    LossyChannel channel1(link1, 0);
+    LossyChannel channel2(link2, 0);
+
+    // Exchange datagrams between channels
+    uint64_t timestamp = 0;
+    auto exchange = [&]()
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            timestamp += 1000000;
+
+            channel1.Flush(timestamp);
+            while (!link1.empty())
+            {
+                REQUIRE(channel2.Receive(link1.front().data(), link1.front().size(), timestamp));
+                link1.pop_front();
+            }
+
+            channel2.Flush(timestamp);
+            while (!link2.empty())
+            {
+                REQUIRE(channel1.Receive(link2.front().data(), link2.front().size(), timestamp));
+                link2.pop_front();
+            }
+        }
+    };
+
+    for (int i = 0; i < 10; ++i)
+        REQUIRE(channel1.SendReliable("before", 6));
+    exchange();
+    REQUIRE(channel2.messages.size() == 10);
+
+    // Keep a late datagram of the first incarnation
+    REQUIRE(channel1.SendReliable("late", 4));
+    channel1.Flush(timestamp);
+    REQUIRE(link1.size() == 1);
+    std::vector<uint8_t> late(link1.front());
+    link1.clear();
+
+    // Keep unacknowledged and queued messages of the second channel
+    REQUIRE(channel2.SendReliable("lost", 4));
+    REQUIRE(channel2.SendReliable("lost", 4));
+    channel2.Flush(timestamp);
+    link2.clear();
+    REQUIRE(channel2.SendReliable("queued", 6));
+    REQUIRE(channel2.messages_pending() == 3);
+
+    // Restart the first channel, its sequences start from zero again
+    channel1.Reset();
+    for (int i = 0; i < 5; ++i)
+        REQUIRE(channel1.SendReliable("after", 5));
+    exchange();
+
+    // Check new messages are delivered after the peer restart
+    REQUIRE(channel1.messages_pending() == 0);
+    REQUIRE(channel2.peer_resets() == 1);
+    REQUIRE(channel2.messages.size() == 15);
+    REQUIRE(channel2.messages.back() == "after");
+
+    // Check messages pending for the previous incarnation are reported as dropped
+    REQUIRE(channel2.messages_pending() == 0);
+    REQUIRE(channel2.messages_dropped() == 3);
+    REQUIRE(channel2.dropped == std::vector<std::string>({ "lost", "lost", "queued" }));
+    REQUIRE(channel1.messages.empty());
+
+    // Check the late datagram of the previous incarnation is ignored
+    REQUIRE(channel2.Receive(late.data(), late.size(), timestamp));
+    REQUIRE(channel2.messages.size() == 15);
+    REQUIRE(channel2.peer_resets() == 1);
+}
+
+TEST_CASE("Reliable UDP server test", "[CppServer][RUDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3341;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server
+    auto server = std::make_shared<EchoRUDPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client
+    auto client = std::make_shared<EchoRUDPClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Send reliable messages to the Echo server
+    for (int i = 0; i < 100; ++i)
+        REQUIRE(client->SendReliable("test"));
+
+    // Wait for all messages echoed...
+    while (client->received != 400)
+        Thread::Yield();
+
+    // Disconnect the Echo client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(server->started);
+    REQUIRE(server->stopped);
+    REQUIRE(server->connected == 1);
+    REQUIRE(server->disconnected == 1);
+    REQUIRE(!server->errors);
+
+    // Check the Echo client state
+    REQUIRE(client->connected);
+    REQUIRE(client->disconnected);
+    REQUIRE(client->messages_sent() == 100);
+    REQUIRE(client->messages_received() == 100);
+    REQUIRE(!client->errors);
+}
+
+TEST_CASE("Reliable UDP client pending limit test", "[CppServer][RUDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3352;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and connect the client without the server
+    auto client = std::make_shared<EchoRUDPClient>(service, address, port);
+    client->SetupMaxPending(10);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Unacknowledged messages should fill the pending limit
+    for (int i = 0; i < 10; ++i)
+        REQUIRE(client->SendReliable("test"));
+    REQUIRE(!client->SendReliable("test"));
+    REQUIRE(client->messages_pending() == 10);
+
+    // Disconnect the client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+}
@@ -5,7 +5,9 @@
 #include "test.h"
 
 #include "server/asio/ssl_client.h"
+#include "server/asio/ssl_client_pool.h"
 #include "server/asio/ssl_server.h"
+#include "server/asio/tcp_server.h"
 #include "threads/thread.h"
 
 #include <atomic>
@@ -67,6 +69,32 @@ public:
     std::atomic<bool> errors{false};
 };
 
+class TimeoutSSLClient : public EchoSSLClient
+{
+public:
+    using EchoSSLClient::EchoSSLClient;
+
+protected:
+    void onDisconnected() override
+    {
+        // Timed out error should be reported before the client is disconnected
+        if (timeouts > 0)
+            ++timed_out_disconnects;
+        disconnected = true;
+    }
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        if (error == asio::error::timed_out)
+            ++timeouts;
+        else
+            errors = true;
+    }
+
+public:
+    std::atomic<size_t> timeouts{0};
+    std::atomic<size_t> timed_out_disconnects{0};
+};
+
 class EchoSSLSession : public SSLSession
 {
 public:
@@ -122,6 +150,18 @@ public:
     std::atomic<bool> errors{false};
 };
 
+class EchoSSLClientPool : public SSLClientPool<EchoSSLClient>
+{
+public:
+    using SSLClientPool<EchoSSLClient>::SSLClientPool;
+
+protected:
+    bool onHealthCheck(EchoSSLClient& client) override { ++checks; return SSLClientPool<EchoSSLClient>::onHealthCheck(client); }
+
+public:
+    std::atomic<size_t> checks{0};
+};
+
 } // namespace
 
 TEST_CASE("SSL server test", "[CppServer][SSL]")
@@ -469,3 +509,192 @@ TEST_CASE("SSL server random test", "[CppServer][SSL]")
     REQUIRE(server->bytes_received() > 0);
     REQUIRE(!server->errors);
 }
+
+TEST_CASE("SSL client pool test", "[CppServer][SSL]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 2225;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoSSLService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and prepare a new SSL server context
+    auto server_context = EchoSSLServer::CreateContext();
+
+    // Create and start Echo server
+    auto server = std::make_shared<EchoSSLServer>(service, server_context, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and prepare a new SSL client context
+    auto client_context = EchoSSLClient::CreateContext();
+
+    // Create and start Echo client pool with two warmed up clients
+    auto pool = std::make_shared<EchoSSLClientPool>(service, client_context, address, port, 2, 3);
+    pool->SetupIdleTimeout(Timespan::milliseconds(100));
+    pool->SetupHealthCheckInterval(Timespan::milliseconds(10));
+    REQUIRE(pool->Start());
+    while ((pool->idle() != 2) || (server->clients != 2))
+        Thread::Yield();
+
+    // Wait for idle clients to be checked
+    while (pool->checks == 0)
+        Thread::Yield();
+
+    // Lease all idle clients
+    auto client1 = pool->TryLease();
+    auto client2 = pool->TryLease();
+    REQUIRE(client1);
+    REQUIRE(client2);
+    REQUIRE(client1->IsHandshaked());
+    REQUIRE(client2->IsHandshaked());
+    REQUIRE(pool->leased() == 2);
+
+    // Lease the third client connected and handshaked on demand
+    std::atomic<bool> leased{false};
+    std::shared_ptr<EchoSSLClient> client3;
+    pool->LeaseAsync([&leased, &client3](std::shared_ptr<EchoSSLClient> client) { client3 = client; leased = true; });
+    while (!leased)
+        Thread::Yield();
+    REQUIRE(client3);
+    REQUIRE(client3->IsHandshaked());
+    REQUIRE(pool->size() == 3);
+
+    // Lease above the maximal count waits for the returned client
+    leased = false;
+    std::shared_ptr<EchoSSLClient> client4;
+    pool->LeaseAsync([&leased, &client4](std::shared_ptr<EchoSSLClient> client) { client4 = client; leased = true; });
+    REQUIRE(!leased);
+    pool->Return(client1);
+    while (!leased)
+        Thread::Yield();
+    REQUIRE(client4 == client1);
+
+    // Lease above the maximal count fails when the lease timeout expires
+    leased = false;
+    std::shared_ptr<EchoSSLClient> client5;
+    pool->LeaseAsync([&leased, &client5](std::shared_ptr<EchoSSLClient> client) { client5 = client; leased = true; }, Timespan::milliseconds(10));
+    while (!leased)
+        Thread::Yield();
+    REQUIRE(!client5);
+
+    // Send a message to the Echo server with the leased client
+    client2->SendAsync("test");
+    while (client2->bytes_received() != 4)
+        Thread::Yield();
+
+    // Return all leased clients
+    pool->Return(client2);
+    pool->Return(client3);
+    pool->Return(client4);
+    REQUIRE(pool->leased() == 0);
+
+    // Wait for idle clients above the minimal count to be disconnected
+    while ((pool->size() != 2) || (server->clients != 2))
+        Thread::Yield();
+
+    // Stop the Echo client pool
+    REQUIRE(pool->Stop());
+    REQUIRE(pool->size() == 0);
+    while (server->clients != 0)
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(!server->errors);
+}
+
+TEST_CASE("SSL client handshake timeout test", "[CppServer][SSL]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 2226;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoSSLService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start plain TCP server which accepts connections and never replies
+    auto silent = std::make_shared<TCPServer>(service, port);
+    silent->SetupReuseAddress(true);
+    REQUIRE(silent->Start());
+    while (!silent->IsStarted())
+        Thread::Yield();
+
+    // Create and prepare a new SSL client context
+    auto client_context = EchoSSLClient::CreateContext();
+
+    // Connect the client which never receives the server handshake
+    auto client = std::make_shared<TimeoutSSLClient>(service, client_context, address, port);
+    client->SetupHandshakeTimeout(Timespan::milliseconds(100));
+    REQUIRE(client->ConnectAsync());
+    while (!client->disconnected)
+        Thread::Yield();
+
+    // Check the handshake is timed out and the client is disconnected after the error
+    REQUIRE(client->connected);
+    REQUIRE(!client->handshaked);
+    REQUIRE(!client->IsConnected());
+    REQUIRE(!client->IsHandshaked());
+    REQUIRE(client->timeouts == 1);
+    REQUIRE(client->timed_out_disconnects == 1);
+    REQUIRE(!client->errors);
+
+    // Replace the plain TCP server with the Echo server on the same port
+    REQUIRE(silent->Stop());
+    while (silent->IsStarted())
+        Thread::Yield();
+    auto server = std::make_shared<EchoSSLServer>(service, EchoSSLServer::CreateContext(), port);
+    server->SetupReuseAddress(true);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Reconnect the timed out client with the new SSL stream
+    client->disconnected = false;
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsHandshaked() || (server->clients != 1))
+        Thread::Yield();
+
+    // Send a message to the Echo server
+    client->SendAsync("test");
+    while (client->bytes_received() != 4)
+        Thread::Yield();
+
+    // Disconnect the client
+    client->disconnected = false;
+    REQUIRE(client->DisconnectAsync());
+    while (!client->disconnected || (server->clients != 0))
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server and client state
+    REQUIRE(!server->errors);
+    REQUIRE(client->handshaked);
+    REQUIRE(client->disconnected);
+    REQUIRE(client->timeouts == 1);
+    REQUIRE(!client->errors);
+}
@@ -4,12 +4,17 @@
 
 #include "test.h"
 
+#include "server/asio/framed.h"
 #include "server/asio/tcp_client.h"
+#include "server/asio/tcp_client_pool.h"
 #include "server/asio/tcp_server.h"
 #include "threads/thread.h"
 
 #include <atomic>
 #include <chrono>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <vector>
 
 using namespace CppCommon;
@@ -55,6 +60,32 @@ public:
     std::atomic<bool> errors{false};
 };
 
+class TimeoutTCPClient : public EchoTCPClient
+{
+public:
+    using EchoTCPClient::EchoTCPClient;
+
+protected:
+    void onDisconnected() override
+    {
+        // Timed out error should be reported before the client is disconnected
+        if (timeouts > 0)
+            ++timed_out_disconnects;
+        disconnected = true;
+    }
+    void onError(int error, const std::string& category, const std::string& message) override
+    {
+        if (error == asio::error::timed_out)
+            ++timeouts;
+        else
+            errors = true;
+    }
+
+public:
+    std::atomic<size_t> timeouts{0};
+    std::atomic<size_t> timed_out_disconnects{0};
+};
+
 class EchoTCPSession : public TCPSession
 {
 public:
@@ -96,6 +127,73 @@ public:
     std::atomic<bool> errors{false};
 };
 
+class FramedEchoTCPClient : public Framed<TCPClient>
+{
+public:
+    using Framed<TCPClient>::Framed;
+
+protected:
+    void onMessage(const void* buffer, size_t size) override
+    {
+        std::scoped_lock locker(lock);
+        messages.emplace_back((const char*)buffer, size);
+    }
+    void onMessageError(const std::string& error) override { errors = true; }
+
+public:
+    std::mutex lock;
+    std::vector<std::string> messages;
+    std::atomic<bool> errors{false};
+};
+
+class FramedEchoTCPSession : public Framed<TCPSession>
+{
+public:
+    using Framed<TCPSession>::Framed;
+
+protected:
+    void onMessage(const void* buffer, size_t size) override { SendMessageAsync(buffer, size); }
+};
+
+class FramedEchoTCPServer : public TCPServer
+{
+public:
+    using TCPServer::TCPServer;
+
+protected:
+    std::shared_ptr<TCPSession> CreateSession(std::shared_ptr<TCPServer> server) override { return std::make_shared<FramedEchoTCPSession>(server); }
+};
+
+class CompressedFramedEchoTCPSession : public FramedEchoTCPSession
+{
+public:
+    explicit CompressedFramedEchoTCPSession(std::shared_ptr<TCPServer> server) : FramedEchoTCPSession(server)
+    {
+        compression().SetupDeflate();
+        compression().SetupContextTakeover(false);
+    }
+
+protected:
+    void onMessage(const void* buffer, size_t size) override
+    {
+        // Multicast the message compressed once for all sessions
+        std::vector<uint8_t> message;
+        if ((std::string_view((const char*)buffer, size) == "multicast") && PrepareMessage(buffer, size, message))
+            server()->Multicast(message.data(), message.size());
+        else
+            FramedEchoTCPSession::onMessage(buffer, size);
+    }
+};
+
+class CompressedFramedEchoTCPServer : public TCPServer
+{
+public:
+    using TCPServer::TCPServer;
+
+protected:
+    std::shared_ptr<TCPSession> CreateSession(std::shared_ptr<TCPServer> server) override { return std::make_shared<CompressedFramedEchoTCPSession>(server); }
+};
+
 } // namespace
 
 TEST_CASE("TCP server test", "[CppServer][TCP]")
@@ -421,3 +519,624 @@ TEST_CASE("TCP server random test", "[CppServer][TCP]")
     REQUIRE(server->bytes_received() > 0);
     REQUIRE(!server->errors);
 }
+
+TEST_CASE("TCP resolver DNS cache test", "[CppServer][TCP]")
+{
+    const std::string address = "127.0.0.1";
+    const std::string port = "1111";
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create TCP resolver
+    auto resolver = std::make_shared<TCPResolver>(service);
+
+    // Resolve the same endpoint concurrently
+    std::atomic<size_t> resolved(0);
+    std::atomic<size_t> errors(0);
+    for (int i = 0; i < 10; ++i)
+    {
+        resolver->ResolveAsync(address, port, [&resolved, &errors](std::error_code ec, asio::ip::tcp::resolver::results_type endpoints)
+        {
+            if (ec || endpoints.empty())
+                ++errors;
+            ++resolved;
+        });
+    }
+    while (resolved != 10)
+        Thread::Yield();
+
+    // Check concurrent lookups were coalesced into the single cache entry
+    REQUIRE(errors == 0);
+    REQUIRE(resolver->cache_size() == 1);
+
+    // Resolve the cached endpoint synchronously
+    asio::error_code ec;
+    auto endpoints = resolver->Resolve(address, port, ec);
+    REQUIRE(!ec);
+    REQUIRE(endpoints.begin()->endpoint().port() == 1111);
+    REQUIRE(resolver->cache_size() == 1);
+
+    // Clear the DNS cache
+    resolver->ClearCache();
+    REQUIRE(resolver->cache_size() == 0);
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+}
+
+TEST_CASE("TCP resolver cancel test", "[CppServer][TCP]")
+{
+    const std::string address = "127.0.0.1";
+    const std::string port = "1111";
+
+    // Create Asio service without starting it, so the lookup stays pending
+    auto service = std::make_shared<Service>();
+
+    // Create TCP resolver
+    auto resolver = std::make_shared<TCPResolver>(service);
+
+    // Coalesce two lookups of the same endpoint
+    std::atomic<size_t> resolved(0);
+    std::atomic<size_t> canceled(0);
+    auto handler = [&resolved, &canceled](std::error_code ec, asio::ip::tcp::resolver::results_type endpoints)
+    {
+        if (ec == asio::error::operation_aborted)
+            ++canceled;
+        else if (!ec && !endpoints.empty())
+            ++resolved;
+    };
+    uint64_t waiter = resolver->ResolveAsync(address, port, handler);
+    REQUIRE(resolver->ResolveAsync(address, port, handler) != waiter);
+
+    // Cancel only the first waiter
+    REQUIRE(resolver->Cancel(waiter));
+    REQUIRE(!resolver->Cancel(waiter));
+
+    // Start Asio service
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Wait for both lookups completed...
+    while ((resolved + canceled) != 2)
+        Thread::Yield();
+
+    // Check the second waiter was not aborted
+    REQUIRE(canceled == 1);
+    REQUIRE(resolved == 1);
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+}
+
+TEST_CASE("TCP client happy eyeballs test", "[CppServer][TCP]")
+{
+    const std::string address = "localhost";
+    const int port = 1111;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoTCPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server listening only IPv4 addresses
+    auto server = std::make_shared<EchoTCPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client racing all resolved endpoints
+    auto resolver = std::make_shared<TCPResolver>(service);
+    auto client = std::make_shared<EchoTCPClient>(service, address, std::to_string(port));
+    client->SetupHappyEyeballs(true);
+    client->SetupConnectionAttemptDelay(Timespan::milliseconds(50));
+    REQUIRE(client->ConnectAsync(resolver));
+    while (!client->IsConnected() || (server->clients != 1))
+        Thread::Yield();
+
+    // Check the client is connected to the IPv4 endpoint
+    REQUIRE(client->endpoint().address().is_v4());
+
+    // Send a message to the Echo server
+    client->SendAsync("test");
+
+    // Wait for all data processed...
+    while (client->bytes_received() != 4)
+        Thread::Yield();
+
+    // Disconnect the Echo client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected() || (server->clients != 0))
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo client state
+    REQUIRE(client->connected);
+    REQUIRE(!server->errors);
+}
+
+#if defined(__linux__)
+TEST_CASE("TCP client connect timeout test", "[CppServer][TCP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 1115;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoTCPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create listening socket which never accepts connections (Linux drops
+    // connection requests when the accept queue is full, so they are never
+    // answered)
+    asio::ip::tcp::endpoint endpoint(asio::ip::make_address(address), (unsigned short)port);
+    asio::ip::tcp::acceptor acceptor(*service->GetAsioService());
+    acceptor.open(endpoint.protocol());
+    acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+    acceptor.bind(endpoint);
+    acceptor.listen(0);
+
+    // Fill the accept queue with the first connection
+    auto filler = std::make_shared<EchoTCPClient>(service, address, port);
+    REQUIRE(filler->ConnectAsync());
+    while (!filler->IsConnected())
+        Thread::Yield();
+
+    // Connect the client which never completes the connect
+    auto client = std::make_shared<TimeoutTCPClient>(service, address, port);
+    client->SetupConnectTimeout(Timespan::milliseconds(100));
+    REQUIRE(client->ConnectAsync());
+    while (!client->disconnected)
+        Thread::Yield();
+
+    // Check the connect is timed out and the client is disconnected after the error
+    REQUIRE(!client->connected);
+    REQUIRE(!client->IsConnected());
+    REQUIRE(client->timeouts == 1);
+    REQUIRE(client->timed_out_disconnects == 1);
+    REQUIRE(!client->errors);
+
+    // Disconnect the filler client
+    REQUIRE(filler->DisconnectAsync());
+    while (filler->IsConnected())
+        Thread::Yield();
+
+    // Close the listening socket
+    acceptor.close();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the connect timeout was reported only once
+    REQUIRE(client->timeouts == 1);
+    REQUIRE(!filler->errors);
+}
+#endif
+
+TEST_CASE("TCP client pool test", "[CppServer][TCP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 1111;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoTCPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server
+    auto server = std::make_shared<EchoTCPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo client pool with two warmed up clients
+    auto pool = std::make_shared<TCPClientPool<EchoTCPClient>>(service, address, port, 2, 3);
+    pool->SetupIdleTimeout(Timespan::milliseconds(100));
+    pool->SetupHealthCheckInterval(Timespan::milliseconds(10));
+    REQUIRE(pool->Start());
+    while ((pool->idle() != 2) || (server->clients != 2))
+        Thread::Yield();
+
+    // Lease all idle clients
+    auto client1 = pool->TryLease();
+    auto client2 = pool->TryLease();
+    REQUIRE(client1);
+    REQUIRE(client2);
+    REQUIRE(pool->leased() == 2);
+
+    // Lease the third client connected on demand
+    std::atomic<bool> leased{false};
+    std::shared_ptr<EchoTCPClient> client3;
+    pool->LeaseAsync([&leased, &client3](std::shared_ptr<EchoTCPClient> client) { client3 = client; leased = true; });
+    while (!leased)
+        Thread::Yield();
+    REQUIRE(client3);
+    REQUIRE(pool->size() == 3);
+
+    // Lease above the maximal count waits for the returned client
+    leased = false;
+    std::shared_ptr<EchoTCPClient> client4;
+    pool->LeaseAsync([&leased, &client4](std::shared_ptr<EchoTCPClient> client) { client4 = client; leased = true; });
+    REQUIRE(!leased);
+    pool->Return(client1);
+    while (!leased)
+        Thread::Yield();
+    REQUIRE(client4 == client1);
+
+    // Lease above the maximal count fails when the lease timeout expires
+    leased = false;
+    std::shared_ptr<EchoTCPClient> client5;
+    pool->LeaseAsync([&leased, &client5](std::shared_ptr<EchoTCPClient> client) { client5 = client; leased = true; }, Timespan::milliseconds(10));
+    while (!leased)
+        Thread::Yield();
+    REQUIRE(!client5);
+
+    // Send a message to the Echo server with the leased client
+    client2->SendAsync("test");
+    while (client2->bytes_received() != 4)
+        Thread::Yield();
+
+    // Return all leased clients
+    pool->Return(client2);
+    pool->Return(client3);
+    pool->Return(client4);
+    REQUIRE(pool->leased() == 0);
+
+    // Wait for idle clients above the minimal count to be disconnected
+    while ((pool->size() != 2) || (server->clients != 2))
+        Thread::Yield();
+
+    // Stop the Echo client pool
+    REQUIRE(pool->Stop());
+    REQUIRE(pool->size() == 0);
+    while (server->clients != 0)
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(!server->errors);
+}
+
+TEST_CASE("TCP client reconnect test", "[CppServer][TCP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 1111;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoTCPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server
+    auto server = std::make_shared<EchoTCPServer>(service, port);
+    server->SetupReuseAddress(true);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client with automatic reconnect
+    auto client = std::make_shared<EchoTCPClient>(service, address, port);
+    client->SetupReconnect(true);
+    client->SetupReconnectDelay(Timespan::milliseconds(10));
+    client->SetupReconnectMaxDelay(Timespan::milliseconds(100));
+    client->SetupReconnectPreserve(true);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected() || (server->clients != 1))
+        Thread::Yield();
+
+    // Disconnect the Echo client by the server and wait for reconnect
+    server->DisconnectAll();
+    while (!client->disconnected)
+        Thread::Yield();
+    while (!client->IsConnected() || (server->clients != 1))
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted() || client->IsConnected())
+        Thread::Yield();
+
+    // Send a message to the Echo server while the client is reconnecting
+    REQUIRE(client->SendAsync("test"));
+
+    // Restart the Echo server and wait for the preserved message
+    REQUIRE(server->Start());
+    while (client->bytes_received() != 4)
+        Thread::Yield();
+
+    // Disconnect the Echo client and check the automatic reconnect is stopped
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected() || (server->clients != 0))
+        Thread::Yield();
+    Thread::Sleep(200);
+    REQUIRE(!client->IsConnected());
+    REQUIRE(server->clients == 0);
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(!server->errors);
+}
+
+TEST_CASE("TCP message framing test", "[CppServer][TCP]")
+{
+    // Frame messages and receive them byte by byte and as a whole
+    auto check = [](MessageFraming& framing)
+    {
+        std::vector<uint8_t> stream;
+        REQUIRE(framing.Frame("first", 5, stream));
+        REQUIRE(framing.Frame("", 0, stream));
+        REQUIRE(framing.Frame("second message", 14, stream));
+
+        std::vector<std::string> messages;
+        auto handler = [&messages](const void* buffer, size_t size) { messages.emplace_back((const char*)buffer, size); };
+        for (size_t i = 0; i < stream.size(); ++i)
+            REQUIRE(framing.Receive(stream.data() + i, 1, handler));
+        REQUIRE(framing.Receive(stream.data(), stream.size(), handler));
+        REQUIRE(framing.pending() == 0);
+
+        REQUIRE(messages == std::vector<std::string>({ "first", "", "second message", "first", "", "second message" }));
+    };
+
+    MessageFraming framing;
+    check(framing);
+    framing.SetupLengthPrefix(2, MessageFraming::Endian::Little);
+    check(framing);
+    framing.SetupLengthPrefix(8);
+    check(framing);
+    framing.SetupDelimiter("\r\n");
+    check(framing);
+
+    // Check the maximal message size
+    std::vector<uint8_t> stream;
+    framing.SetupLengthPrefix(1);
+    framing.SetupMaxMessageSize(4);
+    REQUIRE(!framing.Frame(std::string(256, 'x').data(), 256, stream));
+    REQUIRE(framing.Frame("large", 5, stream));
+    REQUIRE(!framing.Receive(stream.data(), stream.size(), [](const void* buffer, size_t size) {}));
+    REQUIRE(framing.error());
+}
+
+TEST_CASE("TCP framed client test", "[CppServer][TCP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 1111;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoTCPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server
+    auto server = std::make_shared<FramedEchoTCPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client
+    auto client = std::make_shared<FramedEchoTCPClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected() || (server->connected_sessions() != 1))
+        Thread::Yield();
+
+    // Send framed messages to the Echo server
+    REQUIRE(client->SendMessageAsync("test"));
+    REQUIRE(client->SendMessageAsync(std::string(100000, 'x')));
+    REQUIRE(client->SendMessageAsync("done"));
+
+    // Wait for all messages echoed...
+    while (true)
+    {
+        {
+            std::scoped_lock locker(client->lock);
+            if (client->messages.size() == 3)
+                break;
+        }
+        Thread::Yield();
+    }
+
+    REQUIRE(client->messages[0] == "test");
+    REQUIRE(client->messages[1] == std::string(100000, 'x'));
+    REQUIRE(client->messages[2] == "done");
+
+    // Disconnect the Echo client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected() || (server->connected_sessions() != 0))
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo client state
+    REQUIRE(!client->errors);
+}
+
+#if defined(CPPSERVER_ZLIB)
+TEST_CASE("TCP message compression test", "[CppServer][TCP]")
+{
+    std::string dictionary = "{\"symbol\":\"EURUSD\",\"price\":1.0,\"volume\":100}";
+    std::string message = "{\"symbol\":\"EURUSD\",\"price\":1.0842,\"volume\":250}";
+    std::string large;
+    for (size_t i = 0; i < 1000; ++i)
+        large += message;
+
+    // Compress messages with context takeover
+    MessageCompression sender;
+    MessageCompression receiver;
+    sender.SetupDeflate();
+    receiver.SetupDeflate();
+    std::string first;
+    std::string second;
+    std::string decompressed;
+    REQUIRE(sender.Compress(large.data(), large.size(), first));
+    REQUIRE(sender.Compress(large.data(), large.size(), second));
+    REQUIRE(first.size() < large.size() / 10);
+    REQUIRE(second.size() < first.size());
+    REQUIRE(receiver.Decompress(first.data(), first.size(), decompressed));
+    REQUIRE(decompressed == large);
+    decompressed.clear();
+    REQUIRE(receiver.Decompress(second.data(), second.size(), decompressed));
+    REQUIRE(decompressed == large);
+
+    // Compress the message once without context takeover with and without the preset dictionary
+    MessageCompression multicast;
+    multicast.SetupDeflate(9);
+    multicast.SetupContextTakeover(false);
+    std::string plain;
+    REQUIRE(multicast.Compress(message.data(), message.size(), plain));
+    multicast.SetupDictionary(dictionary);
+    std::string compressed;
+    REQUIRE(multicast.Compress(message.data(), message.size(), compressed));
+    REQUIRE(compressed.size() < plain.size());
+
+    // Decompress the same compressed message with independent receivers
+    for (size_t i = 0; i < 3; ++i)
+    {
+        MessageCompression peer;
+        peer.SetupDeflate();
+        peer.SetupContextTakeover(false);
+        peer.SetupDictionary(dictionary);
+        for (size_t j = 0; j < 2; ++j)
+        {
+            decompressed.clear();
+            REQUIRE(peer.Decompress(compressed.data(), compressed.size(), decompressed));
+            REQUIRE(decompressed == message);
+        }
+    }
+
+    // Decompressing stops after the limit, invalid compressed message is the error
+    MessageCompression limited;
+    limited.SetupDeflate();
+    decompressed.clear();
+    REQUIRE(limited.Decompress(first.data(), first.size(), decompressed, 100));
+    REQUIRE(decompressed.size() > 100);
+    REQUIRE(decompressed.size() < large.size());
+    decompressed.clear();
+    REQUIRE(!limited.Decompress("\xFF\xFF\xFF", 3, decompressed));
+}
+
+TEST_CASE("TCP framed compression test", "[CppServer][TCP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 1114;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoTCPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server
+    auto server = std::make_shared<CompressedFramedEchoTCPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo clients with the same compression
+    std::vector<std::shared_ptr<FramedEchoTCPClient>> clients;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        auto client = std::make_shared<FramedEchoTCPClient>(service, address, port);
+        client->compression().SetupDeflate();
+        client->compression().SetupContextTakeover(false);
+        REQUIRE(client->ConnectAsync());
+        while (!client->IsConnected() || (server->connected_sessions() != (i + 1)))
+            Thread::Yield();
+        clients.emplace_back(client);
+    }
+
+    // Send compressed messages to the Echo server and multicast the message to all clients
+    auto client = clients.front();
+    REQUIRE(client->SendMessageAsync("test"));
+    REQUIRE(client->SendMessageAsync(std::string(100000, 'x')));
+    REQUIRE(client->SendMessageAsync("multicast"));
+
+    // Wait for all messages echoed and multicast...
+    for (auto& current : clients)
+    {
+        size_t count = (current == client) ? 3 : 1;
+        while (true)
+        {
+            {
+                std::scoped_lock locker(current->lock);
+                if (current->messages.size() == count)
+                    break;
+            }
+            Thread::Yield();
+        }
+    }
+
+    REQUIRE(client->messages[0] == "test");
+    REQUIRE(client->messages[1] == std::string(100000, 'x'));
+    for (auto& current : clients)
+        REQUIRE(current->messages.back() == "multicast");
+
+    // Disconnect the Echo clients
+    for (auto& current : clients)
+        REQUIRE(current->DisconnectAsync());
+    while (server->connected_sessions() != 0)
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo clients state
+    for (auto& current : clients)
+        REQUIRE(!current->errors);
+}
+#endif
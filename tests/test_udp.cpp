@@ -5,11 +5,14 @@
 #include "test.h"
 
 #include "server/asio/udp_client.h"
+#include "server/asio/udp_resolver.h"
 #include "server/asio/udp_server.h"
 #include "threads/thread.h"
 
 #include <atomic>
 #include <chrono>
+#include <mutex>
+#include <set>
 #include <vector>
 
 using namespace CppCommon;
@@ -56,30 +59,552 @@ public:
     std::atomic<bool> errors{false};
 };
 
+class DisconnectingUDPClient : public EchoUDPClient
+{
+public:
+    using EchoUDPClient::EchoUDPClient;
+
+protected:
+    void onConnected() override
+    {
+        EchoUDPClient::onConnected();
+
+        // Queue a bunch of datagrams to be sent in one batch
+        for (int i = 0; i < 16; ++i)
+            SendAsync("test");
+    }
+
+    void onSent(const asio::ip::udp::endpoint& endpoint, size_t sent) override
+    {
+        // The first datagram is sent alone and the rest are sent in the next batch,
+        // so disconnect from the handler of the first datagram in that batch
+        if (++sent_handled == 2)
+            Disconnect();
+    }
+
+public:
+    std::atomic<size_t> sent_handled{0};
+};
+
 class EchoUDPServer : public UDPServer
 {
 public:
     using UDPServer::UDPServer;
 
-protected:
-    void onStarted() override { started = true; ReceiveAsync(); }
-    void onStopped() override { stopped = true; }
-    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override { SendAsync(endpoint, buffer, size); }
-    void onSent(const asio::ip::udp::endpoint& endpoint, size_t sent) override { ReceiveAsync(); }
-    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+protected:
+    void onStarted() override { started = true; ReceiveAsync(); }
+    void onStopped() override { stopped = true; }
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override { SendAsync(endpoint, buffer, size); }
+    void onSent(const asio::ip::udp::endpoint& endpoint, size_t sent) override { ReceiveAsync(); }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> started{false};
+    std::atomic<bool> stopped{false};
+    std::atomic<bool> errors{false};
+};
+
+class CountingUDPServer : public UDPServer
+{
+public:
+    using UDPServer::UDPServer;
+
+protected:
+    void onStarted() override { started = true; ReceiveAsync(); }
+    void onStopped() override { stopped = true; }
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override { ReceiveAsync(); }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> started{false};
+    std::atomic<bool> stopped{false};
+    std::atomic<bool> errors{false};
+};
+
+class CoalescingUDPServer : public CountingUDPServer
+{
+public:
+    using CountingUDPServer::CountingUDPServer;
+
+protected:
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override
+    {
+        // Segments of the coalesced buffer follow each other in the receive buffer
+        if ((size > 0) && ((const uint8_t*)buffer == (_last + _last_size)))
+            ++coalesced;
+        _last = (const uint8_t*)buffer;
+        _last_size = size;
+        if (size != 4)
+            segmented = false;
+        CountingUDPServer::onReceived(endpoint, buffer, size);
+    }
+
+public:
+    std::atomic<size_t> coalesced{0};
+    std::atomic<bool> segmented{true};
+
+private:
+    const uint8_t* _last{nullptr};
+    size_t _last_size{0};
+};
+
+class GroupUDPServer : public CountingUDPServer
+{
+public:
+    using CountingUDPServer::CountingUDPServer;
+
+    size_t sockets()
+    {
+        std::scoped_lock locker(_lock);
+        return _buffers.size();
+    }
+
+protected:
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override
+    {
+        // Each socket of the group receives datagrams into its own buffer
+        {
+            std::scoped_lock locker(_lock);
+            _buffers.insert(buffer);
+        }
+        CountingUDPServer::onReceived(endpoint, buffer, size);
+    }
+
+private:
+    std::mutex _lock;
+    std::set<const void*> _buffers;
+};
+
+class EchoUDPSession : public UDPSession
+{
+public:
+    using UDPSession::UDPSession;
+
+protected:
+    void onReceived(const void* buffer, size_t size) override { SendAsync(buffer, size); }
+};
+
+class EchoUDPSessionServer : public UDPServer
+{
+public:
+    using UDPServer::UDPServer;
+
+protected:
+    std::shared_ptr<UDPSession> CreateSession(std::shared_ptr<UDPServer> server, const asio::ip::udp::endpoint& endpoint) override { return std::make_shared<EchoUDPSession>(server, endpoint); }
+
+protected:
+    void onStarted() override { started = true; }
+    void onStopped() override { stopped = true; }
+    void onConnected(std::shared_ptr<UDPSession>& session) override { ++connected; }
+    void onDisconnected(std::shared_ptr<UDPSession>& session) override { ++disconnected; }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> started{false};
+    std::atomic<bool> stopped{false};
+    std::atomic<size_t> connected{0};
+    std::atomic<size_t> disconnected{0};
+    std::atomic<bool> errors{false};
+};
+
+} // namespace
+
+TEST_CASE("UDP server test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3333;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server
+    auto server = std::make_shared<EchoUDPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client
+    auto client = std::make_shared<EchoUDPClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Send a message to the Echo server
+    client->Send("test");
+
+    // Wait for all data processed...
+    while (client->bytes_received() != 4)
+        Thread::Yield();
+
+    // Disconnect the Echo client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Asio service state
+    REQUIRE(service->thread_initialize);
+    REQUIRE(service->thread_cleanup);
+    REQUIRE(service->started);
+    REQUIRE(service->stopped);
+    REQUIRE(!service->idle);
+    REQUIRE(!service->errors);
+
+    // Check the Echo server state
+    REQUIRE(server->started);
+    REQUIRE(server->stopped);
+    REQUIRE(server->bytes_sent() == 4);
+    REQUIRE(server->bytes_received() == 4);
+    REQUIRE(!server->errors);
+
+    // Check the Echo client state
+    REQUIRE(client->connected);
+    REQUIRE(client->disconnected);
+    REQUIRE(client->bytes_sent() == 4);
+    REQUIRE(client->bytes_received() == 4);
+    REQUIRE(!client->errors);
+}
+
+TEST_CASE("UDP server batch receive test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3337;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start counting server with batched receive
+    auto server = std::make_shared<CountingUDPServer>(service, port);
+    server->SetupReceiveBatch(16);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client
+    auto client = std::make_shared<EchoUDPClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Send a bunch of datagrams to the counting server
+    for (int i = 0; i < 100; ++i)
+        client->Send("test");
+
+    // Wait for all datagrams received...
+    while (server->datagrams_received() != 100)
+        Thread::Yield();
+
+    // Disconnect the Echo client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the counting server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the counting server state
+    REQUIRE(server->started);
+    REQUIRE(server->stopped);
+    REQUIRE(server->datagrams_received() == 100);
+    REQUIRE(server->bytes_received() == 400);
+    REQUIRE(!server->errors);
+
+    // Check the Echo client state
+    REQUIRE(client->datagrams_sent() == 100);
+    REQUIRE(!client->errors);
+}
+
+TEST_CASE("UDP client batch send test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3338;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start counting server
+    auto server = std::make_shared<CountingUDPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client with batched send
+    auto client = std::make_shared<EchoUDPClient>(service, address, port);
+    client->SetupSendBatch(16);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Queue a bunch of datagrams without waiting for send completion
+    for (int i = 0; i < 100; ++i)
+        REQUIRE(client->SendAsync("test"));
+
+    // Wait for all datagrams sent and received...
+    while ((client->datagrams_sent() != 100) || (server->datagrams_received() != 100))
+        Thread::Yield();
+
+    // Disconnect the Echo client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the counting server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the counting server state
+    REQUIRE(server->datagrams_received() == 100);
+    REQUIRE(server->bytes_received() == 400);
+    REQUIRE(!server->errors);
+
+    // Check the Echo client state
+    REQUIRE(client->bytes_sent() == 400);
+    REQUIRE(client->bytes_pending() == 0);
+    REQUIRE(!client->errors);
+}
+
+TEST_CASE("UDP client batch send disconnect test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3353;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start counting server
+    auto server = std::make_shared<CountingUDPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect disconnecting client with batched send
+    auto client = std::make_shared<DisconnectingUDPClient>(service, address, port);
+    client->SetupSendBatch(16);
+    REQUIRE(client->ConnectAsync());
+
+    // Wait for the client disconnected from the sent handler...
+    while (!client->disconnected)
+        Thread::Yield();
+
+    // Stop the counting server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the disconnecting client state
+    REQUIRE(client->sent_handled == 2);
+    REQUIRE(!client->IsConnected());
+    REQUIRE(client->bytes_pending() == 0);
+    REQUIRE(!client->errors);
+}
+
+TEST_CASE("UDP client connected socket test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3344;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server
+    auto server = std::make_shared<EchoUDPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client with connected socket
+    auto client = std::make_shared<EchoUDPClient>(service, address, port);
+    client->SetupConnected(true);
+    client->SetupSendBatch(16);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Send datagrams to the Echo server
+    for (int i = 0; i < 100; ++i)
+        REQUIRE(client->SendAsync("test"));
+
+    // Wait for all datagrams echoed...
+    while (client->datagrams_received() != 100)
+        Thread::Yield();
+
+    // Create and connect foreign client
+    auto foreign = std::make_shared<EchoUDPClient>(service, address, port);
+    REQUIRE(foreign->ConnectAsync());
+    while (!foreign->IsConnected())
+        Thread::Yield();
+
+    // Datagrams from the foreign endpoint should be filtered out
+    asio::ip::udp::endpoint endpoint(asio::ip::make_address(address), client->socket().local_endpoint().port());
+    REQUIRE(foreign->Send(endpoint, "foreign") == 7);
+    Thread::Sleep(100);
+
+    // Disconnect clients
+    REQUIRE(foreign->DisconnectAsync());
+    while (foreign->IsConnected())
+        Thread::Yield();
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(server->datagrams_received() == 100);
+    REQUIRE(!server->errors);
+
+    // Check the Echo client state
+    REQUIRE(client->connected);
+    REQUIRE(client->disconnected);
+    REQUIRE(client->datagrams_sent() == 100);
+    REQUIRE(client->datagrams_received() == 100);
+    REQUIRE(client->bytes_received() == 400);
+    REQUIRE(!client->errors);
+}
+
+TEST_CASE("UDP client connected socket server restart test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3345;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server
+    auto server = std::make_shared<EchoUDPServer>(service, port);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo clients with connected sockets and plain or batched receive
+    auto client1 = std::make_shared<EchoUDPClient>(service, address, port);
+    client1->SetupConnected(true);
+    REQUIRE(client1->ConnectAsync());
+    auto client2 = std::make_shared<EchoUDPClient>(service, address, port);
+    client2->SetupConnected(true);
+    client2->SetupReceiveBatch(16);
+    REQUIRE(client2->ConnectAsync());
+    while (!client1->IsConnected() || !client2->IsConnected())
+        Thread::Yield();
+
+    // Send datagrams to the Echo server
+    REQUIRE(client1->SendAsync("test"));
+    REQUIRE(client2->SendAsync("test"));
+    while ((client1->datagrams_received() != 1) || (client2->datagrams_received() != 1))
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Send datagrams to the stopped server, so the kernel refuses them
+    for (int i = 0; i < 10; ++i)
+    {
+        REQUIRE(client1->SendAsync("test"));
+        REQUIRE(client2->SendAsync("test"));
+        Thread::Sleep(10);
+    }
 
-public:
-    std::atomic<bool> started{false};
-    std::atomic<bool> stopped{false};
-    std::atomic<bool> errors{false};
-};
+    // Clients should stay connected
+    REQUIRE(client1->IsConnected());
+    REQUIRE(client2->IsConnected());
 
-} // namespace
+    // Restart the Echo server
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
 
-TEST_CASE("UDP server test", "[CppServer][UDP]")
+    // Send datagrams to the restarted Echo server
+    REQUIRE(client1->SendAsync("test"));
+    REQUIRE(client2->SendAsync("test"));
+    while ((client1->datagrams_received() != 2) || (client2->datagrams_received() != 2))
+        Thread::Yield();
+
+    // Disconnect clients
+    REQUIRE(client1->DisconnectAsync());
+    REQUIRE(client2->DisconnectAsync());
+    while (client1->IsConnected() || client2->IsConnected())
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(!server->errors);
+
+    // Check Echo clients state
+    REQUIRE(client1->datagrams_received() == 2);
+    REQUIRE(client2->datagrams_received() == 2);
+    REQUIRE(!client1->errors);
+    REQUIRE(!client2->errors);
+}
+
+#if defined(__linux__)
+TEST_CASE("UDP client GSO test", "[CppServer][UDP]")
 {
     const std::string address = "127.0.0.1";
-    const int port = 3333;
+    const int port = 3339;
 
     // Create and start Asio service
     auto service = std::make_shared<EchoUDPService>();
@@ -87,31 +612,50 @@ TEST_CASE("UDP server test", "[CppServer][UDP]")
     while (!service->IsStarted())
         Thread::Yield();
 
-    // Create and start Echo server
-    auto server = std::make_shared<EchoUDPServer>(service, port);
+    // Create and start counting server
+    auto server = std::make_shared<CountingUDPServer>(service, port);
     REQUIRE(server->Start());
     while (!server->IsStarted())
         Thread::Yield();
 
-    // Create and connect Echo client
+    // Create and connect Echo client with 4 bytes GSO segments
     auto client = std::make_shared<EchoUDPClient>(service, address, port);
+    client->SetupGSO(4);
     REQUIRE(client->ConnectAsync());
     while (!client->IsConnected())
         Thread::Yield();
 
-    // Send a message to the Echo server
-    client->Send("test");
+    // Send one buffer which will be split into 10 datagrams
+    REQUIRE(client->Send(std::string(40, 'x')) == 40);
 
-    // Wait for all data processed...
-    while (client->bytes_received() != 4)
+    // Wait for all datagrams received...
+    while (server->datagrams_received() != 10)
         Thread::Yield();
 
-    // Disconnect the Echo client
+    // Create and connect Echo client with 4 bytes GSO segments through the resolver
+    auto resolver = std::make_shared<UDPResolver>(service);
+    auto resolved = std::make_shared<EchoUDPClient>(service, address, port);
+    resolved->SetupGSO(4);
+    REQUIRE(resolved->ConnectAsync(resolver));
+    while (!resolved->IsConnected())
+        Thread::Yield();
+
+    // Send one buffer which will be split into 10 more datagrams
+    REQUIRE(resolved->Send(std::string(40, 'x')) == 40);
+
+    // Wait for all datagrams received...
+    while (server->datagrams_received() != 20)
+        Thread::Yield();
+
+    // Disconnect Echo clients
     REQUIRE(client->DisconnectAsync());
     while (client->IsConnected())
         Thread::Yield();
+    REQUIRE(resolved->DisconnectAsync());
+    while (resolved->IsConnected())
+        Thread::Yield();
 
-    // Stop the Echo server
+    // Stop the counting server
     REQUIRE(server->Stop());
     while (server->IsStarted())
         Thread::Yield();
@@ -121,27 +665,150 @@ TEST_CASE("UDP server test", "[CppServer][UDP]")
     while (service->IsStarted())
         Thread::Yield();
 
-    // Check the Asio service state
-    REQUIRE(service->thread_initialize);
-    REQUIRE(service->thread_cleanup);
-    REQUIRE(service->started);
-    REQUIRE(service->stopped);
-    REQUIRE(!service->idle);
-    REQUIRE(!service->errors);
-
-    // Check the Echo server state
-    REQUIRE(server->started);
-    REQUIRE(server->stopped);
-    REQUIRE(server->bytes_sent() == 4);
-    REQUIRE(server->bytes_received() == 4);
+    // Check the counting server state
+    REQUIRE(server->datagrams_received() == 20);
+    REQUIRE(server->bytes_received() == 80);
     REQUIRE(!server->errors);
+    REQUIRE(!client->errors);
+    REQUIRE(!resolved->errors);
+}
 
-    // Check the Echo client state
-    REQUIRE(client->connected);
-    REQUIRE(client->disconnected);
-    REQUIRE(client->bytes_sent() == 4);
-    REQUIRE(client->bytes_received() == 4);
+TEST_CASE("UDP server GRO test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3348;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start coalescing server with GRO
+    auto server = std::make_shared<CoalescingUDPServer>(service, port);
+    server->SetupGRO(true);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client with 4 bytes GSO segments
+    auto client = std::make_shared<EchoUDPClient>(service, address, port);
+    client->SetupGSO(4);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Send one buffer which will be received as 10 coalesced datagrams over loopback
+    REQUIRE(client->Send(std::string(40, 'x')) == 40);
+
+    // Wait for all datagrams received...
+    while (server->datagrams_received() != 10)
+        Thread::Yield();
+
+    // Create and connect Echo client with invalid GSO segment size
+    auto invalid = std::make_shared<EchoUDPClient>(service, address, port);
+    invalid->SetupGSO(100000);
+    REQUIRE(invalid->ConnectAsync());
+    while (!invalid->IsConnected())
+        Thread::Yield();
+
+    // Disconnect Echo clients
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+    REQUIRE(invalid->DisconnectAsync());
+    while (invalid->IsConnected())
+        Thread::Yield();
+
+    // Stop the coalescing server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the coalescing server state
+    REQUIRE(server->datagrams_received() == 10);
+    REQUIRE(server->bytes_received() == 40);
+    REQUIRE(server->coalesced > 0);
+    REQUIRE(server->segmented);
+    REQUIRE(!server->errors);
     REQUIRE(!client->errors);
+
+    // Check the rejected GSO option is reported without connect failure
+    REQUIRE(invalid->errors);
+}
+#endif
+
+TEST_CASE("UDP server reuse port group test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3340;
+
+    // Create and start Asio service with several working threads
+    auto service = std::make_shared<EchoUDPService>(4);
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start counting server with the socket group
+    auto server = std::make_shared<GroupUDPServer>(service, port);
+    server->SetupReusePortGroup(true);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo clients
+    std::vector<std::shared_ptr<EchoUDPClient>> clients;
+    for (int i = 0; i < 10; ++i)
+    {
+        auto client = std::make_shared<EchoUDPClient>(service, address, port);
+        REQUIRE(client->ConnectAsync());
+        while (!client->IsConnected())
+            Thread::Yield();
+        clients.emplace_back(client);
+    }
+
+    // Send datagrams from all clients
+    for (int i = 0; i < 10; ++i)
+        for (auto& client : clients)
+            client->Send("test");
+
+    // Wait for all datagrams received...
+    while (server->datagrams_received() != 100)
+        Thread::Yield();
+
+    // Keep sending datagrams while the server is stopping
+    for (int i = 0; i < 10; ++i)
+        for (auto& client : clients)
+            client->SendAsync("test");
+
+    // Stop the counting server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Disconnect Echo clients
+    for (auto& client : clients)
+    {
+        REQUIRE(client->DisconnectAsync());
+        while (client->IsConnected())
+            Thread::Yield();
+    }
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the counting server state
+    REQUIRE(server->datagrams_received() >= 100);
+    REQUIRE(server->bytes_received() >= 400);
+    REQUIRE(server->sockets() > 1);
+    REQUIRE(!server->errors);
 }
 
 TEST_CASE("UDP server random test", "[CppServer][UDP]")
@@ -261,3 +928,171 @@ TEST_CASE("UDP server random test", "[CppServer][UDP]")
     REQUIRE(server->bytes_received() > 0);
     REQUIRE(!server->errors);
 }
+
+TEST_CASE("UDP server sessions test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3343;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server in sessions mode
+    auto server = std::make_shared<EchoUDPSessionServer>(service, port);
+    server->SetupSessions(true);
+    server->SetupSessionTimeout(Timespan::seconds(1));
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo clients
+    std::vector<std::shared_ptr<EchoUDPClient>> clients;
+    for (int i = 0; i < 3; ++i)
+    {
+        auto client = std::make_shared<EchoUDPClient>(service, address, port);
+        REQUIRE(client->ConnectAsync());
+        while (!client->IsConnected())
+            Thread::Yield();
+        clients.emplace_back(client);
+    }
+
+    // Send a message from each client to the Echo server
+    for (auto& client : clients)
+        client->Send("test");
+
+    // Wait for all data processed...
+    for (auto& client : clients)
+        while (client->bytes_received() != 4)
+            Thread::Yield();
+
+    // Check sessions of all clients
+    REQUIRE(server->connected_sessions() == 3);
+    for (auto& client : clients)
+    {
+        auto session = server->FindSession(asio::ip::udp::endpoint(asio::ip::make_address(address), client->socket().local_endpoint().port()));
+        REQUIRE(session != nullptr);
+        while (session->bytes_sent() != 4)
+            Thread::Yield();
+        REQUIRE(session->bytes_received() == 4);
+        REQUIRE(session->bytes_pending() == 0);
+    }
+
+    // Wait for idle sessions expiration...
+    auto idle = std::chrono::steady_clock::now();
+    while (server->connected_sessions() != 0)
+        Thread::Yield();
+
+    // Check idle sessions were expired soon after the session timeout
+    REQUIRE((std::chrono::steady_clock::now() - idle) < std::chrono::milliseconds(1500));
+
+    // Send a message from the expired client to create a new session
+    clients.front()->Send("test");
+    while (clients.front()->bytes_received() != 8)
+        Thread::Yield();
+    REQUIRE(server->connected_sessions() == 1);
+
+    // Disconnect Echo clients
+    for (auto& client : clients)
+    {
+        REQUIRE(client->DisconnectAsync());
+        while (client->IsConnected())
+            Thread::Yield();
+    }
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(server->started);
+    REQUIRE(server->stopped);
+    REQUIRE(server->connected == 4);
+    REQUIRE(server->disconnected == 4);
+    REQUIRE(server->bytes_sent() == 16);
+    REQUIRE(server->bytes_received() == 16);
+    REQUIRE(!server->errors);
+}
+
+TEST_CASE("UDP send buffer limit test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 3349;
+
+    // Create and start Asio service
+    auto service = std::make_shared<EchoUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo server in sessions mode with limited send buffers
+    auto server = std::make_shared<EchoUDPSessionServer>(service, port);
+    server->SetupSessions(true);
+    server->SetupSendBufferLimit(16);
+    server->SetupSessionSendLimit(4);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo client with limited send buffer
+    auto client = std::make_shared<EchoUDPClient>(service, address, port);
+    client->SetupSendBufferLimit(8);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Datagram above the client send buffer limit is not queued
+    REQUIRE(!client->SendAsync("too large"));
+
+    // Send a message to the Echo server
+    REQUIRE(client->SendAsync("test"));
+    while (client->bytes_received() != 4)
+        Thread::Yield();
+
+    // Datagram above the server send buffer limit is not queued
+    auto endpoint = asio::ip::udp::endpoint(asio::ip::make_address(address), client->socket().local_endpoint().port());
+    REQUIRE(!server->SendAsync(endpoint, "datagram too large"));
+
+    // Echo above the session send limit is not queued
+    REQUIRE(client->SendAsync("tested"));
+    REQUIRE(client->SendAsync("test"));
+    while (client->bytes_received() != 8)
+        Thread::Yield();
+
+    // Check the session statistic
+    auto session = server->FindSession(endpoint);
+    REQUIRE(session != nullptr);
+    while (session->bytes_sent() != 8)
+        Thread::Yield();
+    REQUIRE(session->bytes_received() == 14);
+    REQUIRE(session->bytes_pending() == 0);
+
+    // Disconnect the Echo client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the Echo server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo server state
+    REQUIRE(server->bytes_sent() == 8);
+    REQUIRE(server->bytes_received() == 14);
+    REQUIRE(!server->errors);
+    REQUIRE(!client->errors);
+}
@@ -4,6 +4,8 @@
 
 #include "test.h"
 
+#include "server/asio/sequenced_udp_client.h"
+#include "server/asio/sequenced_udp_server.h"
 #include "server/asio/udp_client.h"
 #include "server/asio/udp_server.h"
 #include "threads/thread.h"
@@ -72,6 +74,115 @@ public:
     std::atomic<bool> errors{false};
 };
 
+class LossySequencedUDPClient : public SequencedUDPClient
+{
+public:
+    using SequencedUDPClient::SequencedUDPClient;
+
+protected:
+    void onConnected() override { SequencedUDPClient::onConnected(); connected = true; }
+    void onDisconnected() override { SequencedUDPClient::onDisconnected(); disconnected = true; }
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override
+    {
+        // Drop every 10th datagram
+        if ((++counter % 10) == 0)
+        {
+            ReceiveAsync();
+            return;
+        }
+        SequencedUDPClient::onReceived(endpoint, buffer, size);
+    }
+    void onReceivedMessage(uint64_t sequence, const void* buffer, size_t size) override
+    {
+        if (sequence != messages)
+            ordered = false;
+        ++messages;
+    }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> connected{false};
+    std::atomic<bool> disconnected{false};
+    std::atomic<bool> ordered{true};
+    std::atomic<uint64_t> messages{0};
+    std::atomic<bool> errors{false};
+
+private:
+    size_t counter{0};
+};
+
+class NackUDPClient : public UDPClient
+{
+public:
+    using UDPClient::UDPClient;
+
+    void SendNack(uint16_t session, const std::vector<std::pair<uint64_t, uint64_t>>& ranges)
+    {
+        std::vector<uint8_t> datagram(4 + ranges.size() * 16, 0);
+        datagram[0] = 2;
+        datagram[1] = (uint8_t)ranges.size();
+        datagram[2] = (uint8_t)(session >> 8);
+        datagram[3] = (uint8_t)session;
+        for (size_t i = 0; i < ranges.size(); ++i)
+        {
+            for (int j = 0; j < 8; ++j)
+            {
+                datagram[4 + i * 16 + j] = (uint8_t)(ranges[i].first >> (56 - 8 * j));
+                datagram[4 + i * 16 + 8 + j] = (uint8_t)(ranges[i].second >> (56 - 8 * j));
+            }
+        }
+        Send(datagram.data(), datagram.size());
+    }
+
+protected:
+    void onConnected() override { ReceiveAsync(); }
+    void onReceived(const asio::ip::udp::endpoint& endpoint, const void* buffer, size_t size) override
+    {
+        if ((size > 0) && (((const uint8_t*)buffer)[0] == 1))
+            ++retransmitted;
+        ReceiveAsync();
+    }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<uint64_t> retransmitted{0};
+    std::atomic<bool> errors{false};
+};
+
+class ResetSequencedUDPClient : public SequencedUDPClient
+{
+public:
+    using SequencedUDPClient::SequencedUDPClient;
+
+protected:
+    void onReceivedMessage(uint64_t sequence, const void* buffer, size_t size) override { ++messages; }
+    void onGap(uint64_t begin, uint64_t end) override { ++gaps; }
+    void onReset() override { ++resets; }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<uint64_t> messages{0};
+    std::atomic<uint64_t> gaps{0};
+    std::atomic<uint64_t> resets{0};
+    std::atomic<bool> errors{false};
+};
+
+class SequencedMulticastUDPServer : public SequencedUDPServer
+{
+public:
+    using SequencedUDPServer::SequencedUDPServer;
+
+protected:
+    void onStarted() override { SequencedUDPServer::onStarted(); started = true; }
+    void onStopped() override { SequencedUDPServer::onStopped(); stopped = true; }
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> started{false};
+    std::atomic<bool> stopped{false};
+    std::atomic<bool> errors{false};
+};
+
 } // namespace
 
 TEST_CASE("UDP server multicast test", "[CppServer][UDP]")
@@ -325,3 +436,247 @@ TEST_CASE("UDP server multicast random test", "[CppServer][UDP]")
     REQUIRE(server->bytes_received() == 0);
     REQUIRE(!server->errors);
 }
+
+TEST_CASE("UDP server sequenced multicast test", "[CppServer][UDP]")
+{
+    const std::string listen_address = "0.0.0.0";
+    const std::string multicast_address = "239.255.0.1";
+    const int multicast_port = 3342;
+
+    // Create and start Asio service
+    auto service = std::make_shared<MulticastUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start sequenced multicast server
+    auto server = std::make_shared<SequencedMulticastUDPServer>(service, 0);
+    REQUIRE(server->Start(multicast_address, multicast_port));
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect lossy sequenced multicast client
+    auto client = std::make_shared<LossySequencedUDPClient>(service, listen_address, multicast_port);
+    client->SetupMulticast(true);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Join multicast group
+    client->JoinMulticastGroup(multicast_address);
+
+    // Multicast a bunch of messages to the client
+    for (int i = 0; i < 100; ++i)
+    {
+        server->Multicast("test");
+        Thread::Sleep(1);
+    }
+
+    // Wait for all messages recovered and delivered in order...
+    while (client->messages != 100)
+        Thread::Yield();
+
+    // Leave multicast group
+    client->LeaveMulticastGroup(multicast_address);
+
+    // Disconnect the sequenced multicast client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the sequenced multicast server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the sequenced multicast server state
+    REQUIRE(server->started);
+    REQUIRE(server->stopped);
+    REQUIRE(server->sequence() == 100);
+    REQUIRE(server->nacks_received() > 0);
+    REQUIRE(server->datagrams_retransmitted() > 0);
+    REQUIRE(!server->errors);
+
+    // Check the sequenced multicast client state
+    REQUIRE(client->connected);
+    REQUIRE(client->disconnected);
+    REQUIRE(client->ordered);
+    REQUIRE(client->messages == 100);
+    REQUIRE(client->nacks_sent() > 0);
+    REQUIRE(client->datagrams_lost() == 0);
+    REQUIRE(!client->errors);
+}
+
+TEST_CASE("UDP server sequenced multicast NACK limits test", "[CppServer][UDP]")
+{
+    const std::string address = "127.0.0.1";
+    const std::string multicast_address = "239.255.0.1";
+    const int multicast_port = 3342;
+    const int port = 3347;
+
+    // Create and start Asio service
+    auto service = std::make_shared<MulticastUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start sequenced multicast server with retransmit limits
+    auto server = std::make_shared<SequencedMulticastUDPServer>(service, port);
+    server->SetupRetransmitLimit(6);
+    server->SetupRetransmitRate(12);
+    REQUIRE(server->Start(multicast_address, multicast_port));
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Multicast a bunch of messages
+    for (int i = 0; i < 100; ++i)
+        server->Multicast("test");
+
+    // Create and connect NACK client
+    auto client = std::make_shared<NackUDPClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Overlapping ranges are merged and retransmitted once
+    client->SendNack(server->session(), { { 0, 3 }, { 1, 4 }, { 2, 5 } });
+    while (client->retransmitted != 5)
+        Thread::Yield();
+    Thread::Sleep(20);
+    REQUIRE(client->retransmitted == 5);
+
+    // Datagrams retransmitted for one NACK are limited, then the rate budget of the client is exhausted
+    client->SendNack(server->session(), { { 0, 100 } });
+    client->SendNack(server->session(), { { 0, 100 } });
+    client->SendNack(server->session(), { { 0, 100 } });
+    while (client->retransmitted != 12)
+        Thread::Yield();
+    Thread::Sleep(20);
+    REQUIRE(client->retransmitted == 12);
+
+    // NACK of another server session is ignored
+    client->SendNack((uint16_t)(server->session() + 1), { { 0, 1 } });
+    Thread::Sleep(20);
+    REQUIRE(client->retransmitted == 12);
+
+    // Disconnect NACK client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the sequenced multicast server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the sequenced multicast server state
+    REQUIRE(server->nacks_received() == 4);
+    REQUIRE(server->datagrams_retransmitted() == 12);
+    REQUIRE(!server->errors);
+    REQUIRE(!client->errors);
+}
+
+TEST_CASE("UDP server sequenced multicast restart test", "[CppServer][UDP]")
+{
+    const std::string listen_address = "0.0.0.0";
+    const std::string multicast_address = "239.255.0.1";
+    const int multicast_port = 3350;
+    const int port = 3351;
+
+    // Create and start Asio service
+    auto service = std::make_shared<MulticastUDPService>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start sequenced multicast server
+    auto server = std::make_shared<SequencedMulticastUDPServer>(service, port);
+    REQUIRE(server->Start(multicast_address, multicast_port));
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect sequenced multicast client
+    auto client = std::make_shared<ResetSequencedUDPClient>(service, listen_address, multicast_port);
+    client->SetupMulticast(true);
+    REQUIRE(client->ConnectAsync());
+    while (!client->IsConnected())
+        Thread::Yield();
+
+    // Join multicast group
+    client->JoinMulticastGroup(multicast_address);
+
+    // Multicast a bunch of messages to the client
+    for (int i = 0; i < 10; ++i)
+    {
+        server->Multicast("test");
+        Thread::Sleep(1);
+    }
+    while (client->messages != 10)
+        Thread::Yield();
+
+    // Restart the sequenced multicast server, so its sequence starts from zero
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+    server = std::make_shared<SequencedMulticastUDPServer>(service, port);
+    REQUIRE(server->Start(multicast_address, multicast_port));
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Datagram of a foreign sender is dropped
+    auto foreign = std::make_shared<MulticastUDPServer>(service, 0);
+    REQUIRE(foreign->Start(multicast_address, multicast_port));
+    while (!foreign->IsStarted())
+        Thread::Yield();
+    uint8_t datagram[16] = { 1, 0, 0xAB, 0xCD, 0, 0, 0, 0, 0, 0, 0, 100, 't', 'e', 's', 't' };
+    foreign->Multicast(datagram, sizeof(datagram));
+    REQUIRE(foreign->Stop());
+    while (foreign->IsStarted())
+        Thread::Yield();
+
+    // Multicast a bunch of messages from the restarted server
+    for (int i = 0; i < 10; ++i)
+    {
+        server->Multicast("test");
+        Thread::Sleep(1);
+    }
+
+    // Wait for the client to be re-synchronized and receive all new messages...
+    while (client->messages != 20)
+        Thread::Yield();
+
+    // Leave multicast group
+    client->LeaveMulticastGroup(multicast_address);
+
+    // Disconnect the sequenced multicast client
+    REQUIRE(client->DisconnectAsync());
+    while (client->IsConnected())
+        Thread::Yield();
+
+    // Stop the sequenced multicast server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the sequenced multicast client state
+    REQUIRE(client->resets == 1);
+    REQUIRE(client->server_resets() == 1);
+    REQUIRE(client->gaps == 0);
+    REQUIRE(client->sequence() == 10);
+    REQUIRE(!client->errors);
+}
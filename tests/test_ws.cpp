@@ -0,0 +1,615 @@
+//
+// Created by agent on 18.10.2026
+//
+
+#include "test.h"
+
+#include "server/ws/ws_client.h"
+#include "server/ws/ws_server.h"
+#include "threads/thread.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace CppCommon;
+using namespace CppServer::Asio;
+using namespace CppServer::HTTP;
+using namespace CppServer::WS;
+
+namespace {
+
+class TestWebSocket : public WebSocket
+{
+public:
+    explicit TestWebSocket(bool server) : WebSocket(server) {}
+
+    using WebSocket::ReceiveFrames;
+    using WebSocket::NegotiateDeflate;
+    using WebSocket::OfferDeflate;
+    using WebSocket::AcceptDeflate;
+    using WebSocket::PrepareMessage;
+
+public:
+    std::string sent;
+    std::vector<std::string> messages;
+    std::vector<std::string> pings;
+    int close_status{0};
+    int error_status{0};
+
+protected:
+    void onWSSend(const void* buffer, size_t size) override { sent.append((const char*)buffer, size); }
+    void onWSReceived(const void* buffer, size_t size, bool text) override { messages.emplace_back((text ? "T:" : "B:") + std::string((const char*)buffer, size)); }
+    void onWSPing(const void* buffer, size_t size) override { pings.emplace_back((const char*)buffer, size); }
+    void onWSClose(int status, std::string_view reason) override { close_status = status; }
+    void onWSError(int status, const std::string& error) override { error_status = status; }
+};
+
+class EchoWSSession : public WSSession
+{
+public:
+    using WSSession::WSSession;
+
+protected:
+    void onWSConnected(const HTTPRequest& request) override { ++connected; }
+    void onWSDisconnected() override { ++disconnected; }
+    void onWSReceived(const void* buffer, size_t size, bool text) override
+    {
+        // Echo the received message
+        if (text)
+            SendTextAsync(std::string_view((const char*)buffer, size));
+        else
+            SendBinaryAsync(buffer, size);
+    }
+    void onWSError(int status, const std::string& error) override { ++errors; }
+
+public:
+    static std::atomic<size_t> connected;
+    static std::atomic<size_t> disconnected;
+    static std::atomic<size_t> errors;
+};
+
+std::atomic<size_t> EchoWSSession::connected{0};
+std::atomic<size_t> EchoWSSession::disconnected{0};
+std::atomic<size_t> EchoWSSession::errors{0};
+
+class EchoWSServer : public WSServer
+{
+public:
+    using WSServer::WSServer;
+
+protected:
+    std::shared_ptr<TCPSession> CreateSession(std::shared_ptr<TCPServer> server) override { return std::make_shared<EchoWSSession>(server); }
+
+protected:
+    void onError(int error, const std::string& category, const std::string& message) override { errors = true; }
+
+public:
+    std::atomic<bool> errors{false};
+};
+
+class DeflateWSServer : public EchoWSServer
+{
+public:
+    using EchoWSServer::EchoWSServer;
+
+protected:
+    std::shared_ptr<TCPSession> CreateSession(std::shared_ptr<TCPServer> server) override
+    {
+        // Compress messages without context takeover to multicast them once for all sessions
+        auto session = std::make_shared<EchoWSSession>(server);
+        session->SetupWSDeflate(true);
+        session->SetupWSDeflateContextTakeover(false);
+        return session;
+    }
+};
+
+class FragmentWSSession : public WSSession
+{
+public:
+    using WSSession::WSSession;
+
+protected:
+    void onWSReceived(const void* buffer, size_t size, bool text) override
+    {
+        // Start or finish the fragmented message on the client command
+        std::string command((const char*)buffer, size);
+        if (command == "start")
+        {
+            SendFragmentAsync(Opcode::Text, false, "frag", 4);
+            fragmenting = true;
+        }
+        else if (command == "finish")
+            SendFragmentAsync(Opcode::Continuation, true, "ment", 4);
+    }
+
+public:
+    static std::atomic<bool> fragmenting;
+};
+
+std::atomic<bool> FragmentWSSession::fragmenting{false};
+
+class FragmentWSServer : public EchoWSServer
+{
+public:
+    using EchoWSServer::EchoWSServer;
+
+protected:
+    std::shared_ptr<TCPSession> CreateSession(std::shared_ptr<TCPServer> server) override { return std::make_shared<FragmentWSSession>(server); }
+};
+
+class EchoWSClient : public WSClient
+{
+public:
+    using WSClient::WSClient;
+
+    std::vector<std::string> messages()
+    {
+        std::scoped_lock locker(_lock);
+        return _messages;
+    }
+
+protected:
+    void onWSConnected(const HTTPResponse& response) override { connected = true; }
+    void onWSDisconnected() override { disconnected = true; }
+    void onWSReceived(const void* buffer, size_t size, bool text) override
+    {
+        std::scoped_lock locker(_lock);
+        _messages.emplace_back((const char*)buffer, size);
+        received += size;
+    }
+    void onWSClose(int status, std::string_view reason) override { close_status = status; }
+    void onWSError(int status, const std::string& error) override { errors = true; }
+
+public:
+    std::atomic<bool> connected{false};
+    std::atomic<bool> disconnected{false};
+    std::atomic<size_t> received{0};
+    std::atomic<int> close_status{0};
+    std::atomic<bool> errors{false};
+
+private:
+    std::mutex _lock;
+    std::vector<std::string> _messages;
+};
+
+} // namespace
+
+TEST_CASE("WebSocket frame test", "[CppServer][WebSocket]")
+{
+    // Check masking of unaligned payloads with the payload offset
+    const uint8_t key[4] = { 0x12, 0x34, 0x56, 0x78 };
+    std::string payload(1000, 'x');
+    for (size_t i = 0; i < payload.size(); ++i)
+        payload[i] = (char)(i * 7);
+    std::string masked(payload.size(), 0);
+    WebSocket::Mask(&masked[0], payload.data(), 3, key);
+    WebSocket::Mask(&masked[3], payload.data() + 3, payload.size() - 3, key, 3);
+    for (size_t i = 0; i < payload.size(); ++i)
+        REQUIRE((uint8_t)masked[i] == ((uint8_t)payload[i] ^ key[i & 3]));
+
+    // Prepare masked client frames: text, fragmented binary message with the ping inside and close
+    std::string frames;
+    std::string large(70000, 'a');
+    WebSocket::PrepareFrame(frames, WebSocket::Opcode::Text, true, "test", 4, true);
+    WebSocket::PrepareFrame(frames, WebSocket::Opcode::Binary, false, large.data(), 200, true);
+    WebSocket::PrepareFrame(frames, WebSocket::Opcode::Ping, true, "ping", 4, true);
+    WebSocket::PrepareFrame(frames, WebSocket::Opcode::Continuation, true, large.data() + 200, large.size() - 200, true);
+    WebSocket::PrepareCloseFrame(frames, WebSocket::CLOSE_GOING_AWAY, "bye", true);
+
+    // Receive frames by one byte
+    TestWebSocket server(true);
+    for (size_t i = 0; i < frames.size(); ++i)
+        REQUIRE(server.ReceiveFrames(frames.data() + i, 1));
+
+    // Check the received messages
+    REQUIRE(server.messages.size() == 2);
+    REQUIRE(server.messages[0] == "T:test");
+    REQUIRE(server.messages[1] == "B:" + large);
+    REQUIRE(server.pings.size() == 1);
+    REQUIRE(server.pings[0] == "ping");
+    REQUIRE(server.close_status == WebSocket::CLOSE_GOING_AWAY);
+    REQUIRE(server.error_status == 0);
+    REQUIRE(server.IsWSCloseSent());
+    REQUIRE(server.IsWSCloseReceived());
+
+    // Receive unmasked pong and close replies of the server at once
+    TestWebSocket client(false);
+    REQUIRE(client.ReceiveFrames(server.sent.data(), server.sent.size()));
+    REQUIRE(client.close_status == WebSocket::CLOSE_GOING_AWAY);
+    REQUIRE(client.error_status == 0);
+
+    // Unmasked client frame is the protocol error
+    std::string unmasked;
+    WebSocket::PrepareFrame(unmasked, WebSocket::Opcode::Text, true, "test", 4, false);
+    TestWebSocket invalid(true);
+    REQUIRE(!invalid.ReceiveFrames(unmasked.data(), unmasked.size()));
+    REQUIRE(invalid.error_status == WebSocket::CLOSE_PROTOCOL_ERROR);
+    REQUIRE(invalid.messages.empty());
+
+    // Invalid UTF-8 text message
+    std::string text;
+    WebSocket::PrepareFrame(text, WebSocket::Opcode::Text, true, "\xC0\xAF", 2, true);
+    TestWebSocket utf8(true);
+    REQUIRE(!utf8.ReceiveFrames(text.data(), text.size()));
+    REQUIRE(utf8.error_status == WebSocket::CLOSE_INVALID_PAYLOAD);
+
+    // Message exceeding the message size limit
+    std::string big;
+    WebSocket::PrepareFrame(big, WebSocket::Opcode::Binary, true, large.data(), 1000, true);
+    TestWebSocket limited(true);
+    limited.SetupWSMaxMessageSize(100);
+    REQUIRE(!limited.ReceiveFrames(big.data(), big.size()));
+    REQUIRE(limited.error_status == WebSocket::CLOSE_MESSAGE_TOO_BIG);
+
+    // Frame header of the message above the default 64 MiB limit
+    const uint8_t huge[] = { 0x82, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x01, 0x01, 0x02, 0x03, 0x04 };
+    TestWebSocket bounded(true);
+    REQUIRE(bounded.ws_max_message_size() == 64 * 1024 * 1024);
+    REQUIRE(!bounded.ReceiveFrames(huge, sizeof(huge)));
+    REQUIRE(bounded.error_status == WebSocket::CLOSE_MESSAGE_TOO_BIG);
+
+    // Zero message size limit disables the check
+    TestWebSocket unbounded(true);
+    unbounded.SetupWSMaxMessageSize(0);
+    REQUIRE(unbounded.ReceiveFrames(huge, sizeof(huge)));
+    REQUIRE(unbounded.error_status == 0);
+}
+
+TEST_CASE("WebSocket permessage-deflate test", "[CppServer][WebSocket]")
+{
+    std::string text;
+    for (size_t i = 0; i < 100; ++i)
+        text += "{\"symbol\":\"EURUSD\",\"price\":1.0842}";
+
+    // Negotiate permessage-deflate extension without context takeover of the server
+    TestWebSocket server(true);
+    server.SetupWSDeflate(true);
+    server.SetupWSDeflateContextTakeover(false);
+    TestWebSocket client(false);
+    client.SetupWSDeflate(true);
+
+    HTTPRequest request;
+    std::string key = WebSocket::PrepareUpgradeRequest(request, "localhost", "/");
+    client.OfferDeflate(request);
+    request.SetBody();
+    HTTPResponse response;
+    REQUIRE(WebSocket::PrepareUpgradeResponse(request, response));
+    server.NegotiateDeflate(request, response);
+    response.SetBody();
+    REQUIRE(WebSocket::CheckUpgradeResponse(response, key));
+    REQUIRE(client.AcceptDeflate(response));
+#if !defined(CPPSERVER_ZLIB)
+    // Extension is never negotiated without zlib
+    REQUIRE(!server.IsWSDeflated());
+    REQUIRE(!client.IsWSDeflated());
+#else
+    REQUIRE(server.IsWSDeflated());
+    REQUIRE(server.IsWSDeflateStateless());
+    REQUIRE(client.IsWSDeflated());
+    REQUIRE(!client.IsWSDeflateStateless());
+
+    // Prepare compressed client messages with context takeover, fragmented message and small uncompressed message
+    std::string frames;
+    REQUIRE(client.PrepareMessage(frames, WebSocket::Opcode::Text, true, text.data(), text.size()));
+    REQUIRE(((uint8_t)frames[0] & 0x40) != 0);
+    REQUIRE(frames.size() < text.size() / 4);
+    size_t first = frames.size();
+    REQUIRE(client.PrepareMessage(frames, WebSocket::Opcode::Text, true, text.data(), text.size()));
+    REQUIRE((frames.size() - first) < first);
+    REQUIRE(client.PrepareMessage(frames, WebSocket::Opcode::Binary, false, text.data(), 100));
+    REQUIRE(client.PrepareMessage(frames, WebSocket::Opcode::Continuation, true, text.data() + 100, text.size() - 100));
+    size_t small = frames.size();
+    REQUIRE(client.PrepareMessage(frames, WebSocket::Opcode::Text, true, "test", 4));
+    REQUIRE(((uint8_t)frames[small] & 0x40) == 0);
+
+    // Receive frames by one byte
+    for (size_t i = 0; i < frames.size(); ++i)
+        REQUIRE(server.ReceiveFrames(frames.data() + i, 1));
+    REQUIRE(server.messages == std::vector<std::string>({ "T:" + text, "T:" + text, "B:" + text, "T:test" }));
+    REQUIRE(server.error_status == 0);
+
+    // Compress the server message once and receive it twice
+    std::string shared;
+    REQUIRE(WebSocket::PrepareDeflateFrame(shared, WebSocket::Opcode::Text, text.data(), text.size(), false));
+    REQUIRE(client.ReceiveFrames(shared.data(), shared.size()));
+    REQUIRE(client.ReceiveFrames(shared.data(), shared.size()));
+    REQUIRE(client.messages == std::vector<std::string>({ "T:" + text, "T:" + text }));
+
+    // Compressed frame without the negotiated extension is the protocol error
+    TestWebSocket plain(false);
+    REQUIRE(!plain.ReceiveFrames(shared.data(), shared.size()));
+    REQUIRE(plain.error_status == WebSocket::CLOSE_PROTOCOL_ERROR);
+
+    // Decompressed message exceeding the message size limit
+    frames.clear();
+    REQUIRE(client.PrepareMessage(frames, WebSocket::Opcode::Text, true, text.data(), text.size()));
+    server.SetupWSMaxMessageSize(100);
+    REQUIRE(!server.ReceiveFrames(frames.data(), frames.size()));
+    REQUIRE(server.error_status == WebSocket::CLOSE_MESSAGE_TOO_BIG);
+#endif
+}
+
+TEST_CASE("WebSocket server test", "[CppServer][WebSocket]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8090;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo WebSocket server
+    auto server = std::make_shared<EchoWSServer>(service, port);
+    server->SetupReuseAddress(true);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo WebSocket client
+    auto client = std::make_shared<EchoWSClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->connected)
+        Thread::Yield();
+
+    // Send text, large binary and fragmented messages
+    std::string large(100000, 'b');
+    REQUIRE(client->SendTextAsync("test"));
+    REQUIRE(client->SendBinaryAsync(large.data(), large.size()));
+    REQUIRE(client->SendFragmentAsync(WSClient::Opcode::Text, false, "frag", 4));
+    REQUIRE(client->SendFragmentAsync(WSClient::Opcode::Continuation, true, "ment", 4));
+
+    // Wait for all echo messages...
+    while (client->messages().size() != 3)
+        Thread::Yield();
+
+    // Check the echo messages
+    auto messages = client->messages();
+    REQUIRE(messages[0] == "test");
+    REQUIRE(messages[1] == large);
+    REQUIRE(messages[2] == "fragment");
+
+    // Close the WebSocket connection
+    REQUIRE(client->CloseAsync(WebSocket::CLOSE_NORMAL, "done"));
+    while (!client->disconnected)
+        Thread::Yield();
+
+    // Stop the Echo WebSocket server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo WebSocket server state
+    REQUIRE(!server->errors);
+    REQUIRE(EchoWSSession::connected == 1);
+    REQUIRE(EchoWSSession::disconnected == 1);
+    REQUIRE(EchoWSSession::errors == 0);
+
+    // Check the Echo WebSocket client state
+    REQUIRE(client->close_status == WebSocket::CLOSE_NORMAL);
+    REQUIRE(!client->errors);
+}
+
+TEST_CASE("WebSocket server multicast test", "[CppServer][WebSocket]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8091;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Echo WebSocket server
+    auto server = std::make_shared<EchoWSServer>(service, port);
+    server->SetupReuseAddress(true);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo WebSocket clients
+    std::vector<std::shared_ptr<EchoWSClient>> clients;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        auto client = std::make_shared<EchoWSClient>(service, address, port);
+        REQUIRE(client->ConnectAsync());
+        while (!client->connected)
+            Thread::Yield();
+        clients.emplace_back(client);
+    }
+
+    // Multicast text and binary messages to all clients
+    REQUIRE(server->MulticastText("test"));
+    REQUIRE(server->MulticastBinary("data", 4));
+
+    // Wait for all multicast messages...
+    for (auto& client : clients)
+        while (client->messages().size() != 2)
+            Thread::Yield();
+
+    // Check the multicast messages
+    for (auto& client : clients)
+    {
+        auto messages = client->messages();
+        REQUIRE(messages[0] == "test");
+        REQUIRE(messages[1] == "data");
+    }
+
+    // Disconnect all clients
+    for (auto& client : clients)
+    {
+        REQUIRE(client->CloseAsync());
+        while (!client->disconnected)
+            Thread::Yield();
+    }
+
+    // Stop the Echo WebSocket server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Echo WebSocket server state
+    REQUIRE(!server->errors);
+
+    // Check the Echo WebSocket clients state
+    for (auto& client : clients)
+        REQUIRE(!client->errors);
+}
+
+TEST_CASE("WebSocket server multicast fragmented test", "[CppServer][WebSocket]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8094;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start Fragment WebSocket server
+    auto server = std::make_shared<FragmentWSServer>(service, port);
+    server->SetupReuseAddress(true);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect Echo WebSocket client
+    auto client = std::make_shared<EchoWSClient>(service, address, port);
+    REQUIRE(client->ConnectAsync());
+    while (!client->connected)
+        Thread::Yield();
+
+    // Start the fragmented message in the session
+    REQUIRE(client->SendTextAsync("start"));
+    while (!FragmentWSSession::fragmenting)
+        Thread::Yield();
+
+    // Multicast text message in the middle of the fragmented message and finish it
+    REQUIRE(server->MulticastText("test"));
+    REQUIRE(client->SendTextAsync("finish"));
+
+    // Wait for all messages...
+    while (client->messages().size() != 2)
+        Thread::Yield();
+
+    // Check the multicast message is received after the fragmented message
+    auto messages = client->messages();
+    REQUIRE(messages[0] == "fragment");
+    REQUIRE(messages[1] == "test");
+
+    // Disconnect the client
+    REQUIRE(client->CloseAsync());
+    while (!client->disconnected)
+        Thread::Yield();
+
+    // Stop the Fragment WebSocket server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the Fragment WebSocket server state
+    REQUIRE(!server->errors);
+
+    // Check the Echo WebSocket client state
+    REQUIRE(!client->errors);
+}
+
+#if defined(CPPSERVER_ZLIB)
+TEST_CASE("WebSocket server compression test", "[CppServer][WebSocket]")
+{
+    const std::string address = "127.0.0.1";
+    const int port = 8092;
+
+    // Create and start Asio service
+    auto service = std::make_shared<Service>();
+    REQUIRE(service->Start());
+    while (!service->IsStarted())
+        Thread::Yield();
+
+    // Create and start WebSocket server with permessage-deflate extension
+    auto server = std::make_shared<DeflateWSServer>(service, port);
+    server->SetupReuseAddress(true);
+    REQUIRE(server->Start());
+    while (!server->IsStarted())
+        Thread::Yield();
+
+    // Create and connect WebSocket clients with and without permessage-deflate extension
+    std::vector<std::shared_ptr<EchoWSClient>> clients;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        auto client = std::make_shared<EchoWSClient>(service, address, port);
+        client->SetupWSDeflate(i > 0);
+        REQUIRE(client->ConnectAsync());
+        while (!client->connected)
+            Thread::Yield();
+        REQUIRE(client->IsWSDeflated() == (i > 0));
+        clients.emplace_back(client);
+    }
+
+    // Send the compressed message and multicast compressed and small messages to all clients
+    std::string large(100000, 'c');
+    REQUIRE(clients.back()->SendTextAsync(large));
+    while (clients.back()->messages().size() != 1)
+        Thread::Yield();
+    REQUIRE(server->MulticastText(large));
+    REQUIRE(server->MulticastBinary("data", 4));
+
+    // Wait for all multicast messages...
+    for (auto& client : clients)
+        while (client->messages().size() != ((client == clients.back()) ? 3 : 2))
+            Thread::Yield();
+
+    // Check the multicast messages
+    for (auto& client : clients)
+    {
+        auto messages = client->messages();
+        REQUIRE(messages[messages.size() - 2] == large);
+        REQUIRE(messages[messages.size() - 1] == "data");
+    }
+
+    // Disconnect all clients
+    for (auto& client : clients)
+    {
+        REQUIRE(client->CloseAsync());
+        while (!client->disconnected)
+            Thread::Yield();
+    }
+
+    // Stop the WebSocket server
+    REQUIRE(server->Stop());
+    while (server->IsStarted())
+        Thread::Yield();
+
+    // Stop the Asio service
+    REQUIRE(service->Stop());
+    while (service->IsStarted())
+        Thread::Yield();
+
+    // Check the WebSocket server state
+    REQUIRE(!server->errors);
+
+    // Check the WebSocket clients state
+    for (auto& client : clients)
+        REQUIRE(!client->errors);
+}
+#endif
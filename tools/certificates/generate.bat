@@ -15,6 +15,15 @@ openssl.exe pkcs12 -clcerts -export -passout pass:qwerty -in server.crt -inkey s
 openssl.exe pkcs12 -clcerts -passin pass:qwerty -passout pass:qwerty -in server.p12 -out server.pem
 openssl.exe pkcs12 -export -out server.pfx -inkey server.key -in server.crt
 
+# SSL Server certificate (ECDSA)
+openssl.exe ecparam -name prime256v1 -genkey -noout | openssl.exe ec -aes256 -passout pass:qwerty -out server-ecdsa-secret.key
+openssl.exe ec -passin pass:qwerty -in server-ecdsa-secret.key -out server-ecdsa.key
+openssl.exe req -new -subj "/C=BY/ST=Belarus/L=Minsk/O=Example server/OU=Example server unit/CN=server.example.com" -key server-ecdsa.key -out server-ecdsa.csr -config openssl.cfg
+openssl.exe x509 -req -days 3650 -in server-ecdsa.csr -CA ca.crt -CAkey ca.key -set_serial 02 -out server-ecdsa.crt
+openssl.exe pkcs12 -clcerts -export -passout pass:qwerty -in server-ecdsa.crt -inkey server-ecdsa.key -out server-ecdsa.p12
+openssl.exe pkcs12 -clcerts -passin pass:qwerty -passout pass:qwerty -in server-ecdsa.p12 -out server-ecdsa.pem
+openssl.exe pkcs12 -export -out server-ecdsa.pfx -inkey server-ecdsa.key -in server-ecdsa.crt
+
 # SSL Client certificate
 openssl.exe genrsa -des3 -passout pass:qwerty -out client-secret.key 4096
 openssl.exe rsa -passin pass:qwerty -in client-secret.key -out client.key
@@ -17,6 +17,15 @@ openssl pkcs12 -clcerts -export -passout pass:qwerty -in server.crt -inkey serve
 openssl pkcs12 -clcerts -passin pass:qwerty -passout pass:qwerty -in server.p12 -out server.pem
 openssl pkcs12 -export -out server.pfx -inkey server.key -in server.crt
 
+# SSL Server certificate (ECDSA)
+openssl ecparam -name prime256v1 -genkey -noout | openssl ec -aes256 -passout pass:qwerty -out server-ecdsa-secret.key
+openssl ec -passin pass:qwerty -in server-ecdsa-secret.key -out server-ecdsa.key
+openssl req -new -subj '/C=BY/ST=Belarus/L=Minsk/O=Example server/OU=Example server unit/CN=server.example.com' -key server-ecdsa.key -out server-ecdsa.csr -config openssl.cfg
+openssl x509 -req -days 3650 -in server-ecdsa.csr -CA ca.crt -CAkey ca.key -set_serial 02 -out server-ecdsa.crt
+openssl pkcs12 -clcerts -export -passout pass:qwerty -in server-ecdsa.crt -inkey server-ecdsa.key -out server-ecdsa.p12
+openssl pkcs12 -clcerts -passin pass:qwerty -passout pass:qwerty -in server-ecdsa.p12 -out server-ecdsa.pem
+openssl pkcs12 -export -out server-ecdsa.pfx -inkey server-ecdsa.key -in server-ecdsa.crt
+
 # SSL Client certificate
 openssl genrsa -des3 -passout pass:qwerty -out client-secret.key 4096
 openssl rsa -passin pass:qwerty -in client-secret.key -out client.key